@@ -0,0 +1,226 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestInformationPerformance.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME Test speed of vtkInformation.
+// .SECTION Description
+// Probe the cost of the vtkInformation operations performed for every
+// pipeline request: setting scalar and extent keys, copying requests and
+// clearing them.
+
+#include "vtkInformation.h"
+#include "vtkInformationDoubleKey.h"
+#include "vtkInformationDoubleVectorKey.h"
+#include "vtkInformationIdTypeKey.h"
+#include "vtkInformationIntegerKey.h"
+#include "vtkInformationIntegerVectorKey.h"
+#include "vtkInformationStringKey.h"
+#include "vtkNew.h"
+#include "vtkTimerLog.h"
+
+// How many times the tests are run to average the elapsed time.
+static const int STRESS_COUNT = 5;
+
+// Number of simulated requests in each run.
+static const int REQUEST_COUNT = 100000;
+
+//------------------------------------------------------------------------------
+static vtkInformationIntegerKey* PIECE()
+{
+  static vtkInformationIntegerKey* key =
+    new vtkInformationIntegerKey("PIECE", "TestInformationPerformance");
+  return key;
+}
+
+static vtkInformationIntegerKey* NUMBER_OF_PIECES()
+{
+  static vtkInformationIntegerKey* key =
+    new vtkInformationIntegerKey("NUMBER_OF_PIECES",
+                                 "TestInformationPerformance");
+  return key;
+}
+
+static vtkInformationIdTypeKey* NUMBER_OF_CELLS()
+{
+  static vtkInformationIdTypeKey* key =
+    new vtkInformationIdTypeKey("NUMBER_OF_CELLS",
+                                "TestInformationPerformance");
+  return key;
+}
+
+static vtkInformationDoubleKey* TIME()
+{
+  static vtkInformationDoubleKey* key =
+    new vtkInformationDoubleKey("TIME", "TestInformationPerformance");
+  return key;
+}
+
+static vtkInformationIntegerVectorKey* EXTENT()
+{
+  static vtkInformationIntegerVectorKey* key =
+    new vtkInformationIntegerVectorKey("EXTENT",
+                                       "TestInformationPerformance", 6);
+  return key;
+}
+
+static vtkInformationDoubleVectorKey* VALUES()
+{
+  static vtkInformationDoubleVectorKey* key =
+    new vtkInformationDoubleVectorKey("VALUES", "TestInformationPerformance");
+  return key;
+}
+
+static vtkInformationStringKey* NAME()
+{
+  static vtkInformationStringKey* key =
+    new vtkInformationStringKey("NAME", "TestInformationPerformance");
+  return key;
+}
+
+//------------------------------------------------------------------------------
+static void FillRequest(vtkInformation* info, int i)
+{
+  int extent[6] = { 0, i % 100, 0, 99, 0, 99 };
+  PIECE()->Set(info, i);
+  NUMBER_OF_PIECES()->Set(info, 1000);
+  NUMBER_OF_CELLS()->Set(info, static_cast<vtkIdType>(i) * 10);
+  TIME()->Set(info, 0.5 * i);
+  EXTENT()->Set(info, extent, 6);
+}
+
+//------------------------------------------------------------------------------
+// Set the keys of a request that is reused from one pass to the next.
+static double StressSet()
+{
+  vtkNew<vtkInformation> info;
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  for (int i = 0; i < REQUEST_COUNT; ++i)
+    {
+    FillRequest(info.GetPointer(), i);
+    }
+  timer->StopTimer();
+  return timer->GetElapsedTime();
+}
+
+//------------------------------------------------------------------------------
+// Build a new request for every pass, copy it downstream and clear it.
+static double StressCopy()
+{
+  vtkNew<vtkInformation> downstream;
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  for (int i = 0; i < REQUEST_COUNT; ++i)
+    {
+    vtkInformation* request = vtkInformation::New();
+    FillRequest(request, i);
+    downstream->Copy(request);
+    request->Delete();
+    downstream->Clear();
+    }
+  timer->StopTimer();
+  return timer->GetElapsedTime();
+}
+
+//------------------------------------------------------------------------------
+// Query keys, present or not, as the executives do.
+static double StressGet()
+{
+  vtkNew<vtkInformation> info;
+  FillRequest(info.GetPointer(), 1);
+  int sum = 0;
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  for (int i = 0; i < REQUEST_COUNT; ++i)
+    {
+    sum += PIECE()->Get(info.GetPointer());
+    sum += EXTENT()->Get(info.GetPointer())[1];
+    sum += info->Has(TIME());
+    sum += info->Has(NAME());
+    }
+  timer->StopTimer();
+  return sum != 0? timer->GetElapsedTime() : 0.0;
+}
+
+//------------------------------------------------------------------------------
+static void ReportStress(const char* name, double (*stress)())
+{
+  double meanDuration = 0.0;
+  for (int i = 0; i < STRESS_COUNT; ++i)
+    {
+    meanDuration += stress();
+    }
+  meanDuration /= STRESS_COUNT;
+  std::cout << "<DartMeasurement name=\"" << name
+            << "\" type=\"numeric/double\">"
+            << meanDuration << "</DartMeasurement>" << std::endl;
+}
+
+//------------------------------------------------------------------------------
+// Vectors grow from inline storage to a separate value without losing
+// their values.
+static bool TestAppend()
+{
+  vtkNew<vtkInformation> info;
+  for (int i = 0; i < 10; ++i)
+    {
+    VALUES()->Append(info.GetPointer(), i);
+    }
+  if (VALUES()->Length(info.GetPointer()) != 10)
+    {
+    std::cerr << "Wrong length after Append." << std::endl;
+    return false;
+    }
+  for (int i = 0; i < 10; ++i)
+    {
+    if (VALUES()->Get(info.GetPointer(), i) != i)
+      {
+      std::cerr << "Wrong value after Append." << std::endl;
+      return false;
+      }
+    }
+
+  double values[2] = { 1.0, 2.0 };
+  VALUES()->Set(info.GetPointer(), values, 2);
+  info->Set(NAME(), "name");
+  vtkNew<vtkInformation> copy;
+  copy->Copy(info.GetPointer());
+  if (VALUES()->Length(copy.GetPointer()) != 2 ||
+      VALUES()->Get(copy.GetPointer())[1] != 2.0 ||
+      !copy->Has(NAME()))
+    {
+    std::cerr << "Wrong values after Copy." << std::endl;
+    return false;
+    }
+  copy->Remove(VALUES());
+  if (copy->Has(VALUES()) || VALUES()->Get(copy.GetPointer()))
+    {
+    std::cerr << "Value not removed." << std::endl;
+    return false;
+    }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+int TestInformationPerformance(int, char*[])
+{
+  if (!TestAppend())
+    {
+    return EXIT_FAILURE;
+    }
+
+  ReportStress("InformationSet", StressSet);
+  ReportStress("InformationCopy", StressCopy);
+  ReportStress("InformationGet", StressGet);
+  return EXIT_SUCCESS;
+}
@@ -24,13 +24,108 @@
 // -*- c++ -*- *******************************************************
 
 #include "vtkSortDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
 #include "vtkIntArray.h"
 #include "vtkMath.h"
+#include "vtkStringArray.h"
 #include "vtkTimerLog.h"
 
 #define ARRAY_SIZE (2*1024*1024)
 //  #define ARRAY_SIZE 128
 
+// Stable sort of material/id pairs by material, then by a second key.
+static int TestStableSort(vtkTimerLog *timer)
+{
+  vtkIdType i;
+  cout << "Building material arrays" << endl;
+  vtkIntArray *material = vtkIntArray::New();
+  material->SetNumberOfTuples(ARRAY_SIZE);
+  vtkDoubleArray *level = vtkDoubleArray::New();
+  level->SetNumberOfTuples(ARRAY_SIZE);
+  vtkIntArray *ids = vtkIntArray::New();
+  ids->SetNumberOfComponents(2);
+  ids->SetNumberOfTuples(ARRAY_SIZE);
+  for (i = 0; i < ARRAY_SIZE; i++)
+    {
+    material->SetValue(i, static_cast<int>(vtkMath::Random(0, 16)));
+    level->SetValue(i, static_cast<int>(vtkMath::Random(0, 4)));
+    ids->SetComponent(i, 0, i);
+    ids->SetComponent(i, 1, -i);
+    }
+  vtkIntArray *saveMaterial = vtkIntArray::New();
+  saveMaterial->DeepCopy(material);
+
+  cout << "Computing sort permutation" << endl;
+  vtkIdList *order = vtkIdList::New();
+  timer->StartTimer();
+  vtkSortDataArray::ArgSort(material, order);
+  timer->StopTimer();
+  cout << "Time to sort array: " << timer->GetElapsedTime() << " sec" << endl;
+
+  int status = 0;
+  for (i = 0; i < ARRAY_SIZE-1 && !status; i++)
+    {
+    int m0 = material->GetValue(order->GetId(i));
+    int m1 = material->GetValue(order->GetId(i+1));
+    if (m0 > m1 || (m0 == m1 && order->GetId(i) > order->GetId(i+1)))
+      {
+      cout << "Permutation not stably sorted!" << endl;
+      status = 1;
+      }
+    }
+
+  cout << "Sorting arrays by two keys" << endl;
+  vtkAbstractArray *keys[2] = { material, level };
+  vtkAbstractArray *values[1] = { ids };
+  timer->StartTimer();
+  vtkSortDataArray::StableSort(2, keys, 1, values);
+  timer->StopTimer();
+  cout << "Time to sort array: " << timer->GetElapsedTime() << " sec" << endl;
+
+  for (i = 0; i < ARRAY_SIZE-1 && !status; i++)
+    {
+    int m0 = material->GetValue(i);
+    int m1 = material->GetValue(i+1);
+    double l0 = level->GetValue(i);
+    double l1 = level->GetValue(i+1);
+    int id0 = ids->GetValue(2*i);
+    int id1 = ids->GetValue(2*i+2);
+    if (m0 > m1 || (m0 == m1 && (l0 > l1 || (l0 == l1 && id0 > id1))))
+      {
+      cout << "Arrays not stably sorted!" << endl;
+      status = 1;
+      }
+    if (saveMaterial->GetValue(id0) != m0 || ids->GetValue(2*i+1) != -id0)
+      {
+      cout << "Values array not consistent with keys array!" << endl;
+      status = 1;
+      }
+    }
+
+  vtkStringArray *names = vtkStringArray::New();
+  names->InsertNextValue("c");
+  names->InsertNextValue("a");
+  names->InsertNextValue("b");
+  names->InsertNextValue("a");
+  vtkSortDataArray::ArgSort(names, order);
+  if (order->GetNumberOfIds() != 4 || order->GetId(0) != 1 ||
+      order->GetId(1) != 3 || order->GetId(2) != 2 || order->GetId(3) != 0)
+    {
+    cout << "String keys not stably sorted!" << endl;
+    status = 1;
+    }
+  cout << "Stable sort check finished\n" << endl;
+
+  names->Delete();
+  order->Delete();
+  saveMaterial->Delete();
+  ids->Delete();
+  level->Delete();
+  material->Delete();
+  return status;
+}
+
 int TestSortDataArray(int, char *[])
 {
   vtkIdType i;
@@ -151,11 +246,13 @@ int TestSortDataArray(int, char *[])
     }
   cout << "Array consistency check finished\n" << endl;
 
+  int status = TestStableSort(timer);
+
   timer->Delete();
   keys->Delete();
   values->Delete();
   saveKeys->Delete();
   saveValues->Delete();
 
-  return 0;
+  return status;
 }
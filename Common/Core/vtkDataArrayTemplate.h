@@ -254,7 +254,8 @@ public:
   enum DeleteMethod
   {
     VTK_DATA_ARRAY_FREE,
-    VTK_DATA_ARRAY_DELETE
+    VTK_DATA_ARRAY_DELETE,
+    VTK_DATA_ARRAY_USER_DEFINED
   };
 //ETX
 
@@ -267,7 +268,9 @@ public:
   // suppled array. If specified, the delete method determines how the data
   // array will be deallocated. If the delete method is
   // VTK_DATA_ARRAY_FREE, free() will be used. If the delete method is
-  // DELETE, delete[] will be used. The default is FREE.
+  // DELETE, delete[] will be used. If the delete method is USER_DEFINED,
+  // the function given to SetArrayFreeFunction() will be used. The default
+  // is FREE.
   void SetArray(T* array, vtkIdType size, int save, int deleteMethod);
   void SetArray(T* array, vtkIdType size, int save)
     { this->SetArray(array, size, save, VTK_DATA_ARRAY_FREE); }
@@ -281,6 +284,14 @@ public:
       this->SetArray(static_cast<T*>(array), size, save, deleteMethod);
     }
 
+  // Description:
+  // Set the function used to release an array given to SetArray() with the
+  // VTK_DATA_ARRAY_USER_DEFINED delete method.  It must be set after
+  // SetArray(), which resets it.  Without one, free() is used.
+  //BTX
+  void SetArrayFreeFunction(void (*callback)(void *));
+  //ETX
+
   // Description:
   // This method copies the array data to the void pointer specified
   // by the user.  It is up to the user to allocate enough memory for
@@ -341,6 +352,7 @@ protected:
 
   int SaveUserArray;
   int DeleteMethod;
+  void (*DeleteFunction)(void *);
 
   virtual bool ComputeScalarRange(double* ranges);
   virtual bool ComputeVectorRange(double range[2]);
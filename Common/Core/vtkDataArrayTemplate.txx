@@ -81,6 +81,7 @@ vtkDataArrayTemplate<T>::vtkDataArrayTemplate()
   this->Tuple = 0;
   this->SaveUserArray = 0;
   this->DeleteMethod = VTK_DATA_ARRAY_FREE;
+  this->DeleteFunction = 0;
   this->Lookup = 0;
   this->RebuildLookup = true;
 }
@@ -218,16 +219,32 @@ void vtkDataArrayTemplate<T>::DeleteArray()
       {
       free(this->Array);
       }
-    else
+    else if (this->DeleteMethod == VTK_DATA_ARRAY_DELETE)
       {
       delete[] this->Array;
       }
+    else if (this->DeleteFunction)
+      {
+      this->DeleteFunction(this->Array);
+      }
+    else
+      {
+      free(this->Array);
+      }
     }
   this->SaveUserArray = 0;
   this->DeleteMethod = VTK_DATA_ARRAY_FREE;
+  this->DeleteFunction = 0;
   this->Array = 0;
 }
 
+//----------------------------------------------------------------------------
+template <class T>
+void vtkDataArrayTemplate<T>::SetArrayFreeFunction(void (*callback)(void *))
+{
+  this->DeleteFunction = callback;
+}
+
 //----------------------------------------------------------------------------
 template <class T>
 T* vtkDataArrayTemplate<T>::ResizeAndExtend(vtkIdType sz)
@@ -274,7 +291,7 @@ T* vtkDataArrayTemplate<T>::ResizeAndExtend(vtkIdType sz)
   if (this->Array
       &&
       (this->SaveUserArray
-       || this->DeleteMethod==VTK_DATA_ARRAY_DELETE
+       || this->DeleteMethod!=VTK_DATA_ARRAY_FREE
        || dontUseRealloc ))
     {
     newArray = static_cast<T*>(malloc(static_cast<size_t>(newSize)*sizeof(T)));
@@ -139,22 +139,26 @@ void vtkInformation::SetAsObjectBase(vtkInformationKey* key,
   MapType::iterator i = this->Internal->Map.find(key);
   if(i != this->Internal->Map.end())
     {
-    vtkObjectBase* oldvalue = i->second;
+    vtkObjectBase* oldvalue = i->second.Object;
     if(newvalue)
       {
-      i->second = newvalue;
+      i->second.Object = newvalue;
+      i->second.InlineLength = -1;
       newvalue->Register(0);
       }
     else
       {
       this->Internal->Map.erase(i);
       }
-    oldvalue->UnRegister(0);
+    if(oldvalue)
+      {
+      oldvalue->UnRegister(0);
+      }
     }
   else if(newvalue)
     {
-    MapType::value_type entry(key, newvalue);
-    this->Internal->Map.insert(entry);
+    MapType::value_type entry(key, vtkInformationValue());
+    this->Internal->Map.insert(entry).first->second.Object = newvalue;
     newvalue->Register(0);
     }
   this->Modified(key);
@@ -170,7 +174,7 @@ const vtkObjectBase* vtkInformation::GetAsObjectBase(
     MapType::const_iterator i = this->Internal->Map.find(const_cast<vtkInformationKey*>(key));
     if(i != this->Internal->Map.end())
       {
-      return i->second;
+      return i->second.Object;
       }
     }
   return 0;
@@ -185,12 +189,38 @@ vtkObjectBase* vtkInformation::GetAsObjectBase(vtkInformationKey* key)
     MapType::const_iterator i = this->Internal->Map.find(key);
     if(i != this->Internal->Map.end())
       {
-      return i->second;
+      return i->second.Object;
       }
     }
   return 0;
 }
 
+//----------------------------------------------------------------------------
+vtkInformationValue* vtkInformation::GetEntry(vtkInformationKey* key)
+{
+  typedef vtkInformationInternals::MapType MapType;
+  MapType::iterator i = this->Internal->Map.find(key);
+  return i != this->Internal->Map.end()? &i->second : 0;
+}
+
+//----------------------------------------------------------------------------
+vtkInformationValue* vtkInformation::SetInlineEntry(vtkInformationKey* key,
+                                                    int length)
+{
+  typedef vtkInformationInternals::MapType MapType;
+  MapType::value_type entry(key, vtkInformationValue());
+  vtkInformationValue* value =
+    &this->Internal->Map.insert(entry).first->second;
+  vtkObjectBase* oldvalue = value->Object;
+  value->Object = 0;
+  value->InlineLength = length;
+  if(oldvalue)
+    {
+    oldvalue->UnRegister(0);
+    }
+  return value;
+}
+
 //----------------------------------------------------------------------------
 void vtkInformation::Clear()
 {
@@ -200,8 +230,15 @@ void vtkInformation::Clear()
 //----------------------------------------------------------------------------
 void vtkInformation::Copy(vtkInformation* from, int deep)
 {
-  vtkInformationInternals* oldInternal = this->Internal;
-  this->Internal = new vtkInformationInternals;
+  // The old entries are released only once the copy is done since they
+  // may hold the last reference to from.  Nothing needs to be released
+  // when there are no entries, which is common for pipeline requests.
+  vtkInformationInternals* oldInternal = 0;
+  if(!this->Internal->Map.empty())
+    {
+    oldInternal = this->Internal;
+    this->Internal = new vtkInformationInternals;
+    }
   if(from)
     {
     typedef vtkInformationInternals::MapType MapType;
@@ -924,7 +961,7 @@ void vtkInformation::ReportAsObjectBase(vtkInformationKey* key,
     MapType::iterator i = this->Internal->Map.find(key);
     if(i != this->Internal->Map.end())
       {
-      vtkGarbageCollectorReport(collector, i->second, key->GetName());
+      vtkGarbageCollectorReport(collector, i->second.Object, key->GetName());
       }
     }
 }
@@ -59,6 +59,7 @@ class vtkInformationRequestKey;
 class vtkInformationStringKey;
 class vtkInformationStringVectorKey;
 class vtkInformationUnsignedLongKey;
+class vtkInformationValue;
 class vtkInformationVariantKey;
 class vtkInformationVariantVectorKey;
 class vtkInformationVector;
@@ -386,6 +387,13 @@ protected:
     const vtkInformationKey* key) const;
   VTKCOMMONCORE_EXPORT vtkObjectBase* GetAsObjectBase(vtkInformationKey* key);
 
+  // Get a map entry, or create one holding an inline value of the given
+  // length, replacing any previous value.  Used internally by the keys
+  // whose values are stored inline.
+  VTKCOMMONCORE_EXPORT vtkInformationValue* GetEntry(vtkInformationKey* key);
+  VTKCOMMONCORE_EXPORT vtkInformationValue* SetInlineEntry(
+    vtkInformationKey* key, int length);
+
   // Internal implementation details.
   vtkInformationInternals* Internal;
 
@@ -15,6 +15,7 @@
 #include "vtkInformationDoubleKey.h"
 
 #include "vtkInformation.h"
+#include "vtkInformationInternals.h"
 
 
 //----------------------------------------------------------------------------
@@ -35,49 +36,28 @@ void vtkInformationDoubleKey::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
 }
 
-//----------------------------------------------------------------------------
-class vtkInformationDoubleValue: public vtkObjectBase
-{
-public:
-  vtkTypeMacro(vtkInformationDoubleValue, vtkObjectBase);
-  double Value;
-};
-
 //----------------------------------------------------------------------------
 void vtkInformationDoubleKey::Set(vtkInformation* info, double value)
 {
-  if(vtkInformationDoubleValue* oldv =
-     static_cast<vtkInformationDoubleValue *>(
-       this->GetAsObjectBase(info)))
+  // The value is stored inline in the information object.
+  vtkInformationValue* v = this->GetInlineValue(info);
+  if(!v)
     {
-    if (oldv->Value != value)
-      {
-      // Replace the existing value.
-      oldv->Value = value;
-      // Since this sets a value without call SetAsObjectBase(),
-      // the info has to be modified here (instead of
-      // vtkInformation::SetAsObjectBase()
-      info->Modified(this);
-      }
+    v = this->SetInlineValue(info, 1);
     }
-  else
+  else if(v->Inline.Double[0] == value)
     {
-    // Allocate a new value.
-    vtkInformationDoubleValue* v = new vtkInformationDoubleValue;
-    this->ConstructClass("vtkInformationDoubleValue");
-    v->Value = value;
-    this->SetAsObjectBase(info, v);
-    v->Delete();
+    return;
     }
+  v->Inline.Double[0] = value;
+  info->Modified(this);
 }
 
 //----------------------------------------------------------------------------
 double vtkInformationDoubleKey::Get(vtkInformation* info)
 {
-  vtkInformationDoubleValue* v =
-    static_cast<vtkInformationDoubleValue *>(
-      this->GetAsObjectBase(info));
-  return v?v->Value:0;
+  vtkInformationValue* v = this->GetInlineValue(info);
+  return v?v->Inline.Double[0]:0;
 }
 
 //----------------------------------------------------------------------------
@@ -106,11 +86,6 @@ void vtkInformationDoubleKey::Print(ostream& os, vtkInformation* info)
 //----------------------------------------------------------------------------
 double* vtkInformationDoubleKey::GetWatchAddress(vtkInformation* info)
 {
-  if(vtkInformationDoubleValue* v =
-     static_cast<vtkInformationDoubleValue *>(
-       this->GetAsObjectBase(info)))
-    {
-    return &v->Value;
-    }
-  return 0;
+  vtkInformationValue* v = this->GetInlineValue(info);
+  return v?&v->Inline.Double[0]:0;
 }
@@ -15,7 +15,9 @@
 #include "vtkInformationDoubleVectorKey.h"
 
 #include "vtkInformation.h" // For vtkErrorWithObjectMacro
+#include "vtkInformationInternals.h"
 
+#include <algorithm>
 #include <vector>
 
 
@@ -50,6 +52,27 @@ public:
 //----------------------------------------------------------------------------
 void vtkInformationDoubleVectorKey::Append(vtkInformation* info, double value)
 {
+  if(vtkInformationValue* iv = this->GetInlineValue(info))
+    {
+    if(iv->InlineLength < vtkInformationValue::MaximumInlineLength)
+      {
+      iv->Inline.Double[iv->InlineLength++] = value;
+      }
+    else
+      {
+      // Too long to be stored inline any more.
+      vtkInformationDoubleVectorValue* v =
+        new vtkInformationDoubleVectorValue;
+      this->ConstructClass("vtkInformationDoubleVectorValue");
+      v->Value.insert(v->Value.begin(), iv->Inline.Double,
+                      iv->Inline.Double + iv->InlineLength);
+      v->Value.push_back(value);
+      this->SetAsObjectBase(info, v);
+      v->Delete();
+      }
+    return;
+    }
+
   vtkInformationDoubleVectorValue* v =
     static_cast<vtkInformationDoubleVectorValue *>(
       this->GetAsObjectBase(info));
@@ -80,6 +103,18 @@ void vtkInformationDoubleVectorKey::Set(vtkInformation* info, double* value,
       this->SetAsObjectBase(info, 0);
       return;
       }
+    if(length <= vtkInformationValue::MaximumInlineLength)
+      {
+      // Short vectors, such as bounds or spacing, are stored inline.
+      vtkInformationValue* iv = this->GetInlineValue(info);
+      if(!iv || iv->InlineLength != length)
+        {
+        iv = this->SetInlineValue(info, length);
+        }
+      std::copy(value, value+length, iv->Inline.Double);
+      info->Modified(this);
+      return;
+      }
     vtkInformationDoubleVectorValue* v =
       new vtkInformationDoubleVectorValue;
     this->ConstructClass("vtkInformationDoubleVectorValue");
@@ -96,6 +131,10 @@ void vtkInformationDoubleVectorKey::Set(vtkInformation* info, double* value,
 //----------------------------------------------------------------------------
 double* vtkInformationDoubleVectorKey::Get(vtkInformation* info)
 {
+  if(vtkInformationValue* iv = this->GetInlineValue(info))
+    {
+    return iv->InlineLength > 0? iv->Inline.Double : 0;
+    }
   vtkInformationDoubleVectorValue* v =
     static_cast<vtkInformationDoubleVectorValue *>(
       this->GetAsObjectBase(info));
@@ -120,22 +159,20 @@ double vtkInformationDoubleVectorKey::Get(vtkInformation* info, int idx)
 void vtkInformationDoubleVectorKey::Get(vtkInformation* info,
                                      double* value)
 {
-  vtkInformationDoubleVectorValue* v =
-    static_cast<vtkInformationDoubleVectorValue *>(
-      this->GetAsObjectBase(info));
-  if(v && value)
+  double* values = this->Get(info);
+  if(values && value)
     {
-    for(std::vector<double>::size_type i = 0;
-        i < v->Value.size(); ++i)
-      {
-      value[i] = v->Value[i];
-      }
+    std::copy(values, values + this->Length(info), value);
     }
 }
 
 //----------------------------------------------------------------------------
 int vtkInformationDoubleVectorKey::Length(vtkInformation* info)
 {
+  if(vtkInformationValue* iv = this->GetInlineValue(info))
+    {
+    return iv->InlineLength;
+    }
   vtkInformationDoubleVectorValue* v =
     static_cast<vtkInformationDoubleVectorValue *>(
       this->GetAsObjectBase(info));
@@ -15,6 +15,7 @@
 #include "vtkInformationIdTypeKey.h"
 
 #include "vtkInformation.h"
+#include "vtkInformationInternals.h"
 
 
 //----------------------------------------------------------------------------
@@ -35,49 +36,28 @@ void vtkInformationIdTypeKey::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
 }
 
-//----------------------------------------------------------------------------
-class vtkInformationIdTypeValue: public vtkObjectBase
-{
-public:
-  vtkTypeMacro(vtkInformationIdTypeValue, vtkObjectBase);
-  vtkIdType Value;
-};
-
 //----------------------------------------------------------------------------
 void vtkInformationIdTypeKey::Set(vtkInformation* info, vtkIdType value)
 {
-  if(vtkInformationIdTypeValue* oldv =
-     static_cast<vtkInformationIdTypeValue *>
-     (this->GetAsObjectBase(info)))
+  // The value is stored inline in the information object.
+  vtkInformationValue* v = this->GetInlineValue(info);
+  if(!v)
     {
-    if (oldv->Value != value)
-      {
-      // Replace the existing value.
-      oldv->Value = value;
-      // Since this sets a value without call SetAsObjectBase(),
-      // the info has to be modified here (instead of
-      // vtkInformation::SetAsObjectBase()
-      info->Modified(this);
-      }
-   }
-  else
+    v = this->SetInlineValue(info, 1);
+    }
+  else if(v->Inline.IdType == value)
     {
-    // Allocate a new value.
-    vtkInformationIdTypeValue* v = new vtkInformationIdTypeValue;
-    this->ConstructClass("vtkInformationIdTypeValue");
-    v->Value = value;
-    this->SetAsObjectBase(info, v);
-    v->Delete();
+    return;
     }
+  v->Inline.IdType = value;
+  info->Modified(this);
 }
 
 //----------------------------------------------------------------------------
 vtkIdType vtkInformationIdTypeKey::Get(vtkInformation* info)
 {
-  vtkInformationIdTypeValue* v =
-    static_cast<vtkInformationIdTypeValue *>
-    (this->GetAsObjectBase(info));
-  return v?v->Value:0;
+  vtkInformationValue* v = this->GetInlineValue(info);
+  return v?v->Inline.IdType:0;
 }
 
 //----------------------------------------------------------------------------
@@ -106,11 +86,6 @@ void vtkInformationIdTypeKey::Print(ostream& os, vtkInformation* info)
 //----------------------------------------------------------------------------
 vtkIdType* vtkInformationIdTypeKey::GetWatchAddress(vtkInformation* info)
 {
-  if(vtkInformationIdTypeValue* v =
-     static_cast<vtkInformationIdTypeValue *>
-     (this->GetAsObjectBase(info)))
-    {
-    return &v->Value;
-    }
-  return 0;
+  vtkInformationValue* v = this->GetInlineValue(info);
+  return v?&v->Inline.IdType:0;
 }
@@ -15,6 +15,7 @@
 #include "vtkInformationIntegerKey.h"
 
 #include "vtkInformation.h"
+#include "vtkInformationInternals.h"
 
 
 //----------------------------------------------------------------------------
@@ -35,49 +36,28 @@ void vtkInformationIntegerKey::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
 }
 
-//----------------------------------------------------------------------------
-class vtkInformationIntegerValue: public vtkObjectBase
-{
-public:
-  vtkTypeMacro(vtkInformationIntegerValue, vtkObjectBase);
-  int Value;
-};
-
 //----------------------------------------------------------------------------
 void vtkInformationIntegerKey::Set(vtkInformation* info, int value)
 {
-  if(vtkInformationIntegerValue* oldv =
-     static_cast<vtkInformationIntegerValue *>
-     (this->GetAsObjectBase(info)))
+  // The value is stored inline in the information object.
+  vtkInformationValue* v = this->GetInlineValue(info);
+  if(!v)
     {
-    if (oldv->Value != value)
-      {
-      // Replace the existing value.
-      oldv->Value = value;
-      // Since this sets a value without call SetAsObjectBase(),
-      // the info has to be modified here (instead of
-      // vtkInformation::SetAsObjectBase()
-      info->Modified(this);
-      }
-   }
-  else
+    v = this->SetInlineValue(info, 1);
+    }
+  else if(v->Inline.Integer[0] == value)
     {
-    // Allocate a new value.
-    vtkInformationIntegerValue* v = new vtkInformationIntegerValue;
-    this->ConstructClass("vtkInformationIntegerValue");
-    v->Value = value;
-    this->SetAsObjectBase(info, v);
-    v->Delete();
+    return;
     }
+  v->Inline.Integer[0] = value;
+  info->Modified(this);
 }
 
 //----------------------------------------------------------------------------
 int vtkInformationIntegerKey::Get(vtkInformation* info)
 {
-  vtkInformationIntegerValue* v =
-    static_cast<vtkInformationIntegerValue *>
-    (this->GetAsObjectBase(info));
-  return v?v->Value:0;
+  vtkInformationValue* v = this->GetInlineValue(info);
+  return v?v->Inline.Integer[0]:0;
 }
 
 //----------------------------------------------------------------------------
@@ -106,11 +86,6 @@ void vtkInformationIntegerKey::Print(ostream& os, vtkInformation* info)
 //----------------------------------------------------------------------------
 int* vtkInformationIntegerKey::GetWatchAddress(vtkInformation* info)
 {
-  if(vtkInformationIntegerValue* v =
-     static_cast<vtkInformationIntegerValue *>
-     (this->GetAsObjectBase(info)))
-    {
-    return &v->Value;
-    }
-  return 0;
+  vtkInformationValue* v = this->GetInlineValue(info);
+  return v?&v->Inline.Integer[0]:0;
 }
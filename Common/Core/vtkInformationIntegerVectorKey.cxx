@@ -15,6 +15,7 @@
 #include "vtkInformationIntegerVectorKey.h"
 
 #include "vtkInformation.h" // For vtkErrorWithObjectMacro
+#include "vtkInformationInternals.h"
 
 #include <algorithm>
 #include <vector>
@@ -51,6 +52,27 @@ public:
 //----------------------------------------------------------------------------
 void vtkInformationIntegerVectorKey::Append(vtkInformation* info, int value)
 {
+  if(vtkInformationValue* iv = this->GetInlineValue(info))
+    {
+    if(iv->InlineLength < vtkInformationValue::MaximumInlineLength)
+      {
+      iv->Inline.Integer[iv->InlineLength++] = value;
+      }
+    else
+      {
+      // Too long to be stored inline any more.
+      vtkInformationIntegerVectorValue* v =
+        new vtkInformationIntegerVectorValue;
+      this->ConstructClass("vtkInformationIntegerVectorValue");
+      v->Value.insert(v->Value.begin(), iv->Inline.Integer,
+                      iv->Inline.Integer + iv->InlineLength);
+      v->Value.push_back(value);
+      this->SetAsObjectBase(info, v);
+      v->Delete();
+      }
+    return;
+    }
+
   vtkInformationIntegerVectorValue* v =
     static_cast<vtkInformationIntegerVectorValue *>
     (this->GetAsObjectBase(info));
@@ -89,6 +111,19 @@ void vtkInformationIntegerVectorKey::Set(vtkInformation* info, int* value,
       return;
       }
 
+    if(length <= vtkInformationValue::MaximumInlineLength)
+      {
+      // Short vectors, such as extents, are stored inline.
+      vtkInformationValue* iv = this->GetInlineValue(info);
+      if(!iv || iv->InlineLength != length)
+        {
+        iv = this->SetInlineValue(info, length);
+        }
+      std::copy(value, value+length, iv->Inline.Integer);
+      info->Modified(this);
+      return;
+      }
+
     vtkInformationIntegerVectorValue* oldv =
       static_cast<vtkInformationIntegerVectorValue *>
       (this->GetAsObjectBase(info));
@@ -121,6 +156,10 @@ void vtkInformationIntegerVectorKey::Set(vtkInformation* info, int* value,
 //----------------------------------------------------------------------------
 int* vtkInformationIntegerVectorKey::Get(vtkInformation* info)
 {
+  if(vtkInformationValue* iv = this->GetInlineValue(info))
+    {
+    return iv->InlineLength > 0? iv->Inline.Integer : 0;
+    }
   vtkInformationIntegerVectorValue* v =
     static_cast<vtkInformationIntegerVectorValue *>
     (this->GetAsObjectBase(info));
@@ -145,22 +184,20 @@ int vtkInformationIntegerVectorKey::Get(vtkInformation* info, int idx)
 void vtkInformationIntegerVectorKey::Get(vtkInformation* info,
                                      int* value)
 {
-  vtkInformationIntegerVectorValue* v =
-    static_cast<vtkInformationIntegerVectorValue *>
-    (this->GetAsObjectBase(info));
-  if(v && value)
+  int* values = this->Get(info);
+  if(values && value)
     {
-    for(std::vector<int>::size_type i = 0;
-        i < v->Value.size(); ++i)
-      {
-      value[i] = v->Value[i];
-      }
+    std::copy(values, values + this->Length(info), value);
     }
 }
 
 //----------------------------------------------------------------------------
 int vtkInformationIntegerVectorKey::Length(vtkInformation* info)
 {
+  if(vtkInformationValue* iv = this->GetInlineValue(info))
+    {
+    return iv->InlineLength;
+    }
   vtkInformationIntegerVectorValue* v =
     static_cast<vtkInformationIntegerVectorValue *>
     (this->GetAsObjectBase(info));
@@ -194,8 +231,5 @@ void vtkInformationIntegerVectorKey::Print(ostream& os, vtkInformation* info)
 //----------------------------------------------------------------------------
 int* vtkInformationIntegerVectorKey::GetWatchAddress(vtkInformation* info)
 {
-  vtkInformationIntegerVectorValue* v =
-    static_cast<vtkInformationIntegerVectorValue*>
-    (this->GetAsObjectBase(info));
-  return (v && !v->Value.empty())?(&v->Value[0]):0;
+  return this->Get(info);
 }
@@ -31,12 +31,38 @@
 # include <vtksys/stl/map>
 #endif
 
+//----------------------------------------------------------------------------
+// Value stored for a key.  Most keys store a reference counted
+// vtkObjectBase.  Scalars and short vectors of the integer, id and double
+// keys are stored directly in the entry instead, so setting them does not
+// allocate and reference count a value object.
+class vtkInformationValue
+{
+public:
+  // Longest vector stored inline.  Large enough for extents and bounds.
+  enum { MaximumInlineLength = 6 };
+
+  vtkInformationValue(): Object(0), InlineLength(-1) {}
+
+  // The reference counted value, or NULL for an inline value.
+  vtkObjectBase* Object;
+
+  // Number of components stored inline, or -1 if Object holds the value.
+  int InlineLength;
+  union
+  {
+    int Integer[MaximumInlineLength];
+    double Double[MaximumInlineLength];
+    vtkIdType IdType;
+  } Inline;
+};
+
 //----------------------------------------------------------------------------
 class vtkInformationInternals
 {
 public:
   typedef vtkInformationKey* KeyType;
-  typedef vtkObjectBase* DataType;
+  typedef vtkInformationValue DataType;
 #ifdef VTK_INFORMATION_USE_HASH_MAP
   struct HashFun
   {
@@ -59,7 +85,7 @@ public:
     {
     for(MapType::iterator i = this->Map.begin(); i != this->Map.end(); ++i)
       {
-      if(vtkObjectBase* value = i->second)
+      if(vtkObjectBase* value = i->second.Object)
         {
         value->UnRegister(0);
         }
@@ -16,6 +16,7 @@
 
 #include "vtkDebugLeaks.h"
 #include "vtkInformation.h"
+#include "vtkInformationInternals.h"
 
 
 class vtkInformationKeyToInformationFriendship
@@ -36,6 +37,17 @@ public:
     {
     return info->GetAsObjectBase(key);
     }
+  static vtkInformationValue* GetEntry(vtkInformation* info,
+                                       vtkInformationKey* key)
+    {
+    return info->GetEntry(key);
+    }
+  static vtkInformationValue* SetInlineEntry(vtkInformation* info,
+                                             vtkInformationKey* key,
+                                             int length)
+    {
+    return info->SetInlineEntry(key, length);
+    }
   static void ReportAsObjectBase(vtkInformation* info, vtkInformationKey* key,
                                  vtkGarbageCollector* collector)
     {
@@ -105,10 +117,27 @@ const vtkObjectBase* vtkInformationKey::GetAsObjectBase(
   return vtkInformationKeyToInformationFriendship::GetAsObjectBase(info, this);
 }
 
+//----------------------------------------------------------------------------
+vtkInformationValue* vtkInformationKey::GetInlineValue(vtkInformation* info)
+{
+  vtkInformationValue* value =
+    vtkInformationKeyToInformationFriendship::GetEntry(info, this);
+  return (value && value->InlineLength >= 0)? value : 0;
+}
+
+//----------------------------------------------------------------------------
+vtkInformationValue* vtkInformationKey::SetInlineValue(vtkInformation* info,
+                                                       int length)
+{
+  return vtkInformationKeyToInformationFriendship::SetInlineEntry(info, this,
+                                                                  length);
+}
+
 //----------------------------------------------------------------------------
 int vtkInformationKey::Has(vtkInformation* info)
 {
-  return this->GetAsObjectBase(info)?1:0;
+  // Every entry holds either an object or an inline value.
+  return vtkInformationKeyToInformationFriendship::GetEntry(info, this)?1:0;
 }
 
 //----------------------------------------------------------------------------
@@ -31,6 +31,7 @@
 #include "vtkObject.h" // Need vtkTypeMacro
 
 class vtkInformation;
+class vtkInformationValue;
 
 class VTKCOMMONCORE_EXPORT vtkInformationKey : public vtkObjectBase
 {
@@ -145,6 +146,15 @@ protected:
   const vtkObjectBase* GetAsObjectBase(vtkInformation* info) const;
   vtkObjectBase* GetAsObjectBase(vtkInformation* info);
 
+  // Get the value stored inline for this key instance in the given
+  // information object, or NULL if there is none.  SetInlineValue
+  // replaces any previous value with an inline value of the given length
+  // and returns it to be filled.  The caller must call Modified on the
+  // information object.  Used by the scalar and short vector keys to avoid
+  // allocating a value object.
+  vtkInformationValue* GetInlineValue(vtkInformation* info);
+  vtkInformationValue* SetInlineValue(vtkInformation* info, int length);
+
   // Report the object associated with this key instance in the given
   // information object to the collector.
   void ReportAsObjectBase(vtkInformation* info,
@@ -28,12 +28,15 @@
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
 #include "vtkIdList.h"
+#include "vtkSMPTools.h"
 #include "vtkStdString.h"
 #include "vtkStringArray.h"
 #include "vtkVariant.h"
 #include "vtkVariantArray.h"
 
 #include <algorithm>
+#include <functional>
+#include <vector>
 
 // -------------------------------------------------------------------------
 
@@ -270,6 +273,154 @@ static void vtkSortDataArraySort11(vtkAbstractArray *keys, vtkAbstractArray *val
     }
 }
 
+// ---------------------------------------------------------------------------
+// Parallel stable sorting of tuple indices
+
+// Compare tuple indices by the value of their key.
+template<class TKey, class TComp = std::less<TKey> >
+class vtkSortDataArrayIndexLess
+{
+public:
+  vtkSortDataArrayIndexLess(const TKey *keys) : Keys(keys) {}
+  bool operator()(vtkIdType a, vtkIdType b) const
+  {
+    return this->Comp(this->Keys[a], this->Keys[b]);
+  }
+
+  const TKey *Keys;
+  TComp Comp;
+};
+
+// Stable sort of each chunk of the indices.
+template<class TComp>
+class vtkSortDataArrayChunkSort
+{
+public:
+  vtkSortDataArrayChunkSort(vtkIdType *ids, vtkIdType size,
+                            vtkIdType chunkSize, TComp comp)
+    : Ids(ids), Size(size), ChunkSize(chunkSize), Comp(comp) {}
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType chunk = begin; chunk < end; ++chunk)
+      {
+      vtkIdType first = chunk*this->ChunkSize;
+      vtkIdType last = std::min(first + this->ChunkSize, this->Size);
+      std::stable_sort(this->Ids + first, this->Ids + last, this->Comp);
+      }
+  }
+
+  vtkIdType *Ids;
+  vtkIdType Size;
+  vtkIdType ChunkSize;
+  TComp Comp;
+};
+
+// Merge pairs of consecutive sorted runs of the given width.
+template<class TComp>
+class vtkSortDataArrayRunMerge
+{
+public:
+  vtkSortDataArrayRunMerge(const vtkIdType *in, vtkIdType *out,
+                           vtkIdType size, vtkIdType width, TComp comp)
+    : In(in), Out(out), Size(size), Width(width), Comp(comp) {}
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType pair = begin; pair < end; ++pair)
+      {
+      vtkIdType first = 2*pair*this->Width;
+      vtkIdType middle = std::min(first + this->Width, this->Size);
+      vtkIdType last = std::min(first + 2*this->Width, this->Size);
+      // std::merge takes from the first run on ties, which keeps it stable.
+      std::merge(this->In + first, this->In + middle,
+                 this->In + middle, this->In + last,
+                 this->Out + first, this->Comp);
+      }
+  }
+
+  const vtkIdType *In;
+  vtkIdType *Out;
+  vtkIdType Size;
+  vtkIdType Width;
+  TComp Comp;
+};
+
+template<class TComp>
+void vtkSortDataArrayStableSort(vtkIdType *ids, vtkIdType size, TComp comp)
+{
+  // Split in chunks large enough to be worth a thread.
+  const vtkIdType minimumChunkSize = 32768;
+  vtkIdType numberOfChunks = 1;
+  while (numberOfChunks < 64 && size / (2*numberOfChunks) >= minimumChunkSize)
+    {
+    numberOfChunks *= 2;
+    }
+  if (numberOfChunks == 1)
+    {
+    std::stable_sort(ids, ids + size, comp);
+    return;
+    }
+
+  vtkIdType chunkSize = (size + numberOfChunks - 1) / numberOfChunks;
+  vtkSortDataArrayChunkSort<TComp> sorter(ids, size, chunkSize, comp);
+  vtkSMPTools::For(0, numberOfChunks, 1, sorter);
+
+  std::vector<vtkIdType> buffer(size);
+  vtkIdType *in = ids;
+  vtkIdType *out = &buffer[0];
+  for (vtkIdType width = chunkSize; width < size; width *= 2)
+    {
+    vtkSortDataArrayRunMerge<TComp> merger(in, out, size, width, comp);
+    vtkSMPTools::For(0, (size + 2*width - 1) / (2*width), 1, merger);
+    std::swap(in, out);
+    }
+  if (in != ids)
+    {
+    std::copy(in, in + size, ids);
+    }
+}
+
+template<class TKey>
+void vtkSortDataArrayArgSort(const TKey *keys, vtkIdType *ids, vtkIdType size)
+{
+  vtkSortDataArrayStableSort(ids, size, vtkSortDataArrayIndexLess<TKey>(keys));
+}
+
+// Gather the tuples of an array in the order given by the indices.
+template<class T>
+class vtkSortDataArrayGather
+{
+public:
+  vtkSortDataArrayGather(const T *in, T *out, const vtkIdType *ids,
+                         int numComp)
+    : In(in), Out(out), Ids(ids), NumComp(numComp) {}
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      const T *tuple = this->In + this->Ids[i]*this->NumComp;
+      std::copy(tuple, tuple + this->NumComp, this->Out + i*this->NumComp);
+      }
+  }
+
+  const T *In;
+  T *Out;
+  const vtkIdType *Ids;
+  int NumComp;
+};
+
+template<class T>
+void vtkSortDataArrayReorder(T *data, vtkIdType numTuples, int numComp,
+                             const vtkIdType *ids)
+{
+  if (numTuples == 0 || numComp == 0)
+    {
+    return;
+    }
+  std::vector<T> copy(data, data + numTuples*numComp);
+  vtkSortDataArrayGather<T> gather(&copy[0], data, ids, numComp);
+  vtkSMPTools::For(0, numTuples, gather);
+}
+
 // The component that qsort should use to compare tuples.
 // This is ugly and not thread-safe but it works.
 static int vtkSortDataArrayComp = 0;
@@ -594,3 +745,126 @@ void vtkSortDataArray::Sort(vtkAbstractArray *keys, vtkAbstractArray *values)
     vtkSortDataArraySort11(keys, values);
     }
 }
+
+void vtkSortDataArray::ArgSort(vtkAbstractArray *keys, vtkIdList *ids)
+{
+  vtkSortDataArray::ArgSort(1, &keys, ids);
+}
+
+void vtkSortDataArray::ArgSort(int numberOfKeys, vtkAbstractArray **keys,
+                               vtkIdList *ids)
+{
+  if (numberOfKeys < 1)
+    {
+    vtkGenericWarningMacro("No keys to sort.");
+    return;
+    }
+
+  vtkIdType size = keys[0]->GetNumberOfTuples();
+  for (int k = 0; k < numberOfKeys; k++)
+    {
+    if (keys[k]->GetNumberOfComponents() != 1)
+      {
+      vtkGenericWarningMacro("Can only sort keys that are 1-tuples.");
+      return;
+      }
+    if (keys[k]->GetNumberOfTuples() != size)
+      {
+      vtkGenericWarningMacro("Cannot sort arrays.  Key arrays have different sizes.");
+      return;
+      }
+    }
+
+  ids->SetNumberOfIds(size);
+  vtkIdType *order = ids->GetPointer(0);
+  for (vtkIdType i = 0; i < size; i++)
+    {
+    order[i] = i;
+    }
+
+  // Sort by the least significant key first. Since each pass is stable,
+  // tuples with equal keys remain ordered by the keys that follow.
+  for (int k = numberOfKeys - 1; k >= 0; k--)
+    {
+    void *data = keys[k]->GetVoidPointer(0);
+    if (keys[k]->GetDataType() == VTK_VARIANT)
+      {
+      vtkSortDataArrayStableSort(order, size,
+        vtkSortDataArrayIndexLess<vtkVariant, vtkVariantLessThan>(
+          static_cast<vtkVariant *>(data)));
+      continue;
+      }
+    switch (keys[k]->GetDataType())
+      {
+      vtkExtendedTemplateMacro(
+        vtkSortDataArrayArgSort(static_cast<VTK_TT *>(data), order, size));
+      default:
+        vtkGenericWarningMacro("Cannot sort keys of type "
+                               << keys[k]->GetDataTypeAsString());
+        return;
+      }
+    }
+}
+
+void vtkSortDataArray::Reorder(vtkIdList *ids, vtkAbstractArray *array)
+{
+  vtkIdType numTuples = array->GetNumberOfTuples();
+  if (ids->GetNumberOfIds() != numTuples)
+    {
+    vtkGenericWarningMacro("Cannot reorder array.  It does not have as many tuples as there are ids.");
+    return;
+    }
+
+  switch (array->GetDataType())
+    {
+    vtkExtraExtendedTemplateMacro(
+      vtkSortDataArrayReorder(static_cast<VTK_TT *>(array->GetVoidPointer(0)),
+                              numTuples, array->GetNumberOfComponents(),
+                              ids->GetPointer(0)));
+    default:
+      vtkGenericWarningMacro("Cannot reorder arrays of type "
+                             << array->GetDataTypeAsString());
+      return;
+    }
+  array->DataChanged();
+}
+
+void vtkSortDataArray::StableSort(vtkAbstractArray *keys, int numberOfValues,
+                                  vtkAbstractArray **values)
+{
+  vtkSortDataArray::StableSort(1, &keys, numberOfValues, values);
+}
+
+void vtkSortDataArray::StableSort(int numberOfKeys, vtkAbstractArray **keys,
+                                  int numberOfValues, vtkAbstractArray **values)
+{
+  if (numberOfKeys < 1)
+    {
+    vtkGenericWarningMacro("No keys to sort.");
+    return;
+    }
+  vtkIdType size = keys[0]->GetNumberOfTuples();
+  for (int v = 0; v < numberOfValues; v++)
+    {
+    if (values[v]->GetNumberOfTuples() != size)
+      {
+      vtkGenericWarningMacro("Could not sort arrays.  Key and value arrays have different sizes.");
+      return;
+      }
+    }
+
+  vtkIdList *ids = vtkIdList::New();
+  vtkSortDataArray::ArgSort(numberOfKeys, keys, ids);
+  if (ids->GetNumberOfIds() == size)
+    {
+    for (int k = 0; k < numberOfKeys; k++)
+      {
+      vtkSortDataArray::Reorder(ids, keys[k]);
+      }
+    for (int v = 0; v < numberOfValues; v++)
+      {
+      vtkSortDataArray::Reorder(ids, values[v]);
+      }
+    }
+  ids->Delete();
+}
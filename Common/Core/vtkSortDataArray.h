@@ -62,6 +62,33 @@ public:
   static void Sort(vtkAbstractArray *keys, vtkIdList *values);
   static void Sort(vtkAbstractArray *keys, vtkAbstractArray *values);
 
+  // Description:
+  // Compute the permutation that sorts the given keys, without modifying
+  // them: on return the i-th id is the index of the tuple with the i-th
+  // smallest key. The sort is stable, tuples with equal keys keep their
+  // relative order. When several key arrays are given, tuples are ordered
+  // by the first one, then by the second one for equal first keys, and so
+  // on. Keys must be 1-tuples and all key arrays must have the same size.
+  // The sort is performed in parallel using vtkSMPTools.
+  static void ArgSort(vtkAbstractArray *keys, vtkIdList *ids);
+  static void ArgSort(int numberOfKeys, vtkAbstractArray **keys,
+                      vtkIdList *ids);
+
+  // Description:
+  // Reorder the tuples of the given array so that its i-th tuple is the
+  // tuple found at index ids->GetId(i) before the call, such as with a
+  // permutation computed by ArgSort(). The array must have as many tuples
+  // as there are ids.
+  static void Reorder(vtkIdList *ids, vtkAbstractArray *array);
+
+  // Description:
+  // Stably sort the given keys, as ArgSort() does, and reorder the keys
+  // and the tuples of each of the value arrays accordingly.
+  static void StableSort(vtkAbstractArray *keys, int numberOfValues,
+                         vtkAbstractArray **values);
+  static void StableSort(int numberOfKeys, vtkAbstractArray **keys,
+                         int numberOfValues, vtkAbstractArray **values);
+
 protected:
   vtkSortDataArray();
   virtual ~vtkSortDataArray();
@@ -92,6 +92,22 @@ int TestGenericCell(int , char *[])
       }
     }
 
+  // Switching back to a cell type reuses the cell instantiated before
+  cell->SetCellType(VTK_TETRA);
+  vtkIdList *tetraIds = cell->GetPointIds();
+  cell->SetCellType(VTK_HEXAHEDRON);
+  if( cell->GetPointIds() == tetraIds || cell->GetNumberOfPoints() != 8 )
+    {
+    cerr << "Hexahedron not instantiated" << endl;
+    ++rval;
+    }
+  cell->SetCellType(VTK_TETRA);
+  if( cell->GetPointIds() != tetraIds || cell->GetCellType() != VTK_TETRA )
+    {
+    cerr << "Tetra not reused" << endl;
+    ++rval;
+    }
+
   cell->Delete();
 
   return rval;
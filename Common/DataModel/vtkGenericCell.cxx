@@ -59,13 +59,23 @@ vtkStandardNewMacro(vtkGenericCell);
 // Construct cell.
 vtkGenericCell::vtkGenericCell()
 {
-  this->Cell = vtkEmptyCell::New();
+  for (int i = 0; i < VTK_NUMBER_OF_CELL_TYPES; ++i)
+    {
+    this->CellStore[i] = NULL;
+    }
+  this->Cell = this->CellStore[VTK_EMPTY_CELL] = vtkEmptyCell::New();
 }
 
 //----------------------------------------------------------------------------
 vtkGenericCell::~vtkGenericCell()
 {
-  this->Cell->Delete();
+  for (int i = 0; i < VTK_NUMBER_OF_CELL_TYPES; ++i)
+    {
+    if (this->CellStore[i])
+      {
+      this->CellStore[i]->Delete();
+      }
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -363,14 +373,23 @@ void vtkGenericCell::SetCellType(int cellType)
     this->Points->UnRegister(this);
     this->PointIds->UnRegister(this);
     this->PointIds = NULL;
-    this->Cell->Delete();
 
-    vtkCell *cell = vtkGenericCell::InstantiateCell(cellType);
+    // Reuse the cell of this type instantiated by a previous call, if any.
+    vtkCell *cell = NULL;
+    if ( cellType >= 0 && cellType < VTK_NUMBER_OF_CELL_TYPES )
+      {
+      cell = this->CellStore[cellType];
+      if( !cell )
+        {
+        cell = this->CellStore[cellType] =
+          vtkGenericCell::InstantiateCell(cellType);
+        }
+      }
 
     if( !cell )
       {
       vtkErrorMacro( << "Unsupported cell type! Setting to vtkEmptyCell" );
-      cell = vtkEmptyCell::New();
+      cell = this->CellStore[VTK_EMPTY_CELL];
       }
 
     this->Cell = cell;
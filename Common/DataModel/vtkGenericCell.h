@@ -20,6 +20,11 @@
 // like any type of cell, it just dereferences an internal representation.
 // The SetCellType() methods use \#define constants; these are defined in
 // the file vtkCellType.h.
+//
+// A vtkGenericCell keeps the concrete cells it has instantiated, one per
+// cell type, so switching cell types does not allocate once every type in
+// use has been seen.  This is the only reuse it provides: it does not pool
+// the storage of vtkIdList or data array temporaries.
 
 // .SECTION See Also
 // vtkCell vtkDataSet
@@ -153,6 +158,11 @@ protected:
 
   vtkCell *Cell;
 
+  // Cells instantiated so far, indexed by cell type.  Switching between
+  // cell types, as when traversing an unstructured grid of mixed cells,
+  // reuses them instead of allocating a new cell for every switch.
+  vtkCell *CellStore[VTK_NUMBER_OF_CELL_TYPES];
+
 private:
   vtkGenericCell(const vtkGenericCell&);  // Not implemented.
   void operator=(const vtkGenericCell&);  // Not implemented.
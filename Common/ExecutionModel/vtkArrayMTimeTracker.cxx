@@ -0,0 +1,260 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkArrayMTimeTracker.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkArrayMTimeTracker.h"
+
+#include "vtkAbstractArray.h"
+#include "vtkCellArray.h"
+#include "vtkImageData.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkRectilinearGrid.h"
+#include "vtkSmartPointer.h"
+#include "vtkStructuredGrid.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+vtkStandardNewMacro(vtkArrayMTimeTracker);
+
+//----------------------------------------------------------------------------
+// Identity and modified time of a set of objects, plus plain values.
+struct vtkArrayMTimeTrackerSignature
+{
+  std::vector<const void*> Objects;
+  std::vector<unsigned long> MTimes;
+  std::vector<double> Values;
+
+  void AddObject(vtkObject* obj)
+  {
+    this->Objects.push_back(obj);
+    this->MTimes.push_back(obj ? obj->GetMTime() : 0);
+  }
+
+  void AddCellArray(vtkCellArray* cells)
+  {
+    this->AddObject(cells);
+    this->AddObject(cells ? cells->GetData() : 0);
+  }
+
+  void AddValues(const int* values, int n)
+  {
+    this->Values.insert(this->Values.end(), values, values + n);
+  }
+
+  void AddValues(const double* values, int n)
+  {
+    this->Values.insert(this->Values.end(), values, values + n);
+  }
+
+  bool operator==(const vtkArrayMTimeTrackerSignature& other) const
+  {
+    return this->Objects == other.Objects && this->MTimes == other.MTimes &&
+      this->Values == other.Values;
+  }
+};
+
+struct vtkArrayMTimeTrackerResult
+{
+  vtkSmartPointer<vtkAbstractArray> Result;
+  vtkArrayMTimeTrackerSignature Inputs;
+};
+
+class vtkArrayMTimeTrackerInternals
+{
+public:
+  vtkArrayMTimeTrackerInternals() : HasInput(false), ParametersMTime(0) {}
+
+  bool HasInput;
+  unsigned long ParametersMTime;
+  vtkArrayMTimeTrackerSignature Structure;
+  std::map<std::string, vtkArrayMTimeTrackerResult> Results;
+};
+
+//----------------------------------------------------------------------------
+static void vtkArrayMTimeTrackerGetStructure(
+  vtkDataObject* input, vtkArrayMTimeTrackerSignature& sig)
+{
+  int type = input->GetDataObjectType();
+  sig.Values.push_back(type);
+
+  vtkDataSet* ds = vtkDataSet::SafeDownCast(input);
+  if (ds)
+    {
+    sig.Values.push_back(static_cast<double>(ds->GetNumberOfPoints()));
+    sig.Values.push_back(static_cast<double>(ds->GetNumberOfCells()));
+    }
+
+  // Only the exact types below are fully described by these arrays and
+  // values. Anything else falls back to the modified time of the data
+  // object itself, which changes whenever it is shallow copied.
+  if (type == VTK_IMAGE_DATA || type == VTK_STRUCTURED_POINTS)
+    {
+    vtkImageData* image = static_cast<vtkImageData*>(input);
+    sig.AddValues(image->GetExtent(), 6);
+    sig.AddValues(image->GetOrigin(), 3);
+    sig.AddValues(image->GetSpacing(), 3);
+    }
+  else if (type == VTK_RECTILINEAR_GRID)
+    {
+    vtkRectilinearGrid* grid = static_cast<vtkRectilinearGrid*>(input);
+    sig.AddValues(grid->GetExtent(), 6);
+    sig.AddObject(grid->GetXCoordinates());
+    sig.AddObject(grid->GetYCoordinates());
+    sig.AddObject(grid->GetZCoordinates());
+    }
+  else if (type == VTK_STRUCTURED_GRID)
+    {
+    vtkStructuredGrid* grid = static_cast<vtkStructuredGrid*>(input);
+    sig.AddValues(grid->GetExtent(), 6);
+    sig.AddObject(grid->GetPoints());
+    }
+  else if (type == VTK_POLY_DATA)
+    {
+    vtkPolyData* pd = static_cast<vtkPolyData*>(input);
+    sig.AddObject(pd->GetPoints());
+    sig.AddCellArray(pd->GetVerts());
+    sig.AddCellArray(pd->GetLines());
+    sig.AddCellArray(pd->GetPolys());
+    sig.AddCellArray(pd->GetStrips());
+    }
+  else if (type == VTK_UNSTRUCTURED_GRID)
+    {
+    vtkUnstructuredGrid* ug = static_cast<vtkUnstructuredGrid*>(input);
+    sig.AddObject(ug->GetPoints());
+    sig.AddCellArray(ug->GetCells());
+    sig.AddObject(ug->GetCellTypesArray());
+    sig.AddObject(ug->GetCellLocationsArray());
+    sig.AddObject(ug->GetFaces());
+    sig.AddObject(ug->GetFaceLocations());
+    }
+  else
+    {
+    sig.Objects.push_back(input);
+    sig.MTimes.push_back(input->vtkObject::GetMTime());
+    }
+}
+
+//----------------------------------------------------------------------------
+static void vtkArrayMTimeTrackerGetInputs(
+  int numberOfInputs, vtkAbstractArray** inputs,
+  vtkArrayMTimeTrackerSignature& sig)
+{
+  for (int i = 0; i < numberOfInputs; ++i)
+    {
+    sig.AddObject(inputs[i]);
+    }
+}
+
+//----------------------------------------------------------------------------
+vtkArrayMTimeTracker::vtkArrayMTimeTracker()
+{
+  this->Internals = new vtkArrayMTimeTrackerInternals;
+}
+
+//----------------------------------------------------------------------------
+vtkArrayMTimeTracker::~vtkArrayMTimeTracker()
+{
+  delete this->Internals;
+}
+
+//----------------------------------------------------------------------------
+bool vtkArrayMTimeTracker::CheckInput(vtkDataObject* input,
+                                      unsigned long parametersMTime)
+{
+  vtkArrayMTimeTrackerSignature structure;
+  if (input)
+    {
+    vtkArrayMTimeTrackerGetStructure(input, structure);
+    }
+
+  if (input && this->Internals->HasInput &&
+      this->Internals->ParametersMTime == parametersMTime &&
+      this->Internals->Structure == structure)
+    {
+    return true;
+    }
+
+  this->Internals->Results.clear();
+  this->Internals->Structure = structure;
+  this->Internals->ParametersMTime = parametersMTime;
+  this->Internals->HasInput = (input != 0);
+  return false;
+}
+
+//----------------------------------------------------------------------------
+vtkAbstractArray* vtkArrayMTimeTracker::GetResult(
+  const char* key, int numberOfInputs, vtkAbstractArray** inputs)
+{
+  if (!key)
+    {
+    return 0;
+    }
+
+  std::map<std::string, vtkArrayMTimeTrackerResult>::iterator iter =
+    this->Internals->Results.find(key);
+  if (iter == this->Internals->Results.end())
+    {
+    return 0;
+    }
+
+  vtkArrayMTimeTrackerSignature current;
+  vtkArrayMTimeTrackerGetInputs(numberOfInputs, inputs, current);
+  if (!(current == iter->second.Inputs))
+    {
+    return 0;
+    }
+  return iter->second.Result;
+}
+
+//----------------------------------------------------------------------------
+void vtkArrayMTimeTracker::SetResult(const char* key, vtkAbstractArray* result,
+                                     int numberOfInputs,
+                                     vtkAbstractArray** inputs)
+{
+  if (!key)
+    {
+    return;
+    }
+
+  vtkArrayMTimeTrackerResult& entry = this->Internals->Results[key];
+  entry.Result = result;
+  entry.Inputs = vtkArrayMTimeTrackerSignature();
+  vtkArrayMTimeTrackerGetInputs(numberOfInputs, inputs, entry.Inputs);
+}
+
+//----------------------------------------------------------------------------
+void vtkArrayMTimeTracker::Initialize()
+{
+  this->Internals->Results.clear();
+  this->Internals->Structure = vtkArrayMTimeTrackerSignature();
+  this->Internals->ParametersMTime = 0;
+  this->Internals->HasInput = false;
+}
+
+//----------------------------------------------------------------------------
+int vtkArrayMTimeTracker::GetNumberOfResults()
+{
+  return static_cast<int>(this->Internals->Results.size());
+}
+
+//----------------------------------------------------------------------------
+void vtkArrayMTimeTracker::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfResults: " << this->GetNumberOfResults() << "\n";
+}
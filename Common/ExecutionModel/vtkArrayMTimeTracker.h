@@ -0,0 +1,93 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkArrayMTimeTracker.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkArrayMTimeTracker - Remember arrays derived from input arrays.
+// .SECTION Description
+// vtkArrayMTimeTracker lets an algorithm re-execute incrementally when only
+// some of the arrays of its input were modified. During each execution the
+// algorithm first calls CheckInput(), which compares the geometry and
+// topology of the input and the modified time of the algorithm parameters
+// with those seen by the previous execution. If they are unchanged, output
+// arrays recorded with SetResult() may be looked up with GetResult(), which
+// returns them only if the input arrays they were derived from are the same
+// arrays, with the same modified time, as when they were recorded.
+//
+// The geometry and topology are identified by the arrays defining them
+// (points, connectivity, coordinates) and by the extent, origin and spacing
+// of images, so a structure passed through upstream filters by shallow copy
+// is recognized as unchanged. Arrays modified in place must have Modified()
+// called on them for the change to be detected.
+
+#ifndef __vtkArrayMTimeTracker_h
+#define __vtkArrayMTimeTracker_h
+
+#include "vtkCommonExecutionModelModule.h" // For export macro
+#include "vtkObject.h"
+
+class vtkAbstractArray;
+class vtkDataObject;
+class vtkArrayMTimeTrackerInternals;
+
+class VTKCOMMONEXECUTIONMODEL_EXPORT vtkArrayMTimeTracker : public vtkObject
+{
+public:
+  vtkTypeMacro(vtkArrayMTimeTracker,vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent);
+  static vtkArrayMTimeTracker *New();
+
+  // Description:
+  // Compare the geometry and topology of the input and the modified time of
+  // the algorithm parameters with the ones passed to the previous call.
+  // Returns true if both are unchanged. Otherwise all recorded results are
+  // discarded, the new state is remembered and false is returned.
+  bool CheckInput(vtkDataObject* input, unsigned long parametersMTime);
+
+  // Description:
+  // Return the array recorded under the given key if the input arrays it
+  // was derived from are unchanged since it was recorded, NULL otherwise.
+  vtkAbstractArray* GetResult(const char* key, int numberOfInputs,
+                              vtkAbstractArray** inputs);
+  vtkAbstractArray* GetResult(const char* key, vtkAbstractArray* input)
+    { return this->GetResult(key, 1, &input); }
+
+  // Description:
+  // Record result as derived from the current state of the given input
+  // arrays. The result is referenced by the tracker until it is replaced
+  // or discarded.
+  void SetResult(const char* key, vtkAbstractArray* result,
+                 int numberOfInputs, vtkAbstractArray** inputs);
+  void SetResult(const char* key, vtkAbstractArray* result,
+                 vtkAbstractArray* input)
+    { this->SetResult(key, result, 1, &input); }
+
+  // Description:
+  // Discard all recorded state.
+  void Initialize();
+
+  // Description:
+  // Return the number of results currently recorded.
+  int GetNumberOfResults();
+
+protected:
+  vtkArrayMTimeTracker();
+  ~vtkArrayMTimeTracker();
+
+  vtkArrayMTimeTrackerInternals* Internals;
+
+private:
+  vtkArrayMTimeTracker(const vtkArrayMTimeTracker&);  // Not implemented.
+  void operator=(const vtkArrayMTimeTracker&);  // Not implemented.
+};
+
+#endif
@@ -0,0 +1,181 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestIncrementalArrayUpdate.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Tests the IncrementalUpdate mode of vtkCellDataToPointData and
+// vtkArrayCalculator: only results derived from modified arrays are
+// recomputed.
+
+#include <vtkArrayCalculator.h>
+#include <vtkCellData.h>
+#include <vtkCellDataToPointData.h>
+#include <vtkDataSetTriangleFilter.h>
+#include <vtkDoubleArray.h>
+#include <vtkImageData.h>
+#include <vtkPointData.h>
+#include <vtkSmartPointer.h>
+#include <vtkUnstructuredGrid.h>
+
+#include <cmath>
+
+#define vsp(type, name) \
+        vtkSmartPointer<vtk##type> name = vtkSmartPointer<vtk##type>::New()
+
+namespace
+{
+void AddCellArray(vtkDataSet* ds, const char* name, double scale)
+{
+  vsp(DoubleArray, array);
+  array->SetName(name);
+  array->SetNumberOfTuples(ds->GetNumberOfCells());
+  for (vtkIdType i = 0; i < ds->GetNumberOfCells(); ++i)
+    {
+    array->SetValue(i, scale * i);
+    }
+  ds->GetCellData()->AddArray(array);
+}
+
+void ScaleArray(vtkDataArray* array, double scale)
+{
+  for (vtkIdType i = 0; i < array->GetNumberOfTuples(); ++i)
+    {
+    array->SetTuple1(i, scale * array->GetTuple1(i));
+    }
+  array->Modified();
+}
+
+bool SameValues(vtkDataArray* x, vtkDataArray* y)
+{
+  if (!x || !y || x->GetNumberOfTuples() != y->GetNumberOfTuples())
+    {
+    return false;
+    }
+  for (vtkIdType i = 0; i < x->GetNumberOfTuples(); ++i)
+    {
+    if (fabs(x->GetTuple1(i) - y->GetTuple1(i)) > 1e-6)
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
+// Check that after modifying "a" only its point array is recomputed, and
+// that the results match a non incremental execution.
+bool TestCellDataToPointData(vtkDataSet* input)
+{
+  vsp(CellDataToPointData, c2p);
+  c2p->SetInputData(input);
+  c2p->IncrementalUpdateOn();
+  c2p->Update();
+
+  vtkPointData* pd = c2p->GetOutput()->GetPointData();
+  vtkDataArray* a0 = pd->GetArray("a");
+  vtkDataArray* b0 = pd->GetArray("b");
+  if (!a0 || !b0)
+    {
+    cerr << "Missing point arrays" << endl;
+    return false;
+    }
+
+  ScaleArray(input->GetCellData()->GetArray("a"), 2.0);
+  c2p->Update();
+  pd = c2p->GetOutput()->GetPointData();
+  if (pd->GetArray("b") != b0 || pd->GetArray("a") == a0)
+    {
+    cerr << "Expected b to be reused and a to be recomputed" << endl;
+    return false;
+    }
+
+  vsp(CellDataToPointData, reference);
+  reference->SetInputData(input);
+  reference->Update();
+  vtkPointData* refPD = reference->GetOutput()->GetPointData();
+  if (!SameValues(pd->GetArray("a"), refPD->GetArray("a")) ||
+      !SameValues(pd->GetArray("b"), refPD->GetArray("b")))
+    {
+    cerr << "Incremental results differ from the reference" << endl;
+    return false;
+    }
+
+  // a change of parameters discards the previous results
+  c2p->PassCellDataOn();
+  c2p->Update();
+  if (c2p->GetOutput()->GetPointData()->GetArray("b") == b0)
+    {
+    cerr << "Expected b to be recomputed" << endl;
+    return false;
+    }
+  return true;
+}
+}
+
+int TestIncrementalArrayUpdate(int, char*[])
+{
+  vsp(ImageData, image);
+  image->SetDimensions(5, 5, 5);
+  AddCellArray(image, "a", 1.0);
+  AddCellArray(image, "b", 3.0);
+
+  if (!TestCellDataToPointData(image))
+    {
+    return EXIT_FAILURE;
+    }
+
+  // unstructured grids take a different code path
+  vsp(DataSetTriangleFilter, tetra);
+  tetra->SetInputData(image);
+  tetra->Update();
+  vsp(UnstructuredGrid, grid);
+  grid->DeepCopy(tetra->GetOutput());
+
+  if (!TestCellDataToPointData(grid))
+    {
+    return EXIT_FAILURE;
+    }
+
+  // the calculator only depends on "a"
+  vsp(ArrayCalculator, calc);
+  calc->SetInputData(image);
+  calc->SetAttributeModeToUseCellData();
+  calc->AddScalarArrayName("a");
+  calc->SetFunction("a*2");
+  calc->SetResultArrayName("result");
+  calc->IncrementalUpdateOn();
+  calc->Update();
+  vtkDataArray* result =
+    calc->GetImageDataOutput()->GetCellData()->GetArray("result");
+
+  ScaleArray(image->GetCellData()->GetArray("b"), 2.0);
+  calc->Update();
+  if (calc->GetImageDataOutput()->GetCellData()->GetArray("result") != result)
+    {
+    cerr << "Expected the calculator result to be reused" << endl;
+    return EXIT_FAILURE;
+    }
+
+  ScaleArray(image->GetCellData()->GetArray("a"), 2.0);
+  calc->Update();
+  vtkDataArray* a = image->GetCellData()->GetArray("a");
+  result = calc->GetImageDataOutput()->GetCellData()->GetArray("result");
+  for (vtkIdType i = 0; i < a->GetNumberOfTuples(); ++i)
+    {
+    if (result->GetTuple1(i) != 2.0 * a->GetTuple1(i))
+      {
+      cerr << "Wrong calculator result after modifying its input" << endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -14,6 +14,7 @@
 =========================================================================*/
 #include "vtkArrayCalculator.h"
 
+#include "vtkArrayMTimeTracker.h"
 #include "vtkCellData.h"
 #include "vtkDataSet.h"
 #include "vtkDoubleArray.h"
@@ -28,6 +29,8 @@
 #include "vtkPolyData.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <vector>
+
 vtkStandardNewMacro(vtkArrayCalculator);
 
 vtkArrayCalculator::vtkArrayCalculator()
@@ -58,6 +61,9 @@ vtkArrayCalculator::vtkArrayCalculator()
   this->ReplacementValue = 0.0;
 
   this->ResultArrayType=VTK_DOUBLE;
+
+  this->IncrementalUpdate = 0;
+  this->Tracker = vtkArrayMTimeTracker::New();
 }
 
 vtkArrayCalculator::~vtkArrayCalculator()
@@ -66,6 +72,7 @@ vtkArrayCalculator::~vtkArrayCalculator()
 
   this->FunctionParser->Delete();
   this->FunctionParser = NULL;
+  this->Tracker->Delete();
 
   if (this->Function)
     {
@@ -427,6 +434,32 @@ int vtkArrayCalculator::RequestData(
     vtkWarningMacro("ResultNormals specified but output is scalar");
     }
 
+  // Look for a result of the previous execution computed from the same
+  // arrays
+  std::vector<vtkAbstractArray*> usedArrays;
+  vtkDataArray* reusedArray = 0;
+  if (this->IncrementalUpdate && !this->CoordinateResults)
+    {
+    for (i = 0; i < this->NumberOfScalarArrays; i++)
+      {
+      usedArrays.push_back(inFD->GetAbstractArray(this->ScalarArrayNames[i]));
+      }
+    for (i = 0; i < this->NumberOfVectorArrays; i++)
+      {
+      usedArrays.push_back(inFD->GetAbstractArray(this->VectorArrayNames[i]));
+      }
+    if (this->Tracker->CheckInput(input, this->GetMTime()))
+      {
+      reusedArray = vtkDataArray::SafeDownCast(this->Tracker->GetResult(
+          this->ResultArrayName, static_cast<int>(usedArrays.size()),
+          usedArrays.empty() ? NULL : &usedArrays[0]));
+      }
+    }
+  else
+    {
+    this->Tracker->Initialize();
+    }
+
   if(resultType == VECTOR_RESULT &&
      CoordinateResults != 0 && (psOutput || graphOutput))
     {
@@ -448,85 +481,101 @@ int vtkArrayCalculator::RequestData(
       }
     return 1;
     }
-  else
+  else if (reusedArray)
     {
-      resultArray=
-        vtkDataArray::SafeDownCast(vtkAbstractArray::CreateArray(this->ResultArrayType));
-    }
-
-  if (resultType == SCALAR_RESULT)
-    {
-    resultArray->SetNumberOfComponents(1);
-    resultArray->SetNumberOfTuples(numTuples);
-    scalarResult[0] = this->FunctionParser->GetScalarResult();
-    resultArray->SetTuple(0, scalarResult);
+    resultArray = reusedArray;
+    resultArray->Register(this);
     }
   else
     {
-    resultArray->Allocate(numTuples * 3);
-    resultArray->SetNumberOfComponents(3);
-    resultArray->SetNumberOfTuples(numTuples);
-    resultArray->SetTuple(0, this->FunctionParser->GetVectorResult());
+      resultArray=
+        vtkDataArray::SafeDownCast(vtkAbstractArray::CreateArray(this->ResultArrayType));
     }
 
-  for (i = 1; i < numTuples; i++)
+  // evaluate the function unless the previous result is reused
+  if (!reusedArray)
     {
-    for (j = 0; j < this->NumberOfScalarArrays; j++)
+    if (resultType == SCALAR_RESULT)
       {
-      currentArray = inFD->GetArray(this->ScalarArrayNames[j]);
-      if(currentArray)
-        {
-        this->FunctionParser->
-          SetScalarVariableValue(
-            j, currentArray->GetComponent(i, this->SelectedScalarComponents[j]));
-        }
+      resultArray->SetNumberOfComponents(1);
+      resultArray->SetNumberOfTuples(numTuples);
+      scalarResult[0] = this->FunctionParser->GetScalarResult();
+      resultArray->SetTuple(0, scalarResult);
       }
-    for (j = 0; j < this->NumberOfVectorArrays; j++)
+    else
       {
-      currentArray = inFD->GetArray(this->VectorArrayNames[j]);
-      this->FunctionParser->
-        SetVectorVariableValue(
-          j, currentArray->GetComponent(i, this->SelectedVectorComponents[j][0]),
-          currentArray->GetComponent(
-            i, this->SelectedVectorComponents[j][1]),
-          currentArray->GetComponent(i, this->SelectedVectorComponents[j][2]));
+      resultArray->Allocate(numTuples * 3);
+      resultArray->SetNumberOfComponents(3);
+      resultArray->SetNumberOfTuples(numTuples);
+      resultArray->SetTuple(0, this->FunctionParser->GetVectorResult());
       }
-    if(attributeDataType == POINT_DATA)
+
+    for (i = 1; i < numTuples; i++)
       {
-      double* pt = 0;
-      if (dsInput)
+      for (j = 0; j < this->NumberOfScalarArrays; j++)
         {
-        pt = dsInput->GetPoint(i);
+        currentArray = inFD->GetArray(this->ScalarArrayNames[j]);
+        if(currentArray)
+          {
+          this->FunctionParser->
+            SetScalarVariableValue(
+              j, currentArray->GetComponent(i, this->SelectedScalarComponents[j]));
+          }
         }
-      else
+      for (j = 0; j < this->NumberOfVectorArrays; j++)
         {
-        pt = graphInput->GetPoint(i);
+        currentArray = inFD->GetArray(this->VectorArrayNames[j]);
+        this->FunctionParser->
+          SetVectorVariableValue(
+            j, currentArray->GetComponent(i, this->SelectedVectorComponents[j][0]),
+            currentArray->GetComponent(
+              i, this->SelectedVectorComponents[j][1]),
+            currentArray->GetComponent(i, this->SelectedVectorComponents[j][2]));
         }
-      for (j = 0; j < this->NumberOfCoordinateScalarArrays; j++)
+      if(attributeDataType == POINT_DATA)
         {
-        this->FunctionParser->
-          SetScalarVariableValue(
-            j+this->NumberOfScalarArrays, pt[this->SelectedCoordinateScalarComponents[j]]);
+        double* pt = 0;
+        if (dsInput)
+          {
+          pt = dsInput->GetPoint(i);
+          }
+        else
+          {
+          pt = graphInput->GetPoint(i);
+          }
+        for (j = 0; j < this->NumberOfCoordinateScalarArrays; j++)
+          {
+          this->FunctionParser->
+            SetScalarVariableValue(
+              j+this->NumberOfScalarArrays, pt[this->SelectedCoordinateScalarComponents[j]]);
+          }
+        for (j = 0; j < this->NumberOfCoordinateVectorArrays; j++)
+          {
+          this->FunctionParser->
+            SetVectorVariableValue(
+              j+this->NumberOfVectorArrays,
+              pt[this->SelectedCoordinateVectorComponents[j][0]],
+              pt[this->SelectedCoordinateVectorComponents[j][1]],
+              pt[this->SelectedCoordinateVectorComponents[j][2]]);
+          }
         }
-      for (j = 0; j < this->NumberOfCoordinateVectorArrays; j++)
+      if (resultType == SCALAR_RESULT)
         {
-        this->FunctionParser->
-          SetVectorVariableValue(
-            j+this->NumberOfVectorArrays,
-            pt[this->SelectedCoordinateVectorComponents[j][0]],
-            pt[this->SelectedCoordinateVectorComponents[j][1]],
-            pt[this->SelectedCoordinateVectorComponents[j][2]]);
+        scalarResult[0] = this->FunctionParser->GetScalarResult();
+        resultArray->SetTuple(i, scalarResult);
+        }
+      else
+        {
+        resultArray->SetTuple(i, this->FunctionParser->GetVectorResult());
         }
       }
-    if (resultType == SCALAR_RESULT)
-      {
-      scalarResult[0] = this->FunctionParser->GetScalarResult();
-      resultArray->SetTuple(i, scalarResult);
-      }
-    else
-      {
-      resultArray->SetTuple(i, this->FunctionParser->GetVectorResult());
-      }
+    }
+
+  if (this->IncrementalUpdate && !reusedArray && !resultPoints)
+    {
+    this->Tracker->SetResult(this->ResultArrayName, resultArray,
+                             static_cast<int>(usedArrays.size()),
+                             usedArrays.empty() ? NULL : &usedArrays[0]);
     }
 
   CopyDataSetOrGraph (dsInput, dsOutput, graphInput, graphOutput);
@@ -1260,4 +1309,6 @@ void vtkArrayCalculator::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Replace Invalid Values: "
      << (this->ReplaceInvalidValues ? "On" : "Off") << endl;
   os << indent << "Replacement Value: " << this->ReplacementValue << endl;
+  os << indent << "Incremental Update: "
+     << (this->IncrementalUpdate ? "On" : "Off") << endl;
 }
@@ -61,6 +61,7 @@
 #include "vtkFiltersCoreModule.h" // For export macro
 #include "vtkDataSetAlgorithm.h"
 
+class vtkArrayMTimeTracker;
 class vtkFunctionParser;
 
 #define VTK_ATTRIBUTE_MODE_DEFAULT 0
@@ -217,6 +218,15 @@ public:
   vtkSetMacro(ReplacementValue,double);
   vtkGetMacro(ReplacementValue,double);
 
+  // Description:
+  // When IncrementalUpdate is on, the result array of the previous
+  // execution is reused if neither the arrays used by the function nor the
+  // geometry and topology of the input were modified since. It does not
+  // apply when CoordinateResults is on. Off by default.
+  vtkSetMacro(IncrementalUpdate,int);
+  vtkGetMacro(IncrementalUpdate,int);
+  vtkBooleanMacro(IncrementalUpdate,int);
+
 protected:
   vtkArrayCalculator();
   ~vtkArrayCalculator();
@@ -250,6 +260,9 @@ protected:
   int     NumberOfCoordinateVectorArrays;
 
   int     ResultArrayType;
+
+  int     IncrementalUpdate;
+  vtkArrayMTimeTracker* Tracker;
 private:
   vtkArrayCalculator(const vtkArrayCalculator&);  // Not implemented.
   void operator=(const vtkArrayCalculator&);  // Not implemented.
@@ -14,6 +14,7 @@
 =========================================================================*/
 #include "vtkCellDataToPointData.h"
 
+#include "vtkArrayMTimeTracker.h"
 #include "vtkCellData.h"
 #include "vtkCell.h"
 #include "vtkDataSet.h"
@@ -29,6 +30,8 @@
 
 #include <algorithm>
 #include <functional>
+#include <utility>
+#include <vector>
 
 vtkStandardNewMacro(vtkCellDataToPointData);
 
@@ -37,6 +40,75 @@ vtkStandardNewMacro(vtkCellDataToPointData);
 vtkCellDataToPointData::vtkCellDataToPointData()
 {
   this->PassCellData = 0;
+  this->IncrementalUpdate = 0;
+  this->Tracker = vtkArrayMTimeTracker::New();
+}
+
+//----------------------------------------------------------------------------
+vtkCellDataToPointData::~vtkCellDataToPointData()
+{
+  this->Tracker->Delete();
+}
+
+//----------------------------------------------------------------------------
+// Helpers for incremental updates. Pairs of a cell array and the point
+// array computed from it by a previous execution.
+namespace
+{
+  typedef std::vector<std::pair<vtkAbstractArray*, vtkAbstractArray*> >
+    ReusedArraysType;
+
+  // Remove from cd the arrays whose point array can be reused.
+  void RemoveReusedArrays(vtkArrayMTimeTracker* tracker, vtkCellData* cd,
+                          ReusedArraysType& reused)
+  {
+    for (int i = cd->GetNumberOfArrays(); i--;)
+      {
+      vtkAbstractArray* array = cd->GetAbstractArray(i);
+      vtkAbstractArray* result = tracker->GetResult(array->GetName(), array);
+      if (result)
+        {
+        reused.push_back(std::make_pair(array, result));
+        cd->RemoveArray(i);
+        }
+      }
+  }
+
+  // Add the reused point arrays to pd, with the attribute designation of the
+  // cell arrays they were computed from in cd.
+  void AddReusedArrays(vtkCellData* cd, vtkPointData* pd,
+                       const ReusedArraysType& reused)
+  {
+    for (ReusedArraysType::const_iterator iter = reused.begin();
+         iter != reused.end(); ++iter)
+      {
+      pd->AddArray(iter->second);
+      for (int t = 0; t < vtkDataSetAttributes::NUM_ATTRIBUTES; ++t)
+        {
+        if (cd->GetAbstractAttribute(t) == iter->first)
+          {
+          pd->SetActiveAttribute(iter->second->GetName(), t);
+          }
+        }
+      }
+  }
+
+  // Remember the point arrays of pd computed from the arrays of cd. Arrays
+  // passed from the input point data rather than computed are skipped.
+  void RecordResults(vtkArrayMTimeTracker* tracker, vtkCellData* cd,
+                     vtkPointData* inPD, vtkPointData* pd)
+  {
+    for (int i = 0; i < cd->GetNumberOfArrays(); ++i)
+      {
+      vtkAbstractArray* array = cd->GetAbstractArray(i);
+      const char* name = array->GetName();
+      vtkAbstractArray* result = name ? pd->GetAbstractArray(name) : 0;
+      if (result && result != inPD->GetAbstractArray(name))
+        {
+        tracker->SetResult(name, result, array);
+        }
+      }
+  }
 }
 
 #define VTK_MAX_CELLS_PER_POINT 4096
@@ -67,12 +139,27 @@ int vtkCellDataToPointData::RequestData(
   vtkIdType numCells, numPts;
   vtkCellData *inPD=input->GetCellData();
   vtkPointData *outPD=output->GetPointData();
+  vtkSmartPointer<vtkCellData> changedCD;
+  ReusedArraysType reused;
   vtkIdList *cellIds;
   double weight;
   double *weights;
 
   vtkDebugMacro(<<"Mapping cell data to point data");
 
+  // Only interpolate the cell arrays that changed since the last execution
+  if (!this->IncrementalUpdate)
+    {
+    this->Tracker->Initialize();
+    }
+  else if (this->Tracker->CheckInput(input, this->GetMTime()))
+    {
+    changedCD = vtkSmartPointer<vtkCellData>::New();
+    changedCD->PassData(inPD);
+    RemoveReusedArrays(this->Tracker, changedCD, reused);
+    inPD = changedCD;
+    }
+
   // First, copy the input to the output as a starting point
   output->CopyStructure( input );
 
@@ -100,6 +187,11 @@ int vtkCellDataToPointData::RequestData(
 
   int abort=0;
   vtkIdType progressInterval=numPts/20 + 1;
+  // nothing to interpolate when all point arrays are reused
+  if (changedCD && changedCD->GetNumberOfArrays() == 0)
+    {
+    numPts = 0;
+    }
   for (ptId=0; ptId < numPts && !abort; ptId++)
     {
     if ( !(ptId % progressInterval) )
@@ -125,6 +217,12 @@ int vtkCellDataToPointData::RequestData(
       }
     }
 
+  if (this->IncrementalUpdate && !abort)
+    {
+    AddReusedArrays(input->GetCellData(), outPD, reused);
+    RecordResults(this->Tracker, inPD, input->GetPointData(), outPD);
+    }
+
   if ( !this->PassCellData )
     {
     output->GetCellData()->CopyAllOff();
@@ -144,6 +242,8 @@ void vtkCellDataToPointData::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os,indent);
 
   os << indent << "Pass Cell Data: " << (this->PassCellData ? "On\n" : "Off\n");
+  os << indent << "Incremental Update: "
+     << (this->IncrementalUpdate ? "On\n" : "Off\n");
 }
 
 //----------------------------------------------------------------------------
@@ -212,23 +312,6 @@ int vtkCellDataToPointData::RequestDataForUnstructuredGrid
     return 1;
     }
 
-  // count the number of cells associated with each point
-  vtkSmartPointer<vtkUnsignedIntArray> num
-    = vtkSmartPointer<vtkUnsignedIntArray>::New();
-  num->SetNumberOfComponents(1);
-  num->SetNumberOfTuples(npoints);
-  std::fill_n(num->GetPointer(0), npoints, 0u);
-  vtkNew<vtkIdList> pids;
-  for (vtkIdType cid = 0; cid < ncells; ++cid)
-    {
-    src->GetCellPoints(cid, pids.GetPointer());
-    for (vtkIdType i = 0, I = pids->GetNumberOfIds(); i < I; ++i)
-      {
-      vtkIdType const pid = pids->GetId(i);
-      num->SetValue(pid, num->GetValue(pid)+1);
-      }
-    }
-
   // First, copy the input to the output as a starting point
   dst->CopyStructure(src);
   vtkPointData* const opd = dst->GetPointData();
@@ -244,6 +327,17 @@ int vtkCellDataToPointData::RequestDataForUnstructuredGrid
   vtkSmartPointer<vtkCellData> clean = vtkSmartPointer<vtkCellData>::New();
   clean->PassData(src->GetCellData());
 
+  // Only average the cell arrays that changed since the last execution
+  ReusedArraysType reused;
+  if (!this->IncrementalUpdate)
+    {
+    this->Tracker->Initialize();
+    }
+  else if (this->Tracker->CheckInput(src, this->GetMTime()))
+    {
+    RemoveReusedArrays(this->Tracker, clean, reused);
+    }
+
   // Remove all fields that are not a data array.
   for (vtkIdType fid = clean->GetNumberOfArrays(); fid--;)
     {
@@ -253,6 +347,27 @@ int vtkCellDataToPointData::RequestDataForUnstructuredGrid
       }
     }
 
+  // count the number of cells associated with each point, unless all point
+  // arrays are reused
+  vtkSmartPointer<vtkUnsignedIntArray> num
+    = vtkSmartPointer<vtkUnsignedIntArray>::New();
+  if (clean->GetNumberOfArrays() > 0)
+    {
+    num->SetNumberOfComponents(1);
+    num->SetNumberOfTuples(npoints);
+    std::fill_n(num->GetPointer(0), npoints, 0u);
+    vtkNew<vtkIdList> pids;
+    for (vtkIdType cid = 0; cid < ncells; ++cid)
+      {
+      src->GetCellPoints(cid, pids.GetPointer());
+      for (vtkIdType i = 0, I = pids->GetNumberOfIds(); i < I; ++i)
+        {
+        vtkIdType const pid = pids->GetId(i);
+        num->SetValue(pid, num->GetValue(pid)+1);
+        }
+      }
+    }
+
   // Cell field list constructed from the filtered cell data array
   vtkDataSetAttributes::FieldList cfl(1);
   cfl.InitializeFieldList(clean);
@@ -296,6 +411,12 @@ int vtkCellDataToPointData::RequestDataForUnstructuredGrid
       }
     }
 
+  if (this->IncrementalUpdate && !this->GetAbortExecute())
+    {
+    AddReusedArrays(src->GetCellData(), opd, reused);
+    RecordResults(this->Tracker, clean, src->GetPointData(), opd);
+    }
+
   if (!this->PassCellData)
     {
     dst->GetCellData()->CopyAllOff();
@@ -19,6 +19,11 @@
 // points). The method of transformation is based on averaging the data
 // values of all cells using a particular point. Optionally, the input cell
 // data can be passed through to the output as well.
+//
+// When IncrementalUpdate is on and the geometry and topology of the input
+// are unchanged since the previous execution, only the cell arrays that were
+// modified (or are new) are averaged again; the point arrays computed for the
+// others are reused.
 
 // .SECTION Caveats
 // This filter is an abstract filter, that is, the output is an abstract type
@@ -36,6 +41,7 @@
 #include "vtkFiltersCoreModule.h" // For export macro
 #include "vtkDataSetAlgorithm.h"
 
+class vtkArrayMTimeTracker;
 class vtkDataSet;
 
 class VTKFILTERSCORE_EXPORT vtkCellDataToPointData : public vtkDataSetAlgorithm
@@ -53,9 +59,18 @@ public:
   vtkGetMacro(PassCellData,int);
   vtkBooleanMacro(PassCellData,int);
 
+  // Description:
+  // Control whether point arrays computed by the previous execution are
+  // reused for cell arrays that were not modified since, provided the
+  // geometry and topology of the input did not change either. Off by
+  // default.
+  vtkSetMacro(IncrementalUpdate,int);
+  vtkGetMacro(IncrementalUpdate,int);
+  vtkBooleanMacro(IncrementalUpdate,int);
+
 protected:
   vtkCellDataToPointData();
-  ~vtkCellDataToPointData() {}
+  ~vtkCellDataToPointData();
 
   virtual int RequestData(vtkInformation* request,
                           vtkInformationVector** inputVector,
@@ -66,6 +81,8 @@ protected:
     (vtkInformation*, vtkInformationVector**, vtkInformationVector*);
 
   int PassCellData;
+  int IncrementalUpdate;
+  vtkArrayMTimeTracker* Tracker;
 private:
   vtkCellDataToPointData(const vtkCellDataToPointData&);  // Not implemented.
   void operator=(const vtkCellDataToPointData&);  // Not implemented.
@@ -0,0 +1,163 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestTemporalCachePrefetch.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "vtkDataObject.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkObjectFactory.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTemporalDataSetCache.h"
+
+//
+// This test checks that vtkTemporalDataSetCache prefetches the time step
+// following the one requested, in the direction of playback, so that the
+// next request is served from the cache.
+//
+
+//-------------------------------------------------------------------------
+// Sphere source advertising time steps 0..9 and counting its executions.
+//-------------------------------------------------------------------------
+class vtkPrefetchSphereSource : public vtkSphereSource
+{
+public:
+  static vtkPrefetchSphereSource *New();
+  vtkTypeMacro(vtkPrefetchSphereSource, vtkSphereSource);
+
+  int ExecuteCount;
+
+protected:
+  vtkPrefetchSphereSource() : ExecuteCount(0) {}
+
+  virtual int RequestInformation(vtkInformation* request,
+                                 vtkInformationVector** inputVector,
+                                 vtkInformationVector* outputVector)
+  {
+    if (!this->Superclass::RequestInformation(request, inputVector,
+                                              outputVector))
+      {
+      return 0;
+      }
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    double steps[10];
+    for (int i = 0; i < 10; ++i)
+      {
+      steps[i] = i;
+      }
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_STEPS(), steps, 10);
+    double range[2] = { steps[0], steps[9] };
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_RANGE(), range, 2);
+    return 1;
+  }
+
+  virtual int RequestData(vtkInformation* request,
+                          vtkInformationVector** inputVector,
+                          vtkInformationVector* outputVector)
+  {
+    ++this->ExecuteCount;
+    return this->Superclass::RequestData(request, inputVector, outputVector);
+  }
+};
+
+vtkStandardNewMacro(vtkPrefetchSphereSource);
+
+//-------------------------------------------------------------------------
+static bool RequestTime(vtkTemporalDataSetCache* cache, double time)
+{
+  vtkStreamingDemandDrivenPipeline* sdd =
+    vtkStreamingDemandDrivenPipeline::SafeDownCast(cache->GetExecutive());
+  sdd->SetUpdateTimeStep(0, time);
+  cache->Update();
+  cache->WaitForPrefetch();
+
+  vtkDataObject* output = cache->GetOutputDataObject(0);
+  if (output->GetInformation()->Get(vtkDataObject::DATA_TIME_STEP()) != time)
+    {
+    cerr << "Wrong time step in output, expected " << time << endl;
+    return false;
+    }
+  return true;
+}
+
+//-------------------------------------------------------------------------
+static bool CheckCount(vtkPrefetchSphereSource* source, int expected)
+{
+  if (source->ExecuteCount != expected)
+    {
+    cerr << "Source executed " << source->ExecuteCount
+         << " times, expected " << expected << endl;
+    return false;
+    }
+  return true;
+}
+
+//-------------------------------------------------------------------------
+int TestTemporalCachePrefetch(int , char *[])
+{
+  vtkSmartPointer<vtkPrefetchSphereSource> source =
+    vtkSmartPointer<vtkPrefetchSphereSource>::New();
+
+  vtkSmartPointer<vtkTemporalDataSetCache> cache =
+    vtkSmartPointer<vtkTemporalDataSetCache>::New();
+  cache->SetInputConnection(source->GetOutputPort());
+  cache->SetCacheSize(10);
+  cache->PrefetchOn();
+  cache->UpdateInformation();
+
+  // forward playback: each request after the first is a cache hit and
+  // triggers the prefetch of the following step
+  for (int i = 0; i < 5; ++i)
+    {
+    if (!RequestTime(cache, i) || !CheckCount(source, i + 2))
+      {
+      return EXIT_FAILURE;
+      }
+    }
+
+  // backward playback over cached steps does not execute the source
+  if (!RequestTime(cache, 3) || !CheckCount(source, 6))
+    {
+    return EXIT_FAILURE;
+    }
+
+  // jumping to the last step executes it, nothing follows it
+  if (!RequestTime(cache, 9) || !CheckCount(source, 7))
+    {
+    return EXIT_FAILURE;
+    }
+
+  // stepping backwards prefetches the previous step
+  if (!RequestTime(cache, 8) || !CheckCount(source, 9))
+    {
+    return EXIT_FAILURE;
+    }
+
+  // a tiny memory budget disables prefetching
+  cache->SetPrefetchMemoryLimit(1);
+  if (!RequestTime(cache, 7) || !CheckCount(source, 9))
+    {
+    return EXIT_FAILURE;
+    }
+  // the step that was not prefetched is executed on demand, the one
+  // before it was prefetched during forward playback
+  cache->SetPrefetchMemoryLimit(0);
+  if (!RequestTime(cache, 6) || !CheckCount(source, 10))
+    {
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
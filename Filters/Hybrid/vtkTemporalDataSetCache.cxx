@@ -15,7 +15,9 @@
 #include "vtkTemporalDataSetCache.h"
 
 #include "vtkInformation.h"
+#include "vtkInformationExecutivePortKey.h"
 #include "vtkInformationVector.h"
+#include "vtkMultiThreader.h"
 #include "vtkObjectFactory.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkCompositeDataPipeline.h"
@@ -23,17 +25,38 @@
 #include "vtkCompositeDataIterator.h"
 #include "vtkSmartPointer.h"
 
+#include <algorithm>
 #include <vector>
 
 //---------------------------------------------------------------------------
 vtkStandardNewMacro(vtkTemporalDataSetCache);
 
+//----------------------------------------------------------------------------
+static VTK_THREAD_RETURN_TYPE vtkTemporalDataSetCachePrefetchStart(void* arg)
+{
+  vtkTemporalDataSetCache* self;
+  self = static_cast<vtkTemporalDataSetCache *>(
+    static_cast<vtkMultiThreader::ThreadInfo *>(arg)->UserData);
+  self->PrefetchThread();
+  return VTK_THREAD_RETURN_VALUE;
+}
+
 
 //----------------------------------------------------------------------------
 //----------------------------------------------------------------------------
 vtkTemporalDataSetCache::vtkTemporalDataSetCache()
 {
   this->CacheSize = 10;
+  this->Prefetch = 0;
+  this->PrefetchMemoryLimit = 0;
+  this->Threader = vtkMultiThreader::New();
+  this->PrefetchThreadId = -1;
+  this->PrefetchTime = 0.0;
+  this->PrefetchExecutive = 0;
+  this->PrefetchPort = 0;
+  this->LastUpdateTime = 0.0;
+  this->HasLastUpdateTime = 0;
+  this->PlaybackDirection = 1;
   this->SetNumberOfInputPorts(1);
   this->SetNumberOfOutputPorts(1);
 }
@@ -41,6 +64,9 @@ vtkTemporalDataSetCache::vtkTemporalDataSetCache()
 //----------------------------------------------------------------------------
 vtkTemporalDataSetCache::~vtkTemporalDataSetCache()
 {
+  this->WaitForPrefetch();
+  this->Threader->Delete();
+
   CacheType::iterator pos = this->Cache.begin();
   for (; pos != this->Cache.end();)
     {
@@ -103,6 +129,8 @@ void vtkTemporalDataSetCache::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os,indent);
 
   os << indent << "CacheSize: " << this->CacheSize << endl;
+  os << indent << "Prefetch: " << this->Prefetch << endl;
+  os << indent << "PrefetchMemoryLimit: " << this->PrefetchMemoryLimit << endl;
 }
 //----------------------------------------------------------------------------
 void vtkTemporalDataSetCache::SetCacheSize(int size)
@@ -113,6 +141,8 @@ void vtkTemporalDataSetCache::SetCacheSize(int size)
     return;
     }
 
+  this->WaitForPrefetch();
+
   // if growing the cache, there is no need to do anything
   this->CacheSize = size;
   if (this->Cache.size() <= static_cast<unsigned long>(size))
@@ -131,6 +161,184 @@ void vtkTemporalDataSetCache::SetCacheSize(int size)
     }
 }
 
+//----------------------------------------------------------------------------
+// The prefetch settings do not change the output, so unlike the set macros
+// these do not call Modified(), which would invalidate the cache.
+void vtkTemporalDataSetCache::SetPrefetch(int prefetch)
+{
+  this->Prefetch = prefetch;
+}
+
+//----------------------------------------------------------------------------
+void vtkTemporalDataSetCache::SetPrefetchMemoryLimit(unsigned long limit)
+{
+  this->PrefetchMemoryLimit = limit;
+}
+
+//----------------------------------------------------------------------------
+int vtkTemporalDataSetCache::ComputePipelineMTime(
+  vtkInformation* request,
+  vtkInformationVector** inInfoVec,
+  vtkInformationVector* outInfoVec,
+  int requestFromOutputPort,
+  unsigned long* mtime)
+{
+  // Every pipeline pass starts by computing the pipeline modified time,
+  // before anything upstream is touched. The prefetch thread must be done
+  // with the upstream pipeline by then.
+  this->WaitForPrefetch();
+  return this->Superclass::ComputePipelineMTime(request, inInfoVec, outInfoVec,
+                                                requestFromOutputPort, mtime);
+}
+
+//----------------------------------------------------------------------------
+void vtkTemporalDataSetCache::WaitForPrefetch()
+{
+  if (this->PrefetchThreadId >= 0)
+    {
+    this->Threader->TerminateThread(this->PrefetchThreadId);
+    this->PrefetchThreadId = -1;
+    }
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkTemporalDataSetCache::GetCacheMemorySize()
+{
+  unsigned long size = 0;
+  CacheType::iterator pos = this->Cache.begin();
+  for (; pos != this->Cache.end(); ++pos)
+    {
+    size += pos->second.second->GetActualMemorySize();
+    }
+  return size;
+}
+
+//----------------------------------------------------------------------------
+void vtkTemporalDataSetCache::StartPrefetch(vtkInformation* inInfo,
+                                            double upTime)
+{
+  if (!this->Prefetch || this->PrefetchThreadId >= 0 ||
+      !inInfo->Has(vtkStreamingDemandDrivenPipeline::TIME_STEPS()))
+    {
+    return;
+    }
+
+  vtkExecutive* producer;
+  int producerPort;
+  vtkExecutive::PRODUCER()->Get(inInfo, producer, producerPort);
+  if (!vtkStreamingDemandDrivenPipeline::SafeDownCast(producer))
+    {
+    return;
+    }
+
+  // The executive may release the input data once this request is done,
+  // which would race with the prefetch thread.
+  vtkDataObject *input = inInfo->Get(vtkDataObject::DATA_OBJECT());
+  if (!input || input->GetGlobalReleaseDataFlag() ||
+      inInfo->Get(vtkDemandDrivenPipeline::RELEASE_DATA()))
+    {
+    return;
+    }
+
+  if (this->HasLastUpdateTime && upTime != this->LastUpdateTime)
+    {
+    this->PlaybackDirection = upTime < this->LastUpdateTime ? -1 : 1;
+    }
+
+  // find the neighbouring time step in the direction of playback
+  const double *steps =
+    inInfo->Get(vtkStreamingDemandDrivenPipeline::TIME_STEPS());
+  const double *end =
+    steps + inInfo->Length(vtkStreamingDemandDrivenPipeline::TIME_STEPS());
+  const double *next;
+  if (this->PlaybackDirection > 0)
+    {
+    next = std::upper_bound(steps, end, upTime);
+    if (next == end)
+      {
+      return;
+      }
+    }
+  else
+    {
+    next = std::lower_bound(steps, end, upTime);
+    if (next == steps)
+      {
+      return;
+      }
+    --next;
+    }
+
+  if (this->Cache.find(*next) != this->Cache.end())
+    {
+    return;
+    }
+
+  if (this->PrefetchMemoryLimit > 0 &&
+      this->GetCacheMemorySize() + input->GetActualMemorySize() >
+      this->PrefetchMemoryLimit)
+    {
+    vtkDebugMacro("Skipping prefetch of time " << *next
+                  << ", memory limit reached");
+    return;
+    }
+
+#if defined(VTK_USE_PTHREADS) || defined(VTK_USE_WIN32_THREADS)
+  this->PrefetchTime = *next;
+  this->PrefetchExecutive = producer;
+  this->PrefetchPort = producerPort;
+  this->PrefetchThreadId =
+    this->Threader->SpawnThread(vtkTemporalDataSetCachePrefetchStart, this);
+#endif
+}
+
+//----------------------------------------------------------------------------
+void vtkTemporalDataSetCache::PrefetchThread()
+{
+  vtkStreamingDemandDrivenPipeline *sddp =
+    vtkStreamingDemandDrivenPipeline::SafeDownCast(this->PrefetchExecutive);
+  sddp->SetUpdateTimeStep(this->PrefetchPort, this->PrefetchTime);
+  if (!sddp->Update(this->PrefetchPort))
+    {
+    return;
+    }
+
+  vtkDataObject *input = sddp->GetOutputData(this->PrefetchPort);
+  if (!input || !input->GetInformation()->Has(vtkDataObject::DATA_TIME_STEP()))
+    {
+    return;
+    }
+  double inTime = input->GetInformation()->Get(vtkDataObject::DATA_TIME_STEP());
+  if (this->Cache.find(inTime) != this->Cache.end())
+    {
+    return;
+    }
+
+  // make room by getting rid of the oldest data in the cache
+  if (!this->Cache.empty() &&
+      this->Cache.size() >= static_cast<unsigned long>(this->CacheSize))
+    {
+    CacheType::iterator pos = this->Cache.begin();
+    CacheType::iterator oldestpos = this->Cache.begin();
+    for (; pos != this->Cache.end(); ++pos)
+      {
+      if (pos->second.first < oldestpos->second.first)
+        {
+        oldestpos = pos;
+        }
+      }
+    oldestpos->second.second->UnRegister(this);
+    this->Cache.erase(oldestpos);
+    }
+
+  vtkDataObject* cachedData = input->NewInstance();
+  cachedData->ShallowCopy(input);
+  this->Cache[inTime] =
+    std::pair<unsigned long, vtkDataObject *>
+    (input->GetUpdateTime(), cachedData);
+}
+
+//----------------------------------------------------------------------------
 int vtkTemporalDataSetCache::RequestDataObject( vtkInformation*,
                                              vtkInformationVector** inputVector ,
                                              vtkInformationVector* outputVector)
@@ -362,5 +570,11 @@ int vtkTemporalDataSetCache::RequestData(
         }
       }
     }
+
+  // speculatively fetch the next time step while the output is consumed
+  this->StartPrefetch(inInfo, upTime);
+  this->LastUpdateTime = upTime;
+  this->HasLastUpdateTime = 1;
+
   return 1;
 }
@@ -16,6 +16,15 @@
 // .SECTION Description
 // vtkTemporalDataSetCache cache time step requests of a temporal dataset,
 // when cached data is requested it is returned using a shallow copy.
+//
+// When Prefetch is on, the cache also speculatively executes the upstream
+// pipeline on a background thread for the time step that follows the one
+// just served, in the direction of recent playback, so that animation
+// playback does not stall on reading each frame. The upstream pipeline is
+// only driven from that thread between pipeline passes: any pass through the
+// cache first waits for a pending prefetch to complete. For this to be safe
+// the upstream pipeline must not be shared with other consumers and its
+// observers must tolerate being invoked from a non-main thread.
 // .SECTION Thanks
 // Ken Martin (Kitware) and John Bidiscombe of
 // CSCS - Swiss National Supercomputing Centre
@@ -33,6 +42,9 @@
 #include "vtkAlgorithm.h"
 #include <map> // used for the cache
 
+class vtkExecutive;
+class vtkMultiThreader;
+
 class VTKFILTERSHYBRID_EXPORT vtkTemporalDataSetCache : public vtkAlgorithm
 {
 public:
@@ -46,11 +58,70 @@ public:
   void SetCacheSize(int size);
   vtkGetMacro(CacheSize,int);
 
+  // Description:
+  // Turn on/off asynchronous prefetching of the next time step in the
+  // direction of playback. Prefetched time steps occupy cache entries like
+  // requested ones. Off by default.
+  void SetPrefetch(int prefetch);
+  vtkGetMacro(Prefetch,int);
+  vtkBooleanMacro(Prefetch,int);
+
+  // Description:
+  // Memory budget, in kibibytes, for the data held by the cache. A prefetch
+  // is skipped when the cached data plus one more time step (estimated from
+  // the size of the current input) would exceed it. The estimate ignores
+  // arrays shared between time steps, so it is conservative. 0 means no
+  // limit other than CacheSize. Defaults to 0.
+  void SetPrefetchMemoryLimit(unsigned long limit);
+  vtkGetMacro(PrefetchMemoryLimit,unsigned long);
+
+  // Description:
+  // Block until a pending prefetch, if any, has completed.
+  void WaitForPrefetch();
+
+  // Description:
+  // Method executed by the prefetch thread. Do not call directly.
+  void PrefetchThread();
+
+  // Description:
+  // Waits for a pending prefetch before the pipeline is traversed, then
+  // defers to the superclass.
+  virtual int
+  ComputePipelineMTime(vtkInformation* request,
+                       vtkInformationVector** inInfoVec,
+                       vtkInformationVector* outInfoVec,
+                       int requestFromOutputPort,
+                       unsigned long* mtime);
+
 protected:
   vtkTemporalDataSetCache();
   ~vtkTemporalDataSetCache();
 
   int CacheSize;
+  int Prefetch;
+  unsigned long PrefetchMemoryLimit;
+
+  // State of the prefetch thread. PrefetchThreadId is -1 when no prefetch
+  // is pending.
+  vtkMultiThreader* Threader;
+  int PrefetchThreadId;
+  double PrefetchTime;
+  vtkExecutive* PrefetchExecutive;
+  int PrefetchPort;
+
+  // Last time served and the direction of playback it implied.
+  double LastUpdateTime;
+  int HasLastUpdateTime;
+  int PlaybackDirection;
+
+  // Description:
+  // Start prefetching the time step following upTime, if there is one
+  // that is not cached and the memory budget allows it.
+  void StartPrefetch(vtkInformation* inInfo, double upTime);
+
+  // Description:
+  // Return the approximate memory used by the cached data in kibibytes.
+  unsigned long GetCacheMemorySize();
 
 //BTX
   typedef std::map<double,std::pair<unsigned long,vtkDataObject *> >
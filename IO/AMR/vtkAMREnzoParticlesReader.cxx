@@ -20,6 +20,9 @@
 #include "vtkPointData.h"
 #include "vtkIntArray.h"
 #include "vtkDataArray.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
 
 #include <cassert>
 #include <vector>
@@ -119,6 +122,20 @@ static void GetDoubleArrayByName(
 //          END of HDF5 Utility Routine definitions
 //------------------------------------------------------------------------------
 
+//------------------------------------------------------------------------------
+// Description:
+// The finalization of MurmurHash3, as used by vtkParticleReader to select
+// the blocks of particles to read.
+static vtkTypeUInt32 MixHash( vtkTypeUInt32 h )
+{
+  h ^= h >> 16;
+  h *= 0x85ebca6bU;
+  h ^= h >> 13;
+  h *= 0xc2b2ae35U;
+  h ^= h >> 16;
+  return h;
+}
+
 vtkStandardNewMacro(vtkAMREnzoParticlesReader);
 
 //------------------------------------------------------------------------------
@@ -126,6 +143,12 @@ vtkAMREnzoParticlesReader::vtkAMREnzoParticlesReader()
 {
   this->Internal     = new vtkEnzoReaderInternal();
   this->ParticleType = -1; /* undefined particle type */
+  this->SampleRatio         = 1.0;
+  this->SampleBlockSize     = 256;
+  this->RandomSeed          = 0;
+  this->ProgressiveSampling = 0;
+  this->SampleLow           = 0.0;
+  this->SampleHigh          = 1.0;
   this->Initialize();
 }
 
@@ -144,6 +167,76 @@ void vtkAMREnzoParticlesReader::PrintSelf(
     std::ostream &os, vtkIndent indent )
 {
   this->Superclass::PrintSelf( os, indent );
+  os << indent << "SampleRatio: " << this->SampleRatio << endl;
+  os << indent << "SampleBlockSize: " << this->SampleBlockSize << endl;
+  os << indent << "RandomSeed: " << this->RandomSeed << endl;
+  os << indent << "ProgressiveSampling: "
+     << (this->ProgressiveSampling ? "On" : "Off") << endl;
+}
+
+//------------------------------------------------------------------------------
+int vtkAMREnzoParticlesReader::RequestInformation(
+    vtkInformation *request,
+    vtkInformationVector **inputVector,
+    vtkInformationVector *outputVector )
+{
+  if( !this->Superclass::RequestInformation(
+        request, inputVector, outputVector ) )
+    {
+    return 0;
+    }
+
+  if( this->ProgressiveSampling )
+    {
+    vtkInformation *outInfo = outputVector->GetInformationObject( 0 );
+    outInfo->Set( CAN_HANDLE_PIECE_REQUEST(), 1 );
+    }
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+int vtkAMREnzoParticlesReader::RequestData(
+    vtkInformation *request,
+    vtkInformationVector **inputVector,
+    vtkInformationVector *outputVector )
+{
+  // Select the range of the hash kept by the requested piece.
+  this->SampleLow  = 0.0;
+  this->SampleHigh = this->SampleRatio;
+  if( this->ProgressiveSampling )
+    {
+    vtkInformation *outInfo = outputVector->GetInformationObject( 0 );
+    int piece =
+      outInfo->Get( vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER() );
+    int numPieces = outInfo->Get(
+      vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES() );
+    if( numPieces > 1 && piece >= 0 && piece < numPieces )
+      {
+      this->SampleLow  = this->SampleRatio * piece / numPieces;
+      this->SampleHigh = this->SampleRatio * (piece + 1) / numPieces;
+      }
+    }
+  return( this->Superclass::RequestData( request, inputVector, outputVector ) );
+}
+
+//------------------------------------------------------------------------------
+bool vtkAMREnzoParticlesReader::CheckSample( const int blockIdx, const int idx )
+{
+  if( this->SampleLow <= 0.0 && this->SampleHigh >= 1.0 )
+    {
+    return true;
+    }
+
+  // The particle indices restart in each grid, so the grid index is mixed
+  // into the seed to select different blocks in different grids.
+  vtkTypeUInt32 seed =
+    MixHash( static_cast<vtkTypeUInt32>(this->RandomSeed) ) ^
+    MixHash( static_cast<vtkTypeUInt32>(blockIdx) + 1 );
+  vtkTypeUInt32 block = static_cast<vtkTypeUInt32>(
+    idx / (this->SampleBlockSize > 0 ? this->SampleBlockSize : 1) );
+  vtkTypeUInt32 h = MixHash( MixHash( block ^ seed ) );
+  double level = h / 4294967296.0;
+  return( level >= this->SampleLow && level < this->SampleHigh );
 }
 
 //------------------------------------------------------------------------------
@@ -296,7 +389,7 @@ vtkPolyData* vtkAMREnzoParticlesReader::GetParticles(
   vtkIdType NumberOfParticlesLoaded = 0;
   for( int i=0; i < TotalNumberOfParticles; ++i )
     {
-    if( (i%this->Frequency) == 0  )
+    if( (i%this->Frequency) == 0 && this->CheckSample( blockIdx, i ) )
       {
       if( this->CheckLocation( xcoords[i], ycoords[i],zcoords[i] ) &&
           this->CheckParticleType( i, particleTypes) )
@@ -46,6 +46,42 @@ public:
   vtkSetMacro( ParticleType, int );
   vtkGetMacro( ParticleType, int );
 
+  // Description:
+  // Get/Set the fraction of the particles read, between 0 and 1.  The
+  // particles of each grid are split in blocks of SampleBlockSize
+  // consecutive particles, and each block is kept or not depending on a
+  // hash of its index, of the grid index and of RandomSeed, so the same
+  // particles are read every time, and the particles read with a ratio are
+  // also read with any larger ratio.  This is the hash of
+  // vtkParticleReader.  It applies on top of Frequency.  The positions are
+  // still read whole from the HDF5 file, but only the kept particles are
+  // stored.  The default is 1, which keeps every particle.
+  vtkSetClampMacro(SampleRatio, double, 0.0, 1.0);
+  vtkGetMacro(SampleRatio, double);
+
+  // Description:
+  // Get/Set the number of consecutive particles that SampleRatio and
+  // ProgressiveSampling keep or drop together.  The default is 256; 1
+  // samples each particle on its own.
+  vtkSetClampMacro(SampleBlockSize, int, 1, VTK_INT_MAX);
+  vtkGetMacro(SampleBlockSize, int);
+
+  // Description:
+  // Get/Set the seed of the hash used by SampleRatio and
+  // ProgressiveSampling.  The default is 0.
+  vtkSetMacro(RandomSeed, int);
+  vtkGetMacro(RandomSeed, int);
+
+  // Description:
+  // Get/Set whether the pieces requested are levels of detail.  When on,
+  // piece p of n holds the sampled blocks whose hash lies in the p-th of n
+  // equal parts of [0,SampleRatio), so that pieces 0 to p together hold a
+  // fraction (p+1)/n of the sampled particles of every grid.  Streaming
+  // the pieces in order thus refines a preview.  The default is off.
+  vtkSetMacro(ProgressiveSampling, int);
+  vtkGetMacro(ProgressiveSampling, int);
+  vtkBooleanMacro(ProgressiveSampling, int);
+
   // Description:
   // See vtkAMRBaseParticlesReader::GetTotalNumberOfParticles.
   int GetTotalNumberOfParticles();
@@ -67,6 +103,11 @@ protected:
   // See vtkAMRBaseParticlesReader::SetupParticleDataSelections
   void SetupParticleDataSelections();
 
+  // Description:
+  // Returns whether the particle of the given index in the given block is
+  // kept by SampleRatio and ProgressiveSampling.
+  bool CheckSample( const int blockIdx, const int pIdx );
+
   // Description:
   // Filter's by particle type, iff particle_type is included in
   // the given file.
@@ -80,8 +121,27 @@ protected:
   // Reads the particles.
   vtkPolyData* ReadParticles( const int blkidx );
 
+  // Description:
+  // Standard pipeline operations.  In progressive mode, the requested
+  // piece selects the range of the hash that is kept.
+  virtual int RequestInformation( vtkInformation *request,
+      vtkInformationVector **inputVector,
+      vtkInformationVector *outputVector );
+  virtual int RequestData( vtkInformation *request,
+      vtkInformationVector **inputVector,
+      vtkInformationVector *outputVector );
+
   int ParticleType;
 
+  double SampleRatio;
+  int SampleBlockSize;
+  int RandomSeed;
+  int ProgressiveSampling;
+
+  // The range of the hash of the blocks kept for the current piece.
+  double SampleLow;
+  double SampleHigh;
+
   vtkEnzoReaderInternal *Internal;
 
 private:
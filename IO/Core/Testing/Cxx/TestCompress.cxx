@@ -12,16 +12,19 @@
      PURPOSE.  See the above copyright notice for more information.
 
 =========================================================================*/
-// .NAME Test of vtkZLibDataCompressor
+// .NAME Test of vtkZLibDataCompressor and vtkZstdDataCompressor
 // .SECTION Description
 //
 
 #include "vtkZLibDataCompressor.h"
+#include "vtkZstdDataCompressor.h"
 #include "vtkOutputWindow.h"
 #include "vtkObjectFactory.h"
 
+#include <string.h>
 
-int TestCompress(int argc, char *argv[])
+static int TestCompressor(vtkDataCompressor* compressor,
+                          int argc, char *argv[])
 {
   int res = 1;
   const unsigned int start_size = 100024;
@@ -32,10 +35,9 @@ int TestCompress(int argc, char *argv[])
   size_t nlen;
   size_t rlen;
 
-  vtkZLibDataCompressor* compressor = vtkZLibDataCompressor::New();
   for ( cc = 0; cc < start_size; cc ++ )
     {
-    buffer[cc] = static_cast<unsigned char>(cc % sizeof(unsigned char));
+    buffer[cc] = static_cast<unsigned char>(cc % 251);
     }
   buffer[0] = 'v';
   buffer[1] = 't';
@@ -48,16 +50,37 @@ int TestCompress(int argc, char *argv[])
     {
     ucbuffer = new unsigned char[ start_size ];
     rlen = compressor->Uncompress(cbuffer, rlen, ucbuffer, start_size);
-    if ( rlen == start_size )
+    if ( rlen == start_size && memcmp(buffer, ucbuffer, start_size) == 0 )
       {
-      cout << argv[0] << " Works " << argc << endl;
+      cout << argv[0] << " Works " << argc << " with "
+           << compressor->GetClassName() << " level "
+           << compressor->GetCompressionLevel() << endl;
       cout << ucbuffer[0] << ucbuffer[1] << ucbuffer[2] << endl;
       res = 0;
       }
     delete [] ucbuffer;
     }
   delete [] cbuffer;
+  return res;
+}
+
+int TestCompress(int argc, char *argv[])
+{
+  int res = 0;
+
+  vtkZLibDataCompressor* zlib = vtkZLibDataCompressor::New();
+  res |= TestCompressor(zlib, argc, argv);
+  zlib->Delete();
+
+  // Fast negative levels, the default level and a high ratio level.
+  int levels[3] = { -5, 3, 19 };
+  vtkZstdDataCompressor* zstd = vtkZstdDataCompressor::New();
+  for ( int cc = 0; cc < 3; cc ++ )
+    {
+    zstd->SetCompressionLevel(levels[cc]);
+    res |= TestCompressor(zstd, argc, argv);
+    }
+  zstd->Delete();
 
-  compressor->Delete();
   return res;
 }
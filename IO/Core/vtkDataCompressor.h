@@ -75,6 +75,14 @@ public:
   vtkUnsignedCharArray* Uncompress(unsigned char const* compressedData,
                                    size_t compressedSize,
                                    size_t uncompressedSize);
+
+  // Description:
+  // Get/Set the compression level.  The meaning and range of the level
+  // depend on the compression method; higher levels compress better but
+  // more slowly.  Compressors without levels ignore this setting.
+  virtual void SetCompressionLevel(int) {}
+  virtual int GetCompressionLevel() { return 0; }
+
 protected:
   vtkDataCompressor();
   ~vtkDataCompressor();
@@ -38,7 +38,7 @@ public:
   size_t GetMaximumCompressionSpace(size_t size);
 
   // Description:
-  // Get/Set the compression level.
+  // Get/Set the compression level, from 0 (no compression) to 9.
   vtkSetClampMacro(CompressionLevel, int, 0, 9);
   vtkGetMacro(CompressionLevel, int);
 
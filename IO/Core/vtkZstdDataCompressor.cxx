@@ -0,0 +1,197 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkZstdDataCompressor.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkZstdDataCompressor.h"
+#include "vtkCriticalSection.h"
+#include "vtkObjectFactory.h"
+#include "vtk_zstd.h"
+
+#include <vector>
+
+vtkStandardNewMacro(vtkZstdDataCompressor);
+
+//----------------------------------------------------------------------------
+// Contexts not currently used by a thread.  Creating a context for every
+// block would cost about as much as compressing it.
+class vtkZstdDataCompressorInternals
+{
+public:
+  ~vtkZstdDataCompressorInternals()
+    {
+    for(size_t i=0; i < this->CompressContexts.size(); ++i)
+      {
+      ZSTD_freeCCtx(this->CompressContexts[i]);
+      }
+    for(size_t i=0; i < this->DecompressContexts.size(); ++i)
+      {
+      ZSTD_freeDCtx(this->DecompressContexts[i]);
+      }
+    }
+
+  ZSTD_CCtx* PopCompressContext()
+    {
+    ZSTD_CCtx* ctx = 0;
+    this->Lock.Lock();
+    if(!this->CompressContexts.empty())
+      {
+      ctx = this->CompressContexts.back();
+      this->CompressContexts.pop_back();
+      }
+    this->Lock.Unlock();
+    return ctx? ctx : ZSTD_createCCtx();
+    }
+
+  void PushCompressContext(ZSTD_CCtx* ctx)
+    {
+    this->Lock.Lock();
+    this->CompressContexts.push_back(ctx);
+    this->Lock.Unlock();
+    }
+
+  ZSTD_DCtx* PopDecompressContext()
+    {
+    ZSTD_DCtx* ctx = 0;
+    this->Lock.Lock();
+    if(!this->DecompressContexts.empty())
+      {
+      ctx = this->DecompressContexts.back();
+      this->DecompressContexts.pop_back();
+      }
+    this->Lock.Unlock();
+    return ctx? ctx : ZSTD_createDCtx();
+    }
+
+  void PushDecompressContext(ZSTD_DCtx* ctx)
+    {
+    this->Lock.Lock();
+    this->DecompressContexts.push_back(ctx);
+    this->Lock.Unlock();
+    }
+
+private:
+  vtkSimpleCriticalSection Lock;
+  std::vector<ZSTD_CCtx*> CompressContexts;
+  std::vector<ZSTD_DCtx*> DecompressContexts;
+};
+
+//----------------------------------------------------------------------------
+vtkZstdDataCompressor::vtkZstdDataCompressor()
+{
+  this->CompressionLevel = ZSTD_CLEVEL_DEFAULT;
+  this->Internals = new vtkZstdDataCompressorInternals;
+}
+
+//----------------------------------------------------------------------------
+vtkZstdDataCompressor::~vtkZstdDataCompressor()
+{
+  delete this->Internals;
+}
+
+//----------------------------------------------------------------------------
+void vtkZstdDataCompressor::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "CompressionLevel: " << this->CompressionLevel << endl;
+}
+
+//----------------------------------------------------------------------------
+void vtkZstdDataCompressor::SetCompressionLevel(int compressionLevel)
+{
+  int minLevel = ZSTD_minCLevel();
+  int maxLevel = ZSTD_maxCLevel();
+  compressionLevel = compressionLevel < minLevel? minLevel :
+    (compressionLevel > maxLevel? maxLevel : compressionLevel);
+  if(this->CompressionLevel != compressionLevel)
+    {
+    this->CompressionLevel = compressionLevel;
+    this->Modified();
+    }
+}
+
+//----------------------------------------------------------------------------
+int vtkZstdDataCompressor::GetCompressionLevel()
+{
+  return this->CompressionLevel;
+}
+
+//----------------------------------------------------------------------------
+size_t
+vtkZstdDataCompressor::CompressBuffer(unsigned char const* uncompressedData,
+                                      size_t uncompressedSize,
+                                      unsigned char* compressedData,
+                                      size_t compressionSpace)
+{
+  ZSTD_CCtx* ctx = this->Internals->PopCompressContext();
+  if(!ctx)
+    {
+    vtkErrorMacro("Cannot allocate a zstd compression context.");
+    return 0;
+    }
+  size_t cs = ZSTD_compressCCtx(ctx, compressedData, compressionSpace,
+                                uncompressedData, uncompressedSize,
+                                this->CompressionLevel);
+  this->Internals->PushCompressContext(ctx);
+
+  if(ZSTD_isError(cs))
+    {
+    vtkErrorMacro("Zstd error while compressing data: "
+                  << ZSTD_getErrorName(cs));
+    return 0;
+    }
+
+  return cs;
+}
+
+//----------------------------------------------------------------------------
+size_t
+vtkZstdDataCompressor::UncompressBuffer(unsigned char const* compressedData,
+                                        size_t compressedSize,
+                                        unsigned char* uncompressedData,
+                                        size_t uncompressedSize)
+{
+  ZSTD_DCtx* ctx = this->Internals->PopDecompressContext();
+  if(!ctx)
+    {
+    vtkErrorMacro("Cannot allocate a zstd decompression context.");
+    return 0;
+    }
+  size_t us = ZSTD_decompressDCtx(ctx, uncompressedData, uncompressedSize,
+                                  compressedData, compressedSize);
+  this->Internals->PushDecompressContext(ctx);
+
+  if(ZSTD_isError(us))
+    {
+    vtkErrorMacro("Zstd error while uncompressing data: "
+                  << ZSTD_getErrorName(us));
+    return 0;
+    }
+
+  // Make sure the output size matched that expected.
+  if(us != uncompressedSize)
+    {
+    vtkErrorMacro("Decompression produced incorrect size.\n"
+                  "Expected " << uncompressedSize << " and got " << us);
+    return 0;
+    }
+
+  return us;
+}
+
+//----------------------------------------------------------------------------
+size_t
+vtkZstdDataCompressor::GetMaximumCompressionSpace(size_t size)
+{
+  return ZSTD_compressBound(size);
+}
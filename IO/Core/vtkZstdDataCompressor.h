@@ -0,0 +1,81 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkZstdDataCompressor.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkZstdDataCompressor - Data compression using Zstandard.
+// .SECTION Description
+// vtkZstdDataCompressor provides a concrete vtkDataCompressor class
+// using the Zstandard (zstd) library for compressing and uncompressing
+// data.  Zstandard compresses several times faster than zlib for a
+// similar or better ratio.  Negative compression levels select its fast
+// mode, which reaches the throughput of LZ4-class codecs and stands in
+// for a separate LZ4 compressor, which VTK does not provide.  Levels up
+// to 22 favor the compression ratio.
+//
+// Compression contexts are pooled and reused, so one compressor may be
+// used by several threads at the same time.
+
+#ifndef __vtkZstdDataCompressor_h
+#define __vtkZstdDataCompressor_h
+
+#include "vtkIOCoreModule.h" // For export macro
+#include "vtkDataCompressor.h"
+
+class vtkZstdDataCompressorInternals;
+
+class VTKIOCORE_EXPORT vtkZstdDataCompressor : public vtkDataCompressor
+{
+public:
+  vtkTypeMacro(vtkZstdDataCompressor,vtkDataCompressor);
+  void PrintSelf(ostream& os, vtkIndent indent);
+  static vtkZstdDataCompressor* New();
+
+  // Description:
+  // Get the maximum space that may be needed to store data of the
+  // given uncompressed size after compression.  This is the minimum
+  // size of the output buffer that can be passed to the four-argument
+  // Compress method.
+  size_t GetMaximumCompressionSpace(size_t size);
+
+  // Description:
+  // Get/Set the compression level.  The value is clamped to the range
+  // supported by the zstd library, from its fastest negative levels to
+  // 22.  The default is 3.
+  virtual void SetCompressionLevel(int compressionLevel);
+  virtual int GetCompressionLevel();
+
+protected:
+  vtkZstdDataCompressor();
+  ~vtkZstdDataCompressor();
+
+  int CompressionLevel;
+
+  // Compression method required by vtkDataCompressor.
+  size_t CompressBuffer(unsigned char const* uncompressedData,
+                        size_t uncompressedSize,
+                        unsigned char* compressedData,
+                        size_t compressionSpace);
+  // Decompression method required by vtkDataCompressor.
+  size_t UncompressBuffer(unsigned char const* compressedData,
+                          size_t compressedSize,
+                          unsigned char* uncompressedData,
+                          size_t uncompressedSize);
+
+  vtkZstdDataCompressorInternals* Internals;
+
+private:
+  vtkZstdDataCompressor(const vtkZstdDataCompressor&);  // Not implemented.
+  void operator=(const vtkZstdDataCompressor&);  // Not implemented.
+};
+
+#endif
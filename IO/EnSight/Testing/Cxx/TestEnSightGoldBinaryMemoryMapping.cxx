@@ -0,0 +1,313 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestEnSightGoldBinaryMemoryMapping.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Writes a binary EnSight Gold case whose geometry and per-node variables
+// are single-file sets of several time steps, reads every step with and
+// without memory mapping and with several threads decoding the parts,
+// forwards and backwards with the same reader, and checks that the outputs
+// are the same.  The files are then rewritten with larger parts to check
+// that the indexed time steps and parts are not reused.
+
+#include <vtkDataArray.h>
+#include <vtkDataSet.h>
+#include <vtkEnSightGoldBinaryReader.h>
+#include <vtkMultiBlockDataSet.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkTestUtilities.h>
+
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace
+{
+const int NumberOfParts = 4;
+
+void WriteString(std::ofstream& file, const char* value)
+{
+  char line[80];
+  memset(line, 0, 80);
+  strncpy(line, value, 79);
+  file.write(line, 80);
+}
+
+void WriteInt(std::ofstream& file, int value)
+{
+  file.write(reinterpret_cast<char*>(&value), sizeof(int));
+}
+
+void WriteFloat(std::ofstream& file, float value)
+{
+  file.write(reinterpret_cast<char*>(&value), sizeof(float));
+}
+
+int NumberOfPoints(int part, int growth)
+{
+  // Part 3 is a 3x2xN structured block, the others are made of tetrahedra.
+  return part == 3 ? 6 * (2 + growth) : 4 + 3 * part + 2 * growth;
+}
+
+void WriteCase(const std::string& prefix, int numberOfSteps, int growth)
+{
+  std::string name = prefix.substr(prefix.find_last_of("/") + 1);
+  std::ofstream caseFile((prefix + ".case").c_str());
+  caseFile << "FORMAT\ntype: ensight gold\n\nGEOMETRY\n"
+           << "model: 1 1 " << name << ".geo\n\nVARIABLE\n"
+           << "scalar per node: 1 1 pressure " << name << ".scl\n"
+           << "vector per node: 1 1 velocity " << name << ".vec\n"
+           << "tensor symm per node: 1 1 stress " << name << ".ten\n\n"
+           << "TIME\ntime set: 1\nnumber of steps: " << numberOfSteps
+           << "\ntime values:";
+  for (int step = 0; step < numberOfSteps; ++step)
+    {
+    caseFile << " " << step;
+    }
+  caseFile << "\n\nFILE\nfile set: 1\nnumber of steps: " << numberOfSteps
+           << "\n";
+
+  std::ofstream geometry((prefix + ".geo").c_str(),
+                         std::ios::out | std::ios::binary);
+  WriteString(geometry, "C Binary");
+  for (int step = 0; step < numberOfSteps; ++step)
+    {
+    WriteString(geometry, "BEGIN TIME STEP");
+    WriteString(geometry, "geometry");
+    WriteString(geometry, "generated by TestEnSightGoldBinaryMemoryMapping");
+    WriteString(geometry, "node id off");
+    WriteString(geometry, "element id off");
+    for (int part = 0; part < NumberOfParts; ++part)
+      {
+      int numPts = NumberOfPoints(part, growth);
+      WriteString(geometry, "part");
+      WriteInt(geometry, part + 1);
+      WriteString(geometry, "a part");
+      if (part == 3)
+        {
+        WriteString(geometry, "block");
+        WriteInt(geometry, 3);
+        WriteInt(geometry, 2);
+        WriteInt(geometry, 2 + growth);
+        }
+      else
+        {
+        WriteString(geometry, "coordinates");
+        WriteInt(geometry, numPts);
+        }
+      for (int c = 0; c < 3; ++c)
+        {
+        for (int i = 0; i < numPts; ++i)
+          {
+          WriteFloat(geometry, (c == 0 ? i % 3 : c == 1 ? (i / 3) % 2 : i / 6)
+                     + 0.25f * step + 10.0f * part + 0.125f * c);
+          }
+        }
+      if (part != 3)
+        {
+        WriteString(geometry, "tetra4");
+        WriteInt(geometry, numPts - 3);
+        for (int e = 0; e < numPts - 3; ++e)
+          {
+          for (int n = 0; n < 4; ++n)
+            {
+            WriteInt(geometry, e + n + 1);
+            }
+          }
+        }
+      }
+    WriteString(geometry, "END TIME STEP");
+    }
+
+  const char* extensions[3] = { ".scl", ".vec", ".ten" };
+  int numberOfComponents[3] = { 1, 3, 6 };
+  for (int v = 0; v < 3; ++v)
+    {
+    std::ofstream variable((prefix + extensions[v]).c_str(),
+                           std::ios::out | std::ios::binary);
+    for (int step = 0; step < numberOfSteps; ++step)
+      {
+      WriteString(variable, "BEGIN TIME STEP");
+      WriteString(variable, "variable");
+      for (int part = 0; part < NumberOfParts; ++part)
+        {
+        WriteString(variable, "part");
+        WriteInt(variable, part + 1);
+        WriteString(variable, part == 3 ? "block" : "coordinates");
+        for (int c = 0; c < numberOfComponents[v]; ++c)
+          {
+          for (int i = 0; i < NumberOfPoints(part, growth); ++i)
+            {
+            WriteFloat(variable, 1000.0f * v + 100.0f * step + 10.0f * part
+                       + c + 0.5f * i);
+            }
+          }
+        }
+      WriteString(variable, "END TIME STEP");
+      }
+    }
+}
+
+void Summarize(vtkDataArray* array, std::ostream& os)
+{
+  double sum = 0.0;
+  for (vtkIdType i = 0; i < array->GetNumberOfTuples(); ++i)
+    {
+    for (int c = 0; c < array->GetNumberOfComponents(); ++c)
+      {
+      sum += array->GetComponent(i, c) * (i + 1) * (c + 1);
+      }
+    }
+  os << " " << array->GetName() << " " << array->GetNumberOfComponents()
+     << " " << sum;
+}
+
+// Describe the blocks read at the given step.
+std::string Describe(vtkEnSightGoldBinaryReader* reader, int step)
+{
+  std::ostringstream os;
+  os.precision(17);
+  reader->SetTimeValue(step);
+  reader->Update();
+  vtkMultiBlockDataSet* output = reader->GetOutput();
+  for (unsigned int b = 0; b < output->GetNumberOfBlocks(); ++b)
+    {
+    vtkDataSet* block = vtkDataSet::SafeDownCast(output->GetBlock(b));
+    if (!block)
+      {
+      continue;
+      }
+    os << "block " << b << " " << block->GetClassName()
+       << " cells " << block->GetNumberOfCells()
+       << " points " << block->GetNumberOfPoints();
+    double sum = 0.0;
+    for (vtkIdType i = 0; i < block->GetNumberOfPoints(); ++i)
+      {
+      double* x = block->GetPoint(i);
+      sum += (x[0] + 3.0 * x[1] + 7.0 * x[2]) * (i + 1);
+      }
+    os << " coordinates " << sum;
+    vtkPointData* pointData = block->GetPointData();
+    for (int a = 0; a < pointData->GetNumberOfArrays(); ++a)
+      {
+      Summarize(pointData->GetArray(a), os);
+      }
+    os << " scalars "
+       << (pointData->GetScalars() ? pointData->GetScalars()->GetName() : "")
+       << " vectors "
+       << (pointData->GetVectors() ? pointData->GetVectors()->GetName() : "")
+       << "\n";
+    }
+  return os.str();
+}
+
+std::string Read(const std::string& caseFileName, int mapping, int threads,
+                 int step)
+{
+  vtkNew<vtkEnSightGoldBinaryReader> reader;
+  reader->SetCaseFileName(caseFileName.c_str());
+  reader->SetUseMemoryMapping(mapping);
+  reader->SetNumberOfPartThreads(threads);
+  return Describe(reader.GetPointer(), step);
+}
+}
+
+int TestEnSightGoldBinaryMemoryMapping(int argc, char* argv[])
+{
+  char* tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  if (!tempDir)
+    {
+    cerr << "Could not determine temporary directory." << endl;
+    return EXIT_FAILURE;
+    }
+  std::string prefix = tempDir;
+  delete [] tempDir;
+  prefix += "/TestEnSightGoldBinaryMemoryMapping";
+  std::string caseFileName = prefix + ".case";
+
+  const int numberOfSteps = 3;
+  WriteCase(prefix, numberOfSteps, 0);
+  std::string expected[numberOfSteps];
+  for (int step = 0; step < numberOfSteps; ++step)
+    {
+    expected[step] = Read(caseFileName, 0, 1, step);
+    if (expected[step].find("stress 6") == std::string::npos)
+      {
+      cerr << "Missing variables at step " << step << ":\n"
+           << expected[step];
+      return EXIT_FAILURE;
+      }
+    }
+  if (expected[0] == expected[1])
+    {
+    cerr << "The time steps were not read." << endl;
+    return EXIT_FAILURE;
+    }
+
+  int result = EXIT_SUCCESS;
+  int mappings[3] = { 1, 1, 1 };
+  int threads[3] = { 1, 3, 0 };
+  for (int run = 0; run < 3; ++run)
+    {
+    for (int step = 0; step < numberOfSteps; ++step)
+      {
+      std::string actual = Read(caseFileName, mappings[run], threads[run],
+                                step);
+      if (actual != expected[step])
+        {
+        cerr << "Wrong output at step " << step << " with "
+             << threads[run] << " threads:\n" << actual
+             << "instead of:\n" << expected[step];
+        result = EXIT_FAILURE;
+        }
+      }
+    }
+
+  // Read the steps forwards and backwards with the same reader, which
+  // reuses the indexed time steps and parts.
+  vtkNew<vtkEnSightGoldBinaryReader> reader;
+  reader->SetCaseFileName(caseFileName.c_str());
+  reader->UseMemoryMappingOn();
+  reader->SetNumberOfPartThreads(2);
+  int steps[6] = { 0, 2, 1, 1, 0, 2 };
+  for (int s = 0; s < 6; ++s)
+    {
+    std::string actual = Describe(reader.GetPointer(), steps[s]);
+    if (actual != expected[steps[s]])
+      {
+      cerr << "Wrong output when reading step " << steps[s]
+           << " again:\n" << actual << "instead of:\n"
+           << expected[steps[s]];
+      result = EXIT_FAILURE;
+      }
+    }
+
+  // The parts grow, which moves every time step and part in the files.
+  WriteCase(prefix, numberOfSteps, 1);
+  reader->Modified();
+  for (int step = numberOfSteps - 1; step >= 0; --step)
+    {
+    std::string grown = Read(caseFileName, 0, 1, step);
+    std::string actual = Describe(reader.GetPointer(), step);
+    if (actual != grown || actual == expected[step])
+      {
+      cerr << "Wrong output at step " << step << " of the grown files:\n"
+           << actual << "instead of:\n" << grown;
+      result = EXIT_FAILURE;
+      }
+    }
+
+  return result;
+}
@@ -21,10 +21,12 @@
 #include "vtkMultiBlockDataSet.h"
 #include "vtkIdList.h"
 #include "vtkImageData.h"
+#include "vtkMultiThreader.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkRectilinearGrid.h"
+#include "vtkSMPTools.h"
 #include "vtkStructuredGrid.h"
 #include "vtkUnstructuredGrid.h"
 
@@ -34,6 +36,14 @@
 #include <vector>
 #include <map>
 
+#if defined(_WIN32) && !defined(__CYGWIN__)
+# include <windows.h>
+#else
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <unistd.h>
+#endif
+
 vtkStandardNewMacro(vtkEnSightGoldBinaryReader);
 
 
@@ -46,8 +56,177 @@ class vtkEnSightGoldBinaryReader::FileOffsetMapInternal
     typedef std::map<MapKey, MapValue>::value_type value_type;
 
     std::map<MapKey, MapValue> Map;
+
+    // The size of each file when its offsets were cached.
+    std::map<MapKey, vtkTypeInt64> FileSizes;
+
+    // The size and number of time steps of the geometry files counted so
+    // far.
+    std::map<MapKey, std::pair<vtkTypeInt64, int> > TimeStepCounts;
+
+    // The per-node variable block of a part in a variable file.
+    struct PartBlock
+    {
+      int PartId;
+      int NumberOfPoints;
+      vtkTypeInt64 Offset;
+    };
+
+    // The parts of the last time step read from a variable file, valid as
+    // long as the file keeps the same size and the time step starts at
+    // Start.  Only the last one is kept because the blocks of the parts are
+    // read right after the index, so rebuilding it costs little compared
+    // to keeping thousands of parts for hundreds of time steps.
+    struct PartIndex
+    {
+      PartIndex() : TimeStep(-1), FileSize(0), Start(0) {}
+      int TimeStep;
+      vtkTypeInt64 FileSize;
+      vtkTypeInt64 Start;
+      std::vector<PartBlock> Blocks;
+    };
+    std::map<MapKey, PartIndex> PartIndices;
 };
 
+// A read-only memory mapping of the file being read.
+class vtkEnSightGoldBinaryReader::FileMappingInternal
+{
+public:
+  FileMappingInternal() : Data(0), Size(0) {}
+  ~FileMappingInternal() { this->Unmap(); }
+
+  // Map the whole file.  Returns false if it could not be mapped.
+  bool Map(const char* fileName)
+  {
+    this->Unmap();
+    void* data = 0;
+#if defined(_WIN32) && !defined(__CYGWIN__)
+    HANDLE file = CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ, NULL,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+      {
+      return false;
+      }
+    LARGE_INTEGER size;
+    if (GetFileSizeEx(file, &size) && size.QuadPart > 0)
+      {
+      HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0,
+                                          NULL);
+      if (mapping)
+        {
+        data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(mapping);
+        }
+      this->Size = static_cast<vtkTypeInt64>(size.QuadPart);
+      }
+    CloseHandle(file);
+#else
+    int fd = open(fileName, O_RDONLY);
+    if (fd < 0)
+      {
+      return false;
+      }
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size > 0)
+      {
+      data = mmap(0, static_cast<size_t>(st.st_size), PROT_READ,
+                  MAP_SHARED, fd, 0);
+      if (data == MAP_FAILED)
+        {
+        data = 0;
+        }
+      this->Size = static_cast<vtkTypeInt64>(st.st_size);
+      }
+    close(fd);
+#endif
+    this->Data = static_cast<const char*>(data);
+    if (!this->Data)
+      {
+      this->Size = 0;
+      }
+    return this->Data != 0;
+  }
+
+  void Unmap()
+  {
+    if (this->Data)
+      {
+#if defined(_WIN32) && !defined(__CYGWIN__)
+      UnmapViewOfFile(this->Data);
+#else
+      munmap(const_cast<char*>(this->Data),
+             static_cast<size_t>(this->Size));
+#endif
+      }
+    this->Data = 0;
+    this->Size = 0;
+  }
+
+  const char* Data;
+  vtkTypeInt64 Size;
+};
+
+namespace
+{
+// Decode numberOfBlocks consecutive float arrays of numFloats values each,
+// with Fortran record markers if fortran is set.  Value i of array j is
+// stored at result[i*stride+j].
+void vtkEnSightGoldBinaryReaderDecodeBlocks(
+  const char* data, float* result, vtkIdType numFloats, int numberOfBlocks,
+  int stride, int fortran, int littleEndian)
+{
+  for (int block = 0; block < numberOfBlocks; ++block)
+    {
+    if (fortran)
+      {
+      data += 4;
+      }
+    float* out = result + block;
+    for (vtkIdType i = 0; i < numFloats; ++i, data += sizeof(float))
+      {
+      float value;
+      memcpy(&value, data, sizeof(float));
+      if (littleEndian)
+        {
+        vtkByteSwap::Swap4LE(&value);
+        }
+      else
+        {
+        vtkByteSwap::Swap4BE(&value);
+        }
+      out[i*stride] = value;
+      }
+    if (fortran)
+      {
+      data += 4;
+      }
+    }
+}
+
+// Decodes the variable blocks of parts.
+struct vtkEnSightGoldBinaryReaderPartDecoder
+{
+  const char* Data;
+  std::vector<vtkTypeInt64> Offsets;
+  std::vector<float*> Results;
+  std::vector<vtkIdType> NumberOfPoints;
+  int NumberOfBlocks;
+  int Stride;
+  int Fortran;
+  int LittleEndian;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      vtkEnSightGoldBinaryReaderDecodeBlocks(
+        this->Data + this->Offsets[i], this->Results[i],
+        this->NumberOfPoints[i], this->NumberOfBlocks, this->Stride,
+        this->Fortran, this->LittleEndian);
+      }
+  }
+};
+}
 
 // This is half the precision of an int.
 #define MAXIMUM_PART_ID 65536
@@ -56,6 +235,9 @@ class vtkEnSightGoldBinaryReader::FileOffsetMapInternal
 vtkEnSightGoldBinaryReader::vtkEnSightGoldBinaryReader()
 {
   this->FileOffsets = new vtkEnSightGoldBinaryReader::FileOffsetMapInternal;
+  this->FileMapping = new vtkEnSightGoldBinaryReader::FileMappingInternal;
+  this->UseMemoryMapping = 0;
+  this->NumberOfPartThreads = 1;
 
   this->IFile = NULL;
   this->FileSize = 0;
@@ -69,6 +251,7 @@ vtkEnSightGoldBinaryReader::vtkEnSightGoldBinaryReader()
 vtkEnSightGoldBinaryReader::~vtkEnSightGoldBinaryReader()
 {
   delete this->FileOffsets;
+  delete this->FileMapping;
 
   if (this->IFile)
     {
@@ -78,6 +261,19 @@ vtkEnSightGoldBinaryReader::~vtkEnSightGoldBinaryReader()
     }
 }
 
+//----------------------------------------------------------------------------
+int vtkEnSightGoldBinaryReader::RequestData(
+  vtkInformation *request,
+  vtkInformationVector **inputVector,
+  vtkInformationVector *outputVector)
+{
+  int result = this->Superclass::RequestData(request, inputVector,
+                                             outputVector);
+  // Do not keep the last file mapped between updates.
+  this->FileMapping->Unmap();
+  return result;
+}
+
 //----------------------------------------------------------------------------
 int vtkEnSightGoldBinaryReader::OpenFile(const char* filename)
 {
@@ -94,6 +290,7 @@ int vtkEnSightGoldBinaryReader::OpenFile(const char* filename)
     delete this->IFile;
     this->IFile = NULL;
     }
+  this->FileMapping->Unmap();
 
   // Open the new file
   vtkDebugMacro(<< "Opening file " << filename);
@@ -119,6 +316,10 @@ int vtkEnSightGoldBinaryReader::OpenFile(const char* filename)
     vtkErrorMacro(<< "Could not open file " << filename);
     return 0;
     }
+  if (this->UseMemoryMapping && !this->FileMapping->Map(filename))
+    {
+    vtkDebugMacro("Could not map " << filename << ", reading it instead.");
+    }
 
   //we now need to check for Fortran and byte ordering
 
@@ -258,14 +459,39 @@ int vtkEnSightGoldBinaryReader::ReadGeometryFile(const char* fileName, int timeS
     return 0;
     }
 
-  //this will close the file, so we need to reinitialize it
-  int numberOfTimeStepsInFile=this->CountTimeSteps();
-
-  if (!this->InitializeFile(fileName))
-  {
-  return 0;
-  }
-
+  // Count the time steps of a file set only the first time the file is
+  // read, or when it changed size since, using its file index if it has
+  // one.
+  int numberOfTimeStepsInFile = 0;
+  if (this->UseFileSets)
+    {
+    typedef std::map<std::string, std::pair<vtkTypeInt64, int> > CountMapType;
+    CountMapType::iterator countIterator =
+      this->FileOffsets->TimeStepCounts.find(fileName);
+    if (countIterator != this->FileOffsets->TimeStepCounts.end() &&
+        countIterator->second.first == this->FileSize)
+      {
+      numberOfTimeStepsInFile = countIterator->second.second;
+      }
+    else
+      {
+      vtkTypeInt64 fileSize = this->FileSize;
+      this->AddFileIndexToCache(fileName);
+      numberOfTimeStepsInFile =
+        static_cast<int>(this->FileOffsets->Map[fileName].size());
+      if (numberOfTimeStepsInFile == 0)
+        {
+        //this will close the file, so we need to reinitialize it
+        numberOfTimeStepsInFile = this->CountTimeSteps(fileName);
+        if (!this->InitializeFile(fileName))
+          {
+          return 0;
+          }
+        }
+      this->FileOffsets->TimeStepCounts[fileName] =
+        std::make_pair(fileSize, numberOfTimeStepsInFile);
+      }
+    }
 
   if (this->UseFileSets)
     {
@@ -432,14 +658,19 @@ int vtkEnSightGoldBinaryReader::ReadGeometryFile(const char* fileName, int timeS
 
 
 //----------------------------------------------------------------------------
-int vtkEnSightGoldBinaryReader::CountTimeSteps()
+int vtkEnSightGoldBinaryReader::CountTimeSteps(const char* fileName)
 {
   int count=0;
   while(1)
     {
-    int result=this->SkipTimeStep();
+    vtkTypeInt64 offset;
+    int result=this->SkipTimeStep(&offset);
     if (result)
       {
+      if (fileName && offset >= 0)
+        {
+        this->AddTimeStepToCache(fileName, count, offset);
+        }
       count++;
       }
     else
@@ -451,7 +682,7 @@ int vtkEnSightGoldBinaryReader::CountTimeSteps()
 }
 
 //----------------------------------------------------------------------------
-int vtkEnSightGoldBinaryReader::SkipTimeStep()
+int vtkEnSightGoldBinaryReader::SkipTimeStep(vtkTypeInt64 *offset)
 {
   char line[80], subLine[80];
   int lineRead;
@@ -464,6 +695,10 @@ int vtkEnSightGoldBinaryReader::SkipTimeStep()
       return 0;
       }
     }
+  if (offset)
+    {
+    *offset = this->IFile->tellg();
+    }
 
   // Skip the 2 description lines.
   this->ReadLine(line);
@@ -1432,6 +1667,19 @@ int vtkEnSightGoldBinaryReader::ReadScalarsPerNode(
     return 1;
     }
 
+  if (this->ReadPartBlocks(fileName, timeStep, description, compositeOutput,
+                           numberOfComponents, component, 1,
+                           vtkDataSetAttributes::SCALARS))
+    {
+    if (this->IFile)
+      {
+      this->IFile->close();
+      delete this->IFile;
+      this->IFile = NULL;
+      }
+    return 1;
+    }
+
   lineRead = this->ReadLine(line);
   while (lineRead && strncmp(line, "part", 4) == 0)
     {
@@ -1631,6 +1879,18 @@ int vtkEnSightGoldBinaryReader::ReadVectorsPerNode(
     return 1;
     }
 
+  if (this->ReadPartBlocks(fileName, timeStep, description, compositeOutput,
+                           3, 0, 3, vtkDataSetAttributes::VECTORS))
+    {
+    if (this->IFile)
+      {
+      this->IFile->close();
+      delete this->IFile;
+      this->IFile = NULL;
+      }
+    return 1;
+    }
+
   lineRead = this->ReadLine(line);
   while (lineRead && strncmp(line, "part", 4) == 0)
     {
@@ -1773,6 +2033,19 @@ int vtkEnSightGoldBinaryReader::ReadTensorsPerNode(
     }
 
   this->ReadLine(line); // skip the description line
+
+  if (this->ReadPartBlocks(fileName, timeStep, description, compositeOutput,
+                           6, 0, 6, -1))
+    {
+    if (this->IFile)
+      {
+      this->IFile->close();
+      delete this->IFile;
+      this->IFile = NULL;
+      }
+    return 1;
+    }
+
   lineRead = this->ReadLine(line);
 
   while (lineRead && strncmp(line, "part", 4) == 0)
@@ -2598,7 +2871,6 @@ int vtkEnSightGoldBinaryReader::CreateUnstructuredGridOutput(
   int *nodeIdList;
   int numElements;
   int idx, cellId, cellType;
-  float *xCoords, *yCoords, *zCoords;
 
   this->NumberOfNewOutputs++;
 
@@ -2643,30 +2915,18 @@ int vtkEnSightGoldBinaryReader::CreateUnstructuredGridOutput(
       vtkPoints *points = vtkPoints::New();
       vtkDebugMacro("num. points: " << numPts);
 
-      points->Allocate(numPts);
+      points->SetNumberOfPoints(numPts);
 
       if (this->NodeIdsListed)
         {
         this->IFile->seekg(sizeof(int)*numPts, ios::cur);
         }
 
-      xCoords = new float[numPts];
-      yCoords = new float[numPts];
-      zCoords = new float[numPts];
-      this->ReadFloatArray(xCoords, numPts);
-      this->ReadFloatArray(yCoords, numPts);
-      this->ReadFloatArray(zCoords, numPts);
-
-      for (i = 0; i < numPts; i++)
-        {
-        points->InsertNextPoint(xCoords[i], yCoords[i], zCoords[i]);
-        }
+      this->ReadFloatBlocks(static_cast<float*>(points->GetVoidPointer(0)),
+                            numPts, 3);
 
       output->SetPoints(points);
       points->Delete();
-      delete [] xCoords;
-      delete [] yCoords;
-      delete [] zCoords;
       }
     else if (strncmp(line, "point", 5) == 0)
       {
@@ -3709,7 +3969,6 @@ int vtkEnSightGoldBinaryReader::CreateStructuredGridOutput(
   int i;
   vtkPoints *points = vtkPoints::New();
   int numPts;
-  float *xCoords, *yCoords, *zCoords;
 
   this->NumberOfNewOutputs++;
 
@@ -3751,19 +4010,9 @@ int vtkEnSightGoldBinaryReader::CreateStructuredGridOutput(
     return -1;
     }
   output->SetDimensions(dimensions);
-  points->Allocate(numPts);
-
-  xCoords = new float[numPts];
-  yCoords = new float[numPts];
-  zCoords = new float[numPts];
-  this->ReadFloatArray(xCoords, numPts);
-  this->ReadFloatArray(yCoords, numPts);
-  this->ReadFloatArray(zCoords, numPts);
-
-  for (i = 0; i < numPts; i++)
-    {
-    points->InsertNextPoint(xCoords[i], yCoords[i], zCoords[i]);
-    }
+  points->SetNumberOfPoints(numPts);
+  this->ReadFloatBlocks(static_cast<float*>(points->GetVoidPointer(0)),
+                        numPts, 3);
   output->SetPoints(points);
   if (iblanked)
     {
@@ -3781,9 +4030,6 @@ int vtkEnSightGoldBinaryReader::CreateStructuredGridOutput(
     }
 
   points->Delete();
-  delete [] xCoords;
-  delete [] yCoords;
-  delete [] zCoords;
 
   this->IFile->peek();
   if (this->IFile->eof())
@@ -4237,10 +4483,227 @@ int vtkEnSightGoldBinaryReader::ReadFloatArray(float *result,
   return 1;
 }
 
+// Internal function to read consecutive float arrays into the components
+// of a tuple array.  Returns zero if there was an error.
+int vtkEnSightGoldBinaryReader::ReadFloatBlocks(float *result,
+  int numFloats, int numberOfBlocks)
+{
+  if (numFloats <= 0)
+    {
+    return 1;
+    }
+
+  if (this->FileMapping->Data)
+    {
+    vtkTypeInt64 offset = this->IFile->tellg();
+    vtkTypeInt64 size = numberOfBlocks *
+      (static_cast<vtkTypeInt64>(sizeof(float))*numFloats +
+       (this->Fortran ? 8 : 0));
+    if (offset < 0 || offset + size > this->FileMapping->Size)
+      {
+      vtkErrorMacro("Read failed");
+      return 0;
+      }
+    vtkEnSightGoldBinaryReaderDecodeBlocks(
+      this->FileMapping->Data + offset, result, numFloats, numberOfBlocks,
+      numberOfBlocks, this->Fortran, this->ByteOrder == FILE_LITTLE_ENDIAN);
+    this->IFile->seekg(size, ios::cur);
+    return 1;
+    }
+
+  float *block = new float[numFloats];
+  for (int j = 0; j < numberOfBlocks; j++)
+    {
+    if (!this->ReadFloatArray(block, numFloats))
+      {
+      delete [] block;
+      return 0;
+      }
+    for (int i = 0; i < numFloats; i++)
+      {
+      result[i*numberOfBlocks + j] = block[i];
+      }
+    }
+  delete [] block;
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkEnSightGoldBinaryReader::ReadPartBlocks(
+  const char* fileName, int timeStep, const char* description,
+  vtkMultiBlockDataSet *compositeOutput, int numberOfComponents,
+  int component, int numberOfBlocks, int attribute)
+{
+  typedef vtkEnSightGoldBinaryReader::FileOffsetMapInternal MapType;
+  const char* data = this->FileMapping->Data;
+  if (!data)
+    {
+    return 0;
+    }
+  vtkTypeInt64 start = this->IFile->tellg();
+  if (start < 0)
+    {
+    return 0;
+    }
+
+  int lineSize = this->Fortran ? 88 : 80;
+  int intSize = this->Fortran ? 12 : 4;
+  int markerSize = this->Fortran ? 4 : 0;
+
+  // Index the parts of this time step the first time it is read, or again
+  // if the file or the number of points of the parts changed since.
+  MapType::PartIndex& index = this->FileOffsets->PartIndices[fileName];
+  std::vector<vtkDataSet*> outputs;
+  bool indexed = index.TimeStep == timeStep &&
+    index.FileSize == this->FileMapping->Size && index.Start == start &&
+    !index.Blocks.empty();
+  for (size_t i = 0; indexed && i < index.Blocks.size(); i++)
+    {
+    const MapType::PartBlock& block = index.Blocks[i];
+    int realId = this->FindPartId(block.PartId);
+    vtkDataSet *output = realId < 0 ? NULL :
+      this->GetDataSetFromBlock(compositeOutput, realId);
+    indexed = output && output->GetNumberOfPoints() == block.NumberOfPoints;
+    outputs.push_back(output);
+    }
+  if (!indexed)
+    {
+    index.TimeStep = timeStep;
+    index.FileSize = this->FileMapping->Size;
+    index.Start = start;
+    index.Blocks.clear();
+    outputs.clear();
+    vtkTypeInt64 size = this->FileMapping->Size;
+    vtkTypeInt64 offset = start;
+    while (offset + lineSize <= size &&
+           strncmp(data + offset + markerSize, "part", 4) == 0)
+      {
+      offset += lineSize;
+      if (offset + intSize > size)
+        {
+        break;
+        }
+      MapType::PartBlock block;
+      memcpy(&block.PartId, data + offset + markerSize, sizeof(int));
+      if (this->ByteOrder == FILE_LITTLE_ENDIAN)
+        {
+        vtkByteSwap::Swap4LE(&block.PartId);
+        }
+      else if (this->ByteOrder == FILE_BIG_ENDIAN)
+        {
+        vtkByteSwap::Swap4BE(&block.PartId);
+        }
+      offset += intSize;
+      block.PartId--; // EnSight starts #ing with 1.
+      // Only look the part up: a part missing from the geometry is a
+      // layout mismatch, left to the stream reader to handle.
+      int realId = this->FindPartId(block.PartId);
+      vtkDataSet *output = realId < 0 ? NULL :
+        this->GetDataSetFromBlock(compositeOutput, realId);
+      if (!output)
+        {
+        index.Blocks.clear();
+        return 0;
+        }
+      // If the part has no points, then only the part number is listed in
+      // the variable file.
+      block.NumberOfPoints = static_cast<int>(output->GetNumberOfPoints());
+      block.Offset = offset + lineSize; // skip "coordinates" or "block"
+      if (block.NumberOfPoints)
+        {
+        offset = block.Offset + numberOfBlocks *
+          (static_cast<vtkTypeInt64>(sizeof(float))*block.NumberOfPoints +
+           2*markerSize);
+        if (offset > size)
+          {
+          index.Blocks.clear();
+          return 0;
+          }
+        }
+      index.Blocks.push_back(block);
+      outputs.push_back(output);
+      }
+    }
+
+  // Allocate the arrays, then decode the parts concurrently.
+  vtkEnSightGoldBinaryReaderPartDecoder decoder;
+  decoder.Data = data;
+  decoder.NumberOfBlocks = numberOfBlocks;
+  decoder.Stride = numberOfComponents;
+  decoder.Fortran = this->Fortran;
+  decoder.LittleEndian = this->ByteOrder == FILE_LITTLE_ENDIAN;
+  std::vector<vtkPointData*> pointData;
+  std::vector<vtkFloatArray*> arrays;
+  for (size_t i = 0; i < index.Blocks.size(); i++)
+    {
+    const MapType::PartBlock& block = index.Blocks[i];
+    if (!block.NumberOfPoints)
+      {
+      continue;
+      }
+    vtkFloatArray *array;
+    if (component == 0)
+      {
+      array = vtkFloatArray::New();
+      array->SetNumberOfComponents(numberOfComponents);
+      array->SetNumberOfTuples(block.NumberOfPoints);
+      }
+    else
+      {
+      array = vtkFloatArray::SafeDownCast(
+        outputs[i]->GetPointData()->GetArray(description));
+      if (!array || array->GetNumberOfTuples() != block.NumberOfPoints)
+        {
+        continue;
+        }
+      array->Register(this);
+      }
+    pointData.push_back(outputs[i]->GetPointData());
+    arrays.push_back(array);
+    decoder.Offsets.push_back(block.Offset);
+    decoder.Results.push_back(array->GetPointer(0) + component);
+    decoder.NumberOfPoints.push_back(block.NumberOfPoints);
+    }
+
+  vtkIdType numParts = static_cast<vtkIdType>(arrays.size());
+  int numThreads = this->NumberOfPartThreads;
+  if (numThreads == 1 || numParts < 2)
+    {
+    decoder(0, numParts);
+    }
+  else
+    {
+    if (numThreads == 0)
+      {
+      numThreads = vtkMultiThreader::GetGlobalDefaultNumberOfThreads();
+      }
+    vtkIdType grain = (numParts + numThreads - 1) / numThreads;
+    vtkSMPTools::For(0, numParts, grain, decoder);
+    }
+
+  for (size_t i = 0; i < arrays.size(); i++)
+    {
+    if (component == 0)
+      {
+      arrays[i]->SetName(description);
+      int arrayIndex = pointData[i]->AddArray(arrays[i]);
+      if (attribute >= 0 && !pointData[i]->GetAttribute(attribute))
+        {
+        pointData[i]->SetActiveAttribute(arrayIndex, attribute);
+        }
+      }
+    arrays[i]->UnRegister(this);
+    }
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 void vtkEnSightGoldBinaryReader::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os,indent);
+  os << indent << "UseMemoryMapping: " << this->UseMemoryMapping << endl;
+  os << indent << "NumberOfPartThreads: " << this->NumberOfPartThreads
+     << endl;
 }
 
 // Seeks the IFile to the cached timestep nearest the target timestep.
@@ -4267,10 +4730,11 @@ int vtkEnSightGoldBinaryReader::SeekToCachedTimeStep(const char* fileName,
     FileOffsetIterator fileOffsetIterator = nameIterator->second.find(i);
     if (fileOffsetIterator != nameIterator->second.end())
       {
-      //we need to account for the last 80 characters as where we need to seek,
+      //we need to account for the last line as where we need to seek,
       //as we need to be at the BEGIN TIMESTEP keyword and not
       //the description line
-      this->IFile->seekg(fileOffsetIterator->second - 80l, ios::beg);
+      this->IFile->seekg(fileOffsetIterator->second -
+                         (this->Fortran ? 88l : 80l), ios::beg);
       j = i;
       break;
       }
@@ -4296,6 +4760,16 @@ void vtkEnSightGoldBinaryReader::AddTimeStepToCache(const char* fileName,
 //----------------------------------------------------------------------------
 void vtkEnSightGoldBinaryReader::AddFileIndexToCache(const char* fileName)
 {
+  // forget the offsets of a file that changed since they were cached
+  std::map<std::string, vtkTypeInt64>::iterator sizeIterator =
+    this->FileOffsets->FileSizes.find(fileName);
+  if (sizeIterator != this->FileOffsets->FileSizes.end() &&
+      sizeIterator->second != this->FileSize)
+    {
+    this->FileOffsets->Map.erase(fileName);
+    }
+  this->FileOffsets->FileSizes[fileName] = this->FileSize;
+
   // only read the file index if we have not searched for the file index before
   if (this->FileOffsets->Map.find(fileName) == this->FileOffsets->Map.end())
     {
@@ -31,6 +31,13 @@
 // what types they will be.
 // This reader can only handle static EnSight datasets (both static geometry
 // and variables).
+//
+// The number of time steps of the file sets and the offsets of the time
+// steps in the files are indexed the first time each file is read, and
+// reused until the file changes size.  When UseMemoryMapping is on, the
+// files are memory mapped and the coordinate and per-node variable blocks
+// are decoded directly from the mapping into the data arrays, the variable
+// blocks of several parts at a time when NumberOfPartThreads is not 1.
 // .SECTION Thanks
 // Thanks to Yvan Fournier for providing the code to support nfaced elements.
 
@@ -50,10 +57,35 @@ public:
   vtkTypeMacro(vtkEnSightGoldBinaryReader, vtkEnSightReader);
   virtual void PrintSelf(ostream& os, vtkIndent indent);
 
+  // Description:
+  // Get/Set whether the geometry and variable files are memory mapped
+  // while they are read.  The coordinates and the per-node variables are
+  // then decoded from the mapping directly into the data arrays.  The
+  // other blocks, and files that cannot be mapped, are read with file
+  // streams.  The default is off.
+  vtkSetMacro(UseMemoryMapping, int);
+  vtkGetMacro(UseMemoryMapping, int);
+  vtkBooleanMacro(UseMemoryMapping, int);
+
+  // Description:
+  // The number of batches the parts are split into to decode their
+  // per-node variables from a memory mapped file concurrently.  This is
+  // the grain of vtkSMPTools::For, not a number of threads: the SMP
+  // backend decides how many threads run the batches.  0 makes as many
+  // batches as vtkMultiThreader's default number of threads.  The output
+  // does not depend on this setting.  The default is 1, which decodes the
+  // parts one after the other.
+  vtkSetClampMacro(NumberOfPartThreads, int, 0, VTK_INT_MAX);
+  vtkGetMacro(NumberOfPartThreads, int);
+
 protected:
   vtkEnSightGoldBinaryReader();
   ~vtkEnSightGoldBinaryReader();
 
+  virtual int RequestData(vtkInformation*,
+                          vtkInformationVector**,
+                          vtkInformationVector*);
+
   // Returns 1 if successful.  Sets file size as a side action.
   int OpenFile(const char* filename);
 
@@ -172,16 +204,42 @@ protected:
   // Returns zero if there was an error.
   int ReadFloatArray(float *result, int numFloats);
 
+  // Description:
+  // Internal function to read numberOfBlocks consecutive float arrays of
+  // numFloats values each, and store value i of array j at
+  // result[i*numberOfBlocks+j].  The arrays are decoded from the memory
+  // mapped file if there is one.  Returns zero if there was an error.
+  int ReadFloatBlocks(float *result, int numFloats, int numberOfBlocks);
+
+  // Description:
+  // Read the per-node variable blocks of all the parts of the current time
+  // step from the memory mapped file, starting at the current position of
+  // IFile, into the given component of an array of numberOfComponents
+  // components per part, or into all of its components when
+  // numberOfBlocks is numberOfComponents.  The arrays are set as the given
+  // attribute when the point data does not have one yet.  Returns zero
+  // without changing the output if the file is not mapped or its layout
+  // does not match the geometry, in which case the variable should be read
+  // from IFile instead.
+  int ReadPartBlocks(const char* fileName, int timeStep,
+                     const char* description,
+                     vtkMultiBlockDataSet *compositeOutput,
+                     int numberOfComponents, int component,
+                     int numberOfBlocks, int attribute);
+
   // Description:
   // Counts the number of timesteps in the geometry file
   // This function assumes the file is already open and returns the
   // number of timesteps remaining in the file
   // The file will be closed after calling this method
-  int CountTimeSteps();
+  // If fileName is given, the offset of each time step is added to the
+  // time step cache of this file.
+  int CountTimeSteps(const char* fileName = NULL);
 
   // Description:
-  // Read to the next time step in the geometry file.
-  int SkipTimeStep();
+  // Read to the next time step in the geometry file.  If offset is given,
+  // it is set to the address following the BEGIN TIME STEP line.
+  int SkipTimeStep(vtkTypeInt64 *offset = NULL);
   int SkipStructuredGrid(char line[256]);
   int SkipUnstructuredGrid(char line[256]);
   int SkipRectilinearGrid(char line[256]);
@@ -210,8 +268,13 @@ protected:
   //BTX
   class FileOffsetMapInternal;
   FileOffsetMapInternal *FileOffsets;
+  class FileMappingInternal;
+  FileMappingInternal *FileMapping;
   //ETX
 
+  int UseMemoryMapping;
+  int NumberOfPartThreads;
+
 private:
   int SizeOfInt;
   vtkEnSightGoldBinaryReader(const vtkEnSightGoldBinaryReader&);  // Not implemented.
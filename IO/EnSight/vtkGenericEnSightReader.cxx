@@ -1685,6 +1685,14 @@ int vtkGenericEnSightReader::InsertNewPartId(int partId)
   return lastId;
 }
 
+//----------------------------------------------------------------------------
+int vtkGenericEnSightReader::FindPartId(int partId)
+{
+  std::map<int,int>::const_iterator it =
+    this->TranslationTable->PartIdMap.find(partId);
+  return it == this->TranslationTable->PartIdMap.end() ? -1 : it->second;
+}
+
 //----------------------------------------------------------------------------
 int vtkGenericEnSightReader::FillOutputPortInformation(int vtkNotUsed(port),
                                                        vtkInformation* info)
@@ -360,6 +360,9 @@ protected:
   // Insert a partId and return the 'realId' that should be used.
   int InsertNewPartId(int partId);
 
+  // Return the 'realId' of a partId already inserted, or -1.
+  int FindPartId(int partId);
+
   // Wrapper around an stl map
   TranslationTableType *TranslationTable;
 
@@ -0,0 +1,270 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestExodusReadAhead.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkDataArray.h"
+#include "vtkExodusIICache.h"
+#include "vtkExodusIIReader.h"
+#include "vtkExodusIIWriter.h"
+#include "vtkFloatArray.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnstructuredGrid.h"
+#include "vtkUnstructuredGridAlgorithm.h"
+
+#include <string>
+
+//
+// This test checks that reading Exodus time steps gives the same output
+// whether the arrays of the next time step are read ahead or not, that
+// deflected points are computed from the cached undeflected ones, that
+// the cache statistics count the arrays served from the cache and that
+// the arrays of the next time step are served from the cache once read
+// ahead.
+//
+
+static const int NumberOfTimeSteps = 5;
+static const int NumberOfHexes = 20;
+
+//-------------------------------------------------------------------------
+// A row of hexahedra with displacements and a cell array varying in time.
+//-------------------------------------------------------------------------
+class vtkHexRowSource : public vtkUnstructuredGridAlgorithm
+{
+public:
+  static vtkHexRowSource *New();
+  vtkTypeMacro(vtkHexRowSource, vtkUnstructuredGridAlgorithm);
+
+protected:
+  vtkHexRowSource()
+  {
+    this->SetNumberOfInputPorts(0);
+  }
+
+  virtual int RequestInformation(vtkInformation*,
+                                 vtkInformationVector**,
+                                 vtkInformationVector* outputVector)
+  {
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    double steps[NumberOfTimeSteps];
+    for (int i = 0; i < NumberOfTimeSteps; ++i)
+      {
+      steps[i] = i;
+      }
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_STEPS(), steps,
+                 NumberOfTimeSteps);
+    double range[2] = { steps[0], steps[NumberOfTimeSteps - 1] };
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_RANGE(), range, 2);
+    return 1;
+  }
+
+  virtual int RequestData(vtkInformation*,
+                          vtkInformationVector**,
+                          vtkInformationVector* outputVector)
+  {
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    vtkUnstructuredGrid* output = vtkUnstructuredGrid::GetData(outInfo);
+    double time = 0;
+    if (outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP()))
+      {
+      time = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP());
+      }
+
+    vtkNew<vtkPoints> points;
+    vtkNew<vtkFloatArray> displacements;
+    displacements->SetName("DISPL");
+    displacements->SetNumberOfComponents(3);
+    for (int i = 0; i <= NumberOfHexes; ++i)
+      {
+      for (int j = 0; j < 4; ++j)
+        {
+        points->InsertNextPoint(i, j % 2, j / 2);
+        displacements->InsertNextTuple3(0.5 * time, 0.0, i * time);
+        }
+      }
+    vtkNew<vtkFloatArray> pressure;
+    pressure->SetName("Pressure");
+    output->Allocate(NumberOfHexes);
+    for (vtkIdType i = 0; i < NumberOfHexes; ++i)
+      {
+      vtkIdType p = 4 * i;
+      vtkIdType hex[8] = { p, p + 4, p + 5, p + 1, p + 2, p + 6, p + 7, p + 3 };
+      output->InsertNextCell(VTK_HEXAHEDRON, 8, hex);
+      pressure->InsertNextValue(time + i);
+      }
+    output->SetPoints(points.GetPointer());
+    output->GetPointData()->AddArray(displacements.GetPointer());
+    output->GetCellData()->AddArray(pressure.GetPointer());
+    output->GetInformation()->Set(vtkDataObject::DATA_TIME_STEP(), time);
+    return 1;
+  }
+};
+
+vtkStandardNewMacro(vtkHexRowSource);
+
+//-------------------------------------------------------------------------
+static vtkUnstructuredGrid* ReadTimeStep(vtkExodusIIReader* reader, int step)
+{
+  reader->SetTimeStep(step);
+  reader->Update();
+  vtkMultiBlockDataSet* elementBlocks = vtkMultiBlockDataSet::SafeDownCast(
+    vtkMultiBlockDataSet::SafeDownCast(reader->GetOutputDataObject(0))
+    ->GetBlock(0));
+  return vtkUnstructuredGrid::SafeDownCast(elementBlocks->GetBlock(0));
+}
+
+//-------------------------------------------------------------------------
+static bool CheckTimeStep(vtkUnstructuredGrid* grid, int step)
+{
+  vtkDataArray* pressure = grid ? grid->GetCellData()->GetArray("Pressure") : 0;
+  if (!pressure || grid->GetNumberOfPoints() != 4 * (NumberOfHexes + 1) ||
+      pressure->GetNumberOfTuples() != NumberOfHexes)
+    {
+    cerr << "Missing or truncated output at time step " << step << endl;
+    return false;
+    }
+  for (vtkIdType i = 0; i < NumberOfHexes; ++i)
+    {
+    if (pressure->GetTuple1(i) != step + i)
+      {
+      cerr << "Wrong pressure at time step " << step << endl;
+      return false;
+      }
+    }
+  // The points are deflected by the displacements written by the source.
+  for (vtkIdType i = 0; i < grid->GetNumberOfPoints(); ++i)
+    {
+    int hex = i / 4;
+    int j = i % 4;
+    double x[3];
+    grid->GetPoint(i, x);
+    if (x[0] != hex + 0.5 * step || x[1] != j % 2 ||
+        x[2] != j / 2 + hex * step)
+      {
+      cerr << "Wrong point " << i << " at time step " << step << endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+//-------------------------------------------------------------------------
+int TestExodusReadAhead(int argc, char* argv[])
+{
+  char* tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  if (!tempDir)
+    {
+    cerr << "Could not determine temporary directory." << endl;
+    return EXIT_FAILURE;
+    }
+  std::string fileName = tempDir;
+  delete [] tempDir;
+  fileName += "/TestExodusReadAhead.exo";
+
+  vtkNew<vtkHexRowSource> source;
+  vtkNew<vtkExodusIIWriter> writer;
+  writer->SetInputConnection(source->GetOutputPort());
+  writer->SetFileName(fileName.c_str());
+  writer->WriteAllTimeStepsOn();
+  writer->Write();
+
+  vtkNew<vtkExodusIIReader> reader;
+  vtkNew<vtkExodusIIReader> readAheadReader;
+  vtkExodusIIReader* readers[2] =
+    { reader.GetPointer(), readAheadReader.GetPointer() };
+  for (int r = 0; r < 2; ++r)
+    {
+    readers[r]->SetFileName(fileName.c_str());
+    readers[r]->SetCacheSize(16);
+    readers[r]->SetSqueezePoints(false);
+    readers[r]->SetReadAhead(r);
+    readers[r]->UpdateInformation();
+    readers[r]->SetAllArrayStatus(vtkExodusIIReader::NODAL, 1);
+    readers[r]->SetAllArrayStatus(vtkExodusIIReader::ELEM_BLOCK, 1);
+    }
+  if (readAheadReader->GetNumberOfTimeSteps() != NumberOfTimeSteps)
+    {
+    cerr << "Wrote " << readAheadReader->GetNumberOfTimeSteps()
+         << " time steps" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Count the cache misses of the reader without read-ahead when it reads
+  // time step 1 for the first time, and those of the reader with
+  // read-ahead, once its read-ahead has completed, for each time step.
+  vtkExodusIICache* cache = reader->GetCache();
+  vtkExodusIICache* readAheadCache = readAheadReader->GetCache();
+  vtkIdType firstMisses = 0;
+  vtkIdType readAheadMisses[NumberOfTimeSteps];
+  for (int step = 0; step < NumberOfTimeSteps; ++step)
+    {
+    cache->ResetStatistics();
+    readAheadCache->ResetStatistics();
+    for (int r = 0; r < 2; ++r)
+      {
+      if (!CheckTimeStep(ReadTimeStep(readers[r], step), step))
+        {
+        cerr << (r ? "With" : "Without") << " read-ahead" << endl;
+        return EXIT_FAILURE;
+        }
+      }
+    if (step == 1)
+      {
+      firstMisses = cache->GetNumberOfMisses();
+      }
+    readAheadMisses[step] = readAheadCache->GetNumberOfMisses();
+    readAheadReader->WaitForReadAhead();
+    }
+
+  // Reading time step 1 for the first time only read its deflected points,
+  // displacements and pressure: the undeflected points were cached for all
+  // time steps. Reading it again reads none of them. Arrays missing from
+  // the file, such as the QA records, are never cached.
+  cache->ResetStatistics();
+  if (!CheckTimeStep(ReadTimeStep(reader.GetPointer(), 1), 1) ||
+      cache->GetNumberOfMisses() + 3 != firstMisses ||
+      cache->GetNumberOfHits() == 0)
+    {
+    cerr << "Read time step 1 with " << firstMisses << " misses, then with "
+         << cache->GetNumberOfHits() << " hits and "
+         << cache->GetNumberOfMisses() << " misses" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // The read-ahead of time step n left all the arrays of time step n + 1
+  // in the cache, so reading it misses no more than reading again a time
+  // step already read.
+  for (int step = 1; step < NumberOfTimeSteps; ++step)
+    {
+    if (readAheadMisses[step] != cache->GetNumberOfMisses())
+      {
+      cerr << "Read time step " << step << " with read-ahead with "
+           << readAheadMisses[step] << " misses instead of "
+           << cache->GetNumberOfMisses() << endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -71,6 +71,7 @@ vtkExodusIICache::vtkExodusIICache()
 {
   this->Size = 0.;
   this->Capacity = 2.;
+  this->ResetStatistics();
 }
 
 vtkExodusIICache::~vtkExodusIICache()
@@ -85,12 +86,25 @@ void vtkExodusIICache::PrintSelf( ostream& os, vtkIndent indent )
   os << indent << "Size: " << this->Size << " MiB\n";
   os << indent << "Cache: " << &this->Cache << " (" << this->Cache.size() << ")\n";
   os << indent << "LRU: " << &this->LRU << "\n";
+  os << indent << "NumberOfHits: " << this->NumberOfHits << "\n";
+  os << indent << "NumberOfMisses: " << this->NumberOfMisses << "\n";
+  os << indent << "NumberOfEvictions: " << this->NumberOfEvictions << "\n";
+}
+
+void vtkExodusIICache::ResetStatistics()
+{
+  this->NumberOfHits = 0;
+  this->NumberOfMisses = 0;
+  this->NumberOfEvictions = 0;
 }
 
 void vtkExodusIICache::Clear()
 {
   //printCache( this->Cache, this->LRU );
+  // Emptying the cache on purpose does not count as evictions.
+  vtkIdType numberOfEvictions = this->NumberOfEvictions;
   this->ReduceToSize( 0. );
+  this->NumberOfEvictions = numberOfEvictions;
 }
 
 void vtkExodusIICache::SetCacheCapacity( double sizeInMiB )
@@ -139,6 +153,7 @@ int vtkExodusIICache::ReduceToSize( double newSize )
     delete cit->second;
     this->Cache.erase( cit );
     this->LRU.pop_back();
+    ++this->NumberOfEvictions;
     }
 
   if ( this->Cache.size() == 0 )
@@ -199,9 +214,11 @@ vtkDataArray*& vtkExodusIICache::Find( vtkExodusIICacheKey key )
     {
     this->LRU.erase( it->second->LRUEntry );
     it->second->LRUEntry = this->LRU.insert( this->LRU.begin(), it );
+    ++this->NumberOfHits;
     return it->second->Value;
     }
 
+  ++this->NumberOfMisses;
   dummy = 0;
   return dummy;
 }
@@ -146,6 +146,20 @@ public:
   double GetSpaceLeft()
     { return this->Capacity - this->Size; }
 
+  /// Get the current size of the cache in MiB.
+  double GetSize()
+    { return this->Size; }
+
+  /** Statistics on the use of the cache since it was created or since
+    * ResetStatistics() was last called: the number of Find() calls that
+    * returned an array (hits) or did not (misses), and the number of
+    * entries dropped to make space for new ones (evictions).
+    */
+  vtkGetMacro(NumberOfHits,vtkIdType);
+  vtkGetMacro(NumberOfMisses,vtkIdType);
+  vtkGetMacro(NumberOfEvictions,vtkIdType);
+  void ResetStatistics();
+
   /** Remove cache entries until the size of the cache is at or below the given size.
     * Returns a nonzero value if deletions were required.
     */
@@ -195,6 +209,11 @@ protected:
   /// The current size of the cache (i.e., the size of the all the arrays it currently contains) in MiB.
   double Size;
 
+  /// Counters reported by GetNumberOfHits(), GetNumberOfMisses() and GetNumberOfEvictions().
+  vtkIdType NumberOfHits;
+  vtkIdType NumberOfMisses;
+  vtkIdType NumberOfEvictions;
+
   //BTX
   /** A least-recently-used (LRU) cache to hold arrays.
     * During RequestData the cache may contain more than its maximum size since
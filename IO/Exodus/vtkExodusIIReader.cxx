@@ -23,6 +23,7 @@
 #include "vtkCellData.h"
 #include "vtkCellType.h"
 #include "vtkCharArray.h"
+#include "vtkConditionVariable.h"
 #include "vtkDoubleArray.h"
 #include "vtkFloatArray.h"
 #include "vtkIdTypeArray.h"
@@ -31,7 +32,9 @@
 #include "vtkIntArray.h"
 #include "vtkMath.h"
 #include "vtkMultiBlockDataSet.h"
+#include "vtkMultiThreader.h"
 #include "vtkMutableDirectedGraph.h"
+#include "vtkMutexLock.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
@@ -207,6 +210,11 @@ extern "C" { typedef int (*vtkExodusIIGetMapFunc)( int, int* ); }
 #include "vtkExodusIIReaderPrivate.h"
 #include "vtkExodusIIReaderVariableCheck.h"
 
+// Readers whose read-ahead thread may still be using the Exodus library,
+// and the lock serializing the starting and stopping of those threads.
+static std::set<vtkExodusIIReaderPrivate*> vtkExodusIIReadersReadingAhead;
+static vtkSimpleMutexLock vtkExodusIIReadersReadingAheadLock;
+
 // --------------------------------------------------- PRIVATE CLASS Implementations
 vtkExodusIIReaderPrivate::BlockSetInfoType::BlockSetInfoType(
   const vtkExodusIIReaderPrivate::BlockSetInfoType &block):
@@ -388,6 +396,13 @@ vtkExodusIIReaderPrivate::vtkExodusIIReaderPrivate()
   this->Cache = vtkExodusIICache::New();
   this->CacheSize = 0;
 
+  this->ReadAhead = 0;
+  this->ReadAheadThreader = vtkMultiThreader::New();
+  this->ReadAheadThreadId = -1;
+  this->ReadAheadDone = 1;
+  this->ReadAheadDoneLock = vtkMutexLock::New();
+  this->ReadAheadDoneCondition = vtkConditionVariable::New();
+
   this->TimeStep = 0;
   this->HasModeShapes = 0;
   this->ModeShapeTime = -1.;
@@ -417,6 +432,9 @@ vtkExodusIIReaderPrivate::vtkExodusIIReaderPrivate()
 vtkExodusIIReaderPrivate::~vtkExodusIIReaderPrivate()
 {
   this->CloseFile();
+  this->ReadAheadThreader->Delete();
+  this->ReadAheadDoneCondition->Delete();
+  this->ReadAheadDoneLock->Delete();
   this->Cache->Delete();
   this->CacheSize = 0;
   this->ClearConnectivityCaches();
@@ -605,7 +623,7 @@ int vtkExodusIIReaderPrivate::AssembleOutputPoints(
     }
 
   int ts = -1; // If we don't have displacements, only cache the array under one key.
-  if ( this->ApplyDisplacements && this->FindDisplacementVectors( timeStep ) )
+  if ( this->ApplyDisplacements && this->GetDisplacementArrayIndex() >= 0 )
     { // Otherwise, each time step's array will be different.
     ts = timeStep;
     }
@@ -734,7 +752,7 @@ int vtkExodusIIReaderPrivate::AssembleOutputCellArrays(
       if (*atit)
         {
         vtkDataArray* arr = this->GetCacheOrRead(
-          vtkExodusIICacheKey( timeStep, vtkExodusIIReader::ELEM_BLOCK_ATTRIB, obj, a ) );
+          vtkExodusIICacheKey( -1, vtkExodusIIReader::ELEM_BLOCK_ATTRIB, obj, a ) );
         if ( arr )
           {
           cd->AddArray( arr );
@@ -1614,7 +1632,8 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
 {
   vtkDataArray* arr;
   // Never cache points deflected for a mode shape animation... doubles don't make good keys.
-  if ( this->HasModeShapes && key.ObjectType == vtkExodusIIReader::NODAL_COORDS )
+  // The undeflected points (time -1) are cached as usual.
+  if ( this->HasModeShapes && key.ObjectType == vtkExodusIIReader::NODAL_COORDS && key.Time >= 0 )
     {
     arr = 0;
     }
@@ -2583,64 +2602,82 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
   else if ( key.ObjectType == vtkExodusIIReader::NODAL_COORDS )
     {
     // read node coords
-    vtkDataArray* displ = 0;
-    if ( this->ApplyDisplacements && key.Time >= 0 )
+    // The undeflected coordinates are the same at every time step, so they
+    // are read once and cached under the time-constant key (-1); deflected
+    // coordinates start from a copy of them. They are fetched before the
+    // displacements since inserting them may evict the displacements.
+    vtkDataArray* undeflected = 0;
+    if ( this->ApplyDisplacements && key.Time >= 0 && this->GetDisplacementArrayIndex() >= 0 )
       {
-      displ = this->FindDisplacementVectors( key.Time );
+      undeflected = this->GetCacheOrRead(
+        vtkExodusIICacheKey( -1, vtkExodusIIReader::NODAL_COORDS, 0, 0 ) );
       }
 
     std::vector<double> coordTmp;
     vtkDoubleArray* darr = vtkDoubleArray::New();
     arr = darr;
-    arr->SetNumberOfComponents( 3 );
-    arr->SetNumberOfTuples( this->ModelParameters.num_nodes );
     int dim = this->ModelParameters.num_dim;
     int c;
     vtkIdType t;
-    double* xc = 0;
-    double* yc = 0;
-    double* zc = 0;
-    coordTmp.resize( this->ModelParameters.num_nodes );
-    for ( c = 0; c < dim; ++c )
+    if ( undeflected )
       {
-      switch ( c )
-        {
-      case 0:
-        xc = &coordTmp[0];
-        break;
-      case 1:
-        yc = xc;
-        xc = 0;
-        break;
-      case 2:
-        zc = yc;
-        yc = 0;
-        break;
-      default:
-        vtkErrorMacro( "Bad coordinate index " << c << " when reading point coordinates." );
-        xc = yc = zc = 0;
-        }
-      if ( ex_get_coord( exoid, xc, yc, zc ) < 0 )
+      darr->DeepCopy( undeflected );
+      }
+    else
+      {
+      arr->SetNumberOfComponents( 3 );
+      arr->SetNumberOfTuples( this->ModelParameters.num_nodes );
+      double* xc = 0;
+      double* yc = 0;
+      double* zc = 0;
+      coordTmp.resize( this->ModelParameters.num_nodes );
+      for ( c = 0; c < dim; ++c )
         {
-        vtkErrorMacro( "Unable to read node coordinates for index " << c << "." );
-        arr->Delete();
-        arr = 0;
-        break;
+        switch ( c )
+          {
+        case 0:
+          xc = &coordTmp[0];
+          break;
+        case 1:
+          yc = xc;
+          xc = 0;
+          break;
+        case 2:
+          zc = yc;
+          yc = 0;
+          break;
+        default:
+          vtkErrorMacro( "Bad coordinate index " << c << " when reading point coordinates." );
+          xc = yc = zc = 0;
+          }
+        if ( ex_get_coord( exoid, xc, yc, zc ) < 0 )
+          {
+          vtkErrorMacro( "Unable to read node coordinates for index " << c << "." );
+          arr->Delete();
+          arr = 0;
+          break;
+          }
+        double* cptr = darr->GetPointer( c );
+        for ( t = 0; t < this->ModelParameters.num_nodes; ++t )
+          {
+          *cptr = coordTmp[t];
+          cptr += 3;
+          }
         }
-      double* cptr = darr->GetPointer( c );
-      for ( t = 0; t < this->ModelParameters.num_nodes; ++t )
+      if ( arr && dim < 3 )
         {
-        *cptr = coordTmp[t];
-        cptr += 3;
+        double* cptr = darr->GetPointer( 2 );
+        for ( t = 0; t < this->ModelParameters.num_nodes; ++t, cptr += 3 )
+          {
+          *cptr = 0.;
+          }
         }
       }
-    if ( dim < 3 )
+
+    vtkDataArray* displ = 0;
+    if ( arr && this->ApplyDisplacements && key.Time >= 0 )
       {
-      double* cptr = darr->GetPointer( 2 );
-      for ( t = 0; t < this->ModelParameters.num_nodes; ++t, cptr += 3 )
-        {
-        *cptr = 0.;
-        }
+      displ = this->FindDisplacementVectors( key.Time );
       }
     if ( displ )
       {
@@ -3645,6 +3682,7 @@ void vtkExodusIIReaderPrivate::PrintData( ostream& os, vtkIndent indent )
 
   os << indent << "Array Cache:\n";
   this->Cache->PrintSelf( os, inden2 );
+  os << indent << "ReadAhead: " << this->ReadAhead << "\n";
 
   os << indent << "SqueezePoints: " << this->SqueezePoints << "\n";
   os << indent << "ApplyDisplacements: " << this->ApplyDisplacements << "\n";
@@ -3662,6 +3700,10 @@ int vtkExodusIIReaderPrivate::OpenFile( const char* filename )
     return 0;
     }
 
+  // The Exodus library is not thread safe, even across files, so no
+  // read-ahead may go on while a file is used from this thread.
+  vtkExodusIIReaderPrivate::StopAllReadAhead();
+
   if ( this->Exoid >= 0 )
     {
     this->CloseFile();
@@ -3686,6 +3728,7 @@ int vtkExodusIIReaderPrivate::OpenFile( const char* filename )
 
 int vtkExodusIIReaderPrivate::CloseFile()
 {
+  this->StopReadAhead();
   if ( this->Exoid >= 0 )
     {
     VTK_EXO_FUNC( ex_close( this->Exoid ), "Could not close an open file (" << this->Exoid << ")" );
@@ -3695,6 +3738,175 @@ int vtkExodusIIReaderPrivate::CloseFile()
 }
 
 
+//-----------------------------------------------------------------------------
+static VTK_THREAD_RETURN_TYPE vtkExodusIIReaderReadAhead( void* arg )
+{
+  vtkMultiThreader::ThreadInfo* info =
+    static_cast<vtkMultiThreader::ThreadInfo*>( arg );
+  static_cast<vtkExodusIIReaderPrivate*>( info->UserData )->ReadAheadArrays(
+    info->ActiveFlag, info->ActiveFlagLock );
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+void vtkExodusIIReaderPrivate::SetReadAhead( int readAhead )
+{
+  if ( this->ReadAhead == readAhead )
+    return;
+
+  this->StopReadAhead();
+  this->ReadAhead = readAhead;
+  this->Modified();
+}
+
+int vtkExodusIIReaderPrivate::StartReadAhead( vtkIdType timeStep )
+{
+  // Mode shapes are not read by time step and deflected points are never cached.
+  if ( this->HasModeShapes || this->Exoid < 0 || timeStep < 0 ||
+       timeStep >= static_cast<vtkIdType>( this->Times.size() ) ||
+       this->Cache->GetSpaceLeft() <= 0. )
+    {
+    return 0;
+    }
+
+  // List the time-varying arrays that RequestData() reads: the deflected
+  // points (which reads the displacements), the point arrays and the cell
+  // arrays of the enabled blocks and sets.
+  this->ReadAheadKeys.clear();
+  if ( this->ApplyDisplacements && this->GetDisplacementArrayIndex() >= 0 )
+    {
+    this->ReadAheadKeys.push_back(
+      vtkExodusIICacheKey( timeStep, vtkExodusIIReader::NODAL_COORDS, 0, 0 ) );
+    }
+  std::map<int,std::vector<ArrayInfoType> >::iterator ami;
+  std::vector<ArrayInfoType>::iterator ai;
+  int aidx;
+  ami = this->ArrayInfo.find( vtkExodusIIReader::NODAL );
+  if ( ami != this->ArrayInfo.end() )
+    {
+    for ( ai = ami->second.begin(), aidx = 0; ai != ami->second.end(); ++ai, ++aidx )
+      {
+      if ( ai->Status )
+        {
+        this->ReadAheadKeys.push_back(
+          vtkExodusIICacheKey( timeStep, vtkExodusIIReader::NODAL, 0, aidx ) );
+        }
+      }
+    }
+  for ( int conntypidx = 0; conntypidx < num_conn_types; ++conntypidx )
+    {
+    int otypidx = conn_obj_idx_cvt[conntypidx];
+    int otyp = obj_types[otypidx];
+    ami = this->ArrayInfo.find( otyp );
+    if ( ami == this->ArrayInfo.end() )
+      continue;
+
+    int numObj = this->GetNumberOfObjectsOfType( otyp );
+    for ( int obj = 0; obj < numObj; ++obj )
+      {
+      BlockSetInfoType* bsinfop = static_cast<BlockSetInfoType*>( this->GetObjectInfo( otypidx, obj ) );
+      if ( ! bsinfop->Status )
+        continue;
+
+      for ( ai = ami->second.begin(), aidx = 0; ai != ami->second.end(); ++ai, ++aidx )
+        {
+        if ( ai->Status && ai->ObjectTruth[obj] )
+          {
+          this->ReadAheadKeys.push_back( vtkExodusIICacheKey( timeStep, otyp, obj, aidx ) );
+          }
+        }
+      }
+    }
+
+  if ( this->ReadAheadKeys.empty() )
+    {
+    return 0;
+    }
+
+  this->ReadAheadDoneLock->Lock();
+  this->ReadAheadDone = 0;
+  this->ReadAheadDoneLock->Unlock();
+
+  vtkExodusIIReadersReadingAheadLock.Lock();
+  this->ReadAheadThreadId = this->ReadAheadThreader->SpawnThread(
+    vtkExodusIIReaderReadAhead, this );
+  if ( this->ReadAheadThreadId >= 0 )
+    {
+    vtkExodusIIReadersReadingAhead.insert( this );
+    }
+  vtkExodusIIReadersReadingAheadLock.Unlock();
+
+  if ( this->ReadAheadThreadId < 0 )
+    {
+    this->ReadAheadKeys.clear();
+    this->ReadAheadDone = 1;
+    return 0;
+    }
+  return 1;
+}
+
+void vtkExodusIIReaderPrivate::ReadAheadArrays(
+  int* activeFlag, vtkMutexLock* activeFlagLock )
+{
+  std::vector<vtkExodusIICacheKey>::iterator it;
+  for ( it = this->ReadAheadKeys.begin(); it != this->ReadAheadKeys.end(); ++it )
+    {
+    activeFlagLock->Lock();
+    int active = *activeFlag;
+    activeFlagLock->Unlock();
+    // Stop before arrays read ahead push out the ones just read.
+    if ( ! active || this->Cache->GetSpaceLeft() <= 0. )
+      break;
+
+    this->GetCacheOrRead( *it );
+    }
+  ex_close( this->Exoid );
+  this->Exoid = -1;
+
+  this->ReadAheadDoneLock->Lock();
+  this->ReadAheadDone = 1;
+  this->ReadAheadDoneCondition->Broadcast();
+  this->ReadAheadDoneLock->Unlock();
+}
+
+void vtkExodusIIReaderPrivate::StopReadAhead()
+{
+  // Another thread may be stopping this read-ahead in StopAllReadAhead().
+  vtkExodusIIReadersReadingAheadLock.Lock();
+  if ( this->ReadAheadThreadId >= 0 )
+    {
+    this->ReadAheadThreader->TerminateThread( this->ReadAheadThreadId );
+    this->ReadAheadThreadId = -1;
+    this->ReadAheadKeys.clear();
+    vtkExodusIIReadersReadingAhead.erase( this );
+    }
+  vtkExodusIIReadersReadingAheadLock.Unlock();
+}
+
+void vtkExodusIIReaderPrivate::WaitForReadAhead()
+{
+  this->ReadAheadDoneLock->Lock();
+  while ( ! this->ReadAheadDone )
+    {
+    this->ReadAheadDoneCondition->Wait( this->ReadAheadDoneLock );
+    }
+  this->ReadAheadDoneLock->Unlock();
+  this->StopReadAhead();
+}
+
+void vtkExodusIIReaderPrivate::StopAllReadAhead()
+{
+  vtkExodusIIReadersReadingAheadLock.Lock();
+  std::set<vtkExodusIIReaderPrivate*>::iterator it;
+  for ( it = vtkExodusIIReadersReadingAhead.begin();
+        it != vtkExodusIIReadersReadingAhead.end(); ++it )
+    {
+    (*it)->ReadAheadThreader->TerminateThread( (*it)->ReadAheadThreadId );
+    (*it)->ReadAheadThreadId = -1;
+    (*it)->ReadAheadKeys.clear();
+    }
+  vtkExodusIIReadersReadingAhead.clear();
+  vtkExodusIIReadersReadingAheadLock.Unlock();
+}
 
 int vtkExodusIIReaderPrivate::UpdateTimeInformation()
 {
@@ -4347,7 +4559,11 @@ int vtkExodusIIReaderPrivate::RequestData( vtkIdType timeStep, vtkMultiBlockData
       }
     }
 
-  this->CloseFile();
+  // The read-ahead thread closes the file once it is done with it.
+  if ( ! this->ReadAhead || ! this->StartReadAhead( timeStep + 1 ) )
+    {
+    this->CloseFile();
+    }
 
   return 0;
 }
@@ -4532,6 +4748,7 @@ void vtkExodusIIReaderPrivate::ResetSettings()
 
 void vtkExodusIIReaderPrivate::ResetCache()
 {
+  this->StopReadAhead();
   this->Cache->Clear();
   this->Cache->SetCacheCapacity(this->CacheSize); // FIXME: Perhaps Cache should have a Reset and a Clear method?
   this->ClearConnectivityCaches();
@@ -4541,6 +4758,7 @@ void vtkExodusIIReaderPrivate::SetCacheSize( double size )
 {
   if (this->CacheSize != size)
     {
+    this->StopReadAhead();
     this->CacheSize = size;
     this->Cache->SetCacheCapacity(this->CacheSize);
     this->Modified();
@@ -4826,6 +5044,7 @@ void vtkExodusIIReaderPrivate::SetObjectArrayStatus( int otyp, int i, int stat )
     // it was any faster before.
     //vtkExodusIICacheKey key( 0, GLOBAL, 0, i );
     //vtkExodusIICacheKey pattern( 0, 1, 0, 1 );
+    this->StopReadAhead();
     this->Cache->Invalidate(
       vtkExodusIICacheKey( 0, vtkExodusIIReader::GLOBAL, otyp, i ),
       vtkExodusIICacheKey( 0, 1, 1, 1 ) );
@@ -4987,6 +5206,7 @@ void vtkExodusIIReaderPrivate::SetApplyDisplacements( int d )
   if ( this->ApplyDisplacements == d )
     return;
 
+  this->StopReadAhead();
   this->ApplyDisplacements = d;
   this->Modified();
 
@@ -5001,6 +5221,7 @@ void vtkExodusIIReaderPrivate::SetDisplacementMagnitude( double s )
   if ( this->DisplacementMagnitude == s )
     return;
 
+  this->StopReadAhead();
   this->DisplacementMagnitude = s;
   this->Modified();
 
@@ -5010,7 +5231,7 @@ void vtkExodusIIReaderPrivate::SetDisplacementMagnitude( double s )
     vtkExodusIICacheKey( 0, 1, 0, 0 ) );
 }
 
-vtkDataArray* vtkExodusIIReaderPrivate::FindDisplacementVectors( int timeStep )
+int vtkExodusIIReaderPrivate::GetDisplacementArrayIndex()
 {
   std::map<int,std::vector<ArrayInfoType> >::iterator it = this->ArrayInfo.find( vtkExodusIIReader::NODAL );
   if ( it != this->ArrayInfo.end() )
@@ -5021,11 +5242,21 @@ vtkDataArray* vtkExodusIIReaderPrivate::FindDisplacementVectors( int timeStep )
       std::string upperName = vtksys::SystemTools::UpperCase( it->second[i].Name.substr( 0, 3 ) );
       if ( upperName == "DIS" && it->second[i].Components == this->ModelParameters.num_dim )
         {
-        return this->GetCacheOrRead( vtkExodusIICacheKey( timeStep, vtkExodusIIReader::NODAL, 0, i ) );
+        return i;
         }
       }
     }
-  return 0;
+  return -1;
+}
+
+vtkDataArray* vtkExodusIIReaderPrivate::FindDisplacementVectors( int timeStep )
+{
+  int i = this->GetDisplacementArrayIndex();
+  if ( i < 0 )
+    {
+    return 0;
+    }
+  return this->GetCacheOrRead( vtkExodusIICacheKey( timeStep, vtkExodusIIReader::NODAL, 0, i ) );
 }
 
 
@@ -6227,6 +6458,32 @@ double vtkExodusIIReader::GetCacheSize()
   return this->Metadata->GetCacheSize();
 }
 
+vtkExodusIICache* vtkExodusIIReader::GetCache()
+{
+  this->Metadata->StopReadAhead();
+  return this->Metadata->GetCache();
+}
+
+void vtkExodusIIReader::SetReadAhead(int readAhead)
+{
+  this->Metadata->SetReadAhead(readAhead);
+}
+
+int vtkExodusIIReader::GetReadAhead()
+{
+  return this->Metadata->GetReadAhead();
+}
+
+void vtkExodusIIReader::WaitForReadAhead()
+{
+  this->Metadata->WaitForReadAhead();
+}
+
+void vtkExodusIIReader::StopAllReadAhead()
+{
+  vtkExodusIIReaderPrivate::StopAllReadAhead();
+}
+
 void vtkExodusIIReader::SetSqueezePoints(bool sp)
 {
   this->Metadata->SetSqueezePoints(sp ? 1 : 0);
@@ -668,6 +668,38 @@ public:
   // Get the size of the cache in MiB.
   double GetCacheSize();
 
+  // Description:
+  // Return the cache of arrays read from the file, for example to query how
+  // many requests it answered. Time-constant arrays such as the undeflected
+  // point coordinates and the block attributes are cached once for all time
+  // steps. This stops any read-ahead in progress.
+  vtkExodusIICache* GetCache();
+
+  // Description:
+  // When on, the arrays of the time step following the one just read are
+  // read into the cache by a background thread, after RequestData returns
+  // and until the cache is full or the reader is used again. This hides the
+  // latency of reading many blocks when stepping forward through time, but
+  // only helps with a cache large enough to hold a time step. Off by
+  // default. The Exodus and netCDF libraries are not thread safe, even
+  // across files. The read-ahead of every reader is stopped whenever any
+  // reader opens a file or vtkExodusIIWriter writes one, but other users
+  // of netCDF, such as vtkNetCDFReader or vtkSLACReader, do not know about
+  // it: call StopAllReadAhead() before running them, or leave ReadAhead off.
+  void SetReadAhead(int readAhead);
+  int GetReadAhead();
+  vtkBooleanMacro(ReadAhead,int);
+
+  // Description:
+  // Wait until the read-ahead in progress, if any, has read the next time
+  // step or filled the cache.
+  void WaitForReadAhead();
+
+  // Description:
+  // Stop the read-ahead of every vtkExodusIIReader, so that the netCDF
+  // library may be used from this thread.
+  static void StopAllReadAhead();
+
   // Description:
   // Should the reader output only points used by elements in the output mesh,
   // or all the points. Outputting all the points is much faster since the
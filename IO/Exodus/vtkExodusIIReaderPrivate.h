@@ -13,8 +13,11 @@
 
 #include "vtk_exodusII.h"
 #include "vtkIOExodusModule.h" // For export macro
+class vtkConditionVariable;
 class vtkExodusIIReaderParser;
+class vtkMultiThreader;
 class vtkMutableDirectedGraph;
+class vtkMutexLock;
 
 /** This class holds metadata for an Exodus file.
   *
@@ -77,6 +80,39 @@ public:
   /// Get the size of the cache in MiB.
   vtkGetMacro(CacheSize, double);
 
+  /// Return the cache of arrays read from the file.
+  vtkExodusIICache* GetCache()
+    { return this->Cache; }
+
+  /** Set whether RequestData() starts reading the arrays of the next time
+    * step into the cache in the background before returning.
+    */
+  void SetReadAhead( int readAhead );
+  vtkGetMacro(ReadAhead,int);
+
+  /** Stop reading ahead, if a read-ahead is in progress, and wait for the
+    * read-ahead thread to close the file.
+    * This is called before the file or the cache is used again.
+    */
+  void StopReadAhead();
+
+  /** Wait until the read-ahead in progress, if any, has read all its
+    * arrays or filled the cache, then stop it.
+    */
+  void WaitForReadAhead();
+
+  /** Stop the read-ahead of every reader.
+    * The Exodus and netCDF libraries are not thread safe, even across
+    * files, so this is called before they are used from another thread.
+    */
+  static void StopAllReadAhead();
+
+  /** Read the arrays listed in ReadAheadKeys into the cache until the cache
+    * is full or \a activeFlag is cleared, then close the file.
+    * This runs in the read-ahead thread; do not call it directly.
+    */
+  void ReadAheadArrays( int* activeFlag, vtkMutexLock* activeFlagLock );
+
   /** Return the number of time steps in the open file.
     * You must have called RequestInformation() before
     * invoking this member function.
@@ -266,6 +302,9 @@ public:
 
   vtkDataArray* FindDisplacementVectors( int timeStep );
 
+  /// Return the index of the nodal array used as displacements or -1 if there is none.
+  int GetDisplacementArrayIndex();
+
   const struct ex_init_params* GetModelParams() const
     { return &this->ModelParameters; }
 
@@ -602,6 +641,13 @@ protected:
   void InsertSetSides(
     vtkIntArray* refs, int otyp, int obj, SetInfoType* sinfo );
 
+  /** Start reading the arrays that RequestData() would read for the time
+    * step \a timeStep in the background, leaving the file open for the
+    * read-ahead thread. Returns 0 and does nothing when there is nothing to
+    * read ahead or no thread could be started.
+    */
+  int StartReadAhead( vtkIdType timeStep );
+
   /** Return an array for the specified cache key. If the array was not cached,
     * read it from the file.
     * This function can still return 0 if you are foolish enough to request an
@@ -797,6 +843,19 @@ protected:
   /// The size of the cache in MiB.
   double CacheSize;
 
+  /** Whether to read the arrays of the next time step ahead, the thread
+    * reading them (-1 when no read-ahead is in progress) and their keys.
+    * ReadAheadDone is set, under ReadAheadDoneLock, once the thread has
+    * closed the file.
+    */
+  int ReadAhead;
+  vtkMultiThreader* ReadAheadThreader;
+  int ReadAheadThreadId;
+  std::vector<vtkExodusIICacheKey> ReadAheadKeys;
+  int ReadAheadDone;
+  vtkMutexLock* ReadAheadDoneLock;
+  vtkConditionVariable* ReadAheadDoneCondition;
+
   int ApplyDisplacements;
   float DisplacementMagnitude;
   int HasModeShapes;
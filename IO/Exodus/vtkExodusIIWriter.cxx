@@ -19,6 +19,7 @@
 ----------------------------------------------------------------------------*/
 
 #include "vtkExodusIIWriter.h"
+#include "vtkExodusIIReader.h"
 #include "vtkObjectFactory.h"
 #include "vtkModelMetadata.h"
 #include "vtkInformation.h"
@@ -228,6 +229,9 @@ int vtkExodusIIWriter::RequestData (
     return 1;
     }
 
+  // The Exodus library is not thread safe, even across files.
+  vtkExodusIIReader::StopAllReadAhead();
+
   vtkInformation* inInfo = inputVector[0]->GetInformationObject (0);
   this->OriginalInput = vtkDataObject::SafeDownCast (
     inInfo->Get(vtkDataObject::DATA_OBJECT ()));
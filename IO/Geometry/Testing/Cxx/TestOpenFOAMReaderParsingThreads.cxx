@@ -0,0 +1,275 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestOpenFOAMReaderParsingThreads.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Writes a two-cell OpenFOAM case with ASCII and binary fields and checks
+// that the fields read with several parsing threads are the same as the
+// fields read one file at a time, and that binary fields are read exactly.
+
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkOpenFOAMReader.h"
+#include "vtkPointData.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <vtksys/SystemTools.hxx>
+
+#include <stdio.h>
+#include <string>
+
+namespace
+{
+const int NumberOfTimeSteps = 3;
+
+FILE* OpenFoamFile(const std::string& fileName, const char* format,
+                   const char* className, const char* object)
+{
+  FILE* file = fopen(fileName.c_str(), "wb");
+  fprintf(file, "FoamFile\n{\n    version 2.0;\n    format %s;\n", format);
+  fprintf(file, "    class %s;\n    object %s;\n}\n", className, object);
+  return file;
+}
+
+// Two unit hexahedra along x: 12 points, 1 internal face and 10 faces on
+// a single patch.
+void WriteMesh(const std::string& caseDir)
+{
+  std::string meshDir = caseDir + "/constant/polyMesh";
+  vtksys::SystemTools::MakeDirectory(meshDir.c_str());
+
+  FILE* file = OpenFoamFile(meshDir + "/points", "ascii", "vectorField",
+                            "points");
+  fprintf(file, "12\n(\n");
+  for (int i = 0; i < 12; ++i)
+    {
+    fprintf(file, "(%d %d %d)\n", i % 3, (i / 3) % 2, i / 6);
+    }
+  fprintf(file, ")\n");
+  fclose(file);
+
+  file = OpenFoamFile(meshDir + "/faces", "ascii", "faceList", "faces");
+  fprintf(file, "11\n(\n4(1 4 10 7)\n4(0 6 9 3)\n4(2 5 11 8)\n");
+  for (int c = 0; c < 2; ++c)
+    {
+    fprintf(file, "4(%d %d %d %d)\n", c, c + 1, c + 7, c + 6);
+    fprintf(file, "4(%d %d %d %d)\n", c + 3, c + 9, c + 10, c + 4);
+    fprintf(file, "4(%d %d %d %d)\n", c, c + 3, c + 4, c + 1);
+    fprintf(file, "4(%d %d %d %d)\n", c + 6, c + 7, c + 10, c + 9);
+    }
+  fprintf(file, ")\n");
+  fclose(file);
+
+  file = OpenFoamFile(meshDir + "/owner", "ascii", "labelList", "owner");
+  fprintf(file, "11\n(\n0 0 1 0 0 0 0 1 1 1 1\n)\n");
+  fclose(file);
+
+  file = OpenFoamFile(meshDir + "/neighbour", "ascii", "labelList",
+                      "neighbour");
+  fprintf(file, "1\n(\n1\n)\n");
+  fclose(file);
+
+  file = OpenFoamFile(meshDir + "/boundary", "ascii", "polyBoundaryMesh",
+                      "boundary");
+  fprintf(file, "1\n(\nwalls\n{\n    type wall;\n    nFaces 10;\n"
+          "    startFace 1;\n}\n)\n");
+  fclose(file);
+
+  std::string systemDir = caseDir + "/system";
+  vtksys::SystemTools::MakeDirectory(systemDir.c_str());
+  file = OpenFoamFile(systemDir + "/controlDict", "ascii", "dictionary",
+                      "controlDict");
+  fprintf(file, "startTime 0;\nendTime %d;\ndeltaT 1;\n",
+          NumberOfTimeSteps - 1);
+  fprintf(file, "writeControl timeStep;\nwriteInterval 1;\n");
+  fclose(file);
+
+  file = fopen((caseDir + "/case.foam").c_str(), "wb");
+  fclose(file);
+}
+
+double Value(int step, int field, int i)
+{
+  return 0.125 * step + 1.5 * field + i / 3.0;
+}
+
+// Writes the internal field of a volume or point field of the given
+// number of components, in ASCII or binary.
+void WriteField(const std::string& timeDir, int step, int field,
+                bool binary, bool point, int nComponents)
+{
+  const char* names[] = { "ScalarA", "VectorB", "ScalarC", "ScalarD" };
+  std::string className = point ? "point" : "vol";
+  className += nComponents == 1 ? "ScalarField" : "VectorField";
+  FILE* file = OpenFoamFile(timeDir + "/" + names[field],
+                            binary ? "binary" : "ascii", className.c_str(),
+                            names[field]);
+  const int n = point ? 12 : 2;
+  fprintf(file, "dimensions [0 0 0 0 0 0 0];\ninternalField nonuniform "
+          "List<%s> %d(", nComponents == 1 ? "scalar" : "vector", n);
+  for (int i = 0; i < n * nComponents; ++i)
+    {
+    double value = Value(step, field, i);
+    if (binary)
+      {
+      fwrite(&value, sizeof(double), 1, file);
+      }
+    else
+      {
+      const bool first = i % nComponents == 0;
+      const bool last = i % nComponents == nComponents - 1;
+      fprintf(file, "%s%.17g%s ", first && nComponents > 1 ? "(" : "",
+              value, last && nComponents > 1 ? ")" : "");
+      }
+    }
+  fprintf(file, ");\nboundaryField\n{\n    walls\n    {\n"
+          "        type fixedValue;\n        value uniform %s;\n    }\n}\n",
+          nComponents == 1 ? "1" : "(1 2 3)");
+  fclose(file);
+}
+
+bool CompareArrays(vtkDataArray* actual, vtkDataArray* expected,
+                   const char* name)
+{
+  if (!actual || !expected ||
+      actual->GetNumberOfTuples() != expected->GetNumberOfTuples() ||
+      actual->GetNumberOfComponents() != expected->GetNumberOfComponents())
+    {
+    cerr << "Missing or truncated " << name << endl;
+    return false;
+    }
+  for (vtkIdType i = 0; i < expected->GetNumberOfTuples(); ++i)
+    {
+    for (int c = 0; c < expected->GetNumberOfComponents(); ++c)
+      {
+      if (actual->GetComponent(i, c) != expected->GetComponent(i, c))
+        {
+        cerr << "Wrong " << name << " at " << i << endl;
+        return false;
+        }
+      }
+    }
+  return true;
+}
+
+void ReadTimeStep(vtkOpenFOAMReader* reader, int step)
+{
+  vtkStreamingDemandDrivenPipeline::SetUpdateTimeStep(
+    reader->GetOutputInformation(0), step);
+  reader->Update();
+}
+
+vtkUnstructuredGrid* GetInternalMesh(vtkOpenFOAMReader* reader)
+{
+  return vtkUnstructuredGrid::SafeDownCast(reader->GetOutput()->GetBlock(0));
+}
+}
+
+int TestOpenFOAMReaderParsingThreads(int argc, char* argv[])
+{
+  char* tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  if (!tempDir)
+    {
+    cerr << "Could not determine temporary directory." << endl;
+    return EXIT_FAILURE;
+    }
+  std::string caseDir = tempDir;
+  delete [] tempDir;
+  caseDir += "/TestOpenFOAMReaderParsingThreads";
+  vtksys::SystemTools::RemoveADirectory(caseDir.c_str());
+
+  WriteMesh(caseDir);
+  for (int step = 0; step < NumberOfTimeSteps; ++step)
+    {
+    char timeName[16];
+    sprintf(timeName, "/%d", step);
+    std::string timeDir = caseDir + timeName;
+    vtksys::SystemTools::MakeDirectory(timeDir.c_str());
+    WriteField(timeDir, step, 0, false, false, 1);
+    WriteField(timeDir, step, 1, true, false, 3);
+    WriteField(timeDir, step, 2, true, false, 1);
+    WriteField(timeDir, step, 3, true, true, 1);
+    }
+
+  const char* cellArrays[] = { "ScalarA", "VectorB", "ScalarC" };
+  std::string fileName = caseDir + "/case.foam";
+  vtkNew<vtkOpenFOAMReader> serialReader;
+  serialReader->SetFileName(fileName.c_str());
+  serialReader->CreateCellToPointOff();
+  serialReader->UpdateInformation();
+  for (int threads = 0; threads < 4; threads += 3)
+    {
+    vtkNew<vtkOpenFOAMReader> reader;
+    reader->SetFileName(fileName.c_str());
+    reader->CreateCellToPointOff();
+    reader->SetNumberOfParsingThreads(threads);
+    reader->UpdateInformation();
+    for (int step = 0; step < NumberOfTimeSteps; ++step)
+      {
+      ReadTimeStep(serialReader.GetPointer(), step);
+      ReadTimeStep(reader.GetPointer(), step);
+      vtkUnstructuredGrid* expected = GetInternalMesh(serialReader.GetPointer());
+      vtkUnstructuredGrid* actual = GetInternalMesh(reader.GetPointer());
+      if (!expected || !actual || expected->GetNumberOfCells() != 2)
+        {
+        cerr << "Missing internal mesh at time step " << step << endl;
+        return EXIT_FAILURE;
+        }
+      for (int field = 0; field < 3; ++field)
+        {
+        if (!CompareArrays(actual->GetCellData()->GetArray(cellArrays[field]),
+                           expected->GetCellData()->GetArray(cellArrays[field]),
+                           cellArrays[field]))
+          {
+          cerr << "With " << threads << " parsing threads" << endl;
+          return EXIT_FAILURE;
+          }
+        }
+      if (!CompareArrays(actual->GetPointData()->GetArray("ScalarD"),
+                         expected->GetPointData()->GetArray("ScalarD"),
+                         "ScalarD"))
+        {
+        cerr << "With " << threads << " parsing threads" << endl;
+        return EXIT_FAILURE;
+        }
+
+      // The binary fields are converted from double to float.
+      vtkDataArray* vectors = actual->GetCellData()->GetArray("VectorB");
+      vtkDataArray* points = actual->GetPointData()->GetArray("ScalarD");
+      for (int i = 0; i < 6; ++i)
+        {
+        if (vectors->GetComponent(i / 3, i % 3) !=
+            static_cast<float>(Value(step, 1, i)))
+          {
+          cerr << "Wrong binary vector field at time step " << step << endl;
+          return EXIT_FAILURE;
+          }
+        }
+      for (int i = 0; i < 12; ++i)
+        {
+        if (points->GetComponent(i, 0) !=
+            static_cast<float>(Value(step, 3, i)))
+          {
+          cerr << "Wrong binary point field at time step " << step << endl;
+          return EXIT_FAILURE;
+          }
+        }
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
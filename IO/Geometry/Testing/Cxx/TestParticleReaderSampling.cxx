@@ -0,0 +1,311 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestParticleReaderSampling.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Writes binary and text particle files whose scalar is the index of the
+// particle, reads them with a stride, with a sampling ratio of single
+// particles or of blocks of particles and as progressive levels of
+// detail, and checks which particles are read.
+
+#include <vtkCellArray.h>
+#include <vtkDataArray.h>
+#include <vtkNew.h>
+#include <vtkParticleReader.h>
+#include <vtkPointData.h>
+#include <vtkPolyData.h>
+#include <vtkStreamingDemandDrivenPipeline.h>
+#include <vtkTestUtilities.h>
+
+#include <algorithm>
+#include <fstream>
+#include <set>
+#include <string>
+
+namespace
+{
+typedef std::set<vtkIdType> ParticleSet;
+
+// Read the given piece and return the indices of the particles read.
+ParticleSet Read(const std::string& fileName, bool binary, int stride,
+                 double ratio, int seed, int progressive,
+                 int piece = 0, int numPieces = 1, int blockSize = 1)
+{
+  vtkNew<vtkParticleReader> reader;
+  reader->SetFileName(fileName.c_str());
+  if (binary)
+    {
+    reader->SetFileTypeToBinary();
+    }
+  else
+    {
+    reader->SetFileTypeToText();
+    }
+  reader->SetDataTypeToFloat();
+  reader->SetSampleStride(stride);
+  reader->SetSampleRatio(ratio);
+  reader->SetSampleBlockSize(blockSize);
+  reader->SetRandomSeed(seed);
+  reader->SetProgressiveSampling(progressive);
+  reader->UpdateInformation();
+  vtkStreamingDemandDrivenPipeline::SetUpdateExtent(
+    reader->GetOutputInformation(0), piece, numPieces, 0);
+  reader->Update();
+
+  ParticleSet particles;
+  vtkPolyData* output = reader->GetOutput();
+  vtkDataArray* scalars = output->GetPointData()->GetScalars();
+  vtkCellArray* verts = output->GetVerts();
+  if (!scalars || verts->GetNumberOfConnectivityEntries() -
+      verts->GetNumberOfCells() != output->GetNumberOfPoints())
+    {
+    return particles;
+    }
+  for (vtkIdType i = 0; i < scalars->GetNumberOfTuples(); ++i)
+    {
+    particles.insert(static_cast<vtkIdType>(scalars->GetTuple1(i)));
+    }
+  return particles;
+}
+
+bool Includes(const ParticleSet& a, const ParticleSet& b)
+{
+  return std::includes(a.begin(), a.end(), b.begin(), b.end());
+}
+
+// Check that a sample of the first numberOfParticles particles is made of
+// whole blocks of blockSize particles, and return the number of blocks.
+vtkIdType CountBlocks(const ParticleSet& sample, vtkIdType numberOfParticles,
+                      vtkIdType blockSize)
+{
+  vtkIdType blocks = 0;
+  for (ParticleSet::const_iterator it = sample.begin(); it != sample.end();
+       ++blocks)
+    {
+    vtkIdType first = *it / blockSize * blockSize;
+    vtkIdType last = std::min(first + blockSize, numberOfParticles);
+    for (vtkIdType i = first; i < last; ++i, ++it)
+      {
+      if (it == sample.end() || *it != i)
+        {
+        cerr << "Particle " << i << " of a sampled block was not read"
+             << endl;
+        return -1;
+        }
+      }
+    }
+  return blocks;
+}
+}
+
+int TestParticleReaderSampling(int argc, char* argv[])
+{
+  char* tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  if (!tempDir)
+    {
+    cerr << "Could not determine temporary directory." << endl;
+    return EXIT_FAILURE;
+    }
+  std::string prefix = tempDir;
+  delete [] tempDir;
+  prefix += "/TestParticleReaderSampling";
+  std::string binaryName = prefix + ".raw";
+  std::string textName = prefix + ".txt";
+
+  const vtkIdType numberOfParticles = 200000;
+  const vtkIdType numberOfTextParticles = 5000;
+  std::ofstream binary(binaryName.c_str(), std::ios::out | std::ios::binary);
+  std::ofstream text(textName.c_str());
+  text << "# x y z index\n";
+  for (vtkIdType i = 0; i < numberOfParticles; ++i)
+    {
+    float values[4] = { static_cast<float>(i % 100),
+                        static_cast<float>((i / 100) % 100),
+                        static_cast<float>(i / 10000),
+                        static_cast<float>(i) };
+    binary.write(reinterpret_cast<char*>(values), sizeof(values));
+    if (i < numberOfTextParticles)
+      {
+      text << values[0] << " " << values[1] << " " << values[2] << " "
+           << values[3] << "\n";
+      }
+    }
+  binary.close();
+  text.close();
+
+  const bool binaryType = true;
+  const bool textType = false;
+
+  ParticleSet all = Read(binaryName, binaryType, 1, 1.0, 0, 0);
+  if (static_cast<vtkIdType>(all.size()) != numberOfParticles)
+    {
+    cerr << "Read " << all.size() << " particles instead of "
+         << numberOfParticles << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Every seventh particle.
+  ParticleSet strided = Read(binaryName, binaryType, 7, 1.0, 0, 0);
+  if (static_cast<vtkIdType>(strided.size()) != (numberOfParticles + 6) / 7)
+    {
+    cerr << "Read " << strided.size() << " particles with a stride of 7"
+         << endl;
+    return EXIT_FAILURE;
+    }
+  for (ParticleSet::iterator it = strided.begin(); it != strided.end(); ++it)
+    {
+    if (*it % 7 != 0)
+      {
+      cerr << "Particle " << *it << " read with a stride of 7" << endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  // Random samples are reproducible, nested and depend on the seed.
+  ParticleSet sample = Read(binaryName, binaryType, 1, 0.01, 0, 0);
+  ParticleSet larger = Read(binaryName, binaryType, 1, 0.05, 0, 0);
+  ParticleSet other = Read(binaryName, binaryType, 1, 0.01, 3, 0);
+  if (sample.size() < 1800 || sample.size() > 2200 ||
+      larger.size() < 9500 || larger.size() > 10500)
+    {
+    cerr << "Read " << sample.size() << " and " << larger.size()
+         << " particles with ratios of 0.01 and 0.05" << endl;
+    return EXIT_FAILURE;
+    }
+  if (sample != Read(binaryName, binaryType, 1, 0.01, 0, 0) ||
+      !Includes(larger, sample) || other == sample)
+    {
+    cerr << "The random samples are not reproducible or not nested" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Far apart particles are read on their own.
+  ParticleSet sparse = Read(binaryName, binaryType, 1000, 1.0, 0, 0);
+  if (static_cast<vtkIdType>(sparse.size()) != numberOfParticles / 1000 ||
+      *sparse.begin() != 0 || *sparse.rbegin() != numberOfParticles - 1000)
+    {
+    cerr << "Read " << sparse.size() << " particles with a stride of 1000"
+         << endl;
+    return EXIT_FAILURE;
+    }
+
+  // The pieces of a sample partition the sample.
+  ParticleSet pieces;
+  for (int piece = 0; piece < 4; ++piece)
+    {
+    ParticleSet p = Read(binaryName, binaryType, 1, 0.05, 0, 0, piece, 4);
+    pieces.insert(p.begin(), p.end());
+    }
+  if (pieces != larger)
+    {
+    cerr << "The pieces of a sample do not make up the sample" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Progressive levels are disjoint, spread over the whole file, and
+  // together make up the sample.
+  ParticleSet levels;
+  size_t total = 0;
+  for (int level = 0; level < 5; ++level)
+    {
+    ParticleSet p = Read(binaryName, binaryType, 1, 0.05, 0, 1, level, 5);
+    if (p.empty() || *p.begin() > numberOfParticles / 10 ||
+        *p.rbegin() < numberOfParticles - numberOfParticles / 10)
+      {
+      cerr << "Level " << level << " is not spread over the file" << endl;
+      return EXIT_FAILURE;
+      }
+    total += p.size();
+    levels.insert(p.begin(), p.end());
+    }
+  if (levels != larger || total != larger.size())
+    {
+    cerr << "The progressive levels do not make up the sample" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Blocks of particles are kept or dropped together, and their samples
+  // are nested and partitioned by the pieces and levels like those of
+  // single particles.
+  const vtkIdType blockSize = 256;
+  const vtkIdType numberOfBlocks =
+    (numberOfParticles + blockSize - 1) / blockSize;
+  ParticleSet blockSample =
+    Read(binaryName, binaryType, 1, 0.1, 0, 0, 0, 1, blockSize);
+  ParticleSet largerBlockSample =
+    Read(binaryName, binaryType, 1, 0.2, 0, 0, 0, 1, blockSize);
+  vtkIdType blocks =
+    CountBlocks(blockSample, numberOfParticles, blockSize);
+  if (blocks < numberOfBlocks / 20 || blocks > numberOfBlocks / 5 ||
+      CountBlocks(largerBlockSample, numberOfParticles, blockSize) < 0 ||
+      !Includes(largerBlockSample, blockSample))
+    {
+    cerr << "Read " << blocks << " blocks of " << numberOfBlocks
+         << " with a ratio of 0.1" << endl;
+    return EXIT_FAILURE;
+    }
+  ParticleSet blockPieces;
+  for (int piece = 0; piece < 3; ++piece)
+    {
+    ParticleSet p =
+      Read(binaryName, binaryType, 1, 0.1, 0, 0, piece, 3, blockSize);
+    blockPieces.insert(p.begin(), p.end());
+    }
+  ParticleSet blockLevels;
+  total = 0;
+  for (int level = 0; level < 4; ++level)
+    {
+    ParticleSet p =
+      Read(binaryName, binaryType, 1, 1.0, 0, 1, level, 4, blockSize);
+    if (CountBlocks(p, numberOfParticles, blockSize) <= 0 ||
+        *p.begin() > numberOfParticles / 10 ||
+        *p.rbegin() < numberOfParticles - numberOfParticles / 10)
+      {
+      cerr << "Level " << level << " of blocks is not spread over the file"
+           << endl;
+      return EXIT_FAILURE;
+      }
+    total += p.size();
+    blockLevels.insert(p.begin(), p.end());
+    }
+  if (blockPieces != blockSample || blockLevels != all ||
+      total != all.size())
+    {
+    cerr << "The pieces or levels of blocks do not make up the sample"
+         << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Text files are sampled the same way.
+  ParticleSet allText = Read(textName, textType, 1, 1.0, 0, 0);
+  ParticleSet textLevels;
+  for (int level = 0; level < 3; ++level)
+    {
+    ParticleSet p = Read(textName, textType, 1, 1.0, 0, 1, level, 3);
+    textLevels.insert(p.begin(), p.end());
+    }
+  ParticleSet textSample =
+    Read(textName, textType, 3, 0.5, 0, 0, 0, 1, blockSize);
+  ParticleSet binarySample =
+    Read(binaryName, binaryType, 3, 0.5, 0, 0, 0, 1, blockSize);
+  ParticleSet expectedSample(binarySample.begin(),
+    binarySample.lower_bound(numberOfTextParticles));
+  if (static_cast<vtkIdType>(allText.size()) != numberOfTextParticles ||
+      textLevels != allText || textSample != expectedSample)
+    {
+    cerr << "Wrong particles read from the text file" << endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
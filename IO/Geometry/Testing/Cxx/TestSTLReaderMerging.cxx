@@ -0,0 +1,164 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestSTLReaderMerging.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that merging the points of STL files by sorting them gives the
+// same points and triangles as merging them with vtkMergePoints, for
+// binary and ASCII files, and that a file without triangles is read.
+
+#include <vtkCellArray.h>
+#include <vtkIdTypeArray.h>
+#include <vtkMergePoints.h>
+#include <vtkNew.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+#include <vtkSmartPointer.h>
+#include <vtkSTLReader.h>
+#include <vtkSTLWriter.h>
+#include <vtkTestUtilities.h>
+
+#include <stdio.h>
+#include <string>
+
+namespace
+{
+vtkSmartPointer<vtkPolyData> Read(const std::string& fileName, int merging,
+                                  bool locator)
+{
+  vtkNew<vtkSTLReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->SetMerging(merging);
+  if (locator)
+    {
+    vtkNew<vtkMergePoints> mergePoints;
+    reader->SetLocator(mergePoints.GetPointer());
+    }
+  reader->Update();
+  return reader->GetOutput();
+}
+
+bool Compare(vtkPolyData* actual, vtkPolyData* expected)
+{
+  if (actual->GetNumberOfPoints() != expected->GetNumberOfPoints() ||
+      actual->GetNumberOfPolys() != expected->GetNumberOfPolys())
+    {
+    cerr << "Read " << actual->GetNumberOfPoints() << " points and "
+         << actual->GetNumberOfPolys() << " triangles instead of "
+         << expected->GetNumberOfPoints() << " and "
+         << expected->GetNumberOfPolys() << endl;
+    return false;
+    }
+  for (vtkIdType i = 0; i < expected->GetNumberOfPoints(); ++i)
+    {
+    double a[3];
+    double e[3];
+    actual->GetPoint(i, a);
+    expected->GetPoint(i, e);
+    if (a[0] != e[0] || a[1] != e[1] || a[2] != e[2])
+      {
+      cerr << "Wrong point " << i << endl;
+      return false;
+      }
+    }
+  vtkIdTypeArray* a = actual->GetPolys()->GetData();
+  vtkIdTypeArray* e = expected->GetPolys()->GetData();
+  for (vtkIdType i = 0; i < e->GetNumberOfTuples(); ++i)
+    {
+    if (a->GetValue(i) != e->GetValue(i))
+      {
+      cerr << "Wrong connectivity at " << i << endl;
+      return false;
+      }
+    }
+  return true;
+}
+}
+
+int TestSTLReaderMerging(int argc, char* argv[])
+{
+  char* tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  if (!tempDir)
+    {
+    cerr << "Could not determine temporary directory." << endl;
+    return EXIT_FAILURE;
+    }
+  std::string fileName = tempDir;
+  delete [] tempDir;
+  fileName += "/TestSTLReaderMerging.stl";
+
+  // A grid of triangles shuffled over the file, with coincident points
+  // of opposite zero signs and a degenerate triangle.
+  const int n = 300;
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkCellArray> triangles;
+  for (int j = 0; j < n; ++j)
+    {
+    for (int i = 0; i < n; ++i)
+      {
+      points->InsertNextPoint(i == 0 && j % 2 ? -0.0 : i, j, 0.0);
+      }
+    }
+  for (vtkIdType c = 0; c < (n - 1) * (n - 1); ++c)
+    {
+    vtkIdType cell = (c * 7919) % ((n - 1) * (n - 1));
+    vtkIdType p = cell + cell / (n - 1);
+    vtkIdType pts[3] = { p, p + 1, p + n };
+    triangles->InsertNextCell(3, pts);
+    }
+  vtkIdType degenerate[3] = { 0, n, n };
+  triangles->InsertNextCell(3, degenerate);
+  vtkNew<vtkPolyData> surface;
+  surface->SetPoints(points.GetPointer());
+  surface->SetPolys(triangles.GetPointer());
+
+  for (int binary = 0; binary < 2; ++binary)
+    {
+    vtkNew<vtkSTLWriter> writer;
+    writer->SetInputData(surface.GetPointer());
+    writer->SetFileName(fileName.c_str());
+    writer->SetFileType(binary ? VTK_BINARY : VTK_ASCII);
+    writer->Write();
+
+    vtkSmartPointer<vtkPolyData> unmerged = Read(fileName, 0, false);
+    if (unmerged->GetNumberOfPoints() != 3 * triangles->GetNumberOfCells())
+      {
+      cerr << "Read " << unmerged->GetNumberOfPoints() << " points" << endl;
+      return EXIT_FAILURE;
+      }
+    vtkSmartPointer<vtkPolyData> expected = Read(fileName, 1, true);
+    vtkSmartPointer<vtkPolyData> sorted = Read(fileName, 1, false);
+    if (expected->GetNumberOfPolys() != triangles->GetNumberOfCells() - 1 ||
+        !Compare(sorted, expected))
+      {
+      cerr << "Wrong merging of the " << (binary ? "binary" : "ASCII")
+           << " file" << endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  // A binary file without triangles.
+  FILE* file = fopen(fileName.c_str(), "wb");
+  char header[84] = { 0 };
+  fwrite(header, 1, 84, file);
+  fclose(file);
+  vtkSmartPointer<vtkPolyData> empty = Read(fileName, 1, false);
+  if (empty->GetNumberOfPoints() != 0 || empty->GetNumberOfPolys() != 0)
+    {
+    cerr << "Read " << empty->GetNumberOfPoints() << " points from a file "
+         << "without triangles" << endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -73,6 +73,7 @@
 #include "vtkInformationVector.h"
 #include "vtkIntArray.h"
 #include "vtkMultiBlockDataSet.h"
+#include "vtkMultiThreader.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
@@ -80,6 +81,7 @@
 #include "vtkPolygon.h"
 #include "vtkPyramid.h"
 #include "vtkQuad.h"
+#include "vtkSMPTools.h"
 #include "vtkSortDataArray.h"
 #include "vtkStdString.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
@@ -315,20 +317,27 @@ private:
 
   // read and create cell/point fields
   void ConstructDimensions(vtkStdString *, vtkFoamDict *);
+  bool ParseFieldFile(vtkFoamIOobject *, vtkFoamDict *, const vtkStdString &,
+      vtkDataArraySelection *, vtkStdString *) const;
   bool ReadFieldFile(vtkFoamIOobject *, vtkFoamDict *, const vtkStdString &,
       vtkDataArraySelection *);
   vtkFloatArray *FillField(vtkFoamEntry *, int, vtkFoamIOobject *,
       const vtkStdString &);
+  void GetFieldsAtTimeStep(vtkUnstructuredGrid *, vtkMultiBlockDataSet *,
+      vtkStringArray *, const bool, const double, const double);
   void GetVolFieldAtTimeStep(vtkUnstructuredGrid *, vtkMultiBlockDataSet *,
-      const vtkStdString &);
+      vtkFoamIOobject &, vtkFoamDict &, const vtkStdString &);
   void GetPointFieldAtTimeStep(vtkUnstructuredGrid *, vtkMultiBlockDataSet *,
-      const vtkStdString &);
+      vtkFoamIOobject &, vtkFoamDict &, const vtkStdString &);
   void AddArrayToFieldData(vtkDataSetAttributes *, vtkDataArray *,
       const vtkStdString &);
 
   // create lagrangian mesh/fields
   vtkMultiBlockDataSet *MakeLagrangianMesh();
 
+  // parses a batch of field files concurrently
+  struct vtkFoamFieldParser;
+
   // create point/face/cell zones
   vtkFoamDict *GatherBlocks(const char *, bool);
   bool GetPointZoneMesh(vtkMultiBlockDataSet *, vtkPoints *);
@@ -2006,6 +2015,28 @@ VTK_TEMPLATE_SPECIALIZE inline float vtkFoamReadValue<float>::ReadValue(vtkFoamI
   return io.ReadFloatValue();
 }
 
+//-----------------------------------------------------------------------------
+// reads a binary list of doubles into floats. the doubles are read and
+// converted in blocks rather than one at a time since binary fields are
+// the bulk of the data of large cases.
+static void vtkFoamReadBinaryDoubles(vtkFoamIOobject& io, float *ptr,
+    const vtkIdType size)
+{
+  const vtkIdType blockSize = VTK_FOAMFILE_OUTBUFSIZE / sizeof(double);
+  std::vector<double> buffer(static_cast<size_t>(
+      size < blockSize ? size : blockSize));
+  for (vtkIdType i = 0; i < size; i += blockSize)
+    {
+    const vtkIdType n = (size - i < blockSize ? size - i : blockSize);
+    io.Read(reinterpret_cast<unsigned char *>(&buffer[0]),
+        static_cast<int>(n * sizeof(double)));
+    for (vtkIdType j = 0; j < n; j++)
+      {
+      ptr[i + j] = static_cast<float>(buffer[j]);
+      }
+    }
+}
+
 //-----------------------------------------------------------------------------
 // class vtkFoamEntryValue
 // a class that represents a value of a dictionary entry that corresponds to
@@ -2153,13 +2184,8 @@ public:
         }
       else
         {
-        for (int i = 0; i < size; i++)
-          {
-          double buffer[nComponents];
-          io.Read(reinterpret_cast<unsigned char *>(buffer), sizeof(double)
-              * nComponents);
-          this->Ptr->SetTuple(i, buffer);
-          }
+        vtkFoamReadBinaryDoubles(io, this->Ptr->GetPointer(0),
+            static_cast<vtkIdType>(size) * nComponents);
         }
     }
     void ReadValue(vtkFoamIOobject& io, vtkFoamToken& currToken)
@@ -2500,12 +2526,7 @@ VTK_TEMPLATE_SPECIALIZE
 void vtkFoamEntryValue::listTraits<vtkFloatArray, float>::ReadBinaryList(
     vtkFoamIOobject& io, const int size)
 {
-  for (int i = 0; i < size; i++)
-    {
-    double buffer;
-    io.Read(reinterpret_cast<unsigned char *>(&buffer), sizeof(double));
-    this->Ptr->SetValue(i, static_cast<float>(buffer));
-    }
+  vtkFoamReadBinaryDoubles(io, this->Ptr->GetPointer(0), size);
 }
 
 // generic reader for nonuniform lists. requires size prefix of the
@@ -6438,18 +6459,23 @@ void vtkOpenFOAMReaderPrivate::InterpolateCellToPoint(vtkFloatArray *pData,
 }
 
 //-----------------------------------------------------------------------------
-bool vtkOpenFOAMReaderPrivate::ReadFieldFile(vtkFoamIOobject *ioPtr,
+// parses a field file without reporting errors so that it can be called
+// from several threads. returns the error message in errorMessage, which
+// is left empty if the variable is simply disabled.
+bool vtkOpenFOAMReaderPrivate::ParseFieldFile(vtkFoamIOobject *ioPtr,
     vtkFoamDict *dictPtr, const vtkStdString &varName,
-    vtkDataArraySelection *selection)
+    vtkDataArraySelection *selection, vtkStdString *errorMessage) const
 {
   const vtkStdString varPath(this->CurrentTimeRegionPath() + "/" + varName);
+  vtksys_ios::ostringstream error;
 
   // open the file
   vtkFoamIOobject &io = *ioPtr;
   if (!io.Open(varPath))
     {
-    vtkErrorMacro(<<"Error opening " << io.GetFileName().c_str() << ": "
-        << io.GetError().c_str());
+    error << "Error opening " << io.GetFileName().c_str() << ": "
+        << io.GetError().c_str();
+    *errorMessage = error.str();
     return false;
     }
 
@@ -6463,20 +6489,148 @@ bool vtkOpenFOAMReaderPrivate::ReadFieldFile(vtkFoamIOobject *ioPtr,
   vtkFoamDict &dict = *dictPtr;
   if (!dict.Read(io))
     {
-    vtkErrorMacro(<<"Error reading line " << io.GetLineNumber()
-        << " of " << io.GetFileName().c_str() << ": " << io.GetError().c_str());
+    error << "Error reading line " << io.GetLineNumber()
+        << " of " << io.GetFileName().c_str() << ": " << io.GetError().c_str();
+    *errorMessage = error.str();
     return false;
     }
 
   if (dict.GetType() != vtkFoamToken::DICTIONARY)
     {
-    vtkErrorMacro(<<"File " << io.GetFileName().c_str()
-        << "is not valid as a field file");
+    error << "File " << io.GetFileName().c_str()
+        << "is not valid as a field file";
+    *errorMessage = error.str();
+    return false;
+    }
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+bool vtkOpenFOAMReaderPrivate::ReadFieldFile(vtkFoamIOobject *ioPtr,
+    vtkFoamDict *dictPtr, const vtkStdString &varName,
+    vtkDataArraySelection *selection)
+{
+  vtkStdString errorMessage;
+  if (!this->ParseFieldFile(ioPtr, dictPtr, varName, selection,
+      &errorMessage))
+    {
+    if (!errorMessage.empty())
+      {
+      vtkErrorMacro(<< errorMessage.c_str());
+      }
     return false;
     }
   return true;
 }
 
+//-----------------------------------------------------------------------------
+// parses the field files of a batch, each into its own IOobject and
+// dictionary. vtkFoamIOobject and vtkFoamDict share no state between
+// instances, so the files are parsed concurrently.
+struct vtkOpenFOAMReaderPrivate::vtkFoamFieldParser
+{
+  const vtkOpenFOAMReaderPrivate *Reader;
+  vtkStringArray *FieldFiles;
+  vtkDataArraySelection *Selection;
+  vtkIdType FirstFile;
+  std::vector<vtkFoamIOobject *> *IOs;
+  std::vector<vtkFoamDict *> *Dicts;
+  std::vector<vtkStdString> *Errors;
+  std::vector<char> *Parsed;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    for (vtkIdType i = begin; i < end; i++)
+      {
+      (*this->Parsed)[i] = this->Reader->ParseFieldFile((*this->IOs)[i],
+          (*this->Dicts)[i], this->FieldFiles->GetValue(this->FirstFile + i),
+          this->Selection, &(*this->Errors)[i]);
+      }
+  }
+};
+
+//-----------------------------------------------------------------------------
+// reads the vol or point field files into the meshes. the files are parsed
+// in batches of NumberOfParsingThreads files at a time, concurrently, then
+// added to the meshes one after the other.
+void vtkOpenFOAMReaderPrivate::GetFieldsAtTimeStep(
+    vtkUnstructuredGrid *internalMesh, vtkMultiBlockDataSet *boundaryMesh,
+    vtkStringArray *fieldFiles, const bool volFields,
+    const double progressStart, const double progressRange)
+{
+  vtkDataArraySelection *selection = (volFields
+      ? this->Parent->CellDataArraySelection
+      : this->Parent->PointDataArraySelection);
+  const vtkIdType nFiles = fieldFiles->GetNumberOfValues();
+  vtkIdType batchSize = this->Parent->GetNumberOfParsingThreads();
+  if (batchSize == 0)
+    {
+    batchSize = vtkMultiThreader::GetGlobalDefaultNumberOfThreads();
+    }
+
+  std::vector<vtkFoamIOobject *> ios;
+  std::vector<vtkFoamDict *> dicts;
+  std::vector<vtkStdString> errors;
+  std::vector<char> parsed;
+  for (vtkIdType firstFile = 0; firstFile < nFiles; firstFile += batchSize)
+    {
+    const vtkIdType n = (nFiles - firstFile < batchSize
+        ? nFiles - firstFile : batchSize);
+    ios.resize(n);
+    dicts.resize(n);
+    errors.assign(n, vtkStdString());
+    parsed.assign(n, 0);
+    for (vtkIdType i = 0; i < n; i++)
+      {
+      ios[i] = new vtkFoamIOobject(this->CasePath);
+      dicts[i] = new vtkFoamDict;
+      }
+
+    vtkFoamFieldParser parser;
+    parser.Reader = this;
+    parser.FieldFiles = fieldFiles;
+    parser.Selection = selection;
+    parser.FirstFile = firstFile;
+    parser.IOs = &ios;
+    parser.Dicts = &dicts;
+    parser.Errors = &errors;
+    parser.Parsed = &parsed;
+    if (n == 1)
+      {
+      parser(0, 1);
+      }
+    else
+      {
+      vtkSMPTools::For(0, n, 1, parser);
+      }
+
+    for (vtkIdType i = 0; i < n; i++)
+      {
+      if (parsed[i])
+        {
+        if (volFields)
+          {
+          this->GetVolFieldAtTimeStep(internalMesh, boundaryMesh, *ios[i],
+              *dicts[i], fieldFiles->GetValue(firstFile + i));
+          }
+        else
+          {
+          this->GetPointFieldAtTimeStep(internalMesh, boundaryMesh, *ios[i],
+              *dicts[i], fieldFiles->GetValue(firstFile + i));
+          }
+        }
+      else if (!errors[i].empty())
+        {
+        vtkErrorMacro(<< errors[i].c_str());
+        }
+      delete dicts[i];
+      delete ios[i];
+      this->Parent->UpdateProgress(progressStart + progressRange
+          * ((float)(firstFile + i + 1) / ((float)nFiles + 0.0001)));
+      }
+    }
+}
+
 //-----------------------------------------------------------------------------
 vtkFloatArray *vtkOpenFOAMReaderPrivate::FillField(vtkFoamEntry *entryPtr,
     int nElements, vtkFoamIOobject *ioPtr, const vtkStdString &fieldType)
@@ -6711,16 +6865,8 @@ void vtkOpenFOAMReaderPrivate::ConstructDimensions(vtkStdString *dimString,
 //-----------------------------------------------------------------------------
 void vtkOpenFOAMReaderPrivate::GetVolFieldAtTimeStep(
     vtkUnstructuredGrid *internalMesh, vtkMultiBlockDataSet *boundaryMesh,
-    const vtkStdString &varName)
+    vtkFoamIOobject &io, vtkFoamDict &dict, const vtkStdString &varName)
 {
-  vtkFoamIOobject io(this->CasePath);
-  vtkFoamDict dict;
-  if (!this->ReadFieldFile(&io, &dict, varName,
-      this->Parent->CellDataArraySelection))
-    {
-    return;
-    }
-
   if (io.GetClassName().substr(0, 3) != "vol")
     {
     vtkErrorMacro(<< io.GetFileName().c_str() << " is not a volField");
@@ -7064,16 +7210,9 @@ void vtkOpenFOAMReaderPrivate::GetVolFieldAtTimeStep(
 // read point field at a timestep
 void vtkOpenFOAMReaderPrivate::GetPointFieldAtTimeStep(
     vtkUnstructuredGrid *internalMesh, vtkMultiBlockDataSet *boundaryMesh,
-    const vtkStdString &varName)
+    vtkFoamIOobject &io, vtkFoamDict &dict,
+    const vtkStdString &vtkNotUsed(varName))
 {
-  vtkFoamIOobject io(this->CasePath);
-  vtkFoamDict dict;
-  if (!this->ReadFieldFile(&io, &dict, varName,
-      this->Parent->PointDataArraySelection))
-    {
-    return;
-    }
-
   if (io.GetClassName().substr(0, 5) != "point")
     {
     vtkErrorMacro(<< io.GetFileName().c_str() << " is not a pointField");
@@ -7979,20 +8118,10 @@ int vtkOpenFOAMReaderPrivate::RequestData(vtkMultiBlockDataSet *output,
           }
         }
       // read field data variables into Internal/Boundary meshes
-      for (int i = 0; i < (int)this->VolFieldFiles->GetNumberOfValues(); i++)
-        {
-        this->GetVolFieldAtTimeStep(this->InternalMesh, this->BoundaryMesh,
-            this->VolFieldFiles->GetValue(i));
-        this->Parent->UpdateProgress(0.5 + 0.25 * ((float)(i + 1)
-            / ((float)this->VolFieldFiles->GetNumberOfValues() + 0.0001)));
-        }
-      for (int i = 0; i < (int)this->PointFieldFiles->GetNumberOfValues(); i++)
-        {
-        this->GetPointFieldAtTimeStep(this->InternalMesh, this->BoundaryMesh,
-            this->PointFieldFiles->GetValue(i));
-        this->Parent->UpdateProgress(0.75 + 0.125 * ((float)(i + 1)
-            / ((float)this->PointFieldFiles->GetNumberOfValues() + 0.0001)));
-        }
+      this->GetFieldsAtTimeStep(this->InternalMesh, this->BoundaryMesh,
+          this->VolFieldFiles, true, 0.5, 0.25);
+      this->GetFieldsAtTimeStep(this->InternalMesh, this->BoundaryMesh,
+          this->PointFieldFiles, false, 0.75, 0.125);
       }
     // read lagrangian mesh and fields
     lagrangianMesh = this->MakeLagrangianMesh();
@@ -8118,6 +8247,7 @@ vtkOpenFOAMReader::vtkOpenFOAMReader()
 
   // for caching mesh
   this->CacheMesh = 1;
+  this->NumberOfParsingThreads = 1;
 
   // for decomposing polyhedra
   this->DecomposePolyhedra = 0;
@@ -8181,6 +8311,8 @@ void vtkOpenFOAMReader::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Refresh: " << this->Refresh << endl;
   os << indent << "CreateCellToPoint: " << this->CreateCellToPoint << endl;
   os << indent << "CacheMesh: " << this->CacheMesh << endl;
+  os << indent << "NumberOfParsingThreads: " << this->NumberOfParsingThreads
+      << endl;
   os << indent << "DecomposePolyhedra: " << this->DecomposePolyhedra << endl;
   os << indent << "PositionsIsIn13Format: " << this->PositionsIsIn13Format
       << endl;
@@ -188,6 +188,16 @@ public:
   vtkGetMacro(CacheMesh, int);
   vtkBooleanMacro(CacheMesh, int);
 
+  // Description:
+  // Set/Get the number of field files of a time step that are parsed
+  // concurrently. The parsed files are added to the mesh one after the
+  // other, so that the output does not depend on this setting. 0 parses
+  // as many files at a time as vtkMultiThreader's default number of
+  // threads. The default is 1, which parses one file at a time and keeps
+  // a single parsed file in memory.
+  vtkSetClampMacro(NumberOfParsingThreads, int, 0, VTK_INT_MAX);
+  vtkGetMacro(NumberOfParsingThreads, int);
+
   // Description:
   // Set/Get whether polyhedra are to be decomposed.
   vtkSetMacro(DecomposePolyhedra, int);
@@ -241,6 +251,9 @@ protected:
   // for caching mesh
   int CacheMesh;
 
+  // number of field files parsed concurrently
+  int NumberOfParsingThreads;
+
   // for decomposing polyhedra on-the-fly
   int DecomposePolyhedra;
 
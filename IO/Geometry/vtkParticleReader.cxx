@@ -105,6 +105,169 @@ namespace {
 
   };
 
+ // The number of particles read from a binary file at a time.
+ vtkTypeUInt64 const ParticleChunkLength = 65536;
+ // The number of bytes between the particles kept with a stride above
+ // which the particles in between are seeked over rather than read.
+ std::streamoff const ParticleSeekSize = 4096;
+
+ // .NAME ParticleSampler - Select the particles to read from their index.
+ // .SECTION Description
+ // A particle is selected if its index in the file is a multiple of the
+ // stride and if its block is.  The particles are split in blocks of
+ // blockSize consecutive particles, and a block is selected if a hash of
+ // its index and of the seed, mapped to [0,1), lies in [low,high).  The
+ // hash spreads the selected blocks over the whole file and does not
+ // depend on the pieces read, so that nested intervals select nested sets
+ // of particles.
+ class ParticleSampler
+ {
+ public:
+   ParticleSampler(int stride, int blockSize, double low, double high,
+                   int seed) :
+     Stride(stride < 1 ? 1 : stride),
+     BlockSize(blockSize < 1 ? 1 : blockSize), Low(low), High(high),
+     Seed(Mix(static_cast<vtkTypeUInt32>(seed))),
+     All(low <= 0.0 && high >= 1.0) {}
+
+   bool operator () (vtkTypeUInt64 index) const
+   {
+     if ( this->Stride > 1 && index % this->Stride != 0 )
+       {
+       return false;
+       }
+     return this->KeepBlock(index / this->BlockSize);
+   }
+
+   bool KeepBlock(vtkTypeUInt64 block) const
+   {
+     if ( this->All )
+       {
+       return true;
+       }
+     vtkTypeUInt32 h = Mix(static_cast<vtkTypeUInt32>(block) ^ this->Seed);
+     h = Mix(h ^ static_cast<vtkTypeUInt32>(block >> 32));
+     double level = h / 4294967296.0;
+     return level >= this->Low && level < this->High;
+   }
+
+   vtkTypeUInt64 GetStride() const { return this->Stride; }
+   vtkTypeUInt64 GetBlockSize() const { return this->BlockSize; }
+
+ private:
+   // The finalization of MurmurHash3.
+   static vtkTypeUInt32 Mix(vtkTypeUInt32 h)
+   {
+     h ^= h >> 16;
+     h *= 0x85ebca6bU;
+     h ^= h >> 13;
+     h *= 0xc2b2ae35U;
+     h ^= h >> 16;
+     return h;
+   }
+
+   vtkTypeUInt64 Stride;
+   vtkTypeUInt64 BlockSize;
+   double Low;
+   double High;
+   vtkTypeUInt32 Seed;
+   bool All;
+ };
+
+ // Read the records of the particles in [start,next) of a binary file that
+ // the sampler selects, and append them to points and, if not NULL, to
+ // scalars.  The blocks that are not selected are never read, and the
+ // records that the stride skips are seeked over when they are far apart.
+ // Returns the index of the first particle that could not be read, or next.
+ template <class T, class TArray>
+ vtkTypeUInt64 ReadSampledRecords(ifstream *file, bool swapBytes,
+                                  int numComponents, vtkTypeUInt64 start,
+                                  vtkTypeUInt64 next,
+                                  const ParticleSampler &sampler,
+                                  vtkPoints *points, TArray *scalars,
+                                  vtkAlgorithm *self)
+ {
+   std::streamoff recordSize =
+     static_cast<std::streamoff>(numComponents * sizeof(T));
+   vtkTypeUInt64 stride = sampler.GetStride();
+   vtkTypeUInt64 blockSize = sampler.GetBlockSize();
+   bool seekRecords =
+     static_cast<std::streamoff>(stride) * recordSize > ParticleSeekSize;
+   std::vector<T> data(numComponents * (seekRecords ? 1 : ParticleChunkLength));
+   vtkTypeUInt64 position = next + 1;
+   vtkTypeUInt64 progress = start;
+   vtkTypeUInt64 first = start;
+   while (first < next)
+     {
+     // Skip the blocks that are not selected, then find the end of the run
+     // of selected blocks that follows.
+     vtkTypeUInt64 last = std::min(next, (first / blockSize + 1) * blockSize);
+     if (!sampler.KeepBlock(first / blockSize))
+       {
+       first = last;
+       continue;
+       }
+     while (last < next && sampler.KeepBlock(last / blockSize))
+       {
+       last = std::min(next, last + blockSize);
+       }
+
+     // Read the records of the run from the first one the stride keeps.
+     vtkTypeUInt64 kept = (first + stride - 1) / stride * stride;
+     while (kept < last)
+       {
+       vtkTypeUInt64 count =
+         seekRecords ? 1 : std::min(last - kept, ParticleChunkLength);
+       std::streamsize countSize =
+         static_cast<std::streamsize>(count) * recordSize;
+       if (position != kept)
+         {
+         file->seekg(static_cast<std::streamoff>(kept) * recordSize,
+                     ios::beg);
+         if (file->fail())
+           {
+           return kept;
+           }
+         }
+       file->read(reinterpret_cast<char *>(&data[0]), countSize);
+       if ( file->gcount() != countSize
+       // On apple read to eof returns fail
+#ifndef __APPLE_CC__
+            || file->fail()
+#endif // __APPLE_CC__
+          )
+         {
+         return kept;
+         }
+       position = kept + count;
+       if (swapBytes)
+         {
+         vtkByteSwap::SwapVoidRange(&data[0],
+                                    static_cast<int>(count) * numComponents,
+                                    sizeof(T));
+         }
+       for (vtkTypeUInt64 k = 0; k < count; k += stride)
+         {
+         const T *ptr = &data[k * numComponents];
+         points->InsertNextPoint(ptr);
+         if (scalars)
+           {
+           scalars->InsertNextValue(ptr[3]);
+           }
+         }
+       kept += (count + stride - 1) / stride * stride;
+       }
+     first = last;
+     if (first - progress >= ParticleChunkLength)
+       {
+       progress = first;
+       self->UpdateProgress(0.5 * static_cast<double>(first - start) /
+                            static_cast<double>(next - start));
+       }
+     }
+   return next;
+ }
+
  // The number of times we output a progress message.
  int const quantum = 20;
  // The ratio of high ASCII characters to low ASCII characeters.
@@ -122,6 +285,13 @@ vtkParticleReader::vtkParticleReader() :
   , Count(0)
   , SwapBytes(0)
   , NumberOfPoints(0)
+  , SampleStride(1)
+  , SampleRatio(1.0)
+  , SampleBlockSize(256)
+  , RandomSeed(0)
+  , ProgressiveSampling(0)
+  , SampleLow(0.0)
+  , SampleHigh(1.0)
 {
   this->SetNumberOfInputPorts(0);
 }
@@ -203,7 +373,7 @@ int vtkParticleReader::RequestInformation(
   this->File = NULL;
 
 
-  if (ft == FILE_TYPE_IS_BINARY)
+  if (ft == FILE_TYPE_IS_BINARY || this->ProgressiveSampling)
     {
     vtkInformation *outInfo = outputVector->GetInformationObject(0);
     outInfo->Set(CAN_HANDLE_PIECE_REQUEST(),
@@ -225,6 +395,24 @@ int vtkParticleReader::RequestData(
     return 0;
     }
 
+  // Select the particles of the requested piece: a range of the file for
+  // binary files, or a range of the sampling levels in progressive mode.
+  this->SampleLow = 0.0;
+  this->SampleHigh = this->SampleRatio;
+  if (this->ProgressiveSampling)
+    {
+    vtkInformation *outInfo = outputVector->GetInformationObject(0);
+    int piece =
+      outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER());
+    int numPieces =
+      outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES());
+    if (numPieces > 1 && piece >= 0 && piece < numPieces)
+      {
+      this->SampleLow = this->SampleRatio * piece / numPieces;
+      this->SampleHigh = this->SampleRatio * (piece + 1) / numPieces;
+      }
+    }
+
   this->OpenFile();
   int ft = this->FileType;
   if ( ft == FILE_TYPE_IS_UNKNOWN )
@@ -395,6 +583,10 @@ int vtkParticleReader::ProduceOutputFromTextFileDouble(vtkInformationVector *out
   this->Alliquot = fileLength / quantum;
   this->Count = 1;
   ParseLine<double> pl;
+  ParticleSampler sampler(this->SampleStride, this->SampleBlockSize,
+                          this->SampleLow, this->SampleHigh,
+                          this->RandomSeed);
+  vtkTypeUInt64 index = 0;
   char buffer[256];
   while ( this->File->getline(buffer,256,'\n') )
     {
@@ -405,7 +597,7 @@ int vtkParticleReader::ProduceOutputFromTextFileDouble(vtkInformationVector *out
       this->DoProgressUpdate( bytesRead, fileLength );
       double val[4];
       val[0]=val[1]=val[2]=val[3]=0;
-      if ( pl(s,val) )
+      if ( pl(s,val) && sampler(index++) )
         {
         points->InsertNextPoint(val[0], val[1], val[2]);
         if ( this->HasScalar)
@@ -472,6 +664,10 @@ int vtkParticleReader::ProduceOutputFromTextFileFloat(vtkInformationVector *outp
   this->Alliquot = fileLength / quantum;
   this->Count = 1;
   ParseLine<float> pl;
+  ParticleSampler sampler(this->SampleStride, this->SampleBlockSize,
+                          this->SampleLow, this->SampleHigh,
+                          this->RandomSeed);
+  vtkTypeUInt64 index = 0;
   char buffer[256];
   while ( this->File->getline(buffer,256,'\n') )
     {
@@ -483,7 +679,7 @@ int vtkParticleReader::ProduceOutputFromTextFileFloat(vtkInformationVector *outp
 
       float val[4];
       val[0]=val[1]=val[2]=val[3]=0;
-      if ( pl(s,val) )
+      if ( pl(s,val) && sampler(index++) )
         {
         points->InsertNextPoint(val[0], val[1], val[2]);
         if ( this->HasScalar)
@@ -529,10 +725,10 @@ int vtkParticleReader::ProduceOutputFromTextFileFloat(vtkInformationVector *outp
 int vtkParticleReader::ProduceOutputFromBinaryFileDouble(vtkInformationVector *outputVector)
 {
 
-  unsigned long fileLength, start, next, length, ptIdx, cellPtIdx;
-  unsigned long cellLength;
+  std::streamoff fileLength;
+  vtkTypeUInt64 start, next, length, cellLength;
+  vtkIdType ptIdx, cellPtIdx;
   int piece, numPieces;
-  double *data, *ptr;
 
   if (!this->FileName)
     {
@@ -550,15 +746,11 @@ int vtkParticleReader::ProduceOutputFromBinaryFileDouble(vtkInformationVector *o
     return 0;
     }
 
-  fileLength = (unsigned long)this->File->tellg();
-  if ( this->HasScalar )
-    {
-    this->NumberOfPoints = fileLength / (4 * sizeof(double));
-    }
-  else
-    {
-    this->NumberOfPoints = fileLength / (3 * sizeof(double));
-    }
+  fileLength = this->File->tellg();
+  int numComponents = this->HasScalar ? 4 : 3;
+  vtkTypeUInt64 numberOfPoints = static_cast<vtkTypeUInt64>(
+    fileLength / static_cast<std::streamoff>(numComponents * sizeof(double)));
+  this->NumberOfPoints = static_cast<size_t>(numberOfPoints);
 
   // get the info object
   vtkInformation *outInfo = outputVector->GetInformationObject(0);
@@ -568,113 +760,67 @@ int vtkParticleReader::ProduceOutputFromBinaryFileDouble(vtkInformationVector *o
   numPieces =
     outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES());
 
-  if ((unsigned long)numPieces > this->NumberOfPoints)
+  if (static_cast<vtkTypeUInt64>(numPieces) > numberOfPoints)
     {
-    numPieces = (int)(this->NumberOfPoints);
+    numPieces = static_cast<int>(numberOfPoints);
     }
   if (numPieces <= 0 || piece < 0 || piece >= numPieces)
     {
     return 0;
     }
 
-  start = static_cast<unsigned long>(piece * this->NumberOfPoints / numPieces);
-  next = static_cast<unsigned long>((piece+1) * this->NumberOfPoints / numPieces);
-
-  length = next - start;
-
-  if ( this->HasScalar )
+  if (this->ProgressiveSampling)
     {
-    data = new double[length * 4];
+    // The pieces are selected by the sampling, from the whole file.
+    start = 0;
+    next = numberOfPoints;
     }
   else
     {
-    data = new double[length * 3];
+    start = piece * numberOfPoints / numPieces;
+    next = (piece+1) * numberOfPoints / numPieces;
     }
 
-  // Seek to the first point in the file.
-  if ( this->HasScalar )
-    {
-    this->File->seekg(start*4*sizeof(double), ios::beg);
-    }
-  else
-    {
-    this->File->seekg(start*3*sizeof(double), ios::beg);
-    }
-  if (this->File->fail())
-    {
-    vtkErrorMacro(<< "File operation failed: Seeking to " << start*4);
-    delete [] data;
-    return 0;
-    }
+  length = next - start;
 
-  // Read the data.
+  vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
+  points->SetDataTypeToDouble();
+  vtkSmartPointer<vtkDoubleArray> array = vtkSmartPointer<vtkDoubleArray>::New();
+  array->SetName("Scalar");
+  ParticleSampler sampler(this->SampleStride, this->SampleBlockSize,
+                          this->SampleLow, this->SampleHigh,
+                          this->RandomSeed);
+  vtkIdType expected = static_cast<vtkIdType>(
+    (this->SampleHigh - this->SampleLow) * static_cast<double>(length) /
+    this->SampleStride) + 1;
+  points->Allocate(expected);
   if ( this->HasScalar )
     {
-    this->File->read((char *)data, length*4*sizeof(double));
-    if ( static_cast<unsigned long>(this->File->gcount()) !=
-         static_cast<unsigned long>(length*4*sizeof(double))
-       // On apple read to eof returns fail
-#ifndef __APPLE_CC__
-       || this->File->fail()
-#endif // __APPLE_CC__
-       )
-      {
-      vtkErrorMacro("Could not read points: " << start
-             << " to " << next-1);
-      delete [] data;
-      return 0;
-      }
-    }
-  else
-    {
-    this->File->read((char *)data, length*3*sizeof(double));
-    if ( static_cast<unsigned long>(this->File->gcount()) !=
-         static_cast<unsigned long>(length*3*sizeof(double))
-       // On apple read to eof returns fail
-#ifndef __APPLE_CC__
-       || this->File->fail()
-#endif // __APPLE_CC__
-       )
-      {
-      vtkErrorMacro("Could not read points: " << start
-             << " to " << next-1);
-      delete [] data;
-      return 0;
-      }
+    array->Allocate(expected);
     }
 
-  // Swap bytes if necessary.
-  if (this->GetSwapBytes())
+  // Read only the records of the sampled particles, so that only the
+  // points kept are held in memory.
+  vtkTypeUInt64 failed = ReadSampledRecords<double>(
+    this->File, this->GetSwapBytes() != 0, numComponents, start, next,
+    sampler, points, this->HasScalar ? array.GetPointer() : NULL, this);
+  if (failed < next)
     {
-    if ( this->HasScalar )
-      {
-      vtkByteSwap::SwapVoidRange(data, length*4, sizeof(double));
-      }
-    else
-      {
-      vtkByteSwap::SwapVoidRange(data, length*3, sizeof(double));
-      }
+    vtkErrorMacro("Could not read point " << failed);
+    return 0;
     }
 
-  this->UpdateProgress(0.5);
-
-  ptr = data;
-
-  vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
-  points->SetDataTypeToDouble();
-  points->SetNumberOfPoints(length);
-  vtkSmartPointer<vtkDoubleArray> array = vtkSmartPointer<vtkDoubleArray>::New();
-  array->SetName("Scalar");
   vtkSmartPointer<vtkCellArray> verts = vtkSmartPointer<vtkCellArray>::New();
 
   // Each cell will have 1000 points.  Leave a little extra space just in case.
   // We break up the cell this way so that the render will check for aborts
   // at a reasonable rate.
+  length = static_cast<vtkTypeUInt64>(points->GetNumberOfPoints());
   verts->Allocate((int)((double)length * 1.002));
   // Keep adding cells until we run out of points.
   ptIdx = 0;
   int cnt = 1;
-  double len = length;
+  double len = static_cast<double>(length);
   while (length > 0)
     {
     if ( cnt % 10 == 0 )
@@ -691,21 +837,10 @@ int vtkParticleReader::ProduceOutputFromBinaryFileDouble(vtkInformationVector *o
     verts->InsertNextCell((int)cellLength);
     for (cellPtIdx = 0; cellPtIdx < cellLength; ++cellPtIdx)
       {
-      points->SetPoint(ptIdx, ptr[0], ptr[1], ptr[2]);
-      if ( this->HasScalar )
-        {
-        array->InsertNextValue(ptr[3]);
-        ptr += 4;
-        }
-      else
-        {
-        ptr += 3;
-        }
       verts->InsertCellPoint(ptIdx);
       ++ptIdx;
       }
     }
-  delete [] data;
 
   // get the ouptut
   vtkPolyData *output = vtkPolyData::SafeDownCast(
@@ -725,10 +860,10 @@ int vtkParticleReader::ProduceOutputFromBinaryFileDouble(vtkInformationVector *o
 int vtkParticleReader::ProduceOutputFromBinaryFileFloat(vtkInformationVector *outputVector)
 {
 
-  unsigned long fileLength, start, next, length, ptIdx, cellPtIdx;
-  unsigned long cellLength;
+  std::streamoff fileLength;
+  vtkTypeUInt64 start, next, length, cellLength;
+  vtkIdType ptIdx, cellPtIdx;
   int piece, numPieces;
-  float *data, *ptr;
 
   if (!this->FileName)
     {
@@ -746,16 +881,11 @@ int vtkParticleReader::ProduceOutputFromBinaryFileFloat(vtkInformationVector *ou
     return 0;
     }
 
-  fileLength = (unsigned long)this->File->tellg();
-  if ( this->HasScalar )
-    {
-    this->NumberOfPoints = fileLength / (4 * sizeof(float));
-    }
-  else
-    {
-    this->NumberOfPoints = fileLength / (3 * sizeof(float));
-    }
-
+  fileLength = this->File->tellg();
+  int numComponents = this->HasScalar ? 4 : 3;
+  vtkTypeUInt64 numberOfPoints = static_cast<vtkTypeUInt64>(
+    fileLength / static_cast<std::streamoff>(numComponents * sizeof(float)));
+  this->NumberOfPoints = static_cast<size_t>(numberOfPoints);
 
   // get the info object
   vtkInformation *outInfo = outputVector->GetInformationObject(0);
@@ -765,113 +895,66 @@ int vtkParticleReader::ProduceOutputFromBinaryFileFloat(vtkInformationVector *ou
   numPieces =
     outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES());
 
-  if ((unsigned long)numPieces > this->NumberOfPoints)
+  if (static_cast<vtkTypeUInt64>(numPieces) > numberOfPoints)
     {
-    numPieces = (int)(this->NumberOfPoints);
+    numPieces = static_cast<int>(numberOfPoints);
     }
   if (numPieces <= 0 || piece < 0 || piece >= numPieces)
     {
     return 0;
     }
 
-  start = static_cast<unsigned long>(piece * this->NumberOfPoints / numPieces);
-  next = static_cast<unsigned long>((piece+1) * this->NumberOfPoints / numPieces);
-
-  length = next - start;
-
-  if ( this->HasScalar )
+  if (this->ProgressiveSampling)
     {
-    data = new float[length * 4];
+    // The pieces are selected by the sampling, from the whole file.
+    start = 0;
+    next = numberOfPoints;
     }
   else
     {
-    data = new float[length * 3];
+    start = piece * numberOfPoints / numPieces;
+    next = (piece+1) * numberOfPoints / numPieces;
     }
 
+  length = next - start;
 
-  // Seek to the first point in the file.
+  vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
+  vtkSmartPointer<vtkFloatArray> array = vtkSmartPointer<vtkFloatArray>::New();
+  array->SetName("Scalar");
+  ParticleSampler sampler(this->SampleStride, this->SampleBlockSize,
+                          this->SampleLow, this->SampleHigh,
+                          this->RandomSeed);
+  vtkIdType expected = static_cast<vtkIdType>(
+    (this->SampleHigh - this->SampleLow) * static_cast<double>(length) /
+    this->SampleStride) + 1;
+  points->Allocate(expected);
   if ( this->HasScalar )
     {
-    this->File->seekg(start*4*sizeof(float), ios::beg);
-    }
-  else
-    {
-    this->File->seekg(start*3*sizeof(float), ios::beg);
-    }
-  if (this->File->fail())
-    {
-    vtkErrorMacro(<< "File operation failed: Seeking to " << start*4);
-    delete [] data;
-    return 0;
+    array->Allocate(expected);
     }
 
-  // Read the data.
-  if ( this->HasScalar )
+  // Read only the records of the sampled particles, so that only the
+  // points kept are held in memory.
+  vtkTypeUInt64 failed = ReadSampledRecords<float>(
+    this->File, this->GetSwapBytes() != 0, numComponents, start, next,
+    sampler, points, this->HasScalar ? array.GetPointer() : NULL, this);
+  if (failed < next)
     {
-    this->File->read((char *)data, length*4*sizeof(float));
-    if ( static_cast<unsigned long>(this->File->gcount()) !=
-         static_cast<unsigned long>(length*4*sizeof(float))
-       // On apple read to eof returns fail
-#ifndef __APPLE_CC__
-       || this->File->fail()
-#endif // __APPLE_CC__
-       )
-      {
-      vtkErrorMacro("Could not read points: " << start
-             << " to " << next-1);
-      delete [] data;
-      return 0;
-      }
-    }
-  else
-    {
-    this->File->read((char *)data, length*3*sizeof(float));
-    if ( static_cast<unsigned long>(this->File->gcount()) !=
-         static_cast<unsigned long>(length*3*sizeof(float))
-       // On apple read to eof returns fail
-#ifndef __APPLE_CC__
-       || this->File->fail()
-#endif // __APPLE_CC__
-       )
-      {
-      vtkErrorMacro("Could not read points: " << start
-             << " to " << next-1);
-      delete [] data;
-      return 0;
-      }
-    }
-
-  // Swap bytes if necessary.
-  if (this->GetSwapBytes())
-    {
-    if ( this->HasScalar )
-      {
-      vtkByteSwap::SwapVoidRange(data, length*4, sizeof(float));
-      }
-    else
-      {
-      vtkByteSwap::SwapVoidRange(data, length*3, sizeof(float));
-      }
+    vtkErrorMacro("Could not read point " << failed);
+    return 0;
     }
 
-  this->UpdateProgress(0.5);
-
-  ptr = data;
-
-  vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
-  points->SetNumberOfPoints(length);
-  vtkSmartPointer<vtkFloatArray> array = vtkSmartPointer<vtkFloatArray>::New();
-  array->SetName("Scalar");
   vtkSmartPointer<vtkCellArray> verts = vtkSmartPointer<vtkCellArray>::New();
 
   // Each cell will have 1000 points.  Leave a little extra space just in case.
   // We break up the cell this way so that the render will check for aborts
   // at a reasonable rate.
-  verts->Allocate((int)((float)length * 1.002));
+  length = static_cast<vtkTypeUInt64>(points->GetNumberOfPoints());
+  verts->Allocate((int)((double)length * 1.002));
   // Keep adding cells until we run out of points.
   ptIdx = 0;
   int cnt = 1;
-  double len = length;
+  double len = static_cast<double>(length);
   while (length > 0)
     {
     if ( cnt % 10 == 0 )
@@ -888,21 +971,10 @@ int vtkParticleReader::ProduceOutputFromBinaryFileFloat(vtkInformationVector *ou
     verts->InsertNextCell((int)cellLength);
     for (cellPtIdx = 0; cellPtIdx < cellLength; ++cellPtIdx)
       {
-      points->SetPoint(ptIdx, ptr[0], ptr[1], ptr[2]);
-      if ( this->HasScalar )
-        {
-        array->InsertNextValue(ptr[3]);
-        ptr += 4;
-        }
-      else
-        {
-        ptr += 3;
-        }
       verts->InsertCellPoint(ptIdx);
       ++ptIdx;
       }
     }
-  delete [] data;
 
   // get the ouptut
   vtkPolyData *output = vtkPolyData::SafeDownCast(
@@ -1046,6 +1118,12 @@ void vtkParticleReader::PrintSelf(ostream& os, vtkIndent indent)
     os << indent << "Data type should never have this value: " << this->DataType << "\n";
     break;
   }
+  os << indent << "SampleStride: " << this->SampleStride << "\n";
+  os << indent << "SampleRatio: " << this->SampleRatio << "\n";
+  os << indent << "SampleBlockSize: " << this->SampleBlockSize << "\n";
+  os << indent << "RandomSeed: " << this->RandomSeed << "\n";
+  os << indent << "ProgressiveSampling: "
+     << (this->ProgressiveSampling ? "On\n" : "Off\n");
   os << indent << "NumberOfPoints: " << this->NumberOfPoints << "\n";
   os << indent << "Alliquot: " << (unsigned int)this->Alliquot << "\n";
   os << indent << "Count: " << (unsigned int)this->Count << "\n";
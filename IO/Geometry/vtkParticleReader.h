@@ -26,6 +26,10 @@
 //  Progress updates are provided.
 //  With respect to binary files, random access into the file to read
 //  pieces is supported.
+//  A subset of the particles can be read, selected by a stride and by a
+//  deterministic random sampling, to preview large files.  In progressive
+//  mode, the pieces are increasing levels of detail of the sampled
+//  particles instead of ranges of the file.
 //
 
 #ifndef __vtkParticleReader_h
@@ -105,6 +109,53 @@ public:
   void SetDataTypeToFloat() {this->SetDataType(VTK_FLOAT);}
   void SetDataTypeToDouble() {this->SetDataType(VTK_DOUBLE);}
 
+  // Description:
+  // Get/Set the stride between the particles read: only the particles
+  // whose index in the file is a multiple of SampleStride are kept.  The
+  // records of binary files in between are seeked over when they are far
+  // apart.  The default is 1, which keeps every particle.
+  vtkSetClampMacro(SampleStride, int, 1, VTK_INT_MAX);
+  vtkGetMacro(SampleStride, int);
+
+  // Description:
+  // Get/Set the fraction of the particles read, between 0 and 1.  The
+  // particles are split in blocks of SampleBlockSize consecutive
+  // particles, and each block is kept or not depending on a hash of its
+  // index and of RandomSeed, so the same particles are read every time
+  // whatever the pieces requested, and the particles read with a ratio
+  // are also read with any larger ratio.  The blocks of binary files that
+  // are not kept are never read.  It applies on top of SampleStride.  The
+  // default is 1, which keeps every particle.
+  vtkSetClampMacro(SampleRatio, double, 0.0, 1.0);
+  vtkGetMacro(SampleRatio, double);
+
+  // Description:
+  // Get/Set the number of consecutive particles that SampleRatio and
+  // ProgressiveSampling keep or drop together.  Larger blocks make fewer,
+  // larger reads of binary files, smaller ones spread the sample more
+  // evenly.  The default is 256; 1 samples each particle on its own.
+  vtkSetClampMacro(SampleBlockSize, int, 1, VTK_INT_MAX);
+  vtkGetMacro(SampleBlockSize, int);
+
+  // Description:
+  // Get/Set the seed of the hash used by SampleRatio and
+  // ProgressiveSampling.  The default is 0.
+  vtkSetMacro(RandomSeed, int);
+  vtkGetMacro(RandomSeed, int);
+
+  // Description:
+  // Get/Set whether the pieces requested are levels of detail rather than
+  // ranges of the file.  When on, piece p of n holds the sampled blocks
+  // whose hash lies in the p-th of n equal parts of [0,SampleRatio), so
+  // that each piece is spread over the whole data set and pieces 0 to p
+  // together hold a fraction (p+1)/n of the sampled particles.  Streaming
+  // the pieces in order thus refines a preview.  Each piece only reads its
+  // own blocks of binary files, and text files can also be read in
+  // pieces.  The default is off.
+  vtkSetMacro(ProgressiveSampling, int);
+  vtkGetMacro(ProgressiveSampling, int);
+  vtkBooleanMacro(ProgressiveSampling, int);
+
 
 protected:
   vtkParticleReader();
@@ -181,6 +232,17 @@ protected:
   int SwapBytes;
   size_t NumberOfPoints;
 
+  int SampleStride;
+  double SampleRatio;
+  int SampleBlockSize;
+  int RandomSeed;
+  int ProgressiveSampling;
+
+  // Description:
+  // The range of sampling levels selected for the current request.
+  double SampleLow;
+  double SampleHigh;
+
 private:
   vtkParticleReader(const vtkParticleReader&);  // Not implemented.
   void operator=(const vtkParticleReader&);  // Not implemented.
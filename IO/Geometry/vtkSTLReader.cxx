@@ -19,16 +19,21 @@
 #include "vtkCellData.h"
 #include "vtkErrorCode.h"
 #include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
 #include "vtkIncrementalPointLocator.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMergePoints.h"
 #include "vtkObjectFactory.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <algorithm>
 #include <ctype.h>
+#include <string.h>
+#include <vector>
 #include <vtksys/SystemTools.hxx>
 
 vtkStandardNewMacro(vtkSTLReader);
@@ -38,6 +43,211 @@ vtkStandardNewMacro(vtkSTLReader);
 
 vtkCxxSetObjectMacro(vtkSTLReader,Locator,vtkIncrementalPointLocator);
 
+namespace
+{
+// Number of facets of binary files read and decoded at once.
+const vtkIdType STLFacetBlockSize = 1 << 20;
+
+// Decode a block of 50 byte binary facets into the points and the
+// connectivity of their triangles.
+class STLFacetDecoder
+{
+public:
+  STLFacetDecoder(const unsigned char* facets, float* points,
+                  vtkIdType* cells, vtkIdType first)
+    : Facets(facets), Points(points), Cells(cells), First(first) {}
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      vtkIdType facet = this->First + i;
+      float* x = this->Points + 9 * facet;
+      // Skip the normal, read the 3 vertices.
+      memcpy(x, this->Facets + 50 * i + 12, 9 * sizeof(float));
+      vtkByteSwap::Swap4LERange(x, 9);
+      vtkIdType* cell = this->Cells + 4 * facet;
+      cell[0] = 3;
+      cell[1] = 3 * facet;
+      cell[2] = 3 * facet + 1;
+      cell[3] = 3 * facet + 2;
+      }
+  }
+
+private:
+  const unsigned char* Facets;
+  float* Points;
+  vtkIdType* Cells;
+  vtkIdType First;
+};
+
+// Hash the coordinates of points into buckets. Both zeros hash alike as
+// they are merged, points with NaN coordinates go to no bucket as they are
+// never merged.
+class STLHashPoints
+{
+public:
+  STLHashPoints(const float* points, vtkIdType* buckets,
+                vtkIdType numBuckets)
+    : Points(points), Buckets(buckets), NumberOfBuckets(numBuckets) {}
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      const float* x = this->Points + 3 * i;
+      if (x[0] != x[0] || x[1] != x[1] || x[2] != x[2])
+        {
+        this->Buckets[i] = this->NumberOfBuckets;
+        continue;
+        }
+      vtkTypeUInt32 hash = 0;
+      for (int c = 0; c < 3; ++c)
+        {
+        vtkTypeUInt32 bits = 0;
+        if (x[c] != 0.0f)
+          {
+          memcpy(&bits, x + c, sizeof(bits));
+          }
+        hash = (hash ^ bits) * 0x9E3779B1u;
+        hash ^= hash >> 15;
+        }
+      this->Buckets[i] = static_cast<vtkIdType>(hash % this->NumberOfBuckets);
+      }
+  }
+
+private:
+  const float* Points;
+  vtkIdType* Buckets;
+  vtkIdType NumberOfBuckets;
+};
+
+// Map every point of the buckets to the first of its coincident points,
+// the ids of a bucket being sorted.
+class STLMergeBuckets
+{
+public:
+  STLMergeBuckets(const float* points, const vtkIdType* offsets,
+                  const vtkIdType* ids, vtkIdType* first)
+    : Points(points), Offsets(offsets), Ids(ids), First(first) {}
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    for (vtkIdType b = begin; b < end; ++b)
+      {
+      for (vtkIdType j = this->Offsets[b]; j < this->Offsets[b + 1]; ++j)
+        {
+        const float* y = this->Points + 3 * this->Ids[j];
+        for (vtkIdType i = this->Offsets[b]; i < j; ++i)
+          {
+          vtkIdType id = this->Ids[i];
+          const float* x = this->Points + 3 * id;
+          if (this->First[id] == id &&
+              x[0] == y[0] && x[1] == y[1] && x[2] == y[2])
+            {
+            this->First[this->Ids[j]] = id;
+            break;
+            }
+          }
+        }
+      }
+  }
+
+private:
+  const float* Points;
+  const vtkIdType* Offsets;
+  const vtkIdType* Ids;
+  vtkIdType* First;
+};
+
+// Merge the coincident points of the triangles by sorting the points into
+// hash buckets and comparing the points of each bucket in parallel. The
+// points are numbered in the order of their first use, as vtkMergePoints
+// does when they are inserted triangle after triangle, and the triangles
+// that become degenerate are removed.
+void STLMergeSortedPoints(vtkPoints* newPts, vtkCellArray* newPolys,
+                          vtkFloatArray* newScalars, vtkPoints* mergedPts,
+                          vtkCellArray* mergedPolys,
+                          vtkFloatArray* mergedScalars)
+{
+  vtkFloatArray* coordinates = vtkFloatArray::SafeDownCast(newPts->GetData());
+  const float* points = coordinates->GetPointer(0);
+  vtkIdType numPts = newPts->GetNumberOfPoints();
+  if (numPts == 0)
+    {
+    return;
+    }
+
+  // Counting sort of the point ids by bucket keeps the ids of each bucket
+  // sorted, so that the first of coincident points has the smallest id.
+  vtkIdType numBuckets = numPts / 2 + 1;
+  std::vector<vtkIdType> buckets(numPts);
+  vtkSMPTools::For(0, numPts,
+                   STLHashPoints(points, &buckets[0], numBuckets));
+  std::vector<vtkIdType> offsets(numBuckets + 3, 0);
+  for (vtkIdType i = 0; i < numPts; ++i)
+    {
+    ++offsets[buckets[i] + 2];
+    }
+  for (vtkIdType b = 2; b < numBuckets + 3; ++b)
+    {
+    offsets[b] += offsets[b - 1];
+    }
+  std::vector<vtkIdType> ids(numPts);
+  for (vtkIdType i = 0; i < numPts; ++i)
+    {
+    ids[offsets[buckets[i] + 1]++] = i;
+    }
+
+  std::vector<vtkIdType> first(numPts);
+  for (vtkIdType i = 0; i < numPts; ++i)
+    {
+    first[i] = i;
+    }
+  vtkSMPTools::For(0, numBuckets,
+    STLMergeBuckets(points, &offsets[0], &ids[0], &first[0]));
+
+  // Number the first points in order and copy them.
+  std::vector<vtkIdType> pointMap(numPts);
+  vtkIdType numMerged = 0;
+  for (vtkIdType i = 0; i < numPts; ++i)
+    {
+    pointMap[i] = first[i] == i ? numMerged++ : pointMap[first[i]];
+    }
+  mergedPts->SetNumberOfPoints(numMerged);
+  float* mergedPoints = vtkFloatArray::SafeDownCast(
+    mergedPts->GetData())->GetPointer(0);
+  for (vtkIdType i = 0; i < numPts; ++i)
+    {
+    if (first[i] == i)
+      {
+      memcpy(mergedPoints + 3 * pointMap[i], points + 3 * i,
+             3 * sizeof(float));
+      }
+    }
+
+  vtkIdType npts;
+  vtkIdType* pts = 0;
+  vtkIdType nodes[3];
+  vtkIdType nextCell = 0;
+  for (newPolys->InitTraversal(); newPolys->GetNextCell(npts,pts);
+       ++nextCell)
+    {
+    nodes[0] = pointMap[pts[0]];
+    nodes[1] = pointMap[pts[1]];
+    nodes[2] = pointMap[pts[2]];
+    if (nodes[0] != nodes[1] && nodes[0] != nodes[2] && nodes[1] != nodes[2])
+      {
+      mergedPolys->InsertNextCell(3,nodes);
+      if (newScalars)
+        {
+        mergedScalars->InsertNextValue(newScalars->GetValue(nextCell));
+        }
+      }
+    }
+}
+}
+
 // Construct object with merging set to true.
 vtkSTLReader::vtkSTLReader()
 {
@@ -145,19 +355,11 @@ int vtkSTLReader::RequestData(
 
   fclose(fp);
   //
-  // If merging is on, create hash table and merge points/triangles.
+  // If merging is on, merge points/triangles.
   //
   if ( this->Merging )
     {
-    int i;
-    vtkIdType *pts = 0;
-    vtkIdType nodes[3];
-    vtkIdType npts;
-    double x[3];
-    int nextCell=0;
-
     mergedPts = vtkPoints::New();
-    mergedPts->Allocate(newPts->GetNumberOfPoints()/2);
     mergedPolys = vtkCellArray::New();
     mergedPolys->Allocate(newPolys->GetSize());
     if (newScalars)
@@ -166,32 +368,44 @@ int vtkSTLReader::RequestData(
       mergedScalars->Allocate(newPolys->GetSize());
       }
 
-    vtkSmartPointer<vtkIncrementalPointLocator> locator = this->Locator;
+    // Without a locator, sort the points into buckets in parallel.
     if (this->Locator == NULL)
       {
-      locator.TakeReference(this->NewDefaultLocator());
+      STLMergeSortedPoints(newPts, newPolys, newScalars, mergedPts,
+                           mergedPolys, mergedScalars);
       }
-    locator->InitPointInsertion (mergedPts, newPts->GetBounds());
-
-    for (newPolys->InitTraversal(); newPolys->GetNextCell(npts,pts); )
+    else
       {
-      for (i=0; i < 3; i++)
-        {
-        newPts->GetPoint(pts[i],x);
-        locator->InsertUniquePoint(x, nodes[i]);
-        }
+      int i;
+      vtkIdType *pts = 0;
+      vtkIdType nodes[3];
+      vtkIdType npts;
+      double x[3];
+      int nextCell=0;
 
-      if ( nodes[0] != nodes[1] &&
-           nodes[0] != nodes[2] &&
-           nodes[1] != nodes[2] )
+      mergedPts->Allocate(newPts->GetNumberOfPoints()/2);
+      this->Locator->InitPointInsertion (mergedPts, newPts->GetBounds());
+
+      for (newPolys->InitTraversal(); newPolys->GetNextCell(npts,pts); )
         {
-        mergedPolys->InsertNextCell(3,nodes);
-        if (newScalars)
+        for (i=0; i < 3; i++)
           {
-          mergedScalars->InsertNextValue(newScalars->GetValue(nextCell));
+          newPts->GetPoint(pts[i],x);
+          this->Locator->InsertUniquePoint(x, nodes[i]);
+          }
+
+        if ( nodes[0] != nodes[1] &&
+             nodes[0] != nodes[2] &&
+             nodes[1] != nodes[2] )
+          {
+          mergedPolys->InsertNextCell(3,nodes);
+          if (newScalars)
+            {
+            mergedScalars->InsertNextValue(newScalars->GetValue(nextCell));
+            }
           }
+        nextCell++;
         }
-      nextCell++;
       }
 
     newPts->Delete();
@@ -240,13 +454,9 @@ int vtkSTLReader::RequestData(
 bool vtkSTLReader::ReadBinarySTL(FILE *fp, vtkPoints *newPts,
                                  vtkCellArray *newPolys)
 {
-  int i, numTris;
-  vtkIdType pts[3];
+  int numTris;
   unsigned long   ulint;
-  unsigned short  ibuff2;
   char    header[81];
-  typedef struct  {float  n[3], v1[3], v2[3], v3[3];} facet_t;
-  facet_t facet;
 
   vtkDebugMacro(<< " Reading BINARY STL file");
 
@@ -277,56 +487,45 @@ bool vtkSTLReader::ReadBinarySTL(FILE *fp, vtkPoints *newPts,
     << numTris << ")");
     }
 
-  // Verify the numTris with the length of the file
+  // The facets that the file holds, whatever the count says.
   unsigned long ulFileLength = vtksys::SystemTools::FileLength(this->FileName);
   ulFileLength -= (80 + 4); // 80 byte - header, 4 byte - tringle count
   ulFileLength /= 50;       // 50 byte - twelve 32-bit-floating point numbers + 2 byte for attribute byte count
-
-  if (numTris < static_cast<int>(ulFileLength))
-    numTris = static_cast<int>(ulFileLength);
-
-  // now we can allocate the memory we need for this STL file
-  newPts->Allocate(numTris*3,10000);
-  newPolys->Allocate(numTris,20000);
-
-  for ( i=0; fread(&facet,48,1,fp) > 0; i++ )
+  vtkIdType numFacets = static_cast<vtkIdType>(ulFileLength);
+
+  // Read the facets by blocks straight into the points and the cells,
+  // decoding each block in parallel.
+  vtkFloatArray *points = vtkFloatArray::SafeDownCast(newPts->GetData());
+  points->SetNumberOfComponents(3);
+  points->SetNumberOfTuples(3 * numFacets);
+  vtkIdTypeArray *cells = vtkIdTypeArray::New();
+  cells->SetNumberOfValues(4 * numFacets);
+  std::vector<unsigned char> facets(
+    50 * static_cast<size_t>(std::min(numFacets, STLFacetBlockSize)));
+
+  for (vtkIdType first = 0; first < numFacets; first += STLFacetBlockSize)
     {
-    if (fread(&ibuff2,2,1,fp) != 1) //read extra junk
+    vtkIdType count = std::min(STLFacetBlockSize, numFacets - first);
+    if (fread(&facets[0], 50, count, fp) != static_cast<size_t>(count))
       {
       vtkErrorMacro ("STLReader error reading file: " << this->FileName
-                     << " Premature EOF while reading extra junk.");
+                     << " Premature EOF while reading facets.");
+      cells->Delete();
       fclose(fp);
       return false;
       }
+    vtkSMPTools::For(0, count,
+      STLFacetDecoder(&facets[0], points->GetPointer(0),
+                      cells->GetPointer(0), first));
 
-    vtkByteSwap::Swap4LE (facet.n);
-    vtkByteSwap::Swap4LE (facet.n+1);
-    vtkByteSwap::Swap4LE (facet.n+2);
-
-    vtkByteSwap::Swap4LE (facet.v1);
-    vtkByteSwap::Swap4LE (facet.v1+1);
-    vtkByteSwap::Swap4LE (facet.v1+2);
-    pts[0] = newPts->InsertNextPoint(facet.v1);
-
-    vtkByteSwap::Swap4LE (facet.v2);
-    vtkByteSwap::Swap4LE (facet.v2+1);
-    vtkByteSwap::Swap4LE (facet.v2+2);
-    pts[1] = newPts->InsertNextPoint(facet.v2);
-
-    vtkByteSwap::Swap4LE (facet.v3);
-    vtkByteSwap::Swap4LE (facet.v3+1);
-    vtkByteSwap::Swap4LE (facet.v3+2);
-    pts[2] = newPts->InsertNextPoint(facet.v3);
-
-    newPolys->InsertNextCell(3,pts);
-
-    if ( (i % 5000) == 0 && i != 0 )
-      {
-      vtkDebugMacro(<< "triangle# " << i);
-      this->UpdateProgress(static_cast<double>(i)/numTris);
-      }
+    vtkDebugMacro(<< "triangle# " << first + count);
+    this->UpdateProgress(static_cast<double>(first + count)/numFacets);
     }
 
+  newPts->Modified();
+  newPolys->SetCells(numFacets, cells);
+  cells->Delete();
+
   return true;
 }
 
@@ -497,8 +696,7 @@ int vtkSTLReader::GetSTLFileType(const char *filename)
   return type;
 }
 
-// Specify a spatial locator for merging points. By
-// default an instance of vtkMergePoints is used.
+// Create a vtkMergePoints locator.
 vtkIncrementalPointLocator* vtkSTLReader::NewDefaultLocator()
 {
   return vtkMergePoints::New();
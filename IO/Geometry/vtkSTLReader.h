@@ -22,8 +22,11 @@
 // .stl files are quite inefficient since they duplicate vertex
 // definitions. By setting the Merging boolean you can control whether the
 // point data is merged after reading. Merging is performed by default,
-// however, merging requires a large amount of temporary storage since a
-// 3D hash table must be constructed.
+// however, merging requires a large amount of temporary storage. Unless a
+// Locator is specified, coincident points are found by sorting the points
+// in parallel, which gives the same output as inserting them in a
+// vtkMergePoints locator. Binary files are read in large blocks that are
+// decoded in parallel.
 
 // .SECTION Caveats
 // Binary files written on one system may not be readable on other systems.
@@ -73,8 +76,8 @@ public:
   vtkBooleanMacro(ScalarTags,int);
 
   // Description:
-  // Specify a spatial locator for merging points. By
-  // default an instance of vtkMergePoints is used.
+  // Specify a spatial locator for merging points. By default no locator
+  // is used and the points are merged by sorting them.
   void SetLocator(vtkIncrementalPointLocator *locator);
   vtkGetObjectMacro(Locator,vtkIncrementalPointLocator);
 
@@ -83,7 +86,8 @@ protected:
   ~vtkSTLReader();
 
   // Description:
-  // Create default locator. Used to create one when none is specified.
+  // Create a vtkMergePoints locator. Points are merged by sorting them
+  // when no locator is specified.
   vtkIncrementalPointLocator* NewDefaultLocator();
 
   char *FileName;
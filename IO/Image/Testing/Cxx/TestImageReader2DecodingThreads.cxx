@@ -0,0 +1,232 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImageReader2DecodingThreads.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Writes stacks of PNG and JPEG slices and checks that decoding several
+// slice files at a time gives the same image as decoding them one after
+// the other, both from a file pattern and from a list of file names, and
+// that PNG slices that cannot be decoded are reported as errors.
+
+#include <vtkCommand.h>
+#include <vtkImageData.h>
+#include <vtkImageReader2.h>
+#include <vtkImageWriter.h>
+#include <vtkJPEGReader.h>
+#include <vtkJPEGWriter.h>
+#include <vtkNew.h>
+#include <vtkPNGReader.h>
+#include <vtkPNGWriter.h>
+#include <vtkPointData.h>
+#include <vtkSmartPointer.h>
+#include <vtkStringArray.h>
+#include <vtkTestErrorObserver.h>
+#include <vtkTestUtilities.h>
+#include <vtkUnsignedCharArray.h>
+
+#include <cstdio>
+#include <string>
+
+namespace
+{
+vtkSmartPointer<vtkImageData> Read(vtkImageReader2* reader, int threads,
+                                   int* extent)
+{
+  reader->SetNumberOfDecodingThreads(threads);
+  reader->UpdateInformation();
+  reader->SetUpdateExtent(extent);
+  reader->Update();
+  vtkSmartPointer<vtkImageData> output = vtkSmartPointer<vtkImageData>::New();
+  output->DeepCopy(reader->GetOutput());
+  return output;
+}
+
+// Compare the scalars of actual with those of expected at the same
+// structured coordinates, over the extent of actual.
+bool Compare(vtkImageData* actual, vtkImageData* expected)
+{
+  int extent[6];
+  actual->GetExtent(extent);
+  int components = actual->GetNumberOfScalarComponents();
+  if (components != expected->GetNumberOfScalarComponents())
+    {
+    cerr << "Wrong number of components " << components << endl;
+    return false;
+    }
+  for (int k = extent[4]; k <= extent[5]; ++k)
+    {
+    for (int j = extent[2]; j <= extent[3]; ++j)
+      {
+      for (int i = extent[0]; i <= extent[1]; ++i)
+        {
+        for (int c = 0; c < components; ++c)
+          {
+          double a = actual->GetScalarComponentAsDouble(i, j, k, c);
+          double e = expected->GetScalarComponentAsDouble(i, j, k, c);
+          if (a != e)
+            {
+            cerr << "Wrong value " << a << " instead of " << e << " at "
+                 << i << " " << j << " " << k << endl;
+            return false;
+            }
+          }
+        }
+      }
+    }
+  return true;
+}
+
+// Read the stack with 1, 3 and the default number of threads, from the
+// file pattern and from the file names.  Returns the serial read of the
+// whole stack, or NULL when the reads differ.
+vtkSmartPointer<vtkImageData> CheckReader(vtkImageReader2* reader,
+                                          const std::string& prefix,
+                                          const char* extension,
+                                          int numberOfSlices)
+{
+  std::string pattern = "%s_%d.";
+  pattern += extension;
+  int wholeExtent[6] = { 0, 39, 0, 29, 0, numberOfSlices - 1 };
+  int subExtent[6] = { 5, 30, 3, 20, 1, numberOfSlices - 2 };
+
+  reader->SetFilePrefix(prefix.c_str());
+  reader->SetFilePattern(pattern.c_str());
+  reader->SetDataExtent(wholeExtent);
+  vtkSmartPointer<vtkImageData> serial = Read(reader, 1, wholeExtent);
+  int threads[2] = { 3, 0 };
+  for (int t = 0; t < 2; ++t)
+    {
+    if (!Compare(Read(reader, threads[t], wholeExtent), serial) ||
+        !Compare(Read(reader, threads[t], subExtent), serial))
+      {
+      cerr << "Wrong " << extension << " pattern read with " << threads[t]
+           << " threads" << endl;
+      return NULL;
+      }
+    }
+
+  vtkNew<vtkStringArray> fileNames;
+  for (int slice = 0; slice < numberOfSlices; ++slice)
+    {
+    char name[32];
+    sprintf(name, "_%d.", slice);
+    fileNames->InsertNextValue(prefix + name + extension);
+    }
+  reader->SetFileNames(fileNames.GetPointer());
+  for (int t = 0; t < 2; ++t)
+    {
+    if (!Compare(Read(reader, threads[t], wholeExtent), serial))
+      {
+      cerr << "Wrong " << extension << " file names read with "
+           << threads[t] << " threads" << endl;
+      return NULL;
+      }
+    }
+  return serial;
+}
+}
+
+int TestImageReader2DecodingThreads(int argc, char* argv[])
+{
+  char* tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  if (!tempDir)
+    {
+    cerr << "Could not determine temporary directory." << endl;
+    return EXIT_FAILURE;
+    }
+  std::string prefix = tempDir;
+  delete [] tempDir;
+  prefix += "/TestImageReader2DecodingThreads";
+
+  const int numberOfSlices = 7;
+  vtkNew<vtkImageData> image;
+  image->SetExtent(0, 39, 0, 29, 0, numberOfSlices - 1);
+  image->AllocateScalars(VTK_UNSIGNED_CHAR, 3);
+  for (int k = 0; k < numberOfSlices; ++k)
+    {
+    for (int j = 0; j < 30; ++j)
+      {
+      for (int i = 0; i < 40; ++i)
+        {
+        unsigned char* pixel =
+          static_cast<unsigned char*>(image->GetScalarPointer(i, j, k));
+        pixel[0] = static_cast<unsigned char>(6 * i + k);
+        pixel[1] = static_cast<unsigned char>(8 * j);
+        pixel[2] = static_cast<unsigned char>(36 * k);
+        }
+      }
+    }
+
+  vtkNew<vtkPNGWriter> pngWriter;
+  vtkNew<vtkJPEGWriter> jpegWriter;
+  vtkImageWriter* writers[2] = { pngWriter.GetPointer(),
+                                 jpegWriter.GetPointer() };
+  const char* extensions[2] = { "png", "jpg" };
+  for (int w = 0; w < 2; ++w)
+    {
+    std::string pattern = std::string("%s_%d.") + extensions[w];
+    writers[w]->SetInputData(image.GetPointer());
+    writers[w]->SetFilePrefix(prefix.c_str());
+    writers[w]->SetFilePattern(pattern.c_str());
+    writers[w]->Write();
+    }
+
+  // PNG is lossless, so the slices read must also match the image.
+  vtkNew<vtkPNGReader> pngReader;
+  vtkSmartPointer<vtkImageData> png = CheckReader(
+    pngReader.GetPointer(), prefix, "png", numberOfSlices);
+  if (!png || !Compare(png, image.GetPointer()))
+    {
+    return EXIT_FAILURE;
+    }
+
+  // Replace one slice with a truncated file and another with a file that
+  // has a PNG signature but no image.
+  std::string truncated = prefix + "_2.png";
+  std::string corrupt = prefix + "_4.png";
+  FILE* fp = fopen(truncated.c_str(), "wb");
+  fputs("PNG", fp);
+  fclose(fp);
+  fp = fopen(corrupt.c_str(), "wb");
+  const unsigned char signature[8] = { 137, 80, 78, 71, 13, 10, 26, 10 };
+  fwrite(signature, 1, 8, fp);
+  fputs("not an image", fp);
+  fclose(fp);
+  int threads[2] = { 1, 3 };
+  for (int t = 0; t < 2; ++t)
+    {
+    vtkNew<vtkPNGReader> reader;
+    vtkNew<vtkTest::ErrorObserver> errorObserver;
+    reader->AddObserver(vtkCommand::ErrorEvent, errorObserver.GetPointer());
+    reader->SetFilePrefix(prefix.c_str());
+    reader->SetFilePattern("%s_%d.png");
+    reader->SetDataExtent(0, 39, 0, 29, 0, numberOfSlices - 1);
+    reader->SetNumberOfDecodingThreads(threads[t]);
+    reader->Update();
+    if (!errorObserver->GetError() ||
+        errorObserver->GetErrorMessage().find(corrupt) == std::string::npos)
+      {
+      cerr << "Undecodable PNG slices not reported with " << threads[t]
+           << " threads" << endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  vtkNew<vtkJPEGReader> jpegReader;
+  if (!CheckReader(jpegReader.GetPointer(), prefix, "jpg", numberOfSlices))
+    {
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
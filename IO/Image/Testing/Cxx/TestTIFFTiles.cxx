@@ -0,0 +1,241 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestTIFFTiles.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Writes volumes as tiled multi-page TIFF files with each compression
+// that vtkTIFFWriter compresses itself, and checks that the whole volume
+// and sub-extents of it are read back exactly, decoding the tiles with
+// one and several threads.
+
+#include <vtkImageData.h>
+#include <vtkNew.h>
+#include <vtkSmartPointer.h>
+#include <vtkTestUtilities.h>
+#include <vtkTIFFReader.h>
+#include <vtkTIFFWriter.h>
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+namespace
+{
+vtkSmartPointer<vtkImageData> Read(const std::string& fileName, int threads,
+                                   int* extent)
+{
+  vtkNew<vtkTIFFReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->SetNumberOfDecodingThreads(threads);
+  reader->UpdateInformation();
+  if (extent)
+    {
+    reader->SetUpdateExtent(extent);
+    }
+  else
+    {
+    reader->SetUpdateExtentToWholeExtent();
+    }
+  reader->Update();
+  vtkSmartPointer<vtkImageData> output = vtkSmartPointer<vtkImageData>::New();
+  output->DeepCopy(reader->GetOutput());
+  return output;
+}
+
+// Compare the scalars of actual with those of expected over extent.
+// vtkTIFFReader puts the first row of files written by vtkTIFFWriter at
+// the bottom of its output, so the rows of expected are flipped.
+// Whether actual has an extra, opaque, alpha component is given by
+// alphaAdded.
+bool Compare(vtkImageData* actual, vtkImageData* expected,
+             const int* extent, bool alphaAdded = false)
+{
+  int* expectedExtent = expected->GetExtent();
+  int actualExtent[6];
+  actual->GetExtent(actualExtent);
+  for (int i = 0; i < 6; ++i)
+    {
+    if (actualExtent[i] != extent[i])
+      {
+      cerr << "Wrong extent" << endl;
+      return false;
+      }
+    }
+  // Tiled RGB images are read with an opaque alpha.
+  int components = expected->GetNumberOfScalarComponents();
+  int alpha = alphaAdded ? 1 : 0;
+  if (actual->GetScalarType() != expected->GetScalarType() ||
+      actual->GetNumberOfScalarComponents() != components + alpha)
+    {
+    cerr << "Wrong scalar type " << actual->GetScalarTypeAsString()
+         << " or number of components " << components << endl;
+    return false;
+    }
+  for (int k = extent[4]; k <= extent[5]; ++k)
+    {
+    for (int j = extent[2]; j <= extent[3]; ++j)
+      {
+      for (int i = extent[0]; i <= extent[1]; ++i)
+        {
+        for (int c = 0; c < components; ++c)
+          {
+          double a = actual->GetScalarComponentAsDouble(i, j, k, c);
+          double e = expected->GetScalarComponentAsDouble(
+            i, expectedExtent[2] + expectedExtent[3] - j, k, c);
+          if (a != e)
+            {
+            cerr << "Wrong value " << a << " instead of " << e << " at "
+                 << i << " " << j << " " << k << endl;
+            return false;
+            }
+          }
+        if (alpha && actual->GetScalarComponentAsDouble(
+              i, j, k, components) != 255.0)
+          {
+          cerr << "Wrong alpha at " << i << " " << j << " " << k << endl;
+          return false;
+          }
+        }
+      }
+    }
+  return true;
+}
+
+vtkSmartPointer<vtkImageData> MakeImage(int scalarType, int components)
+{
+  vtkSmartPointer<vtkImageData> image = vtkSmartPointer<vtkImageData>::New();
+  image->SetExtent(0, 99, 0, 69, 0, 2);
+  image->AllocateScalars(scalarType, components);
+  for (int k = 0; k <= 2; ++k)
+    {
+    for (int j = 0; j <= 69; ++j)
+      {
+      for (int i = 0; i <= 99; ++i)
+        {
+        for (int c = 0; c < components; ++c)
+          {
+          // Runs of equal values along rows exercise PackBits.
+          double value = ((i / 7) * 13 + j * 3 + k * 50 + c * 20) % 256;
+          if (scalarType == VTK_FLOAT)
+            {
+            value = 0.25 * value - 3.0;
+            }
+          else if (scalarType == VTK_UNSIGNED_SHORT)
+            {
+            value = value * 250.0;
+            }
+          image->SetScalarComponentFromDouble(i, j, k, c, value);
+          }
+        }
+      }
+    }
+  return image;
+}
+
+std::string ReadFile(const std::string& fileName)
+{
+  std::ifstream file(fileName.c_str(), std::ios::in | std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(file),
+                     std::istreambuf_iterator<char>());
+}
+}
+
+int TestTIFFTiles(int argc, char* argv[])
+{
+  char* tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  if (!tempDir)
+    {
+    cerr << "Could not determine temporary directory." << endl;
+    return EXIT_FAILURE;
+    }
+  std::string fileName = tempDir;
+  delete [] tempDir;
+  std::string serialFileName = fileName + "/TestTIFFTilesSerial.tif";
+  std::string stripsFileName = fileName + "/TestTIFFTilesStrips.tif";
+  fileName += "/TestTIFFTiles.tif";
+
+  int scalarTypes[4] =
+    { VTK_UNSIGNED_CHAR, VTK_UNSIGNED_SHORT, VTK_FLOAT, VTK_UNSIGNED_CHAR };
+  int components[4] = { 1, 1, 1, 3 };
+  int compressions[3] = { vtkTIFFWriter::NoCompression,
+                          vtkTIFFWriter::PackBits,
+                          vtkTIFFWriter::Deflate };
+  for (int t = 0; t < 4; ++t)
+    {
+    vtkSmartPointer<vtkImageData> image =
+      MakeImage(scalarTypes[t], components[t]);
+
+    // Images written in strips are read in the same orientation.
+    vtkNew<vtkImageData> slice;
+    slice->SetExtent(0, 99, 0, 69, 0, 0);
+    slice->AllocateScalars(scalarTypes[t], components[t]);
+    memcpy(slice->GetScalarPointer(), image->GetScalarPointer(),
+           slice->GetNumberOfPoints() * components[t] *
+           slice->GetScalarSize());
+    vtkNew<vtkTIFFWriter> stripsWriter;
+    stripsWriter->SetInputData(slice.GetPointer());
+    stripsWriter->SetCompressionToNoCompression();
+    stripsWriter->SetFileName(stripsFileName.c_str());
+    stripsWriter->Write();
+    if (!Compare(Read(stripsFileName, 1, 0), slice.GetPointer(),
+                 slice->GetExtent()))
+      {
+      cerr << "Wrong image written in strips" << endl;
+      return EXIT_FAILURE;
+      }
+    for (int c = 0; c < 3; ++c)
+      {
+      // Tiles of 40x20 are rounded up to 48x32, so that the tiles of the
+      // last column and row are partly outside of the image.
+      vtkNew<vtkTIFFWriter> writer;
+      writer->SetInputData(image);
+      writer->SetFileDimensionality(3);
+      writer->SetTileSize(40, 20);
+      writer->SetCompression(compressions[c]);
+      writer->SetFileName(fileName.c_str());
+      writer->Write();
+
+      // The file does not depend on the number of compression threads.
+      writer->SetNumberOfCompressionThreads(1);
+      writer->SetFileName(serialFileName.c_str());
+      writer->Write();
+      if (ReadFile(fileName) != ReadFile(serialFileName))
+        {
+        cerr << "Compressing tiles serially changed the file" << endl;
+        return EXIT_FAILURE;
+        }
+
+      int* wholeExtent = image->GetExtent();
+      int subExtent[6] = { 45, 60, 10, 40, 1, 2 };
+      int threads[2] = { 1, 3 };
+      for (int i = 0; i < 2; ++i)
+        {
+        bool alphaAdded = components[t] == 3;
+        if (!Compare(Read(fileName, threads[i], 0), image, wholeExtent,
+                     alphaAdded) ||
+            !Compare(Read(fileName, threads[i], subExtent), image, subExtent,
+                     alphaAdded))
+          {
+          cerr << "Wrong " << image->GetScalarTypeAsString() << " image with "
+               << components[t] << " components and compression "
+               << compressions[c] << " read with " << threads[i]
+               << " threads" << endl;
+          return EXIT_FAILURE;
+          }
+        }
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
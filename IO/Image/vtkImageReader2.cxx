@@ -19,13 +19,17 @@
 #include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkMultiThreader.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkErrorCode.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringArray.h"
 
 #include <sys/stat.h>
+#include <string>
+#include <vector>
 
 vtkStandardNewMacro(vtkImageReader2);
 
@@ -72,6 +76,8 @@ vtkImageReader2::vtkImageReader2()
   this->FileNameSliceOffset = 0;
   this->FileNameSliceSpacing = 1;
 
+  this->NumberOfDecodingThreads = 1;
+
   // Left over from short reader
   this->SwapBytes = 0;
   this->FileLowerLeft = 0;
@@ -443,6 +449,8 @@ void vtkImageReader2::PrintSelf(ostream& os, vtkIndent indent)
      << this->FileNameSliceOffset << "\n";
   os << indent << "FileNameSliceSpacing: "
      << this->FileNameSliceSpacing << "\n";
+  os << indent << "NumberOfDecodingThreads: "
+     << this->NumberOfDecodingThreads << "\n";
 
   os << indent << "DataScalarType: "
      << vtkImageScalarTypeNameMacro(this->DataScalarType) << "\n";
@@ -842,6 +850,91 @@ void vtkImageReader2::ExecuteDataWithInformation(vtkDataObject *output,
     }
 }
 
+//----------------------------------------------------------------------------
+// Decodes a batch of slice files, each into its own slice of the output.
+class vtkImageReader2DecodeFunctor
+{
+public:
+  vtkImageReader2 *Reader;
+  vtkImageData *Data;
+  int FirstSlice;
+  const std::vector<std::string> *FileNames;
+  std::vector<int> *Status;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      (*this->Status)[i] = this->Reader->DecodeSlice(
+        this->Data, this->FirstSlice + static_cast<int>(i),
+        (*this->FileNames)[i].c_str());
+      }
+  }
+};
+
+//----------------------------------------------------------------------------
+void vtkImageReader2::DecodeSlices(vtkImageData *data)
+{
+  int outExtent[6];
+  data->GetExtent(outExtent);
+  int numberOfSlices = outExtent[5] - outExtent[4] + 1;
+
+  int batchSize = this->NumberOfDecodingThreads;
+  if (batchSize == 0)
+    {
+    batchSize = vtkMultiThreader::GetGlobalDefaultNumberOfThreads();
+    }
+  if (batchSize < 1)
+    {
+    batchSize = 1;
+    }
+
+  std::vector<std::string> fileNames;
+  std::vector<int> status;
+  for (int first = 0; first < numberOfSlices; first += batchSize)
+    {
+    int n = numberOfSlices - first;
+    if (n > batchSize)
+      {
+      n = batchSize;
+      }
+
+    // The file names are computed up front since ComputeInternalFileName
+    // modifies the reader.
+    fileNames.resize(n);
+    status.assign(n, 1);
+    for (int i = 0; i < n; ++i)
+      {
+      this->ComputeInternalFileName(outExtent[4] + first + i);
+      fileNames[i] = this->InternalFileName ? this->InternalFileName : "";
+      }
+
+    vtkImageReader2DecodeFunctor decoder;
+    decoder.Reader = this;
+    decoder.Data = data;
+    decoder.FirstSlice = outExtent[4] + first;
+    decoder.FileNames = &fileNames;
+    decoder.Status = &status;
+    if (n == 1)
+      {
+      decoder(0, 1);
+      }
+    else
+      {
+      vtkSMPTools::For(0, n, 1, decoder);
+      }
+
+    for (int i = 0; i < n; ++i)
+      {
+      if (!status[i])
+        {
+        vtkErrorMacro(<< "Could not decode file: " << fileNames[i]);
+        }
+      }
+    this->UpdateProgress(static_cast<double>(first + n) / numberOfSlices);
+    }
+}
+
 //----------------------------------------------------------------------------
 void vtkImageReader2::SetMemoryBuffer(void *membuf)
 {
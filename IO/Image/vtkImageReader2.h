@@ -184,6 +184,15 @@ public:
   vtkSetMacro(FileNameSliceSpacing,int);
   vtkGetMacro(FileNameSliceSpacing,int);
 
+  // Description:
+  // Set/Get the number of slice files that are opened and decoded at the
+  // same time by the readers that support it, currently vtkPNGReader and
+  // vtkJPEGReader.  Each file is decoded straight into its own slice of
+  // the output.  vtkTIFFReader decodes the tiles of tiled images with
+  // this many threads.  0 uses vtkMultiThreader's default number of
+  // threads.  The default is 1, which reads the slices one after the other.
+  vtkSetClampMacro(NumberOfDecodingThreads, int, 0, VTK_INT_MAX);
+  vtkGetMacro(NumberOfDecodingThreads, int);
 
   // Description:
   // Set/Get the byte swapping to explicitly swap the bytes of a file.
@@ -271,12 +280,33 @@ protected:
   int FileNameSliceOffset;
   int FileNameSliceSpacing;
 
+  int NumberOfDecodingThreads;
+
   virtual int RequestInformation(vtkInformation* request,
                                  vtkInformationVector** inputVector,
                                  vtkInformationVector* outputVector);
   virtual void ExecuteInformation();
   virtual void ExecuteDataWithInformation(vtkDataObject *data, vtkInformation *outInfo);
   virtual void ComputeDataIncrements();
+
+  // Decode the slices of the extent of data with DecodeSlice, in batches
+  // of NumberOfDecodingThreads files decoded concurrently.  The progress
+  // is updated after each batch.
+  void DecodeSlices(vtkImageData *data);
+
+  // Decode the file of one slice into data.  Called concurrently for
+  // different slices, so it must not modify the reader.  Returns 0 when
+  // the file could not be decoded, which is reported as an error.
+  virtual int DecodeSlice(vtkImageData *vtkNotUsed(data),
+                          int vtkNotUsed(slice),
+                          const char *vtkNotUsed(fileName))
+    {
+      return 1;
+    }
+
+//BTX
+  friend class vtkImageReader2DecodeFunctor;
+//ETX
 private:
   vtkImageReader2(const vtkImageReader2&);  // Not implemented.
   void operator=(const vtkImageReader2&);  // Not implemented.
@@ -225,7 +225,7 @@ void vtkJPEGReader::ExecuteInformation()
 }
 
 template <class OT>
-int vtkJPEGReaderUpdate2(vtkJPEGReader *self, OT *outPtr,
+int vtkJPEGReaderUpdate2(vtkJPEGReader *self, const char *fileName, OT *outPtr,
                           int *outExt, vtkIdType *outInc, long)
 {
   // certain variables must be stored here for longjmp
@@ -235,7 +235,7 @@ int vtkJPEGReaderUpdate2(vtkJPEGReader *self, OT *outPtr,
 
   if (!self->GetMemoryBuffer())
     {
-    jerr.fp = fopen(self->GetInternalFileName(), "rb");
+    jerr.fp = fopen(fileName, "rb");
     if (!jerr.fp)
       {
       return 1;
@@ -331,36 +331,32 @@ int vtkJPEGReaderUpdate2(vtkJPEGReader *self, OT *outPtr,
 }
 
 //----------------------------------------------------------------------------
-// This function reads in one data of data.
-// templated to handle different data types.
-template <class OT>
-void vtkJPEGReaderUpdate(vtkJPEGReader *self, vtkImageData *data, OT *outPtr)
+// This function reads the file of one slice into data.  It is called
+// concurrently for different slices.
+int vtkJPEGReader::DecodeSlice(vtkImageData *data, int slice,
+                               const char *fileName)
 {
   vtkIdType outIncr[3];
   int outExtent[6];
-  OT *outPtr2;
 
   data->GetExtent(outExtent);
   data->GetIncrements(outIncr);
 
-  long pixSize = data->GetNumberOfScalarComponents()*sizeof(OT);
-
-  outPtr2 = outPtr;
-  int idx2;
-  for (idx2 = outExtent[4]; idx2 <= outExtent[5]; ++idx2)
+  void *outPtr = data->GetScalarPointer(outExtent[0], outExtent[2], slice);
+  long pixSize = data->GetNumberOfScalarComponents();
+  int result;
+  switch (data->GetScalarType())
     {
-    self->ComputeInternalFileName(idx2);
-    // read in a JPEG file
-    if ( vtkJPEGReaderUpdate2(self, outPtr2, outExtent, outIncr, pixSize) == 2 )
-      {
-      const char* fn = self->GetInternalFileName();
-      vtkErrorWithObjectMacro(self, "libjpeg could not read file: " << fn);
-      }
-
-    self->UpdateProgress((idx2 - outExtent[4])/
-                         (outExtent[5] - outExtent[4] + 1.0));
-    outPtr2 += outIncr[2];
+    vtkTemplateMacro(
+      result = vtkJPEGReaderUpdate2(this, fileName,
+                                    static_cast<VTK_TT *>(outPtr),
+                                    outExtent, outIncr,
+                                    pixSize*sizeof(VTK_TT)));
+    default:
+      return 0;
     }
+  // 2 means that libjpeg could not read the file
+  return result != 2;
 }
 
 
@@ -382,17 +378,7 @@ void vtkJPEGReader::ExecuteDataWithInformation(vtkDataObject *output,
 
   data->GetPointData()->GetScalars()->SetName("JPEGImage");
 
-  // Call the correct templated function for the output
-  void *outPtr;
-
-  // Call the correct templated function for the input
-  outPtr = data->GetScalarPointer();
-  switch (data->GetScalarType())
-    {
-    vtkTemplateMacro(vtkJPEGReaderUpdate(this, data, (VTK_TT *)(outPtr)));
-    default:
-      vtkErrorMacro(<< "UpdateFromFile: Unknown data type");
-    }
+  this->DecodeSlices(data);
 }
 
 
@@ -162,30 +162,29 @@ void vtkPNGReader::ExecuteInformation()
 
 
 //----------------------------------------------------------------------------
+// Returns 0 when the file could not be decoded.
 template <class OT>
-void vtkPNGReaderUpdate2(vtkPNGReader *self, OT *outPtr,
-                         int *outExt, vtkIdType *outInc, long pixSize)
+int vtkPNGReaderUpdate2(const char *fileName, OT *outPtr,
+                        int *outExt, vtkIdType *outInc, long pixSize)
 {
   unsigned int ui;
   int i;
-  FILE *fp = fopen(self->GetInternalFileName(), "rb");
+  FILE *fp = fopen(fileName, "rb");
   if (!fp)
     {
-    return;
+    return 0;
     }
   unsigned char header[8];
   if (fread(header, 1, 8, fp) != 8)
     {
-    vtkGenericWarningMacro ("PNGReader error reading file: " << self->GetInternalFileName()
-                   << " Premature EOF while reading header.");
     fclose (fp);
-    return;
+    return 0;
     }
   int is_png = !png_sig_cmp(header, 0, 8);
   if (!is_png)
     {
     fclose(fp);
-    return;
+    return 0;
     }
 
   png_structp png_ptr = png_create_read_struct
@@ -193,7 +192,7 @@ void vtkPNGReaderUpdate2(vtkPNGReader *self, OT *outPtr,
   if (!png_ptr)
     {
     fclose(fp);
-    return;
+    return 0;
     }
 
   png_infop info_ptr = png_create_info_struct(png_ptr);
@@ -202,7 +201,7 @@ void vtkPNGReaderUpdate2(vtkPNGReader *self, OT *outPtr,
     png_destroy_read_struct(&png_ptr,
                             (png_infopp)NULL, (png_infopp)NULL);
     fclose(fp);
-    return;
+    return 0;
     }
 
   png_infop end_info = png_create_info_struct(png_ptr);
@@ -211,7 +210,7 @@ void vtkPNGReaderUpdate2(vtkPNGReader *self, OT *outPtr,
     png_destroy_read_struct(&png_ptr, &info_ptr,
                             (png_infopp)NULL);
     fclose(fp);
-    return;
+    return 0;
     }
 
   // Set error handling
@@ -219,7 +218,7 @@ void vtkPNGReaderUpdate2(vtkPNGReader *self, OT *outPtr,
   {
     png_destroy_read_struct (&png_ptr, &info_ptr, (png_infopp)NULL);
     fclose(fp);
-    return;
+    return 0;
   }
 
   png_init_io(png_ptr, fp);
@@ -295,34 +294,34 @@ void vtkPNGReaderUpdate2(vtkPNGReader *self, OT *outPtr,
   png_read_end(png_ptr, NULL);
   png_destroy_read_struct(&png_ptr, &info_ptr, &end_info);
   fclose(fp);
+  return 1;
 }
 
 //----------------------------------------------------------------------------
-// This function reads in one data of data.
-// templated to handle different data types.
-template <class OT>
-void vtkPNGReaderUpdate(vtkPNGReader *self, vtkImageData *data, OT *outPtr)
+// This function reads the file of one slice into data.  It is called
+// concurrently for different slices.
+int vtkPNGReader::DecodeSlice(vtkImageData *data, int slice,
+                              const char *fileName)
 {
   vtkIdType outIncr[3];
   int outExtent[6];
-  OT *outPtr2;
 
   data->GetExtent(outExtent);
   data->GetIncrements(outIncr);
 
-  long pixSize = data->GetNumberOfScalarComponents()*sizeof(OT);
-
-  outPtr2 = outPtr;
-  int idx2;
-  for (idx2 = outExtent[4]; idx2 <= outExtent[5]; ++idx2)
+  void *outPtr = data->GetScalarPointer(outExtent[0], outExtent[2], slice);
+  long pixSize = data->GetNumberOfScalarComponents();
+  int result;
+  switch (data->GetScalarType())
     {
-    self->ComputeInternalFileName(idx2);
-    // read in a PNG file
-    vtkPNGReaderUpdate2(self, outPtr2, outExtent, outIncr, pixSize);
-    self->UpdateProgress((idx2 - outExtent[4])/
-                         (outExtent[5] - outExtent[4] + 1.0));
-    outPtr2 += outIncr[2];
+    vtkTemplateMacro(
+      result = vtkPNGReaderUpdate2(fileName, static_cast<VTK_TT *>(outPtr),
+                                   outExtent, outIncr,
+                                   pixSize*sizeof(VTK_TT)));
+    default:
+      return 0;
     }
+  return result;
 }
 
 
@@ -344,17 +343,7 @@ void vtkPNGReader::ExecuteDataWithInformation(vtkDataObject *output,
 
   this->ComputeDataIncrements();
 
-  // Call the correct templated function for the output
-  void *outPtr;
-
-  // Call the correct templated function for the input
-  outPtr = data->GetScalarPointer();
-  switch (data->GetScalarType())
-    {
-    vtkTemplateMacro(vtkPNGReaderUpdate(this, data, (VTK_TT *)(outPtr)));
-    default:
-      vtkErrorMacro(<< "UpdateFromFile: Unknown data type");
-    }
+  this->DecodeSlices(data);
 }
 
 
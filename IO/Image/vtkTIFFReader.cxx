@@ -18,10 +18,13 @@
 #include "vtkImageData.h"
 #include "vtkPointData.h"
 #include "vtkErrorCode.h"
+#include "vtkMultiThreader.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 
 #include <sys/stat.h>
 #include <string>
+#include <vector>
 
 extern "C" {
 #include "vtk_tiff.h"
@@ -93,6 +96,7 @@ public:
   bool Initialize();
   void Clean();
   bool CanRead();
+  bool CanReadTiles();
   bool Open(const char *filename);
   TIFF *Image;
   bool IsOpen;
@@ -320,6 +324,13 @@ bool vtkTIFFReader::vtkTIFFReaderInternal::Initialize()
       {
       this->TileDepth = 0;
       }
+
+    // Get the size of the tiles of the pages, see CanReadTiles.
+    if (this->NumberOfTiles == 0 && TIFFIsTiled(this->Image))
+      {
+      TIFFGetField(this->Image, TIFFTAG_TILEWIDTH, &this->TileWidth);
+      TIFFGetField(this->Image, TIFFTAG_TILELENGTH, &this->TileHeight);
+      }
     }
 
   return true;
@@ -345,6 +356,31 @@ bool vtkTIFFReader::vtkTIFFReaderInternal::CanRead()
              this->BitsPerSample == 32) );
 }
 
+//-------------------------------------------------------------------------
+// Whether the pages are tiled images whose tiles can be copied straight
+// into the output, which only reads the tiles inside the output extent.
+bool vtkTIFFReader::vtkTIFFReaderInternal::CanReadTiles()
+{
+  return ( this->Image && TIFFIsTiled(this->Image) &&
+           ( this->NumberOfTiles == 0 ) &&
+           ( this->TileWidth > 0 ) && ( this->TileHeight > 0 ) &&
+           ( this->TileDepth <= 1 ) &&
+           ( this->SubFiles == 0 || this->SubFiles == this->NumberOfPages ) &&
+           ( this->Compression == COMPRESSION_NONE ||
+             this->Compression == COMPRESSION_PACKBITS ||
+             this->Compression == COMPRESSION_LZW ||
+             this->Compression == COMPRESSION_DEFLATE ||
+             this->Compression == COMPRESSION_ADOBE_DEFLATE ) &&
+           ( this->HasValidPhotometricInterpretation ) &&
+           ( this->PlanarConfig == PLANARCONFIG_CONTIG ) &&
+           ( ( this->Photometrics == PHOTOMETRIC_MINISBLACK &&
+               this->SamplesPerPixel == 1 &&
+               ( this->BitsPerSample == 8 || this->BitsPerSample == 16 ||
+                 this->BitsPerSample == 32 ) ) ||
+             ( this->Photometrics == PHOTOMETRIC_RGB &&
+               this->SamplesPerPixel == 3 && this->BitsPerSample == 8 ) ) );
+}
+
 //-------------------------------------------------------------------------
 vtkTIFFReader::vtkTIFFReader()
 {
@@ -460,7 +496,12 @@ void vtkTIFFReader::ExecuteInformation()
       this->SetNumberOfScalarComponents(4);
     }
 
-  if (!this->InternalImage->CanRead())
+  // Tiled RGB images get an opaque alpha component, like the images read
+  // with TIFFReadRGBAImage.
+  if ((!this->InternalImage->CanRead() &&
+       !this->InternalImage->CanReadTiles()) ||
+      (this->InternalImage->CanReadTiles() &&
+       this->InternalImage->Photometrics == PHOTOMETRIC_RGB))
     {
     this->SetNumberOfScalarComponents(4);
     }
@@ -609,6 +650,13 @@ void vtkTIFFReader::Process2(OT *outPtr, int *)
 template <class OT>
 void vtkTIFFReader::Process(OT *outPtr, int outExtent[6], vtkIdType outIncr[3])
 {
+  // tiled pages
+  if (this->InternalImage->CanReadTiles())
+    {
+    this->ReadTiledImage(outPtr, sizeof(OT));
+    return;
+    }
+
   // multiple number of pages
   if (this->InternalImage->NumberOfPages > 1)
     {
@@ -926,6 +974,272 @@ void vtkTIFFReader::ReadTiles(void* buffer)
     }
 }
 
+//-------------------------------------------------------------------------
+// A tile of a slice of the output, at pixel X, Y of its page.
+struct vtkTIFFReaderTile
+{
+  int Slice;
+  unsigned int X;
+  unsigned int Y;
+};
+
+//-------------------------------------------------------------------------
+// Decodes the tiles of the output, split in one contiguous range per
+// worker.  Each worker opens the files with its own TIFF handle.
+class vtkTIFFReaderDecodeTiles
+{
+public:
+  const std::vector<std::string> *FileNames;
+  const std::vector<int> *Pages;
+  const std::vector<vtkTIFFReaderTile> *Tiles;
+  int NumberOfWorkers;
+  std::vector<int> *Failed;
+
+  unsigned char *Output;
+  vtkIdType Increments[3];
+  int OutputExtent[6];
+  unsigned int Width;
+  unsigned int Height;
+  unsigned int TileWidth;
+  unsigned int TileHeight;
+  int PixelSize;
+  int OutputPixelSize;
+  bool FlipRows;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType worker = begin; worker < end; ++worker)
+      {
+      size_t n = this->Tiles->size();
+      size_t first = n * worker / this->NumberOfWorkers;
+      size_t last = n * (worker + 1) / this->NumberOfWorkers;
+      if (!this->Decode(first, last))
+        {
+        (*this->Failed)[worker] = 1;
+        }
+      }
+  }
+
+  bool Decode(size_t first, size_t last)
+  {
+    TIFF *image = NULL;
+    const std::string *fileName = NULL;
+    int page = -1;
+    std::vector<unsigned char> buffer;
+    bool result = true;
+    for (size_t i = first; i < last && result; ++i)
+      {
+      const vtkTIFFReaderTile &tile = (*this->Tiles)[i];
+      const std::string &tileFileName = (*this->FileNames)[tile.Slice];
+      int tilePage = (*this->Pages)[tile.Slice];
+      if (!fileName || *fileName != tileFileName || page != tilePage)
+        {
+        if (image && (!fileName || *fileName != tileFileName))
+          {
+          TIFFClose(image);
+          image = NULL;
+          }
+        if (!image)
+          {
+          image = TIFFOpen(tileFileName.c_str(), "r");
+          }
+        fileName = &tileFileName;
+        page = tilePage;
+        result = image && TIFFSetDirectory(image, page) &&
+          this->HasSameLayout(image);
+        if (result)
+          {
+          buffer.resize(TIFFTileSize(image));
+          }
+        }
+      result = result &&
+        TIFFReadTile(image, &buffer[0], tile.X, tile.Y, 0, 0) >= 0;
+      if (result)
+        {
+        this->Copy(tile, &buffer[0]);
+        }
+      }
+    if (image)
+      {
+      TIFFClose(image);
+      }
+    return result;
+  }
+
+  // All pages must have the size and tiles of the first one.
+  bool HasSameLayout(TIFF *image)
+  {
+    uint32 width = 0, height = 0, tileWidth = 0, tileHeight = 0;
+    TIFFGetField(image, TIFFTAG_IMAGEWIDTH, &width);
+    TIFFGetField(image, TIFFTAG_IMAGELENGTH, &height);
+    TIFFGetField(image, TIFFTAG_TILEWIDTH, &tileWidth);
+    TIFFGetField(image, TIFFTAG_TILELENGTH, &tileHeight);
+    return width == this->Width && height == this->Height &&
+      tileWidth == this->TileWidth && tileHeight == this->TileHeight &&
+      TIFFTileSize(image) ==
+      static_cast<tsize_t>(tileWidth * tileHeight * this->PixelSize);
+  }
+
+  // Copy the rows of a decoded tile that are inside the output extent.
+  void Copy(const vtkTIFFReaderTile &tile, const unsigned char *buffer)
+  {
+    int x0 = static_cast<int>(tile.X);
+    int x1 = static_cast<int>(tile.X + this->TileWidth);
+    if (x1 > static_cast<int>(this->Width))
+      {
+      x1 = static_cast<int>(this->Width);
+      }
+    --x1;
+    x0 = x0 > this->OutputExtent[0] ? x0 : this->OutputExtent[0];
+    x1 = x1 < this->OutputExtent[1] ? x1 : this->OutputExtent[1];
+    if (x0 > x1)
+      {
+      return;
+      }
+    unsigned char *slice = this->Output +
+      (tile.Slice) * this->Increments[2] +
+      (x0 - this->OutputExtent[0]) * this->Increments[0];
+    int numPixels = x1 - x0 + 1;
+    size_t size = static_cast<size_t>(numPixels) * this->PixelSize;
+    for (unsigned int r = 0; r < this->TileHeight; ++r)
+      {
+      unsigned int fileRow = tile.Y + r;
+      if (fileRow >= this->Height)
+        {
+        break;
+        }
+      int row = static_cast<int>(this->FlipRows ?
+                                 this->Height - fileRow - 1 : fileRow);
+      if (row < this->OutputExtent[2] || row > this->OutputExtent[3])
+        {
+        continue;
+        }
+      unsigned char *out =
+        slice + (row - this->OutputExtent[2]) * this->Increments[1];
+      const unsigned char *in =
+        buffer + (r * this->TileWidth + x0 - tile.X) * this->PixelSize;
+      if (this->OutputPixelSize == this->PixelSize)
+        {
+        memcpy(out, in, size);
+        continue;
+        }
+      // Add the opaque alpha of RGB pixels.
+      for (int i = 0; i < numPixels; ++i)
+        {
+        memcpy(out, in, this->PixelSize);
+        memset(out + this->PixelSize, 255,
+               this->OutputPixelSize - this->PixelSize);
+        out += this->OutputPixelSize;
+        in += this->PixelSize;
+        }
+      }
+  }
+};
+
+//-------------------------------------------------------------------------
+void vtkTIFFReader::ReadTiledImage(void *buffer, int scalarSize)
+{
+  vtkTIFFReaderInternal *internal = this->InternalImage;
+  int *outExt = this->OutputExtent;
+
+  // The file and page of each slice.  Multi-page files have one page per
+  // slice, otherwise each slice is a file of its own.
+  std::vector<std::string> fileNames;
+  std::vector<int> pages;
+  std::string fileName = this->InternalFileName;
+  for (int z = outExt[4]; z <= outExt[5]; ++z)
+    {
+    if (internal->NumberOfPages > 1)
+      {
+      fileNames.push_back(fileName);
+      pages.push_back(z);
+      }
+    else
+      {
+      this->ComputeInternalFileName(z);
+      fileNames.push_back(this->InternalFileName);
+      pages.push_back(0);
+      }
+    }
+
+  // Only the tiles that overlap the output extent are decoded.
+  bool flipRows = (internal->Orientation != ORIENTATION_TOPLEFT);
+  int row0 = flipRows ? internal->Height - 1 - outExt[3] : outExt[2];
+  int row1 = flipRows ? internal->Height - 1 - outExt[2] : outExt[3];
+  std::vector<vtkTIFFReaderTile> tiles;
+  for (int z = outExt[4]; z <= outExt[5]; ++z)
+    {
+    for (int y = row0 / internal->TileHeight;
+         y <= static_cast<int>(row1 / internal->TileHeight); ++y)
+      {
+      for (int x = outExt[0] / internal->TileWidth;
+           x <= static_cast<int>(outExt[1] / internal->TileWidth); ++x)
+        {
+        vtkTIFFReaderTile tile;
+        tile.Slice = z - outExt[4];
+        tile.X = x * internal->TileWidth;
+        tile.Y = y * internal->TileHeight;
+        tiles.push_back(tile);
+        }
+      }
+    }
+
+  int workers = this->NumberOfDecodingThreads;
+  if (workers == 0)
+    {
+    workers = vtkMultiThreader::GetGlobalDefaultNumberOfThreads();
+    }
+  if (workers > static_cast<int>(tiles.size()))
+    {
+    workers = static_cast<int>(tiles.size());
+    }
+  if (workers < 1)
+    {
+    return;
+    }
+
+  std::vector<int> failed(workers, 0);
+  vtkTIFFReaderDecodeTiles decoder;
+  decoder.FileNames = &fileNames;
+  decoder.Pages = &pages;
+  decoder.Tiles = &tiles;
+  decoder.NumberOfWorkers = workers;
+  decoder.Failed = &failed;
+  decoder.Output = static_cast<unsigned char*>(buffer);
+  for (int i = 0; i < 3; ++i)
+    {
+    decoder.Increments[i] = this->OutputIncrements[i] * scalarSize;
+    }
+  for (int i = 0; i < 6; ++i)
+    {
+    decoder.OutputExtent[i] = outExt[i];
+    }
+  decoder.Width = internal->Width;
+  decoder.Height = internal->Height;
+  decoder.TileWidth = internal->TileWidth;
+  decoder.TileHeight = internal->TileHeight;
+  decoder.PixelSize = scalarSize * internal->SamplesPerPixel;
+  decoder.OutputPixelSize = scalarSize * this->GetNumberOfScalarComponents();
+  decoder.FlipRows = flipRows;
+  if (workers == 1)
+    {
+    decoder(0, 1);
+    }
+  else
+    {
+    vtkSMPTools::For(0, workers, 1, decoder);
+    }
+
+  for (int i = 0; i < workers; ++i)
+    {
+    if (failed[i])
+      {
+      vtkErrorMacro(<< "Cannot read the tiles of file " << fileNames[0]);
+      break;
+      }
+    }
+}
+
 /** To Support Zeiss images that contains only 2 samples per pixel but are actually
  *  RGB images */
 void vtkTIFFReader::ReadTwoSamplesPerPixelImage(void *out,
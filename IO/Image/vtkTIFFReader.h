@@ -17,6 +17,9 @@
 // vtkTIFFReader is a source object that reads TIFF files.
 // It should be able to read almost any TIFF file
 //
+// Tiled RGB images are read with 4 components, the last one being an
+// opaque alpha.
+//
 // .SECTION See Also
 // vtkTIFFWriter
 
@@ -131,6 +134,11 @@ private:
   // Reads 3D data from tiled tiff
   void ReadTiles(void* buffer);
 
+  // Description:
+  // Reads the tiles of tiled pages that overlap the output extent,
+  // NumberOfDecodingThreads at a time.
+  void ReadTiledImage(void* buffer, int scalarSize);
+
   // Description:
   // Reads a generic image.
   template<typename T>
@@ -18,35 +18,73 @@
 #include "vtkImageData.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkSMPTools.h"
 #include "vtk_tiff.h"
+#include "vtk_zlib.h"
+
+#include <vector>
 
 vtkStandardNewMacro(vtkTIFFWriter);
 
+//----------------------------------------------------------------------------
+// Number of tiles compressed together before they are written.
+static const int vtkTIFFWriterTilesPerBatch = 64;
+
 //----------------------------------------------------------------------------
 vtkTIFFWriter::vtkTIFFWriter()
 {
   this->TIFFPtr = 0;
   this->Compression = vtkTIFFWriter::PackBits;
+  this->TileSize[0] = 0;
+  this->TileSize[1] = 0;
+  this->NumberOfCompressionThreads = 0;
 };
 
 
+// The client data of the TIFF handle.  Writing the directory of a page
+// after the first one reads back the directories already written, so the
+// file is then also opened for reading.
+class vtkTIFFWriterHandle
+{
+public:
+  ostream *Stream;
+  const char *FileName;
+  ifstream *Input;
+};
+
 class vtkTIFFWriterIO
 {
 public:
-  // Writing file no reading
-  static tsize_t TIFFRead(thandle_t, tdata_t, tsize_t) { return 0; }
+  // Read back data already written
+  static tsize_t TIFFRead(thandle_t fd, tdata_t buf, tsize_t size)
+    {
+    vtkTIFFWriterHandle *handle = reinterpret_cast<vtkTIFFWriterHandle *>(fd);
+    ostream *out = handle->Stream;
+    out->flush();
+    toff_t pos = out->tellp();
+    if (!handle->Input)
+      {
+      handle->Input = new ifstream(handle->FileName, ios::in | ios::binary);
+      }
+    handle->Input->clear();
+    handle->Input->seekg(pos);
+    handle->Input->read(static_cast<char *>(buf), size);
+    tsize_t count = static_cast<tsize_t>(handle->Input->gcount());
+    out->seekp(pos + count, ios::beg);
+    return count;
+    }
 
   // Write data
   static tsize_t TIFFWrite(thandle_t fd, tdata_t buf, tsize_t size)
     {
-    ostream *out = reinterpret_cast<ostream *>(fd);
+    ostream *out = reinterpret_cast<vtkTIFFWriterHandle *>(fd)->Stream;
     out->write(static_cast<char *>(buf), size);
     return out->fail() ? static_cast<tsize_t>(0) : size;
     }
 
   static toff_t TIFFSeek(thandle_t fd, toff_t off, int whence)
     {
-    ostream *out = reinterpret_cast<ostream *>(fd);
+    ostream *out = reinterpret_cast<vtkTIFFWriterHandle *>(fd)->Stream;
     switch (whence)
       {
       case SEEK_SET:
@@ -65,11 +103,17 @@ public:
     }
 
   // File will be closed by the superclass
-  static int TIFFClose(thandle_t) { return 1; }
+  static int TIFFClose(thandle_t fd)
+    {
+    vtkTIFFWriterHandle *handle = reinterpret_cast<vtkTIFFWriterHandle *>(fd);
+    delete handle->Input;
+    delete handle;
+    return 1;
+    }
 
   static toff_t TIFFSize(thandle_t fd)
     {
-    ostream *out = reinterpret_cast<ostream *>(fd);
+    ostream *out = reinterpret_cast<vtkTIFFWriterHandle *>(fd)->Stream;
     out->seekp(0, ios::end);
     return out->tellp();
     }
@@ -79,51 +123,49 @@ public:
 };
 
 //----------------------------------------------------------------------------
-void vtkTIFFWriter::WriteFileHeader(ofstream *file, vtkImageData *data, int wExt[6])
+// Returns the number of bits per sample of a scalar type, or 0 if TIFF
+// files of that type cannot be written.
+static int vtkTIFFWriterGetBitsPerSample(int stype)
 {
-  int dims[3];
-  int width, height;
-  data->GetDimensions(dims);
-  int scomponents = data->GetNumberOfScalarComponents();
-  int stype = data->GetScalarType();
-  double resolution = -1;
-  uint32 rowsperstrip = (uint32) -1;
-
-  int min0 = wExt[0],
-    max0 = wExt[1],
-    min1 = wExt[2],
-    max1 = wExt[3];
-
-  int bps;
   switch (stype)
     {
     case VTK_CHAR:
     case VTK_SIGNED_CHAR:
     case VTK_UNSIGNED_CHAR:
-      bps = 8;
-      break;
+      return 8;
     case VTK_SHORT:
     case VTK_UNSIGNED_SHORT:
-      bps = 16;
-      break;
+      return 16;
     case VTK_FLOAT:
-      bps = 32;
-      break;
-    default:
-      vtkErrorMacro(<< "Unsupported data type: " << data->GetScalarTypeAsString());
-      this->SetErrorCode(vtkErrorCode::FileFormatError);
-      return;
+      return 32;
     }
+  return 0;
+}
 
-  int predictor;
-  ostream* ost = file;
+//----------------------------------------------------------------------------
+// Rounds a tile size up to a multiple of 16.
+static int vtkTIFFWriterRoundTileSize(int size)
+{
+  return ((size + 15) / 16) * 16;
+}
 
-  // Find the length of the rows to write.
-  width = (max0 - min0 + 1);
-  height = (max1 - min1 + 1);
+//----------------------------------------------------------------------------
+void vtkTIFFWriter::WriteFileHeader(ofstream *file, vtkImageData *data, int wExt[6])
+{
+  if (!vtkTIFFWriterGetBitsPerSample(data->GetScalarType()))
+    {
+    vtkErrorMacro(<< "Unsupported data type: " << data->GetScalarTypeAsString());
+    this->SetErrorCode(vtkErrorCode::FileFormatError);
+    return;
+    }
+
+  vtkTIFFWriterHandle* handle = new vtkTIFFWriterHandle;
+  handle->Stream = file;
+  handle->FileName = this->InternalFileName;
+  handle->Input = 0;
 
   TIFF* tif = TIFFClientOpen(this->InternalFileName, "w",
-    (thandle_t) ost,
+    (thandle_t) handle,
     reinterpret_cast<TIFFReadWriteProc>(vtkTIFFWriterIO::TIFFRead),
     reinterpret_cast<TIFFReadWriteProc>(vtkTIFFWriterIO::TIFFWrite),
     reinterpret_cast<TIFFSeekProc>(vtkTIFFWriterIO::TIFFSeek),
@@ -134,11 +176,31 @@ void vtkTIFFWriter::WriteFileHeader(ofstream *file, vtkImageData *data, int wExt
     );
   if ( !tif )
     {
+    delete handle;
     this->TIFFPtr = 0;
     return;
     }
   this->TIFFPtr = tif;
 
+  this->SetDirectoryFields(data, wExt);
+}
+
+//----------------------------------------------------------------------------
+void vtkTIFFWriter::SetDirectoryFields(vtkImageData *data, int wExt[6])
+{
+  TIFF* tif = reinterpret_cast<TIFF*>(this->TIFFPtr);
+  int scomponents = data->GetNumberOfScalarComponents();
+  int stype = data->GetScalarType();
+  int bps = vtkTIFFWriterGetBitsPerSample(stype);
+  double resolution = -1;
+  uint32 rowsperstrip = (uint32) -1;
+  int tiled = (this->TileSize[0] > 0 && this->TileSize[1] > 0);
+  int predictor;
+
+  // Find the length of the rows to write.
+  int width = (wExt[1] - wExt[0] + 1);
+  int height = (wExt[3] - wExt[2] + 1);
+
   uint32 w = width;
   uint32 h = height;
   TIFFSetField(tif, TIFFTAG_IMAGEWIDTH, w);
@@ -190,19 +252,30 @@ void vtkTIFFWriter::WriteFileHeader(ofstream *file, vtkImageData *data, int wExt
     }
   else if ( compression == COMPRESSION_LZW )
     {
-    predictor = 2;
+    // libtiff only differences 8 and 16 bit samples of tiles
+    predictor = (tiled && bps == 32) ? 1 : 2;
     TIFFSetField(tif, TIFFTAG_PREDICTOR, predictor);
     vtkErrorMacro("LZW compression is patented outside US so it is disabled");
     }
   else if ( compression == COMPRESSION_DEFLATE )
     {
-    predictor = 2;
+    predictor = (tiled && bps == 32) ? 1 : 2;
     TIFFSetField(tif, TIFFTAG_PREDICTOR, predictor);
     }
 
   TIFFSetField(tif, TIFFTAG_PHOTOMETRIC, photometric); // Fix for scomponents
-  TIFFSetField(tif, TIFFTAG_ROWSPERSTRIP,
-    TIFFDefaultStripSize(tif, rowsperstrip));
+  if (tiled)
+    {
+    TIFFSetField(tif, TIFFTAG_TILEWIDTH,
+      static_cast<uint32>(vtkTIFFWriterRoundTileSize(this->TileSize[0])));
+    TIFFSetField(tif, TIFFTAG_TILELENGTH,
+      static_cast<uint32>(vtkTIFFWriterRoundTileSize(this->TileSize[1])));
+    }
+  else
+    {
+    TIFFSetField(tif, TIFFTAG_ROWSPERSTRIP,
+      TIFFDefaultStripSize(tif, rowsperstrip));
+    }
   if (resolution > 0)
     {
     TIFFSetField(tif, TIFFTAG_XRESOLUTION, resolution);
@@ -211,9 +284,253 @@ void vtkTIFFWriter::WriteFileHeader(ofstream *file, vtkImageData *data, int wExt
     }
 }
 
+//----------------------------------------------------------------------------
+// The tiles of one slice.  Tiles are numbered along rows of tiles, the
+// top row first, as TIFF stores them.
+class vtkTIFFWriterTiles
+{
+public:
+  unsigned char *TopLeft;
+  vtkIdType RowIncrement;
+  int Width;
+  int Height;
+  int PixelSize;
+  int TileWidth;
+  int TileHeight;
+  int TilesAcross;
+
+  // Copy a tile from the slice, padded with zeros past the image.
+  void Copy(int tile, std::vector<unsigned char> &buffer) const
+  {
+    size_t tileRowSize = static_cast<size_t>(this->TileWidth) * this->PixelSize;
+    buffer.assign(tileRowSize * this->TileHeight, 0);
+    int x0 = (tile % this->TilesAcross) * this->TileWidth;
+    int row0 = (tile / this->TilesAcross) * this->TileHeight;
+    int width = this->Width - x0;
+    if (width > this->TileWidth)
+      {
+      width = this->TileWidth;
+      }
+    for (int r = 0; r < this->TileHeight && row0 + r < this->Height; ++r)
+      {
+      memcpy(&buffer[r * tileRowSize],
+             this->TopLeft - (row0 + r) * this->RowIncrement +
+             x0 * this->PixelSize,
+             static_cast<size_t>(width) * this->PixelSize);
+      }
+  }
+};
+
+//----------------------------------------------------------------------------
+// Apply the horizontal differencing predictor to each row of a tile.
+template <class T>
+void vtkTIFFWriterDifferenceRows(T *data, int rowLength, int rows,
+                                 int samplesPerPixel)
+{
+  for (int r = 0; r < rows; ++r)
+    {
+    T *row = data + static_cast<size_t>(r) * rowLength;
+    for (int i = rowLength - 1; i >= samplesPerPixel; --i)
+      {
+      row[i] = static_cast<T>(row[i] - row[i - samplesPerPixel]);
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+// Encode one row with PackBits: runs of 3 or more equal bytes are
+// replicated, other bytes are copied literally, at most 128 at a time.
+static void vtkTIFFWriterPackBits(const unsigned char *in, int size,
+                                  std::vector<unsigned char> &out)
+{
+  int i = 0;
+  while (i < size)
+    {
+    int run = 1;
+    while (i + run < size && run < 128 && in[i + run] == in[i])
+      {
+      ++run;
+      }
+    if (run >= 3)
+      {
+      out.push_back(static_cast<unsigned char>(1 - run));
+      out.push_back(in[i]);
+      i += run;
+      continue;
+      }
+    int start = i;
+    while (i < size && i - start < 128 &&
+           !(i + 2 < size && in[i] == in[i + 1] && in[i] == in[i + 2]))
+      {
+      ++i;
+      }
+    out.push_back(static_cast<unsigned char>(i - start - 1));
+    out.insert(out.end(), in + start, in + i);
+    }
+}
+
+//----------------------------------------------------------------------------
+// Copies and compresses a batch of tiles without libtiff, so that they can
+// be compressed concurrently.  An empty tile means that compression failed.
+class vtkTIFFWriterEncodeTiles
+{
+public:
+  const vtkTIFFWriterTiles *Tiles;
+  int FirstTile;
+  int Compression;
+  int BitsPerSample;
+  int SamplesPerPixel;
+  std::vector<std::vector<unsigned char> > *Encoded;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    std::vector<unsigned char> tile;
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      std::vector<unsigned char> &out = (*this->Encoded)[i];
+      out.clear();
+      if (this->Compression == vtkTIFFWriter::NoCompression)
+        {
+        this->Tiles->Copy(this->FirstTile + static_cast<int>(i), out);
+        continue;
+        }
+      this->Tiles->Copy(this->FirstTile + static_cast<int>(i), tile);
+      int rowSize = this->Tiles->TileWidth * this->Tiles->PixelSize;
+      if (this->Compression == vtkTIFFWriter::PackBits)
+        {
+        for (int r = 0; r < this->Tiles->TileHeight; ++r)
+          {
+          vtkTIFFWriterPackBits(&tile[r * rowSize], rowSize, out);
+          }
+        continue;
+        }
+
+      // Deflate, with the same predictor as set in SetDirectoryFields.
+      int rowLength = this->Tiles->TileWidth * this->SamplesPerPixel;
+      if (this->BitsPerSample == 8)
+        {
+        vtkTIFFWriterDifferenceRows(&tile[0], rowLength,
+                                    this->Tiles->TileHeight,
+                                    this->SamplesPerPixel);
+        }
+      else if (this->BitsPerSample == 16)
+        {
+        vtkTIFFWriterDifferenceRows(reinterpret_cast<unsigned short*>(&tile[0]),
+                                    rowLength, this->Tiles->TileHeight,
+                                    this->SamplesPerPixel);
+        }
+      uLongf size = compressBound(static_cast<uLong>(tile.size()));
+      out.resize(size);
+      if (compress2(&out[0], &size, &tile[0], static_cast<uLong>(tile.size()),
+                    Z_DEFAULT_COMPRESSION) != Z_OK)
+        {
+        out.clear();
+        continue;
+        }
+      out.resize(size);
+      }
+  }
+};
+
+//----------------------------------------------------------------------------
+int vtkTIFFWriter::WriteTiles(vtkImageData *data, int extent[6], int slice)
+{
+  TIFF* tif = reinterpret_cast<TIFF*>(this->TIFFPtr);
+
+  vtkIdType increments[3];
+  data->GetIncrements(increments);
+  vtkTIFFWriterTiles tiles;
+  tiles.TopLeft = static_cast<unsigned char*>(
+    data->GetScalarPointer(extent[0], extent[3], slice));
+  tiles.RowIncrement = increments[1] * data->GetScalarSize();
+  tiles.Width = extent[1] - extent[0] + 1;
+  tiles.Height = extent[3] - extent[2] + 1;
+  tiles.PixelSize = data->GetNumberOfScalarComponents() * data->GetScalarSize();
+  tiles.TileWidth = vtkTIFFWriterRoundTileSize(this->TileSize[0]);
+  tiles.TileHeight = vtkTIFFWriterRoundTileSize(this->TileSize[1]);
+  tiles.TilesAcross = (tiles.Width + tiles.TileWidth - 1) / tiles.TileWidth;
+  int numberOfTiles = tiles.TilesAcross *
+    ((tiles.Height + tiles.TileHeight - 1) / tiles.TileHeight);
+
+  // libtiff compresses JPEG and LZW tiles itself, one at a time.
+  if (this->Compression == vtkTIFFWriter::JPEG ||
+      this->Compression == vtkTIFFWriter::LZW)
+    {
+    std::vector<unsigned char> tile;
+    for (int t = 0; t < numberOfTiles; ++t)
+      {
+      tiles.Copy(t, tile);
+      if (TIFFWriteEncodedTile(tif, t, &tile[0],
+                               static_cast<tsize_t>(tile.size())) < 0)
+        {
+        this->SetErrorCode(vtkErrorCode::OutOfDiskSpaceError);
+        return 0;
+        }
+      }
+    return 1;
+    }
+
+  std::vector<std::vector<unsigned char> > encoded;
+  vtkTIFFWriterEncodeTiles encoder;
+  encoder.Tiles = &tiles;
+  encoder.Compression = this->Compression;
+  encoder.BitsPerSample = vtkTIFFWriterGetBitsPerSample(data->GetScalarType());
+  encoder.SamplesPerPixel = data->GetNumberOfScalarComponents();
+  encoder.Encoded = &encoded;
+  int batchSize = vtkTIFFWriterTilesPerBatch;
+  if (this->NumberOfCompressionThreads == 1)
+    {
+    batchSize = 1;
+    }
+  for (int first = 0; first < numberOfTiles; first += batchSize)
+    {
+    int n = numberOfTiles - first;
+    if (n > batchSize)
+      {
+      n = batchSize;
+      }
+    encoded.resize(n);
+    encoder.FirstTile = first;
+
+    // Compress the tiles concurrently.
+    if (this->NumberOfCompressionThreads == 1)
+      {
+      encoder(0, n);
+      }
+    else
+      {
+      vtkIdType grain = 1;
+      if (this->NumberOfCompressionThreads > 0)
+        {
+        grain = (n + this->NumberOfCompressionThreads - 1) /
+          this->NumberOfCompressionThreads;
+        }
+      vtkSMPTools::For(0, n, grain, encoder);
+      }
+
+    // Write the compressed tiles in order.
+    for (int i = 0; i < n; ++i)
+      {
+      if (encoded[i].empty())
+        {
+        vtkErrorMacro("Error compressing tile " << first + i);
+        this->SetErrorCode(vtkErrorCode::UnknownError);
+        return 0;
+        }
+      if (TIFFWriteRawTile(tif, first + i, &encoded[i][0],
+                           static_cast<tsize_t>(encoded[i].size())) < 0)
+        {
+        this->SetErrorCode(vtkErrorCode::OutOfDiskSpaceError);
+        return 0;
+        }
+      }
+    }
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 void vtkTIFFWriter::WriteFile(ofstream *, vtkImageData *data,
-                              int extent[6], int*)
+                              int extent[6], int *wExt)
 {
   int idx1, idx2;
   void *ptr;
@@ -244,6 +561,28 @@ void vtkTIFFWriter::WriteFile(ofstream *, vtkImageData *data,
     return;
     }
 
+  // Tiled images have one page per slice.
+  if (this->TileSize[0] > 0 && this->TileSize[1] > 0)
+    {
+    for (idx2 = extent[4]; idx2 <= extent[5]; ++idx2)
+      {
+      if (idx2 > extent[4])
+        {
+        if (!TIFFWriteDirectory(tif))
+          {
+          this->SetErrorCode(vtkErrorCode::OutOfDiskSpaceError);
+          return;
+          }
+        this->SetDirectoryFields(data, wExt);
+        }
+      if (!this->WriteTiles(data, extent, idx2))
+        {
+        return;
+        }
+      }
+    return;
+    }
+
   int row = 0;
   for (idx2 = extent[4]; idx2 <= extent[5]; ++idx2)
     {
@@ -299,4 +638,8 @@ void vtkTIFFWriter::PrintSelf(ostream& os, vtkIndent indent)
     {
     os << "No Compression\n";
     }
+  os << indent << "TileSize: " << this->TileSize[0] << " "
+     << this->TileSize[1] << "\n";
+  os << indent << "NumberOfCompressionThreads: "
+     << this->NumberOfCompressionThreads << "\n";
 }
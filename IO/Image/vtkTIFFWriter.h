@@ -20,6 +20,11 @@
 // is currently under patent in the US and is disabled until the patent
 // expires. However, the mechanism for supporting this compression is available
 // for those with a valid license or to whom the patent does not apply.)
+//
+// The image is written in strips of rows unless TileSize is set, in which
+// case each slice is written as its own page, cut into tiles.  Tiles that
+// are not compressed, or compressed with packed bits or deflation, are
+// compressed concurrently.
 
 #ifndef __vtkTIFFWriter_h
 #define __vtkTIFFWriter_h
@@ -55,6 +60,24 @@ public:
   void SetCompressionToDeflate()       { this->SetCompression(Deflate); }
   void SetCompressionToLZW()           { this->SetCompression(LZW); }
 
+  // Description:
+  // Get/Set the width and height of the tiles.  Both are rounded up to a
+  // multiple of 16, as required by TIFF.  The default, 0 0, writes the
+  // image in strips of rows.
+  vtkSetVector2Macro(TileSize, int);
+  vtkGetVector2Macro(TileSize, int);
+
+  // Description:
+  // Get/Set how many batches consecutive tiles are split into to be
+  // compressed concurrently with vtkSMPTools.  This is the grain of
+  // vtkSMPTools::For, not a number of threads: the SMP backend decides how
+  // many threads run the batches.  The tiles are written in order, so the
+  // file does not depend on this setting.  A value of 0 (the default)
+  // lets vtkSMPTools choose the grain; 1 compresses the tiles serially.
+  // JPEG and LZW tiles are always compressed serially by libtiff.
+  vtkSetClampMacro(NumberOfCompressionThreads, int, 0, VTK_INT_MAX);
+  vtkGetMacro(NumberOfCompressionThreads, int);
+
 protected:
   vtkTIFFWriter();
   ~vtkTIFFWriter() {}
@@ -63,8 +86,17 @@ protected:
   virtual void WriteFileHeader(ofstream *, vtkImageData *, int wExt[6]);
   virtual void WriteFileTrailer(ofstream *, vtkImageData *);
 
+  // Set the fields of the current directory for an image of the given
+  // whole extent.
+  void SetDirectoryFields(vtkImageData *data, int wExt[6]);
+
+  // Write one slice of data as tiles.  Returns 0 on error.
+  int WriteTiles(vtkImageData *data, int extent[6], int slice);
+
   void* TIFFPtr;
   int Compression;
+  int TileSize[2];
+  int NumberOfCompressionThreads;
 
 private:
   vtkTIFFWriter(const vtkTIFFWriter&);  // Not implemented.
@@ -0,0 +1,266 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestColumnarTableReadWrite.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Writes a table of numeric and string columns without compression and
+// with each compressor, then reads all of it, some columns, a range of
+// rows and pieces, with and without memory mapping and with several
+// threads, and checks that the values read are those written and that
+// the raw numeric columns are mapped rather than copied.
+
+#include <vtkColumnarTableReader.h>
+#include <vtkColumnarTableWriter.h>
+#include <vtkDoubleArray.h>
+#include <vtkFloatArray.h>
+#include <vtkIdTypeArray.h>
+#include <vtkIntArray.h>
+#include <vtkNew.h>
+#include <vtkStreamingDemandDrivenPipeline.h>
+#include <vtkStringArray.h>
+#include <vtkTable.h>
+#include <vtkTestUtilities.h>
+
+#include <sstream>
+#include <string>
+
+namespace
+{
+void MakeTable(vtkTable* table, vtkIdType numberOfRows)
+{
+  vtkNew<vtkDoubleArray> noise;
+  noise->SetName("noise");
+  vtkNew<vtkIntArray> counts;
+  counts->SetName("counts");
+  counts->SetNumberOfComponents(3);
+  vtkNew<vtkIdTypeArray> ids;
+  ids->SetName("ids");
+  vtkNew<vtkFloatArray> zeros;
+  zeros->SetName("zeros");
+  vtkNew<vtkStringArray> labels;
+  labels->SetName("labels");
+  unsigned int seed = 12345;
+  for (vtkIdType i = 0; i < numberOfRows; ++i)
+    {
+    // Random values do not compress and are stored raw.
+    seed = seed * 1103515245 + 12345;
+    noise->InsertNextValue(seed / 4294967296.0 + i);
+    for (int c = 0; c < 3; ++c)
+      {
+      counts->InsertNextValue(static_cast<int>(i % 1000) * (c + 1));
+      }
+    ids->InsertNextValue(i * 7);
+    zeros->InsertNextValue(i % 50000 == 0 ? 1.0f : 0.0f);
+    std::ostringstream label;
+    label << "row " << i << std::string(i % 5, '+');
+    labels->InsertNextValue(i % 11 == 0 ? std::string() : label.str());
+    }
+  table->AddColumn(noise.GetPointer());
+  table->AddColumn(counts.GetPointer());
+  table->AddColumn(ids.GetPointer());
+  table->AddColumn(zeros.GetPointer());
+  table->AddColumn(labels.GetPointer());
+}
+
+// Check that the column read holds the given rows of the column written.
+bool Compare(vtkAbstractArray* expected, vtkAbstractArray* actual,
+             vtkIdType firstRow, vtkIdType numberOfRows)
+{
+  if (!actual || strcmp(actual->GetClassName(),
+                        expected->GetClassName()) != 0 ||
+      actual->GetNumberOfComponents() != expected->GetNumberOfComponents() ||
+      actual->GetNumberOfTuples() != numberOfRows)
+    {
+    return false;
+    }
+  int numberOfComponents = expected->GetNumberOfComponents();
+  for (vtkIdType i = 0; i < numberOfRows * numberOfComponents; ++i)
+    {
+    if (expected->GetVariantValue(firstRow * numberOfComponents + i) !=
+        actual->GetVariantValue(i))
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
+// Read the given columns, or all of them, and compare them.
+bool Read(const std::string& fileName, vtkTable* expected,
+          const char* columns, vtkIdType firstRow, vtkIdType lastRow,
+          int mapping, int threads, int piece = 0, int numPieces = 1,
+          vtkTable* output = 0, int* numberOfMappedColumns = 0)
+{
+  vtkNew<vtkColumnarTableReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->SetRowRange(firstRow, lastRow);
+  reader->SetUseMemoryMapping(mapping);
+  reader->SetNumberOfDecompressionThreads(threads);
+  reader->UpdateInformation();
+  if (reader->GetTotalNumberOfRows() != expected->GetNumberOfRows() ||
+      reader->GetNumberOfColumnArrays() != expected->GetNumberOfColumns())
+    {
+    cerr << "Wrong directory in " << fileName << endl;
+    return false;
+    }
+  if (columns)
+    {
+    for (int c = 0; c < reader->GetNumberOfColumnArrays(); ++c)
+      {
+      const char* name = reader->GetColumnArrayName(c);
+      reader->SetColumnArrayStatus(name, strstr(columns, name) != 0);
+      }
+    }
+  vtkStreamingDemandDrivenPipeline::SetUpdateExtent(
+    reader->GetOutputInformation(0), piece, numPieces, 0);
+  reader->Update();
+
+  vtkTable* table = reader->GetOutput();
+  vtkIdType last = lastRow < 0 ? expected->GetNumberOfRows() - 1 : lastRow;
+  vtkIdType count = last - firstRow + 1;
+  vtkIdType begin = firstRow + count * piece / numPieces;
+  vtkIdType end = firstRow + count * (piece + 1) / numPieces;
+  int numberOfColumns = 0;
+  for (vtkIdType c = 0; c < expected->GetNumberOfColumns(); ++c)
+    {
+    vtkAbstractArray* column = expected->GetColumn(c);
+    if (columns && !strstr(columns, column->GetName()))
+      {
+      continue;
+      }
+    ++numberOfColumns;
+    if (!Compare(column, table->GetColumnByName(column->GetName()),
+                 begin, end - begin))
+      {
+      cerr << "Wrong column " << column->GetName() << " read from "
+           << fileName << " for rows " << begin << " to " << end
+           << " with mapping " << mapping << endl;
+      return false;
+      }
+    }
+  if (table->GetNumberOfColumns() != numberOfColumns)
+    {
+    cerr << "Read " << table->GetNumberOfColumns() << " columns instead of "
+         << numberOfColumns << endl;
+    return false;
+    }
+  if (output)
+    {
+    output->ShallowCopy(table);
+    }
+  if (numberOfMappedColumns)
+    {
+    *numberOfMappedColumns = reader->GetNumberOfMappedColumns();
+    }
+  return true;
+}
+}
+
+int TestColumnarTableReadWrite(int argc, char* argv[])
+{
+  char* tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  if (!tempDir)
+    {
+    cerr << "Could not determine temporary directory." << endl;
+    return EXIT_FAILURE;
+    }
+  std::string prefix = tempDir;
+  delete [] tempDir;
+  prefix += "/TestColumnarTableReadWrite";
+
+  const vtkIdType numberOfRows = 100003;
+  vtkNew<vtkTable> table;
+  MakeTable(table.GetPointer(), numberOfRows);
+
+  const char* names[3] = { "none", "zlib", "zstd" };
+  for (int compressor = 0; compressor < 3; ++compressor)
+    {
+    std::string fileName = prefix + "-" + names[compressor] + ".vtc";
+    vtkNew<vtkColumnarTableWriter> writer;
+    writer->SetInputData(table.GetPointer());
+    writer->SetFileName(fileName.c_str());
+    writer->SetCompressorType(compressor);
+    writer->SetNumberOfRowsPerBlock(4096);
+    writer->SetNumberOfCompressionThreads(compressor == 2 ? 1 : 0);
+    if (!writer->Write())
+      {
+      cerr << "Error writing " << fileName << endl;
+      return EXIT_FAILURE;
+      }
+
+    for (int mapping = 0; mapping < 2; ++mapping)
+      {
+      // All numeric columns of the uncompressed file are raw and mapped.
+      int numberOfMappedColumns = -1;
+      if (!Read(fileName, table.GetPointer(), 0, 0, -1, mapping, 0, 0, 1, 0,
+                &numberOfMappedColumns))
+        {
+        return EXIT_FAILURE;
+        }
+      if ((mapping == 0 && numberOfMappedColumns != 0) ||
+          (compressor == 0 && mapping && numberOfMappedColumns != 4))
+        {
+        cerr << numberOfMappedColumns << " columns mapped from " << fileName
+             << " with mapping " << mapping << endl;
+        return EXIT_FAILURE;
+        }
+      if (!Read(fileName, table.GetPointer(), 0, 0, -1, mapping, 1) ||
+          !Read(fileName, table.GetPointer(), 0, 0, -1, mapping, 1) ||
+          !Read(fileName, table.GetPointer(), "ids labels", 0, -1, mapping,
+                3) ||
+          !Read(fileName, table.GetPointer(), 0, 5000, 77777, mapping, 0) ||
+          !Read(fileName, table.GetPointer(), "noise zeros", 4096, 8191,
+                mapping, 2) ||
+          !Read(fileName, table.GetPointer(), 0, 123, 123, mapping, 0))
+        {
+        return EXIT_FAILURE;
+        }
+      for (int piece = 0; piece < 3; ++piece)
+        {
+        if (!Read(fileName, table.GetPointer(), 0, 17, -1, mapping, 0,
+                  piece, 3))
+          {
+          return EXIT_FAILURE;
+          }
+        }
+      }
+    }
+
+  // Mapped columns outlive the reader and can be modified without
+  // changing the file.
+  std::string fileName = prefix + "-none.vtc";
+  vtkNew<vtkTable> mapped;
+  int numberOfMappedColumns = 0;
+  if (!Read(fileName, table.GetPointer(), "noise", 10, 20000, 1, 0, 0, 1,
+            mapped.GetPointer(), &numberOfMappedColumns))
+    {
+    return EXIT_FAILURE;
+    }
+  if (numberOfMappedColumns != 1)
+    {
+    cerr << "The noise column was copied instead of mapped" << endl;
+    return EXIT_FAILURE;
+    }
+  vtkDoubleArray* noise =
+    vtkDoubleArray::SafeDownCast(mapped->GetColumnByName("noise"));
+  noise->SetValue(0, -1.0);
+  if (noise->GetValue(1) !=
+      table->GetColumn(0)->GetVariantValue(11).ToDouble() ||
+      !Read(fileName, table.GetPointer(), 0, 0, -1, 1, 0))
+    {
+    cerr << "Modifying a mapped column changed the file" << endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,178 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestDelimitedTextReaderChunks.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that chunked parsing reads the same table as the default mode,
+// whatever the chunk size, the number of threads and the number of pieces,
+// and that it reads windows of the records.
+
+#include <vtkAbstractArray.h>
+#include <vtkDelimitedTextReader.h>
+#include <vtkDoubleArray.h>
+#include <vtkIntArray.h>
+#include <vtkNew.h>
+#include <vtkSmartPointer.h>
+#include <vtkStreamingDemandDrivenPipeline.h>
+#include <vtkStringArray.h>
+#include <vtkTable.h>
+#include <vtkVariant.h>
+
+#include <sstream>
+#include <string>
+
+namespace
+{
+vtkSmartPointer<vtkTable> Read(const std::string& text, bool chunked,
+                               vtkIdType chunkSize, int threads,
+                               int piece = 0, int numberOfPieces = 1,
+                               vtkIdType offset = 0, vtkIdType max = 0)
+{
+  vtkNew<vtkDelimitedTextReader> reader;
+  reader->SetReadFromInputString(1);
+  reader->SetInputString(text);
+  reader->SetHaveHeaders(true);
+  reader->SetDetectNumericColumns(true);
+  reader->SetChunkedParsing(chunked);
+  reader->SetChunkSize(chunkSize);
+  reader->SetNumberOfParsingThreads(threads);
+  reader->SetNumberOfSampleRecords(100);
+  reader->SetRecordOffset(offset);
+  reader->SetMaxRecords(max);
+  reader->UpdateInformation();
+  vtkStreamingDemandDrivenPipeline::SetUpdateExtent(
+    reader->GetOutputInformation(0), piece, numberOfPieces, 0);
+  reader->Update();
+  return reader->GetOutput();
+}
+
+// Compare the rows of actual with those of expected from row first.
+bool Compare(vtkTable* actual, vtkTable* expected, vtkIdType first)
+{
+  if (actual->GetNumberOfColumns() != expected->GetNumberOfColumns())
+    {
+    cerr << "Wrong number of columns" << endl;
+    return false;
+    }
+  for (vtkIdType c = 0; c < expected->GetNumberOfColumns(); ++c)
+    {
+    vtkAbstractArray* a = actual->GetColumn(c);
+    vtkAbstractArray* e = expected->GetColumn(c);
+    if (strcmp(a->GetClassName(), e->GetClassName()) != 0 ||
+        strcmp(a->GetName(), e->GetName()) != 0)
+      {
+      cerr << "Column " << e->GetName() << " is a " << a->GetClassName()
+           << " named " << a->GetName() << endl;
+      return false;
+      }
+    }
+  for (vtkIdType r = 0; r < actual->GetNumberOfRows(); ++r)
+    {
+    for (vtkIdType c = 0; c < expected->GetNumberOfColumns(); ++c)
+      {
+      vtkVariant a = actual->GetValue(r, c);
+      vtkVariant e = expected->GetValue(first + r, c);
+      if (a.ToString() != e.ToString())
+        {
+        cerr << "Row " << first + r << " column " << c << " is "
+             << a.ToString() << " instead of " << e.ToString() << endl;
+        return false;
+        }
+      }
+    }
+  return true;
+}
+}
+
+int TestDelimitedTextReaderChunks(int, char*[])
+{
+  // Integers, integers that become reals after the sampled records,
+  // strings with delimiters in quotes, empty fields and blank lines.
+  std::ostringstream text;
+  text << "id,value,name,count\r\n";
+  for (int i = 0; i < 3000; ++i)
+    {
+    text << i << ",";
+    if (i < 500)
+      {
+      text << i * 3;
+      }
+    else
+      {
+      text << i * 0.25;
+      }
+    text << ",\"name, " << i << "\",";
+    if (i % 7)
+      {
+      text << " " << -i;
+      }
+    text << (i % 11 ? "\r\n" : "\n\n");
+    }
+
+  vtkSmartPointer<vtkTable> expected = Read(text.str(), false, 1024, 1);
+  if (expected->GetNumberOfRows() != 3000 ||
+      !vtkDoubleArray::SafeDownCast(expected->GetColumn(1)) ||
+      !vtkIntArray::SafeDownCast(expected->GetColumn(3)) ||
+      !vtkStringArray::SafeDownCast(expected->GetColumn(2)))
+    {
+    cerr << "Unexpected reference table" << endl;
+    return EXIT_FAILURE;
+    }
+
+  vtkIdType chunkSizes[2] = { 1024, 1 << 20 };
+  for (int s = 0; s < 2; ++s)
+    {
+    for (int threads = 0; threads <= 3; ++threads)
+      {
+      vtkSmartPointer<vtkTable> table =
+        Read(text.str(), true, chunkSizes[s], threads);
+      if (table->GetNumberOfRows() != 3000 ||
+          !Compare(table, expected, 0))
+        {
+        cerr << "Wrong table with chunks of " << chunkSizes[s] << " bytes and "
+             << threads << " threads" << endl;
+        return EXIT_FAILURE;
+        }
+      }
+    }
+
+  // The pieces hold all the records once, in order.
+  vtkIdType row = 0;
+  for (int piece = 0; piece < 5; ++piece)
+    {
+    vtkSmartPointer<vtkTable> table =
+      Read(text.str(), true, 1024, 0, piece, 5);
+    if (!Compare(table, expected, row))
+      {
+      cerr << "Wrong piece " << piece << endl;
+      return EXIT_FAILURE;
+      }
+    row += table->GetNumberOfRows();
+    }
+  if (row != 3000)
+    {
+    cerr << "The pieces hold " << row << " records" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // A window of the records.
+  vtkSmartPointer<vtkTable> window =
+    Read(text.str(), true, 1024, 2, 0, 1, 1234, 100);
+  if (window->GetNumberOfRows() != 100 ||
+      !Compare(window, expected, 1234))
+    {
+    cerr << "Wrong window of records" << endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
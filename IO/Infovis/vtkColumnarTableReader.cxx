@@ -0,0 +1,841 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkColumnarTableReader.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkColumnarTableReader.h"
+
+#include "vtkByteSwap.h"
+#include "vtkCallbackCommand.h"
+#include "vtkCriticalSection.h"
+#include "vtkDataArray.h"
+#include "vtkDataArraySelection.h"
+#include "vtkDataArrayTemplate.h"
+#include "vtkDataCompressor.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkInstantiator.h"
+#include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkStringArray.h"
+#include "vtkTable.h"
+#include "vtkZLibDataCompressor.h"
+#include "vtkZstdDataCompressor.h"
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32) && !defined(__CYGWIN__)
+# include <windows.h>
+#else
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif
+
+vtkStandardNewMacro(vtkColumnarTableReader);
+
+//----------------------------------------------------------------------------
+// The directory of the file and its memory mapping, if any.
+class vtkColumnarTableReaderInternals
+{
+public:
+  struct Column
+  {
+    std::string Name;
+    int DataType;
+    int ElementSize;
+    int NumberOfComponents;
+    std::vector<vtkTypeUInt64> Offsets;
+    std::vector<vtkTypeUInt64> StoredSizes;
+    std::vector<vtkTypeUInt64> Sizes;
+  };
+
+  std::vector<Column> Columns;
+  vtkTypeUInt64 NumberOfRowsPerBlock;
+  vtkTypeUInt64 FileLength;
+  bool SwapBytes;
+  const char* MappedData;
+};
+
+namespace
+{
+//----------------------------------------------------------------------------
+// Mappings are reference counted in a global registry indexed by their
+// address so that the columns pointing into them can release them
+// without knowing the reader or the mapping size.
+struct vtkColumnarTableReaderMapping
+{
+  vtkTypeUInt64 Length;
+  int References;
+};
+
+typedef std::map<const char*, vtkColumnarTableReaderMapping>
+  vtkColumnarTableReaderMappingRegistry;
+
+vtkSimpleCriticalSection vtkColumnarTableReaderMappingLock;
+
+vtkColumnarTableReaderMappingRegistry& vtkColumnarTableReaderGetMappings()
+{
+  static vtkColumnarTableReaderMappingRegistry mappings;
+  return mappings;
+}
+
+// Map a whole file copy-on-write so that the columns pointing into it may
+// be modified without changing the file.
+const char* vtkColumnarTableReaderMapFile(const char* fileName)
+{
+  void* data = 0;
+  vtkTypeUInt64 length = 0;
+#if defined(_WIN32) && !defined(__CYGWIN__)
+  HANDLE file = CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ, NULL,
+                            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+  if (file == INVALID_HANDLE_VALUE)
+    {
+    return 0;
+    }
+  LARGE_INTEGER size;
+  if (GetFileSizeEx(file, &size) && size.QuadPart > 0)
+    {
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_WRITECOPY, 0, 0,
+                                        NULL);
+    if (mapping)
+      {
+      data = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+      CloseHandle(mapping);
+      }
+    length = static_cast<vtkTypeUInt64>(size.QuadPart);
+    }
+  CloseHandle(file);
+#else
+  int fd = open(fileName, O_RDONLY);
+  if (fd < 0)
+    {
+    return 0;
+    }
+  struct stat st;
+  if (fstat(fd, &st) == 0 && st.st_size > 0)
+    {
+    data = mmap(0, static_cast<size_t>(st.st_size), PROT_READ|PROT_WRITE,
+                MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED)
+      {
+      data = 0;
+      }
+    length = static_cast<vtkTypeUInt64>(st.st_size);
+    }
+  close(fd);
+#endif
+  if (data)
+    {
+    vtkColumnarTableReaderMappingLock.Lock();
+    vtkColumnarTableReaderMapping& mapping =
+      vtkColumnarTableReaderGetMappings()[static_cast<const char*>(data)];
+    mapping.Length = length;
+    mapping.References = 1;
+    vtkColumnarTableReaderMappingLock.Unlock();
+    }
+  return static_cast<const char*>(data);
+}
+
+// Add one reference to the mapping starting at the given address.
+void vtkColumnarTableReaderRetainMapping(const char* data)
+{
+  vtkColumnarTableReaderMappingLock.Lock();
+  ++vtkColumnarTableReaderGetMappings()[data].References;
+  vtkColumnarTableReaderMappingLock.Unlock();
+}
+
+// Drop one reference to the mapping containing the given address.
+void vtkColumnarTableReaderReleaseMapping(void* address)
+{
+  const char* p = static_cast<const char*>(address);
+  const char* data = 0;
+  vtkTypeUInt64 length = 0;
+  vtkColumnarTableReaderMappingLock.Lock();
+  vtkColumnarTableReaderMappingRegistry& mappings =
+    vtkColumnarTableReaderGetMappings();
+  vtkColumnarTableReaderMappingRegistry::iterator i = mappings.upper_bound(p);
+  if (i != mappings.begin())
+    {
+    --i;
+    if (p < i->first + i->second.Length && --i->second.References == 0)
+      {
+      data = i->first;
+      length = i->second.Length;
+      mappings.erase(i);
+      }
+    }
+  vtkColumnarTableReaderMappingLock.Unlock();
+  if (data)
+    {
+#if defined(_WIN32) && !defined(__CYGWIN__)
+    (void)length;
+    UnmapViewOfFile(data);
+#else
+    munmap(const_cast<char*>(data), static_cast<size_t>(length));
+#endif
+    }
+}
+
+// Make an array point to values inside the mapped file.
+template <class T>
+void vtkColumnarTableReaderMapArray(vtkDataArrayTemplate<T>* array,
+                                    const char* mappedData,
+                                    const char* values, vtkIdType numValues)
+{
+  vtkColumnarTableReaderRetainMapping(mappedData);
+  array->SetArray(reinterpret_cast<T*>(const_cast<char*>(values)),
+                  numValues, 0,
+                  vtkDataArrayTemplate<T>::VTK_DATA_ARRAY_USER_DEFINED);
+  array->SetArrayFreeFunction(vtkColumnarTableReaderReleaseMapping);
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+bool vtkColumnarTableReaderGet(istream& is, T& value, bool swap)
+{
+  is.read(reinterpret_cast<char*>(&value), sizeof(T));
+  if (swap)
+    {
+    vtkByteSwap::SwapVoidRange(&value, 1, sizeof(T));
+    }
+  return !is.fail();
+}
+
+bool vtkColumnarTableReaderGetString(istream& is, std::string& value,
+                                     bool swap)
+{
+  vtkTypeUInt32 length = 0;
+  if (!vtkColumnarTableReaderGet(is, length, swap) || length > (1 << 24))
+    {
+    return false;
+    }
+  value.resize(length);
+  if (length > 0)
+    {
+    is.read(&value[0], length);
+    }
+  return !is.fail();
+}
+
+//----------------------------------------------------------------------------
+// Decompress the blocks holding the requested rows of a column.  Numeric
+// blocks are decoded straight into the array, the others into their own
+// buffers.
+struct vtkColumnarTableReaderDecodeBlocks
+{
+  const vtkColumnarTableReaderInternals::Column* Column;
+  vtkDataCompressor* Compressor;
+  const unsigned char* Data;
+  vtkTypeUInt64 DataOffset;
+  vtkIdType FirstBlock;
+  vtkIdType FirstRow;
+  vtkIdType EndRow;
+  vtkIdType RowsPerBlock;
+  size_t RowSize;
+  bool SwapBytes;
+  unsigned char* Output;
+  std::vector<unsigned char>* Buffers;
+  char* Failed;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    std::vector<unsigned char> buffer;
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      vtkIdType b = this->FirstBlock + i;
+      const unsigned char* stored =
+        this->Data + (this->Column->Offsets[b] - this->DataOffset);
+      size_t storedSize = static_cast<size_t>(this->Column->StoredSizes[b]);
+      size_t size = static_cast<size_t>(this->Column->Sizes[b]);
+
+      if (!this->Output)
+        {
+        this->Buffers[i].resize(size);
+        this->Failed[i] = !this->Decode(stored, storedSize,
+                                        &this->Buffers[i][0], size);
+        continue;
+        }
+
+      // The rows of this block that are requested.
+      vtkIdType blockRow = b * this->RowsPerBlock;
+      vtkIdType first = std::max(this->FirstRow, blockRow);
+      vtkIdType last = std::min(this->EndRow, blockRow + this->RowsPerBlock);
+      unsigned char* output = this->Output + (first - this->FirstRow) *
+        this->RowSize;
+      size_t skip = (first - blockRow) * this->RowSize;
+      size_t length = (last - first) * this->RowSize;
+      if (skip + length > size)
+        {
+        this->Failed[i] = 1;
+        continue;
+        }
+      if (storedSize == size)
+        {
+        memcpy(output, stored + skip, length);
+        }
+      else if (skip == 0 && length == size)
+        {
+        this->Failed[i] = !this->Decode(stored, storedSize, output, size);
+        }
+      else
+        {
+        buffer.resize(size);
+        this->Failed[i] = !this->Decode(stored, storedSize, &buffer[0], size);
+        memcpy(output, &buffer[0] + skip, length);
+        }
+      if (this->SwapBytes)
+        {
+        vtkByteSwap::SwapVoidRange(output,
+          static_cast<int>(length / this->Column->ElementSize),
+          this->Column->ElementSize);
+        }
+      }
+  }
+
+  bool Decode(const unsigned char* stored, size_t storedSize,
+              unsigned char* output, size_t size) const
+  {
+    if (storedSize == size)
+      {
+      if (size > 0)
+        {
+        memcpy(output, stored, size);
+        }
+      return true;
+      }
+    return this->Compressor &&
+      this->Compressor->Uncompress(stored, storedSize, output, size) == size;
+  }
+};
+}
+
+//----------------------------------------------------------------------------
+vtkColumnarTableReader::vtkColumnarTableReader()
+{
+  this->SetNumberOfInputPorts(0);
+  this->FileName = 0;
+  this->RowRange[0] = 0;
+  this->RowRange[1] = -1;
+  this->TotalNumberOfRows = 0;
+  this->UseMemoryMapping = 0;
+  this->NumberOfDecompressionThreads = 1;
+  this->NumberOfMappedColumns = 0;
+  this->Compressor = 0;
+  this->Internals = new vtkColumnarTableReaderInternals;
+  this->Internals->NumberOfRowsPerBlock = 1;
+  this->Internals->FileLength = 0;
+  this->Internals->SwapBytes = false;
+  this->Internals->MappedData = 0;
+
+  this->ColumnArraySelection = vtkDataArraySelection::New();
+  this->SelectionObserver = vtkCallbackCommand::New();
+  this->SelectionObserver->SetCallback(
+    &vtkColumnarTableReader::SelectionModifiedCallback);
+  this->SelectionObserver->SetClientData(this);
+  this->ColumnArraySelection->AddObserver(vtkCommand::ModifiedEvent,
+                                          this->SelectionObserver);
+}
+
+//----------------------------------------------------------------------------
+vtkColumnarTableReader::~vtkColumnarTableReader()
+{
+  this->SetFileName(0);
+  this->ColumnArraySelection->RemoveObserver(this->SelectionObserver);
+  this->SelectionObserver->Delete();
+  this->ColumnArraySelection->Delete();
+  if (this->Compressor)
+    {
+    this->Compressor->Delete();
+    }
+  delete this->Internals;
+}
+
+//----------------------------------------------------------------------------
+void vtkColumnarTableReader::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "FileName: "
+     << (this->FileName ? this->FileName : "(none)") << endl;
+  os << indent << "ColumnArraySelection: " << this->ColumnArraySelection
+     << endl;
+  os << indent << "RowRange: " << this->RowRange[0] << " "
+     << this->RowRange[1] << endl;
+  os << indent << "TotalNumberOfRows: " << this->TotalNumberOfRows << endl;
+  os << indent << "UseMemoryMapping: " << this->UseMemoryMapping << endl;
+  os << indent << "NumberOfDecompressionThreads: "
+     << this->NumberOfDecompressionThreads << endl;
+  os << indent << "NumberOfMappedColumns: " << this->NumberOfMappedColumns
+     << endl;
+}
+
+//----------------------------------------------------------------------------
+int vtkColumnarTableReader::GetNumberOfColumnArrays()
+{
+  return this->ColumnArraySelection->GetNumberOfArrays();
+}
+
+//----------------------------------------------------------------------------
+const char* vtkColumnarTableReader::GetColumnArrayName(int index)
+{
+  return this->ColumnArraySelection->GetArrayName(index);
+}
+
+//----------------------------------------------------------------------------
+int vtkColumnarTableReader::GetColumnArrayStatus(const char* name)
+{
+  return this->ColumnArraySelection->ArrayIsEnabled(name);
+}
+
+//----------------------------------------------------------------------------
+void vtkColumnarTableReader::SetColumnArrayStatus(const char* name,
+                                                  int status)
+{
+  if (status)
+    {
+    this->ColumnArraySelection->EnableArray(name);
+    }
+  else
+    {
+    this->ColumnArraySelection->DisableArray(name);
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkColumnarTableReader::SelectionModifiedCallback(vtkObject*,
+                                                       unsigned long,
+                                                       void* clientdata,
+                                                       void*)
+{
+  static_cast<vtkColumnarTableReader*>(clientdata)->Modified();
+}
+
+//----------------------------------------------------------------------------
+int vtkColumnarTableReader::SetupCompressor(const char* type)
+{
+  if (this->Compressor)
+    {
+    this->Compressor->Delete();
+    this->Compressor = 0;
+    }
+  if (!type || !*type)
+    {
+    return 1;
+    }
+
+  vtkObject* object = vtkInstantiator::CreateInstance(type);
+  vtkDataCompressor* compressor = vtkDataCompressor::SafeDownCast(object);
+
+  // In static builds, the compressors provided by VTK may not have been
+  // registered with the vtkInstantiator.  Check for them here.
+  if (!compressor && (strcmp(type, "vtkZLibDataCompressor") == 0))
+    {
+    compressor = vtkZLibDataCompressor::New();
+    }
+  else if (!compressor && (strcmp(type, "vtkZstdDataCompressor") == 0))
+    {
+    compressor = vtkZstdDataCompressor::New();
+    }
+
+  if (!compressor)
+    {
+    vtkErrorMacro("Error creating " << type);
+    if (object)
+      {
+      object->Delete();
+      }
+    return 0;
+    }
+  this->Compressor = compressor;
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkColumnarTableReader::ReadDirectory()
+{
+  vtkColumnarTableReaderInternals* internals = this->Internals;
+  internals->Columns.clear();
+  this->TotalNumberOfRows = 0;
+  if (!this->FileName)
+    {
+    vtkErrorMacro("No FileName specified.");
+    return 0;
+    }
+  ifstream is(this->FileName, ios::in | ios::binary);
+  if (!is)
+    {
+    vtkErrorMacro("Unable to open file: " << this->FileName);
+    return 0;
+    }
+  is.seekg(0, ios::end);
+  internals->FileLength = static_cast<vtkTypeUInt64>(is.tellg());
+  is.seekg(0, ios::beg);
+
+  char magic[8];
+  vtkTypeUInt32 byteOrderMark = 0;
+  is.read(magic, 8);
+  if (is.fail() || strncmp(magic, "vtkCTab1", 8) != 0 ||
+      !vtkColumnarTableReaderGet(is, byteOrderMark, false) ||
+      (byteOrderMark != 0x01020304 && byteOrderMark != 0x04030201))
+    {
+    vtkErrorMacro(<< this->FileName << " is not a columnar table file.");
+    return 0;
+    }
+  bool swap = internals->SwapBytes = (byteOrderMark != 0x01020304);
+
+  vtkTypeUInt64 directoryOffset = 0;
+  vtkTypeUInt64 numberOfRows = 0;
+  vtkTypeUInt32 rowsPerBlock = 0;
+  vtkTypeUInt32 numberOfColumns = 0;
+  std::string compressorName;
+  if (!vtkColumnarTableReaderGet(is, directoryOffset, swap) ||
+      directoryOffset >= internals->FileLength ||
+      !is.seekg(static_cast<std::streamoff>(directoryOffset)) ||
+      !vtkColumnarTableReaderGet(is, numberOfRows, swap) ||
+      !vtkColumnarTableReaderGet(is, rowsPerBlock, swap) ||
+      !vtkColumnarTableReaderGet(is, numberOfColumns, swap) ||
+      !vtkColumnarTableReaderGetString(is, compressorName, swap) ||
+      rowsPerBlock == 0)
+    {
+    vtkErrorMacro("Error reading the directory of " << this->FileName);
+    return 0;
+    }
+  internals->NumberOfRowsPerBlock = rowsPerBlock;
+
+  vtkTypeUInt64 numberOfBlocks =
+    (numberOfRows + rowsPerBlock - 1) / rowsPerBlock;
+  internals->Columns.resize(numberOfColumns);
+  for (vtkTypeUInt32 c = 0; c < numberOfColumns; ++c)
+    {
+    vtkColumnarTableReaderInternals::Column& column = internals->Columns[c];
+    vtkTypeInt32 dataType = 0;
+    vtkTypeInt32 elementSize = 0;
+    vtkTypeInt32 numberOfComponents = 0;
+    bool ok = vtkColumnarTableReaderGetString(is, column.Name, swap) &&
+      vtkColumnarTableReaderGet(is, dataType, swap) &&
+      vtkColumnarTableReaderGet(is, elementSize, swap) &&
+      vtkColumnarTableReaderGet(is, numberOfComponents, swap) &&
+      numberOfComponents > 0;
+    column.DataType = dataType;
+    column.ElementSize = elementSize;
+    column.NumberOfComponents = numberOfComponents;
+    column.Offsets.resize(ok ? numberOfBlocks : 0);
+    column.StoredSizes.resize(ok ? numberOfBlocks : 0);
+    column.Sizes.resize(ok ? numberOfBlocks : 0);
+    for (vtkTypeUInt64 b = 0; ok && b < numberOfBlocks; ++b)
+      {
+      ok = vtkColumnarTableReaderGet(is, column.Offsets[b], swap) &&
+        vtkColumnarTableReaderGet(is, column.StoredSizes[b], swap) &&
+        vtkColumnarTableReaderGet(is, column.Sizes[b], swap) &&
+        column.Offsets[b] + column.StoredSizes[b] <= directoryOffset;
+      }
+    if (!ok)
+      {
+      vtkErrorMacro("Error reading the directory of " << this->FileName);
+      internals->Columns.clear();
+      return 0;
+      }
+    }
+
+  if (!this->SetupCompressor(compressorName.c_str()))
+    {
+    internals->Columns.clear();
+    return 0;
+    }
+  this->TotalNumberOfRows = static_cast<vtkIdType>(numberOfRows);
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkColumnarTableReader::RequestInformation(
+  vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector)
+{
+  if (!this->ReadDirectory())
+    {
+    return 0;
+    }
+
+  std::vector<const char*> names;
+  for (size_t c = 0; c < this->Internals->Columns.size(); ++c)
+    {
+    names.push_back(this->Internals->Columns[c].Name.c_str());
+    }
+  this->ColumnArraySelection->SetArraysWithDefault(
+    names.empty() ? 0 : &names[0], static_cast<int>(names.size()), 1);
+
+  outputVector->GetInformationObject(0)->Set(
+    vtkAlgorithm::CAN_HANDLE_PIECE_REQUEST(), 1);
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkColumnarTableReader::RequestData(
+  vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector)
+{
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+  vtkTable* output = vtkTable::GetData(outInfo);
+  vtkColumnarTableReaderInternals* internals = this->Internals;
+  if (internals->Columns.empty() && !this->ReadDirectory())
+    {
+    return 0;
+    }
+
+  // The rows of the requested piece.
+  vtkIdType total = this->TotalNumberOfRows;
+  vtkIdType first = std::min(std::max(this->RowRange[0],
+                                      static_cast<vtkIdType>(0)), total);
+  vtkIdType last = this->RowRange[1];
+  if (last < 0 || last >= total)
+    {
+    last = total - 1;
+    }
+  vtkIdType count = std::max(last - first + 1, static_cast<vtkIdType>(0));
+  int piece = 0;
+  int numPieces = 1;
+  if (outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER()) &&
+      outInfo->Has(
+        vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES()))
+    {
+    piece = outInfo->Get(
+      vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER());
+    numPieces = outInfo->Get(
+      vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES());
+    }
+  if (numPieces < 1 || piece < 0 || piece >= numPieces)
+    {
+    piece = 0;
+    numPieces = 1;
+    }
+  vtkIdType begin = first + count * piece / numPieces;
+  vtkIdType end = first + count * (piece + 1) / numPieces;
+
+  ifstream is(this->FileName, ios::in | ios::binary);
+  if (!is)
+    {
+    vtkErrorMacro("Unable to open file: " << this->FileName);
+    return 0;
+    }
+  internals->MappedData = 0;
+  this->NumberOfMappedColumns = 0;
+  if (this->UseMemoryMapping)
+    {
+    internals->MappedData = vtkColumnarTableReaderMapFile(this->FileName);
+    }
+
+  int result = 1;
+  size_t numberOfColumns = internals->Columns.size();
+  for (size_t c = 0; result && c < numberOfColumns; ++c)
+    {
+    const char* name = internals->Columns[c].Name.c_str();
+    if (!this->ColumnArraySelection->ArrayIsEnabled(name))
+      {
+      continue;
+      }
+    vtkAbstractArray* column =
+      this->ReadColumn(is, static_cast<int>(c), begin, end - begin);
+    if (!column)
+      {
+      result = 0;
+      break;
+      }
+    output->AddColumn(column);
+    column->Delete();
+    this->UpdateProgress(static_cast<double>(c + 1) / numberOfColumns);
+    }
+
+  // The mapped columns keep their own references to the mapping.
+  if (internals->MappedData)
+    {
+    vtkColumnarTableReaderReleaseMapping(
+      const_cast<char*>(internals->MappedData));
+    internals->MappedData = 0;
+    }
+  return result;
+}
+
+//----------------------------------------------------------------------------
+vtkAbstractArray* vtkColumnarTableReader::ReadColumn(istream& is, int index,
+                                                     vtkIdType firstRow,
+                                                     vtkIdType numberOfRows)
+{
+  vtkColumnarTableReaderInternals* internals = this->Internals;
+  const vtkColumnarTableReaderInternals::Column& column =
+    internals->Columns[index];
+  vtkAbstractArray* array = vtkAbstractArray::CreateArray(column.DataType);
+  vtkDataArray* dataArray = vtkDataArray::SafeDownCast(array);
+  vtkStringArray* stringArray = vtkStringArray::SafeDownCast(array);
+  if ((!dataArray && !stringArray) || column.DataType == VTK_BIT ||
+      (dataArray && column.ElementSize != dataArray->GetDataTypeSize()))
+    {
+    vtkErrorMacro("Cannot read column " << column.Name << " of type "
+                  << column.DataType << " and size " << column.ElementSize);
+    if (array)
+      {
+      array->Delete();
+      }
+    return 0;
+    }
+  array->SetName(column.Name.c_str());
+  array->SetNumberOfComponents(column.NumberOfComponents);
+  if (numberOfRows <= 0)
+    {
+    return array;
+    }
+
+  vtkIdType rowsPerBlock =
+    static_cast<vtkIdType>(internals->NumberOfRowsPerBlock);
+  vtkIdType firstBlock = firstRow / rowsPerBlock;
+  vtkIdType lastBlock = (firstRow + numberOfRows - 1) / rowsPerBlock;
+  vtkIdType numberOfBlocks = lastBlock - firstBlock + 1;
+  size_t rowSize = static_cast<size_t>(column.ElementSize) *
+    column.NumberOfComponents;
+
+  // Use raw numeric blocks in place when they are contiguous in the
+  // mapped file.
+  if (internals->MappedData && dataArray && !internals->SwapBytes &&
+      array->GetArrayType() == vtkAbstractArray::DataArrayTemplate)
+    {
+    bool contiguous = true;
+    for (vtkIdType b = firstBlock; contiguous && b <= lastBlock; ++b)
+      {
+      contiguous = column.StoredSizes[b] == column.Sizes[b] &&
+        (b == lastBlock ||
+         column.Offsets[b + 1] == column.Offsets[b] + column.Sizes[b]);
+      }
+    if (contiguous)
+      {
+      const char* values = internals->MappedData + column.Offsets[firstBlock] +
+        (firstRow - firstBlock * rowsPerBlock) * rowSize;
+      vtkIdType numValues = numberOfRows * column.NumberOfComponents;
+      switch (column.DataType)
+        {
+        vtkTemplateMacro(
+          vtkColumnarTableReaderMapArray(
+            static_cast<vtkDataArrayTemplate<VTK_TT>*>(dataArray),
+            internals->MappedData, values, numValues));
+        }
+      ++this->NumberOfMappedColumns;
+      return array;
+      }
+    }
+
+  // Read the stored blocks at once, unless the file is mapped.
+  vtkTypeUInt64 dataOffset = column.Offsets[firstBlock];
+  vtkTypeUInt64 dataEnd =
+    column.Offsets[lastBlock] + column.StoredSizes[lastBlock];
+  std::vector<unsigned char> storedData;
+  const unsigned char* data =
+    reinterpret_cast<const unsigned char*>(internals->MappedData);
+  if (data)
+    {
+    data += dataOffset;
+    }
+  else
+    {
+    storedData.resize(static_cast<size_t>(dataEnd - dataOffset) + 1);
+    is.seekg(static_cast<std::streamoff>(dataOffset));
+    is.read(reinterpret_cast<char*>(&storedData[0]),
+            static_cast<std::streamsize>(dataEnd - dataOffset));
+    if (is.fail())
+      {
+      vtkErrorMacro("Error reading column " << column.Name);
+      array->Delete();
+      return 0;
+      }
+    data = &storedData[0];
+    }
+
+  // Decompress the blocks concurrently.
+  array->SetNumberOfTuples(numberOfRows);
+  std::vector<std::vector<unsigned char> > buffers(dataArray ? 0 :
+                                                   numberOfBlocks);
+  std::vector<char> failed(numberOfBlocks, 0);
+  vtkColumnarTableReaderDecodeBlocks functor;
+  functor.Column = &column;
+  functor.Compressor = this->Compressor;
+  functor.Data = data;
+  functor.DataOffset = dataOffset;
+  functor.FirstBlock = firstBlock;
+  functor.FirstRow = firstRow;
+  functor.EndRow = firstRow + numberOfRows;
+  functor.RowsPerBlock = rowsPerBlock;
+  functor.RowSize = rowSize;
+  functor.SwapBytes = internals->SwapBytes;
+  functor.Output = dataArray ?
+    static_cast<unsigned char*>(dataArray->GetVoidPointer(0)) : 0;
+  functor.Buffers = buffers.empty() ? 0 : &buffers[0];
+  functor.Failed = &failed[0];
+  if (this->NumberOfDecompressionThreads == 1)
+    {
+    functor(0, numberOfBlocks);
+    }
+  else
+    {
+    vtkIdType grain = 1;
+    if (this->NumberOfDecompressionThreads > 0)
+      {
+      grain = (numberOfBlocks + this->NumberOfDecompressionThreads - 1) /
+        this->NumberOfDecompressionThreads;
+      }
+    vtkSMPTools::For(0, numberOfBlocks, grain, functor);
+    }
+  if (std::find(failed.begin(), failed.end(), 1) != failed.end())
+    {
+    vtkErrorMacro("Error decompressing column " << column.Name);
+    array->Delete();
+    return 0;
+    }
+  if (dataArray)
+    {
+    return array;
+    }
+
+  // Strings are stored as their length followed by their characters.
+  vtkIdType firstValue = firstRow * column.NumberOfComponents;
+  vtkIdType endValue = firstValue + numberOfRows * column.NumberOfComponents;
+  for (vtkIdType i = 0; i < numberOfBlocks; ++i)
+    {
+    const std::vector<unsigned char>& buffer = buffers[i];
+    vtkIdType v = (firstBlock + i) * rowsPerBlock * column.NumberOfComponents;
+    size_t position = 0;
+    while (position + sizeof(vtkTypeUInt32) <= buffer.size() &&
+           v < endValue)
+      {
+      vtkTypeUInt32 length;
+      memcpy(&length, &buffer[position], sizeof(length));
+      if (internals->SwapBytes)
+        {
+        vtkByteSwap::SwapVoidRange(&length, 1, sizeof(length));
+        }
+      position += sizeof(length);
+      if (position + length > buffer.size())
+        {
+        vtkErrorMacro("Error reading column " << column.Name);
+        array->Delete();
+        return 0;
+        }
+      if (v >= firstValue)
+        {
+        stringArray->SetValue(v - firstValue, vtkStdString(
+          reinterpret_cast<const char*>(&buffer[0]) + position, length));
+        }
+      position += length;
+      ++v;
+      }
+    }
+  return array;
+}
@@ -0,0 +1,142 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkColumnarTableReader.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkColumnarTableReader - read a vtkTable written by vtkColumnarTableWriter.
+// .SECTION Description
+// vtkColumnarTableReader reads the columnar binary files written by
+// vtkColumnarTableWriter.  Only the columns enabled in the column array
+// selection and the rows in RowRange are read: the reader seeks to the
+// blocks holding them and never reads the others.  When pieces are
+// requested, the rows are split evenly among them.
+//
+// The blocks of a column are read at once and decompressed concurrently.
+// When UseMemoryMapping is on, numeric columns stored raw in the byte
+// order of this machine point directly into the memory mapped file
+// instead of being read, so their pages are only loaded when accessed.
+// .SECTION See Also
+// vtkColumnarTableWriter vtkDelimitedTextReader
+
+#ifndef __vtkColumnarTableReader_h
+#define __vtkColumnarTableReader_h
+
+#include "vtkIOInfovisModule.h" // For export macro
+#include "vtkTableAlgorithm.h"
+
+class vtkCallbackCommand;
+class vtkDataArraySelection;
+class vtkDataCompressor;
+class vtkColumnarTableReaderInternals;
+
+class VTKIOINFOVIS_EXPORT vtkColumnarTableReader : public vtkTableAlgorithm
+{
+public:
+  static vtkColumnarTableReader* New();
+  vtkTypeMacro(vtkColumnarTableReader, vtkTableAlgorithm);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Get/Set the name of the file to read.
+  vtkSetStringMacro(FileName);
+  vtkGetStringMacro(FileName);
+
+  // Description:
+  // Get the selection of the columns to read.  The columns of the file
+  // are added to it, enabled, by UpdateInformation().
+  vtkGetObjectMacro(ColumnArraySelection, vtkDataArraySelection);
+
+  // Description:
+  // Get the number and names of the columns in the file, and get/set
+  // whether each column is read.
+  int GetNumberOfColumnArrays();
+  const char* GetColumnArrayName(int index);
+  int GetColumnArrayStatus(const char* name);
+  void SetColumnArrayStatus(const char* name, int status);
+
+  // Description:
+  // Get/Set the first and last rows to read.  A last row of -1, the
+  // default, or past the end of the file reads up to the last row.
+  vtkSetVector2Macro(RowRange, vtkIdType);
+  vtkGetVector2Macro(RowRange, vtkIdType);
+
+  // Description:
+  // Get the number of rows in the file, available after
+  // UpdateInformation().
+  vtkGetMacro(TotalNumberOfRows, vtkIdType);
+
+  // Description:
+  // Get/Set whether the file is memory mapped.  Numeric columns stored
+  // raw in the byte order of this machine then point directly into the
+  // mapped file instead of being read.  Modifying such a column does not
+  // change the file.  The file stays mapped for as long as such columns
+  // exist, and truncating or rewriting it meanwhile makes the next access
+  // to a page not yet read raise SIGBUS on POSIX systems, as with
+  // vtkXMLDataParser::MapFile().  Off by default.
+  vtkSetMacro(UseMemoryMapping, int);
+  vtkGetMacro(UseMemoryMapping, int);
+  vtkBooleanMacro(UseMemoryMapping, int);
+
+  // Description:
+  // Get the number of columns of the last output that point into the
+  // mapped file rather than holding a copy of their values.
+  vtkGetMacro(NumberOfMappedColumns, int);
+
+  // Description:
+  // Get/Set how many batches the blocks of a column are split into to be
+  // decompressed concurrently.  As with
+  // vtkXMLWriter::SetNumberOfCompressionThreads, this is a vtkSMPTools
+  // grain, not a number of threads.  Default is 1, serial.
+  vtkSetClampMacro(NumberOfDecompressionThreads, int, 0, VTK_INT_MAX);
+  vtkGetMacro(NumberOfDecompressionThreads, int);
+
+protected:
+  vtkColumnarTableReader();
+  ~vtkColumnarTableReader();
+
+  int RequestInformation(vtkInformation*, vtkInformationVector**,
+                         vtkInformationVector*);
+  int RequestData(vtkInformation*, vtkInformationVector**,
+                  vtkInformationVector*);
+
+  // Read the header and the directory of the file.  Returns 0 on error.
+  int ReadDirectory();
+
+  // Create the compressor named in the directory, if any.
+  int SetupCompressor(const char* type);
+
+  // Read the given rows of a column.  Returns NULL on error.
+  vtkAbstractArray* ReadColumn(istream& is, int index,
+                               vtkIdType firstRow, vtkIdType numberOfRows);
+
+  // Callback registered with the column array selection.
+  static void SelectionModifiedCallback(vtkObject* caller, unsigned long eid,
+                                        void* clientdata, void* calldata);
+
+  char* FileName;
+  vtkDataArraySelection* ColumnArraySelection;
+  vtkCallbackCommand* SelectionObserver;
+  vtkIdType RowRange[2];
+  vtkIdType TotalNumberOfRows;
+  int UseMemoryMapping;
+  int NumberOfDecompressionThreads;
+  int NumberOfMappedColumns;
+  vtkDataCompressor* Compressor;
+
+  vtkColumnarTableReaderInternals* Internals;
+
+private:
+  vtkColumnarTableReader(const vtkColumnarTableReader&); // Not implemented.
+  void operator=(const vtkColumnarTableReader&); // Not implemented.
+};
+
+#endif
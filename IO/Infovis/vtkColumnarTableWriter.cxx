@@ -0,0 +1,391 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkColumnarTableWriter.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkColumnarTableWriter.h"
+
+#include "vtkDataArray.h"
+#include "vtkDataCompressor.h"
+#include "vtkErrorCode.h"
+#include "vtkInformation.h"
+#include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
+#include "vtkStringArray.h"
+#include "vtkTable.h"
+#include "vtkZLibDataCompressor.h"
+#include "vtkZstdDataCompressor.h"
+
+#include <vtksys/ios/sstream>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+vtkStandardNewMacro(vtkColumnarTableWriter);
+vtkCxxSetObjectMacro(vtkColumnarTableWriter, Compressor, vtkDataCompressor);
+
+namespace
+{
+// The number of blocks of a column compressed together.
+const vtkIdType vtkColumnarTableWriterBlocksPerBatch = 32;
+
+template <class T>
+void vtkColumnarTableWriterPut(ostream& os, T value)
+{
+  os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void vtkColumnarTableWriterPutString(ostream& os, const char* value)
+{
+  std::string s = value ? value : "";
+  vtkColumnarTableWriterPut(os, static_cast<vtkTypeUInt32>(s.size()));
+  os.write(s.c_str(), static_cast<std::streamsize>(s.size()));
+}
+
+// Compress a batch of blocks into their own buffers.
+struct vtkColumnarTableWriterCompressBlocks
+{
+  vtkDataCompressor* Compressor;
+  const unsigned char* const* Blocks;
+  const size_t* Sizes;
+  std::vector<unsigned char>* CompressedBlocks;
+  size_t* CompressedSizes;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      std::vector<unsigned char>& compressed = this->CompressedBlocks[i];
+      this->CompressedSizes[i] = this->Compressor->Compress(
+        this->Blocks[i], this->Sizes[i], &compressed[0], compressed.size());
+      }
+  }
+};
+}
+
+//----------------------------------------------------------------------------
+vtkColumnarTableWriter::vtkColumnarTableWriter()
+{
+  this->FileName = 0;
+  this->Compressor = vtkZLibDataCompressor::New();
+  this->NumberOfRowsPerBlock = 65536;
+  this->NumberOfCompressionThreads = 1;
+}
+
+//----------------------------------------------------------------------------
+vtkColumnarTableWriter::~vtkColumnarTableWriter()
+{
+  this->SetFileName(0);
+  this->SetCompressor(0);
+}
+
+//----------------------------------------------------------------------------
+void vtkColumnarTableWriter::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "FileName: "
+     << (this->FileName ? this->FileName : "(none)") << endl;
+  if (this->Compressor)
+    {
+    os << indent << "Compressor: " << this->Compressor << "\n";
+    }
+  else
+    {
+    os << indent << "Compressor: (none)\n";
+    }
+  os << indent << "NumberOfRowsPerBlock: " << this->NumberOfRowsPerBlock
+     << endl;
+  os << indent << "NumberOfCompressionThreads: "
+     << this->NumberOfCompressionThreads << endl;
+}
+
+//----------------------------------------------------------------------------
+void vtkColumnarTableWriter::SetCompressorType(int compressorType)
+{
+  if (compressorType == NONE)
+    {
+    this->SetCompressor(0);
+    return;
+    }
+
+  if (compressorType == ZLIB)
+    {
+    if (!this->Compressor ||
+        !this->Compressor->IsA("vtkZLibDataCompressor"))
+      {
+      vtkDataCompressor* compressor = vtkZLibDataCompressor::New();
+      this->SetCompressor(compressor);
+      compressor->Delete();
+      }
+    return;
+    }
+
+  if (compressorType == ZSTD)
+    {
+    if (!this->Compressor ||
+        !this->Compressor->IsA("vtkZstdDataCompressor"))
+      {
+      vtkDataCompressor* compressor = vtkZstdDataCompressor::New();
+      this->SetCompressor(compressor);
+      compressor->Delete();
+      }
+    return;
+    }
+}
+
+//----------------------------------------------------------------------------
+int vtkColumnarTableWriter::FillInputPortInformation(int vtkNotUsed(port),
+                                                     vtkInformation* info)
+{
+  info->Set(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkTable");
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+vtkTable* vtkColumnarTableWriter::GetInput()
+{
+  return vtkTable::SafeDownCast(this->Superclass::GetInput());
+}
+
+//----------------------------------------------------------------------------
+vtkTable* vtkColumnarTableWriter::GetInput(int port)
+{
+  return vtkTable::SafeDownCast(this->Superclass::GetInput(port));
+}
+
+//----------------------------------------------------------------------------
+void vtkColumnarTableWriter::WriteData()
+{
+  vtkTable* input = this->GetInput();
+  if (!input)
+    {
+    return;
+    }
+  if (!this->FileName)
+    {
+    vtkErrorMacro("No FileName specified.");
+    this->SetErrorCode(vtkErrorCode::NoFileNameError);
+    return;
+    }
+
+  ofstream os(this->FileName, ios::out | ios::binary);
+  if (!os)
+    {
+    vtkErrorMacro("Unable to open file: " << this->FileName);
+    this->SetErrorCode(vtkErrorCode::CannotOpenFileError);
+    return;
+    }
+
+  // The header, whose directory offset is filled in at the end.
+  os.write("vtkCTab1", 8);
+  vtkColumnarTableWriterPut(os, static_cast<vtkTypeUInt32>(0x01020304));
+  vtkColumnarTableWriterPut(os, static_cast<vtkTypeUInt64>(0));
+
+  vtkIdType numberOfRows = input->GetNumberOfRows();
+  vtksys_ios::ostringstream columns;
+  vtkTypeUInt32 numberOfColumns = 0;
+  int result = 1;
+  for (vtkIdType c = 0; result && c < input->GetNumberOfColumns(); ++c)
+    {
+    vtkAbstractArray* column = input->GetColumn(c);
+    vtkDataArray* dataArray = vtkDataArray::SafeDownCast(column);
+    if ((!dataArray || dataArray->GetDataType() == VTK_BIT) &&
+        !vtkStringArray::SafeDownCast(column))
+      {
+      vtkWarningMacro("Skipping column " << (column->GetName() ?
+        column->GetName() : "(none)") << " of type "
+        << column->GetClassName());
+      continue;
+      }
+    if (column->GetNumberOfTuples() < numberOfRows)
+      {
+      vtkErrorMacro("Column " << (column->GetName() ? column->GetName() :
+        "(none)") << " has fewer than " << numberOfRows << " rows.");
+      this->SetErrorCode(vtkErrorCode::UnknownError);
+      return;
+      }
+    result = this->WriteColumn(os, column, numberOfRows, columns);
+    ++numberOfColumns;
+    this->UpdateProgress(static_cast<double>(c + 1) /
+                         input->GetNumberOfColumns());
+    }
+  if (!result)
+    {
+    return;
+    }
+
+  // The directory.
+  vtkTypeUInt64 directoryOffset = static_cast<vtkTypeUInt64>(os.tellp());
+  vtkColumnarTableWriterPut(os, static_cast<vtkTypeUInt64>(numberOfRows));
+  vtkColumnarTableWriterPut(os,
+    static_cast<vtkTypeUInt32>(this->NumberOfRowsPerBlock));
+  vtkColumnarTableWriterPut(os, numberOfColumns);
+  vtkColumnarTableWriterPutString(os,
+    this->Compressor ? this->Compressor->GetClassName() : "");
+  std::string directory = columns.str();
+  os.write(directory.c_str(), static_cast<std::streamsize>(directory.size()));
+  os.seekp(12);
+  vtkColumnarTableWriterPut(os, directoryOffset);
+  os.flush();
+  if (os.fail())
+    {
+    vtkErrorMacro("Error writing " << this->FileName);
+    this->SetErrorCode(vtkErrorCode::OutOfDiskSpaceError);
+    }
+}
+
+//----------------------------------------------------------------------------
+int vtkColumnarTableWriter::WriteColumn(ostream& os, vtkAbstractArray* column,
+                                        vtkIdType numberOfRows,
+                                        ostream& directory)
+{
+  vtkDataArray* dataArray = vtkDataArray::SafeDownCast(column);
+  vtkStringArray* stringArray = vtkStringArray::SafeDownCast(column);
+  int numberOfComponents = column->GetNumberOfComponents();
+  int elementSize = column->GetDataTypeSize();
+
+  vtkColumnarTableWriterPutString(directory, column->GetName());
+  vtkColumnarTableWriterPut(directory,
+    static_cast<vtkTypeInt32>(column->GetDataType()));
+  vtkColumnarTableWriterPut(directory,
+    static_cast<vtkTypeInt32>(dataArray ? elementSize : 0));
+  vtkColumnarTableWriterPut(directory,
+    static_cast<vtkTypeInt32>(numberOfComponents));
+
+  vtkIdType rowsPerBlock = this->NumberOfRowsPerBlock;
+  vtkIdType numberOfBlocks = (numberOfRows + rowsPerBlock - 1) / rowsPerBlock;
+  size_t rowSize = static_cast<size_t>(elementSize) * numberOfComponents;
+  const unsigned char* data = dataArray ?
+    static_cast<const unsigned char*>(dataArray->GetVoidPointer(0)) : 0;
+
+  std::vector<const unsigned char*> blocks;
+  std::vector<size_t> sizes;
+  std::vector<std::vector<unsigned char> > strings;
+  std::vector<std::vector<unsigned char> > compressedBlocks;
+  std::vector<size_t> compressedSizes;
+  for (vtkIdType first = 0; first < numberOfBlocks;
+       first += vtkColumnarTableWriterBlocksPerBatch)
+    {
+    vtkIdType n = std::min(vtkColumnarTableWriterBlocksPerBatch,
+                           numberOfBlocks - first);
+    blocks.resize(n);
+    sizes.resize(n);
+    strings.resize(n);
+    for (vtkIdType i = 0; i < n; ++i)
+      {
+      vtkIdType begin = (first + i) * rowsPerBlock;
+      vtkIdType end = std::min(begin + rowsPerBlock, numberOfRows);
+      if (data)
+        {
+        blocks[i] = data + begin * rowSize;
+        sizes[i] = (end - begin) * rowSize;
+        continue;
+        }
+
+      // Strings are stored as their length followed by their characters.
+      std::vector<unsigned char>& buffer = strings[i];
+      buffer.clear();
+      for (vtkIdType v = begin * numberOfComponents;
+           v < end * numberOfComponents; ++v)
+        {
+        const vtkStdString& value = stringArray->GetValue(v);
+        vtkTypeUInt32 length = static_cast<vtkTypeUInt32>(value.size());
+        const unsigned char* bytes =
+          reinterpret_cast<const unsigned char*>(&length);
+        buffer.insert(buffer.end(), bytes, bytes + sizeof(length));
+        buffer.insert(buffer.end(), value.begin(), value.end());
+        }
+      blocks[i] = buffer.empty() ? 0 : &buffer[0];
+      sizes[i] = buffer.size();
+      }
+
+    // Compress the blocks concurrently.
+    if (this->Compressor)
+      {
+      compressedBlocks.resize(n);
+      compressedSizes.resize(n);
+      for (vtkIdType i = 0; i < n; ++i)
+        {
+        compressedBlocks[i].resize(
+          this->Compressor->GetMaximumCompressionSpace(sizes[i]) + 1);
+        }
+      vtkColumnarTableWriterCompressBlocks functor;
+      functor.Compressor = this->Compressor;
+      functor.Blocks = &blocks[0];
+      functor.Sizes = &sizes[0];
+      functor.CompressedBlocks = &compressedBlocks[0];
+      functor.CompressedSizes = &compressedSizes[0];
+      if (this->NumberOfCompressionThreads == 1)
+        {
+        functor(0, n);
+        }
+      else
+        {
+        vtkIdType grain = 1;
+        if (this->NumberOfCompressionThreads > 0)
+          {
+          grain = (n + this->NumberOfCompressionThreads - 1) /
+            this->NumberOfCompressionThreads;
+          }
+        vtkSMPTools::For(0, n, grain, functor);
+        }
+      }
+
+    // Write the blocks in order, raw when compression does not help.
+    for (vtkIdType i = 0; i < n; ++i)
+      {
+      const unsigned char* stored = blocks[i];
+      size_t storedSize = sizes[i];
+      if (this->Compressor && sizes[i] > 0)
+        {
+        if (compressedSizes[i] == 0)
+          {
+          vtkErrorMacro("Error compressing block " << first + i
+                        << " of column " << column->GetName());
+          this->SetErrorCode(vtkErrorCode::UnknownError);
+          return 0;
+          }
+        if (compressedSizes[i] < sizes[i])
+          {
+          stored = &compressedBlocks[i][0];
+          storedSize = compressedSizes[i];
+          }
+        }
+
+      vtkTypeUInt64 offset = static_cast<vtkTypeUInt64>(os.tellp());
+      if (offset % 8)
+        {
+        const char padding[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+        os.write(padding, 8 - offset % 8);
+        offset += 8 - offset % 8;
+        }
+      if (storedSize > 0)
+        {
+        os.write(reinterpret_cast<const char*>(stored),
+                 static_cast<std::streamsize>(storedSize));
+        }
+      vtkColumnarTableWriterPut(directory, offset);
+      vtkColumnarTableWriterPut(directory,
+                                static_cast<vtkTypeUInt64>(storedSize));
+      vtkColumnarTableWriterPut(directory,
+                                static_cast<vtkTypeUInt64>(sizes[i]));
+      }
+    if (os.fail())
+      {
+      vtkErrorMacro("Error writing " << this->FileName);
+      this->SetErrorCode(vtkErrorCode::OutOfDiskSpaceError);
+      return 0;
+      }
+    }
+  return 1;
+}
@@ -0,0 +1,135 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkColumnarTableWriter.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkColumnarTableWriter - write a vtkTable in a columnar binary format.
+// .SECTION Description
+// vtkColumnarTableWriter writes the columns of a vtkTable one after the
+// other in a binary file, each cut into blocks of NumberOfRowsPerBlock
+// rows that are compressed independently.  A block that does not shrink
+// when compressed is stored raw.  vtkColumnarTableReader can then read
+// any subset of the columns and of the rows without touching the others,
+// and use raw columns in place from a memory mapped file.
+//
+// Numeric columns (any vtkDataArray but vtkBitArray) are stored in the
+// byte order of the writing machine, and vtkStringArray columns as a
+// 32-bit length followed by the characters of each value.  Other columns
+// are skipped with a warning.
+//
+// The file starts with the 8 characters "vtkCTab1", a 32-bit byte order
+// mark and the 64-bit offset of a directory written after the data.  The
+// directory holds the number of rows, the number of rows per block, the
+// number of columns and the class name of the compressor, then for each
+// column its name, data type, element size, number of components and
+// the offset, stored size and size of each of its blocks.  Blocks start
+// on 8 byte boundaries.
+// .SECTION See Also
+// vtkColumnarTableReader vtkDelimitedTextWriter vtkTableWriter
+
+#ifndef __vtkColumnarTableWriter_h
+#define __vtkColumnarTableWriter_h
+
+#include "vtkIOInfovisModule.h" // For export macro
+#include "vtkWriter.h"
+
+class vtkAbstractArray;
+class vtkDataCompressor;
+class vtkTable;
+
+class VTKIOINFOVIS_EXPORT vtkColumnarTableWriter : public vtkWriter
+{
+public:
+  static vtkColumnarTableWriter* New();
+  vtkTypeMacro(vtkColumnarTableWriter, vtkWriter);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Get the input to this writer.
+  vtkTable* GetInput();
+  vtkTable* GetInput(int port);
+
+  // Description:
+  // Get/Set the name of the file to write.
+  vtkSetStringMacro(FileName);
+  vtkGetStringMacro(FileName);
+
+  // Description:
+  // Get/Set the compressor used to compress the blocks of each column.
+  // Default is a vtkZLibDataCompressor.  With no compressor the columns
+  // are stored raw and can be memory mapped by vtkColumnarTableReader.
+  virtual void SetCompressor(vtkDataCompressor*);
+  vtkGetObjectMacro(Compressor, vtkDataCompressor);
+
+//BTX
+  enum CompressorType
+    {
+    NONE,
+    ZLIB,
+    ZSTD
+    };
+//ETX
+
+  // Description:
+  // Convenience functions to set the compressor to certain known types.
+  void SetCompressorType(int compressorType);
+  void SetCompressorTypeToNone()
+    {
+    this->SetCompressorType(NONE);
+    }
+  void SetCompressorTypeToZLib()
+    {
+    this->SetCompressorType(ZLIB);
+    }
+  void SetCompressorTypeToZstd()
+    {
+    this->SetCompressorType(ZSTD);
+    }
+
+  // Description:
+  // Get/Set the number of rows in each compressed block.  When reading,
+  // this is the granularity of how much extra data must be decompressed
+  // when only some rows are requested.  Default is 65536.
+  vtkSetClampMacro(NumberOfRowsPerBlock, int, 1, VTK_INT_MAX);
+  vtkGetMacro(NumberOfRowsPerBlock, int);
+
+  // Description:
+  // Get/Set how many batches the blocks of a column are split into to be
+  // compressed concurrently.  As with
+  // vtkXMLWriter::SetNumberOfCompressionThreads, this is a vtkSMPTools
+  // grain, not a number of threads.  Default is 1, serial.
+  vtkSetClampMacro(NumberOfCompressionThreads, int, 0, VTK_INT_MAX);
+  vtkGetMacro(NumberOfCompressionThreads, int);
+
+protected:
+  vtkColumnarTableWriter();
+  ~vtkColumnarTableWriter();
+
+  virtual void WriteData();
+  virtual int FillInputPortInformation(int port, vtkInformation* info);
+
+  // Write the blocks of one column and append their offsets and sizes to
+  // the directory.  Returns 0 on error.
+  int WriteColumn(ostream& os, vtkAbstractArray* column,
+                  vtkIdType numberOfRows, ostream& directory);
+
+  char* FileName;
+  vtkDataCompressor* Compressor;
+  int NumberOfRowsPerBlock;
+  int NumberOfCompressionThreads;
+
+private:
+  vtkColumnarTableWriter(const vtkColumnarTableWriter&); // Not implemented.
+  void operator=(const vtkColumnarTableWriter&); // Not implemented.
+};
+
+#endif
@@ -21,10 +21,14 @@
 #include "vtkDelimitedTextReader.h"
 #include "vtkCommand.h"
 #include "vtkDataSetAttributes.h"
+#include "vtkDoubleArray.h"
 #include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkIntArray.h"
+#include "vtkMath.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTable.h"
@@ -44,6 +48,7 @@
 #include <vector>
 
 #include <ctype.h>
+#include <stdlib.h>
 
 // #include <utf8.h>
 
@@ -368,6 +373,430 @@ private:
 
 } // End anonymous namespace
 
+////////////////////////////////////////////////////////////////////////////////
+// Chunked parsing
+
+namespace {
+
+enum ChunkColumnType
+{
+  ChunkStringColumn,
+  ChunkIntegerColumn,
+  ChunkDoubleColumn
+};
+
+/// The delimiters of the text, looked up by byte.  Records are split the
+/// same way DelimitedTextIterator splits them, so that record delimiters
+/// always end a record and chunks can be split at any of them.
+class ChunkSyntax
+{
+public:
+  ChunkSyntax(
+    const vtkUnicodeString& record_delimiters,
+    const vtkUnicodeString& field_delimiters,
+    const vtkUnicodeString& string_delimiters,
+    const vtkUnicodeString& whitespace,
+    const vtkUnicodeString& escape,
+    bool merge_cons_delimiters,
+    bool use_string_delimiter) :
+    Escape(-1),
+    MergeConsDelims(merge_cons_delimiters)
+  {
+    Fill(this->IsRecordDelimiter, record_delimiters);
+    Fill(this->IsFieldDelimiter, field_delimiters);
+    Fill(this->IsStringDelimiter, use_string_delimiter ?
+         string_delimiters : vtkUnicodeString());
+    Fill(this->IsWhitespace, whitespace);
+    if(!escape.empty() && escape[0] < 128)
+      {
+      this->Escape = static_cast<int>(escape[0]);
+      }
+  }
+
+  /// Skip the record delimiters and whitespace that precede a record.
+  /// line_start is moved past the last record delimiter skipped.
+  const char* SkipBlanks(const char* p, const char* end,
+                         const char*& line_start) const
+  {
+    for(; p != end; ++p)
+      {
+      unsigned char c = static_cast<unsigned char>(*p);
+      if(this->IsRecordDelimiter[c])
+        {
+        line_start = p + 1;
+        }
+      else if(!this->IsWhitespace[c])
+        {
+        break;
+        }
+      }
+    return p;
+  }
+
+  const char* FindRecordDelimiter(const char* p, const char* end) const
+  {
+    while(p != end && !this->IsRecordDelimiter[static_cast<unsigned char>(*p)])
+      {
+      ++p;
+      }
+    return p;
+  }
+
+  const char* FindLastRecordDelimiter(const char* begin, const char* end) const
+  {
+    for(const char* p = end; p != begin; --p)
+      {
+      if(this->IsRecordDelimiter[static_cast<unsigned char>(p[-1])])
+        {
+        return p - 1;
+        }
+      }
+    return 0;
+  }
+
+  /// Split the record [p, end) into fields.  Returns the number of fields.
+  size_t SplitRecord(const char* p, const char* end,
+                     std::vector<std::string>& fields) const
+  {
+    size_t count = 0;
+    NextField(fields, count);
+    char within_string = 0;
+    bool escaped = false;
+    for(; p != end; ++p)
+      {
+      unsigned char c = static_cast<unsigned char>(*p);
+      std::string& field = fields[count - 1];
+      if(escaped)
+        {
+        switch(c)
+          {
+          case '0': field += '\0'; break;
+          case 'a': field += '\a'; break;
+          case 'b': field += '\b'; break;
+          case 't': field += '\t'; break;
+          case 'n': field += '\n'; break;
+          case 'v': field += '\v'; break;
+          case 'f': field += '\f'; break;
+          case 'r': field += '\r'; break;
+          default: field += static_cast<char>(c); break;
+          }
+        escaped = false;
+        }
+      else if(!within_string && this->IsFieldDelimiter[c])
+        {
+        if(!(field.empty() && this->MergeConsDelims))
+          {
+          NextField(fields, count);
+          }
+        }
+      else if(static_cast<int>(c) == this->Escape)
+        {
+        escaped = true;
+        }
+      else if(!within_string && this->IsStringDelimiter[c])
+        {
+        within_string = static_cast<char>(c);
+        field.clear();
+        }
+      else if(within_string && within_string == static_cast<char>(c))
+        {
+        within_string = 0;
+        }
+      else
+        {
+        field += static_cast<char>(c);
+        }
+      }
+    return count;
+  }
+
+private:
+  static void Fill(bool* table, const vtkUnicodeString& characters)
+  {
+    std::fill(table, table + 256, false);
+    for(vtkUnicodeString::const_iterator i = characters.begin();
+        i != characters.end(); ++i)
+      {
+      if(*i >= 128)
+        {
+        throw std::runtime_error(
+          "Chunked parsing only supports ASCII delimiters");
+        }
+      table[*i] = true;
+      }
+  }
+
+  static void NextField(std::vector<std::string>& fields, size_t& count)
+  {
+    if(count == fields.size())
+      {
+      fields.push_back(std::string());
+      }
+    fields[count++].clear();
+  }
+
+  bool IsRecordDelimiter[256];
+  bool IsFieldDelimiter[256];
+  bool IsStringDelimiter[256];
+  bool IsWhitespace[256];
+  int Escape;
+  bool MergeConsDelims;
+};
+
+/// Trim the whitespace around a field, as vtkStringToNumeric does with
+/// TrimWhitespacePriorToNumericConversion.  Returns false if nothing is left.
+bool ChunkTrim(const std::string& field, const char*& begin, const char*& end)
+{
+  begin = field.c_str();
+  end = begin + field.size();
+  while(begin != end && isspace(static_cast<unsigned char>(*begin)))
+    {
+    ++begin;
+    }
+  while(end != begin && isspace(static_cast<unsigned char>(end[-1])))
+    {
+    --end;
+    }
+  return begin != end;
+}
+
+bool ChunkParseInteger(const char* begin, const char* end, int* value)
+{
+  const char* p = begin;
+  bool negative = false;
+  if(*p == '-' || *p == '+')
+    {
+    negative = (*p++ == '-');
+    }
+  if(p == end || end - p > 10)
+    {
+    return false;
+    }
+  vtkTypeInt64 result = 0;
+  for(; p != end; ++p)
+    {
+    unsigned int digit = static_cast<unsigned int>(*p - '0');
+    if(digit > 9)
+      {
+      return false;
+      }
+    result = result * 10 + digit;
+    }
+  result = negative ? -result : result;
+  if(result < VTK_INT_MIN || result > VTK_INT_MAX)
+    {
+    return false;
+    }
+  *value = static_cast<int>(result);
+  return true;
+}
+
+bool ChunkParseDouble(const char* begin, const char* end, double* value)
+{
+  // strtod stops at the trailing whitespace or the null terminating the
+  // field, and accepts nan and inf as vtkVariant does.
+  char* stop = 0;
+  *value = strtod(begin, &stop);
+  return stop == end;
+}
+
+/// The values of one column parsed from a range of a chunk.
+class ChunkColumn
+{
+public:
+  int Type;
+  std::vector<int> Integers;
+  std::vector<double> Doubles;
+  std::vector<std::string> Strings;
+};
+
+/// A range of complete records of a chunk and the values parsed from it.
+class ChunkRange
+{
+public:
+  const char* Begin;
+  const char* End;
+  vtkIdType MaxRecords;
+  vtkIdType NumberOfRecords;
+  vtkIdType NumberOfMismatches;
+  std::vector<ChunkColumn> Columns;
+};
+
+/// Parse the ranges of a chunk, concurrently with vtkSMPTools.
+class ChunkParser
+{
+public:
+  const ChunkSyntax* Syntax;
+  const std::vector<int>* Types;
+  std::vector<ChunkRange>* Ranges;
+  int DefaultIntegerValue;
+  double DefaultDoubleValue;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for(vtkIdType i = begin; i != end; ++i)
+      {
+      this->Parse((*this->Ranges)[i]);
+      }
+  }
+
+  void Parse(ChunkRange& range) const
+  {
+    size_t num_columns = this->Types->size();
+    range.NumberOfRecords = 0;
+    range.NumberOfMismatches = 0;
+    range.Columns.resize(num_columns);
+    for(size_t c = 0; c != num_columns; ++c)
+      {
+      range.Columns[c].Type = (*this->Types)[c];
+      }
+
+    std::vector<std::string> fields;
+    const std::string empty;
+    const char* p = range.Begin;
+    const char* line_start = p;
+    while(range.MaxRecords == 0 || range.NumberOfRecords < range.MaxRecords)
+      {
+      p = this->Syntax->SkipBlanks(p, range.End, line_start);
+      if(p == range.End)
+        {
+        break;
+        }
+      const char* record_end = this->Syntax->FindRecordDelimiter(p, range.End);
+      size_t num_fields = this->Syntax->SplitRecord(p, record_end, fields);
+      for(size_t c = 0; c != num_columns; ++c)
+        {
+        this->Append(range, range.Columns[c],
+                     c < num_fields ? fields[c] : empty);
+        }
+      ++range.NumberOfRecords;
+      p = record_end;
+      }
+  }
+
+private:
+  void Append(ChunkRange& range, ChunkColumn& column,
+              const std::string& field) const
+  {
+    if(column.Type == ChunkStringColumn)
+      {
+      column.Strings.push_back(field);
+      return;
+      }
+
+    const char* begin;
+    const char* end;
+    if(!ChunkTrim(field, begin, end))
+      {
+      if(column.Type == ChunkIntegerColumn)
+        {
+        column.Integers.push_back(this->DefaultIntegerValue);
+        }
+      else
+        {
+        column.Doubles.push_back(this->DefaultDoubleValue);
+        }
+      return;
+      }
+
+    int integer;
+    double real;
+    if(column.Type == ChunkIntegerColumn)
+      {
+      if(ChunkParseInteger(begin, end, &integer))
+        {
+        column.Integers.push_back(integer);
+        return;
+        }
+      if(!ChunkParseDouble(begin, end, &real))
+        {
+        column.Integers.push_back(this->DefaultIntegerValue);
+        ++range.NumberOfMismatches;
+        return;
+        }
+      // A real number turns the column into a double column.
+      column.Doubles.assign(column.Integers.begin(), column.Integers.end());
+      column.Integers.clear();
+      column.Type = ChunkDoubleColumn;
+      column.Doubles.push_back(real);
+      return;
+      }
+
+    if(!ChunkParseDouble(begin, end, &real))
+      {
+      real = vtkMath::Nan();
+      ++range.NumberOfMismatches;
+      }
+    column.Doubles.push_back(real);
+  }
+};
+
+/// Append the records [first, last) of a range to the output columns.
+void ChunkAppend(const ChunkRange& range, vtkIdType first, vtkIdType last,
+                 std::vector<vtkSmartPointer<vtkAbstractArray> >& columns,
+                 std::vector<int>& types)
+{
+  vtkIdType count = last - first;
+  for(size_t c = 0; c != types.size(); ++c)
+    {
+    const ChunkColumn& column = range.Columns[c];
+    vtkAbstractArray* array = columns[c];
+    vtkIdType size = array->GetNumberOfTuples();
+
+    if(column.Type == ChunkDoubleColumn && types[c] == ChunkIntegerColumn)
+      {
+      // Replace the integer column by a double column.
+      vtkIntArray* integers = static_cast<vtkIntArray*>(array);
+      vtkSmartPointer<vtkDoubleArray> doubles =
+        vtkSmartPointer<vtkDoubleArray>::New();
+      doubles->SetName(integers->GetName());
+      doubles->SetNumberOfTuples(size);
+      for(vtkIdType i = 0; i != size; ++i)
+        {
+        doubles->SetValue(i, integers->GetValue(i));
+        }
+      columns[c] = doubles;
+      array = doubles;
+      types[c] = ChunkDoubleColumn;
+      }
+
+    switch(types[c])
+      {
+      case ChunkStringColumn:
+        {
+        vtkStdString* values =
+          static_cast<vtkStringArray*>(array)->WritePointer(size, count);
+        std::copy(column.Strings.begin() + first,
+                  column.Strings.begin() + last, values);
+        } break;
+      case ChunkIntegerColumn:
+        {
+        int* values =
+          static_cast<vtkIntArray*>(array)->WritePointer(size, count);
+        std::copy(column.Integers.begin() + first,
+                  column.Integers.begin() + last, values);
+        } break;
+      case ChunkDoubleColumn:
+        {
+        double* values =
+          static_cast<vtkDoubleArray*>(array)->WritePointer(size, count);
+        if(column.Type == ChunkIntegerColumn)
+          {
+          std::copy(column.Integers.begin() + first,
+                    column.Integers.begin() + last, values);
+          }
+        else
+          {
+          std::copy(column.Doubles.begin() + first,
+                    column.Doubles.begin() + last, values);
+          }
+        } break;
+      }
+    }
+}
+
+} // End anonymous namespace
+
 /////////////////////////////////////////////////////////////////////////////////////////
 // vtkDelimitedTextReader
 
@@ -406,6 +835,11 @@ vtkDelimitedTextReader::vtkDelimitedTextReader() :
   this->DefaultIntegerValue = 0;
   this->DefaultDoubleValue = 0.0;
   this->TrimWhitespacePriorToNumericConversion = false;
+  this->ChunkedParsing = false;
+  this->ChunkSize = 16 << 20;
+  this->NumberOfSampleRecords = 1000;
+  this->RecordOffset = 0;
+  this->NumberOfParsingThreads = 0;
 }
 
 vtkDelimitedTextReader::~vtkDelimitedTextReader()
@@ -469,6 +903,14 @@ void vtkDelimitedTextReader::PrintSelf(ostream& os, vtkIndent indent)
     << this->PedigreeIdArrayName << endl;
   os << indent << "OutputPedigreeIds: "
     << (this->OutputPedigreeIds? "true" : "false") << endl;
+  os << indent << "ChunkedParsing: "
+    << (this->ChunkedParsing ? "true" : "false") << endl;
+  os << indent << "ChunkSize: " << this->ChunkSize << endl;
+  os << indent << "NumberOfSampleRecords: "
+    << this->NumberOfSampleRecords << endl;
+  os << indent << "RecordOffset: " << this->RecordOffset << endl;
+  os << indent << "NumberOfParsingThreads: "
+    << this->NumberOfParsingThreads << endl;
 }
 
 void vtkDelimitedTextReader::SetInputString(const char *in)
@@ -584,6 +1026,17 @@ vtkStdString vtkDelimitedTextReader::GetLastError()
   return this->LastError;
 }
 
+int vtkDelimitedTextReader::RequestInformation(
+  vtkInformation*,
+  vtkInformationVector**,
+  vtkInformationVector* outputVector)
+{
+  // Only chunked parsing splits the input into pieces.
+  vtkInformation* const outInfo = outputVector->GetInformationObject(0);
+  outInfo->Set(CAN_HANDLE_PIECE_REQUEST(), this->ChunkedParsing ? 1 : 0);
+  return 1;
+}
+
 int vtkDelimitedTextReader::RequestData(
   vtkInformation*,
   vtkInformationVector**,
@@ -595,10 +1048,18 @@ int vtkDelimitedTextReader::RequestData(
 
   try
     {
-    // We only retrieve one piece ...
+    // We only retrieve one piece, unless parsing chunks ...
     vtkInformation* const outInfo = outputVector->GetInformationObject(0);
-    if(outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER()) &&
-      outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER()) > 0)
+    int piece = 0;
+    int number_of_pieces = 1;
+    if(outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER()))
+      {
+      piece = outInfo->Get(
+        vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER());
+      number_of_pieces = outInfo->Get(
+        vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES());
+      }
+    if(piece > 0 && !this->ChunkedParsing)
       {
       return 1;
       }
@@ -637,54 +1098,70 @@ int vtkDelimitedTextReader::RequestData(
       input_stream_pt = dynamic_cast<istream*>(&string_stream);
       }
 
-    vtkStdString character_set;
-    vtkTextCodec* transCodec = NULL;
-
-    if(this->UnicodeCharacterSet)
-      {
-      this->UnicodeOutputArrays = true;
-      character_set = this->UnicodeCharacterSet;
-      transCodec = vtkTextCodecFactory::CodecForName(this->UnicodeCharacterSet);
-      }
-    else
+    if(this->ChunkedParsing)
       {
       char tstring[2];
       tstring[1] = '\0';
       tstring[0] = this->StringDelimiter;
-      // don't use Set* methods since they change the MTime in
-      // RequestData() !!!!!
       this->UnicodeFieldDelimiters =
-            vtkUnicodeString::from_utf8(this->FieldDelimiterCharacters);
+        vtkUnicodeString::from_utf8(this->FieldDelimiterCharacters);
       this->UnicodeStringDelimiters =
         vtkUnicodeString::from_utf8(tstring);
       this->UnicodeOutputArrays = false;
-      transCodec = vtkTextCodecFactory::CodecToHandle(*input_stream_pt);
+      this->ReadChunks(*input_stream_pt, output_table, piece,
+                       number_of_pieces);
       }
-
-    if (NULL == transCodec)
+    else
       {
-      // should this use the locale instead??
-      return 1;
-      }
+      vtkStdString character_set;
+      vtkTextCodec* transCodec = NULL;
 
-    DelimitedTextIterator iterator(
-      this->MaxRecords,
-      this->UnicodeRecordDelimiters,
-      this->UnicodeFieldDelimiters,
-      this->UnicodeStringDelimiters,
-      this->UnicodeWhitespace,
-      this->UnicodeEscapeCharacter,
-      this->HaveHeaders,
-      this->UnicodeOutputArrays,
-      this->MergeConsecutiveDelimiters,
-      this->UseStringDelimiter,
-      output_table);
+      if(this->UnicodeCharacterSet)
+        {
+        this->UnicodeOutputArrays = true;
+        character_set = this->UnicodeCharacterSet;
+        transCodec = vtkTextCodecFactory::CodecForName(this->UnicodeCharacterSet);
+        }
+      else
+        {
+        char tstring[2];
+        tstring[1] = '\0';
+        tstring[0] = this->StringDelimiter;
+        // don't use Set* methods since they change the MTime in
+        // RequestData() !!!!!
+        this->UnicodeFieldDelimiters =
+              vtkUnicodeString::from_utf8(this->FieldDelimiterCharacters);
+        this->UnicodeStringDelimiters =
+          vtkUnicodeString::from_utf8(tstring);
+        this->UnicodeOutputArrays = false;
+        transCodec = vtkTextCodecFactory::CodecToHandle(*input_stream_pt);
+        }
 
-    vtkTextCodec::OutputIterator& outIter = iterator;
+      if (NULL == transCodec)
+        {
+        // should this use the locale instead??
+        return 1;
+        }
 
-    transCodec->ToUnicode(*input_stream_pt, outIter);
-    iterator.ReachedEndOfInput();
-    transCodec->Delete();
+      DelimitedTextIterator iterator(
+        this->MaxRecords,
+        this->UnicodeRecordDelimiters,
+        this->UnicodeFieldDelimiters,
+        this->UnicodeStringDelimiters,
+        this->UnicodeWhitespace,
+        this->UnicodeEscapeCharacter,
+        this->HaveHeaders,
+        this->UnicodeOutputArrays,
+        this->MergeConsecutiveDelimiters,
+        this->UseStringDelimiter,
+        output_table);
+
+      vtkTextCodec::OutputIterator& outIter = iterator;
+
+      transCodec->ToUnicode(*input_stream_pt, outIter);
+      iterator.ReachedEndOfInput();
+      transCodec->Delete();
+      }
 
     if(this->OutputPedigreeIds)
       {
@@ -718,7 +1195,8 @@ int vtkDelimitedTextReader::RequestData(
       }
     }
 
-    if (this->DetectNumericColumns && !this->UnicodeOutputArrays)
+    if (this->DetectNumericColumns && !this->UnicodeOutputArrays &&
+        !this->ChunkedParsing)
       {
       vtkStringToNumeric* converter = vtkStringToNumeric::New();
       converter->SetForceDouble(this->ForceDouble);
@@ -750,3 +1228,321 @@ int vtkDelimitedTextReader::RequestData(
 
   return 1;
 }
+
+void vtkDelimitedTextReader::ReadChunks(istream& input, vtkTable* output,
+                                        int piece, int number_of_pieces)
+{
+  const ChunkSyntax syntax(
+    this->UnicodeRecordDelimiters,
+    this->UnicodeFieldDelimiters,
+    this->UnicodeStringDelimiters,
+    this->UnicodeWhitespace,
+    this->UnicodeEscapeCharacter,
+    this->MergeConsecutiveDelimiters,
+    this->UseStringDelimiter);
+  const size_t chunk_size = static_cast<size_t>(this->ChunkSize);
+
+  input.seekg(0, ios::end);
+  const vtkTypeInt64 total_bytes = static_cast<vtkTypeInt64>(input.tellg());
+  input.seekg(0, ios::beg);
+
+  // Read the headers and the records that decide the column types from
+  // the beginning of the input, whatever the piece.
+  std::vector<char> buffer(chunk_size);
+  input.read(&buffer[0], static_cast<std::streamsize>(chunk_size));
+  const char* begin = &buffer[0];
+  const char* end = begin + input.gcount();
+  if(end - begin >= 3 && memcmp(begin, "\xEF\xBB\xBF", 3) == 0)
+    {
+    begin += 3;
+    }
+  if(input.gcount() == static_cast<std::streamsize>(chunk_size))
+    {
+    // Only use complete records.
+    const char* last = syntax.FindLastRecordDelimiter(begin, end);
+    end = last ? last : begin;
+    }
+
+  std::vector<std::string> fields;
+  const char* line_start = begin;
+  const char* p = syntax.SkipBlanks(begin, end, line_start);
+  if(p == end)
+    {
+    return;
+    }
+  const char* record_end = syntax.FindRecordDelimiter(p, end);
+  size_t num_columns = syntax.SplitRecord(p, record_end, fields);
+  std::vector<std::string> names(num_columns);
+  for(size_t c = 0; c != num_columns; ++c)
+    {
+    if(this->HaveHeaders)
+      {
+      names[c] = fields[c];
+      }
+    else
+      {
+      std::ostringstream name;
+      name << "Field " << c;
+      names[c] = name.str();
+      }
+    }
+  vtkTypeInt64 data_begin = 0;
+  if(this->HaveHeaders)
+    {
+    data_begin = record_end - &buffer[0];
+    p = record_end;
+    }
+
+  std::vector<int> types(num_columns, ChunkStringColumn);
+  if(this->DetectNumericColumns)
+    {
+    std::vector<bool> all_integer(num_columns, true);
+    std::vector<bool> all_numeric(num_columns, true);
+    for(vtkIdType i = 0; i < this->NumberOfSampleRecords; ++i)
+      {
+      p = syntax.SkipBlanks(p, end, line_start);
+      if(p == end)
+        {
+        break;
+        }
+      record_end = syntax.FindRecordDelimiter(p, end);
+      size_t num_fields = syntax.SplitRecord(p, record_end, fields);
+      for(size_t c = 0; c != num_columns && c != num_fields; ++c)
+        {
+        const char* field_begin;
+        const char* field_end;
+        int integer;
+        double real;
+        if(!ChunkTrim(fields[c], field_begin, field_end))
+          {
+          continue;
+          }
+        if(all_integer[c] &&
+           !ChunkParseInteger(field_begin, field_end, &integer))
+          {
+          all_integer[c] = false;
+          }
+        if(!all_integer[c] && !ChunkParseDouble(field_begin, field_end, &real))
+          {
+          all_numeric[c] = false;
+          }
+        }
+      p = record_end;
+      }
+    for(size_t c = 0; c != num_columns; ++c)
+      {
+      if(all_numeric[c])
+        {
+        types[c] = (all_integer[c] && !this->ForceDouble) ?
+          ChunkIntegerColumn : ChunkDoubleColumn;
+        }
+      }
+    }
+
+  std::vector<vtkSmartPointer<vtkAbstractArray> > columns(num_columns);
+  for(size_t c = 0; c != num_columns; ++c)
+    {
+    switch(types[c])
+      {
+      case ChunkIntegerColumn:
+        columns[c] = vtkSmartPointer<vtkIntArray>::New();
+        break;
+      case ChunkDoubleColumn:
+        columns[c] = vtkSmartPointer<vtkDoubleArray>::New();
+        break;
+      default:
+        columns[c] = vtkSmartPointer<vtkStringArray>::New();
+        break;
+      }
+    columns[c]->SetName(names[c].c_str());
+    }
+
+  // The bytes of this piece.  A record belongs to the piece in which the
+  // record delimiter preceding it lies, so each piece starts after the
+  // first record delimiter found from the byte before its share.
+  vtkTypeInt64 data_bytes = total_bytes - data_begin;
+  vtkTypeInt64 piece_begin = data_begin + data_bytes * piece / number_of_pieces;
+  vtkTypeInt64 piece_end =
+    data_begin + data_bytes * (piece + 1) / number_of_pieces;
+  if(piece > 0)
+    {
+    piece_begin -= 1;
+    }
+  if(piece == number_of_pieces - 1)
+    {
+    piece_end = total_bytes;
+    }
+  else
+    {
+    piece_end -= 1;
+    }
+
+  input.clear();
+  input.seekg(piece_begin, ios::beg);
+  vtkTypeInt64 buffer_offset = piece_begin;
+  size_t carried = 0;
+  bool skipping_to_piece = piece > 0;
+  bool done = piece_begin >= piece_end && piece > 0;
+  vtkIdType skipped = 0;
+  vtkIdType num_records = 0;
+  vtkIdType num_mismatches = 0;
+  std::vector<ChunkRange> ranges;
+
+  ChunkParser parser;
+  parser.Syntax = &syntax;
+  parser.Types = &types;
+  parser.Ranges = &ranges;
+  parser.DefaultIntegerValue = this->DefaultIntegerValue;
+  parser.DefaultDoubleValue = this->DefaultDoubleValue;
+
+  while(!done)
+    {
+    // Read the next chunk after what was left of the previous one.
+    if(buffer.size() < carried + chunk_size)
+      {
+      buffer.resize(carried + chunk_size);
+      }
+    input.read(&buffer[carried], static_cast<std::streamsize>(chunk_size));
+    bool at_end = input.gcount() < static_cast<std::streamsize>(chunk_size);
+    begin = &buffer[0];
+    end = begin + carried + input.gcount();
+    if(buffer_offset == 0 && end - begin >= 3 &&
+       memcmp(begin, "\xEF\xBB\xBF", 3) == 0)
+      {
+      begin += 3;
+      }
+
+    if(skipping_to_piece)
+      {
+      const char* first = syntax.FindRecordDelimiter(begin, end);
+      if(first == end && !at_end)
+        {
+        buffer_offset += end - &buffer[0];
+        carried = 0;
+        continue;
+        }
+      begin = first;
+      skipping_to_piece = false;
+      }
+
+    // Only parse complete records of the piece.
+    const char* parse_end = end;
+    if(buffer_offset + (end - &buffer[0]) > piece_end)
+      {
+      const char* cut = &buffer[0] + std::max<vtkTypeInt64>(
+        piece_end - buffer_offset, begin - &buffer[0]);
+      cut = syntax.FindRecordDelimiter(cut, end);
+      if(cut != end || at_end)
+        {
+        parse_end = cut;
+        done = true;
+        }
+      }
+    if(!done)
+      {
+      if(at_end)
+        {
+        done = true;
+        }
+      else
+        {
+        const char* last = syntax.FindLastRecordDelimiter(begin, end);
+        parse_end = last ? last : begin;
+        }
+      }
+
+    // Skip the records before the offset without parsing them.
+    p = begin;
+    while(skipped < this->RecordOffset)
+      {
+      p = syntax.SkipBlanks(p, parse_end, line_start);
+      if(p == parse_end)
+        {
+        break;
+        }
+      p = syntax.FindRecordDelimiter(p, parse_end);
+      ++skipped;
+      }
+
+    // Split the rest into ranges of complete records and parse them.
+    size_t num_ranges = static_cast<size_t>(this->NumberOfParsingThreads);
+    if(num_ranges == 0)
+      {
+      num_ranges = static_cast<size_t>((parse_end - p) >> 20) + 1;
+      }
+    vtkIdType max_records = 0;
+    if(this->MaxRecords)
+      {
+      max_records = this->MaxRecords - num_records;
+      }
+    ranges.resize(num_ranges);
+    for(size_t r = 0; r != num_ranges; ++r)
+      {
+      ranges[r].Begin = p;
+      if(r + 1 != num_ranges)
+        {
+        p = syntax.FindRecordDelimiter(
+          std::max(p, ranges[0].Begin +
+                   (parse_end - ranges[0].Begin) * (r + 1) / num_ranges),
+          parse_end);
+        }
+      else
+        {
+        p = parse_end;
+        }
+      ranges[r].End = p;
+      ranges[r].MaxRecords = max_records;
+      }
+    if(num_ranges == 1)
+      {
+      parser.Parse(ranges[0]);
+      }
+    else
+      {
+      vtkSMPTools::For(0, static_cast<vtkIdType>(num_ranges), 1, parser);
+      }
+
+    // Append the records in order, up to MaxRecords.
+    for(size_t r = 0; r != num_ranges; ++r)
+      {
+      vtkIdType count = ranges[r].NumberOfRecords;
+      if(this->MaxRecords && num_records + count > this->MaxRecords)
+        {
+        count = this->MaxRecords - num_records;
+        }
+      ChunkAppend(ranges[r], 0, count, columns, types);
+      num_records += count;
+      num_mismatches += ranges[r].NumberOfMismatches;
+      }
+    ranges.clear();
+    if(this->MaxRecords && num_records >= this->MaxRecords)
+      {
+      done = true;
+      }
+
+    // Keep the incomplete record at the end for the next chunk.
+    carried = static_cast<size_t>(end - parse_end);
+    if(!done && carried)
+      {
+      memmove(&buffer[0], parse_end, carried);
+      }
+    buffer_offset += parse_end - &buffer[0];
+    if(piece_end > piece_begin)
+      {
+      this->UpdateProgress(static_cast<double>(buffer_offset - piece_begin) /
+                           static_cast<double>(piece_end - piece_begin));
+      }
+    }
+
+  for(size_t c = 0; c != num_columns; ++c)
+    {
+    output->AddColumn(columns[c]);
+    }
+
+  if(num_mismatches)
+    {
+    vtkWarningMacro(<< num_mismatches << " values do not match the type "
+                    "of their column found from the first "
+                    << this->NumberOfSampleRecords << " records.");
+    }
+}
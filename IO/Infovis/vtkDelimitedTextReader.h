@@ -48,6 +48,11 @@
 //
 // This class emits ProgressEvent for every 100 lines it reads.
 //
+// For very large files, turn on ChunkedParsing.  The text is then read
+// and parsed a chunk at a time, on several threads, directly into string,
+// integer and double columns, and the reader can produce pieces or a
+// window of the records so that a file can be streamed through.
+//
 // .SECTION Thanks
 // Thanks to Andy Wilson, Brian Wylie, Tim Shead, and Thomas Otahal
 // from Sandia National Laboratories for implementing this class.
@@ -254,16 +259,73 @@ public:
   vtkSetMacro(ReplacementCharacter, vtkTypeUInt32);
   vtkGetMacro(ReplacementCharacter, vtkTypeUInt32);
 
+  // Description:
+  // When on, the input is read ChunkSize bytes at a time and each chunk
+  // is parsed straight into the output columns, instead of decoding the
+  // whole input into string columns and converting them afterwards.  With
+  // DetectNumericColumns, the type of each column is decided from the
+  // first NumberOfSampleRecords records.  The input must use a single
+  // byte or UTF-8 encoding with ASCII delimiters; UnicodeCharacterSet is
+  // ignored.  Pieces are supported: each piece reads the records that
+  // start in its share of the bytes that follow the headers.  Off by
+  // default.
+  vtkSetMacro(ChunkedParsing, bool);
+  vtkGetMacro(ChunkedParsing, bool);
+  vtkBooleanMacro(ChunkedParsing, bool);
+
+  // Description:
+  // The number of bytes read and parsed at a time with ChunkedParsing.
+  // Defaults to 16 MiB.
+  vtkSetClampMacro(ChunkSize, vtkIdType, 1024, VTK_ID_MAX);
+  vtkGetMacro(ChunkSize, vtkIdType);
+
+  // Description:
+  // The number of records used to decide the type of the columns with
+  // ChunkedParsing and DetectNumericColumns.  A value that does not
+  // match the type of its column in a later record is replaced by
+  // DefaultIntegerValue or NaN, except that integer columns become double
+  // columns when they meet a real number.  Defaults to 1000.
+  vtkSetClampMacro(NumberOfSampleRecords, vtkIdType, 1, VTK_ID_MAX);
+  vtkGetMacro(NumberOfSampleRecords, vtkIdType);
+
+  // Description:
+  // The number of records skipped before reading the records with
+  // ChunkedParsing.  Together with MaxRecords, this reads a window of
+  // the records of the file.  Skipped records are only scanned for
+  // their end, not parsed.  With pieces, the offset applies to the
+  // records of each piece.  Defaults to 0.
+  vtkSetClampMacro(RecordOffset, vtkIdType, 0, VTK_ID_MAX);
+  vtkGetMacro(RecordOffset, vtkIdType);
+
+  // Description:
+  // The number of threads used to parse each chunk with ChunkedParsing.
+  // The chunk is split at record boundaries into ranges parsed
+  // concurrently with vtkSMPTools, then appended in order.  A value of
+  // 0 (the default) lets vtkSMPTools schedule ranges of about one
+  // megabyte; 1 parses serially.
+  vtkSetClampMacro(NumberOfParsingThreads, int, 0, VTK_INT_MAX);
+  vtkGetMacro(NumberOfParsingThreads, int);
+
 //BTX
 protected:
   vtkDelimitedTextReader();
   ~vtkDelimitedTextReader();
 
+  int RequestInformation(
+    vtkInformation*,
+    vtkInformationVector**,
+    vtkInformationVector*);
+
   int RequestData(
     vtkInformation*,
     vtkInformationVector**,
     vtkInformationVector*);
 
+  // Read the records of a piece of the input with ChunkedParsing.
+  // Throws std::runtime_error on failure.
+  void ReadChunks(istream& input, vtkTable* output, int piece,
+                  int numberOfPieces);
+
   char* FileName;
   int ReadFromInputString;
   char *InputString;
@@ -291,6 +353,11 @@ protected:
   bool OutputPedigreeIds;
   vtkStdString LastError;
   vtkTypeUInt32 ReplacementCharacter;
+  bool ChunkedParsing;
+  vtkIdType ChunkSize;
+  vtkIdType NumberOfSampleRecords;
+  vtkIdType RecordOffset;
+  int NumberOfParsingThreads;
 
 private:
   vtkDelimitedTextReader(const vtkDelimitedTextReader&); // Not implemented
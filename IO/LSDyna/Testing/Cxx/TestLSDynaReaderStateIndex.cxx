@@ -0,0 +1,168 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestLSDynaReaderStateIndex.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Reads the first and last states of a database without a state index,
+// while writing the index, from the index, and with several threads
+// filling the parts, and checks that the outputs are the same and that
+// the index is written and then used.
+
+#include <vtkCellData.h>
+#include <vtkDataArray.h>
+#include <vtkLSDynaReader.h>
+#include <vtkMultiBlockDataSet.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkTestUtilities.h>
+#include <vtkUnstructuredGrid.h>
+
+#include <vtksys/SystemTools.hxx>
+
+#include <cstdio>
+#include <sstream>
+#include <string>
+
+namespace
+{
+void Summarize(vtkFieldData* fields, std::ostream& os)
+{
+  for (int a = 0; a < fields->GetNumberOfArrays(); ++a)
+    {
+    vtkDataArray* array = fields->GetArray(a);
+    if (!array)
+      {
+      continue;
+      }
+    double sum = 0.0;
+    for (vtkIdType i = 0; i < array->GetNumberOfTuples(); ++i)
+      {
+      for (int c = 0; c < array->GetNumberOfComponents(); ++c)
+        {
+        sum += array->GetComponent(i, c) * (i + 1) * (c + 1);
+        }
+      }
+    os << " " << array->GetName() << " " << sum;
+    }
+}
+
+// Describe the time steps and the blocks read at the given step, and
+// return whether the time steps were read from the index in indexUsed.
+std::string Read(const char* fileName, const char* indexFileName,
+                 int threads, int step, int* indexUsed = 0)
+{
+  std::ostringstream os;
+  os.precision(17);
+  vtkNew<vtkLSDynaReader> reader;
+  reader->SetFileName(fileName);
+  reader->SetStateIndexFileName(indexFileName);
+  reader->SetNumberOfPartThreads(threads);
+  reader->UpdateInformation();
+  if (indexUsed)
+    {
+    *indexUsed = reader->GetStateIndexUsed();
+    }
+  os << "steps";
+  for (vtkIdType i = 0; i < reader->GetNumberOfTimeSteps(); ++i)
+    {
+    os << " " << reader->GetTimeValue(i);
+    }
+  os << "\n";
+  reader->SetTimeStep(step < 0 ? reader->GetNumberOfTimeSteps() - 1 : step);
+  reader->Update();
+
+  vtkMultiBlockDataSet* output = reader->GetOutput();
+  for (unsigned int b = 0; b < output->GetNumberOfBlocks(); ++b)
+    {
+    vtkUnstructuredGrid* grid =
+      vtkUnstructuredGrid::SafeDownCast(output->GetBlock(b));
+    if (!grid)
+      {
+      continue;
+      }
+    os << "block " << b << " cells " << grid->GetNumberOfCells()
+       << " points " << grid->GetNumberOfPoints();
+    double sum = 0.0;
+    for (vtkIdType i = 0; i < grid->GetNumberOfPoints(); ++i)
+      {
+      double* x = grid->GetPoint(i);
+      sum += (x[0] + 3.0 * x[1] + 7.0 * x[2]) * (i + 1);
+      }
+    os << " coordinates " << sum;
+    Summarize(grid->GetPointData(), os);
+    Summarize(grid->GetCellData(), os);
+    os << "\n";
+    }
+  return os.str();
+}
+}
+
+int TestLSDynaReaderStateIndex(int argc, char* argv[])
+{
+  char* fileName = vtkTestUtilities::ExpandDataFileName(
+    argc, argv, "Data/LSDyna/hemi.draw/hemi_draw.d3plot");
+  char* tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  if (!tempDir)
+    {
+    cerr << "Could not determine temporary directory." << endl;
+    delete [] fileName;
+    return EXIT_FAILURE;
+    }
+  std::string indexFileName = tempDir;
+  delete [] tempDir;
+  indexFileName += "/TestLSDynaReaderStateIndex.txt";
+
+  int result = EXIT_SUCCESS;
+  int steps[2] = { 0, -1 };
+  for (int s = 0; s < 2 && result == EXIT_SUCCESS; ++s)
+    {
+    std::string expected = Read(fileName, NULL, 1, steps[s]);
+    const char* names[4] =
+      { "writing the index", "from the index", "with 3 threads",
+        "with the default number of threads" };
+    std::string actual[4];
+    int indexUsed[3] = { -1, -1, -1 };
+    remove(indexFileName.c_str());
+    actual[0] = Read(fileName, indexFileName.c_str(), 1, steps[s],
+                     &indexUsed[0]);
+    if (!vtksys::SystemTools::FileExists(indexFileName.c_str()))
+      {
+      cerr << "The state index was not written" << endl;
+      result = EXIT_FAILURE;
+      }
+    actual[1] = Read(fileName, indexFileName.c_str(), 1, steps[s],
+                     &indexUsed[1]);
+    actual[2] = Read(fileName, indexFileName.c_str(), 3, steps[s],
+                     &indexUsed[2]);
+    actual[3] = Read(fileName, NULL, 0, steps[s]);
+    if (indexUsed[0] != 0 || indexUsed[1] != 1 || indexUsed[2] != 1)
+      {
+      cerr << "The state index was used " << indexUsed[0] << " "
+           << indexUsed[1] << " " << indexUsed[2] << " instead of 0 1 1"
+           << endl;
+      result = EXIT_FAILURE;
+      }
+    for (int i = 0; i < 4; ++i)
+      {
+      if (actual[i] != expected)
+        {
+        cerr << "Wrong output " << names[i] << ":\n" << actual[i]
+             << "instead of:\n" << expected;
+        result = EXIT_FAILURE;
+        }
+      }
+    }
+
+  delete [] fileName;
+  return result;
+}
@@ -800,6 +800,51 @@ void LSDynaFamily::DumpMarks( std::ostream& os )
     }
 }
 
+//-----------------------------------------------------------------------------
+int LSDynaFamily::GetNumberOfAdaptationMarkers() const
+{
+  return (int) this->AdaptationsMarkers.size();
+}
+
+//-----------------------------------------------------------------------------
+LSDynaFamily::LSDynaFamilySectionMark LSDynaFamily::GetSectionMark(
+  int adaptLevel, SectionType m ) const
+{
+  return this->AdaptationsMarkers[adaptLevel].Marks[m];
+}
+
+//-----------------------------------------------------------------------------
+void LSDynaFamily::SetSectionMark( int adaptLevel, SectionType m,
+                                   const LSDynaFamilySectionMark& mark )
+{
+  while ( adaptLevel >= (int) this->AdaptationsMarkers.size() )
+    {
+    this->AdaptationsMarkers.push_back( LSDynaFamilyAdaptLevel() );
+    }
+  this->AdaptationsMarkers[adaptLevel].Marks[m] = mark;
+}
+
+//-----------------------------------------------------------------------------
+vtkIdType LSDynaFamily::GetNumberOfTimeStepMarks() const
+{
+  return (vtkIdType) this->TimeStepMarks.size();
+}
+
+//-----------------------------------------------------------------------------
+LSDynaFamily::LSDynaFamilySectionMark LSDynaFamily::GetTimeStepMark(
+  vtkIdType i ) const
+{
+  return this->TimeStepMarks[i];
+}
+
+//-----------------------------------------------------------------------------
+void LSDynaFamily::AddTimeStepMark( const LSDynaFamilySectionMark& mark,
+                                    int adaptLevel )
+{
+  this->TimeStepMarks.push_back( mark );
+  this->TimeAdaptLevels.push_back( adaptLevel );
+}
+
 //-----------------------------------------------------------------------------
 void LSDynaFamily::CloseFileHandles()
 {
@@ -195,6 +195,16 @@ public:
   /// Print all adaptation and time step marker information.
   void DumpMarks( std::ostream& os );
 
+  /// Get and set the section marks of each adaptation level and the marks
+  /// of the time steps, so that they can be saved and restored instead of
+  /// scanning the database again.
+  int GetNumberOfAdaptationMarkers() const;
+  LSDynaFamilySectionMark GetSectionMark( int adaptLevel, SectionType m ) const;
+  void SetSectionMark( int adaptLevel, SectionType m, const LSDynaFamilySectionMark& mark );
+  vtkIdType GetNumberOfTimeStepMarks() const;
+  LSDynaFamilySectionMark GetTimeStepMark( vtkIdType i ) const;
+  void AddTimeStepMark( const LSDynaFamilySectionMark& mark, int adaptLevel );
+
   //Closes the current file descripter. This is called after
   //we are done reading in request data
   void CloseFileHandles();
@@ -23,16 +23,19 @@
 #include "vtkDoubleArray.h"
 #include "vtkIdTypeArray.h"
 #include "vtkFloatArray.h"
+#include "vtkMultiThreader.h"
 #include "vtkObjectFactory.h"
 #include "vtkPoints.h"
 #include "vtkPointData.h"
+#include "vtkSMPTools.h"
 #include "vtkStringArray.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
 
 #include <algorithm>
-#include <vector>
 #include <list>
+#include <map>
+#include <vector>
 
 //-----------------------------------------------------------------------------
 namespace
@@ -88,6 +91,66 @@ namespace
     std::vector<PartInfo>::iterator pIt;
     vtkIdType numCellsInserted;
     };
+
+  //copies the values of a buffer of point properties to each part that
+  //uses some of the points
+  template<typename T>
+  struct FillPointsFunctor
+    {
+    T* Buffer;
+    vtkIdType NumTuples;
+    vtkIdType NumComps;
+    vtkIdType Offset;
+    vtkLSDynaPart** Parts;
+
+    void operator()(vtkIdType begin, vtkIdType end) const
+    {
+      for(vtkIdType i=begin; i<end; ++i)
+        {
+        this->Parts[i]->ReadPointBasedProperty(this->Buffer,this->NumTuples,
+                                               this->NumComps,this->Offset);
+        }
+    }
+    };
+
+  //copies the runs of cell properties of each part in a buffer, in
+  //order, to the part
+  template<typename T>
+  struct FillCellsFunctor
+    {
+    std::vector<vtkLSDynaPart*> Parts;
+    std::vector<std::vector<std::pair<T*,vtkIdType> > > Runs;
+    int NumPropertiesInCell;
+
+    void operator()(vtkIdType begin, vtkIdType end) const
+    {
+      for(vtkIdType i=begin; i<end; ++i)
+        {
+        for(size_t j=0; j<this->Runs[i].size(); ++j)
+          {
+          this->Parts[i]->ReadCellProperties(this->Runs[i][j].first,
+            this->Runs[i][j].second,this->NumPropertiesInCell);
+          }
+        }
+    }
+    };
+
+  //runs functor over numParts parts, with numThreads threads
+  template<typename Functor>
+  void ForEachPart(vtkIdType numParts, int numThreads, Functor& functor)
+    {
+    if(numThreads == 1 || numParts < 2)
+      {
+      functor(0,numParts);
+      return;
+      }
+    if(numThreads == 0)
+      {
+      numThreads = vtkMultiThreader::GetGlobalDefaultNumberOfThreads();
+      }
+    vtkIdType grain = (numParts + numThreads - 1) / numThreads;
+    vtkSMPTools::For(0,numParts,grain,functor);
+    }
   }
 //-----------------------------------------------------------------------------
 class vtkLSDynaPartCollection::LSDynaPartStorage
@@ -469,6 +532,7 @@ vtkLSDynaPartCollection::vtkLSDynaPartCollection()
   this->Storage = NULL;
   this->MinIds = NULL;
   this->MaxIds = NULL;
+  this->NumberOfThreads = 1;
 }
 
 //-----------------------------------------------------------------------------
@@ -498,6 +562,7 @@ void vtkLSDynaPartCollection::PrintSelf(ostream &os, vtkIndent indent)
 
   //number of parts
   os << indent << "Number of Parts: " << this->GetNumberOfParts() << std::endl;
+  os << indent << "Number of Threads: " << this->NumberOfThreads << std::endl;
 
   //print self for each part
   this->Storage->PrintSelf(os,indent.GetNextIndent());
@@ -675,6 +740,11 @@ void vtkLSDynaPartCollection::FillCellArray(T *buffer,
   vtkIdType numCells, const int& numPropertiesInCell)
 {
   //we only need to iterate the array for the subsection we need
+  //when filling the parts concurrently, the runs of cells of each part are
+  //gathered first so that each part is filled by one thread, in order
+  FillCellsFunctor<T> functor;
+  functor.NumPropertiesInCell = numPropertiesInCell;
+  std::map<vtkLSDynaPart*,vtkIdType> partIndices;
   T* loc = buffer;
   vtkIdType size, globalStartId;
   vtkLSDynaPart *part;
@@ -688,12 +758,26 @@ void vtkLSDynaPartCollection::FillCellArray(T *buffer,
       break;
       }
     vtkIdType is = end - start;
-    if(part)
+    if(part && this->NumberOfThreads == 1)
       {
       part->ReadCellProperties(loc,is,numPropertiesInCell);
       }
+    else if(part)
+      {
+      std::map<vtkLSDynaPart*,vtkIdType>::iterator it =
+        partIndices.insert(std::make_pair(part,
+          static_cast<vtkIdType>(functor.Parts.size()))).first;
+      if(it->second == static_cast<vtkIdType>(functor.Parts.size()))
+        {
+        functor.Parts.push_back(part);
+        functor.Runs.resize(functor.Parts.size());
+        }
+      functor.Runs[it->second].push_back(std::make_pair(loc,is));
+      }
     loc += is * numPropertiesInCell;
     }
+  ForEachPart(static_cast<vtkIdType>(functor.Parts.size()),
+              this->NumberOfThreads,functor);
 }
 
 //-----------------------------------------------------------------------------
@@ -971,6 +1055,11 @@ void vtkLSDynaPartCollection::FillPointProperty(const vtkIdType& numTuples,
   const vtkIdType leftOver(realNumberOfTuples%numPointsToRead);
   const vtkIdType bufferChunkSize(numPointsToRead*numComps);
 
+  //the parts that use points of a buffer are filled concurrently
+  FillPointsFunctor<T> functor;
+  functor.NumComps = numComps;
+  std::vector<vtkLSDynaPart*> bufferParts;
+
   T* buf = NULL;
   p->Fam.SkipWords(numPointsToSkipStart * numComps);
   for(vtkIdType j=0;j<loopTimes;++j,offset+=numPointsToRead)
@@ -988,22 +1077,26 @@ void vtkLSDynaPartCollection::FillPointProperty(const vtkIdType& numTuples,
       partIt = sortedParts.begin();
       }
 
-    while(partIt!=sortedParts.end())
-      {
-      //only read the points which have a point that lies within this section
-      //so we stop once the min is larger than our max id
-      (*partIt)->ReadPointBasedProperty(buf,numPointsToRead,numComps,offset);
-      ++partIt;
-      }
+    //only read the points which have a point that lies within this section
+    bufferParts.assign(partIt,sortedParts.end());
+    functor.Buffer = buf;
+    functor.NumTuples = numPointsToRead;
+    functor.Offset = offset;
+    functor.Parts = bufferParts.empty() ? NULL : &bufferParts[0];
+    ForEachPart(static_cast<vtkIdType>(bufferParts.size()),
+                this->NumberOfThreads,functor);
     }
   if(leftOver>0 && sortedParts.size() > 0)
     {
     p->Fam.BufferChunk(LSDynaFamily::Float, leftOver*numComps);
     buf = p->Fam.GetBufferAs<T>();
-    for (partIt = sortedParts.begin(); partIt!=sortedParts.end();++partIt)
-      {
-      (*partIt)->ReadPointBasedProperty(buf,leftOver,numComps,offset);
-      }
+    bufferParts.assign(sortedParts.begin(),sortedParts.end());
+    functor.Buffer = buf;
+    functor.NumTuples = leftOver;
+    functor.Offset = offset;
+    functor.Parts = bufferParts.empty() ? NULL : &bufferParts[0];
+    ForEachPart(static_cast<vtkIdType>(bufferParts.size()),
+                this->NumberOfThreads,functor);
     }
   p->Fam.SkipWords(numPointsToSkipEnd * numComps);
 }
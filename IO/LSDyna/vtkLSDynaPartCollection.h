@@ -43,6 +43,13 @@ public:
   void InitCollection(LSDynaMetaData *metaData,
     vtkIdType* mins=NULL, vtkIdType* maxs=NULL);
 
+  //Description:
+  //Set/Get the number of threads that fill the parts from each buffer of
+  //state data read. 0 uses vtkMultiThreader's default number of threads,
+  //and the default, 1, fills the parts one after the other.
+  vtkSetClampMacro(NumberOfThreads, int, 0, VTK_INT_MAX);
+  vtkGetMacro(NumberOfThreads, int);
+
 
   //Description:
   //For a given part type returns the number of cells to read and the number
@@ -134,6 +141,8 @@ protected:
   vtkIdType* MinIds;
   vtkIdType* MaxIds;
 
+  int NumberOfThreads;
+
   //Builds up the basic meta information needed for topology storage
   void BuildPartInfo();
 
@@ -527,6 +527,9 @@ vtkLSDynaReader::vtkLSDynaReader()
   this->RemoveDeletedCells = 1;
   this->DeletedCellsAsGhostArray = 0;
   this->InputDeck = 0;
+  this->StateIndexFileName = 0;
+  this->StateIndexUsed = 0;
+  this->NumberOfPartThreads = 1;
   this->Parts = NULL;
 }
 
@@ -534,6 +537,7 @@ vtkLSDynaReader::~vtkLSDynaReader()
 {
   this->ResetPartsCache();
   this->SetInputDeck(0);
+  this->SetStateIndexFileName(0);
   delete this->P;
   this->P = 0;
 }
@@ -544,6 +548,9 @@ void vtkLSDynaReader::PrintSelf( ostream &os, vtkIndent indent )
 
   os << indent << "Title: \"" << this->GetTitle() << "\"" << endl;
   os << indent << "InputDeck: " << (this->InputDeck ? this->InputDeck : "(null)") << endl;
+  os << indent << "StateIndexFileName: " << (this->StateIndexFileName ? this->StateIndexFileName : "(null)") << endl;
+  os << indent << "StateIndexUsed: " << this->StateIndexUsed << endl;
+  os << indent << "NumberOfPartThreads: " << this->NumberOfPartThreads << endl;
   os << indent << "DeformedMesh: " << (this->DeformedMesh ? "On" : "Off") << endl;
   os << indent << "RemoveDeletedCells: " << (this->RemoveDeletedCells ? "On" : "Off") << endl;
   os << indent << "TimeStepRange: " << this->TimeStepRange[0] << ", " << this->TimeStepRange[1] << endl;
@@ -2229,6 +2236,12 @@ int vtkLSDynaReader::ScanDatabaseTimeSteps()
     return 1;
     }
 
+  this->StateIndexUsed = this->StateIndexFileName && this->ReadStateIndex();
+  if ( this->StateIndexUsed )
+    {
+    return -1;
+    }
+
   // Discover the number of states and record the time value for each.
   int ntimesteps = 0;
   double time;
@@ -2283,9 +2296,167 @@ int vtkLSDynaReader::ScanDatabaseTimeSteps()
   this->TimeStepRange[0] = 0;
   this->TimeStepRange[1] = ntimesteps ? ntimesteps - 1 : 0;
 
+  if ( this->StateIndexFileName && ntimesteps > 0 )
+    {
+    this->WriteStateIndex();
+    }
+
   return -1;
 }
 
+// The index starts with this line, followed by the word size and the
+// sizes, modification times and names of the d3plot files it was written
+// for, the control and state section marks of each adaptation level, and
+// the file, offset, adaptation level and time value of each state.
+static const char vtkLSDynaStateIndexHeader[] = "# vtkLSDynaReader state index 2";
+
+int vtkLSDynaReader::ReadStateIndex()
+{
+  LSDynaMetaData* p = this->P;
+  ifstream index( this->StateIndexFileName );
+  if ( ! index.good() )
+    {
+    return 0;
+    }
+
+  std::string line;
+  std::getline( index, line );
+  if ( line != vtkLSDynaStateIndexHeader )
+    {
+    return 0;
+    }
+
+  // Check that the index matches the files of the database.
+  int wordSize;
+  vtkIdType numFiles;
+  index >> wordSize >> numFiles;
+  if ( ! index.good() || wordSize != p->Fam.GetWordSize() ||
+       numFiles != p->Fam.GetNumberOfFiles() )
+    {
+    return 0;
+    }
+  for ( vtkIdType i = 0; i < numFiles; ++i )
+    {
+    vtkIdType fileSize;
+    long modifiedTime;
+    index >> fileSize >> modifiedTime;
+    index.get();
+    std::getline( index, line );
+    std::string fileName = p->Fam.GetFileName( i );
+    if ( ! index.good() || fileSize != p->Fam.GetFileSize( i ) ||
+         modifiedTime != vtksys::SystemTools::ModifiedTime( fileName.c_str() ) ||
+         line != vtksys::SystemTools::GetFilenameName( fileName ) )
+      {
+      return 0;
+      }
+    }
+
+  int numLevels;
+  index >> numLevels;
+  if ( ! index.good() || numLevels < 1 )
+    {
+    return 0;
+    }
+  std::vector<LSDynaFamily::LSDynaFamilySectionMark> controlMarks( numLevels );
+  std::vector<LSDynaFamily::LSDynaFamilySectionMark> stateMarks( numLevels );
+  for ( int level = 0; level < numLevels; ++level )
+    {
+    index >> controlMarks[level].FileNumber >> controlMarks[level].Offset
+          >> stateMarks[level].FileNumber >> stateMarks[level].Offset;
+    }
+
+  vtkIdType numStates;
+  index >> numStates;
+  if ( ! index.good() || numStates < 1 )
+    {
+    return 0;
+    }
+  std::vector<LSDynaFamily::LSDynaFamilySectionMark> marks( numStates );
+  std::vector<int> levels( numStates );
+  std::vector<double> times( numStates );
+  for ( vtkIdType i = 0; i < numStates; ++i )
+    {
+    index >> marks[i].FileNumber >> marks[i].Offset >> levels[i] >> times[i];
+    if ( index.fail() || levels[i] < 0 || levels[i] >= numLevels )
+      {
+      return 0;
+      }
+    }
+
+  // Read the headers of the other adaptation levels, as scanning the
+  // states would when reaching them, then restore the marks.
+  for ( int level = 1; level < numLevels; ++level )
+    {
+    p->Fam.SetSectionMark( level, LSDynaFamily::ControlSection, controlMarks[level] );
+    this->ReadHeaderInformation( level );
+    }
+  for ( int level = 0; level < numLevels; ++level )
+    {
+    p->Fam.SetSectionMark( level, LSDynaFamily::TimeStepSection, stateMarks[level] );
+    }
+  for ( vtkIdType i = 0; i < numStates; ++i )
+    {
+    p->Fam.AddTimeStepMark( marks[i], levels[i] );
+    p->TimeValues.push_back( times[i] );
+    }
+
+  this->TimeStepRange[0] = 0;
+  this->TimeStepRange[1] = numStates - 1;
+  return 1;
+}
+
+int vtkLSDynaReader::WriteStateIndex()
+{
+  LSDynaMetaData* p = this->P;
+  ofstream index( this->StateIndexFileName );
+  if ( ! index.good() )
+    {
+    vtkWarningMacro( "Could not write the state index " << this->StateIndexFileName );
+    return 0;
+    }
+
+  index << vtkLSDynaStateIndexHeader << "\n";
+  index << p->Fam.GetWordSize() << " " << p->Fam.GetNumberOfFiles() << "\n";
+  for ( vtkIdType i = 0; i < p->Fam.GetNumberOfFiles(); ++i )
+    {
+    std::string fileName = p->Fam.GetFileName( i );
+    index << p->Fam.GetFileSize( i ) << " "
+          << vtksys::SystemTools::ModifiedTime( fileName.c_str() ) << " "
+          << vtksys::SystemTools::GetFilenameName( fileName ) << "\n";
+    }
+
+  int numLevels = p->Fam.GetNumberOfAdaptationMarkers();
+  index << numLevels << "\n";
+  for ( int level = 0; level < numLevels; ++level )
+    {
+    LSDynaFamily::LSDynaFamilySectionMark control =
+      p->Fam.GetSectionMark( level, LSDynaFamily::ControlSection );
+    LSDynaFamily::LSDynaFamilySectionMark state =
+      p->Fam.GetSectionMark( level, LSDynaFamily::TimeStepSection );
+    index << control.FileNumber << " " << control.Offset << " "
+          << state.FileNumber << " " << state.Offset << "\n";
+    }
+
+  // Time values are written with enough digits to be read back exactly.
+  index.precision( 17 );
+  vtkIdType numStates = p->Fam.GetNumberOfTimeStepMarks();
+  index << numStates << "\n";
+  for ( vtkIdType i = 0; i < numStates; ++i )
+    {
+    LSDynaFamily::LSDynaFamilySectionMark mark = p->Fam.GetTimeStepMark( i );
+    index << mark.FileNumber << " " << mark.Offset << " "
+          << p->Fam.TimeAdaptLevel( i ) << " " << p->TimeValues[i] << "\n";
+    }
+
+  index.close();
+  if ( index.fail() )
+    {
+    vtkWarningMacro( "Could not write the state index " << this->StateIndexFileName );
+    return 0;
+    }
+  return 1;
+}
+
 // =================================== Provide information about the database to the pipeline
 int vtkLSDynaReader::RequestInformation( vtkInformation* vtkNotUsed(request),
                                          vtkInformationVector** vtkNotUsed(iinfo),
@@ -3467,6 +3638,7 @@ int vtkLSDynaReader::RequestData(
 
   //Read in the topology information for caching
   this->ReadTopology();
+  this->Parts->SetNumberOfThreads(this->NumberOfPartThreads);
 
   // Adapted element parent list
   // This isn't even implemented by LS-Dyna yet
@@ -439,6 +439,34 @@ public:
   vtkSetStringMacro(InputDeck);
   vtkGetStringMacro(InputDeck);
 
+  // Description:
+  // The name of a file indexing the time steps of the current database.
+  // Finding the time steps otherwise requires visiting every state of
+  // every d3plot file.  When the index was written for the same d3plot
+  // files (same names, sizes, modification times and word size), the time
+  // values and the location of each state are read from it instead.
+  // Otherwise the states are scanned and the index is written, if write
+  // permissions exist.  The default, NULL, always scans the states.
+  vtkSetStringMacro(StateIndexFileName);
+  vtkGetStringMacro(StateIndexFileName);
+
+  // Description:
+  // Whether the time steps of the current database were read from the
+  // state index rather than found by scanning the states.
+  vtkGetMacro(StateIndexUsed, int);
+
+  // Description:
+  // The number of batches the parts are split into to copy their state
+  // data out of the d3plot files concurrently.  This is the grain of
+  // vtkSMPTools::For, not a number of threads: the SMP backend decides how
+  // many threads run the batches.  The files are still read one chunk at
+  // a time, and the parts are filled from each chunk, so the output does
+  // not depend on this setting.  0 makes as many batches as
+  // vtkMultiThreader's default number of threads.  The default is 1,
+  // which fills the parts one after the other.
+  vtkSetClampMacro(NumberOfPartThreads, int, 0, VTK_INT_MAX);
+  vtkGetMacro(NumberOfPartThreads, int);
+
   // Description:
   // These methods allow you to load only selected parts of the input.
   // If InputDeck points to a valid keyword file (or summary), then part
@@ -479,6 +507,10 @@ protected:
   // The name of a file containing part names and IDs.
   char* InputDeck;
 
+  char* StateIndexFileName;
+  int StateIndexUsed;
+  int NumberOfPartThreads;
+
   vtkLSDynaReader();
   virtual ~vtkLSDynaReader();
 
@@ -501,6 +533,14 @@ protected:
   // Upon success, -1 is returned. "Soft" failures return 0 and "hard" failures return 1.
   int ScanDatabaseTimeSteps();
 
+  // Description:
+  // Restore the time values and the state marks from StateIndexFileName,
+  // or save them there after scanning the database.  Both return 1 on
+  // success and 0 otherwise; nothing is restored from an index that does
+  // not match the current database.
+  int ReadStateIndex();
+  int WriteStateIndex();
+
   virtual int RequestInformation( vtkInformation*, vtkInformationVector**, vtkInformationVector* );
   virtual int RequestData( vtkInformation*, vtkInformationVector**, vtkInformationVector* );
 
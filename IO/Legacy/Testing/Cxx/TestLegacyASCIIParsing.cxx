@@ -0,0 +1,138 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestLegacyASCIIParsing.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that the numbers of ASCII legacy files are read exactly as
+// operator>> reads them, including those the fast parser leaves to it.
+
+#include "vtkDataArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataReader.h"
+
+#include <vtksys/ios/sstream>
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+namespace
+{
+const char* Reals[] =
+{
+  "0", "-0", "1", "-1", "+7", "0.1", ".5", "5.", "-2.5E+3", "1e-30",
+  "3.4028234e38", "1.17549435e-38", "1e-40", "7.038531e-26",
+  "123456789012345678901234", "0.30000000000000004", "9007199254740993",
+  "0.000001", "16777217", "-33554431.0", "1.000000000000000000000001"
+};
+
+const char* Integers[] =
+{
+  "0", "-0", "7", "+12", "007", "-2147483648", "2147483647", "-1",
+  "123456789", "-987654321"
+};
+}
+
+int TestLegacyASCIIParsing(int, char *[])
+{
+  std::vector<std::string> reals(Reals, Reals + sizeof(Reals)/sizeof(Reals[0]));
+  vtkMath::RandomSeed(1234);
+  char buffer[64];
+  for (int i = 0; i < 2000; ++i)
+    {
+    double value = vtkMath::Random(-1.0, 1.0) *
+      pow(10.0, static_cast<int>(vtkMath::Random(-30.0, 30.0)));
+    sprintf(buffer, i % 3 == 0 ? "%.6g" : i % 3 == 1 ? "%.9g" : "%.17g",
+            value);
+    reals.push_back(buffer);
+    }
+  std::vector<std::string> integers(
+    Integers, Integers + sizeof(Integers)/sizeof(Integers[0]));
+  size_t numPoints = reals.size();
+  size_t numIntegers = integers.size();
+
+  // One coordinate and one scalar per real, over irregular lines.
+  vtksys_ios::ostringstream file;
+  file << "# vtk DataFile Version 3.0\nnumbers\nASCII\nDATASET POLYDATA\n"
+       << "POINTS " << numPoints << " float\n";
+  for (size_t i = 0; i < numPoints; ++i)
+    {
+    file << reals[i] << " 0 0" << (i % 4 == 3 ? "\n" : " \t ");
+    }
+  file << "\nPOINT_DATA " << numPoints
+       << "\nSCALARS reals double 1\nLOOKUP_TABLE default\n";
+  for (size_t i = 0; i < numPoints; ++i)
+    {
+    file << reals[i] << (i % 7 == 6 ? "\r\n" : " ");
+    }
+  file << "\nFIELD FieldData 1\nintegers 1 " << numIntegers << " int\n";
+  for (size_t i = 0; i < numIntegers; ++i)
+    {
+    file << integers[i] << "\n";
+    }
+
+  vtkNew<vtkPolyDataReader> reader;
+  reader->ReadFromInputStringOn();
+  reader->SetInputString(file.str());
+  reader->Update();
+  vtkPolyData* output = reader->GetOutput();
+  vtkDataArray* scalars = output->GetPointData()->GetArray("reals");
+  vtkDataArray* ints = output->GetPointData()->GetArray("integers");
+  if (output->GetNumberOfPoints() != static_cast<vtkIdType>(numPoints) ||
+      !scalars || !ints ||
+      scalars->GetNumberOfTuples() != static_cast<vtkIdType>(numPoints) ||
+      ints->GetNumberOfTuples() != static_cast<vtkIdType>(numIntegers))
+    {
+    cerr << "Missing or truncated data" << endl;
+    return EXIT_FAILURE;
+    }
+
+  for (size_t i = 0; i < numPoints; ++i)
+    {
+    float f = 0;
+    double d = 0;
+    vtksys_ios::istringstream fs(reals[i]);
+    vtksys_ios::istringstream ds(reals[i]);
+    fs >> f;
+    ds >> d;
+    if (static_cast<float>(output->GetPoint(i)[0]) != f)
+      {
+      cerr << "Wrong float read from " << reals[i] << ": "
+           << output->GetPoint(i)[0] << " instead of " << f << endl;
+      return EXIT_FAILURE;
+      }
+    if (scalars->GetTuple1(i) != d)
+      {
+      cerr << "Wrong double read from " << reals[i] << ": "
+           << scalars->GetTuple1(i) << " instead of " << d << endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  for (size_t i = 0; i < numIntegers; ++i)
+    {
+    int expected = 0;
+    vtksys_ios::istringstream is(integers[i]);
+    is >> expected;
+    if (ints->GetTuple1(i) != expected)
+      {
+      cerr << "Wrong integer read from " << integers[i] << endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -53,8 +53,14 @@
 #endif
 
 #include <ctype.h>
+#include <float.h>
+#include <math.h>
+#include <string.h>
 #include <sys/stat.h>
 
+#include <limits>
+#include <string>
+
 // I need a safe way to read a line of arbitrary length.  It exists on
 // some platforms but not others so I'm afraid I have to write it
 // myself.
@@ -268,13 +274,278 @@ int vtkDataReader::ReadString(char result[256])
   return 1;
 }
 
+//----------------------------------------------------------------------------
+// ASCII numbers are parsed directly from the stream buffer instead of with
+// operator>>, whose sentry and locale facets dominate the time spent reading
+// large ASCII files.  Values the fast paths cannot convert exactly are
+// still converted by operator>>.
+namespace
+{
+// The characters isspace() accepts in the "C" locale.
+inline bool vtkDataReaderIsSpace(int c)
+{
+  return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+// A whitespace-delimited word of the stream.
+class vtkDataReaderToken
+{
+public:
+  // Extract the next token, setting the stream state as operator>> would.
+  // Returns false if there is none.
+  bool Extract(istream* is)
+    {
+    typedef std::streambuf::traits_type traits;
+    if (!is->good())
+      {
+      is->setstate(ios::failbit);
+      return false;
+      }
+    std::streambuf* sb = is->rdbuf();
+    int c = sb->sgetc();
+    while (c != traits::eof() && vtkDataReaderIsSpace(c))
+      {
+      c = sb->snextc();
+      }
+    if (c == traits::eof())
+      {
+      is->setstate(ios::eofbit | ios::failbit);
+      return false;
+      }
+    this->Length = 0;
+    this->Long.clear();
+    do
+      {
+      if (this->Length < sizeof(this->Short))
+        {
+        this->Short[this->Length++] = static_cast<char>(c);
+        }
+      else
+        {
+        if (this->Long.empty())
+          {
+          this->Long.assign(this->Short, this->Length);
+          }
+        this->Long += static_cast<char>(c);
+        }
+      c = sb->snextc();
+      }
+    while (c != traits::eof() && !vtkDataReaderIsSpace(c));
+    if (c == traits::eof())
+      {
+      is->setstate(ios::eofbit);
+      }
+    return true;
+    }
+
+  const char* Begin() const
+    {
+    return this->Long.empty() ? this->Short : this->Long.c_str();
+    }
+  const char* End() const
+    {
+    return this->Long.empty() ? this->Short + this->Length :
+      this->Long.c_str() + this->Long.size();
+    }
+
+private:
+  char Short[64];
+  size_t Length;
+  std::string Long;
+};
+
+// Parse a decimal integer that fits in 18 digits and in T.
+template <class T>
+bool vtkDataReaderParse(const char* s, const char* end, T* result)
+{
+  bool negative = false;
+  if (s != end && (*s == '-' || *s == '+'))
+    {
+    negative = (*s++ == '-');
+    }
+  if (s == end || end - s > 18)
+    {
+    return false;
+    }
+  vtkTypeUInt64 value = 0;
+  for (; s != end; ++s)
+    {
+    unsigned int digit = static_cast<unsigned int>(*s - '0');
+    if (digit > 9)
+      {
+      return false;
+      }
+    value = value * 10 + digit;
+    }
+  if (negative)
+    {
+    if (!std::numeric_limits<T>::is_signed || value >
+        static_cast<vtkTypeUInt64>(std::numeric_limits<T>::max()) + 1)
+      {
+      return false;
+      }
+    *result = static_cast<T>(-static_cast<vtkTypeInt64>(value));
+    }
+  else
+    {
+    if (value > static_cast<vtkTypeUInt64>(std::numeric_limits<T>::max()))
+      {
+      return false;
+      }
+    *result = static_cast<T>(value);
+    }
+  return true;
+}
+
+// Parse a decimal number whose significand and power of ten are both
+// exactly representable as doubles, so that a single multiplication or
+// division rounds it correctly.
+bool vtkDataReaderParse(const char* s, const char* end, double* result)
+{
+  static const double powers[23] =
+    {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+  bool negative = false;
+  if (s != end && (*s == '-' || *s == '+'))
+    {
+    negative = (*s++ == '-');
+    }
+
+  vtkTypeUInt64 significand = 0;
+  int digits = 0;
+  int exponent = 0;
+  bool any = false;
+  bool fraction = false;
+  for (; s != end; ++s)
+    {
+    if (*s == '.' && !fraction)
+      {
+      fraction = true;
+      continue;
+      }
+    unsigned int digit = static_cast<unsigned int>(*s - '0');
+    if (digit > 9)
+      {
+      break;
+      }
+    any = true;
+    if ((digits > 0 || digit > 0) && ++digits > 19)
+      {
+      return false;
+      }
+    significand = significand * 10 + digit;
+    if (fraction)
+      {
+      --exponent;
+      }
+    }
+  if (!any)
+    {
+    return false;
+    }
+
+  if (s != end && (*s == 'e' || *s == 'E'))
+    {
+    ++s;
+    bool negativeExponent = false;
+    if (s != end && (*s == '-' || *s == '+'))
+      {
+      negativeExponent = (*s++ == '-');
+      }
+    if (s == end || end - s > 4)
+      {
+      return false;
+      }
+    int value = 0;
+    for (; s != end; ++s)
+      {
+      unsigned int digit = static_cast<unsigned int>(*s - '0');
+      if (digit > 9)
+        {
+        return false;
+        }
+      value = value * 10 + static_cast<int>(digit);
+      }
+    exponent += negativeExponent ? -value : value;
+    }
+  if (s != end)
+    {
+    return false;
+    }
+
+  double value = static_cast<double>(significand);
+  if (significand != 0)
+    {
+    if (significand > (static_cast<vtkTypeUInt64>(1) << 53) ||
+        exponent < -22 || exponent > 22)
+      {
+      return false;
+      }
+    value = exponent < 0 ? value / powers[-exponent] :
+      value * powers[exponent];
+    }
+  *result = negative ? -value : value;
+  return true;
+}
+
+bool vtkDataReaderParse(const char* s, const char* end, float* result)
+{
+  double value;
+  if (!vtkDataReaderParse(s, end, &value))
+    {
+    return false;
+    }
+  // Rounding the correctly rounded double to float gives the correctly
+  // rounded float unless the double lies exactly halfway between two
+  // floats.  Denormal and out of range floats are left to operator>>.
+  double magnitude = fabs(value);
+  if (magnitude != 0.0 && (magnitude < FLT_MIN || magnitude > FLT_MAX))
+    {
+    return false;
+    }
+  vtkTypeUInt64 bits;
+  memcpy(&bits, &value, sizeof(bits));
+  if ((bits & 0x1FFFFFFF) == 0x10000000)
+    {
+    return false;
+    }
+  *result = static_cast<float>(value);
+  return true;
+}
+
+template <class T>
+int vtkDataReaderReadValue(istream* is, T* result)
+{
+  vtkDataReaderToken token;
+  if (!token.Extract(is))
+    {
+    return 0;
+    }
+  if (vtkDataReaderParse(token.Begin(), token.End(), result))
+    {
+    return 1;
+    }
+  vtksys_ios::istringstream str(std::string(token.Begin(), token.End()));
+  str.imbue(is->getloc());
+  str >> *result;
+  if (str.fail())
+    {
+    is->setstate(ios::failbit);
+    return 0;
+    }
+  return 1;
+}
+}
+
 // Internal function to read in an integer value.
 // Returns zero if there was an error.
 int vtkDataReader::Read(char *result)
 {
   int intData;
-  *this->IS >> intData;
-  if (this->IS->fail())
+  if (!vtkDataReaderReadValue(this->IS, &intData))
     {
     return 0;
     }
@@ -286,8 +557,7 @@ int vtkDataReader::Read(char *result)
 int vtkDataReader::Read(unsigned char *result)
 {
   int intData;
-  *this->IS >> intData;
-  if (this->IS->fail())
+  if (!vtkDataReaderReadValue(this->IS, &intData))
     {
     return 0;
     }
@@ -298,126 +568,66 @@ int vtkDataReader::Read(unsigned char *result)
 
 int vtkDataReader::Read(short *result)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
-    {
-    return 0;
-    }
-  return 1;
+  return vtkDataReaderReadValue(this->IS, result);
 }
 
 int vtkDataReader::Read(unsigned short *result)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
-    {
-    return 0;
-    }
-  return 1;
+  return vtkDataReaderReadValue(this->IS, result);
 }
 
 int vtkDataReader::Read(int *result)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
-    {
-    return 0;
-    }
-  return 1;
+  return vtkDataReaderReadValue(this->IS, result);
 }
 
 int vtkDataReader::Read(unsigned int *result)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
-    {
-    return 0;
-    }
-  return 1;
+  return vtkDataReaderReadValue(this->IS, result);
 }
 
 int vtkDataReader::Read(long *result)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
-    {
-    return 0;
-    }
-  return 1;
+  return vtkDataReaderReadValue(this->IS, result);
 }
 
 int vtkDataReader::Read(unsigned long *result)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
-    {
-    return 0;
-    }
-  return 1;
+  return vtkDataReaderReadValue(this->IS, result);
 }
 
 #if defined(VTK_TYPE_USE___INT64)
 int vtkDataReader::Read(__int64 *result)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
-    {
-    return 0;
-    }
-  return 1;
+  return vtkDataReaderReadValue(this->IS, result);
 }
 
 int vtkDataReader::Read(unsigned __int64 *result)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
-    {
-    return 0;
-    }
-  return 1;
+  return vtkDataReaderReadValue(this->IS, result);
 }
 #endif
 
 #if defined(VTK_TYPE_USE_LONG_LONG)
 int vtkDataReader::Read(long long *result)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
-    {
-    return 0;
-    }
-  return 1;
+  return vtkDataReaderReadValue(this->IS, result);
 }
 
 int vtkDataReader::Read(unsigned long long *result)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
-    {
-    return 0;
-    }
-  return 1;
+  return vtkDataReaderReadValue(this->IS, result);
 }
 #endif
 
 int vtkDataReader::Read(float *result)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
-    {
-    return 0;
-    }
-  return 1;
+  return vtkDataReaderReadValue(this->IS, result);
 }
 
 int vtkDataReader::Read(double *result)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
-    {
-    return 0;
-    }
-  return 1;
+  return vtkDataReaderReadValue(this->IS, result);
 }
 
 
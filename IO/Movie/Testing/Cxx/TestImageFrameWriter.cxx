@@ -0,0 +1,143 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImageFrameWriter.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Writes an animation as PNG and JPEG frames on worker threads, with a
+// queue shorter than the number of workers, and checks that every file is
+// identical to the one written by vtkPNGWriter or vtkJPEGWriter for the
+// same frame, also with a file pattern whose expansion is much longer
+// than the pattern.
+
+#include <vtkImageData.h>
+#include <vtkImageFrameWriter.h>
+#include <vtkImageWriter.h>
+#include <vtkJPEGWriter.h>
+#include <vtkNew.h>
+#include <vtkPNGWriter.h>
+#include <vtkTestUtilities.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+namespace
+{
+void MakeFrame(vtkImageData* image, int frame)
+{
+  for (int j = 0; j < 48; ++j)
+    {
+    for (int i = 0; i < 64; ++i)
+      {
+      unsigned char* pixel =
+        static_cast<unsigned char*>(image->GetScalarPointer(i, j, 0));
+      pixel[0] = static_cast<unsigned char>(4 * i + 9 * frame);
+      pixel[1] = static_cast<unsigned char>(5 * j);
+      pixel[2] = static_cast<unsigned char>((i * j + 20 * frame) % 256);
+      }
+    }
+  image->Modified();
+}
+
+std::string ReadFile(const std::string& fileName)
+{
+  std::ifstream file(fileName.c_str(), std::ios::in | std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(file),
+                     std::istreambuf_iterator<char>());
+}
+}
+
+int TestImageFrameWriter(int argc, char* argv[])
+{
+  char* tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  if (!tempDir)
+    {
+    cerr << "Could not determine temporary directory." << endl;
+    return EXIT_FAILURE;
+    }
+  std::string prefix = tempDir;
+  delete [] tempDir;
+  std::string referenceName = prefix + "/TestImageFrameWriterReference";
+  prefix += "/TestImageFrameWriter";
+
+  const int numberOfFrames = 12;
+  vtkNew<vtkImageData> image;
+  image->SetExtent(0, 63, 0, 47, 0, 0);
+  image->AllocateScalars(VTK_UNSIGNED_CHAR, 3);
+
+  vtkNew<vtkPNGWriter> pngWriter;
+  vtkNew<vtkJPEGWriter> jpegWriter;
+  jpegWriter->SetQuality(80);
+  vtkImageWriter* referenceWriters[2] = { pngWriter.GetPointer(),
+                                          jpegWriter.GetPointer() };
+  const char* extensions[2] = { "png", "jpg" };
+  int threads[2] = { 3, 0 };
+  for (int format = 0; format < 2; ++format)
+    {
+    vtkNew<vtkImageFrameWriter> writer;
+    writer->SetInputData(image.GetPointer());
+    writer->SetFileName(prefix.c_str());
+    writer->SetFormat(format);
+    writer->SetQuality(80);
+    writer->SetNumberOfEncodingThreads(threads[format]);
+    writer->SetMaximumNumberOfQueuedFrames(2);
+    writer->Start();
+    for (int frame = 0; frame < numberOfFrames; ++frame)
+      {
+      // The frame is copied, so it can change as soon as Write() returns.
+      MakeFrame(image.GetPointer(), frame);
+      writer->Write();
+      }
+    writer->End();
+    if (writer->GetError() || writer->GetNumberOfFrames() != numberOfFrames)
+      {
+      cerr << "Error writing " << extensions[format] << " frames" << endl;
+      return EXIT_FAILURE;
+      }
+
+    referenceWriters[format]->SetInputData(image.GetPointer());
+    for (int frame = 0; frame < numberOfFrames; ++frame)
+      {
+      MakeFrame(image.GetPointer(), frame);
+      char name[32];
+      sprintf(name, "%04d.%s", frame, extensions[format]);
+      std::string reference = referenceName + "." + extensions[format];
+      referenceWriters[format]->SetFileName(reference.c_str());
+      referenceWriters[format]->Write();
+      std::string actual = ReadFile(prefix + name);
+      if (actual.empty() || actual != ReadFile(reference))
+        {
+        cerr << "Wrong file " << prefix + name << endl;
+        return EXIT_FAILURE;
+        }
+      }
+    }
+
+  // A pattern can make names much longer than itself.
+  vtkNew<vtkImageFrameWriter> writer;
+  writer->SetInputData(image.GetPointer());
+  writer->SetFileName(prefix.c_str());
+  writer->SetFilePattern("%s%0150d.png");
+  writer->Start();
+  writer->Write();
+  writer->End();
+  std::string longName = prefix + std::string(150, '0') + ".png";
+  if (writer->GetError() || ReadFile(longName).empty())
+    {
+    cerr << "Could not write " << longName << endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -12,8 +12,11 @@ vtk_module(vtkIOMovie
     vtkCommonSystem
     vtkIOCore
     ${vtkIOMovie_vtkoggtheora}
+  PRIVATE_DEPENDS
+    vtkIOImage
   TEST_DEPENDS
     vtkTestingCore
+    vtkIOImage
     vtkImagingCore
     vtkImagingSources
   KIT
@@ -0,0 +1,464 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkImageFrameWriter.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkImageFrameWriter.h"
+
+#include "vtkConditionVariable.h"
+#include "vtkErrorCode.h"
+#include "vtkImageData.h"
+#include "vtkJPEGWriter.h"
+#include "vtkMultiThreader.h"
+#include "vtkMutexLock.h"
+#include "vtkObjectFactory.h"
+#include "vtkPNGWriter.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+#if _MSC_VER
+#define snprintf _snprintf
+#endif
+
+vtkStandardNewMacro(vtkImageFrameWriter);
+
+// The longest file name built from FilePattern.
+static const size_t vtkImageFrameWriterMaximumFileNameSize = 65536;
+
+//----------------------------------------------------------------------------
+// The frames and files shared by the main thread and the workers.  Lock
+// must be held to access any member but the encoders, each of which is
+// used by one worker only.
+class vtkImageFrameWriter::vtkInternals
+{
+public:
+  struct Frame
+  {
+    int Number;
+    std::string FileName;
+    vtkImageData *Image;
+  };
+
+  struct EncodedFrame
+  {
+    std::string FileName;
+    std::vector<unsigned char> Bytes;
+    bool Encoded;
+  };
+
+  vtkInternals() : Done(false), Writing(false), NextEncoder(0),
+    NextFrameToWrite(0), NumberOfPendingFrames(0)
+  {
+  }
+
+  ~vtkInternals()
+  {
+    for (size_t i = 0; i < this->Queue.size(); ++i)
+      {
+      this->Queue[i].Image->Delete();
+      }
+  }
+
+  vtkSmartPointer<vtkMultiThreader> Threader;
+  std::vector<int> ThreadIds;
+  std::vector<vtkSmartPointer<vtkImageWriter> > Encoders;
+
+  vtkSimpleMutexLock Lock;
+  // Signaled when a frame is queued, or when the workers must stop.
+  vtkSimpleConditionVariable FrameQueued;
+  // Signaled when a frame is written.
+  vtkSimpleConditionVariable FrameWritten;
+
+  bool Done;
+  bool Writing;
+  size_t NextEncoder;
+  int NextFrameToWrite;
+  int NumberOfPendingFrames;
+  std::deque<Frame> Queue;
+  std::map<int, EncodedFrame> Encoded;
+  std::vector<std::string> FailedFiles;
+
+  // The function run by the workers: encode the queued frames until Done.
+  static VTK_THREAD_RETURN_TYPE Work(void *arg);
+
+  // Write the encoded frames that follow the last one written, in order.
+  // Called with Lock held by the worker that is not able to find another
+  // worker already doing it; the lock is released while writing a file.
+  void WriteEncodedFrames();
+};
+
+//----------------------------------------------------------------------------
+void vtkImageFrameWriter::vtkInternals::WriteEncodedFrames()
+{
+  this->Writing = true;
+  std::map<int, EncodedFrame>::iterator iter;
+  while ((iter = this->Encoded.find(this->NextFrameToWrite)) !=
+         this->Encoded.end())
+    {
+    EncodedFrame frame;
+    frame.FileName.swap(iter->second.FileName);
+    frame.Bytes.swap(iter->second.Bytes);
+    frame.Encoded = iter->second.Encoded;
+    this->Encoded.erase(iter);
+    this->Lock.Unlock();
+
+    bool written = false;
+    if (frame.Encoded)
+      {
+      FILE *file = fopen(frame.FileName.c_str(), "wb");
+      if (file)
+        {
+        written = (fwrite(&frame.Bytes[0], 1, frame.Bytes.size(), file) ==
+                   frame.Bytes.size());
+        written = (fclose(file) == 0 && written);
+        }
+      }
+
+    this->Lock.Lock();
+    if (!written)
+      {
+      this->FailedFiles.push_back(frame.FileName);
+      }
+    this->NextFrameToWrite++;
+    this->NumberOfPendingFrames--;
+    this->FrameWritten.Broadcast();
+    }
+  this->Writing = false;
+}
+
+//----------------------------------------------------------------------------
+VTK_THREAD_RETURN_TYPE vtkImageFrameWriter::vtkInternals::Work(void *arg)
+{
+  vtkMultiThreader::ThreadInfo *info =
+    static_cast<vtkMultiThreader::ThreadInfo *>(arg);
+  vtkInternals *internals = static_cast<vtkInternals *>(info->UserData);
+
+  internals->Lock.Lock();
+  vtkImageWriter *encoder = internals->Encoders[internals->NextEncoder++];
+  while (true)
+    {
+    while (internals->Queue.empty() && !internals->Done)
+      {
+      internals->FrameQueued.Wait(internals->Lock);
+      }
+    if (internals->Queue.empty())
+      {
+      break;
+      }
+    Frame frame = internals->Queue.front();
+    internals->Queue.pop_front();
+    internals->Lock.Unlock();
+
+    // Compress the frame in memory.  The result of the encoder is copied,
+    // because the encoder keeps a reference to it.
+    EncodedFrame encoded;
+    encoded.FileName = frame.FileName;
+    encoder->SetInputData(frame.Image);
+    encoder->Write();
+    encoder->SetInputData(NULL);
+    frame.Image->Delete();
+    vtkUnsignedCharArray *result = NULL;
+    if (vtkPNGWriter *png = vtkPNGWriter::SafeDownCast(encoder))
+      {
+      result = png->GetResult();
+      }
+    else
+      {
+      result = static_cast<vtkJPEGWriter *>(encoder)->GetResult();
+      }
+    encoded.Encoded = (encoder->GetErrorCode() == vtkErrorCode::NoError &&
+                       result && result->GetNumberOfTuples() > 0);
+    if (encoded.Encoded)
+      {
+      encoded.Bytes.assign(result->GetPointer(0),
+                           result->GetPointer(0) + result->GetNumberOfTuples());
+      }
+
+    internals->Lock.Lock();
+    EncodedFrame &stored = internals->Encoded[frame.Number];
+    stored.FileName.swap(encoded.FileName);
+    stored.Bytes.swap(encoded.Bytes);
+    stored.Encoded = encoded.Encoded;
+    if (!internals->Writing)
+      {
+      internals->WriteEncodedFrames();
+      }
+    }
+  internals->Lock.Unlock();
+
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+//----------------------------------------------------------------------------
+vtkImageFrameWriter::vtkImageFrameWriter()
+{
+  this->Format = PNG;
+  this->FilePattern = NULL;
+  this->CompressionLevel = 5;
+  this->Quality = 95;
+  this->NumberOfEncodingThreads = 0;
+  this->MaximumNumberOfQueuedFrames = 16;
+  this->NumberOfFrames = 0;
+  this->Internals = NULL;
+}
+
+//----------------------------------------------------------------------------
+vtkImageFrameWriter::~vtkImageFrameWriter()
+{
+  if (this->Internals)
+    {
+    this->End();
+    }
+  this->SetFilePattern(NULL);
+}
+
+//----------------------------------------------------------------------------
+void vtkImageFrameWriter::Start()
+{
+  this->Error = 1;
+
+  if (this->Internals)
+    {
+    vtkErrorMacro("Movie already started.");
+    this->SetErrorCode(vtkGenericMovieWriter::InitError);
+    return;
+    }
+  if (this->GetInput() == NULL)
+    {
+    vtkErrorMacro("Please specify an input.");
+    this->SetErrorCode(vtkGenericMovieWriter::NoInputError);
+    return;
+    }
+  if (!this->FileName)
+    {
+    vtkErrorMacro("Please specify a filename.");
+    this->SetErrorCode(vtkErrorCode::NoFileNameError);
+    return;
+    }
+
+  int numberOfThreads = this->NumberOfEncodingThreads;
+  if (numberOfThreads == 0)
+    {
+    numberOfThreads = vtkMultiThreader::GetGlobalDefaultNumberOfThreads();
+    }
+
+  // The encoders are created here rather than by the workers, so that the
+  // workers only run the pipelines of their own encoder and frames.
+  this->Internals = new vtkInternals;
+  for (int i = 0; i < numberOfThreads; ++i)
+    {
+    vtkSmartPointer<vtkImageWriter> encoder;
+    if (this->Format == JPEG)
+      {
+      vtkJPEGWriter *jpeg = vtkJPEGWriter::New();
+      jpeg->WriteToMemoryOn();
+      jpeg->SetQuality(this->Quality);
+      encoder.TakeReference(jpeg);
+      }
+    else
+      {
+      vtkPNGWriter *png = vtkPNGWriter::New();
+      png->WriteToMemoryOn();
+      png->SetCompressionLevel(this->CompressionLevel);
+      encoder.TakeReference(png);
+      }
+    this->Internals->Encoders.push_back(encoder);
+    }
+
+  this->Internals->Threader = vtkSmartPointer<vtkMultiThreader>::New();
+  for (int i = 0; i < numberOfThreads; ++i)
+    {
+    this->Internals->ThreadIds.push_back(this->Internals->Threader->SpawnThread(
+      vtkInternals::Work, this->Internals));
+    }
+
+  this->NumberOfFrames = 0;
+  this->Error = 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkImageFrameWriter::Write()
+{
+  if (this->Error)
+    {
+    return;
+    }
+
+  if (!this->Internals)
+    {
+    vtkErrorMacro("Movie not started.");
+    this->Error = 1;
+    this->SetErrorCode(vtkGenericMovieWriter::InitError);
+    return;
+    }
+
+  // get the data
+  vtkImageData *input = this->GetImageDataInput(0);
+  this->GetInputAlgorithm(0, 0)->UpdateWholeExtent();
+
+  // Check the input here, so that the encoders never fail on it.
+  int extent[6];
+  input->GetExtent(extent);
+  int scalarType = input->GetScalarType();
+  int components = input->GetNumberOfScalarComponents();
+  bool valid = (extent[4] == extent[5] && extent[0] <= extent[1] &&
+                extent[2] <= extent[3] && input->GetScalarPointer() != NULL);
+  if (this->Format == JPEG)
+    {
+    valid = (valid && scalarType == VTK_UNSIGNED_CHAR &&
+             (components == 1 || components == 3));
+    }
+  else
+    {
+    valid = (valid && (scalarType == VTK_UNSIGNED_CHAR ||
+                       scalarType == VTK_UNSIGNED_SHORT) &&
+             components >= 1 && components <= 4);
+    }
+  if (!valid)
+    {
+    vtkErrorMacro("Frames must be a single slice of unsigned char"
+                  << (this->Format == JPEG ? " scalars with 1 or 3" :
+                      " or unsigned short scalars with 1 to 4")
+                  << " components.");
+    this->Error = 1;
+    this->SetErrorCode(vtkGenericMovieWriter::CanNotFormat);
+    return;
+    }
+
+  const char *pattern = this->FilePattern;
+  if (!pattern)
+    {
+    pattern = (this->Format == JPEG ? "%s%04d.jpg" : "%s%04d.png");
+    }
+  // Grow the buffer until the name fits.  snprintf returns the length
+  // needed, or -1 with some C libraries, in which case the size doubles.
+  std::vector<char> fileName(strlen(this->FileName) + strlen(pattern) + 32);
+  int length = -1;
+  while (fileName.size() <= vtkImageFrameWriterMaximumFileNameSize)
+    {
+    length = snprintf(&fileName[0], fileName.size(), pattern,
+                      this->FileName, this->NumberOfFrames);
+    if (length >= 0 && static_cast<size_t>(length) < fileName.size())
+      {
+      break;
+      }
+    fileName.resize(length >= 0 ? static_cast<size_t>(length) + 1 :
+                    2 * fileName.size());
+    length = -1;
+    }
+  if (length < 0)
+    {
+    vtkErrorMacro("Could not build a file name from the pattern "
+                  << pattern);
+    this->Error = 1;
+    this->SetErrorCode(vtkErrorCode::NoFileNameError);
+    return;
+    }
+
+  // Wait for a free place in the queue before copying the frame, so that
+  // no more than MaximumNumberOfQueuedFrames copies exist.  Only this
+  // thread adds frames, so the place stays free.
+  vtkInternals *internals = this->Internals;
+  internals->Lock.Lock();
+  while (internals->NumberOfPendingFrames >=
+         this->MaximumNumberOfQueuedFrames)
+    {
+    internals->FrameWritten.Wait(internals->Lock);
+    }
+  internals->Lock.Unlock();
+
+  vtkInternals::Frame frame;
+  frame.Number = this->NumberOfFrames;
+  frame.FileName = &fileName[0];
+  frame.Image = vtkImageData::New();
+  frame.Image->DeepCopy(input);
+
+  internals->Lock.Lock();
+  internals->Queue.push_back(frame);
+  internals->NumberOfPendingFrames++;
+  internals->Lock.Unlock();
+  internals->FrameQueued.Signal();
+
+  this->NumberOfFrames++;
+  this->ReportFailedFiles();
+}
+
+//----------------------------------------------------------------------------
+void vtkImageFrameWriter::End()
+{
+  vtkInternals *internals = this->Internals;
+  if (!internals)
+    {
+    return;
+    }
+
+  internals->Lock.Lock();
+  while (internals->NumberOfPendingFrames > 0)
+    {
+    internals->FrameWritten.Wait(internals->Lock);
+    }
+  internals->Done = true;
+  internals->Lock.Unlock();
+  internals->FrameQueued.Broadcast();
+  for (size_t i = 0; i < internals->ThreadIds.size(); ++i)
+    {
+    internals->Threader->TerminateThread(internals->ThreadIds[i]);
+    }
+
+  this->ReportFailedFiles();
+  delete this->Internals;
+  this->Internals = NULL;
+}
+
+//----------------------------------------------------------------------------
+int vtkImageFrameWriter::ReportFailedFiles()
+{
+  std::vector<std::string> failedFiles;
+  this->Internals->Lock.Lock();
+  failedFiles.swap(this->Internals->FailedFiles);
+  this->Internals->Lock.Unlock();
+  for (size_t i = 0; i < failedFiles.size(); ++i)
+    {
+    vtkErrorMacro("Could not write file: " << failedFiles[i]);
+    }
+  if (!failedFiles.empty())
+    {
+    this->Error = 1;
+    this->SetErrorCode(vtkErrorCode::CannotOpenFileError);
+    return 0;
+    }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkImageFrameWriter::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Format: " << (this->Format == JPEG ? "JPEG" : "PNG")
+     << endl;
+  os << indent << "FilePattern: "
+     << (this->FilePattern ? this->FilePattern : "(none)") << endl;
+  os << indent << "CompressionLevel: " << this->CompressionLevel << endl;
+  os << indent << "Quality: " << this->Quality << endl;
+  os << indent << "NumberOfEncodingThreads: "
+     << this->NumberOfEncodingThreads << endl;
+  os << indent << "MaximumNumberOfQueuedFrames: "
+     << this->MaximumNumberOfQueuedFrames << endl;
+  os << indent << "NumberOfFrames: " << this->NumberOfFrames << endl;
+}
@@ -0,0 +1,134 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkImageFrameWriter.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkImageFrameWriter - Write the frames of an animation as PNG or JPEG files on worker threads.
+// .SECTION Description
+// vtkImageFrameWriter writes each frame passed to Write() as a PNG or
+// JPEG file, numbered from 0 in the order of the frames.  It is meant for
+// exporting long animations, for example from a vtkWindowToImageFilter:
+// Write() only copies the frame, which is then compressed and written by
+// a pool of worker threads while the next frame is being rendered.  The
+// number of frames copied but not yet written is bounded, and Write()
+// waits for the workers when it is reached, so memory use does not grow
+// with the length of the animation.  End() waits until all the frames are
+// written.
+//
+// The file names are built with sprintf from FilePattern, FileName as a
+// prefix and the frame number.  The input must be a single slice of
+// unsigned char scalars, or unsigned short scalars for PNG, with 1 or 3
+// components for JPEG and 1 to 4 components for PNG.  The files are
+// identical to those written by vtkPNGWriter and vtkJPEGWriter.
+
+// .SECTION See Also
+// vtkPNGWriter vtkJPEGWriter vtkWindowToImageFilter vtkDataEncoder
+
+#ifndef __vtkImageFrameWriter_h
+#define __vtkImageFrameWriter_h
+
+#include "vtkIOMovieModule.h" // For export macro
+#include "vtkGenericMovieWriter.h"
+
+class VTKIOMOVIE_EXPORT vtkImageFrameWriter : public vtkGenericMovieWriter
+{
+public:
+  static vtkImageFrameWriter *New();
+  vtkTypeMacro(vtkImageFrameWriter,vtkGenericMovieWriter);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  //BTX
+  enum FormatIds
+  {
+    PNG = 0,
+    JPEG
+  };
+  //ETX
+
+  // Description:
+  // Get/Set the format of the files.  The default is PNG.
+  vtkSetClampMacro(Format, int, PNG, JPEG);
+  vtkGetMacro(Format, int);
+  void SetFormatToPNG() { this->SetFormat(PNG); }
+  void SetFormatToJPEG() { this->SetFormat(JPEG); }
+
+  // Description:
+  // Get/Set the sprintf format used to build the name of each file from
+  // FileName and the frame number.  The default, NULL, uses "%s%04d.png"
+  // or "%s%04d.jpg" depending on the format.
+  vtkSetStringMacro(FilePattern);
+  vtkGetStringMacro(FilePattern);
+
+  // Description:
+  // Get/Set the zlib compression level of PNG files, from 0 (fastest) to 9
+  // (smallest).  The default is 5, as for vtkPNGWriter.
+  vtkSetClampMacro(CompressionLevel, int, 0, 9);
+  vtkGetMacro(CompressionLevel, int);
+
+  // Description:
+  // Get/Set the quality of JPEG files, from 0 to 100.  The default is 95,
+  // as for vtkJPEGWriter.
+  vtkSetClampMacro(Quality, int, 0, 100);
+  vtkGetMacro(Quality, int);
+
+  // Description:
+  // Get/Set the number of worker threads that compress and write the
+  // frames.  The default, 0, uses the global default number of threads of
+  // vtkMultiThreader.  Changes take effect at the next Start().
+  vtkSetClampMacro(NumberOfEncodingThreads, int, 0, VTK_MAX_THREADS);
+  vtkGetMacro(NumberOfEncodingThreads, int);
+
+  // Description:
+  // Get/Set the maximum number of frames copied by Write() that are not
+  // written yet.  Write() waits while this many frames are pending.  The
+  // default is 16.
+  vtkSetClampMacro(MaximumNumberOfQueuedFrames, int, 1, VTK_INT_MAX);
+  vtkGetMacro(MaximumNumberOfQueuedFrames, int);
+
+  // Description:
+  // Get the number of frames passed to Write() since the last Start().
+  vtkGetMacro(NumberOfFrames, int);
+
+  // Description:
+  // Start the worker threads, copy the input as the next frame, and wait
+  // until all the frames are written and stop the worker threads.
+  virtual void Start();
+  virtual void Write();
+  virtual void End();
+
+protected:
+  vtkImageFrameWriter();
+  ~vtkImageFrameWriter();
+
+  // Report the files that the workers could not write, and return 0 if
+  // there was any.
+  int ReportFailedFiles();
+
+  int Format;
+  char *FilePattern;
+  int CompressionLevel;
+  int Quality;
+  int NumberOfEncodingThreads;
+  int MaximumNumberOfQueuedFrames;
+  int NumberOfFrames;
+
+  //BTX
+  class vtkInternals;
+  vtkInternals *Internals;
+  //ETX
+
+private:
+  vtkImageFrameWriter(const vtkImageFrameWriter&); // Not implemented
+  void operator=(const vtkImageFrameWriter&); // Not implemented
+};
+
+#endif
@@ -0,0 +1,273 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestNetCDFCFReaderStride.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Writes CF files with point data on a Cartesian grid and cell data on a
+// latitude/longitude grid, and checks that reading them with a stride gives
+// the points and values of the full resolution grid at the sampled indices.
+
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkImageData.h"
+#include "vtkNetCDFCFReader.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkRectilinearGrid.h"
+#include "vtkSmartPointer.h"
+#include "vtkStructuredGrid.h"
+#include "vtkTestUtilities.h"
+
+#include "vtk_netcdf.h"
+
+#include <algorithm>
+#include <string>
+
+namespace
+{
+// Writes a variable "var" on dimensions of the given sizes (slowest
+// first), each with a coordinate variable with the given units.
+bool WriteFile(const std::string& fileName, int numDims, const int* sizes,
+               const char** names, const char** units)
+{
+  int ncFD;
+  if (nc_create(fileName.c_str(), NC_CLOBBER, &ncFD) != NC_NOERR)
+    {
+    return false;
+    }
+  int dimIds[3], coordIds[3], varId;
+  size_t numValues = 1;
+  for (int d = 0; d < numDims; ++d)
+    {
+    nc_def_dim(ncFD, names[d], sizes[d], &dimIds[d]);
+    nc_def_var(ncFD, names[d], NC_DOUBLE, 1, &dimIds[d], &coordIds[d]);
+    if (units[d])
+      {
+      nc_put_att_text(ncFD, coordIds[d], "units", strlen(units[d]), units[d]);
+      }
+    numValues *= sizes[d];
+    }
+  nc_def_var(ncFD, "var", NC_DOUBLE, numDims, dimIds, &varId);
+  nc_enddef(ncFD);
+
+  for (int d = 0; d < numDims; ++d)
+    {
+    double* coords = new double[sizes[d]];
+    for (int i = 0; i < sizes[d]; ++i)
+      {
+      coords[i] = -10.0 + 5.0 * i;
+      }
+    nc_put_var_double(ncFD, coordIds[d], coords);
+    delete [] coords;
+    }
+  double* values = new double[numValues];
+  for (size_t i = 0; i < numValues; ++i)
+    {
+    values[i] = 0.5 * i;
+    }
+  nc_put_var_double(ncFD, varId, values);
+  delete [] values;
+  return nc_close(ncFD) == NC_NOERR;
+}
+
+void GetDimensions(vtkDataSet* data, int dims[3])
+{
+  if (vtkImageData::SafeDownCast(data))
+    {
+    vtkImageData::SafeDownCast(data)->GetDimensions(dims);
+    }
+  else if (vtkRectilinearGrid::SafeDownCast(data))
+    {
+    vtkRectilinearGrid::SafeDownCast(data)->GetDimensions(dims);
+    }
+  else
+    {
+    vtkStructuredGrid::SafeDownCast(data)->GetDimensions(dims);
+    }
+}
+
+vtkSmartPointer<vtkDataSet> Read(const std::string& fileName, int outputType,
+                                 const int stride[3])
+{
+  vtkNew<vtkNetCDFCFReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->SetOutputType(outputType);
+  reader->SetStride(stride[0], stride[1], stride[2]);
+  reader->SetVariableChunkCacheSize(1 << 20);
+  reader->UpdateMetaData();
+  reader->SetVariableArrayStatus("var", 1);
+  reader->Update();
+  return vtkDataSet::SafeDownCast(reader->GetOutputDataObject(0));
+}
+
+// Checks that the strided output has the points of the full output at the
+// sampled indices, clamped to the last point, and the values of the
+// sampled points or cells.
+bool Compare(vtkDataSet* full, vtkDataSet* strided, const int stride[3],
+             bool cellData)
+{
+  if (!full || !strided)
+    {
+    cerr << "No output" << endl;
+    return false;
+    }
+  int fullDims[3], dims[3];
+  GetDimensions(full, fullDims);
+  GetDimensions(strided, dims);
+  for (int axis = 0; axis < 3; ++axis)
+    {
+    int numValues = fullDims[axis] - (cellData && fullDims[axis] > 1 ? 1 : 0);
+    int expected = (numValues - 1) / stride[axis] + 1;
+    if (cellData && fullDims[axis] > 1)
+      {
+      ++expected;
+      }
+    if (dims[axis] != expected)
+      {
+      cerr << "Wrong dimension " << dims[axis] << " along axis " << axis
+           << ", expected " << expected << endl;
+      return false;
+      }
+    }
+
+  for (int k = 0; k < dims[2]; ++k)
+    {
+    for (int j = 0; j < dims[1]; ++j)
+      {
+      for (int i = 0; i < dims[0]; ++i)
+        {
+        int ijk[3] = { i, j, k };
+        int fullIjk[3];
+        for (int axis = 0; axis < 3; ++axis)
+          {
+          fullIjk[axis] =
+            std::min(ijk[axis] * stride[axis], fullDims[axis] - 1);
+          }
+        vtkIdType id = i + dims[0] * (j + dims[1] * k);
+        vtkIdType fullId =
+          fullIjk[0] + fullDims[0] * (fullIjk[1] + fullDims[1] * fullIjk[2]);
+        double x[3], fullX[3];
+        strided->GetPoint(id, x);
+        full->GetPoint(fullId, fullX);
+        if (x[0] != fullX[0] || x[1] != fullX[1] || x[2] != fullX[2])
+          {
+          cerr << "Wrong point " << i << ", " << j << ", " << k << endl;
+          return false;
+          }
+        }
+      }
+    }
+
+  vtkDataArray* fullValues = cellData ?
+    full->GetCellData()->GetArray("var") : full->GetPointData()->GetArray("var");
+  vtkDataArray* values = cellData ?
+    strided->GetCellData()->GetArray("var") :
+    strided->GetPointData()->GetArray("var");
+  int valueDims[3], fullValueDims[3];
+  for (int axis = 0; axis < 3; ++axis)
+    {
+    valueDims[axis] = std::max(dims[axis] - (cellData ? 1 : 0), 1);
+    fullValueDims[axis] = std::max(fullDims[axis] - (cellData ? 1 : 0), 1);
+    }
+  if (!fullValues || !values || values->GetNumberOfTuples() !=
+      valueDims[0] * valueDims[1] * valueDims[2])
+    {
+    cerr << "Missing or truncated values" << endl;
+    return false;
+    }
+  for (int k = 0; k < valueDims[2]; ++k)
+    {
+    for (int j = 0; j < valueDims[1]; ++j)
+      {
+      for (int i = 0; i < valueDims[0]; ++i)
+        {
+        vtkIdType id = i + valueDims[0] * (j + valueDims[1] * k);
+        vtkIdType fullId = i * stride[0] + fullValueDims[0] *
+          (j * stride[1] + fullValueDims[1] * k * stride[2]);
+        if (values->GetTuple1(id) != fullValues->GetTuple1(fullId))
+          {
+          cerr << "Wrong value " << i << ", " << j << ", " << k << endl;
+          return false;
+          }
+        }
+      }
+    }
+  return true;
+}
+}
+
+int TestNetCDFCFReaderStride(int argc, char* argv[])
+{
+  char* tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  if (!tempDir)
+    {
+    cerr << "Could not determine temporary directory." << endl;
+    return EXIT_FAILURE;
+    }
+  std::string fileName = tempDir;
+  delete [] tempDir;
+  fileName += "/TestNetCDFCFReaderStride.nc";
+
+  const int strides[][3] = { { 4, 4, 4 }, { 2, 3, 1 }, { 5, 1, 3 } };
+
+  // Point data on a uniform Cartesian grid, read as every structured type.
+  const int sizes[] = { 7, 9, 13 };
+  const char* names[] = { "z", "y", "x" };
+  const char* noUnits[] = { NULL, NULL, NULL };
+  if (!WriteFile(fileName, 3, sizes, names, noUnits))
+    {
+    cerr << "Could not write " << fileName << endl;
+    return EXIT_FAILURE;
+    }
+  const int noStride[3] = { 1, 1, 1 };
+  const int outputTypes[] =
+    { VTK_IMAGE_DATA, VTK_RECTILINEAR_GRID, VTK_STRUCTURED_GRID };
+  for (int t = 0; t < 3; ++t)
+    {
+    vtkSmartPointer<vtkDataSet> full =
+      Read(fileName, outputTypes[t], noStride);
+    for (int s = 0; s < 3; ++s)
+      {
+      if (!Compare(full, Read(fileName, outputTypes[t], strides[s]),
+                   strides[s], false))
+        {
+        cerr << "For output type " << outputTypes[t] << " and stride "
+             << strides[s][0] << ", " << strides[s][1] << ", "
+             << strides[s][2] << endl;
+        return EXIT_FAILURE;
+        }
+      }
+    }
+
+  // Cell data on a latitude/longitude grid, whose points are the cell
+  // bounds in spherical coordinates.
+  const char* sphericalNames[] = { "lat", "lon" };
+  const char* sphericalUnits[] = { "degrees_north", "degrees_east" };
+  if (!WriteFile(fileName, 2, sizes + 1, sphericalNames, sphericalUnits))
+    {
+    cerr << "Could not write " << fileName << endl;
+    return EXIT_FAILURE;
+    }
+  vtkSmartPointer<vtkDataSet> full = Read(fileName, -1, noStride);
+  for (int s = 0; s < 3; ++s)
+    {
+    if (!Compare(full, Read(fileName, -1, strides[s]), strides[s], true))
+      {
+      cerr << "For spherical coordinates and stride " << strides[s][0]
+           << ", " << strides[s][1] << ", " << strides[s][2] << endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
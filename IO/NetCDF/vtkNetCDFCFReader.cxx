@@ -1211,7 +1211,7 @@ void vtkNetCDFCFReader::AddRectilinearCoordinates(vtkImageData *imageOutput)
     int dim = this->LoadingDimensions->GetValue(numDim-i-1);
     vtkDimensionInfo *dimInfo = this->GetDimensionInfo(dim);
     origin[i] = dimInfo->GetOrigin();
-    spacing[i] = dimInfo->GetSpacing();
+    spacing[i] = dimInfo->GetSpacing()*std::max(this->Stride[i], 1);
     }
 
   imageOutput->SetOrigin(origin);
@@ -1238,12 +1238,15 @@ void vtkNetCDFCFReader::AddRectilinearCoordinates(
       int extHi = extent[2*i+1];
       if ((extLow != 0) || (extHi != coords->GetNumberOfTuples()-1))
         {
-        // Getting a subset of this dimension.
+        // Getting a subset, or a subsampling, of this dimension.
         VTK_CREATE(vtkDoubleArray, newcoords);
         newcoords->SetNumberOfComponents(1);
         newcoords->SetNumberOfTuples(extHi-extLow+1);
-        memcpy(newcoords->GetPointer(0), coords->GetPointer(extLow),
-               (extHi-extLow+1)*sizeof(double));
+        for (int j = extLow; j <= extHi; j++)
+          {
+          newcoords->SetValue(j-extLow, coords->GetValue(
+                     this->GetFileIndex(i, j, coords->GetNumberOfTuples())));
+          }
         coords = newcoords;
         }
       }
@@ -1318,8 +1321,9 @@ void vtkNetCDFCFReader::Add1DRectilinearCoordinates(vtkPoints *points,
           {
           for (ijk[0] = extent[0*2]; ijk[0] <= extent[0*2+1]; ijk[0]++)
             {
-            pointData->SetComponent(pointIdx, dimVTK,
-                                    coords->GetValue(ijk[dimVTK]));
+            pointData->SetComponent(pointIdx, dimVTK, coords->GetValue(
+                this->GetFileIndex(dimVTK, ijk[dimVTK],
+                                   coords->GetNumberOfTuples())));
             pointIdx++;
             }
           }
@@ -1378,7 +1382,8 @@ void vtkNetCDFCFReader::Add2DRectilinearCoordinates(vtkPoints *points,
     double h;
     if (verticalCoordinates)
       {
-      h = verticalCoordinates->GetValue(k);
+      h = verticalCoordinates->GetValue(
+        this->GetFileIndex(2, k, verticalCoordinates->GetNumberOfTuples()));
       }
     else
       {
@@ -1386,10 +1391,14 @@ void vtkNetCDFCFReader::Add2DRectilinearCoordinates(vtkPoints *points,
       }
     for (int j = extent[2]; j <= extent[3]; j++)
       {
+      vtkIdType fileJ = this->GetFileIndex(
+                              1, j, longitudeCoordinates->GetNumberOfTuples());
       for (int i = extent[0]; i <= extent[1]; i++)
         {
-        double lon = longitudeCoordinates->GetComponent(j, i);
-        double lat = latitudeCoordinates->GetComponent(j, i);
+        int fileI = static_cast<int>(this->GetFileIndex(
+                       0, i, longitudeCoordinates->GetNumberOfComponents()));
+        double lon = longitudeCoordinates->GetComponent(fileJ, fileI);
+        double lat = latitudeCoordinates->GetComponent(fileJ, fileI);
         points->InsertNextPoint(lon, lat, h);
         }
       }
@@ -1481,7 +1490,8 @@ void vtkNetCDFCFReader::Add1DSphericalCoordinates(vtkPoints *points,
                    * (extent[5]-extent[4]+1) );
 
   vtkDoubleArray *coordArrays[3];
-  for (vtkIdType i = 0; i < this->LoadingDimensions->GetNumberOfTuples(); i++)
+  int numDims = this->LoadingDimensions->GetNumberOfTuples();
+  for (vtkIdType i = 0; i < numDims; i++)
     {
     int dim = this->LoadingDimensions->GetValue(i);
     coordArrays[i] = this->GetDimensionInfo(dim)->GetBounds();
@@ -1526,17 +1536,28 @@ void vtkNetCDFCFReader::Add1DSphericalCoordinates(vtkPoints *points,
       {
       for (ijk[2] = extent[0]; ijk[2] <= extent[1]; ijk[2]++)
         {
+        // The VTK axis of netCDF dimension d is numDims-d-1.
         double lon, lat, h;
         if (verticalDim >= 0)
           {
-          lon = coordArrays[longitudeDim]->GetValue(ijk[longitudeDim]);
-          lat = coordArrays[latitudeDim]->GetValue(ijk[latitudeDim]);
-          h = coordArrays[verticalDim]->GetValue(ijk[verticalDim]);
+          lon = coordArrays[longitudeDim]->GetValue(this->GetFileIndex(
+                  numDims-longitudeDim-1, ijk[longitudeDim],
+                  coordArrays[longitudeDim]->GetNumberOfTuples()));
+          lat = coordArrays[latitudeDim]->GetValue(this->GetFileIndex(
+                  numDims-latitudeDim-1, ijk[latitudeDim],
+                  coordArrays[latitudeDim]->GetNumberOfTuples()));
+          h = coordArrays[verticalDim]->GetValue(this->GetFileIndex(
+                  numDims-verticalDim-1, ijk[verticalDim],
+                  coordArrays[verticalDim]->GetNumberOfTuples()));
           }
         else
           {
-          lon = coordArrays[longitudeDim]->GetValue(ijk[longitudeDim+1]);
-          lat = coordArrays[latitudeDim]->GetValue(ijk[latitudeDim+1]);
+          lon = coordArrays[longitudeDim]->GetValue(this->GetFileIndex(
+                  numDims-longitudeDim-1, ijk[longitudeDim+1],
+                  coordArrays[longitudeDim]->GetNumberOfTuples()));
+          lat = coordArrays[latitudeDim]->GetValue(this->GetFileIndex(
+                  numDims-latitudeDim-1, ijk[latitudeDim+1],
+                  coordArrays[latitudeDim]->GetNumberOfTuples()));
           h = 1.0;
           }
         lon = vtkMath::RadiansFromDegrees(lon);
@@ -1608,7 +1629,9 @@ void vtkNetCDFCFReader::Add2DSphericalCoordinates(vtkPoints *points,
     double h;
     if (verticalCoordinates)
       {
-      h = verticalCoordinates->GetValue(k)*vertScale + vertBias;
+      h = verticalCoordinates->GetValue(
+            this->GetFileIndex(2, k, verticalCoordinates->GetNumberOfTuples()))
+          *vertScale + vertBias;
       }
     else
       {
@@ -1616,10 +1639,14 @@ void vtkNetCDFCFReader::Add2DSphericalCoordinates(vtkPoints *points,
       }
     for (int j = extent[2]; j <= extent[3]; j++)
       {
+      vtkIdType fileJ = this->GetFileIndex(
+                              1, j, longitudeCoordinates->GetNumberOfTuples());
       for (int i = extent[0]; i <= extent[1]; i++)
         {
-        double lon = longitudeCoordinates->GetComponent(j, i);
-        double lat = latitudeCoordinates->GetComponent(j, i);
+        int fileI = static_cast<int>(this->GetFileIndex(
+                       0, i, longitudeCoordinates->GetNumberOfComponents()));
+        double lon = longitudeCoordinates->GetComponent(fileJ, fileI);
+        double lat = latitudeCoordinates->GetComponent(fileJ, fileI);
         lon = vtkMath::RadiansFromDegrees(lon);
         lat = vtkMath::RadiansFromDegrees(lat);
 
@@ -1798,11 +1825,12 @@ void vtkNetCDFCFReader::AddUnstructuredRectilinearCoordinates(
   // slow and ghost cells are totally screwed up.
   for (int cellId = extent[0]; cellId < extent[1]; cellId++)
     {
+    vtkIdType fileCellId = this->GetFileIndex(0, cellId, totalNumCells);
     for (int cellPointId = 0; cellPointId < numPointsPerCell; cellPointId++)
       {
       double coord[3];
-      coord[0] = longitudeCoordinates->GetComponent(cellId, cellPointId);
-      coord[1] = latitudeCoordinates->GetComponent(cellId, cellPointId);
+      coord[0] = longitudeCoordinates->GetComponent(fileCellId, cellPointId);
+      coord[1] = latitudeCoordinates->GetComponent(fileCellId, cellPointId);
       coord[2] = 0.0;
 
       vtkIdType pointId;
@@ -105,6 +105,8 @@ vtkNetCDFReader::vtkNetCDFReader()
 
   this->FileName = NULL;
   this->ReplaceFillValueWithNan = 0;
+  this->Stride[0] = this->Stride[1] = this->Stride[2] = 1;
+  this->VariableChunkCacheSize = 0;
 
   this->LoadingDimensions = vtkSmartPointer<vtkIntArray>::New();
 
@@ -146,6 +148,10 @@ void vtkNetCDFReader::PrintSelf(ostream &os, vtkIndent indent)
      << (this->FileName ? this->FileName : "(NULL)") << endl;
   os << indent << "ReplaceFillValueWithNan: "
      << this->ReplaceFillValueWithNan << endl;
+  os << indent << "Stride: " << this->Stride[0] << ", " << this->Stride[1]
+     << ", " << this->Stride[2] << endl;
+  os << indent << "VariableChunkCacheSize: "
+     << this->VariableChunkCacheSize << endl;
 
   os << indent << "VariableArraySelection:" << endl;
   this->VariableArraySelection->PrintSelf(os, indent.GetNextIndent());
@@ -276,7 +282,8 @@ int vtkNetCDFReader::RequestInformation(
       }
     }
 
-  // Capture the extent information from this->LoadingDimensions.
+  // Capture the extent information from this->LoadingDimensions.  With a
+  // stride, the extent is the one of the subsampled grid.
   bool pointData = this->DimensionsAreForPointData(this->LoadingDimensions);
   for (int i = 0 ; i < 3; i++)
     {
@@ -287,7 +294,8 @@ int vtkNetCDFReader::RequestInformation(
       // Remember that netCDF arrays are indexed backward from VTK images.
       int dim = this->LoadingDimensions->GetValue(numDims-i-1);
       CALL_NETCDF(nc_inq_dimlen(ncFD, dim, &dimlength));
-      this->WholeExtent[2*i+1] = static_cast<int>(dimlength-1);
+      int stride = std::max(this->Stride[i], 1);
+      this->WholeExtent[2*i+1] = static_cast<int>((dimlength-1)/stride);
       // For cell data, add one to the extent (which is for points).
       if (!pointData) this->WholeExtent[2*i+1]++;
       }
@@ -405,6 +413,10 @@ int vtkNetCDFReader::RequestData(vtkInformation *vtkNotUsed(request),
   if (imageOutput)
     {
     imageOutput->SetExtent(this->UpdateExtent);
+    // Keep subsampled images the size of the full resolution ones.
+    imageOutput->SetSpacing(std::max(this->Stride[0], 1),
+                            std::max(this->Stride[1], 1),
+                            std::max(this->Stride[2], 1));
     }
   else if (rectOutput)
     {
@@ -714,6 +726,14 @@ void vtkNetCDFReader::GetUpdateExtentForOutput(vtkDataSet *,
   memcpy(extent, this->UpdateExtent, 6*sizeof(int));
 }
 
+//-----------------------------------------------------------------------------
+vtkIdType vtkNetCDFReader::GetFileIndex(int axis, vtkIdType index,
+                                        vtkIdType size)
+{
+  vtkIdType fileIndex = index*std::max(this->Stride[axis], 1);
+  return std::min(fileIndex, size-1);
+}
+
 //-----------------------------------------------------------------------------
 int vtkNetCDFReader::LoadVariable(int ncFD, const char *varName, double time,
                                   vtkDataSet *output)
@@ -739,6 +759,7 @@ int vtkNetCDFReader::LoadVariable(int ncFD, const char *varName, double time,
 
   // Indices to read from.
   size_t start[4], count[4];
+  ptrdiff_t stride[4] = { 1, 1, 1, 1 };
 
   // Are we using time?
   int timeIndexOffset = 0;
@@ -800,9 +821,10 @@ int vtkNetCDFReader::LoadVariable(int ncFD, const char *varName, double time,
       return 1;
       }
     // Remember that netCDF arrays are indexed backward from VTK images.
-    start[i+timeIndexOffset] = extent[2*(numDims-i-1)];
-    count[i+timeIndexOffset]
-      = extent[2*(numDims-i-1)+1]-extent[2*(numDims-i-1)]+1;
+    int axis = numDims-i-1;
+    stride[i+timeIndexOffset] = std::max(this->Stride[axis], 1);
+    start[i+timeIndexOffset] = extent[2*axis]*stride[i+timeIndexOffset];
+    count[i+timeIndexOffset] = extent[2*axis+1]-extent[2*axis]+1;
 
     // If loading cell data, subtract one from the data being loaded.
     if (!loadingPointData) count[i+timeIndexOffset]--;
@@ -820,8 +842,23 @@ int vtkNetCDFReader::LoadVariable(int ncFD, const char *varName, double time,
   dataArray->SetNumberOfComponents(1);
   dataArray->SetNumberOfTuples(arraySize);
 
-  // Read the array from the file.
-  CALL_NETCDF(nc_get_vars(ncFD, varId, start, count, NULL,
+#ifdef VTK_NETCDF_USE_NETCDF4
+  // Enlarge the chunk cache of the variable if requested.  This fails for
+  // files other than netCDF-4, which have no chunk cache.
+  size_t cacheSize, cacheElements;
+  float cachePreemption;
+  if (   (this->VariableChunkCacheSize > 0)
+      && (nc_get_var_chunk_cache(ncFD, varId, &cacheSize, &cacheElements,
+                                 &cachePreemption) == NC_NOERR) )
+    {
+    nc_set_var_chunk_cache(ncFD, varId,
+                           static_cast<size_t>(this->VariableChunkCacheSize),
+                           cacheElements, cachePreemption);
+    }
+#endif
+
+  // Read the array from the file, skipping the values between samples.
+  CALL_NETCDF(nc_get_vars(ncFD, varId, start, count, stride,
                           dataArray->GetVoidPointer(0)));
 
   // Check for a fill value.
@@ -114,6 +114,28 @@ public:
   vtkSetMacro(ReplaceFillValueWithNan, int);
   vtkBooleanMacro(ReplaceFillValueWithNan, int);
 
+  // Description:
+  // Set/get the sampling rate along the x, y and z axes of the output.  With
+  // a stride of n along an axis, only every n-th value along the matching
+  // netCDF dimension is read from the file, with strided hyperslab reads,
+  // and the whole and update extents are those of the subsampled grid.  A
+  // stride of 4 along each axis reads 1/64 of the values of a 3D variable.
+  // The time dimension is never subsampled.  By default the stride is 1
+  // along each axis (every value is read).
+  vtkSetVector3Macro(Stride, int);
+  vtkGetVector3Macro(Stride, int);
+
+  // Description:
+  // Set/get the size in bytes of the chunk cache of each variable read.  A
+  // chunk cache holding at least the chunks crossed by one row of the
+  // update extent avoids decompressing the same chunks over and over in
+  // strided reads.  This only applies to chunked netCDF-4 files.  0 (the
+  // default) keeps the netCDF library's default size.  The size is ignored
+  // when VTK's netCDF is built without netCDF-4 (a system HDF5 lacking the
+  // high-level library) or when a system netCDF is used.
+  vtkSetClampMacro(VariableChunkCacheSize, vtkIdType, 0, VTK_ID_MAX);
+  vtkGetMacro(VariableChunkCacheSize, vtkIdType);
+
   // Description:
   // Access to the time dimensions units.
   // Can be used by the udunits library to convert raw numerical time values
@@ -153,6 +175,10 @@ protected:
 
   int ReplaceFillValueWithNan;
 
+  int Stride[3];
+
+  vtkIdType VariableChunkCacheSize;
+
   int WholeExtent[6];
 
   virtual int RequestDataObject(vtkInformation *request,
@@ -219,6 +245,13 @@ protected:
   // gives it a chance to set the range of values to read.
   virtual void GetUpdateExtentForOutput(vtkDataSet *output, int extent[6]);
 
+  // Description:
+  // Returns the index in the file of the given index of the output along
+  // the given VTK axis (0, 1 or 2), that is index times the stride of the
+  // axis, clamped to size-1.  The clamping lets the last sampled cell of a
+  // dimension end on the last point of coordinates of the given size.
+  vtkIdType GetFileIndex(int axis, vtkIdType index, vtkIdType size);
+
   // Description:
   // Load the variable at the given time into the given data set.  Return 1
   // on success and 0 on failure.
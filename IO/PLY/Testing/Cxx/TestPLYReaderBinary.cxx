@@ -0,0 +1,255 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestPLYReaderBinary.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that binary PLY files, read in bulk, give the same output as the
+// same data in ASCII, read element by element, for both byte orders, for
+// faces of uniform and mixed sizes, and with the faces before or after the
+// vertices.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+#include "vtkPLYReader.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestUtilities.h"
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+namespace
+{
+const int NumberOfVertices = 5000;
+
+// Write the bytes of value in the given byte order.
+template <class T>
+void Put(FILE* file, T value, bool bigEndian)
+{
+  unsigned char bytes[sizeof(T)];
+  memcpy(bytes, &value, sizeof(T));
+  unsigned short one = 1;
+  bool hostBigEndian = *reinterpret_cast<unsigned char*>(&one) == 0;
+  for (size_t i = 0; i < sizeof(T); ++i)
+    {
+    fputc(bytes[hostBigEndian == bigEndian ? i : sizeof(T) - 1 - i], file);
+    }
+}
+
+void WriteVertices(FILE* file, int format)
+{
+  bool bigEndian = format == 2;
+  for (int i = 0; i < NumberOfVertices; ++i)
+    {
+    float x[3] = { 0.5f * i, -0.25f * i, 2.0f };
+    float n[3] = { 0.0f, 1.0f, -0.125f * (i % 8) };
+    float t[2] = { i / 512.0f, 1.0f - i / 512.0f };
+    unsigned char c[3] = { static_cast<unsigned char>(i % 256), 7,
+                           static_cast<unsigned char>(255 - i % 256) };
+    if (format == 0)
+      {
+      fprintf(file, "%.9g %.9g %.9g 0.5 %.9g %.9g %.9g %.9g %.9g %d %d %d\n",
+              x[0], x[1], x[2], n[0], n[1], n[2], t[0], t[1],
+              c[0], c[1], c[2]);
+      continue;
+      }
+    Put(file, x[0], bigEndian);
+    Put(file, x[1], bigEndian);
+    Put(file, static_cast<double>(x[2]), bigEndian);
+    Put(file, 0.5, bigEndian);
+    for (int k = 0; k < 3; ++k)
+      {
+      Put(file, n[k], bigEndian);
+      }
+    Put(file, t[0], bigEndian);
+    Put(file, t[1], bigEndian);
+    fwrite(c, 1, 3, file);
+    }
+}
+
+void WriteFaces(FILE* file, int format, int numFaces, bool mixed)
+{
+  bool bigEndian = format == 2;
+  for (int i = 0; i < numFaces; ++i)
+    {
+    unsigned char intensity = static_cast<unsigned char>(i * 3 % 256);
+    unsigned char numVerts = static_cast<unsigned char>(
+      mixed ? 3 + i % 3 : 3);
+    unsigned char c[3] = { 1, static_cast<unsigned char>(i % 256), 3 };
+    if (format == 0)
+      {
+      fprintf(file, "%d %d", intensity, numVerts);
+      for (int k = 0; k < numVerts; ++k)
+        {
+        fprintf(file, " %d", i + k);
+        }
+      fprintf(file, " -3 %d %d %d\n", c[0], c[1], c[2]);
+      continue;
+      }
+    fputc(intensity, file);
+    fputc(numVerts, file);
+    for (int k = 0; k < numVerts; ++k)
+      {
+      Put(file, i + k, bigEndian);
+      }
+    Put(file, static_cast<short>(-3), bigEndian);
+    fwrite(c, 1, 3, file);
+    }
+}
+
+// Write a file with NumberOfVertices vertices and faces of 3 vertices, or
+// of 3 to 5 vertices when mixed, in ASCII (format 0) or in little or big
+// endian binary (formats 1 and 2).  The faces come before the vertices
+// when facesFirst is set.
+void Write(const std::string& fileName, int format, bool mixed,
+           bool facesFirst)
+{
+  const char* formats[] =
+    { "ascii", "binary_little_endian", "binary_big_endian" };
+  int numFaces = NumberOfVertices - 5;
+  FILE* file = fopen(fileName.c_str(), "wb");
+  fprintf(file, "ply\nformat %s 1.0\n", formats[format]);
+  for (int element = 0; element < 2; ++element)
+    {
+    if ((element == 0) != facesFirst)
+      {
+      fprintf(file, "element vertex %d\n", NumberOfVertices);
+      fprintf(file, "property float x\nproperty float y\n");
+      fprintf(file, "property double z\nproperty double confidence\n");
+      fprintf(file, "property float nx\nproperty float ny\n");
+      fprintf(file, "property float nz\nproperty float u\n");
+      fprintf(file, "property float v\nproperty uchar red\n");
+      fprintf(file, "property uchar green\nproperty uchar blue\n");
+      }
+    else
+      {
+      fprintf(file, "element face %d\n", numFaces);
+      fprintf(file, "property uchar intensity\n");
+      fprintf(file, "property list uchar int vertex_indices\n");
+      fprintf(file, "property short flags\n");
+      fprintf(file, "property uchar red\nproperty uchar green\n");
+      fprintf(file, "property uchar blue\n");
+      }
+    }
+  fprintf(file, "end_header\n");
+  for (int element = 0; element < 2; ++element)
+    {
+    if ((element == 0) != facesFirst)
+      {
+      WriteVertices(file, format);
+      }
+    else
+      {
+      WriteFaces(file, format, numFaces, mixed);
+      }
+    }
+  fclose(file);
+}
+
+vtkSmartPointer<vtkPolyData> Read(const std::string& fileName)
+{
+  vtkNew<vtkPLYReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->Update();
+  return reader->GetOutput();
+}
+
+bool CompareArrays(vtkDataArray* actual, vtkDataArray* expected,
+                   const char* name)
+{
+  if (!actual || !expected ||
+      actual->GetNumberOfTuples() != expected->GetNumberOfTuples() ||
+      actual->GetNumberOfComponents() != expected->GetNumberOfComponents())
+    {
+    cerr << "Missing or truncated " << name << endl;
+    return false;
+    }
+  for (vtkIdType i = 0; i < expected->GetNumberOfTuples(); ++i)
+    {
+    for (int c = 0; c < expected->GetNumberOfComponents(); ++c)
+      {
+      if (actual->GetComponent(i, c) != expected->GetComponent(i, c))
+        {
+        cerr << "Wrong " << name << " at " << i << endl;
+        return false;
+        }
+      }
+    }
+  return true;
+}
+
+bool Compare(vtkPolyData* actual, vtkPolyData* expected)
+{
+  return
+    actual->GetNumberOfPoints() == NumberOfVertices &&
+    CompareArrays(actual->GetPoints()->GetData(),
+                  expected->GetPoints()->GetData(), "points") &&
+    CompareArrays(actual->GetPolys()->GetData(),
+                  expected->GetPolys()->GetData(), "faces") &&
+    CompareArrays(actual->GetPointData()->GetArray("Normals"),
+                  expected->GetPointData()->GetArray("Normals"),
+                  "normals") &&
+    CompareArrays(actual->GetPointData()->GetArray("TCoords"),
+                  expected->GetPointData()->GetArray("TCoords"),
+                  "texture coordinates") &&
+    CompareArrays(actual->GetPointData()->GetArray("RGB"),
+                  expected->GetPointData()->GetArray("RGB"),
+                  "point colors") &&
+    CompareArrays(actual->GetCellData()->GetArray("intensity"),
+                  expected->GetCellData()->GetArray("intensity"),
+                  "intensity") &&
+    CompareArrays(actual->GetCellData()->GetArray("RGB"),
+                  expected->GetCellData()->GetArray("RGB"),
+                  "face colors");
+}
+}
+
+int TestPLYReaderBinary(int argc, char* argv[])
+{
+  char* tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  if (!tempDir)
+    {
+    cerr << "Could not determine temporary directory." << endl;
+    return EXIT_FAILURE;
+    }
+  std::string fileName = tempDir;
+  delete [] tempDir;
+  fileName += "/TestPLYReaderBinary.ply";
+
+  for (int facesFirst = 0; facesFirst < 2; ++facesFirst)
+    {
+    for (int mixed = 0; mixed < 2; ++mixed)
+      {
+      Write(fileName, 0, mixed != 0, facesFirst != 0);
+      vtkSmartPointer<vtkPolyData> expected = Read(fileName);
+      for (int format = 1; format < 3; ++format)
+        {
+        Write(fileName, format, mixed != 0, facesFirst != 0);
+        if (!Compare(Read(fileName), expected))
+          {
+          cerr << "Wrong output for format " << format
+               << (mixed ? " with mixed faces" : "")
+               << (facesFirst ? " with faces first" : "") << endl;
+          return EXIT_FAILURE;
+          }
+        }
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -14,22 +14,440 @@
 =========================================================================*/
 #include "vtkPLYReader.h"
 
+#include "vtkByteSwap.h"
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkPointData.h"
 #include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkPLY.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 #include <vtkSmartPointer.h>
 
+#include <algorithm>
 #include <ctype.h>
 #include <stddef.h>
+#include <string.h>
+#include <vector>
 
 vtkStandardNewMacro(vtkPLYReader);
 
+namespace
+{
+// Size in bytes of the PLY scalar types.
+const int PLYTypeSize[] = { 0, 1, 2, 4, 4, 1, 2, 4, 1, 4, 4, 8 };
+
+template <class T>
+double PLYRead(const unsigned char* p, bool bigEndian)
+{
+  T value;
+  memcpy(&value, p, sizeof(T));
+  if (bigEndian)
+    {
+    vtkByteSwap::SwapBE(&value);
+    }
+  else
+    {
+    vtkByteSwap::SwapLE(&value);
+    }
+  return value;
+}
+
+// Value of a binary scalar of the given PLY type.
+double PLYValue(const unsigned char* p, int type, bool bigEndian)
+{
+  switch (type)
+    {
+    case PLY_CHAR:
+      return static_cast<signed char>(*p);
+    case PLY_UCHAR:
+    case PLY_UINT8:
+      return *p;
+    case PLY_SHORT:
+      return PLYRead<short>(p, bigEndian);
+    case PLY_USHORT:
+      return PLYRead<unsigned short>(p, bigEndian);
+    case PLY_INT:
+    case PLY_INT32:
+      return PLYRead<int>(p, bigEndian);
+    case PLY_UINT:
+      return PLYRead<unsigned int>(p, bigEndian);
+    case PLY_FLOAT:
+    case PLY_FLOAT32:
+      return PLYRead<float>(p, bigEndian);
+    case PLY_DOUBLE:
+      return PLYRead<double>(p, bigEndian);
+    }
+  return 0.0;
+}
+
+// Unsigned char and int values converted as vtkPLY stores them.
+unsigned char PLYUChar(double value)
+{
+  return static_cast<unsigned char>(static_cast<vtkTypeInt64>(value));
+}
+
+int PLYInt(double value)
+{
+  return static_cast<int>(static_cast<vtkTypeInt64>(value));
+}
+
+// What the reader makes of a property of a binary element.
+enum PLYRole
+{
+  PLYSkip = -1,
+  PLYX, PLYY, PLYZ, PLYU, PLYV, PLYNX, PLYNY, PLYNZ,
+  PLYRed, PLYGreen, PLYBlue, PLYIntensity, PLYIndices
+};
+
+struct PLYField
+{
+  int Role;
+  int Type;
+  int CountType;
+  int IsList;
+};
+
+// Reads the vertices and the faces of binary files in bulk and decodes
+// them in parallel, instead of element by element through the generic
+// property callbacks of vtkPLY. It handles vertices without list
+// properties and faces whose only list is vertex_indices.
+class PLYBulkReader
+{
+public:
+  PLYBulkReader(PlyFile* ply) : Ply(ply)
+  {
+    this->BigEndian = ply->file_type == PLY_BINARY_BE;
+  }
+
+  // Whether the vertices and the faces can be read in bulk.
+  bool CanRead()
+  {
+    if (this->Ply->file_type == PLY_ASCII)
+      {
+      return false;
+      }
+    PlyElement* vertex = vtkPLY::find_element(this->Ply, "vertex");
+    PlyElement* face = vtkPLY::find_element(this->Ply, "face");
+    if (!vertex || !face)
+      {
+      return false;
+      }
+    const char* vertexNames[] =
+      { "x", "y", "z", "u", "v", "nx", "ny", "nz", "red", "green", "blue" };
+    const char* faceNames[] =
+      { "intensity", "red", "green", "blue" };
+    const int faceRoles[] = { PLYIntensity, PLYRed, PLYGreen, PLYBlue };
+    return this->Describe(vertex, vertexNames, 0, 11, 0, this->Vertex) &&
+           this->Describe(face, faceNames, faceRoles, 4, "vertex_indices",
+                          this->Face);
+  }
+
+  // Read numPts vertices, filling the given arrays when not null.
+  bool ReadVertices(vtkIdType numPts, vtkPoints* pts, vtkFloatArray* tcoords,
+                    vtkFloatArray* normals, vtkUnsignedCharArray* colors)
+  {
+    size_t size = 0;
+    for (size_t i = 0; i < this->Vertex.size(); ++i)
+      {
+      size += PLYTypeSize[this->Vertex[i].Type];
+      }
+    std::vector<unsigned char> records(size * numPts + 1);
+    if (fread(&records[0], size, numPts, this->Ply->fp) !=
+        static_cast<size_t>(numPts))
+      {
+      return false;
+      }
+    VertexDecoder decoder(this, &records[0], size);
+    decoder.Points =
+      vtkFloatArray::SafeDownCast(pts->GetData())->GetPointer(0);
+    decoder.TCoords = tcoords ? tcoords->GetPointer(0) : 0;
+    decoder.Normals = normals ? normals->GetPointer(0) : 0;
+    decoder.Colors = colors ? colors->GetPointer(0) : 0;
+    vtkSMPTools::For(0, numPts, decoder);
+    return true;
+  }
+
+  // Read numPolys faces into polys, filling the given arrays when not null.
+  bool ReadFaces(vtkIdType numPolys, vtkCellArray* polys,
+                 vtkUnsignedCharArray* intensity,
+                 vtkUnsignedCharArray* colors)
+  {
+    // The faces have variable sizes.  Read the file in blocks until all
+    // of them are present, finding the size of the connectivity and
+    // whether all the faces have the same number of vertices so that they
+    // can be decoded in parallel.
+    std::vector<unsigned char> records;
+    FaceDecoder decoder(this, 0);
+    size_t length = 0;
+    size_t used = 0;
+    vtkIdType connectivity = 0;
+    vtkIdType numVerts = -1;
+    bool uniform = true;
+    for (vtkIdType i = 0; i < numPolys;)
+      {
+      vtkIdType n = 0;
+      const unsigned char* begin = records.empty() ? 0 : &records[0];
+      const unsigned char* p =
+        length > used ? decoder.Skip(begin + used, begin + length, n) : 0;
+      if (!p)
+        {
+        // Read the next block.  Blocks are limited in size so that what
+        // is read past the faces can be given back below.
+        size_t block = std::max(length, static_cast<size_t>(1 << 16));
+        block = std::min(block, static_cast<size_t>(1 << 24));
+        records.resize(length + block);
+        size_t read = fread(&records[length], 1, block, this->Ply->fp);
+        if (read == 0)
+          {
+          return false;
+          }
+        length += read;
+        continue;
+        }
+      uniform = uniform && (numVerts < 0 || n == numVerts);
+      numVerts = n;
+      connectivity += n + 1;
+      used = static_cast<size_t>(p - begin);
+      ++i;
+      }
+
+    // Give back what was read past the faces, which belongs to the
+    // elements that follow.
+    long unused = static_cast<long>(length - used);
+    if (unused > 0 && fseek(this->Ply->fp, -unused, SEEK_CUR) != 0)
+      {
+      return false;
+      }
+    decoder.Records = records.empty() ? 0 : &records[0];
+
+    vtkIdTypeArray* cells = vtkIdTypeArray::New();
+    cells->SetNumberOfValues(connectivity);
+    decoder.Cells = cells->GetPointer(0);
+    decoder.Intensity = intensity ? intensity->GetPointer(0) : 0;
+    decoder.Colors = colors ? colors->GetPointer(0) : 0;
+    if (uniform && numPolys > 0)
+      {
+      decoder.RecordSize = static_cast<vtkIdType>(used) / numPolys;
+      decoder.CellSize = numVerts + 1;
+      vtkSMPTools::For(0, numPolys, decoder);
+      }
+    else
+      {
+      const unsigned char* p = decoder.Records;
+      vtkIdType* cell = decoder.Cells;
+      for (vtkIdType i = 0; i < numPolys; ++i)
+        {
+        p = decoder.Decode(p, i, cell);
+        cell += cell[0] + 1;
+        }
+      }
+    polys->SetCells(numPolys, cells);
+    cells->Delete();
+    return true;
+  }
+
+private:
+  // Describe the properties of an element, which are scalars but for the
+  // list named listName.
+  bool Describe(PlyElement* elem, const char** names, const int* roles,
+                int numNames, const char* listName,
+                std::vector<PLYField>& fields)
+  {
+    fields.resize(elem->nprops);
+    for (int i = 0; i < elem->nprops; ++i)
+      {
+      PlyProperty* prop = elem->props[i];
+      PLYField& field = fields[i];
+      field.Type = prop->external_type;
+      field.CountType = prop->count_external;
+      field.IsList = prop->is_list;
+      field.Role = PLYSkip;
+      if (field.Type <= PLY_START_TYPE || field.Type >= PLY_END_TYPE)
+        {
+        return false;
+        }
+      if (prop->is_list)
+        {
+        if (!listName || !vtkPLY::equal_strings(prop->name, listName) ||
+            field.CountType <= PLY_START_TYPE ||
+            field.CountType >= PLY_END_TYPE)
+          {
+          return false;
+          }
+        field.Role = PLYIndices;
+        listName = 0;
+        continue;
+        }
+      for (int n = 0; n < numNames; ++n)
+        {
+        if (vtkPLY::equal_strings(prop->name, names[n]))
+          {
+          field.Role = roles ? roles[n] : n;
+          }
+        }
+      }
+    return listName == 0;
+  }
+
+  class VertexDecoder
+  {
+  public:
+    VertexDecoder(PLYBulkReader* self, const unsigned char* records,
+                  size_t size)
+      : Self(self), Records(records), Size(size), Points(0), TCoords(0),
+        Normals(0), Colors(0) {}
+
+    void operator()(vtkIdType begin, vtkIdType end) const
+    {
+      const std::vector<PLYField>& fields = this->Self->Vertex;
+      bool bigEndian = this->Self->BigEndian;
+      for (vtkIdType i = begin; i < end; ++i)
+        {
+        const unsigned char* p = this->Records + i * this->Size;
+        for (size_t f = 0; f < fields.size(); ++f)
+          {
+          int role = fields[f].Role;
+          if (role != PLYSkip)
+            {
+            double value = PLYValue(p, fields[f].Type, bigEndian);
+            if (role <= PLYZ)
+              {
+              this->Points[3 * i + role] = static_cast<float>(value);
+              }
+            else if (role <= PLYV && this->TCoords)
+              {
+              this->TCoords[2 * i + role - PLYU] = static_cast<float>(value);
+              }
+            else if (role >= PLYNX && role <= PLYNZ && this->Normals)
+              {
+              this->Normals[3 * i + role - PLYNX] = static_cast<float>(value);
+              }
+            else if (role >= PLYRed && this->Colors)
+              {
+              this->Colors[3 * i + role - PLYRed] = PLYUChar(value);
+              }
+            }
+          p += PLYTypeSize[fields[f].Type];
+          }
+        }
+    }
+
+    PLYBulkReader* Self;
+    const unsigned char* Records;
+    size_t Size;
+    float* Points;
+    float* TCoords;
+    float* Normals;
+    unsigned char* Colors;
+  };
+
+  class FaceDecoder
+  {
+  public:
+    FaceDecoder(PLYBulkReader* self, const unsigned char* records)
+      : Self(self), Records(records), RecordSize(0), CellSize(0), Cells(0),
+        Intensity(0), Colors(0) {}
+
+    // Skip the face at p, setting its number of vertices. Return 0 if the
+    // face ends after end.
+    const unsigned char* Skip(const unsigned char* p,
+                              const unsigned char* end,
+                              vtkIdType& numVerts) const
+    {
+      const std::vector<PLYField>& fields = this->Self->Face;
+      for (size_t f = 0; f < fields.size(); ++f)
+        {
+        vtkIdType size = PLYTypeSize[fields[f].Type];
+        if (fields[f].IsList)
+          {
+          if (end - p < PLYTypeSize[fields[f].CountType])
+            {
+            return 0;
+            }
+          numVerts = PLYInt(PLYValue(p, fields[f].CountType,
+                                     this->Self->BigEndian));
+          p += PLYTypeSize[fields[f].CountType];
+          if (numVerts < 0)
+            {
+            return 0;
+            }
+          size *= numVerts;
+          }
+        if (end - p < size)
+          {
+          return 0;
+          }
+        p += size;
+        }
+      return p;
+    }
+
+    // Decode face i at p into cell, returning the end of the face.
+    const unsigned char* Decode(const unsigned char* p, vtkIdType i,
+                                vtkIdType* cell) const
+    {
+      const std::vector<PLYField>& fields = this->Self->Face;
+      bool bigEndian = this->Self->BigEndian;
+      for (size_t f = 0; f < fields.size(); ++f)
+        {
+        const PLYField& field = fields[f];
+        int size = PLYTypeSize[field.Type];
+        if (field.IsList)
+          {
+          vtkIdType n = PLYInt(PLYValue(p, field.CountType, bigEndian));
+          p += PLYTypeSize[field.CountType];
+          cell[0] = n;
+          for (vtkIdType k = 0; k < n; ++k, p += size)
+            {
+            cell[k + 1] = PLYInt(PLYValue(p, field.Type, bigEndian));
+            }
+          continue;
+          }
+        if (field.Role == PLYIntensity && this->Intensity)
+          {
+          this->Intensity[i] = PLYUChar(PLYValue(p, field.Type, bigEndian));
+          }
+        else if (field.Role >= PLYRed && field.Role <= PLYBlue &&
+                 this->Colors)
+          {
+          this->Colors[3 * i + field.Role - PLYRed] =
+            PLYUChar(PLYValue(p, field.Type, bigEndian));
+          }
+        p += size;
+        }
+      return p;
+    }
+
+    void operator()(vtkIdType begin, vtkIdType end) const
+    {
+      for (vtkIdType i = begin; i < end; ++i)
+        {
+        this->Decode(this->Records + i * this->RecordSize, i,
+                     this->Cells + i * this->CellSize);
+        }
+    }
+
+    PLYBulkReader* Self;
+    const unsigned char* Records;
+    vtkIdType RecordSize;
+    vtkIdType CellSize;
+    vtkIdType* Cells;
+    unsigned char* Intensity;
+    unsigned char* Colors;
+  };
+
+  PlyFile* Ply;
+  bool BigEndian;
+  std::vector<PLYField> Vertex;
+  std::vector<PLYField> Face;
+};
+}
+
 
 // Construct object with merging set to true.
 vtkPLYReader::vtkPLYReader()
@@ -210,6 +628,10 @@ int vtkPLYReader::RequestData(
     output->GetPointData()->SetTCoords(TexCoordsPoints);
     }
 
+  // Binary vertices and faces with a simple layout are read in bulk.
+  PLYBulkReader bulk(ply);
+  bool bulkAvailable = bulk.CanRead();
+
   // Okay, now we can grab the data
   int numPts = 0, numPolys = 0;
   for (int i = 0; i < nelems; i++)
@@ -218,8 +640,65 @@ int vtkPLYReader::RequestData(
     elemName = elist[i];
     vtkPLY::ply_get_element_description (ply, elemName, &numElems, &nprops);
 
+    if ( bulkAvailable && elemName &&
+         (!strcmp ("vertex", elemName) || !strcmp ("face", elemName)) )
+      {
+      bool read;
+      if ( !strcmp ("vertex", elemName) )
+        {
+        numPts = numElems;
+        vtkPoints *pts = vtkPoints::New();
+        pts->SetDataTypeToFloat();
+        pts->SetNumberOfPoints(numPts);
+        if ( TexCoordsPointsAvailable )
+          {
+          TexCoordsPoints->SetNumberOfTuples(numPts);
+          }
+        if ( NormalPointsAvailable )
+          {
+          Normals->SetNumberOfTuples(numPts);
+          }
+        if ( RGBPointsAvailable )
+          {
+          RGBPoints->SetNumberOfTuples(numPts);
+          }
+        read = bulk.ReadVertices(numPts, pts, TexCoordsPoints, Normals,
+                                 RGBPoints);
+        output->SetPoints(pts);
+        pts->Delete();
+        }
+      else
+        {
+        numPolys = numElems;
+        vtkCellArray *polys = vtkCellArray::New();
+        if ( intensityAvailable )
+          {
+          intensity->SetNumberOfTuples(numPolys);
+          }
+        if ( RGBCellsAvailable )
+          {
+          RGBCells->SetNumberOfComponents(3);
+          RGBCells->SetNumberOfTuples(numPolys);
+          }
+        read = bulk.ReadFaces(numPolys, polys, intensity, RGBCells);
+        output->SetPolys(polys);
+        polys->Delete();
+        }
+      if ( !read )
+        {
+        vtkErrorMacro(<<"Premature EOF while reading " << elemName);
+        for (int j = i; j < nelems; j++)
+          {
+          free(elist[j]);
+          }
+        free(elist);
+        vtkPLY::ply_close (ply);
+        return 0;
+        }
+      }
+
     // if we're on vertex elements, read them in
-    if ( elemName && !strcmp ("vertex", elemName) )
+    else if ( elemName && !strcmp ("vertex", elemName) )
       {
       // Create a list of points
       numPts = numElems;
@@ -291,8 +770,7 @@ int vtkPLYReader::RequestData(
       if ( intensityAvailable )
         {
         vtkPLY::ply_get_property (ply, elemName, &faceProps[1]);
-        RGBCells->SetNumberOfComponents(1);
-        RGBCells->SetNumberOfTuples(numPolys);
+        intensity->SetNumberOfTuples(numPolys);
         }
       if ( RGBCellsAvailable )
         {
@@ -0,0 +1,237 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestXMLPWriterThreads.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Writes the pieces of a parallel polydata file serially, on several
+// threads and in the background, and checks that the piece files are
+// identical and read back the same.  Then checks that a piece failing to
+// be written is reported and that the other files are deleted.
+
+#include <vtkErrorCode.h>
+#include <vtkNew.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+#include <vtkSmartPointer.h>
+#include <vtkSphereSource.h>
+#include <vtkTestErrorObserver.h>
+#include <vtkTestUtilities.h>
+#include <vtkXMLPPolyDataReader.h>
+#include <vtkXMLPPolyDataWriter.h>
+
+#include <vtksys/SystemTools.hxx>
+
+#include <sstream>
+#include <string>
+
+namespace
+{
+const int NumberOfPieces = 6;
+
+std::string PieceFileName(const std::string& base, int piece)
+{
+  std::ostringstream fileName;
+  fileName << base << "_" << piece << ".vtp";
+  return fileName.str();
+}
+
+bool ReadFile(const std::string& fileName, std::string& contents)
+{
+  ifstream is(fileName.c_str(), ios::in | ios::binary);
+  if (!is)
+    {
+    return false;
+    }
+  std::ostringstream os;
+  os << is.rdbuf();
+  contents = os.str();
+  return true;
+}
+
+void Configure(vtkXMLPPolyDataWriter* writer, vtkSphereSource* source,
+               const std::string& base, int threads, int asynchronous)
+{
+  writer->SetInputConnection(source->GetOutputPort());
+  writer->SetFileName((base + ".pvtp").c_str());
+  writer->SetNumberOfPieces(NumberOfPieces);
+  writer->SetStartPiece(0);
+  writer->SetEndPiece(NumberOfPieces - 1);
+  writer->SetNumberOfPieceThreads(threads);
+  writer->SetAsynchronousWrite(asynchronous);
+}
+
+vtkSmartPointer<vtkPolyData> Read(const std::string& base)
+{
+  vtkNew<vtkXMLPPolyDataReader> reader;
+  reader->SetFileName((base + ".pvtp").c_str());
+  reader->Update();
+  return reader->GetOutput();
+}
+
+// Check that the files written with the given base name are those of the
+// serial write.
+bool Compare(const std::string& expected, const std::string& actual)
+{
+  for (int i = 0; i < NumberOfPieces; ++i)
+    {
+    std::string a;
+    std::string b;
+    if (!ReadFile(PieceFileName(expected, i), a) ||
+        !ReadFile(PieceFileName(actual, i), b) || a != b)
+      {
+      cerr << "Piece " << i << " of " << actual << " differs from "
+           << expected << endl;
+      return false;
+      }
+    }
+
+  vtkSmartPointer<vtkPolyData> reference = Read(expected);
+  vtkSmartPointer<vtkPolyData> output = Read(actual);
+  if (reference->GetNumberOfPoints() == 0 ||
+      output->GetNumberOfPoints() != reference->GetNumberOfPoints() ||
+      output->GetNumberOfCells() != reference->GetNumberOfCells())
+    {
+    cerr << "Read " << output->GetNumberOfPoints() << " points and "
+         << output->GetNumberOfCells() << " cells from " << actual
+         << " instead of " << reference->GetNumberOfPoints() << " and "
+         << reference->GetNumberOfCells() << endl;
+    return false;
+    }
+  for (vtkIdType i = 0; i < reference->GetNumberOfPoints(); ++i)
+    {
+    double p[3];
+    double q[3];
+    reference->GetPoint(i, p);
+    output->GetPoint(i, q);
+    if (p[0] != q[0] || p[1] != q[1] || p[2] != q[2])
+      {
+      cerr << "Wrong point " << i << " read from " << actual << endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+// Check that a failed write left no file behind but the one in the way.
+bool CheckDeleted(const std::string& base, int blockedPiece)
+{
+  if (vtksys::SystemTools::FileExists((base + ".pvtp").c_str()))
+    {
+    cerr << "The summary file of a failed write was written" << endl;
+    return false;
+    }
+  for (int i = 0; i < NumberOfPieces; ++i)
+    {
+    if (i != blockedPiece &&
+        vtksys::SystemTools::FileExists(PieceFileName(base, i).c_str()))
+      {
+      cerr << "Piece " << i << " of a failed write was not deleted" << endl;
+      return false;
+      }
+    }
+  return true;
+}
+}
+
+int TestXMLPWriterThreads(int argc, char* argv[])
+{
+  char* tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  if (!tempDir)
+    {
+    cerr << "Could not determine temporary directory." << endl;
+    return EXIT_FAILURE;
+    }
+  std::string prefix = tempDir;
+  delete [] tempDir;
+  prefix += "/TestXMLPWriterThreads";
+
+  vtkNew<vtkSphereSource> source;
+  source->SetThetaResolution(64);
+  source->SetPhiResolution(32);
+
+  // The reference files, written one piece after the other.
+  std::string serial = prefix + "-serial";
+  vtkNew<vtkXMLPPolyDataWriter> serialWriter;
+  Configure(serialWriter.GetPointer(), source.GetPointer(), serial, 1, 0);
+  if (!serialWriter->Write())
+    {
+    cerr << "Error writing " << serial << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Pieces written concurrently.
+  for (int threads = 0; threads <= 3; threads += 3)
+    {
+    std::ostringstream base;
+    base << prefix << "-threads" << threads;
+    vtkNew<vtkXMLPPolyDataWriter> writer;
+    Configure(writer.GetPointer(), source.GetPointer(), base.str(),
+              threads, 0);
+    if (!writer->Write() || !Compare(serial, base.str()))
+      {
+      return EXIT_FAILURE;
+      }
+    }
+
+  // Pieces written in the background.  The pipeline may change as soon
+  // as Write() returns.
+  std::string asynchronous = prefix + "-async";
+  vtkNew<vtkXMLPPolyDataWriter> asyncWriter;
+  Configure(asyncWriter.GetPointer(), source.GetPointer(), asynchronous, 2,
+            1);
+  if (!asyncWriter->Write())
+    {
+    cerr << "Error starting to write " << asynchronous << endl;
+    return EXIT_FAILURE;
+    }
+  source->SetRadius(2.0);
+  source->Update();
+  if (!asyncWriter->WaitForWrite() ||
+      asyncWriter->GetErrorCode() != vtkErrorCode::NoError ||
+      !Compare(serial, asynchronous))
+    {
+    cerr << "Error writing " << asynchronous << " in the background" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // A directory in the way of one piece makes its write fail.  The
+  // writer of that piece reports an error of its own.
+  const int blockedPiece = 3;
+  for (int asynchronousFailure = 0; asynchronousFailure < 2;
+       ++asynchronousFailure)
+    {
+    std::string failed = prefix + (asynchronousFailure ? "-fail-async" :
+                                   "-fail");
+    vtksys::SystemTools::MakeDirectory(
+      PieceFileName(failed, blockedPiece).c_str());
+    vtkNew<vtkTest::ErrorObserver> errorObserver;
+    vtkNew<vtkXMLPPolyDataWriter> writer;
+    writer->AddObserver(vtkCommand::ErrorEvent, errorObserver.GetPointer());
+    Configure(writer.GetPointer(), source.GetPointer(), failed, 3,
+              asynchronousFailure);
+    writer->Write();
+    if ((asynchronousFailure && writer->WaitForWrite()) ||
+        writer->GetErrorCode() == vtkErrorCode::NoError ||
+        !errorObserver->GetError())
+      {
+      cerr << "Writing " << failed << " did not fail" << endl;
+      return EXIT_FAILURE;
+      }
+    if (!CheckDeleted(failed, blockedPiece))
+      {
+      return EXIT_FAILURE;
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
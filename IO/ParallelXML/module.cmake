@@ -7,7 +7,9 @@ vtk_module(vtkIOParallelXML
   PRIVATE_DEPENDS
     vtksys
   TEST_DEPENDS
+    vtkFiltersSources
     vtkParallelMPI
+    vtkTestingCore
   KIT
     vtkParallel
   )
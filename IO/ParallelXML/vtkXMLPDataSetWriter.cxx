@@ -34,11 +34,13 @@ vtkStandardNewMacro(vtkXMLPDataSetWriter);
 //----------------------------------------------------------------------------
 vtkXMLPDataSetWriter::vtkXMLPDataSetWriter()
 {
+  this->AsynchronousWriter = 0;
 }
 
 //----------------------------------------------------------------------------
 vtkXMLPDataSetWriter::~vtkXMLPDataSetWriter()
 {
+  this->WaitForWrite();
 }
 
 //----------------------------------------------------------------------------
@@ -56,6 +58,8 @@ vtkDataSet* vtkXMLPDataSetWriter::GetInput()
 //----------------------------------------------------------------------------
 int vtkXMLPDataSetWriter::WriteInternal()
 {
+  this->WaitForWrite();
+
   vtkAlgorithmOutput* input = this->GetInputConnection(0, 0);
   vtkXMLPDataWriter* writer = 0;
 
@@ -119,17 +123,44 @@ int vtkXMLPDataSetWriter::WriteInternal()
   writer->SetStartPiece(this->GetStartPiece());
   writer->SetEndPiece(this->GetEndPiece());
   writer->SetWriteSummaryFile(this->WriteSummaryFile);
+  writer->SetNumberOfPieceThreads(this->NumberOfPieceThreads);
+  writer->SetAsynchronousWrite(this->AsynchronousWrite);
   writer->AddObserver(vtkCommand::ProgressEvent, this->ProgressObserver);
 
   // Try to write.
   int result = writer->Write();
+  writer->RemoveObserver(this->ProgressObserver);
+  this->SetErrorCode(writer->GetErrorCode());
+
+  // Keep the writer until its files are complete.
+  if(this->AsynchronousWrite)
+    {
+    this->AsynchronousWriter = writer;
+    return result;
+    }
 
   // Cleanup.
-  writer->RemoveObserver(this->ProgressObserver);
   writer->Delete();
   return result;
 }
 
+//----------------------------------------------------------------------------
+int vtkXMLPDataSetWriter::WaitForWrite()
+{
+  int result = this->Superclass::WaitForWrite();
+  if(this->AsynchronousWriter)
+    {
+    if(!this->AsynchronousWriter->WaitForWrite())
+      {
+      this->SetErrorCode(this->AsynchronousWriter->GetErrorCode());
+      result = 0;
+      }
+    this->AsynchronousWriter->Delete();
+    this->AsynchronousWriter = 0;
+    }
+  return result;
+}
+
 //----------------------------------------------------------------------------
 const char* vtkXMLPDataSetWriter::GetDataSetName()
 {
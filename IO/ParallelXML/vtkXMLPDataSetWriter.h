@@ -42,6 +42,10 @@ public:
   vtkDataSet* GetInput();
   //ETX
 
+  // Description:
+  // Wait for the files written in the background to be complete.
+  virtual int WaitForWrite();
+
 protected:
   vtkXMLPDataSetWriter();
   ~vtkXMLPDataSetWriter();
@@ -57,6 +61,9 @@ protected:
   const char* GetDefaultFileExtension();
   vtkXMLWriter* CreatePieceWriter(int index);
 
+  // The writer still writing in the background.
+  vtkXMLPDataWriter* AsynchronousWriter;
+
 private:
   vtkXMLPDataSetWriter(const vtkXMLPDataSetWriter&);  // Not implemented.
   void operator=(const vtkXMLPDataSetWriter&);  // Not implemented.
@@ -17,14 +17,199 @@
 #include "vtkCallbackCommand.h"
 #include "vtkDataSet.h"
 #include "vtkErrorCode.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
 #include "vtkMultiProcessController.h"
-
+#include "vtkMultiThreader.h"
+#include "vtkObjectFactory.h"
+#include "vtkPassInputTypeAlgorithm.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+
+#include <vtksys/SystemTools.hxx>
 #include <vtksys/ios/sstream>
 
+#include <string>
+#include <vector>
+
 vtkCxxSetObjectMacro(vtkXMLPDataWriter,
                      Controller,
                      vtkMultiProcessController);
 
+//----------------------------------------------------------------------------
+// Pass the data of one piece of its input, requested as a piece writer
+// would request it.
+class vtkXMLPDataWriterPieceFilter : public vtkPassInputTypeAlgorithm
+{
+public:
+  static vtkXMLPDataWriterPieceFilter* New();
+  vtkTypeMacro(vtkXMLPDataWriterPieceFilter, vtkPassInputTypeAlgorithm);
+
+  vtkSetMacro(Piece, int);
+  vtkSetMacro(NumberOfPieces, int);
+  vtkSetMacro(GhostLevel, int);
+
+protected:
+  vtkXMLPDataWriterPieceFilter()
+    : Piece(0), NumberOfPieces(1), GhostLevel(0) {}
+
+  virtual int RequestUpdateExtent(vtkInformation*,
+                                  vtkInformationVector** inputVector,
+                                  vtkInformationVector*)
+    {
+    vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+    vtkStreamingDemandDrivenPipeline::SetUpdateExtent(
+      inInfo, this->Piece, this->NumberOfPieces, this->GhostLevel);
+    if(inInfo->Has(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT()))
+      {
+      inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(),
+        inInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT()), 6);
+      inInfo->Set(vtkStreamingDemandDrivenPipeline::EXACT_EXTENT(), 1);
+      }
+    return 1;
+    }
+
+  virtual int RequestData(vtkInformation*,
+                          vtkInformationVector** inputVector,
+                          vtkInformationVector* outputVector)
+    {
+    vtkDataObject* input = vtkDataObject::GetData(inputVector[0], 0);
+    vtkDataObject* output = vtkDataObject::GetData(outputVector, 0);
+    output->ShallowCopy(input);
+    return 1;
+    }
+
+  int Piece;
+  int NumberOfPieces;
+  int GhostLevel;
+
+private:
+  vtkXMLPDataWriterPieceFilter(const vtkXMLPDataWriterPieceFilter&);  // Not implemented.
+  void operator=(const vtkXMLPDataWriterPieceFilter&);  // Not implemented.
+};
+
+vtkStandardNewMacro(vtkXMLPDataWriterPieceFilter);
+
+//----------------------------------------------------------------------------
+class vtkXMLPDataWriterInternals
+{
+public:
+  vtkXMLPDataWriterInternals()
+    : NumberOfThreads(1), ErrorCode(vtkErrorCode::NoError), ThreadId(-1)
+    {
+    this->Threader = vtkMultiThreader::New();
+    }
+
+  ~vtkXMLPDataWriterInternals()
+    {
+    this->Threader->Delete();
+    }
+
+  // Write the files of all the pieces, then the summary file, and keep
+  // the first error.  The piece files are deleted if anything failed.
+  void WriteFiles();
+
+  std::vector<vtkSmartPointer<vtkXMLWriter> > Writers;
+  std::vector<std::string> FileNames;
+  std::vector<unsigned long> ErrorCodes;
+  int NumberOfThreads;
+
+  std::string SummaryFileName;
+  std::string SummaryContents;
+
+  unsigned long ErrorCode;
+  vtkMultiThreader* Threader;
+  int ThreadId;
+};
+
+//----------------------------------------------------------------------------
+class vtkXMLPDataWriterWritePieces
+{
+public:
+  vtkXMLPDataWriterInternals* Internals;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    for(vtkIdType i = begin; i < end; ++i)
+      {
+      vtkXMLWriter* pWriter = this->Internals->Writers[i];
+      pWriter->Write();
+      this->Internals->ErrorCodes[i] = pWriter->GetErrorCode();
+      }
+    }
+};
+
+//----------------------------------------------------------------------------
+void vtkXMLPDataWriterInternals::WriteFiles()
+{
+  vtkIdType n = static_cast<vtkIdType>(this->Writers.size());
+  this->ErrorCodes.assign(this->Writers.size(), vtkErrorCode::NoError);
+  vtkXMLPDataWriterWritePieces functor;
+  functor.Internals = this;
+  if(this->NumberOfThreads == 1)
+    {
+    functor(0, n);
+    }
+  else
+    {
+    vtkIdType grain = 1;
+    if(this->NumberOfThreads > 1)
+      {
+      grain = (n + this->NumberOfThreads - 1) / this->NumberOfThreads;
+      }
+    vtkSMPTools::For(0, n, grain, functor);
+    }
+
+  this->ErrorCode = vtkErrorCode::NoError;
+  for(size_t i = 0; i < this->ErrorCodes.size(); ++i)
+    {
+    if(this->ErrorCodes[i] != vtkErrorCode::NoError)
+      {
+      this->ErrorCode = this->ErrorCodes[i];
+      break;
+      }
+    }
+
+  if(this->ErrorCode == vtkErrorCode::NoError &&
+     !this->SummaryFileName.empty())
+    {
+    ofstream os(this->SummaryFileName.c_str(), ios::out | ios::binary);
+    if(!os)
+      {
+      this->ErrorCode = vtkErrorCode::CannotOpenFileError;
+      }
+    else
+      {
+      os.write(this->SummaryContents.c_str(),
+               static_cast<std::streamsize>(this->SummaryContents.size()));
+      os.close();
+      if(os.fail())
+        {
+        this->ErrorCode = vtkErrorCode::OutOfDiskSpaceError;
+        vtksys::SystemTools::RemoveFile(this->SummaryFileName.c_str());
+        }
+      }
+    }
+
+  if(this->ErrorCode != vtkErrorCode::NoError)
+    {
+    for(size_t i = 0; i < this->FileNames.size(); ++i)
+      {
+      vtksys::SystemTools::RemoveFile(this->FileNames[i].c_str());
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+static VTK_THREAD_RETURN_TYPE vtkXMLPDataWriterWriteFiles(void* arg)
+{
+  vtkMultiThreader::ThreadInfo* info =
+    static_cast<vtkMultiThreader::ThreadInfo*>(arg);
+  static_cast<vtkXMLPDataWriterInternals*>(info->UserData)->WriteFiles();
+  return VTK_THREAD_RETURN_VALUE;
+}
+
 //----------------------------------------------------------------------------
 vtkXMLPDataWriter::vtkXMLPDataWriter()
 {
@@ -33,6 +218,9 @@ vtkXMLPDataWriter::vtkXMLPDataWriter()
   this->NumberOfPieces = 1;
   this->GhostLevel = 0;
   this->WriteSummaryFile = 1;
+  this->NumberOfPieceThreads = 1;
+  this->AsynchronousWrite = 0;
+  this->Internals = new vtkXMLPDataWriterInternals;
 
   this->PathName = 0;
   this->FileNameBase = 0;
@@ -51,6 +239,8 @@ vtkXMLPDataWriter::vtkXMLPDataWriter()
 //----------------------------------------------------------------------------
 vtkXMLPDataWriter::~vtkXMLPDataWriter()
 {
+  this->WaitForWrite();
+  delete this->Internals;
   delete [] this->PathName;
   delete [] this->FileNameBase;
   delete [] this->FileNameExtension;
@@ -68,6 +258,9 @@ void vtkXMLPDataWriter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "EndPiece: " << this->EndPiece << "\n";
   os << indent << "GhostLevel: " << this->GhostLevel << "\n";
   os << indent << "WriteSummaryFile: " << this->WriteSummaryFile << "\n";
+  os << indent << "NumberOfPieceThreads: "
+     << this->NumberOfPieceThreads << "\n";
+  os << indent << "AsynchronousWrite: " << this->AsynchronousWrite << "\n";
 }
 
 //----------------------------------------------------------------------------
@@ -85,6 +278,9 @@ void vtkXMLPDataWriter::SetWriteSummaryFile(int flag)
 //----------------------------------------------------------------------------
 int vtkXMLPDataWriter::WriteInternal()
 {
+  // Finish writing the previous files in the background first.
+  this->WaitForWrite();
+
   // Prepare the file name.
   this->SplitFileName();
 
@@ -105,10 +301,21 @@ int vtkXMLPDataWriter::WriteInternal()
       }
     }
 
-  // Write the summary file if requested.
+  // Write the summary file if requested.  When writing in the background
+  // only its contents are generated now.
+  int background = (this->AsynchronousWrite && !this->WriteToOutputString);
   if(result && writeSummary)
     {
-    if(!this->Superclass::WriteInternal())
+    this->WriteToOutputString = background;
+    result = this->Superclass::WriteInternal();
+    if(background)
+      {
+      this->WriteToOutputString = 0;
+      this->Internals->SummaryFileName = this->FileName;
+      this->Internals->SummaryContents = this->OutputString;
+      this->OutputString.clear();
+      }
+    if(!result)
       {
       int i;
       vtkErrorMacro("Ran out of disk space; deleting file(s) already written");
@@ -119,13 +326,55 @@ int vtkXMLPDataWriter::WriteInternal()
         this->DeleteAFile(fileName);
         delete [] fileName;
         }
+      this->Internals->Writers.clear();
       return 0;
       }
     }
 
+  if(this->AsynchronousWrite && !this->Internals->Writers.empty())
+    {
+    this->Internals->ThreadId = this->Internals->Threader->SpawnThread(
+      vtkXMLPDataWriterWriteFiles, this->Internals);
+    if(this->Internals->ThreadId < 0)
+      {
+      // Threads are not available, write the files now.
+      this->Internals->WriteFiles();
+      return this->WaitForWrite();
+      }
+    }
+
   return result;
 }
 
+//----------------------------------------------------------------------------
+int vtkXMLPDataWriter::WaitForWrite()
+{
+  vtkXMLPDataWriterInternals* internals = this->Internals;
+  if(internals->ThreadId >= 0)
+    {
+    internals->Threader->TerminateThread(internals->ThreadId);
+    internals->ThreadId = -1;
+    }
+  if(internals->Writers.empty() && internals->SummaryFileName.empty())
+    {
+    return 1;
+    }
+
+  internals->Writers.clear();
+  internals->FileNames.clear();
+  internals->SummaryFileName.clear();
+  internals->SummaryContents.clear();
+  if(internals->ErrorCode != vtkErrorCode::NoError)
+    {
+    vtkErrorMacro("Error writing the files of " << this->FileName
+                  << "; deleting file(s) already written");
+    this->SetErrorCode(internals->ErrorCode);
+    internals->ErrorCode = vtkErrorCode::NoError;
+    return 0;
+    }
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 void vtkXMLPDataWriter::WritePrimaryElementAttributes(ostream &, vtkIndent)
 {
@@ -283,6 +532,23 @@ char* vtkXMLPDataWriter::CreatePieceFileName(int index, const char* path)
 //----------------------------------------------------------------------------
 int vtkXMLPDataWriter::WritePieces()
 {
+  // Produce all the pieces first to write them concurrently or in the
+  // background.
+  if(this->AsynchronousWrite ||
+     (this->NumberOfPieceThreads != 1 && this->EndPiece > this->StartPiece))
+    {
+    if(!this->PreparePieceWriters())
+      {
+      return 0;
+      }
+    if(this->AsynchronousWrite)
+      {
+      return 1;
+      }
+    this->Internals->WriteFiles();
+    return this->WaitForWrite();
+    }
+
   // Split progress range by piece.  Just assume all pieces are the
   // same size.
   float progressRange[2] = {0,0};
@@ -313,13 +579,73 @@ int vtkXMLPDataWriter::WritePieces()
 }
 
 //----------------------------------------------------------------------------
-int vtkXMLPDataWriter::WritePiece(int index)
+int vtkXMLPDataWriter::PreparePieceWriters()
 {
-  // Create the writer for the piece.  Its configuration should match
-  // our own writer.
-  vtkXMLWriter* pWriter = this->CreatePieceWriter(index);
-  pWriter->AddObserver(vtkCommand::ProgressEvent, this->ProgressObserver);
+  vtkXMLPDataWriterInternals* internals = this->Internals;
+  internals->NumberOfThreads = this->NumberOfPieceThreads;
+  internals->ErrorCode = vtkErrorCode::NoError;
+
+  vtkSmartPointer<vtkXMLPDataWriterPieceFilter> filter =
+    vtkSmartPointer<vtkXMLPDataWriterPieceFilter>::New();
+  filter->SetInputConnection(this->GetInputConnection(0, 0));
+  filter->SetNumberOfPieces(this->NumberOfPieces);
+  filter->SetGhostLevel(this->GhostLevel);
+
+  // Split progress range by piece.  Only producing the pieces is
+  // reported.
+  float progressRange[2] = {0,0};
+  this->GetProgressRange(progressRange);
+
+  for(int i=this->StartPiece; i <= this->EndPiece && !this->AbortExecute; ++i)
+    {
+    this->SetProgressRange(progressRange, i-this->StartPiece,
+                           this->EndPiece-this->StartPiece+1);
+
+    // Copy the piece so that the pipeline may change once it is written.
+    filter->SetPiece(i);
+    filter->Update();
+    vtkDataObject* output = filter->GetOutputDataObject(0);
+    vtkSmartPointer<vtkDataObject> piece;
+    piece.TakeReference(output->NewInstance());
+    piece->DeepCopy(output);
+    this->RecordPiece(i, piece);
+
+    vtkXMLWriter* pWriter = this->CreatePieceWriter(i);
+    this->ConfigurePieceWriter(pWriter, i);
+    this->SetPieceWriterInput(pWriter, piece);
+    internals->Writers.push_back(pWriter);
+    internals->FileNames.push_back(pWriter->GetFileName());
+    pWriter->Delete();
+
+    this->UpdateProgressDiscrete(progressRange[0] +
+      (progressRange[1]-progressRange[0])*(i-this->StartPiece+1)/
+      (this->EndPiece-this->StartPiece+1));
+    }
+
+  if(this->AbortExecute)
+    {
+    internals->Writers.clear();
+    internals->FileNames.clear();
+    return 0;
+    }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkXMLPDataWriter::SetPieceWriterInput(vtkXMLWriter* pWriter,
+                                            vtkDataObject* piece)
+{
+  pWriter->SetInputData(piece);
+}
 
+//----------------------------------------------------------------------------
+void vtkXMLPDataWriter::RecordPiece(int, vtkDataObject*)
+{
+}
+
+//----------------------------------------------------------------------------
+void vtkXMLPDataWriter::ConfigurePieceWriter(vtkXMLWriter* pWriter, int index)
+{
   // Set the file name.
   if(!this->PieceFileNameExtension)
     {
@@ -340,6 +666,16 @@ int vtkXMLPDataWriter::WritePiece(int index)
   pWriter->SetEncodeAppendedData(this->EncodeAppendedData);
   pWriter->SetHeaderType(this->HeaderType);
   pWriter->SetBlockSize(this->BlockSize);
+}
+
+//----------------------------------------------------------------------------
+int vtkXMLPDataWriter::WritePiece(int index)
+{
+  // Create the writer for the piece.  Its configuration should match
+  // our own writer.
+  vtkXMLWriter* pWriter = this->CreatePieceWriter(index);
+  pWriter->AddObserver(vtkCommand::ProgressEvent, this->ProgressObserver);
+  this->ConfigurePieceWriter(pWriter, index);
 
   // Write the piece.
   int result = pWriter->Write();
@@ -26,7 +26,9 @@
 #include "vtkXMLWriter.h"
 
 class vtkCallbackCommand;
+class vtkDataObject;
 class vtkMultiProcessController;
+class vtkXMLPDataWriterInternals;
 
 class VTKIOPARALLELXML_EXPORT vtkXMLPDataWriter : public vtkXMLWriter
 {
@@ -67,6 +69,31 @@ public:
   virtual void SetController(vtkMultiProcessController*);
   vtkGetObjectMacro(Controller, vtkMultiProcessController);
 
+  // Description:
+  // Get/Set the number of threads used to write the pieces assigned to
+  // this writer.  With 1, the default, each piece is written as soon as
+  // it is produced.  Otherwise the data of all the pieces are produced
+  // and copied first, and then their files are written concurrently on
+  // this many threads, or as many as vtkSMPTools uses with 0.
+  vtkSetClampMacro(NumberOfPieceThreads, int, 0, VTK_INT_MAX);
+  vtkGetMacro(NumberOfPieceThreads, int);
+
+  // Description:
+  // Get/Set whether the files are written in the background.  When on,
+  // Write() returns as soon as the data of the pieces have been copied
+  // and the contents of the summary file generated, and a separate
+  // thread writes the files while the caller goes on.  Off by default.
+  vtkSetMacro(AsynchronousWrite, int);
+  vtkGetMacro(AsynchronousWrite, int);
+  vtkBooleanMacro(AsynchronousWrite, int);
+
+  // Description:
+  // Wait until the files of an asynchronous write are complete.  Returns
+  // 0 if writing them failed, in which case the error code is set and
+  // the piece files are deleted.  Writing again or destroying the writer
+  // also waits.
+  virtual int WaitForWrite();
+
 protected:
   vtkXMLPDataWriter();
   ~vtkXMLPDataWriter();
@@ -86,6 +113,23 @@ protected:
   virtual int WritePieces();
   virtual int WritePiece(int index);
 
+  // Copy the settings of this writer to the writer of a piece.
+  void ConfigurePieceWriter(vtkXMLWriter* pWriter, int index);
+
+  // Produce the data of each piece and create a writer for it that does
+  // not depend on the pipeline.  Used when writing pieces concurrently
+  // or in the background.
+  int PreparePieceWriters();
+
+  // Make a writer created by CreatePieceWriter() write the given piece
+  // data instead of requesting it from the input.
+  virtual void SetPieceWriterInput(vtkXMLWriter* pWriter,
+                                   vtkDataObject* piece);
+
+  // Let subclasses keep what they need for the summary file from the
+  // data of a piece once it has been produced.
+  virtual void RecordPiece(int index, vtkDataObject* piece);
+
   // Callback registered with the ProgressObserver.
   static void ProgressCallbackFunction(vtkObject*, unsigned long, void*,
                                        void*);
@@ -97,6 +141,8 @@ protected:
   int NumberOfPieces;
   int GhostLevel;
   int WriteSummaryFile;
+  int NumberOfPieceThreads;
+  int AsynchronousWrite;
 
   char* PathName;
   char* FileNameBase;
@@ -108,6 +154,10 @@ protected:
 
   vtkMultiProcessController* Controller;
 
+  // The piece writers, summary file contents and thread of the current
+  // concurrent or asynchronous write.
+  vtkXMLPDataWriterInternals* Internals;
+
 private:
   vtkXMLPDataWriter(const vtkXMLPDataWriter&);  // Not implemented.
   void operator=(const vtkXMLPDataWriter&);  // Not implemented.
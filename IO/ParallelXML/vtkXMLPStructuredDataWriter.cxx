@@ -173,15 +173,33 @@ int vtkXMLPStructuredDataWriter::WritePiece(int index)
   int result = this->Superclass::WritePiece(index);
   if (result)
     {
-    // Store the extent of this piece in Extents. This is later used
-    // in WritePPieceAttributes to write the summary file.
-    vtkDataSet* input = this->GetInputAsDataSet();
-    int* ext = input->GetInformation()->Get(vtkDataObject::DATA_EXTENT());
-    this->Extents[index] = std::vector<int>(ext, ext+6);
+    this->RecordPiece(index, this->GetInputAsDataSet());
     }
   return result;
 }
 
+//----------------------------------------------------------------------------
+void vtkXMLPStructuredDataWriter::RecordPiece(int index, vtkDataObject* piece)
+{
+  // Store the extent of this piece in Extents. This is later used
+  // in WritePPieceAttributes to write the summary file.
+  int* ext = piece->GetInformation()->Get(vtkDataObject::DATA_EXTENT());
+  this->Extents[index] = std::vector<int>(ext, ext+6);
+}
+
+//----------------------------------------------------------------------------
+void vtkXMLPStructuredDataWriter::SetPieceWriterInput(vtkXMLWriter* pWriter,
+                                                      vtkDataObject* piece)
+{
+  // The piece already has the extent to write.
+  vtkXMLStructuredDataWriter* writer =
+    static_cast<vtkXMLStructuredDataWriter*>(pWriter);
+  writer->SetInputData(piece);
+  writer->SetNumberOfPieces(1);
+  writer->SetWritePiece(-1);
+  writer->SetGhostLevel(0);
+}
+
 //----------------------------------------------------------------------------
 int vtkXMLPStructuredDataWriter::ProcessRequest(vtkInformation* request,
                                                 vtkInformationVector** inputVector,
@@ -56,6 +56,8 @@ protected:
 
   virtual int WritePieces();
   virtual int WritePiece(int index);
+  virtual void SetPieceWriterInput(vtkXMLWriter* pWriter, vtkDataObject* piece);
+  virtual void RecordPiece(int index, vtkDataObject* piece);
 
 private:
   vtkXMLPStructuredDataWriter(const vtkXMLPStructuredDataWriter&);  // Not implemented.
@@ -77,6 +77,19 @@ vtkXMLWriter* vtkXMLPUnstructuredDataWriter::CreatePieceWriter(int index)
   return pWriter;
 }
 
+//----------------------------------------------------------------------------
+void vtkXMLPUnstructuredDataWriter::SetPieceWriterInput(vtkXMLWriter* pWriter,
+                                                        vtkDataObject* piece)
+{
+  // The piece already holds the cells to write, with their ghost levels.
+  vtkXMLUnstructuredDataWriter* writer =
+    static_cast<vtkXMLUnstructuredDataWriter*>(pWriter);
+  writer->SetInputData(piece);
+  writer->SetNumberOfPieces(1);
+  writer->SetWritePiece(-1);
+  writer->SetGhostLevel(0);
+}
+
 //----------------------------------------------------------------------------
 void vtkXMLPUnstructuredDataWriter::WritePData(vtkIndent indent)
 {
@@ -46,6 +46,7 @@ protected:
 
   virtual vtkXMLUnstructuredDataWriter* CreateUnstructuredPieceWriter()=0;
   vtkXMLWriter* CreatePieceWriter(int index);
+  virtual void SetPieceWriterInput(vtkXMLWriter* pWriter, vtkDataObject* piece);
   void WritePData(vtkIndent indent);
 
 private:
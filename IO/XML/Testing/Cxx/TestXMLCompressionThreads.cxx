@@ -0,0 +1,153 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestXMLCompressionThreads.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that the files written with concurrent block compression do not
+// depend on the number of compression threads, and that they are read
+// back identically whatever the number of decompression threads and the
+// compressor.
+
+#include <vtkDoubleArray.h>
+#include <vtkImageData.h>
+#include <vtkIntArray.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkSmartPointer.h>
+#include <vtkTestUtilities.h>
+#include <vtkXMLImageDataReader.h>
+#include <vtkXMLImageDataWriter.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace
+{
+// Write image to fileName and return the contents of the file.
+std::string Write(const std::string& fileName, vtkImageData* image,
+                  int threads, int byteOrder, int encode, int compressor)
+{
+  vtkNew<vtkXMLImageDataWriter> writer;
+  writer->SetInputData(image);
+  writer->SetFileName(fileName.c_str());
+  writer->SetDataModeToAppended();
+  writer->SetEncodeAppendedData(encode);
+  writer->SetByteOrder(byteOrder);
+  writer->SetCompressorType(compressor);
+  // Small blocks give several batches of blocks per array.
+  writer->SetBlockSize(1024);
+  writer->SetNumberOfCompressionThreads(threads);
+  writer->Write();
+
+  std::ifstream file(fileName.c_str(), std::ios::in | std::ios::binary);
+  std::ostringstream contents;
+  contents << file.rdbuf();
+  return contents.str();
+}
+
+bool Read(const std::string& file, int threads, vtkImageData* reference)
+{
+  vtkNew<vtkXMLImageDataReader> reader;
+  reader->ReadFromInputStringOn();
+  reader->SetInputString(file);
+  reader->SetNumberOfDecompressionThreads(threads);
+  reader->Update();
+
+  vtkPointData* pd = reader->GetOutput()->GetPointData();
+  for (int a = 0; a < reference->GetPointData()->GetNumberOfArrays(); ++a)
+    {
+    vtkDataArray* expected = reference->GetPointData()->GetArray(a);
+    vtkDataArray* actual = pd->GetArray(expected->GetName());
+    if (!actual ||
+        actual->GetNumberOfTuples() != expected->GetNumberOfTuples())
+      {
+      cerr << "Missing or truncated array " << expected->GetName() << endl;
+      return false;
+      }
+    for (vtkIdType i = 0; i < expected->GetNumberOfTuples(); ++i)
+      {
+      if (actual->GetTuple1(i) != expected->GetTuple1(i))
+        {
+        cerr << "Wrong value in " << expected->GetName() << " at " << i
+             << " with " << threads << " threads" << endl;
+        return false;
+        }
+      }
+    }
+  return true;
+}
+}
+
+int TestXMLCompressionThreads(int argc, char* argv[])
+{
+  char* tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  if (!tempDir)
+    {
+    cerr << "Could not determine temporary directory." << endl;
+    return EXIT_FAILURE;
+    }
+  std::string fileName = tempDir;
+  delete [] tempDir;
+  fileName += "/TestXMLCompressionThreads.vti";
+
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(40, 30, 20);
+  vtkIdType numPoints = image->GetNumberOfPoints();
+
+  vtkNew<vtkDoubleArray> doubles;
+  doubles->SetName("doubles");
+  doubles->SetNumberOfTuples(numPoints);
+  vtkNew<vtkIntArray> ints;
+  ints->SetName("ints");
+  ints->SetNumberOfTuples(numPoints);
+  for (vtkIdType i = 0; i < numPoints; ++i)
+    {
+    doubles->SetValue(i, 0.25 * (i % 1000));
+    ints->SetValue(i, static_cast<int>(i * 7 % 513));
+    }
+  image->GetPointData()->AddArray(doubles.GetPointer());
+  image->GetPointData()->AddArray(ints.GetPointer());
+
+  int byteOrders[2] =
+    { vtkXMLWriter::LittleEndian, vtkXMLWriter::BigEndian };
+  int compressors[2] = { vtkXMLWriter::ZLIB, vtkXMLWriter::ZSTD };
+  for (int c = 0; c < 2; ++c)
+    {
+    for (int b = 0; b < 2; ++b)
+      {
+      for (int encode = 0; encode < 2; ++encode)
+        {
+        std::string serial = Write(fileName, image.GetPointer(), 1,
+                                   byteOrders[b], encode, compressors[c]);
+        for (int threads = 0; threads <= 3; ++threads)
+          {
+          if (Write(fileName, image.GetPointer(), threads, byteOrders[b],
+                    encode, compressors[c]) != serial)
+            {
+            cerr << "Output differs with " << threads
+                 << " compression threads" << endl;
+            return EXIT_FAILURE;
+            }
+          // The reader finds the compressor from the file.
+          if (!Read(serial, threads, image.GetPointer()))
+            {
+            return EXIT_FAILURE;
+            }
+          }
+        }
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,209 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestXMLImageDataReaderSubExtent.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that sub-extents of image data are read correctly from raw and
+// compressed appended data, that enabling an array only reads that array,
+// and that the arrays are read again when the file changes.
+
+#include <vtkCellData.h>
+#include <vtkDataArraySelection.h>
+#include <vtkDoubleArray.h>
+#include <vtkImageData.h>
+#include <vtkIntArray.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkTestUtilities.h>
+#include <vtkXMLImageDataReader.h>
+#include <vtkXMLImageDataWriter.h>
+
+#include <string>
+
+namespace
+{
+void Fill(vtkImageData* image, int scale)
+{
+  vtkIdType numPoints = image->GetNumberOfPoints();
+  vtkIdType numCells = image->GetNumberOfCells();
+  vtkNew<vtkDoubleArray> a;
+  a->SetName("a");
+  a->SetNumberOfTuples(numPoints);
+  vtkNew<vtkIntArray> b;
+  b->SetName("b");
+  b->SetNumberOfComponents(2);
+  b->SetNumberOfTuples(numPoints);
+  for (vtkIdType i = 0; i < numPoints; ++i)
+    {
+    a->SetValue(i, 0.5 * i * scale);
+    b->SetTuple2(i, static_cast<double>(i * scale), -i);
+    }
+  vtkNew<vtkDoubleArray> c;
+  c->SetName("c");
+  c->SetNumberOfTuples(numCells);
+  for (vtkIdType i = 0; i < numCells; ++i)
+    {
+    c->SetValue(i, 2.0 * i * scale);
+    }
+  image->GetPointData()->AddArray(a.GetPointer());
+  image->GetPointData()->AddArray(b.GetPointer());
+  image->GetCellData()->AddArray(c.GetPointer());
+}
+
+void Write(vtkImageData* image, const std::string& fileName, int compress)
+{
+  vtkNew<vtkXMLImageDataWriter> writer;
+  writer->SetInputData(image);
+  writer->SetFileName(fileName.c_str());
+  writer->SetDataModeToAppended();
+  writer->EncodeAppendedDataOff();
+  if (!compress)
+    {
+    writer->SetCompressorTypeToNone();
+    }
+  writer->Write();
+}
+
+void Update(vtkXMLImageDataReader* reader, int* extent)
+{
+  reader->UpdateInformation();
+  reader->SetUpdateExtent(extent);
+  reader->Update();
+}
+
+// Compare the values of an array over the extent of the output.
+bool Compare(vtkImageData* output, vtkImageData* input, const char* name,
+             bool cells)
+{
+  vtkDataArray* actual = cells ?
+    output->GetCellData()->GetArray(name) :
+    output->GetPointData()->GetArray(name);
+  vtkDataArray* expected = cells ?
+    input->GetCellData()->GetArray(name) :
+    input->GetPointData()->GetArray(name);
+  if (!actual)
+    {
+    cerr << "Missing array " << name << endl;
+    return false;
+    }
+  int extent[6];
+  output->GetExtent(extent);
+  int last = cells ? 1 : 0;
+  vtkIdType o = 0;
+  for (int k = extent[4]; k <= extent[5] - last; ++k)
+    {
+    for (int j = extent[2]; j <= extent[3] - last; ++j)
+      {
+      for (int i = extent[0]; i <= extent[1] - last; ++i, ++o)
+        {
+        int ijk[3] = { i, j, k };
+        vtkIdType id = cells ? input->ComputeCellId(ijk) :
+          input->ComputePointId(ijk);
+        for (int c = 0; c < expected->GetNumberOfComponents(); ++c)
+          {
+          if (actual->GetComponent(o, c) != expected->GetComponent(id, c))
+            {
+            cerr << "Wrong value in " << name << " at " << i << " " << j
+                 << " " << k << endl;
+            return false;
+            }
+          }
+        }
+      }
+    }
+  return o == actual->GetNumberOfTuples();
+}
+}
+
+int TestXMLImageDataReaderSubExtent(int argc, char* argv[])
+{
+  char* tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  if (!tempDir)
+    {
+    cerr << "Could not determine temporary directory." << endl;
+    return EXIT_FAILURE;
+    }
+  std::string fileName = tempDir;
+  delete [] tempDir;
+  fileName += "/TestXMLImageDataReaderSubExtent.vti";
+
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(20, 15, 10);
+  Fill(image.GetPointer(), 1);
+
+  int extent[6] = { 3, 11, 4, 4, 2, 7 };
+  for (int compress = 0; compress < 2; ++compress)
+    {
+    Write(image.GetPointer(), fileName, compress);
+
+    vtkNew<vtkXMLImageDataReader> reader;
+    reader->SetFileName(fileName.c_str());
+    reader->UpdateInformation();
+    reader->GetPointDataArraySelection()->DisableAllArrays();
+    reader->GetPointDataArraySelection()->EnableArray("a");
+    reader->GetCellDataArraySelection()->DisableAllArrays();
+    Update(reader.GetPointer(), extent);
+
+    vtkImageData* output = reader->GetOutput();
+    if (!Compare(output, image.GetPointer(), "a", false) ||
+        output->GetPointData()->GetArray("b"))
+      {
+      return EXIT_FAILURE;
+      }
+
+    // Enabling more arrays keeps those already read.
+    vtkDataArray* a = output->GetPointData()->GetArray("a");
+    reader->GetPointDataArraySelection()->EnableArray("b");
+    reader->GetCellDataArraySelection()->EnableArray("c");
+    Update(reader.GetPointer(), extent);
+    output = reader->GetOutput();
+    if (output->GetPointData()->GetArray("a") != a)
+      {
+      cerr << "Array a was read again" << endl;
+      return EXIT_FAILURE;
+      }
+    if (!Compare(output, image.GetPointer(), "a", false) ||
+        !Compare(output, image.GetPointer(), "b", false) ||
+        !Compare(output, image.GetPointer(), "c", true))
+      {
+      return EXIT_FAILURE;
+      }
+
+    // Another extent or a new file reads every array again.
+    int other[6] = { 0, 19, 0, 14, 5, 5 };
+    Update(reader.GetPointer(), other);
+    output = reader->GetOutput();
+    if (!Compare(output, image.GetPointer(), "a", false) ||
+        !Compare(output, image.GetPointer(), "c", true))
+      {
+      return EXIT_FAILURE;
+      }
+
+    vtkNew<vtkImageData> changed;
+    changed->SetDimensions(20, 15, 10);
+    Fill(changed.GetPointer(), 3);
+    Write(changed.GetPointer(), fileName, compress);
+    reader->Modified();
+    Update(reader.GetPointer(), other);
+    output = reader->GetOutput();
+    if (!Compare(output, changed.GetPointer(), "a", false) ||
+        !Compare(output, changed.GetPointer(), "b", false) ||
+        !Compare(output, changed.GetPointer(), "c", true))
+      {
+      cerr << "Arrays not read again from the new file" << endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
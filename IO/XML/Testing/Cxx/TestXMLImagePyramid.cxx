@@ -0,0 +1,242 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestXMLImagePyramid.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Writes an image pyramid and checks that sub-extents of the full
+// resolution are read exactly from the chunks that overlap them, and that
+// each lower level averages blocks of 2x2x2 samples of the level above.
+// The summary must describe the levels without listing their chunks, and
+// the levels must be written for arrays that are not the active scalars.
+
+#include <vtkDataArray.h>
+#include <vtkFloatArray.h>
+#include <vtkImageData.h>
+#include <vtkImageShrink3D.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkSmartPointer.h>
+#include <vtkTestUtilities.h>
+#include <vtkXMLDataElement.h>
+#include <vtkXMLDataParser.h>
+#include <vtkXMLImagePyramidReader.h>
+#include <vtkXMLImagePyramidWriter.h>
+
+#include <cmath>
+#include <string>
+
+namespace
+{
+vtkSmartPointer<vtkImageData> Read(vtkXMLImagePyramidReader* reader,
+                                   int level, int* extent)
+{
+  reader->SetResolutionLevel(level);
+  reader->UpdateInformation();
+  if (extent)
+    {
+    reader->SetUpdateExtent(extent);
+    }
+  else
+    {
+    reader->SetUpdateExtentToWholeExtent();
+    }
+  reader->Update();
+  vtkSmartPointer<vtkImageData> output = vtkSmartPointer<vtkImageData>::New();
+  output->DeepCopy(reader->GetOutput());
+  return output;
+}
+
+// Compare the scalars of actual with those of expected at the same
+// structured coordinates.
+bool Compare(vtkImageData* actual, vtkImageData* expected, double tolerance)
+{
+  vtkDataArray* actualScalars = actual->GetPointData()->GetScalars();
+  vtkDataArray* expectedScalars = expected->GetPointData()->GetScalars();
+  if (!actualScalars || !expectedScalars)
+    {
+    cerr << "Missing scalars" << endl;
+    return false;
+    }
+  for (int axis = 0; axis < 3; ++axis)
+    {
+    if (fabs(actual->GetOrigin()[axis] - expected->GetOrigin()[axis]) > 1e-9 ||
+        actual->GetSpacing()[axis] != expected->GetSpacing()[axis])
+      {
+      cerr << "Wrong origin or spacing along axis " << axis << endl;
+      return false;
+      }
+    }
+  int extent[6];
+  actual->GetExtent(extent);
+  if (actualScalars->GetNumberOfTuples() != actual->GetNumberOfPoints())
+    {
+    cerr << "Truncated scalars" << endl;
+    return false;
+    }
+  for (int k = extent[4]; k <= extent[5]; ++k)
+    {
+    for (int j = extent[2]; j <= extent[3]; ++j)
+      {
+      for (int i = extent[0]; i <= extent[1]; ++i)
+        {
+        int ijk[3] = { i, j, k };
+        double a = actualScalars->GetTuple1(actual->ComputePointId(ijk));
+        double e = expectedScalars->GetTuple1(expected->ComputePointId(ijk));
+        if (fabs(a - e) > tolerance)
+          {
+          cerr << "Wrong value " << a << " instead of " << e << " at " << i
+               << " " << j << " " << k << endl;
+          return false;
+          }
+        }
+      }
+    }
+  return true;
+}
+
+// Average the blocks of 2x2x2 samples of image, centered between them.
+vtkSmartPointer<vtkImageData> Shrink(vtkImageData* image)
+{
+  vtkNew<vtkImageShrink3D> shrink;
+  shrink->SetInputData(image);
+  shrink->SetShrinkFactors(2, 2, 2);
+  shrink->AveragingOn();
+  shrink->Update();
+  vtkSmartPointer<vtkImageData> output = shrink->GetOutput();
+  double origin[3];
+  for (int axis = 0; axis < 3; ++axis)
+    {
+    origin[axis] = image->GetOrigin()[axis] + 0.5 * image->GetSpacing()[axis];
+    }
+  output->SetOrigin(origin);
+  return output;
+}
+}
+
+int TestXMLImagePyramid(int argc, char* argv[])
+{
+  char* tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  if (!tempDir)
+    {
+    cerr << "Could not determine temporary directory." << endl;
+    return EXIT_FAILURE;
+    }
+  std::string fileName = tempDir;
+  delete [] tempDir;
+  fileName += "/TestXMLImagePyramid.vtip";
+
+  vtkNew<vtkImageData> image;
+  image->SetExtent(0, 49, 0, 36, 0, 8);
+  image->SetOrigin(-1.0, 2.0, 0.5);
+  image->SetSpacing(0.5, 0.25, 1.0);
+  vtkNew<vtkFloatArray> scalars;
+  scalars->SetName("density");
+  scalars->SetNumberOfTuples(image->GetNumberOfPoints());
+  for (vtkIdType i = 0; i < image->GetNumberOfPoints(); ++i)
+    {
+    double x[3];
+    image->GetPoint(i, x);
+    scalars->SetValue(i, static_cast<float>(sin(x[0]) * cos(x[1]) + x[2]));
+    }
+  image->GetPointData()->SetScalars(scalars.GetPointer());
+
+  for (int mode = 0; mode < 2; ++mode)
+    {
+    vtkNew<vtkXMLImagePyramidWriter> writer;
+    writer->SetInputData(image.GetPointer());
+    writer->SetFileName(fileName.c_str());
+    writer->SetChunkSize(16, 16, 4);
+    if (mode)
+      {
+      writer->SetDataModeToBinary();
+      writer->SetCompressorTypeToNone();
+      }
+    writer->Write();
+
+    // Only the levels are in the summary.
+    vtkNew<vtkXMLDataParser> parser;
+    parser->SetFileName(fileName.c_str());
+    vtkXMLDataElement* summary = parser->Parse() ?
+      parser->GetRootElement()->FindNestedElementWithName("ImagePyramid") : 0;
+    if (!summary || summary->GetNumberOfNestedElements() != 3 ||
+        summary->LookupElementWithName("Chunk"))
+      {
+      cerr << "Wrong summary" << endl;
+      return EXIT_FAILURE;
+      }
+
+    vtkNew<vtkXMLImagePyramidReader> reader;
+    reader->SetFileName(fileName.c_str());
+    reader->UpdateInformation();
+    if (reader->GetNumberOfLevels() != 3)
+      {
+      cerr << "Wrote " << reader->GetNumberOfLevels() << " levels" << endl;
+      return EXIT_FAILURE;
+      }
+
+    // A sub-extent of the full resolution overlaps 2 chunks along each
+    // axis.
+    int extent[6] = { 10, 20, 5, 30, 2, 6 };
+    vtkSmartPointer<vtkImageData> full = Read(reader.GetPointer(), 0, extent);
+    if (reader->GetNumberOfChunksRead() != 8 ||
+        !Compare(full, image.GetPointer(), 0.0))
+      {
+      cerr << "Wrong sub-extent with " << reader->GetNumberOfChunksRead()
+           << " chunks read" << endl;
+      return EXIT_FAILURE;
+      }
+
+    // Each lower level averages the level above.
+    vtkSmartPointer<vtkImageData> above = image.GetPointer();
+    for (int level = 1; level < 3; ++level)
+      {
+      vtkSmartPointer<vtkImageData> expected = Shrink(above);
+      vtkSmartPointer<vtkImageData> actual =
+        Read(reader.GetPointer(), level, 0);
+      int expectedExtent[6];
+      expected->GetExtent(expectedExtent);
+      if (!reader->GetLevelWholeExtent(level, extent) ||
+          extent[1] != expectedExtent[1] || extent[3] != expectedExtent[3] ||
+          extent[5] != expectedExtent[5] ||
+          !Compare(actual, expected, 0.0))
+        {
+        cerr << "Wrong level " << level << endl;
+        return EXIT_FAILURE;
+        }
+      above = actual;
+      }
+    }
+
+  // Point data arrays that are not the active scalars are averaged too.
+  vtkNew<vtkImageData> unnamed;
+  unnamed->ShallowCopy(image.GetPointer());
+  unnamed->GetPointData()->SetActiveScalars(0);
+  vtkNew<vtkXMLImagePyramidWriter> writer;
+  writer->SetInputData(unnamed.GetPointer());
+  writer->SetFileName(fileName.c_str());
+  writer->SetChunkSize(16, 16, 4);
+  writer->Write();
+  vtkNew<vtkXMLImagePyramidReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->UpdateInformation();
+  vtkSmartPointer<vtkImageData> level1 = Read(reader.GetPointer(), 1, 0);
+  if (reader->GetNumberOfLevels() != 3 ||
+      !level1->GetPointData()->GetArray("density"))
+    {
+    cerr << "Wrote " << reader->GetNumberOfLevels()
+         << " levels without active scalars" << endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,158 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestXMLMemoryMapping.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that memory mapped raw appended data are read correctly, whether
+// they can be used in place or not, that they remain valid after the
+// reader is destroyed, and that modifying them does not change the file.
+
+#include <vtkDoubleArray.h>
+#include <vtkImageData.h>
+#include <vtkIntArray.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkSmartPointer.h>
+#include <vtkTestUtilities.h>
+#include <vtkUnsignedCharArray.h>
+#include <vtkXMLImageDataReader.h>
+#include <vtkXMLImageDataWriter.h>
+
+#include <string>
+
+namespace
+{
+void Write(vtkImageData* image, const std::string& fileName, int byteOrder)
+{
+  vtkNew<vtkXMLImageDataWriter> writer;
+  writer->SetInputData(image);
+  writer->SetFileName(fileName.c_str());
+  writer->SetDataModeToAppended();
+  writer->EncodeAppendedDataOff();
+  writer->SetCompressorTypeToNone();
+  writer->SetByteOrder(byteOrder);
+  writer->Write();
+}
+
+vtkSmartPointer<vtkImageData> Read(const std::string& fileName, int mapped)
+{
+  vtkNew<vtkXMLImageDataReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->SetUseMemoryMapping(mapped);
+  reader->Update();
+  return reader->GetOutput();
+}
+
+bool Compare(vtkImageData* actual, vtkImageData* expected)
+{
+  for (int a = 0; a < expected->GetPointData()->GetNumberOfArrays(); ++a)
+    {
+    vtkDataArray* e = expected->GetPointData()->GetArray(a);
+    vtkDataArray* x = actual->GetPointData()->GetArray(e->GetName());
+    if (!x || x->GetNumberOfTuples() != e->GetNumberOfTuples() ||
+        x->GetNumberOfComponents() != e->GetNumberOfComponents())
+      {
+      cerr << "Missing or truncated array " << e->GetName() << endl;
+      return false;
+      }
+    for (vtkIdType i = 0; i < e->GetNumberOfTuples(); ++i)
+      {
+      for (int c = 0; c < e->GetNumberOfComponents(); ++c)
+        {
+        if (x->GetComponent(i, c) != e->GetComponent(i, c))
+          {
+          cerr << "Wrong value in " << e->GetName() << " at " << i << endl;
+          return false;
+          }
+        }
+      }
+    }
+  return true;
+}
+}
+
+int TestXMLMemoryMapping(int argc, char* argv[])
+{
+  char* tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  if (!tempDir)
+    {
+    cerr << "Could not determine temporary directory." << endl;
+    return EXIT_FAILURE;
+    }
+  std::string fileName = tempDir;
+  delete [] tempDir;
+  fileName += "/TestXMLMemoryMapping.vti";
+
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(30, 20, 10);
+  vtkIdType numPoints = image->GetNumberOfPoints();
+
+  // The unsigned chars shift the following arrays off their alignment.
+  vtkNew<vtkUnsignedCharArray> chars;
+  chars->SetName("chars");
+  chars->SetNumberOfTuples(numPoints);
+  vtkNew<vtkDoubleArray> vectors;
+  vectors->SetName("vectors");
+  vectors->SetNumberOfComponents(3);
+  vectors->SetNumberOfTuples(numPoints);
+  vtkNew<vtkIntArray> ints;
+  ints->SetName("ints");
+  ints->SetNumberOfTuples(numPoints);
+  for (vtkIdType i = 0; i < numPoints; ++i)
+    {
+    chars->SetValue(i, static_cast<unsigned char>(i % 253));
+    vectors->SetTuple3(i, 0.5 * i, -1.0 * i, 0.25 * (i % 100));
+    ints->SetValue(i, static_cast<int>(i * 7 % 513));
+    }
+  image->GetPointData()->AddArray(chars.GetPointer());
+  image->GetPointData()->AddArray(vectors.GetPointer());
+  image->GetPointData()->AddArray(ints.GetPointer());
+
+  // Data in the other byte order cannot be used in place and are read.
+  int byteOrders[2] =
+    { vtkXMLWriter::LittleEndian, vtkXMLWriter::BigEndian };
+  for (int b = 0; b < 2; ++b)
+    {
+    Write(image.GetPointer(), fileName, byteOrders[b]);
+
+    // The arrays outlive the reader and its mapping of the file.
+    vtkSmartPointer<vtkImageData> mapped = Read(fileName, 1);
+    if (!Compare(mapped, image.GetPointer()))
+      {
+      return EXIT_FAILURE;
+      }
+
+    // Modifying the mapped arrays leaves the file unchanged.
+    vtkDataArray* values = mapped->GetPointData()->GetArray("ints");
+    for (vtkIdType i = 0; i < values->GetNumberOfTuples(); ++i)
+      {
+      values->SetTuple1(i, -1);
+      }
+    if (!Compare(Read(fileName, 1), image.GetPointer()) ||
+        !Compare(Read(fileName, 0), image.GetPointer()))
+      {
+      cerr << "File changed by modifying a mapped array" << endl;
+      return EXIT_FAILURE;
+      }
+
+    // Growing a mapped array copies it.
+    values->InsertNextTuple1(5);
+    if (values->GetTuple1(numPoints) != 5 || values->GetTuple1(0) != -1)
+      {
+      cerr << "Wrong values after resizing a mapped array" << endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
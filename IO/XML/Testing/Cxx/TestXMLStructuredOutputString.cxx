@@ -0,0 +1,64 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestXMLStructuredOutputString.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that structured data writers can write to an output string
+// without a file name, and that the string reads back.
+
+#include <vtkErrorCode.h>
+#include <vtkFloatArray.h>
+#include <vtkImageData.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkXMLImageDataReader.h>
+#include <vtkXMLImageDataWriter.h>
+
+int TestXMLStructuredOutputString(int, char*[])
+{
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(5, 4, 3);
+  vtkNew<vtkFloatArray> scalars;
+  scalars->SetName("scalars");
+  scalars->SetNumberOfTuples(image->GetNumberOfPoints());
+  for (vtkIdType i = 0; i < image->GetNumberOfPoints(); ++i)
+    {
+    scalars->SetValue(i, 0.5f * i);
+    }
+  image->GetPointData()->SetScalars(scalars.GetPointer());
+
+  vtkNew<vtkXMLImageDataWriter> writer;
+  writer->SetInputData(image.GetPointer());
+  writer->WriteToOutputStringOn();
+  writer->Write();
+  if (writer->GetErrorCode() != vtkErrorCode::NoError ||
+      writer->GetOutputString().empty())
+    {
+    cerr << "Could not write to an output string" << endl;
+    return EXIT_FAILURE;
+    }
+
+  vtkNew<vtkXMLImageDataReader> reader;
+  reader->ReadFromInputStringOn();
+  reader->SetInputString(writer->GetOutputString());
+  reader->Update();
+  vtkDataArray* actual =
+    reader->GetOutput()->GetPointData()->GetArray("scalars");
+  if (!actual || actual->GetNumberOfTuples() != image->GetNumberOfPoints() ||
+      actual->GetTuple1(17) != 8.5)
+    {
+    cerr << "Wrong data read from the output string" << endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -11,6 +11,7 @@ vtk_module(vtkIOXML
     vtkFiltersCore
     vtkFiltersHyperTree
     vtkFiltersSources
+    vtkImagingCore
     vtkImagingSources
     vtkInfovisCore
     vtkIOLegacy
@@ -18,6 +18,7 @@
 #include "vtkCallbackCommand.h"
 #include "vtkCellData.h"
 #include "vtkDataArray.h"
+#include "vtkDataArrayTemplate.h"
 #include "vtkDataArraySelection.h"
 #include "vtkDataSet.h"
 #include "vtkPointData.h"
@@ -280,7 +281,7 @@ void vtkXMLDataReader::SetupOutputData()
         vtkAbstractArray* array = this->CreateArray(eNested);
         if (array)
           {
-          array->SetNumberOfTuples(pointTuples);
+          this->AllocateArray(eNested, array, pointTuples);
           pointData->AddArray(array);
           array->Delete();
           }
@@ -306,7 +307,7 @@ void vtkXMLDataReader::SetupOutputData()
         vtkAbstractArray* array = this->CreateArray(eNested);
         if (array)
           {
-          array->SetNumberOfTuples(cellTuples);
+          this->AllocateArray(eNested, array, cellTuples);
           cellData->AddArray(array);
           array->Delete();
           }
@@ -516,7 +517,7 @@ void vtkXMLDataReader::ReadXMLData()
         {
         if(eNested->GetScalarAttribute("NumberOfTuples", numTuples))
           {
-          array->SetNumberOfTuples(numTuples);
+          this->AllocateArray(eNested, array, numTuples);
           }
         else
           {
@@ -687,6 +688,62 @@ int vtkXMLDataReaderReadArrayValues(
   return result;
 }
 
+//----------------------------------------------------------------------------
+// Make a whole array point into the memory mapped appended data, if the
+// parser can provide them in place.
+template <class T>
+int vtkXMLDataReaderMapArrayValues(vtkXMLDataParser* xmlparser,
+  vtkTypeInt64 offset, vtkDataArrayTemplate<T>* array, vtkIdType numValues)
+{
+  void* data = xmlparser->MapAppendedData(offset, 0, numValues,
+                                          array->GetDataType());
+  if (!data)
+    {
+    return 0;
+    }
+  if (data == array->GetVoidPointer(0) &&
+      numValues == array->GetNumberOfTuples()*array->GetNumberOfComponents())
+    {
+    // The array was mapped to these values when it was allocated.
+    vtkXMLDataParser::ReleaseMappedData(data);
+    return 1;
+    }
+  array->SetArray(static_cast<T*>(data), numValues, 0,
+                  vtkDataArrayTemplate<T>::VTK_DATA_ARRAY_USER_DEFINED);
+  array->SetArrayFreeFunction(vtkXMLDataParser::ReleaseMappedData);
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkXMLDataReader::AllocateArray(vtkXMLDataElement* da,
+                                     vtkAbstractArray* array,
+                                     vtkIdType numTuples)
+{
+  // Appended data holding enough values may be used in place when the
+  // file is memory mapped, instead of allocating memory that
+  // ReadArrayValues() would replace by the mapping anyway.  Values from
+  // other pieces or time steps are later read into the mapping, which is
+  // copy-on-write, or replace it.
+  vtkIdType numValues = numTuples*array->GetNumberOfComponents();
+  vtkTypeInt64 offset = 0;
+  int mapped = 0;
+  if (this->UseMemoryMapping && numValues > 0 &&
+      da->GetScalarAttribute("offset", offset) &&
+      array->GetArrayType() == vtkAbstractArray::DataArrayTemplate)
+    {
+    switch (array->GetDataType())
+      {
+      vtkTemplateMacro(
+        mapped = vtkXMLDataReaderMapArrayValues(this->XMLParser, offset,
+          static_cast<vtkDataArrayTemplate<VTK_TT>*>(array), numValues));
+      }
+    }
+  if (!mapped)
+    {
+    array->SetNumberOfTuples(numTuples);
+    }
+}
+
 //----------------------------------------------------------------------------
 int vtkXMLDataReader::ReadArrayValues(vtkXMLDataElement* da, vtkIdType arrayIndex,
   vtkAbstractArray* array, vtkIdType startIndex,
@@ -698,20 +755,44 @@ int vtkXMLDataReader::ReadArrayValues(vtkXMLDataElement* da, vtkIdType arrayInde
     return 0;
     }
   this->InReadData = 1;
-  int result;
-  // All arrays types except vtkBitArray.
-  vtkArrayIterator* iter = array->NewIterator();
-  switch (array->GetDataType())
+  int result = 0;
+  int mapped = 0;
+
+  // Appended data filling a whole array may be used in place when the
+  // file is memory mapped.
+  if (this->UseMemoryMapping && da->GetAttribute("offset") &&
+      arrayIndex == 0 && startIndex == 0 &&
+      numValues ==
+        array->GetNumberOfTuples()*array->GetNumberOfComponents() &&
+      array->GetArrayType() == vtkAbstractArray::DataArrayTemplate)
     {
-    vtkArrayIteratorTemplateMacro(
-      result = vtkXMLDataReaderReadArrayValues(da, this->XMLParser,
-        arrayIndex, static_cast<VTK_TT*>(iter), startIndex, numValues));
-  default:
-    result = 0;
+    vtkTypeInt64 offset = 0;
+    da->GetScalarAttribute("offset", offset);
+    switch (array->GetDataType())
+      {
+      vtkTemplateMacro(
+        mapped = vtkXMLDataReaderMapArrayValues(this->XMLParser, offset,
+          static_cast<vtkDataArrayTemplate<VTK_TT>*>(array), numValues));
+      }
+    result = mapped;
     }
-  if (iter)
+
+  // All arrays types except vtkBitArray.
+  if (!mapped)
     {
-    iter->Delete();
+    vtkArrayIterator* iter = array->NewIterator();
+    switch (array->GetDataType())
+      {
+      vtkArrayIteratorTemplateMacro(
+        result = vtkXMLDataReaderReadArrayValues(da, this->XMLParser,
+          arrayIndex, static_cast<VTK_TT*>(iter), startIndex, numValues));
+    default:
+      result = 0;
+      }
+    if (iter)
+      {
+      iter->Delete();
+      }
     }
   // Marking the array modified is essential, since otherwise, when reading
   // multiple time-steps, the array does not realize that its contents may have
@@ -84,6 +84,12 @@ protected:
   int ReadArrayValues(vtkXMLDataElement* da, vtkIdType arrayIndex, vtkAbstractArray* array,
     vtkIdType startIndex, vtkIdType numValues);
 
+  // Set the number of tuples of an array created for the given element.
+  // With UseMemoryMapping the array points into the mapped file, when
+  // possible, instead of being allocated.
+  void AllocateArray(vtkXMLDataElement* da, vtkAbstractArray* array,
+                     vtkIdType numTuples);
+
 
 
   // Callback registered with the DataProgressObserver.
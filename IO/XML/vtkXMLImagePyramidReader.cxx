@@ -0,0 +1,404 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkXMLImagePyramidReader.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkXMLImagePyramidReader.h"
+
+#include "vtkDataArray.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkXMLDataElement.h"
+#include "vtkXMLDataParser.h"
+#include "vtkXMLFileReadTester.h"
+#include "vtkXMLImageDataReader.h"
+
+#include <vtksys/SystemTools.hxx>
+#include <vtksys/ios/sstream>
+
+#include <algorithm>
+
+vtkStandardNewMacro(vtkXMLImagePyramidReader);
+
+//----------------------------------------------------------------------------
+// Copy the values of a chunk into the rows of the output it covers.
+static void vtkXMLImagePyramidReaderCopyChunk(vtkDataArray* inArray,
+                                              const int inExt[6],
+                                              vtkDataArray* outArray,
+                                              const int outExt[6])
+{
+  vtkIdType tupleSize =
+    inArray->GetDataTypeSize() * inArray->GetNumberOfComponents();
+  vtkIdType rowSize = (inExt[1] - inExt[0] + 1) * tupleSize;
+  vtkIdType outIncs[3];
+  outIncs[0] = tupleSize;
+  outIncs[1] = outIncs[0] * (outExt[1] - outExt[0] + 1);
+  outIncs[2] = outIncs[1] * (outExt[3] - outExt[2] + 1);
+
+  unsigned char* inPtr =
+    static_cast<unsigned char*>(inArray->GetVoidPointer(0));
+  unsigned char* outZPtr =
+    static_cast<unsigned char*>(outArray->GetVoidPointer(0)) +
+    (inExt[0] - outExt[0]) * outIncs[0] +
+    (inExt[2] - outExt[2]) * outIncs[1] +
+    (inExt[4] - outExt[4]) * outIncs[2];
+  for (int k = inExt[4]; k <= inExt[5]; ++k)
+    {
+    unsigned char* outPtr = outZPtr;
+    for (int j = inExt[2]; j <= inExt[3]; ++j)
+      {
+      memcpy(outPtr, inPtr, rowSize);
+      inPtr += rowSize;
+      outPtr += outIncs[1];
+      }
+    outZPtr += outIncs[2];
+    }
+}
+
+//----------------------------------------------------------------------------
+vtkXMLImagePyramidReader::vtkXMLImagePyramidReader()
+{
+  this->FileName = 0;
+  this->ResolutionLevel = 0;
+  this->NumberOfLevels = 0;
+  this->NumberOfChunksRead = 0;
+  this->Summary = 0;
+  this->ChunkReader = vtkXMLImageDataReader::New();
+  this->SetNumberOfInputPorts(0);
+}
+
+//----------------------------------------------------------------------------
+vtkXMLImagePyramidReader::~vtkXMLImagePyramidReader()
+{
+  this->SetFileName(0);
+  if (this->Summary)
+    {
+    this->Summary->UnRegister(this);
+    }
+  this->ChunkReader->Delete();
+}
+
+//----------------------------------------------------------------------------
+void vtkXMLImagePyramidReader::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "FileName: "
+     << (this->FileName ? this->FileName : "(none)") << "\n";
+  os << indent << "ResolutionLevel: " << this->ResolutionLevel << "\n";
+  os << indent << "NumberOfLevels: " << this->NumberOfLevels << "\n";
+  os << indent << "NumberOfChunksRead: " << this->NumberOfChunksRead << "\n";
+}
+
+//----------------------------------------------------------------------------
+int vtkXMLImagePyramidReader::CanReadFile(const char* name)
+{
+  vtkXMLFileReadTester* tester = vtkXMLFileReadTester::New();
+  tester->SetFileName(name);
+  int result = tester->TestReadFile() && tester->GetFileDataType() &&
+    strcmp(tester->GetFileDataType(), "ImagePyramid") == 0;
+  tester->Delete();
+  return result;
+}
+
+//----------------------------------------------------------------------------
+int vtkXMLImagePyramidReader::ReadSummary()
+{
+  if (this->Summary)
+    {
+    this->Summary->UnRegister(this);
+    this->Summary = 0;
+    }
+  this->NumberOfLevels = 0;
+
+  if (!this->FileName)
+    {
+    vtkErrorMacro("A FileName must be specified.");
+    return 0;
+    }
+
+  // The summary is small: parse it again on every update so that a
+  // pyramid being written level by level is seen as it grows.
+  vtkXMLDataParser* parser = vtkXMLDataParser::New();
+  parser->SetFileName(this->FileName);
+  if (!parser->Parse())
+    {
+    vtkErrorMacro("Error parsing pyramid file " << this->FileName);
+    parser->Delete();
+    return 0;
+    }
+  vtkXMLDataElement* root = parser->GetRootElement();
+  vtkXMLDataElement* ePrimary =
+    root ? root->FindNestedElementWithName("ImagePyramid") : 0;
+  if (!ePrimary)
+    {
+    vtkErrorMacro("File " << this->FileName << " is not an image pyramid.");
+    parser->Delete();
+    return 0;
+    }
+  this->Summary = ePrimary;
+  this->Summary->Register(this);
+  parser->Delete();
+
+  for (int i = 0; i < this->Summary->GetNumberOfNestedElements(); ++i)
+    {
+    if (strcmp(this->Summary->GetNestedElement(i)->GetName(), "Level") == 0)
+      {
+      ++this->NumberOfLevels;
+      }
+    }
+  if (this->NumberOfLevels == 0)
+    {
+    vtkErrorMacro("File " << this->FileName << " has no levels.");
+    return 0;
+    }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+vtkXMLDataElement* vtkXMLImagePyramidReader::GetLevelElement(int level)
+{
+  if (!this->Summary)
+    {
+    return 0;
+    }
+  for (int i = 0; i < this->Summary->GetNumberOfNestedElements(); ++i)
+    {
+    vtkXMLDataElement* eLevel = this->Summary->GetNestedElement(i);
+    int index;
+    if (strcmp(eLevel->GetName(), "Level") == 0 &&
+        eLevel->GetScalarAttribute("index", index) && index == level)
+      {
+      return eLevel;
+      }
+    }
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+int vtkXMLImagePyramidReader::GetLevelWholeExtent(int level, int extent[6])
+{
+  vtkXMLDataElement* eLevel = this->GetLevelElement(level);
+  return eLevel && eLevel->GetVectorAttribute("WholeExtent", 6, extent) == 6;
+}
+
+//----------------------------------------------------------------------------
+vtkStdString vtkXMLImagePyramidReader::GetChunkFileName(
+  vtkXMLDataElement* eLevel, int chunk)
+{
+  const char* prefix = eLevel->GetAttribute("ChunkFilePrefix");
+  const char* extension = eLevel->GetAttribute("ChunkFileExtension");
+  if (!prefix || !extension)
+    {
+    return vtkStdString();
+    }
+  vtksys_ios::ostringstream file;
+  file << prefix << chunk << "." << extension;
+
+  // Chunk file names are relative to the summary file.
+  std::string path = vtksys::SystemTools::GetFilenamePath(this->FileName);
+  if (path.empty() || vtksys::SystemTools::FileIsFullPath(prefix))
+    {
+    return file.str();
+    }
+  return path + "/" + file.str();
+}
+
+//----------------------------------------------------------------------------
+int vtkXMLImagePyramidReader::RequestInformation(
+  vtkInformation* vtkNotUsed(request),
+  vtkInformationVector** vtkNotUsed(inputVector),
+  vtkInformationVector* outputVector)
+{
+  if (!this->ReadSummary())
+    {
+    return 0;
+    }
+
+  int level = std::min(this->ResolutionLevel, this->NumberOfLevels - 1);
+  vtkXMLDataElement* eLevel = this->GetLevelElement(level);
+  int wholeExtent[6];
+  double origin[3];
+  double spacing[3];
+  int chunkSize[3];
+  if (!eLevel ||
+      eLevel->GetVectorAttribute("WholeExtent", 6, wholeExtent) != 6 ||
+      eLevel->GetVectorAttribute("Origin", 3, origin) != 3 ||
+      eLevel->GetVectorAttribute("Spacing", 3, spacing) != 3 ||
+      eLevel->GetVectorAttribute("ChunkSize", 3, chunkSize) != 3 ||
+      chunkSize[0] < 1 || chunkSize[1] < 1 || chunkSize[2] < 1)
+    {
+    vtkErrorMacro("Missing or invalid level " << level << " in "
+                  << this->FileName);
+    return 0;
+    }
+
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+  outInfo->Set(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(),
+               wholeExtent, 6);
+  outInfo->Set(vtkDataObject::ORIGIN(), origin, 3);
+  outInfo->Set(vtkDataObject::SPACING(), spacing, 3);
+  outInfo->Set(vtkAlgorithm::CAN_PRODUCE_SUB_EXTENT(), 1);
+
+  // All the chunks of a level have the same arrays: describe them from
+  // the header of the first one.
+  this->ChunkReader->SetFileName(this->GetChunkFileName(eLevel, 0).c_str());
+  this->ChunkReader->UpdateInformation();
+  vtkInformation* chunkInfo = this->ChunkReader->GetOutputInformation(0);
+  if (chunkInfo->Has(vtkDataObject::POINT_DATA_VECTOR()))
+    {
+    outInfo->CopyEntry(chunkInfo, vtkDataObject::POINT_DATA_VECTOR());
+    }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkXMLImagePyramidReader::RequestData(
+  vtkInformation* vtkNotUsed(request),
+  vtkInformationVector** vtkNotUsed(inputVector),
+  vtkInformationVector* outputVector)
+{
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+  vtkImageData* output = vtkImageData::GetData(outInfo);
+
+  int level = std::min(this->ResolutionLevel, this->NumberOfLevels - 1);
+  vtkXMLDataElement* eLevel = this->GetLevelElement(level);
+  if (!eLevel)
+    {
+    vtkErrorMacro("Missing level " << level << " in " << this->FileName);
+    return 0;
+    }
+
+  int outExt[6];
+  outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), outExt);
+  output->Initialize();
+  output->SetExtent(outExt);
+  output->SetOrigin(outInfo->Get(vtkDataObject::ORIGIN()));
+  output->SetSpacing(outInfo->Get(vtkDataObject::SPACING()));
+
+  // The chunks are numbered with x varying fastest.  Find the range of
+  // chunk indices along each axis that overlaps the update extent.
+  int wholeExtent[6];
+  int chunkSize[3];
+  eLevel->GetVectorAttribute("WholeExtent", 6, wholeExtent);
+  eLevel->GetVectorAttribute("ChunkSize", 3, chunkSize);
+  int firstChunk[3];
+  int lastChunk[3];
+  int numChunks[3];
+  for (int axis = 0; axis < 3; ++axis)
+    {
+    int size = wholeExtent[2*axis+1] - wholeExtent[2*axis] + 1;
+    numChunks[axis] = (size + chunkSize[axis] - 1) / chunkSize[axis];
+    firstChunk[axis] = std::max(outExt[2*axis] - wholeExtent[2*axis], 0) /
+      chunkSize[axis];
+    lastChunk[axis] = std::min(outExt[2*axis+1] - wholeExtent[2*axis],
+                               size - 1) / chunkSize[axis];
+    }
+  int numChunksToRead = std::max(lastChunk[0] - firstChunk[0] + 1, 0) *
+    std::max(lastChunk[1] - firstChunk[1] + 1, 0) *
+    std::max(lastChunk[2] - firstChunk[2] + 1, 0);
+
+  // Read the part of each chunk that lies inside the update extent.
+  this->NumberOfChunksRead = 0;
+  for (int ck = firstChunk[2]; ck <= lastChunk[2]; ++ck)
+    {
+    for (int cj = firstChunk[1]; cj <= lastChunk[1]; ++cj)
+      {
+      for (int ci = firstChunk[0]; ci <= lastChunk[0] && !this->AbortExecute;
+           ++ci)
+        {
+        int chunkIndex[3] = { ci, cj, ck };
+        int readExt[6];
+        for (int axis = 0; axis < 3; ++axis)
+          {
+          int chunkStart =
+            wholeExtent[2*axis] + chunkIndex[axis] * chunkSize[axis];
+          readExt[2*axis] = std::max(chunkStart, outExt[2*axis]);
+          readExt[2*axis+1] = std::min(
+            std::min(chunkStart + chunkSize[axis] - 1, wholeExtent[2*axis+1]),
+            outExt[2*axis+1]);
+          }
+        int chunk = (ck * numChunks[1] + cj) * numChunks[0] + ci;
+        if (!this->ReadChunk(eLevel, chunk, readExt, output))
+          {
+          return 0;
+          }
+        this->UpdateProgress(static_cast<double>(this->NumberOfChunksRead) /
+                             numChunksToRead);
+        }
+      }
+    }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkXMLImagePyramidReader::ReadChunk(vtkXMLDataElement* eLevel, int chunk,
+                                        int readExt[6],
+                                        vtkImageData* output)
+{
+  int outExt[6];
+  output->GetExtent(outExt);
+  vtkPointData* outPD = output->GetPointData();
+  vtkIdType numPoints = output->GetNumberOfPoints();
+
+  this->ChunkReader->SetFileName(this->GetChunkFileName(eLevel, chunk).c_str());
+  this->ChunkReader->UpdateInformation();
+  this->ChunkReader->SetUpdateExtent(readExt);
+  this->ChunkReader->Update();
+  vtkImageData* image = this->ChunkReader->GetOutput();
+  int extent[6];
+  image->GetExtent(extent);
+  if (extent[0] != readExt[0] || extent[1] != readExt[1] ||
+      extent[2] != readExt[2] || extent[3] != readExt[3] ||
+      extent[4] != readExt[4] || extent[5] != readExt[5])
+    {
+    vtkErrorMacro("Could not read extent of chunk "
+                  << this->ChunkReader->GetFileName());
+    return 0;
+    }
+
+  vtkPointData* inPD = image->GetPointData();
+  if (this->NumberOfChunksRead == 0)
+    {
+    for (int a = 0; a < inPD->GetNumberOfArrays(); ++a)
+      {
+      vtkDataArray* inArray = inPD->GetArray(a);
+      if (inArray)
+        {
+        vtkDataArray* outArray = inArray->NewInstance();
+        outArray->SetName(inArray->GetName());
+        outArray->SetNumberOfComponents(inArray->GetNumberOfComponents());
+        outArray->SetNumberOfTuples(numPoints);
+        outPD->AddArray(outArray);
+        outArray->Delete();
+        }
+      }
+    if (inPD->GetScalars())
+      {
+      outPD->SetActiveScalars(inPD->GetScalars()->GetName());
+      }
+    }
+  for (int a = 0; a < outPD->GetNumberOfArrays(); ++a)
+    {
+    vtkDataArray* outArray = outPD->GetArray(a);
+    vtkDataArray* inArray = inPD->GetArray(outArray->GetName());
+    if (inArray)
+      {
+      vtkXMLImagePyramidReaderCopyChunk(inArray, readExt, outArray, outExt);
+      }
+    }
+  ++this->NumberOfChunksRead;
+  return 1;
+}
@@ -0,0 +1,114 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkXMLImagePyramidReader.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkXMLImagePyramidReader - Read one level of a VTK XML image pyramid.
+// .SECTION Description
+// vtkXMLImagePyramidReader reads the image pyramids written by
+// vtkXMLImagePyramidWriter.  The output is the image of the level selected
+// with ResolutionLevel, level 0 being the full resolution image.  The
+// reader supports streaming: only the chunk files of the level that
+// overlap the requested update extent are opened, and only the part of
+// each chunk inside the update extent is read from it.  The chunks are
+// found from the extent and chunk size of the level, without listing
+// them.  The standard
+// extension for this reader's file format is "vtip".
+
+// .SECTION See Also
+// vtkXMLImagePyramidWriter vtkXMLImageDataReader
+
+#ifndef __vtkXMLImagePyramidReader_h
+#define __vtkXMLImagePyramidReader_h
+
+#include "vtkIOXMLModule.h" // For export macro
+#include "vtkImageAlgorithm.h"
+#include "vtkStdString.h" // For GetChunkFileName
+
+class vtkImageData;
+class vtkXMLDataElement;
+class vtkXMLImageDataReader;
+
+class VTKIOXML_EXPORT vtkXMLImagePyramidReader : public vtkImageAlgorithm
+{
+public:
+  static vtkXMLImagePyramidReader *New();
+  vtkTypeMacro(vtkXMLImagePyramidReader,vtkImageAlgorithm);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Get/Set the name of the pyramid summary file.
+  vtkSetStringMacro(FileName);
+  vtkGetStringMacro(FileName);
+
+  // Description:
+  // Get/Set the level of the pyramid to read, 0 being the full
+  // resolution.  Levels past the last one read the last level.
+  vtkSetClampMacro(ResolutionLevel, int, 0, VTK_INT_MAX);
+  vtkGetMacro(ResolutionLevel, int);
+
+  // Description:
+  // Get the number of levels in the file.  Valid after
+  // UpdateInformation.
+  vtkGetMacro(NumberOfLevels, int);
+
+  // Description:
+  // Get the whole extent of a level.  Returns 0 if there is no such
+  // level.  Valid after UpdateInformation.
+  int GetLevelWholeExtent(int level, int extent[6]);
+
+  // Description:
+  // Get the number of chunk files read by the last update.
+  vtkGetMacro(NumberOfChunksRead, int);
+
+  // Description:
+  // Test whether the file with the given name can be read by this reader.
+  static int CanReadFile(const char* name);
+
+protected:
+  vtkXMLImagePyramidReader();
+  ~vtkXMLImagePyramidReader();
+
+  virtual int RequestInformation(vtkInformation*,
+                                 vtkInformationVector**,
+                                 vtkInformationVector*);
+  virtual int RequestData(vtkInformation*,
+                          vtkInformationVector**,
+                          vtkInformationVector*);
+
+  // Parse the summary file into Summary.  Returns 0 on error.
+  int ReadSummary();
+
+  // Get the element of the given level, or NULL.
+  vtkXMLDataElement* GetLevelElement(int level);
+
+  // Get the full name of the file of a chunk of a level.
+  vtkStdString GetChunkFileName(vtkXMLDataElement* eLevel, int chunk);
+
+  // Read the part of a chunk of a level inside readExt into output.
+  int ReadChunk(vtkXMLDataElement* eLevel, int chunk, int readExt[6],
+                vtkImageData* output);
+
+  char* FileName;
+  int ResolutionLevel;
+  int NumberOfLevels;
+  int NumberOfChunksRead;
+
+  vtkXMLDataElement* Summary;
+  vtkXMLImageDataReader* ChunkReader;
+
+private:
+  vtkXMLImagePyramidReader(const vtkXMLImagePyramidReader&);  // Not implemented.
+  void operator=(const vtkXMLImagePyramidReader&);  // Not implemented.
+};
+
+#endif
@@ -0,0 +1,541 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkXMLImagePyramidWriter.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkXMLImagePyramidWriter.h"
+
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkErrorCode.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkXMLDataElement.h"
+#include "vtkXMLImageDataWriter.h"
+#include "vtkXMLImagePyramidReader.h"
+
+#include <vtksys/SystemTools.hxx>
+#include <vtksys/ios/sstream>
+
+#include <algorithm>
+#include <math.h>
+
+vtkStandardNewMacro(vtkXMLImagePyramidWriter);
+
+//----------------------------------------------------------------------------
+vtkXMLImagePyramidWriter::vtkXMLImagePyramidWriter()
+{
+  this->ChunkSize[0] = this->ChunkSize[1] = this->ChunkSize[2] = 64;
+  this->NumberOfLevels = 0;
+  this->CurrentChunk = 0;
+  this->NumberOfLevel0Chunks = 0;
+  for (int i = 0; i < 6; ++i)
+    {
+    this->InputWholeExtent[i] = 0;
+    }
+  this->Summary = 0;
+  this->ChunkWriter = vtkXMLImageDataWriter::New();
+}
+
+//----------------------------------------------------------------------------
+vtkXMLImagePyramidWriter::~vtkXMLImagePyramidWriter()
+{
+  if (this->Summary)
+    {
+    this->Summary->Delete();
+    }
+  this->ChunkWriter->Delete();
+}
+
+//----------------------------------------------------------------------------
+void vtkXMLImagePyramidWriter::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "ChunkSize: " << this->ChunkSize[0] << " "
+     << this->ChunkSize[1] << " " << this->ChunkSize[2] << "\n";
+  os << indent << "NumberOfLevels: " << this->NumberOfLevels << "\n";
+}
+
+//----------------------------------------------------------------------------
+const char* vtkXMLImagePyramidWriter::GetDefaultFileExtension()
+{
+  return "vtip";
+}
+
+//----------------------------------------------------------------------------
+const char* vtkXMLImagePyramidWriter::GetDataSetName()
+{
+  return "ImagePyramid";
+}
+
+//----------------------------------------------------------------------------
+int vtkXMLImagePyramidWriter::FillInputPortInformation(
+  int vtkNotUsed(port), vtkInformation* info)
+{
+  info->Set(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkImageData");
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkXMLImagePyramidWriter::GetNumberOfChunks(const int wholeExtent[6])
+{
+  int numChunks = 1;
+  for (int axis = 0; axis < 3; ++axis)
+    {
+    int size = wholeExtent[2*axis+1] - wholeExtent[2*axis] + 1;
+    int chunkSize = this->ChunkSize[axis] > 0 ? this->ChunkSize[axis] : 1;
+    numChunks *= (size + chunkSize - 1) / chunkSize;
+    }
+  return numChunks;
+}
+
+//----------------------------------------------------------------------------
+void vtkXMLImagePyramidWriter::GetChunkExtent(const int wholeExtent[6],
+                                              int chunk, int extent[6])
+{
+  // Chunks are numbered with x varying fastest.
+  for (int axis = 0; axis < 3; ++axis)
+    {
+    int size = wholeExtent[2*axis+1] - wholeExtent[2*axis] + 1;
+    int chunkSize = this->ChunkSize[axis] > 0 ? this->ChunkSize[axis] : 1;
+    int numChunks = (size + chunkSize - 1) / chunkSize;
+    int index = chunk % numChunks;
+    chunk /= numChunks;
+    extent[2*axis] = wholeExtent[2*axis] + index * chunkSize;
+    extent[2*axis+1] = std::min(extent[2*axis] + chunkSize - 1,
+                                wholeExtent[2*axis+1]);
+    }
+}
+
+//----------------------------------------------------------------------------
+int vtkXMLImagePyramidWriter::GetLowerLevel(const int wholeExtent[6],
+                                            int factors[3], int shift[3],
+                                            int lowerExtent[6])
+{
+  // Halve the resolution along the axes that have more than one sample.
+  // The blocks start at multiples of 2, shifted to the first sample.
+  for (int axis = 0; axis < 3; ++axis)
+    {
+    factors[axis] = wholeExtent[2*axis] < wholeExtent[2*axis+1] ? 2 : 1;
+    shift[axis] = wholeExtent[2*axis] -
+      factors[axis] * static_cast<int>(
+        floor(wholeExtent[2*axis] / static_cast<double>(factors[axis])));
+    }
+  if (factors[0] == 1 && factors[1] == 1 && factors[2] == 1)
+    {
+    return 0;
+    }
+
+  // Only the whole blocks are kept.
+  for (int axis = 0; axis < 3; ++axis)
+    {
+    lowerExtent[2*axis] =
+      (wholeExtent[2*axis] - shift[axis]) / factors[axis];
+    lowerExtent[2*axis+1] = static_cast<int>(floor(
+      (wholeExtent[2*axis+1] - shift[axis] - factors[axis] + 1) /
+      static_cast<double>(factors[axis])));
+    }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+vtkStdString vtkXMLImagePyramidWriter::GetChunkFilePrefix(int level)
+{
+  vtksys_ios::ostringstream prefix;
+  prefix << this->FilePrefix << "/" << this->FilePrefix << "_" << level
+         << "_";
+  return prefix.str();
+}
+
+//----------------------------------------------------------------------------
+void vtkXMLImagePyramidWriter::SplitFileName()
+{
+  std::string name = vtksys::SystemTools::GetFilenameName(this->FileName);
+  std::string path = vtksys::SystemTools::GetFilenamePath(this->FileName);
+
+  // Keep the slash in the file path.
+  this->FilePath = path.empty() ? std::string("./") : path + "/";
+  this->FilePrefix =
+    vtksys::SystemTools::GetFilenameWithoutLastExtension(name);
+  if (this->FilePrefix == name)
+    {
+    // Since a subdirectory is used to store the chunks, we need to
+    // change its name if there is no file extension.
+    this->FilePrefix += "_data";
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkXMLImagePyramidWriter::AddLevel(int level, const int wholeExtent[6],
+                                        const double origin[3],
+                                        const double spacing[3])
+{
+  // The chunks are not listed: their extents follow from the whole extent
+  // and the chunk size, and their names from their index.
+  vtkXMLDataElement* eLevel = vtkXMLDataElement::New();
+  eLevel->SetName("Level");
+  eLevel->SetIntAttribute("index", level);
+  eLevel->SetVectorAttribute("WholeExtent", 6, wholeExtent);
+  eLevel->SetVectorAttribute("Origin", 3, origin);
+  eLevel->SetVectorAttribute("Spacing", 3, spacing);
+  int chunkSize[3];
+  for (int axis = 0; axis < 3; ++axis)
+    {
+    chunkSize[axis] = this->ChunkSize[axis] > 0 ? this->ChunkSize[axis] : 1;
+    }
+  eLevel->SetVectorAttribute("ChunkSize", 3, chunkSize);
+  eLevel->SetAttribute("ChunkFilePrefix",
+                       this->GetChunkFilePrefix(level).c_str());
+  eLevel->SetAttribute("ChunkFileExtension",
+                       this->ChunkWriter->GetDefaultFileExtension());
+  this->Summary->AddNestedElement(eLevel);
+  eLevel->Delete();
+}
+
+//----------------------------------------------------------------------------
+void vtkXMLImagePyramidWriter::AddLowerLevels()
+{
+  int wholeExtent[6];
+  double origin[3];
+  double spacing[3];
+  vtkXMLDataElement* eLevel = this->Summary->GetNestedElement(0);
+  eLevel->GetVectorAttribute("WholeExtent", 6, wholeExtent);
+  eLevel->GetVectorAttribute("Origin", 3, origin);
+  eLevel->GetVectorAttribute("Spacing", 3, spacing);
+
+  int factors[3];
+  int shift[3];
+  int lowerExtent[6];
+  for (int level = 1;
+       (this->NumberOfLevels > 0 ? level < this->NumberOfLevels :
+        this->GetNumberOfChunks(wholeExtent) > 1) &&
+       this->GetLowerLevel(wholeExtent, factors, shift, lowerExtent); ++level)
+    {
+    // The averages lie at the centers of the blocks.
+    for (int axis = 0; axis < 3; ++axis)
+      {
+      wholeExtent[2*axis] = lowerExtent[2*axis];
+      wholeExtent[2*axis+1] = lowerExtent[2*axis+1];
+      origin[axis] += (shift[axis] + 0.5 * (factors[axis] - 1)) * spacing[axis];
+      spacing[axis] *= factors[axis];
+      }
+    this->AddLevel(level, wholeExtent, origin, spacing);
+    }
+}
+
+//----------------------------------------------------------------------------
+int vtkXMLImagePyramidWriter::WriteChunk(vtkImageData* image,
+                                         const int extent[6],
+                                         int level, int chunk)
+{
+  vtkImageData* piece = vtkImageData::New();
+  piece->ShallowCopy(image);
+  piece->Crop(extent);
+  piece->GetCellData()->Initialize();
+
+  vtksys_ios::ostringstream fileName;
+  fileName << this->FilePath << this->GetChunkFilePrefix(level) << chunk
+           << "." << this->ChunkWriter->GetDefaultFileExtension();
+
+  vtkXMLImageDataWriter* writer = this->ChunkWriter;
+  writer->SetDebug(this->GetDebug());
+  writer->SetByteOrder(this->GetByteOrder());
+  writer->SetCompressor(this->GetCompressor());
+  writer->SetBlockSize(this->GetBlockSize());
+  writer->SetDataMode(this->GetDataMode());
+  writer->SetEncodeAppendedData(this->GetEncodeAppendedData());
+  writer->SetHeaderType(this->GetHeaderType());
+  writer->SetIdType(this->GetIdType());
+  writer->SetNumberOfCompressionThreads(this->GetNumberOfCompressionThreads());
+  writer->SetInputData(piece);
+  writer->SetFileName(fileName.str().c_str());
+  writer->Write();
+  writer->SetInputData(0);
+  piece->Delete();
+
+  if (writer->GetErrorCode() != vtkErrorCode::NoError)
+    {
+    this->SetErrorCode(writer->GetErrorCode());
+    vtkErrorMacro("Could not write chunk " << writer->GetFileName());
+    return 0;
+    }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+// Set each output sample to the mean of the block of factors samples of
+// the input starting at the output index times factors plus shift.
+template <class T>
+void vtkXMLImagePyramidWriterAverage(const T* in, const int inExt[6],
+                                     T* out, const int outExt[6],
+                                     const int factors[3], const int shift[3],
+                                     int numComps)
+{
+  vtkIdType inIncY = inExt[1] - inExt[0] + 1;
+  vtkIdType inIncZ = inIncY * (inExt[3] - inExt[2] + 1);
+  double norm = 1.0 / (factors[0] * factors[1] * factors[2]);
+  for (int k = outExt[4]; k <= outExt[5]; ++k)
+    {
+    for (int j = outExt[2]; j <= outExt[3]; ++j)
+      {
+      for (int i = outExt[0]; i <= outExt[1]; ++i)
+        {
+        const T* block = in + numComps *
+          ((k * factors[2] + shift[2] - inExt[4]) * inIncZ +
+           (j * factors[1] + shift[1] - inExt[2]) * inIncY +
+           (i * factors[0] + shift[0] - inExt[0]));
+        for (int c = 0; c < numComps; ++c)
+          {
+          double sum = 0.0;
+          for (int z = 0; z < factors[2]; ++z)
+            {
+            for (int y = 0; y < factors[1]; ++y)
+              {
+              const T* row = block + numComps * (z * inIncZ + y * inIncY) + c;
+              for (int x = 0; x < factors[0]; ++x)
+                {
+                sum += static_cast<double>(row[numComps * x]);
+                }
+              }
+            }
+          *out++ = static_cast<T>(sum * norm);
+          }
+        }
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkXMLImagePyramidWriter::Average(vtkImageData* input,
+                                       const int factors[3],
+                                       const int shift[3],
+                                       vtkImageData* output)
+{
+  int inExt[6];
+  input->GetExtent(inExt);
+  int* outExt = output->GetExtent();
+  vtkIdType numTuples = output->GetNumberOfPoints();
+  vtkPointData* inPD = input->GetPointData();
+  vtkPointData* outPD = output->GetPointData();
+  outPD->Initialize();
+  for (int a = 0; a < inPD->GetNumberOfArrays(); ++a)
+    {
+    vtkDataArray* inArray = inPD->GetArray(a);
+    if (!inArray)
+      {
+      continue;
+      }
+    vtkDataArray* outArray = inArray->NewInstance();
+    outArray->SetName(inArray->GetName());
+    outArray->SetNumberOfComponents(inArray->GetNumberOfComponents());
+    outArray->SetNumberOfTuples(numTuples);
+    switch (inArray->GetDataType())
+      {
+      vtkTemplateMacro(
+        vtkXMLImagePyramidWriterAverage(
+          static_cast<VTK_TT*>(inArray->GetVoidPointer(0)), inExt,
+          static_cast<VTK_TT*>(outArray->GetVoidPointer(0)), outExt,
+          factors, shift, inArray->GetNumberOfComponents()));
+      }
+    int attribute = inPD->IsArrayAnAttribute(a);
+    if (attribute >= 0)
+      {
+      outPD->SetAttribute(outArray, attribute);
+      }
+    else
+      {
+      outPD->AddArray(outArray);
+      }
+    outArray->Delete();
+    }
+}
+
+//----------------------------------------------------------------------------
+int vtkXMLImagePyramidWriter::WriteLowerLevels()
+{
+  // Each level averages blocks of 2x2x2 samples of the one above it, read
+  // back from the chunks already written so that only a few chunks are in
+  // memory.
+  vtkXMLImagePyramidReader* reader = vtkXMLImagePyramidReader::New();
+  reader->SetFileName(this->FileName);
+  vtkImageData* image = vtkImageData::New();
+
+  int result = 1;
+  double remainingProgress = 0.125;
+  int numLevels = this->Summary->GetNumberOfNestedElements();
+  for (int level = 1; result && level < numLevels; ++level)
+    {
+    int aboveExtent[6];
+    int wholeExtent[6];
+    int factors[3];
+    int shift[3];
+    this->Summary->GetNestedElement(level - 1)->GetVectorAttribute(
+      "WholeExtent", 6, aboveExtent);
+    this->GetLowerLevel(aboveExtent, factors, shift, wholeExtent);
+    double origin[3];
+    double spacing[3];
+    vtkXMLDataElement* eLevel = this->Summary->GetNestedElement(level);
+    eLevel->GetVectorAttribute("Origin", 3, origin);
+    eLevel->GetVectorAttribute("Spacing", 3, spacing);
+    image->SetOrigin(origin);
+    image->SetSpacing(spacing);
+    reader->SetResolutionLevel(level - 1);
+    reader->UpdateInformation();
+
+    int numChunks = this->GetNumberOfChunks(wholeExtent);
+    for (int chunk = 0; chunk < numChunks && result; ++chunk)
+      {
+      int extent[6];
+      int inExtent[6];
+      this->GetChunkExtent(wholeExtent, chunk, extent);
+      for (int axis = 0; axis < 3; ++axis)
+        {
+        inExtent[2*axis] = extent[2*axis] * factors[axis] + shift[axis];
+        inExtent[2*axis+1] =
+          extent[2*axis+1] * factors[axis] + shift[axis] + factors[axis] - 1;
+        }
+      reader->SetUpdateExtent(inExtent);
+      reader->Update();
+      image->SetExtent(extent);
+      this->Average(reader->GetOutput(), factors, shift, image);
+      result = this->WriteChunk(image, extent, level, chunk);
+      }
+
+    remainingProgress /= 8;
+    this->UpdateProgressDiscrete(1.0 - remainingProgress);
+    }
+
+  image->Delete();
+  reader->Delete();
+  return result;
+}
+
+//----------------------------------------------------------------------------
+int vtkXMLImagePyramidWriter::WriteData()
+{
+  // Write the summary file.
+  this->StartFile();
+  vtkIndent indent = vtkIndent().GetNextIndent();
+  this->Summary->PrintXML(*this->Stream, indent);
+  return this->EndFile();
+}
+
+//----------------------------------------------------------------------------
+int vtkXMLImagePyramidWriter::ProcessRequest(
+  vtkInformation* request,
+  vtkInformationVector** inputVector,
+  vtkInformationVector* outputVector)
+{
+  if(request->Has(vtkStreamingDemandDrivenPipeline::REQUEST_INFORMATION()))
+    {
+    vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+    inInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(),
+                this->InputWholeExtent);
+    this->NumberOfLevel0Chunks =
+      this->GetNumberOfChunks(this->InputWholeExtent);
+    return 1;
+    }
+
+  if(request->Has(vtkStreamingDemandDrivenPipeline::REQUEST_UPDATE_EXTENT()))
+    {
+    // Ask for the full resolution image one chunk at a time.
+    vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+    int extent[6];
+    this->GetChunkExtent(this->InputWholeExtent, this->CurrentChunk, extent);
+    inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), extent, 6);
+    inInfo->Set(vtkStreamingDemandDrivenPipeline::EXACT_EXTENT(), 1);
+    return 1;
+    }
+
+  if(request->Has(vtkDemandDrivenPipeline::REQUEST_DATA()))
+    {
+    vtkImageData* input = vtkImageData::GetData(inputVector[0]);
+    if (this->CurrentChunk == 0)
+      {
+      this->SetErrorCode(vtkErrorCode::NoError);
+      if(!this->FileName)
+        {
+        this->SetErrorCode(vtkErrorCode::NoFileNameError);
+        vtkErrorMacro("The FileName must be set first.");
+        return 0;
+        }
+
+      // We are just starting to write.  Do not call
+      // UpdateProgressDiscrete because we want a 0 progress callback the
+      // first time.
+      this->UpdateProgress(0);
+      float wholeProgressRange[2] = {0,1};
+      this->SetProgressRange(wholeProgressRange, 0, 1);
+
+      // Create the subdirectory for the chunk files.
+      this->SplitFileName();
+      std::string subdir = this->FilePath + this->FilePrefix;
+      if (!vtksys::SystemTools::MakeDirectory(subdir.c_str()))
+        {
+        vtkErrorMacro("Unable to create directory " << subdir);
+        this->SetErrorCode(vtkErrorCode::CannotOpenFileError);
+        return 0;
+        }
+
+      if (this->Summary)
+        {
+        this->Summary->Delete();
+        }
+      this->Summary = vtkXMLDataElement::New();
+      this->Summary->SetName(this->GetDataSetName());
+      this->AddLevel(0, this->InputWholeExtent, input->GetOrigin(),
+                     input->GetSpacing());
+      }
+
+    int extent[6];
+    this->GetChunkExtent(this->InputWholeExtent, this->CurrentChunk, extent);
+    int result = this->WriteChunk(input, extent, 0, this->CurrentChunk);
+    ++this->CurrentChunk;
+    this->UpdateProgressDiscrete(0.875f * this->CurrentChunk /
+                                 this->NumberOfLevel0Chunks);
+
+    if (result && this->CurrentChunk < this->NumberOfLevel0Chunks)
+      {
+      // Tell the pipeline to loop over the chunks.
+      request->Set(vtkStreamingDemandDrivenPipeline::CONTINUE_EXECUTING(), 1);
+      return 1;
+      }
+    request->Remove(vtkStreamingDemandDrivenPipeline::CONTINUE_EXECUTING());
+    this->CurrentChunk = 0;
+
+    // The lower resolutions average every point data array.  The summary
+    // describes all the levels, so it is written only once.
+    int lowerLevels = input->GetPointData()->GetNumberOfArrays() > 0;
+    if (lowerLevels)
+      {
+      this->AddLowerLevels();
+      }
+    result = result && this->Superclass::WriteInternal();
+    if (result && lowerLevels)
+      {
+      result = this->WriteLowerLevels();
+      }
+
+    this->Summary->Delete();
+    this->Summary = 0;
+
+    // We have finished writing.
+    this->UpdateProgressDiscrete(1);
+    return result;
+    }
+
+  return this->Superclass::ProcessRequest(request, inputVector, outputVector);
+}
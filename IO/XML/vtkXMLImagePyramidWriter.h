@@ -0,0 +1,142 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkXMLImagePyramidWriter.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkXMLImagePyramidWriter - Write an image as a chunked multi-resolution pyramid.
+// .SECTION Description
+// vtkXMLImagePyramidWriter writes the point data of an image at several
+// resolutions so that viewers can browse huge volumes without reading
+// them at full resolution.  Level 0 is the input image; each following
+// level halves the resolution along every axis of more than one sample,
+// until a level fits in a single chunk or NumberOfLevels levels are
+// written.  Every level is cut into chunks of at most ChunkSize samples,
+// each written as a VTK XML ImageData file with the data mode and
+// compressor of this writer, in a subdirectory named after the file.  The
+// file itself is a small summary with the standard extension "vtip".  It
+// describes each level by its extent, origin, spacing, chunk size and
+// chunk file name prefix; the extent and file name of each chunk follow
+// from its index.
+//
+// The input is requested one chunk at a time, so the full resolution
+// image never needs to be in memory.  The samples of the lower
+// resolutions are the means of blocks of 2x2x2 samples of each point data
+// array of the level above, computed from the chunks already written, and
+// lie at the centers of these blocks.  Cell data is not written.
+
+// .SECTION See Also
+// vtkXMLImagePyramidReader vtkXMLImageDataWriter
+
+#ifndef __vtkXMLImagePyramidWriter_h
+#define __vtkXMLImagePyramidWriter_h
+
+#include "vtkIOXMLModule.h" // For export macro
+#include "vtkXMLWriter.h"
+#include "vtkStdString.h" // For FilePath and FilePrefix
+
+class vtkImageData;
+class vtkXMLDataElement;
+class vtkXMLImageDataWriter;
+
+class VTKIOXML_EXPORT vtkXMLImagePyramidWriter : public vtkXMLWriter
+{
+public:
+  static vtkXMLImagePyramidWriter* New();
+  vtkTypeMacro(vtkXMLImagePyramidWriter,vtkXMLWriter);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Get/Set the number of samples along each axis of the chunks.  The
+  // default is 64 along every axis.
+  vtkSetVector3Macro(ChunkSize, int);
+  vtkGetVector3Macro(ChunkSize, int);
+
+  // Description:
+  // Get/Set the maximum number of levels to write, including the full
+  // resolution.  The default, 0, writes levels until one fits in a single
+  // chunk.
+  vtkSetClampMacro(NumberOfLevels, int, 0, VTK_INT_MAX);
+  vtkGetMacro(NumberOfLevels, int);
+
+  // Description:
+  // Get the default file extension for files written by this writer.
+  virtual const char* GetDefaultFileExtension();
+
+  // Description:
+  // See the vtkAlgorithm for a desciption of what these do
+  int ProcessRequest(vtkInformation*,
+                     vtkInformationVector**,
+                     vtkInformationVector*);
+
+protected:
+  vtkXMLImagePyramidWriter();
+  ~vtkXMLImagePyramidWriter();
+
+  virtual int FillInputPortInformation(int port, vtkInformation* info);
+
+  virtual const char* GetDataSetName();
+  virtual int WriteData();
+
+  // Get the number of chunks of a level of the given extent, and the
+  // extent of one of them.
+  int GetNumberOfChunks(const int wholeExtent[6]);
+  void GetChunkExtent(const int wholeExtent[6], int chunk, int extent[6]);
+
+  // Get the block sizes and shifts that halve the resolution of a level
+  // of the given whole extent, and the whole extent of the level below.
+  // Returns 0 if the level has a single sample.
+  int GetLowerLevel(const int wholeExtent[6], int factors[3], int shift[3],
+                    int lowerExtent[6]);
+
+  // Get the name of the chunk files of a level without the chunk index
+  // and extension, relative to FilePath.
+  vtkStdString GetChunkFilePrefix(int level);
+
+  // Add a level to the summary.
+  void AddLevel(int level, const int wholeExtent[6],
+                const double origin[3], const double spacing[3]);
+
+  // Add the levels below the full resolution to the summary.
+  void AddLowerLevels();
+
+  // Write the point data of image over extent as a chunk of a level.
+  int WriteChunk(vtkImageData* image, const int extent[6],
+                 int level, int chunk);
+
+  // Set the point data of output, over its extent, to the means of the
+  // blocks of factors samples of the point data of input.
+  void Average(vtkImageData* input, const int factors[3], const int shift[3],
+               vtkImageData* output);
+
+  // Compute and write the levels below the full resolution.
+  int WriteLowerLevels();
+
+  // Split FileName into FilePath and FilePrefix.
+  void SplitFileName();
+
+  int ChunkSize[3];
+  int NumberOfLevels;
+
+  int CurrentChunk;
+  int NumberOfLevel0Chunks;
+  int InputWholeExtent[6];
+  vtkStdString FilePath;
+  vtkStdString FilePrefix;
+  vtkXMLDataElement* Summary;
+  vtkXMLImageDataWriter* ChunkWriter;
+
+private:
+  vtkXMLImagePyramidWriter(const vtkXMLImagePyramidWriter&);  // Not implemented.
+  void operator=(const vtkXMLImagePyramidWriter&);  // Not implemented.
+};
+
+#endif
@@ -25,6 +25,7 @@
 #include "vtkXMLDataParser.h"
 #include "vtkXMLFileReadTester.h"
 #include "vtkZLibDataCompressor.h"
+#include "vtkZstdDataCompressor.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
@@ -123,6 +124,10 @@ vtkXMLReader::vtkXMLReader()
   this->CurrentTimeStep = 0;
   this->TimeStepWasReadOnce = 0;
 
+  this->NumberOfDecompressionThreads = 1;
+  this->UseMemoryMapping = 0;
+  this->ArraySelectionMTime = 0;
+
   this->FileMinorVersion = -1;
   this->FileMajorVersion = -1;
 
@@ -167,6 +172,9 @@ void vtkXMLReader::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "NumberOfTimeSteps:" << this->NumberOfTimeSteps << "\n";
   os << indent << "TimeStepRange:(" << this->TimeStepRange[0] << ","
                                     << this->TimeStepRange[1] << ")\n";
+  os << indent << "NumberOfDecompressionThreads: "
+     << this->NumberOfDecompressionThreads << "\n";
+  os << indent << "UseMemoryMapping: " << this->UseMemoryMapping << "\n";
 }
 
 //----------------------------------------------------------------------------
@@ -382,12 +390,16 @@ void vtkXMLReader::SetupCompressor(const char* type)
   vtkObject* object = vtkInstantiator::CreateInstance(type);
   vtkDataCompressor* compressor = vtkDataCompressor::SafeDownCast(object);
 
-  // In static builds, the vtkZLibDataCompressor may not have been
-  // registered with the vtkInstantiator.  Check for it here.
+  // In static builds, the compressors provided by VTK may not have been
+  // registered with the vtkInstantiator.  Check for them here.
   if(!compressor && (strcmp(type, "vtkZLibDataCompressor") == 0))
     {
     compressor = vtkZLibDataCompressor::New();
     }
+  else if(!compressor && (strcmp(type, "vtkZstdDataCompressor") == 0))
+    {
+    compressor = vtkZstdDataCompressor::New();
+    }
 
   if(!compressor)
     {
@@ -574,6 +586,15 @@ int vtkXMLReader::RequestData(vtkInformation *vtkNotUsed(request),
 
   (*this->Stream).imbue(std::locale::classic());
   this->XMLParser->SetStream(this->Stream);
+  this->XMLParser->SetNumberOfDecompressionThreads(
+    this->NumberOfDecompressionThreads);
+
+  // Map the file only when it was opened by name.  The arrays pointing
+  // into the mapping keep it alive after the parser releases it.
+  if(this->UseMemoryMapping && this->FileStream)
+    {
+    this->XMLParser->MapFile(this->FileName);
+    }
 
   // We are just starting to read.  Do not call UpdateProgressDiscrete
   // because we want a 0 progress callback the first time.
@@ -608,12 +629,14 @@ int vtkXMLReader::RequestData(vtkInformation *vtkNotUsed(request),
   this->UpdateProgressDiscrete(1);
 
   // Close the input stream to prevent resource leaks.
+  this->XMLParser->UnmapFile();
   this->CloseStream();
   if( this->TimeSteps )
     {
     // The SetupOutput should not reallocate this should be done only in a TimeStep case
     this->TimeStepWasReadOnce = 1;
     }
+  this->ArraySelectionMTime = this->vtkObject::GetMTime();
 
   this->CurrentOutput = 0;
   return 1;
@@ -1188,7 +1211,12 @@ int vtkXMLReader::CellDataArrayIsEnabled(vtkXMLDataElement* eCDA)
 void vtkXMLReader::SelectionModifiedCallback(vtkObject*, unsigned long,
                                              void* clientdata, void*)
 {
-  static_cast<vtkXMLReader*>(clientdata)->Modified();
+  vtkXMLReader* self = static_cast<vtkXMLReader*>(clientdata);
+  int onlySelections =
+    (self->ArraySelectionMTime == self->vtkObject::GetMTime());
+  self->Modified();
+  self->ArraySelectionMTime =
+    onlySelections? self->vtkObject::GetMTime() : 0;
 }
 
 //----------------------------------------------------------------------------
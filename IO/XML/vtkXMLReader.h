@@ -105,6 +105,24 @@ public:
   vtkGetVector2Macro(TimeStepRange, int);
   vtkSetVector2Macro(TimeStepRange, int);
 
+  // Description:
+  // Get/Set the vtkXMLDataParser::NumberOfDecompressionThreads used for
+  // compressed binary and appended data.  Serial by default.
+  vtkSetClampMacro(NumberOfDecompressionThreads,int,0,VTK_INT_MAX);
+  vtkGetMacro(NumberOfDecompressionThreads, int);
+
+  // Description:
+  // Get/Set whether raw appended data are memory mapped when reading from
+  // a file.  Arrays stored uncompressed in the byte order of this machine
+  // then point directly into the mapped file instead of being read, and
+  // their pages are only loaded when accessed.  Modifying such an array
+  // does not change the file, but the file must stay unchanged for as
+  // long as such arrays exist, even after the reader is destroyed; see
+  // vtkXMLDataParser::MapFile().  Off by default.
+  vtkSetMacro(UseMemoryMapping, int);
+  vtkGetMacro(UseMemoryMapping, int);
+  vtkBooleanMacro(UseMemoryMapping, int);
+
   // Description:
   // Returns the internal XML parser. This can be used to access
   // the XML DOM after RequestInformation() was called.
@@ -266,6 +284,10 @@ protected:
                                  vtkInformationVector *outputVector);
   vtkTimeStamp ReadMTime;
 
+  // The modified time of the reader when its array selections are the
+  // only changes made since the data were last read, or 0.
+  unsigned long ArraySelectionMTime;
+
   // Whether there was an error reading the XML.
   int ReadError;
 
@@ -285,6 +307,9 @@ protected:
   // Store the range of time steps
   int TimeStepRange[2];
 
+  int NumberOfDecompressionThreads;
+  int UseMemoryMapping;
+
   // Now we need to save what was the last time read for each kind of
   // data to avoid rereading it that is to say we need a var for
   // e.g. PointData/CellData/Points/Cells...
@@ -15,13 +15,68 @@
 #include "vtkXMLStructuredDataReader.h"
 
 #include "vtkArrayIteratorIncludes.h"
+#include "vtkCellData.h"
 #include "vtkDataArray.h"
 #include "vtkDataSet.h"
 #include "vtkInformation.h"
+#include "vtkPointData.h"
+#include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkXMLDataElement.h"
 #include "vtkXMLDataParser.h"
 
+#include <vtksys/SystemTools.hxx>
+
+#include <map>
+#include <set>
+#include <string>
+
+//----------------------------------------------------------------------------
+class vtkXMLStructuredDataReaderArrayCache
+{
+public:
+  struct Entry
+  {
+    vtkSmartPointer<vtkAbstractArray> Array;
+    unsigned long MTime;
+  };
+  typedef std::map<std::string, Entry> ArrayMap;
+
+  vtkXMLStructuredDataReaderArrayCache()
+    {
+    this->Clear();
+    }
+
+  void Clear()
+    {
+    this->Valid = false;
+    this->FileName.clear();
+    this->FileTime = 0;
+    this->FileLength = 0;
+    this->TimeStep = -1;
+    for(int i=0; i < 6; ++i)
+      {
+      this->UpdateExtent[i] = 0;
+      }
+    this->Arrays[0].clear();
+    this->Arrays[1].clear();
+    this->Reused.clear();
+    }
+
+  bool Valid;
+  std::string FileName;
+  long FileTime;
+  unsigned long FileLength;
+  int UpdateExtent[6];
+  int TimeStep;
+
+  // Point data arrays and cell data arrays by name.
+  ArrayMap Arrays[2];
+
+  // The arrays put back in the current output.
+  std::set<vtkAbstractArray*> Reused;
+};
+
 
 //----------------------------------------------------------------------------
 vtkXMLStructuredDataReader::vtkXMLStructuredDataReader()
@@ -32,6 +87,7 @@ vtkXMLStructuredDataReader::vtkXMLStructuredDataReader()
   this->PieceCellDimensions = 0;
   this->PieceCellIncrements = 0;
   this->WholeSlices = 1;
+  this->ArrayCache = new vtkXMLStructuredDataReaderArrayCache;
 
   // Initialize these in case someone calls GetNumberOfPoints or
   // GetNumberOfCells before UpdateInformation is called.
@@ -57,6 +113,7 @@ vtkXMLStructuredDataReader::~vtkXMLStructuredDataReader()
     {
     this->DestroyPieces();
     }
+  delete this->ArrayCache;
 }
 
 //----------------------------------------------------------------------------
@@ -126,6 +183,7 @@ vtkXMLStructuredDataReader::CopyOutputInformation(vtkInformation* outInfo,
 void vtkXMLStructuredDataReader::SetupEmptyOutput()
 {
   this->GetCurrentOutput()->Initialize();
+  this->ArrayCache->Clear();
 }
 
 //----------------------------------------------------------------------------
@@ -265,6 +323,9 @@ void vtkXMLStructuredDataReader::ReadXMLData()
   // Let superclasses read data.  This also allocates output data.
   this->Superclass::ReadXMLData();
 
+  // Put back the arrays read by the previous execution.
+  this->ReuseCachedArrays();
+
   // Split current progress range based on fraction contributed by
   // each piece.
   float progressRange[2] = {0,0};
@@ -334,12 +395,138 @@ void vtkXMLStructuredDataReader::ReadXMLData()
 
   // We filled the exact update extent in the output.
   this->SetOutputExtent(this->UpdateExtent);
+
+  // Remember the arrays for the next execution.
+  this->UpdateArrayCache();
+}
+
+//----------------------------------------------------------------------------
+void vtkXMLStructuredDataReader::ReuseCachedArrays()
+{
+  vtkXMLStructuredDataReaderArrayCache* cache = this->ArrayCache;
+  cache->Reused.clear();
+
+  // The cached arrays are only valid for the same file contents, extent
+  // and time step, and when only the array selections were modified.
+  long fileTime = 0;
+  unsigned long fileLength = 0;
+  bool fromFile = (this->FileName && !this->ReadFromInputString);
+  if(fromFile)
+    {
+    fileTime = vtksys::SystemTools::ModifiedTime(this->FileName);
+    fileLength = vtksys::SystemTools::FileLength(this->FileName);
+    }
+  if(!fromFile || !cache->Valid ||
+     this->ArraySelectionMTime != this->vtkObject::GetMTime() ||
+     cache->FileName != this->FileName ||
+     cache->FileTime != fileTime || cache->FileLength != fileLength ||
+     cache->TimeStep != this->CurrentTimeStep ||
+     memcmp(cache->UpdateExtent, this->UpdateExtent, sizeof(int)*6) != 0)
+    {
+    cache->Clear();
+    if(fromFile)
+      {
+      cache->FileName = this->FileName;
+      cache->FileTime = fileTime;
+      cache->FileLength = fileLength;
+      cache->TimeStep = this->CurrentTimeStep;
+      memcpy(cache->UpdateExtent, this->UpdateExtent, sizeof(int)*6);
+      }
+    return;
+    }
+
+  vtkDataSet* output = vtkDataSet::SafeDownCast(this->GetCurrentOutput());
+  vtkFieldData* fields[2] = { output->GetPointData(), output->GetCellData() };
+  for(int f=0; f < 2; ++f)
+    {
+    for(int i=0; i < fields[f]->GetNumberOfArrays(); ++i)
+      {
+      vtkAbstractArray* array = fields[f]->GetAbstractArray(i);
+      vtkXMLStructuredDataReaderArrayCache::ArrayMap::iterator entry =
+        cache->Arrays[f].find(array->GetName()? array->GetName() : "");
+      if(entry == cache->Arrays[f].end())
+        {
+        continue;
+        }
+      vtkAbstractArray* cached = entry->second.Array;
+
+      // Do not use arrays that were modified since they were read.
+      if(cached->GetMTime() != entry->second.MTime ||
+         cached->GetDataType() != array->GetDataType() ||
+         cached->GetNumberOfComponents() != array->GetNumberOfComponents() ||
+         cached->GetNumberOfTuples() != array->GetNumberOfTuples())
+        {
+        continue;
+        }
+
+      // Replacing an array keeps its index and attribute.
+      if(cached != array)
+        {
+        fields[f]->AddArray(cached);
+        }
+      cache->Reused.insert(cached);
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkXMLStructuredDataReader::UpdateArrayCache()
+{
+  vtkXMLStructuredDataReaderArrayCache* cache = this->ArrayCache;
+  cache->Reused.clear();
+  cache->Arrays[0].clear();
+  cache->Arrays[1].clear();
+  cache->Valid = (!cache->FileName.empty() && !this->DataError &&
+                  !this->AbortExecute);
+  if(!cache->Valid)
+    {
+    return;
+    }
+
+  vtkDataSet* output = vtkDataSet::SafeDownCast(this->GetCurrentOutput());
+  vtkFieldData* fields[2] = { output->GetPointData(), output->GetCellData() };
+  for(int f=0; f < 2; ++f)
+    {
+    for(int i=0; i < fields[f]->GetNumberOfArrays(); ++i)
+      {
+      vtkAbstractArray* array = fields[f]->GetAbstractArray(i);
+      if(array->GetName())
+        {
+        vtkXMLStructuredDataReaderArrayCache::Entry& entry =
+          cache->Arrays[f][array->GetName()];
+        entry.Array = array;
+        entry.MTime = array->GetMTime();
+        }
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+int vtkXMLStructuredDataReader::ArrayIsCached(vtkAbstractArray* array)
+{
+  return this->ArrayCache->Reused.count(array)? 1:0;
+}
+
+//----------------------------------------------------------------------------
+int vtkXMLStructuredDataReader::CanReadRows(vtkXMLDataElement* da,
+                                            vtkAbstractArray* array)
+{
+  // Seeking in raw uncompressed appended data costs nothing, so reading
+  // whole slices would only read more.  Strings are always read from
+  // their start and are better read in few large chunks.
+  return (da->GetAttribute("offset") &&
+          this->XMLParser->GetAppendedDataIsRaw() &&
+          array->GetDataType() != VTK_STRING)? 1:0;
 }
 
 //----------------------------------------------------------------------------
 int vtkXMLStructuredDataReader::ReadArrayForPoints(vtkXMLDataElement* da,
                                                    vtkAbstractArray* outArray)
 {
+  if(this->ArrayIsCached(outArray))
+    {
+    return 1;
+    }
   int* pieceExtent = this->PieceExtents + this->Piece*6;
   int* piecePointDimensions = this->PiecePointDimensions + this->Piece*3;
   vtkIdType* piecePointIncrements = this->PiecePointIncrements + this->Piece*3;
@@ -363,6 +550,10 @@ int vtkXMLStructuredDataReader::ReadArrayForPoints(vtkXMLDataElement* da,
 int vtkXMLStructuredDataReader::ReadArrayForCells(vtkXMLDataElement* da,
                                                   vtkAbstractArray* outArray)
 {
+  if(this->ArrayIsCached(outArray))
+    {
+    return 1;
+    }
   int* pieceExtent = this->PieceExtents + this->Piece*6;
   int* pieceCellDimensions = this->PieceCellDimensions + this->Piece*3;
   vtkIdType* pieceCellIncrements = this->PieceCellIncrements + this->Piece*3;
@@ -479,7 +670,7 @@ vtkXMLStructuredDataReader
     }
   else
     {
-    if(!this->WholeSlices)
+    if(!this->WholeSlices || this->CanReadRows(da, array))
       {
       // Read a row at a time.  Split progress range by row.
       float progressRange[2] = {0,0};
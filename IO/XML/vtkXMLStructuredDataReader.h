@@ -27,6 +27,7 @@
 #include "vtkIOXMLModule.h" // For export macro
 #include "vtkXMLDataReader.h"
 
+class vtkXMLStructuredDataReaderArrayCache;
 
 class VTKIOXML_EXPORT vtkXMLStructuredDataReader : public vtkXMLDataReader
 {
@@ -46,7 +47,8 @@ public:
   // Get/Set whether the reader gets a whole slice from disk when only
   // a rectangle inside it is needed.  This mode reads more data than
   // necessary, but prevents many short reads from interacting poorly
-  // with the compression and encoding schemes.
+  // with the compression and encoding schemes.  Raw uncompressed
+  // appended data are always read row by row.
   vtkSetMacro(WholeSlices, int);
   vtkGetMacro(WholeSlices, int);
   vtkBooleanMacro(WholeSlices, int);
@@ -78,6 +80,19 @@ protected:
   // Whether to read in whole slices mode.
   int WholeSlices;
 
+  // The arrays read by the previous execution.  Those still enabled are
+  // put back in the output instead of being read again when the file,
+  // the update extent and the time step have not changed, so that only
+  // the newly enabled arrays are loaded.
+  vtkXMLStructuredDataReaderArrayCache* ArrayCache;
+  void ReuseCachedArrays();
+  void UpdateArrayCache();
+  int ArrayIsCached(vtkAbstractArray* array);
+
+  // Whether the rows of the given array are read directly instead of
+  // being copied from whole slices.
+  int CanReadRows(vtkXMLDataElement* da, vtkAbstractArray* array);
+
   // The update extent and corresponding increments and dimensions.
   int UpdateExtent[6];
   int PointDimensions[3];
@@ -118,7 +118,7 @@ int vtkXMLStructuredDataWriter::ProcessRequest(
     {
     this->SetErrorCode(vtkErrorCode::NoError);
 
-    if(!this->Stream && !this->FileName)
+    if(!this->Stream && !this->FileName && !this->WriteToOutputString)
       {
       this->SetErrorCode(vtkErrorCode::NoFileNameError);
       vtkErrorMacro("The FileName or Stream must be set first.");
@@ -137,7 +137,8 @@ void vtkXMLStructuredGridReader::SetupOutputData()
     if (a)
       {
       // Allocate the points array.
-      a->SetNumberOfTuples( this->GetNumberOfPoints() );
+      this->AllocateArray(ePoints->GetNestedElement(0), a,
+                          this->GetNumberOfPoints());
       points->SetData(a);
       a->Delete();
       }
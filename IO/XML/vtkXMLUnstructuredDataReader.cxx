@@ -384,7 +384,8 @@ void vtkXMLUnstructuredDataReader::SetupOutputData()
     if (a)
       {
       // Allocate the points array.
-      a->SetNumberOfTuples( this->GetNumberOfPoints() );
+      this->AllocateArray(ePoints->GetNestedElement(0), a,
+                          this->GetNumberOfPoints());
       points->SetData(a);
       a->Delete();
       }
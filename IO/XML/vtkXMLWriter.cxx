@@ -28,10 +28,12 @@
 #include "vtkOutputStream.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
+#include "vtkSMPTools.h"
 #include "vtkStdString.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkZLibDataCompressor.h"
+#include "vtkZstdDataCompressor.h"
 #define vtkXMLOffsetsManager_DoNotInclude
 #include "vtkXMLOffsetsManager.h"
 #undef  vtkXMLOffsetsManager_DoNotInclude
@@ -47,6 +49,7 @@
 
 #include <cassert>
 #include <string>
+#include <vector>
 
 #if !defined(_WIN32) || defined(__CYGWIN__)
 # include <unistd.h> /* unlink */
@@ -86,6 +89,46 @@ public:
    }
 };
 
+//----------------------------------------------------------------------------
+// Number of blocks queued before they are compressed together.  With the
+// default block size of 32KB the queue holds 2MB of data.
+static const size_t vtkXMLWriterBlocksPerBatch = 64;
+
+//----------------------------------------------------------------------------
+// Uncompressed blocks waiting to be compressed, and their compressed form.
+class vtkXMLWriterCompressionQueue
+{
+public:
+  vtkXMLWriterCompressionQueue() : NumberOfBlocks(0) {}
+
+  size_t NumberOfBlocks;
+  std::vector<unsigned char> Blocks;
+  std::vector<size_t> BlockSizes;
+  std::vector<std::vector<unsigned char> > CompressedBlocks;
+  std::vector<size_t> CompressedSizes;
+};
+
+//----------------------------------------------------------------------------
+// Compress a range of the queued blocks.
+class vtkXMLWriterCompressBlocks
+{
+public:
+  vtkDataCompressor* Compressor;
+  vtkXMLWriterCompressionQueue* Queue;
+  size_t BlockSize;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkXMLWriterCompressionQueue* q = this->Queue;
+    for(vtkIdType i=begin; i < end; ++i)
+      {
+      std::vector<unsigned char>& out = q->CompressedBlocks[i];
+      q->CompressedSizes[i] = this->Compressor->Compress(
+        &q->Blocks[i*this->BlockSize], q->BlockSizes[i], &out[0], out.size());
+      }
+  }
+};
+
 //----------------------------------------------------------------------------
 // Specialize for cases where IterType is ValueType* (common case for
 // vtkDataArrayTemplate subclasses). The last arg is to help less-robust
@@ -316,6 +359,8 @@ vtkXMLWriter::vtkXMLWriter()
   this->BlockSize = 32768; //2^15
   this->Compressor = vtkZLibDataCompressor::New();
   this->CompressionHeader = 0;
+  this->NumberOfCompressionThreads = 1;
+  this->CompressionQueue = new vtkXMLWriterCompressionQueue;
   this->Int32IdTypeBuffer = 0;
   this->ByteSwapBuffer = 0;
 
@@ -361,6 +406,7 @@ vtkXMLWriter::~vtkXMLWriter()
 
   delete this->FieldDataOM;
   delete[] this->NumberOfTimeValues;
+  delete this->CompressionQueue;
 }
 
 //----------------------------------------------------------------------------
@@ -379,17 +425,46 @@ void vtkXMLWriter::SetCompressorType(int compressorType)
 
   if (compressorType == ZLIB)
     {
-    if (this->Compressor && !this->Compressor->IsTypeOf("vtkZLibDataCompressor"))
+    if (!this->Compressor ||
+        !this->Compressor->IsA("vtkZLibDataCompressor"))
       {
-      this->Compressor->Delete();
+      vtkDataCompressor* compressor = vtkZLibDataCompressor::New();
+      this->SetCompressor(compressor);
+      compressor->Delete();
       }
+    return;
+    }
 
-    this->Compressor = vtkZLibDataCompressor::New();
-    this->Modified();
+  if (compressorType == ZSTD)
+    {
+    if (!this->Compressor ||
+        !this->Compressor->IsA("vtkZstdDataCompressor"))
+      {
+      vtkDataCompressor* compressor = vtkZstdDataCompressor::New();
+      this->SetCompressor(compressor);
+      compressor->Delete();
+      }
     return;
     }
 }
 
+//----------------------------------------------------------------------------
+void vtkXMLWriter::SetCompressionLevel(int compressionLevel)
+{
+  if (this->Compressor &&
+      this->Compressor->GetCompressionLevel() != compressionLevel)
+    {
+    this->Compressor->SetCompressionLevel(compressionLevel);
+    this->Modified();
+    }
+}
+
+//----------------------------------------------------------------------------
+int vtkXMLWriter::GetCompressionLevel()
+{
+  return this->Compressor? this->Compressor->GetCompressionLevel() : 0;
+}
+
 //----------------------------------------------------------------------------
 void vtkXMLWriter::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -434,6 +509,8 @@ void vtkXMLWriter::PrintSelf(ostream& os, vtkIndent indent)
     }
   os << indent << "EncodeAppendedData: " << this->EncodeAppendedData << "\n";
   os << indent << "BlockSize: " << this->BlockSize << "\n";
+  os << indent << "NumberOfCompressionThreads: "
+     << this->NumberOfCompressionThreads << "\n";
   if(this->Stream)
     {
     os << indent << "Stream: " << this->Stream << "\n";
@@ -1148,6 +1225,12 @@ int vtkXMLWriter::WriteBinaryData(vtkAbstractArray* a)
       result = 0;
       }
 
+    // Compress and write the blocks still queued.
+    if(!this->FlushCompressionBlocks())
+      {
+      result = 0;
+      }
+
     // Finish writing the data.
     if(result && !this->DataStream->EndWriting())
       {
@@ -1477,26 +1560,101 @@ int vtkXMLWriter::CreateCompressionHeader(size_t size)
 //----------------------------------------------------------------------------
 int vtkXMLWriter::WriteCompressionBlock(unsigned char* data, size_t size)
 {
-  // Compress the data.
-  vtkUnsignedCharArray* outputArray = this->Compressor->Compress(data, size);
+  // Queue a copy of the block.  The caller reuses its buffer.
+  vtkXMLWriterCompressionQueue* q = this->CompressionQueue;
+  size_t batchSize = vtkXMLWriterBlocksPerBatch;
+  if(this->NumberOfCompressionThreads == 1)
+    {
+    batchSize = 1;
+    }
+  if(q->Blocks.size() < batchSize*this->BlockSize)
+    {
+    q->Blocks.resize(batchSize*this->BlockSize);
+    q->BlockSizes.resize(batchSize);
+    }
+  memcpy(&q->Blocks[q->NumberOfBlocks*this->BlockSize], data, size);
+  q->BlockSizes[q->NumberOfBlocks++] = size;
+
+  // Compress and write the queue once it is full.
+  if(q->NumberOfBlocks >= batchSize)
+    {
+    return this->FlushCompressionBlocks();
+    }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkXMLWriter::FlushCompressionBlocks()
+{
+  vtkXMLWriterCompressionQueue* q = this->CompressionQueue;
+  size_t numBlocks = q->NumberOfBlocks;
+  if(numBlocks == 0)
+    {
+    return 1;
+    }
+  q->NumberOfBlocks = 0;
 
-  // Find the compressed size.
-  size_t outputSize = outputArray->GetNumberOfTuples();
-  unsigned char* outputPointer = outputArray->GetPointer(0);
+  // Allocate the output buffers before compressing so that the threads
+  // only have to fill them.
+  size_t space = this->Compressor->GetMaximumCompressionSpace(this->BlockSize);
+  if(q->CompressedBlocks.size() < numBlocks)
+    {
+    q->CompressedBlocks.resize(numBlocks);
+    q->CompressedSizes.resize(numBlocks);
+    }
+  for(size_t i=0; i < numBlocks; ++i)
+    {
+    q->CompressedBlocks[i].resize(space);
+    }
 
-  // Write the compressed data.
-  int result = this->DataStream->Write(outputPointer, outputSize);
-  this->Stream->flush();
-  if (this->Stream->fail())
+  // Compress the blocks concurrently.
+  vtkXMLWriterCompressBlocks functor;
+  functor.Compressor = this->Compressor;
+  functor.Queue = q;
+  functor.BlockSize = this->BlockSize;
+  vtkIdType n = static_cast<vtkIdType>(numBlocks);
+  if(this->NumberOfCompressionThreads == 1)
     {
-    this->SetErrorCode(vtkErrorCode::GetLastSystemError());
+    functor(0, n);
+    }
+  else
+    {
+    vtkIdType grain = 1;
+    if(this->NumberOfCompressionThreads > 0)
+      {
+      grain = (n + this->NumberOfCompressionThreads - 1) /
+        this->NumberOfCompressionThreads;
+      }
+    vtkSMPTools::For(0, n, grain, functor);
     }
 
-  // Store the resulting compressed size in the compression header.
-  this->CompressionHeader->Set(3+this->CompressionBlockNumber++, outputSize);
+  // Write the compressed data in order.
+  int result = 1;
+  for(size_t i=0; i < numBlocks; ++i)
+    {
+    size_t outputSize = q->CompressedSizes[i];
+    if(outputSize == 0)
+      {
+      vtkErrorMacro("Error compressing block " << this->CompressionBlockNumber);
+      this->SetErrorCode(vtkErrorCode::UnknownError);
+      return 0;
+      }
+    if(result && !this->DataStream->Write(&q->CompressedBlocks[i][0],
+                                          outputSize))
+      {
+      result = 0;
+      }
 
-  outputArray->Delete();
+    // Store the resulting compressed size in the compression header.
+    this->CompressionHeader->Set(3+this->CompressionBlockNumber++, outputSize);
+    }
 
+  this->Stream->flush();
+  if (this->Stream->fail())
+    {
+    this->SetErrorCode(vtkErrorCode::GetLastSystemError());
+    return 0;
+    }
   return result;
 }
 
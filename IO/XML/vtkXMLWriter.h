@@ -41,6 +41,7 @@ class vtkPointData;
 class vtkPoints;
 class vtkFieldData;
 class vtkXMLDataHeader;
+class vtkXMLWriterCompressionQueue;
 //BTX
 class vtkStdString;
 class OffsetsManager;      // one per piece/per time
@@ -129,7 +130,8 @@ public:
   enum CompressorType
     {
     NONE,
-    ZLIB
+    ZLIB,
+    ZSTD
     };
 //ETX
 
@@ -144,6 +146,17 @@ public:
     {
     this->SetCompressorType(ZLIB);
     }
+  void SetCompressorTypeToZstd()
+    {
+    this->SetCompressorType(ZSTD);
+    }
+
+  // Description:
+  // Get/Set the compression level of the current compressor.  The range
+  // depends on the compressor: 0 to 9 for zlib, negative levels (fastest)
+  // to 22 for zstd.  Set the compressor before its level.
+  void SetCompressionLevel(int compressionLevel);
+  int GetCompressionLevel();
 
   // Description:
   // Get/Set the block size used in compression.  When reading, this
@@ -153,6 +166,20 @@ public:
   virtual void SetBlockSize(size_t blockSize);
   vtkGetMacro(BlockSize, size_t);
 
+  // Description:
+  // Get/Set how many batches the blocks of binary and appended data are
+  // split into to be compressed concurrently with vtkSMPTools.  Despite
+  // its name, this is not a number of threads: it only sets the grain of
+  // vtkSMPTools::For, whose backend decides how many threads run the
+  // batches (the Sequential backend runs them serially).  0 lets
+  // vtkSMPTools choose the grain.  With a value other than 1, the
+  // compressor is called from several threads at once and must support
+  // it, as vtkZLibDataCompressor and vtkZstdDataCompressor do.  The blocks
+  // are written in order, so the file does not depend on this setting.
+  // The default, 1, compresses the blocks serially.
+  vtkSetClampMacro(NumberOfCompressionThreads,int,0,VTK_INT_MAX);
+  vtkGetMacro(NumberOfCompressionThreads, int);
+
   // Description:
   // Get/Set the data mode used for the file's data.  The options are
   // vtkXMLWriter::Ascii, vtkXMLWriter::Binary, and
@@ -290,6 +317,10 @@ protected:
   size_t CompressionBlockNumber;
   vtkXMLDataHeader* CompressionHeader;
   vtkTypeInt64 CompressionHeaderPosition;
+  int NumberOfCompressionThreads;
+
+  // Blocks waiting to be compressed and written.
+  vtkXMLWriterCompressionQueue* CompressionQueue;
 
   // The output stream used to write binary and appended data.  May
   // transparently encode the data.
@@ -422,6 +453,7 @@ protected:
   void PerformByteSwap(void* data, size_t numWords, size_t wordSize);
   int CreateCompressionHeader(size_t size);
   int WriteCompressionBlock(unsigned char* data, size_t size);
+  int FlushCompressionBlocks();
   int WriteCompressionHeader();
   size_t GetWordTypeSize(int dataType);
   const char* GetWordTypeName(int dataType);
@@ -17,9 +17,11 @@
 #include "vtkBase64InputStream.h"
 #include "vtkByteSwap.h"
 #include "vtkCommand.h"
+#include "vtkCriticalSection.h"
 #include "vtkDataCompressor.h"
 #include "vtkInputStream.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkXMLDataElement.h"
 #define vtkXMLDataHeaderPrivate_DoNotInclude
 #include "vtkXMLDataHeaderPrivate.h"
@@ -28,12 +30,144 @@
 #include <vtksys/auto_ptr.hxx>
 #include <vtksys/ios/sstream>
 
+#include <map>
+#include <vector>
+
 #include "vtkXMLUtilities.h"
 
+#if defined(_WIN32) && !defined(__CYGWIN__)
+# include <windows.h>
+#else
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif
+
 
 vtkStandardNewMacro(vtkXMLDataParser);
 vtkCxxSetObjectMacro(vtkXMLDataParser, Compressor, vtkDataCompressor);
 
+// Number of complete compressed blocks read and decompressed together.
+// With the default block size of 32KB a batch holds 2MB of data.
+static const size_t vtkXMLDataParserBlocksPerBatch = 64;
+
+//----------------------------------------------------------------------------
+// A memory mapped file.  Mappings are reference counted in a global
+// registry indexed by their address so that the data arrays pointing into
+// them can release them without knowing the parser or the mapping size.
+class vtkXMLDataParserMappedFile
+{
+public:
+  const char* Data;
+  vtkTypeUInt64 Length;
+};
+
+namespace
+{
+struct vtkXMLDataParserMapping
+{
+  vtkTypeUInt64 Length;
+  int References;
+};
+
+typedef std::map<const char*, vtkXMLDataParserMapping>
+  vtkXMLDataParserMappingRegistry;
+
+vtkSimpleCriticalSection vtkXMLDataParserMappingLock;
+
+vtkXMLDataParserMappingRegistry& vtkXMLDataParserGetMappings()
+{
+  static vtkXMLDataParserMappingRegistry mappings;
+  return mappings;
+}
+
+// Map a whole file copy-on-write so that arrays pointing into it may be
+// modified without changing the file.
+const char* vtkXMLDataParserMapFile(const char* fileName,
+                                    vtkTypeUInt64& length)
+{
+  void* data = 0;
+#if defined(_WIN32) && !defined(__CYGWIN__)
+  HANDLE file = CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ, NULL,
+                            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+  if(file == INVALID_HANDLE_VALUE)
+    {
+    return 0;
+    }
+  LARGE_INTEGER size;
+  if(GetFileSizeEx(file, &size) && size.QuadPart > 0)
+    {
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_WRITECOPY, 0, 0,
+                                        NULL);
+    if(mapping)
+      {
+      data = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+      CloseHandle(mapping);
+      }
+    length = static_cast<vtkTypeUInt64>(size.QuadPart);
+    }
+  CloseHandle(file);
+#else
+  int fd = open(fileName, O_RDONLY);
+  if(fd < 0)
+    {
+    return 0;
+    }
+  struct stat st;
+  if(fstat(fd, &st) == 0 && st.st_size > 0)
+    {
+    data = mmap(0, static_cast<size_t>(st.st_size), PROT_READ|PROT_WRITE,
+                MAP_PRIVATE, fd, 0);
+    if(data == MAP_FAILED)
+      {
+      data = 0;
+      }
+    length = static_cast<vtkTypeUInt64>(st.st_size);
+    }
+  close(fd);
+#endif
+  return static_cast<const char*>(data);
+}
+
+void vtkXMLDataParserUnmapFile(const char* data, vtkTypeUInt64 length)
+{
+#if defined(_WIN32) && !defined(__CYGWIN__)
+  (void)length;
+  UnmapViewOfFile(data);
+#else
+  munmap(const_cast<char*>(data), static_cast<size_t>(length));
+#endif
+}
+
+// Drop one reference to the mapping containing the given address.
+void vtkXMLDataParserReleaseMapping(const char* address)
+{
+  const char* data = 0;
+  vtkTypeUInt64 length = 0;
+  vtkXMLDataParserMappingLock.Lock();
+  vtkXMLDataParserMappingRegistry& mappings = vtkXMLDataParserGetMappings();
+  vtkXMLDataParserMappingRegistry::iterator i =
+    mappings.upper_bound(address);
+  if(i != mappings.begin())
+    {
+    --i;
+    if(address < i->first + i->second.Length &&
+       --i->second.References == 0)
+      {
+      data = i->first;
+      length = i->second.Length;
+      mappings.erase(i);
+      }
+    }
+  vtkXMLDataParserMappingLock.Unlock();
+  if(data)
+    {
+    vtkXMLDataParserUnmapFile(data, length);
+    }
+}
+}
+
 //----------------------------------------------------------------------------
 vtkXMLDataParser::vtkXMLDataParser()
 {
@@ -50,6 +184,8 @@ vtkXMLDataParser::vtkXMLDataParser()
   this->BlockCompressedSizes = 0;
   this->BlockStartOffsets = 0;
   this->Compressor = 0;
+  this->NumberOfDecompressionThreads = 1;
+  this->MappedFile = 0;
 
   this->AsciiDataBuffer = 0;
   this->AsciiDataBufferLength = 0;
@@ -84,6 +220,7 @@ vtkXMLDataParser::~vtkXMLDataParser()
   delete [] this->BlockCompressedSizes;
   delete [] this->BlockStartOffsets;
   this->SetCompressor(0);
+  this->UnmapFile();
   if(this->AsciiDataBuffer) { this->FreeAsciiBuffer(); }
 }
 
@@ -105,6 +242,8 @@ void vtkXMLDataParser::PrintSelf(ostream& os, vtkIndent indent)
     {
     os << indent << "Compressor: (none)\n";
     }
+  os << indent << "NumberOfDecompressionThreads: "
+     << this->NumberOfDecompressionThreads << "\n";
   os << indent << "Progress: " << this->Progress << "\n";
   os << indent << "Abort: " << this->Abort << "\n";
   os << indent << "AttributesEncoding: " << this->AttributesEncoding << "\n";
@@ -574,6 +713,91 @@ int vtkXMLDataParser::ReadBlock(vtkTypeUInt64 block, unsigned char* buffer)
   return result > 0;
 }
 
+//----------------------------------------------------------------------------
+// Decompress a range of full blocks that were read contiguously.
+class vtkXMLDataParserUncompressBlocks
+{
+public:
+  vtkDataCompressor* Compressor;
+  const unsigned char* Input;
+  const size_t* CompressedSizes;
+  const vtkTypeInt64* StartOffsets;
+  unsigned char* Output;
+  size_t BlockSize;
+  unsigned char* Success;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for(vtkIdType i=begin; i < end; ++i)
+      {
+      this->Success[i] = this->Compressor->Uncompress(
+        this->Input + (this->StartOffsets[i] - this->StartOffsets[0]),
+        this->CompressedSizes[i], this->Output + i*this->BlockSize,
+        this->BlockSize) > 0;
+      }
+  }
+};
+
+//----------------------------------------------------------------------------
+int vtkXMLDataParser::ReadBlocks(vtkTypeUInt64 firstBlock, size_t numBlocks,
+                                 unsigned char* buffer)
+{
+  // The compressed blocks are stored one after the other.  Read them
+  // all at once; the stream cannot be shared between threads.
+  vtkTypeUInt64 lastBlock = firstBlock+numBlocks-1;
+  size_t compressedSize = static_cast<size_t>(
+    this->BlockStartOffsets[lastBlock] - this->BlockStartOffsets[firstBlock])
+    + this->BlockCompressedSizes[lastBlock];
+
+  if(!this->DataStream->Seek(this->BlockStartOffsets[firstBlock]))
+    {
+    return 0;
+    }
+
+  std::vector<unsigned char> readBuffer(compressedSize);
+  if(compressedSize > 0 &&
+     this->DataStream->Read(&readBuffer[0], compressedSize) < compressedSize)
+    {
+    return 0;
+    }
+
+  // Decompress the blocks concurrently, each one into its final place.
+  std::vector<unsigned char> success(numBlocks, 0);
+  vtkXMLDataParserUncompressBlocks functor;
+  functor.Compressor = this->Compressor;
+  functor.Input = compressedSize > 0? &readBuffer[0] : 0;
+  functor.CompressedSizes = this->BlockCompressedSizes + firstBlock;
+  functor.StartOffsets = this->BlockStartOffsets + firstBlock;
+  functor.Output = buffer;
+  functor.BlockSize = this->BlockUncompressedSize;
+  functor.Success = &success[0];
+
+  vtkIdType n = static_cast<vtkIdType>(numBlocks);
+  vtkIdType grain = 1;
+  if(this->NumberOfDecompressionThreads > 0)
+    {
+    grain = (n + this->NumberOfDecompressionThreads - 1) /
+      this->NumberOfDecompressionThreads;
+    }
+  if(this->NumberOfDecompressionThreads == 1)
+    {
+    functor(0, n);
+    }
+  else
+    {
+    vtkSMPTools::For(0, n, grain, functor);
+    }
+
+  for(size_t i=0; i < numBlocks; ++i)
+    {
+    if(!success[i])
+      {
+      return 0;
+      }
+    }
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 unsigned char* vtkXMLDataParser::ReadBlock(vtkTypeUInt64 block)
 {
@@ -755,18 +979,29 @@ size_t vtkXMLDataParser::ReadCompressedData(unsigned char* data,
     // Report progress.
     this->UpdateProgress(float(outputPointer-data)/length);
 
-    unsigned int currentBlock = firstBlock+1;
-    for(;currentBlock != lastBlock && !this->Abort; ++currentBlock)
+    // Read the complete blocks in batches.  Each batch is read from the
+    // stream at once and its blocks are decompressed concurrently.
+    vtkTypeUInt64 currentBlock = firstBlock+1;
+    while(currentBlock != lastBlock && !this->Abort)
       {
-      // Read this block.
-      if(!this->ReadBlock(currentBlock, outputPointer)) { return 0; }
+      size_t numBlocks = vtkXMLDataParserBlocksPerBatch;
+      if(lastBlock-currentBlock < numBlocks)
+        {
+        numBlocks = static_cast<size_t>(lastBlock-currentBlock);
+        }
+      if(!this->ReadBlocks(currentBlock, numBlocks, outputPointer))
+        {
+        return 0;
+        }
 
-      // Byte swap this block.  Note that blockSize will always be an
+      // Byte swap these blocks.  Note that blockSize will always be an
       // integer multiple of the word size.
-      this->PerformByteSwap(outputPointer, blockSize / wordSize, wordSize);
+      this->PerformByteSwap(outputPointer, numBlocks*blockSize / wordSize,
+                            wordSize);
 
       // Advance the pointer to the beginning of the next block.
-      outputPointer += this->FindBlockSize(currentBlock);
+      outputPointer += numBlocks*blockSize;
+      currentBlock += numBlocks;
 
       // Report progress.
       this->UpdateProgress(float(outputPointer-data)/length);
@@ -912,6 +1147,109 @@ size_t vtkXMLDataParser::ReadAppendedData(vtkTypeInt64 offset,
 }
 
 //----------------------------------------------------------------------------
+int vtkXMLDataParser::MapFile(const char* fileName)
+{
+  this->UnmapFile();
+  if(!fileName)
+    {
+    return 0;
+    }
+  vtkTypeUInt64 length = 0;
+  const char* data = vtkXMLDataParserMapFile(fileName, length);
+  if(!data)
+    {
+    return 0;
+    }
+
+  vtkXMLDataParserMappingLock.Lock();
+  vtkXMLDataParserMapping& mapping = vtkXMLDataParserGetMappings()[data];
+  mapping.Length = length;
+  mapping.References = 1;
+  vtkXMLDataParserMappingLock.Unlock();
+
+  this->MappedFile = new vtkXMLDataParserMappedFile;
+  this->MappedFile->Data = data;
+  this->MappedFile->Length = length;
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkXMLDataParser::UnmapFile()
+{
+  if(this->MappedFile)
+    {
+    vtkXMLDataParserReleaseMapping(this->MappedFile->Data);
+    delete this->MappedFile;
+    this->MappedFile = 0;
+    }
+}
+
+//----------------------------------------------------------------------------
+int vtkXMLDataParser::GetAppendedDataIsRaw()
+{
+  return (!this->Compressor &&
+          !this->AppendedDataStream->IsA("vtkBase64InputStream"))? 1:0;
+}
+
+//----------------------------------------------------------------------------
+void* vtkXMLDataParser::MapAppendedData(vtkTypeInt64 offset,
+                                        vtkTypeUInt64 startWord,
+                                        size_t numWords, int wordType)
+{
+  // Only raw uncompressed data in our byte order can be used in place.
+  if(!this->MappedFile || this->Abort || !this->GetAppendedDataIsRaw())
+    {
+    return 0;
+    }
+#ifdef VTK_WORDS_BIGENDIAN
+  if(this->ByteOrder != vtkXMLDataParser::BigEndian)
+#else
+  if(this->ByteOrder != vtkXMLDataParser::LittleEndian)
+#endif
+    {
+    return 0;
+    }
+
+  // Read the length of the data from its header.
+  vtksys::auto_ptr<vtkXMLDataHeader>
+    uh(vtkXMLDataHeader::New(this->HeaderType, 1));
+  size_t const headerSize = uh->DataSize();
+  size_t const wordSize = this->GetWordTypeSize(wordType);
+  vtkTypeUInt64 position =
+    static_cast<vtkTypeUInt64>(this->AppendedDataPosition + offset);
+  if(offset < 0 || position + headerSize > this->MappedFile->Length)
+    {
+    return 0;
+    }
+  memcpy(uh->Data(), this->MappedFile->Data + position, headerSize);
+
+  // The requested words must all be present and aligned for direct use.
+  vtkTypeUInt64 begin = startWord*wordSize;
+  vtkTypeUInt64 end = begin + numWords*wordSize;
+  position += headerSize + begin;
+  if(numWords == 0 || end > uh->Get(0) ||
+     position + numWords*wordSize > this->MappedFile->Length)
+    {
+    return 0;
+    }
+  const char* data = this->MappedFile->Data + position;
+  if(reinterpret_cast<size_t>(data) % wordSize != 0)
+    {
+    return 0;
+    }
+
+  vtkXMLDataParserMappingLock.Lock();
+  ++vtkXMLDataParserGetMappings()[this->MappedFile->Data].References;
+  vtkXMLDataParserMappingLock.Unlock();
+  return const_cast<char*>(data);
+}
+
+//----------------------------------------------------------------------------
+void vtkXMLDataParser::ReleaseMappedData(void* data)
+{
+  vtkXMLDataParserReleaseMapping(static_cast<const char*>(data));
+}
+
 //----------------------------------------------------------------------------
 // Define a parsing function template.  The extra "long" argument is used
 // to help broken compilers select the non-templates below for char and
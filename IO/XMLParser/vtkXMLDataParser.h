@@ -32,6 +32,7 @@
 
 class vtkInputStream;
 class vtkDataCompressor;
+class vtkXMLDataParserMappedFile;
 
 class VTKIOXMLPARSER_EXPORT vtkXMLDataParser : public vtkXMLParser
 {
@@ -73,6 +74,20 @@ public:
   { return this->ReadAppendedData(offset, buffer, startWord, numWords,
                                     VTK_CHAR); }
 
+  // Description:
+  // Return a pointer to numWords words of the appended data array at the
+  // given offset, starting at startWord, inside the file mapped by
+  // MapFile().  This is only possible for raw, uncompressed data in the
+  // byte order of this machine that is aligned on its word size;
+  // otherwise NULL is returned and the data must be read with
+  // ReadAppendedData().  The memory is copy-on-write and the file stays
+  // mapped until ReleaseMappedData() is called with the returned pointer,
+  // which makes ReleaseMappedData() suitable as the free function of a
+  // data array holding it.  Pages are read from the file when accessed.
+  void* MapAppendedData(vtkTypeInt64 offset, vtkTypeUInt64 startWord,
+                        size_t numWords, int wordType);
+  static void ReleaseMappedData(void* data);
+
   // Description:
   // Read from an ascii data section starting at the current position in
   // the stream.  Returns the number of words read.
@@ -86,12 +101,29 @@ public:
                         size_t maxWords, int wordType);
   //ETX
 
+  // Description:
+  // Memory map the file being parsed for use by MapAppendedData().
+  // Returns 1 on success.  The parser releases its mapping when
+  // UnmapFile() is called, when another file is mapped, or when it is
+  // destroyed; arrays still using the data keep the file mapped.  The
+  // mapping is private, but pages not yet accessed are still read from
+  // the file, so the file must not be truncated or rewritten while it is
+  // mapped: on POSIX systems, accessing such a page afterwards raises
+  // SIGBUS instead of reporting an error.
+  int MapFile(const char* fileName);
+  void UnmapFile();
+
   // Description:
   // Get/Set the compressor used to decompress binary and appended data
   // after reading from the file.
   virtual void SetCompressor(vtkDataCompressor*);
   vtkGetObjectMacro(Compressor, vtkDataCompressor);
 
+  // Description:
+  // Return 1 if the appended data are stored raw and uncompressed, in
+  // which case any range of words can be read directly from the file.
+  int GetAppendedDataIsRaw();
+
   // Description:
   // Get the size of a word of the given type.
   size_t GetWordTypeSize(int wordType);
@@ -123,6 +155,15 @@ public:
   vtkSetClampMacro(AttributesEncoding,int,VTK_ENCODING_NONE,VTK_ENCODING_UNKNOWN);
   vtkGetMacro(AttributesEncoding, int);
 
+  // Description:
+  // Get/Set how many batches the blocks of compressed binary data are
+  // split into to be decompressed concurrently with vtkSMPTools.  Like
+  // vtkXMLWriter::SetNumberOfCompressionThreads, this is a vtkSMPTools
+  // grain, not a number of threads.  The default, 1, decompresses the
+  // blocks serially.
+  vtkSetClampMacro(NumberOfDecompressionThreads,int,0,VTK_INT_MAX);
+  vtkGetMacro(NumberOfDecompressionThreads, int);
+
   // Description:
   // If you need the text inside XMLElements, turn IgnoreCharacterData off.
   // This method will then be called when the file is parsed, and the text
@@ -166,6 +207,8 @@ protected:
   size_t FindBlockSize(vtkTypeUInt64 block);
   int ReadBlock(vtkTypeUInt64 block, unsigned char* buffer);
   unsigned char* ReadBlock(vtkTypeUInt64 block);
+  int ReadBlocks(vtkTypeUInt64 firstBlock, size_t numBlocks,
+                 unsigned char* buffer);
   size_t ReadUncompressedData(unsigned char* data,
                               vtkTypeUInt64 startWord,
                               size_t numWords,
@@ -223,6 +266,10 @@ protected:
   size_t PartialLastBlockUncompressedSize;
   size_t* BlockCompressedSizes;
   vtkTypeInt64* BlockStartOffsets;
+  int NumberOfDecompressionThreads;
+
+  // The memory mapped file, if any.
+  vtkXMLDataParserMappedFile* MappedFile;
 
   // Ascii data parsing.
   unsigned char* AsciiDataBuffer;
@@ -0,0 +1,574 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestXdmf3PartialRead.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Writes structured and unstructured grids with their heavy data in HDF5,
+// and checks that sub-extents of the structured grids and pieces of the
+// unstructured grids are read the same as the corresponding part of the
+// whole grid, that the geometry shared by two time steps is read once and
+// that attributes shorter than their grid are skipped.
+
+#include <vtkCellArray.h>
+#include <vtkCellData.h>
+#include <vtkDataArray.h>
+#include <vtkDoubleArray.h>
+#include <vtkFloatArray.h>
+#include <vtkIdList.h>
+#include <vtkImageData.h>
+#include <vtkInformation.h>
+#include <vtkIntArray.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkPoints.h>
+#include <vtkRectilinearGrid.h>
+#include <vtkSmartPointer.h>
+#include <vtkStreamingDemandDrivenPipeline.h>
+#include <vtkStructuredData.h>
+#include <vtkStructuredGrid.h>
+#include <vtkTestUtilities.h>
+#include <vtkUnstructuredGrid.h>
+#include <vtkXdmf3Reader.h>
+#include <vtkXdmf3Writer.h>
+
+#include <fstream>
+#include <string>
+
+namespace
+{
+const int WholeExtent[6] = { 0, 6, 0, 5, 0, 4 };
+
+// Add a 3 component point array and a cell array that differ everywhere.
+void AddArrays(vtkDataSet* dataSet)
+{
+  vtkNew<vtkFloatArray> pointArray;
+  pointArray->SetName("PointVectors");
+  pointArray->SetNumberOfComponents(3);
+  pointArray->SetNumberOfTuples(dataSet->GetNumberOfPoints());
+  for (vtkIdType i = 0; i < dataSet->GetNumberOfPoints(); ++i)
+    {
+    pointArray->SetTuple3(i, i, 0.5 * i, -2.0 * i);
+    }
+  dataSet->GetPointData()->AddArray(pointArray.GetPointer());
+  vtkNew<vtkDoubleArray> cellArray;
+  cellArray->SetName("CellScalars");
+  cellArray->SetNumberOfTuples(dataSet->GetNumberOfCells());
+  for (vtkIdType i = 0; i < dataSet->GetNumberOfCells(); ++i)
+    {
+    cellArray->SetValue(i, 3.0 * i + 1.0);
+    }
+  dataSet->GetCellData()->AddArray(cellArray.GetPointer());
+}
+
+vtkSmartPointer<vtkDataSet> MakeStructured(int type)
+{
+  int dims[3] = { WholeExtent[1] + 1, WholeExtent[3] + 1, WholeExtent[5] + 1 };
+  vtkSmartPointer<vtkDataSet> result;
+  if (type == VTK_IMAGE_DATA)
+    {
+    vtkSmartPointer<vtkImageData> image = vtkSmartPointer<vtkImageData>::New();
+    image->SetExtent(const_cast<int*>(WholeExtent));
+    image->SetOrigin(1.0, 2.0, 3.0);
+    image->SetSpacing(0.5, 0.25, 2.0);
+    result = image;
+    }
+  else if (type == VTK_RECTILINEAR_GRID)
+    {
+    vtkSmartPointer<vtkRectilinearGrid> grid =
+      vtkSmartPointer<vtkRectilinearGrid>::New();
+    grid->SetExtent(const_cast<int*>(WholeExtent));
+    vtkNew<vtkDoubleArray> coordinates[3];
+    for (int axis = 0; axis < 3; ++axis)
+      {
+      for (int i = 0; i < dims[axis]; ++i)
+        {
+        coordinates[axis]->InsertNextValue(i * i + axis);
+        }
+      }
+    grid->SetXCoordinates(coordinates[0].GetPointer());
+    grid->SetYCoordinates(coordinates[1].GetPointer());
+    grid->SetZCoordinates(coordinates[2].GetPointer());
+    result = grid;
+    }
+  else
+    {
+    vtkSmartPointer<vtkStructuredGrid> grid =
+      vtkSmartPointer<vtkStructuredGrid>::New();
+    grid->SetExtent(const_cast<int*>(WholeExtent));
+    vtkNew<vtkPoints> points;
+    for (int k = 0; k < dims[2]; ++k)
+      {
+      for (int j = 0; j < dims[1]; ++j)
+        {
+        for (int i = 0; i < dims[0]; ++i)
+          {
+          points->InsertNextPoint(i + 0.1 * j, j * j, k - 0.2 * i);
+          }
+        }
+      }
+    grid->SetPoints(points.GetPointer());
+    result = grid;
+    }
+  AddArrays(result);
+  return result;
+}
+
+vtkSmartPointer<vtkUnstructuredGrid> MakeHexahedra()
+{
+  vtkSmartPointer<vtkUnstructuredGrid> grid =
+    vtkSmartPointer<vtkUnstructuredGrid>::New();
+  vtkNew<vtkPoints> points;
+  for (int k = 0; k < 3; ++k)
+    {
+    for (int j = 0; j < 4; ++j)
+      {
+      for (int i = 0; i < 5; ++i)
+        {
+        points->InsertNextPoint(i, j + 0.1 * i, k * k);
+        }
+      }
+    }
+  grid->SetPoints(points.GetPointer());
+  grid->Allocate(24);
+  for (int k = 0; k < 2; ++k)
+    {
+    for (int j = 0; j < 3; ++j)
+      {
+      for (int i = 0; i < 4; ++i)
+        {
+        vtkIdType p = i + 5 * (j + 4 * k);
+        vtkIdType ids[8] = { p, p + 1, p + 6, p + 5,
+                             p + 20, p + 21, p + 26, p + 25 };
+        grid->InsertNextCell(VTK_HEXAHEDRON, 8, ids);
+        }
+      }
+    }
+  AddArrays(grid);
+  return grid;
+}
+
+void Write(vtkDataObject* data, const std::string& fileName)
+{
+  vtkNew<vtkXdmf3Writer> writer;
+  writer->SetInputData(data);
+  // Put all the arrays in HDF5 so that they can be read in part.
+  writer->SetLightDataLimit(0);
+  writer->SetFileName(fileName.c_str());
+  writer->Write();
+}
+
+// Read the whole file, a sub-extent of it when extent is given, or a piece
+// of it when numPieces is more than 1, at the first time step.
+vtkSmartPointer<vtkDataSet> Read(vtkXdmf3Reader* reader, const int* extent,
+                                 int piece, int numPieces)
+{
+  reader->UpdateInformation();
+  vtkInformation* outInfo = reader->GetOutputInformation(0);
+  if (outInfo->Has(vtkStreamingDemandDrivenPipeline::TIME_STEPS()))
+    {
+    vtkStreamingDemandDrivenPipeline::SetUpdateTimeStep(
+      outInfo, outInfo->Get(vtkStreamingDemandDrivenPipeline::TIME_STEPS())[0]);
+    }
+  if (extent)
+    {
+    reader->SetUpdateExtent(const_cast<int*>(extent));
+    }
+  else
+    {
+    reader->SetUpdateExtent(piece, numPieces, 0);
+    }
+  reader->Update();
+  vtkDataSet* output = vtkDataSet::SafeDownCast(reader->GetOutputDataObject(0));
+  if (!output)
+    {
+    return NULL;
+    }
+  vtkSmartPointer<vtkDataSet> copy;
+  copy.TakeReference(output->NewInstance());
+  copy->DeepCopy(output);
+  return copy;
+}
+
+void GetExtent(vtkDataSet* dataSet, int extent[6])
+{
+  if (vtkImageData::SafeDownCast(dataSet))
+    {
+    vtkImageData::SafeDownCast(dataSet)->GetExtent(extent);
+    }
+  else if (vtkRectilinearGrid::SafeDownCast(dataSet))
+    {
+    vtkRectilinearGrid::SafeDownCast(dataSet)->GetExtent(extent);
+    }
+  else
+    {
+    vtkStructuredGrid::SafeDownCast(dataSet)->GetExtent(extent);
+    }
+}
+
+bool CompareTuples(vtkFieldData* actual, vtkIdType actualId,
+                   vtkFieldData* expected, vtkIdType expectedId)
+{
+  if (actual->GetNumberOfArrays() != expected->GetNumberOfArrays())
+    {
+    cerr << "Wrong number of arrays " << actual->GetNumberOfArrays() << endl;
+    return false;
+    }
+  for (int a = 0; a < expected->GetNumberOfArrays(); ++a)
+    {
+    vtkDataArray* expectedArray = expected->GetArray(a);
+    vtkDataArray* actualArray = actual->GetArray(expectedArray->GetName());
+    if (!actualArray ||
+        actualArray->GetNumberOfComponents() !=
+        expectedArray->GetNumberOfComponents())
+      {
+      cerr << "Wrong array " << expectedArray->GetName() << endl;
+      return false;
+      }
+    for (int c = 0; c < expectedArray->GetNumberOfComponents(); ++c)
+      {
+      if (actualArray->GetComponent(actualId, c) !=
+          expectedArray->GetComponent(expectedId, c))
+        {
+        cerr << "Wrong value of " << expectedArray->GetName() << endl;
+        return false;
+        }
+      }
+    }
+  return true;
+}
+
+bool ComparePoints(vtkDataSet* actual, vtkIdType actualId,
+                   vtkDataSet* expected, vtkIdType expectedId)
+{
+  double a[3];
+  double e[3];
+  actual->GetPoint(actualId, a);
+  expected->GetPoint(expectedId, e);
+  if (a[0] != e[0] || a[1] != e[1] || a[2] != e[2])
+    {
+    cerr << "Wrong point " << a[0] << " " << a[1] << " " << a[2]
+         << " instead of " << e[0] << " " << e[1] << " " << e[2] << endl;
+    return false;
+    }
+  return CompareTuples(actual->GetPointData(), actualId,
+                       expected->GetPointData(), expectedId);
+}
+
+// Compare a sub-extent read with the same extent of the whole grid.
+bool CompareExtent(vtkDataSet* actual, vtkDataSet* whole, const int* extent)
+{
+  int actualExtent[6];
+  GetExtent(actual, actualExtent);
+  int wholeExtent[6];
+  GetExtent(whole, wholeExtent);
+  for (int i = 0; i < 6; ++i)
+    {
+    if (actualExtent[i] != extent[i])
+      {
+      cerr << "Wrong extent" << endl;
+      return false;
+      }
+    }
+  int ijk[3];
+  for (ijk[2] = extent[4]; ijk[2] <= extent[5]; ++ijk[2])
+    {
+    for (ijk[1] = extent[2]; ijk[1] <= extent[3]; ++ijk[1])
+      {
+      for (ijk[0] = extent[0]; ijk[0] <= extent[1]; ++ijk[0])
+        {
+        if (!ComparePoints(
+              actual, vtkStructuredData::ComputePointIdForExtent(
+                const_cast<int*>(extent), ijk),
+              whole, vtkStructuredData::ComputePointIdForExtent(
+                wholeExtent, ijk)))
+          {
+          return false;
+          }
+        if (ijk[0] < extent[1] && ijk[1] < extent[3] && ijk[2] < extent[5] &&
+            !CompareTuples(
+              actual->GetCellData(),
+              vtkStructuredData::ComputeCellIdForExtent(
+                const_cast<int*>(extent), ijk),
+              whole->GetCellData(),
+              vtkStructuredData::ComputeCellIdForExtent(
+                wholeExtent, ijk)))
+          {
+          return false;
+          }
+        }
+      }
+    }
+  return true;
+}
+
+// Compare the cells of a piece with the cells of the whole grid starting
+// at firstCell.
+bool CompareCells(vtkDataSet* actual, vtkDataSet* whole, vtkIdType firstCell)
+{
+  vtkNew<vtkIdList> actualIds;
+  vtkNew<vtkIdList> wholeIds;
+  for (vtkIdType c = 0; c < actual->GetNumberOfCells(); ++c)
+    {
+    actual->GetCellPoints(c, actualIds.GetPointer());
+    whole->GetCellPoints(firstCell + c, wholeIds.GetPointer());
+    if (actual->GetCellType(c) != whole->GetCellType(firstCell + c) ||
+        actualIds->GetNumberOfIds() != wholeIds->GetNumberOfIds())
+      {
+      cerr << "Wrong cell " << c << endl;
+      return false;
+      }
+    for (vtkIdType i = 0; i < actualIds->GetNumberOfIds(); ++i)
+      {
+      if (!ComparePoints(actual, actualIds->GetId(i),
+                         whole, wholeIds->GetId(i)))
+        {
+        return false;
+        }
+      }
+    if (!CompareTuples(actual->GetCellData(), c,
+                       whole->GetCellData(), firstCell + c))
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
+// Read the file in pieces and compare each with the whole grid.
+bool ComparePieces(const std::string& fileName, vtkDataSet* whole)
+{
+  vtkNew<vtkXdmf3Reader> reader;
+  reader->SetFileName(fileName.c_str());
+  const int numPieces = 5;
+  vtkIdType firstCell = 0;
+  for (int piece = 0; piece < numPieces; ++piece)
+    {
+    vtkSmartPointer<vtkDataSet> actual =
+      Read(reader.GetPointer(), NULL, piece, numPieces);
+    if (!actual || !CompareCells(actual, whole, firstCell))
+      {
+      cerr << "Wrong piece " << piece << " of " << fileName << endl;
+      return false;
+      }
+    // Only the points used by the cells of the piece are read.
+    if (actual->GetNumberOfPoints() >= whole->GetNumberOfPoints())
+      {
+      cerr << "Read all the points for piece " << piece << endl;
+      return false;
+      }
+    firstCell += actual->GetNumberOfCells();
+    }
+  if (firstCell != whole->GetNumberOfCells())
+    {
+    cerr << "Wrong number of cells in the pieces " << firstCell << endl;
+    return false;
+    }
+  return true;
+}
+}
+
+int TestXdmf3PartialRead(int argc, char* argv[])
+{
+  char* tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  if (!tempDir)
+    {
+    cerr << "Could not determine temporary directory." << endl;
+    return EXIT_FAILURE;
+    }
+  std::string prefix = tempDir;
+  delete [] tempDir;
+  prefix += "/TestXdmf3PartialRead";
+
+  // Sub-extents of structured grids.
+  int types[3] = { VTK_IMAGE_DATA, VTK_RECTILINEAR_GRID, VTK_STRUCTURED_GRID };
+  const int subExtent[6] = { 1, 4, 2, 5, 0, 3 };
+  for (int t = 0; t < 3; ++t)
+    {
+    std::string fileName = prefix + "Structured.xmf";
+    vtkSmartPointer<vtkDataSet> grid = MakeStructured(types[t]);
+    Write(grid, fileName);
+    vtkNew<vtkXdmf3Reader> reader;
+    reader->SetFileName(fileName.c_str());
+    vtkSmartPointer<vtkDataSet> whole = Read(reader.GetPointer(), NULL, 0, 1);
+    // vtkXdmf3Writer writes the coordinates of rectilinear grids in the
+    // reverse order of what vtkXdmf3Reader expects, so those are only
+    // compared with the whole grid that is read.
+    if (!whole || (types[t] != VTK_RECTILINEAR_GRID &&
+                   !CompareExtent(whole, grid, WholeExtent)))
+      {
+      cerr << "Wrong whole " << grid->GetClassName() << endl;
+      return EXIT_FAILURE;
+      }
+    // The whole output holds the sub-extent, so it is read by another reader.
+    vtkNew<vtkXdmf3Reader> partReader;
+    partReader->SetFileName(fileName.c_str());
+    vtkSmartPointer<vtkDataSet> part =
+      Read(partReader.GetPointer(), subExtent, 0, 1);
+    if (!part || !CompareExtent(part, whole, subExtent))
+      {
+      cerr << "Wrong sub-extent of " << grid->GetClassName() << endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  // Pieces of an unstructured grid with a mixed topology.
+  vtkSmartPointer<vtkUnstructuredGrid> hexahedra = MakeHexahedra();
+  std::string mixedName = prefix + "Mixed.xmf";
+  Write(hexahedra, mixedName);
+  vtkNew<vtkXdmf3Reader> reader;
+  reader->SetFileName(mixedName.c_str());
+  vtkSmartPointer<vtkDataSet> whole = Read(reader.GetPointer(), NULL, 0, 1);
+  if (!whole || !CompareCells(whole, hexahedra, 0) ||
+      whole->GetNumberOfCells() != hexahedra->GetNumberOfCells())
+    {
+    cerr << "Wrong whole unstructured grid" << endl;
+    return EXIT_FAILURE;
+    }
+  if (!ComparePieces(mixedName, hexahedra))
+    {
+    return EXIT_FAILURE;
+    }
+
+  // Pieces of two time steps of an unstructured grid with a topology of
+  // hexahedra, that share their geometry and topology. vtkXdmf3Writer
+  // always writes mixed topologies, so the connectivity is written as the
+  // scalars of an image with 8 values per row.
+  std::string connectivityName = prefix + "Connectivity.xmf";
+  vtkNew<vtkImageData> connectivity;
+  connectivity->SetExtent(0, 7, 0, hexahedra->GetNumberOfCells() - 1, 0, 0);
+  vtkNew<vtkIntArray> ids;
+  ids->SetName("Connectivity");
+  vtkCellArray* cells = hexahedra->GetCells();
+  cells->InitTraversal();
+  vtkIdType npts;
+  vtkIdType* pts;
+  while (cells->GetNextCell(npts, pts))
+    {
+    for (vtkIdType i = 0; i < npts; ++i)
+      {
+      ids->InsertNextValue(static_cast<int>(pts[i]));
+      }
+    }
+  connectivity->GetPointData()->AddArray(ids.GetPointer());
+  Write(connectivity.GetPointer(), connectivityName);
+
+  // The datasets are numbered in the order that vtkXdmf3Writer writes them.
+  std::string base = prefix.substr(prefix.find_last_of("/") + 1);
+  std::string mixedData = base + "Mixed.h5:Data";
+  std::string hexahedraName = prefix + "Hexahedra.xmf";
+  ofstream xmf(hexahedraName.c_str());
+  xmf << "<?xml version=\"1.0\" ?>\n"
+      << "<Xdmf Version=\"2.0\">\n <Domain>\n"
+      << "  <Grid Name=\"Steps\" GridType=\"Collection\""
+      << " CollectionType=\"Temporal\">\n";
+  for (int step = 0; step < 2; ++step)
+    {
+    xmf << "   <Grid Name=\"Hexahedra\">\n"
+        << "    <Time Value=\"" << step << "\"/>\n"
+        << "    <Geometry Type=\"XYZ\">\n"
+        << "     <DataItem DataType=\"Float\" Dimensions=\"60 3\""
+        << " Format=\"HDF\" Precision=\"4\">" << mixedData << "0</DataItem>\n"
+        << "    </Geometry>\n"
+        << "    <Topology Type=\"Hexahedron\" NumberOfElements=\"24\">\n"
+        << "     <DataItem DataType=\"Int\" Dimensions=\"24 8\""
+        << " Format=\"HDF\" Precision=\"4\">" << base
+        << "Connectivity.h5:Data2</DataItem>\n"
+        << "    </Topology>\n"
+        << "    <Attribute Center=\"Node\" Name=\"PointVectors\""
+        << " Type=\"Vector\">\n"
+        << "     <DataItem DataType=\"Float\" Dimensions=\"60 3\""
+        << " Format=\"HDF\" Precision=\"4\">" << mixedData << "2</DataItem>\n"
+        << "    </Attribute>\n"
+        << "    <Attribute Center=\"Cell\" Name=\"CellScalars\">\n"
+        << "     <DataItem DataType=\"Float\" Dimensions=\"24\""
+        << " Format=\"HDF\" Precision=\"8\">" << mixedData << "3</DataItem>\n"
+        << "    </Attribute>\n"
+        << "   </Grid>\n";
+    }
+  xmf << "  </Grid>\n </Domain>\n</Xdmf>\n";
+  xmf.close();
+
+  vtkNew<vtkXdmf3Reader> timeReader;
+  timeReader->SetFileName(hexahedraName.c_str());
+  timeReader->UpdateInformation();
+  vtkStreamingDemandDrivenPipeline* executive =
+    vtkStreamingDemandDrivenPipeline::SafeDownCast(timeReader->GetExecutive());
+  vtkDataArray* points[2];
+  for (int step = 0; step < 2; ++step)
+    {
+    executive->SetUpdateTimeStep(0, step);
+    timeReader->Update();
+    vtkDataSet* output =
+      vtkDataSet::SafeDownCast(timeReader->GetOutputDataObject(0));
+    if (!output || !CompareCells(output, hexahedra, 0) ||
+        output->GetNumberOfCells() != hexahedra->GetNumberOfCells())
+      {
+      cerr << "Wrong hexahedra at time step " << step << endl;
+      return EXIT_FAILURE;
+      }
+    points[step] = vtkPointSet::SafeDownCast(output)->GetPoints()->GetData();
+    }
+  if (points[0] != points[1])
+    {
+    cerr << "The geometry shared by the time steps was read twice" << endl;
+    return EXIT_FAILURE;
+    }
+  if (!ComparePieces(hexahedraName, hexahedra))
+    {
+    return EXIT_FAILURE;
+    }
+
+  // A sub-extent of an attribute shorter than its grid is skipped rather
+  // than read past its end.
+  std::string shortName = prefix + "Short.xmf";
+  ofstream shortXmf(shortName.c_str());
+  shortXmf << "<?xml version=\"1.0\" ?>\n"
+           << "<Xdmf Version=\"2.0\">\n <Domain>\n"
+           << "  <Grid Name=\"Image\">\n"
+           << "   <Topology TopologyType=\"3DCoRectMesh\""
+           << " Dimensions=\"3 3 3\"/>\n"
+           << "   <Geometry GeometryType=\"ORIGIN_DXDYDZ\">\n"
+           << "    <DataItem Dimensions=\"3\" Format=\"XML\">0 0 0</DataItem>\n"
+           << "    <DataItem Dimensions=\"3\" Format=\"XML\">1 1 1</DataItem>\n"
+           << "   </Geometry>\n"
+           << "   <Attribute Center=\"Node\" Name=\"Whole\">\n"
+           << "    <DataItem Dimensions=\"27\" Format=\"XML\">";
+  for (int i = 0; i < 27; ++i)
+    {
+    shortXmf << " " << i;
+    }
+  shortXmf << "</DataItem>\n"
+           << "   </Attribute>\n"
+           << "   <Attribute Center=\"Node\" Name=\"Short\">\n"
+           << "    <DataItem Dimensions=\"10\" Format=\"XML\">"
+           << "0 1 2 3 4 5 6 7 8 9</DataItem>\n"
+           << "   </Attribute>\n"
+           << "  </Grid>\n </Domain>\n</Xdmf>\n";
+  shortXmf.close();
+  vtkNew<vtkXdmf3Reader> shortReader;
+  shortReader->SetFileName(shortName.c_str());
+  const int shortExtent[6] = { 1, 2, 1, 2, 1, 2 };
+  vtkSmartPointer<vtkDataSet> shortPart =
+    Read(shortReader.GetPointer(), shortExtent, 0, 1);
+  vtkDataArray* wholeArray =
+    shortPart ? shortPart->GetPointData()->GetArray("Whole") : NULL;
+  if (!wholeArray || wholeArray->GetNumberOfTuples() != 8 ||
+      wholeArray->GetComponent(0, 0) != 13 ||
+      shortPart->GetPointData()->GetArray("Short"))
+    {
+    cerr << "Wrong sub-extent of a grid with a short attribute" << endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
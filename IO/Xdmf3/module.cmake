@@ -9,6 +9,7 @@ vtk_module(vtkIOXdmf3
     vtkParallelCore
   PRIVATE_DEPENDS
     vtkFiltersExtraction
+    vtkhdf5
     vtksys
     vtkxdmf3
   TEST_DEPENDS
@@ -18,6 +18,8 @@
 
 #include "vtkXdmf3ArrayKeeper.h"
 
+#include "vtkDataArray.h"
+
 #include "XdmfArray.hpp"
 
 //------------------------------------------------------------------------------
@@ -47,6 +49,19 @@ void vtkXdmf3ArrayKeeper::Insert(XdmfArray *val)
 //------------------------------------------------------------------------------
 void vtkXdmf3ArrayKeeper::Release(bool force)
 {
+  //forget the VTK arrays first, some of them refer to arrays released below
+  std::map<std::string, RememberedArray>::iterator rit =
+    this->Remembered.begin();
+  while (rit != this->Remembered.end())
+    {
+    std::map<std::string, RememberedArray>::iterator current = rit++;
+    if (force || (current->second.Generation != this->generation))
+      {
+      current->second.Array->UnRegister(NULL);
+      this->Remembered.erase(current);
+      }
+    }
+
   vtkXdmf3ArrayKeeper::iterator it = this->begin();
   //int cnt = 0;
   //int total = 0;
@@ -64,3 +79,44 @@ void vtkXdmf3ArrayKeeper::Release(bool force)
     }
   //cerr << "released " << cnt << "/" << total << " arrays" << endl;
 }
+
+//------------------------------------------------------------------------------
+vtkDataArray *vtkXdmf3ArrayKeeper::Lookup(const std::string &key)
+{
+  std::map<std::string, RememberedArray>::iterator it =
+    this->Remembered.find(key);
+  if (it == this->Remembered.end())
+    {
+    return NULL;
+    }
+  it->second.Generation = this->generation;
+  if (it->second.Source)
+    {
+    this->Insert(it->second.Source);
+    }
+  return it->second.Array;
+}
+
+//------------------------------------------------------------------------------
+void vtkXdmf3ArrayKeeper::Remember(const std::string &key, XdmfArray *source,
+                                   vtkDataArray *vtkArray)
+{
+  RememberedArray &entry = this->Remembered[key];
+  if (entry.Array == vtkArray)
+    {
+    entry.Generation = this->generation;
+    return;
+    }
+  if (entry.Array)
+    {
+    entry.Array->UnRegister(NULL);
+    }
+  vtkArray->Register(NULL);
+  entry.Source = source;
+  entry.Array = vtkArray;
+  entry.Generation = this->generation;
+  if (source)
+    {
+    this->Insert(source);
+    }
+}
@@ -22,6 +22,10 @@
 // current timestep. A release method frees arrays that have not been recently
 // used.
 //
+// The keeper also remembers the VTK arrays made from heavy data, keyed by
+// where the data is stored, so that a geometry shared by several time steps
+// is read and converted only once while it stays in use.
+//
 // This file is a helper for the vtkXdmf3Reader and not intended to be
 // part of VTK public API
 // VTK-HeaderTest-Exclude: vtkXdmf3ArrayKeeper.h
@@ -31,7 +35,9 @@
 
 #include "vtkIOXdmf3Module.h" // For export macro
 #include <map>
+#include <string> // For the keys of remembered arrays
 
+class vtkDataArray;
 class XdmfArray;
 
 class VTKIOXDMF3_EXPORT vtkXdmf3ArrayKeeper
@@ -59,7 +65,27 @@ public:
   //Force argument frees all arrays.
   void Release(bool force);
 
+  //Description:
+  //Returns the VTK array remembered for the given key and marks it as used
+  //in the current generation, or returns NULL.
+  vtkDataArray *Lookup(const std::string &key);
+
+  //Description:
+  //Remembers a VTK array made from heavy data under the given key. source
+  //is the XDMF array whose memory vtkArray refers to, or NULL when
+  //vtkArray owns its values.
+  void Remember(const std::string &key, XdmfArray *source,
+                vtkDataArray *vtkArray);
+
 private:
+  struct RememberedArray
+  {
+    XdmfArray *Source;
+    vtkDataArray *Array;
+    unsigned int Generation;
+  };
+  std::map<std::string, RememberedArray> Remembered;
+
   unsigned int generation;
 };
 
@@ -41,6 +41,7 @@
 #include "vtkUnsignedIntArray.h"
 #include "vtkUnstructuredGrid.h"
 #include "vtkVertexListIterator.h"
+#include "vtk_hdf5.h"
 
 #include "XdmfArrayType.hpp"
 #include "XdmfAttribute.hpp"
@@ -48,9 +49,11 @@
 #include "XdmfAttributeType.hpp"
 #include "XdmfCurvilinearGrid.hpp"
 #include "XdmfDomain.hpp"
+#include "XdmfError.hpp"
 #include "XdmfGeometry.hpp"
 #include "XdmfGeometryType.hpp"
 #include "XdmfGraph.hpp"
+#include "XdmfHDF5Controller.hpp"
 #include "XdmfRectilinearGrid.hpp"
 #include "XdmfRegularGrid.hpp"
 #include "XdmfSet.hpp"
@@ -60,6 +63,9 @@
 #include "XdmfTopology.hpp"
 #include "XdmfTopologyType.hpp"
 
+#include <cstring>
+#include <sstream>
+
 //==============================================================================
 bool vtkXdmf3DataSet_ReadIfNeeded(XdmfArray *array, bool dbg=false)
 {
@@ -88,6 +94,558 @@ void vtkXdmf3DataSet_ReleaseIfNeeded(XdmfArray *array, bool MyInit,
     }
 }
 
+//==============================================================================
+//A block of tuples of an array seen as a grid of tuples. Dims is the number
+//of tuples along each axis, slowest varying first, and the block starts at
+//Start and spans Count tuples along each axis.
+struct vtkXdmf3DataSet_Block
+{
+  std::vector<unsigned int> Dims;
+  std::vector<unsigned int> Start;
+  std::vector<unsigned int> Count;
+
+  void SetOneAxis(unsigned int dim, unsigned int start, unsigned int count)
+  {
+    this->Dims.assign(1, dim);
+    this->Start.assign(1, start);
+    this->Count.assign(1, count);
+  }
+
+  unsigned int GetNumberOfTuples() const
+  {
+    unsigned int n = 1;
+    for (size_t i = 0; i < this->Count.size(); i++)
+      {
+      n = n * this->Count[i];
+      }
+    return n;
+  }
+};
+
+//------------------------------------------------------------------------------
+//Returns a key that identifies where the values of the array are stored, or
+//an empty string when they are not read from heavy data.
+std::string vtkXdmf3DataSet_HeavyDataKey(XdmfArray *array)
+{
+  unsigned int numControllers = array->getNumberHeavyDataControllers();
+  if (array->getReadMode() != XdmfArray::Controller || numControllers == 0)
+    {
+    return std::string();
+    }
+  std::ostringstream key;
+  for (unsigned int i = 0; i < numControllers; i++)
+    {
+    shared_ptr<XdmfHeavyDataController> controller =
+      array->getHeavyDataController(i);
+    key << controller->getName() << " " << controller->getFilePath()
+        << controller->getDescriptor() << " "
+        << controller->getType()->getName() << " "
+        << controller->getArrayOffset();
+    std::vector<unsigned int> dims = controller->getDimensions();
+    shared_ptr<XdmfHDF5Controller> hdf5Controller =
+      shared_dynamic_cast<XdmfHDF5Controller>(controller);
+    if (hdf5Controller)
+      {
+      std::vector<unsigned int> start = hdf5Controller->getStart();
+      std::vector<unsigned int> stride = hdf5Controller->getStride();
+      for (size_t d = 0; d < dims.size() && d < start.size() &&
+             d < stride.size(); d++)
+        {
+        key << " " << start[d] << ":" << stride[d] << ":" << dims[d];
+        }
+      }
+    else
+      {
+      for (size_t d = 0; d < dims.size(); d++)
+        {
+        key << " " << dims[d];
+        }
+      }
+    key << ";";
+    }
+  return key.str();
+}
+
+//------------------------------------------------------------------------------
+//Gets the dimensions of the dataset that a controller reads from. Unlike the
+//dimensions of the controller, they come from the HDF5 file.
+bool vtkXdmf3DataSet_GetDataspaceDimensions(XdmfHDF5Controller *controller,
+                                            std::vector<unsigned int> &dims)
+{
+  dims.clear();
+  bool OK = false;
+  H5E_BEGIN_TRY
+    {
+    hid_t file = H5Fopen(controller->getFilePath().c_str(),
+                         H5F_ACC_RDONLY, H5P_DEFAULT);
+    if (file >= 0)
+      {
+      hid_t dataset = H5Dopen(file, controller->getDataSetPath().c_str(),
+                              H5P_DEFAULT);
+      if (dataset >= 0)
+        {
+        hid_t dataspace = H5Dget_space(dataset);
+        int rank = dataspace >= 0 ? H5Sget_simple_extent_ndims(dataspace) : -1;
+        if (rank > 0)
+          {
+          std::vector<hsize_t> hdims(rank);
+          H5Sget_simple_extent_dims(dataspace, &hdims[0], NULL);
+          dims.assign(hdims.begin(), hdims.end());
+          OK = true;
+          }
+        if (dataspace >= 0)
+          {
+          H5Sclose(dataspace);
+          }
+        H5Dclose(dataset);
+        }
+      H5Fclose(file);
+      }
+    }
+  H5E_END_TRY;
+  return OK;
+}
+
+//------------------------------------------------------------------------------
+//Reads the block of an array stored in a single HDF5 dataset with a
+//hyperslab selection. The dataset must have the shape of the block's grid
+//of tuples followed by the components, ignoring axes of size 1, or be flat
+//when the block is contiguous. Returns an empty pointer otherwise.
+shared_ptr<XdmfArray> vtkXdmf3DataSet_ReadHyperSlab(
+  XdmfArray *array, unsigned int ncomp, const vtkXdmf3DataSet_Block &block)
+{
+  shared_ptr<XdmfArray> none;
+  if (array->isInitialized() ||
+      array->getReadMode() != XdmfArray::Controller ||
+      array->getNumberHeavyDataControllers() != 1)
+    {
+    return none;
+    }
+  shared_ptr<XdmfHDF5Controller> controller =
+    shared_dynamic_cast<XdmfHDF5Controller>(array->getHeavyDataController(0));
+  if (!controller || controller->getArrayOffset() != 0)
+    {
+    return none;
+    }
+  std::vector<unsigned int> dims = controller->getDimensions();
+  std::vector<unsigned int> cstart = controller->getStart();
+  std::vector<unsigned int> cstride = controller->getStride();
+  std::vector<unsigned int> dataspace;
+  if (dims.empty() || cstart.size() != dims.size() ||
+      cstride.size() != dims.size() ||
+      !vtkXdmf3DataSet_GetDataspaceDimensions(controller.get(), dataspace))
+    {
+    return none;
+    }
+  if (dataspace.size() != dims.size())
+    {
+    //the light data describes the whole dataset with another rank, map the
+    //block onto the dimensions of the dataset instead
+    unsigned int lightSize = 1;
+    unsigned int heavySize = 1;
+    for (size_t i = 0; i < dims.size(); i++)
+      {
+      lightSize = lightSize * dims[i];
+      if (cstart[i] != 0 || cstride[i] != 1)
+        {
+        return none;
+        }
+      }
+    for (size_t i = 0; i < dataspace.size(); i++)
+      {
+      heavySize = heavySize * dataspace[i];
+      }
+    if (lightSize != heavySize)
+      {
+      return none;
+      }
+    dims = dataspace;
+    cstart.assign(dims.size(), 0);
+    cstride.assign(dims.size(), 1);
+    }
+
+  //the axes of the block and the components, without those of size 1
+  std::vector<unsigned int> lDims;
+  std::vector<unsigned int> lStart;
+  std::vector<unsigned int> lCount;
+  for (size_t i = 0; i < block.Dims.size(); i++)
+    {
+    if (block.Dims[i] != 1)
+      {
+      lDims.push_back(block.Dims[i]);
+      lStart.push_back(block.Start[i]);
+      lCount.push_back(block.Count[i]);
+      }
+    }
+  if (ncomp != 1)
+    {
+    lDims.push_back(ncomp);
+    lStart.push_back(0);
+    lCount.push_back(ncomp);
+    }
+
+  std::vector<unsigned int> start(dims.size(), 0);
+  std::vector<unsigned int> count(dims.size(), 1);
+  size_t l = 0;
+  bool matches = true;
+  for (size_t i = 0; i < dims.size() && matches; i++)
+    {
+    if (dims[i] == 1)
+      {
+      continue;
+      }
+    if (l == lDims.size() || dims[i] != lDims[l])
+      {
+      matches = false;
+      break;
+      }
+    start[i] = lStart[l];
+    count[i] = lCount[l];
+    l++;
+    }
+  if (!matches || l != lDims.size())
+    {
+    //a flat dataset, read as one run when the block is contiguous
+    size_t flatAxis = dims.size();
+    for (size_t i = 0; i < dims.size(); i++)
+      {
+      if (dims[i] != 1)
+        {
+        if (flatAxis != dims.size())
+          {
+          return none;
+          }
+        flatAxis = i;
+        }
+      }
+    size_t partial = lDims.size();
+    unsigned int total = 1;
+    for (size_t i = 0; i < lDims.size(); i++)
+      {
+      total = total * lDims[i];
+      if (lCount[i] != lDims[i])
+        {
+        partial = i;
+        }
+      }
+    if (flatAxis == dims.size() || dims[flatAxis] != total)
+      {
+      return none;
+      }
+    unsigned int flatStart = 0;
+    unsigned int flatCount = 1;
+    for (size_t i = 0; i < lDims.size(); i++)
+      {
+      if (i < partial && lCount[i] != 1)
+        {
+        return none;
+        }
+      flatStart = flatStart * lDims[i] + lStart[i];
+      flatCount = flatCount * lCount[i];
+      }
+    start.assign(dims.size(), 0);
+    count.assign(dims.size(), 1);
+    start[flatAxis] = flatStart;
+    count[flatAxis] = flatCount;
+    }
+
+  for (size_t i = 0; i < dims.size(); i++)
+    {
+    start[i] = cstart[i] + start[i] * cstride[i];
+    }
+  shared_ptr<XdmfArray> slab = XdmfArray::New();
+  slab->insert(XdmfHDF5Controller::New(controller->getFilePath(),
+                                       controller->getDataSetPath(),
+                                       controller->getType(),
+                                       start, cstride, count, dataspace));
+  try
+    {
+    slab->read();
+    }
+  catch (XdmfError &)
+    {
+    return none;
+    }
+  return slab;
+}
+
+//------------------------------------------------------------------------------
+//Returns a new VTK array with the tuples of the block of an XDMF array. Only
+//the block is read when the array is stored in a single HDF5 dataset that
+//has not been read yet, otherwise the tuples are copied from the whole
+//array. Returns NULL, with a warning, when the array is shorter than the
+//grid the block is cut from.
+vtkDataArray *vtkXdmf3DataSet_ReadBlock(
+  XdmfArray *xArray, const std::string &name, unsigned int ncomp,
+  const vtkXdmf3DataSet_Block &block, vtkXdmf3ArrayKeeper *keeper)
+{
+  unsigned int ntuples = block.GetNumberOfTuples();
+  shared_ptr<XdmfArray> slab;
+  if (ntuples > 0)
+    {
+    slab = vtkXdmf3DataSet_ReadHyperSlab(xArray, ncomp, block);
+    }
+  if (slab && slab->getSize() == ntuples * ncomp)
+    {
+    vtkDataArray *read = vtkXdmf3DataSet::XdmfToVTKArray(
+      slab.get(), name, ncomp);
+    if (!read)
+      {
+      return NULL;
+      }
+    vtkDataArray *vArray = read->NewInstance();
+    vArray->DeepCopy(read);
+    vArray->SetName(name.c_str());
+    read->Delete();
+    return vArray;
+    }
+
+  vtkDataArray *whole = vtkXdmf3DataSet::XdmfToVTKArray(
+    xArray, name, ncomp, keeper);
+  if (!whole)
+    {
+    return NULL;
+    }
+  size_t naxes = block.Dims.size();
+  unsigned int wholeTuples = 1;
+  for (size_t i = 0; i < naxes; i++)
+    {
+    wholeTuples = wholeTuples * block.Dims[i];
+    }
+  if (ntuples > 0 &&
+      static_cast<unsigned int>(whole->GetNumberOfTuples()) < wholeTuples)
+    {
+    vtkGenericWarningMacro(
+      "Skipping " << (name.empty() ? "an array" : name.c_str())
+      << " of " << whole->GetNumberOfTuples() << " tuples instead of "
+      << wholeTuples);
+    whole->Delete();
+    return NULL;
+    }
+  vtkDataArray *vArray = whole->NewInstance();
+  vArray->SetName(name.c_str());
+  vArray->SetNumberOfComponents(static_cast<int>(ncomp));
+  vArray->SetNumberOfTuples(ntuples);
+  if (ntuples == 0 || naxes == 0)
+    {
+    whole->Delete();
+    return vArray;
+    }
+
+  //copy the runs of tuples along the fastest axis
+  size_t tupleSize = ncomp * whole->GetDataTypeSize();
+  size_t runSize = block.Count[naxes-1] * tupleSize;
+  const char *from = static_cast<const char *>(whole->GetVoidPointer(0));
+  char *to = static_cast<char *>(vArray->GetVoidPointer(0));
+  std::vector<unsigned int> index(block.Start);
+  for (unsigned int run = 0; run < ntuples / block.Count[naxes-1]; run++)
+    {
+    size_t offset = 0;
+    for (size_t i = 0; i < naxes; i++)
+      {
+      offset = offset * block.Dims[i] + index[i];
+      }
+    memcpy(to, from + offset * tupleSize, runSize);
+    to += runSize;
+    for (size_t i = naxes - 1; i-- > 0; )
+      {
+      if (++index[i] < block.Start[i] + block.Count[i])
+        {
+        break;
+        }
+      index[i] = block.Start[i];
+      }
+    }
+  whole->Delete();
+  return vArray;
+}
+
+//------------------------------------------------------------------------------
+//Returns a new reference to the VTK array with the block of a geometry or
+//coordinates array, or with all of it when block is NULL. The array is
+//shared with the previous time steps when they read the same heavy data.
+vtkDataArray *vtkXdmf3DataSet_ReadGeometryArray(
+  XdmfArray *xArray, const std::string &name, unsigned int ncomp,
+  const vtkXdmf3DataSet_Block *block, vtkXdmf3ArrayKeeper *keeper)
+{
+  std::string key;
+  if (keeper)
+    {
+    key = vtkXdmf3DataSet_HeavyDataKey(xArray);
+    }
+  if (!key.empty() && block)
+    {
+    std::ostringstream blockKey;
+    blockKey << key << "block";
+    for (size_t i = 0; i < block->Dims.size(); i++)
+      {
+      blockKey << " " << block->Start[i] << ":" << block->Count[i];
+      }
+    key = blockKey.str();
+    }
+  vtkDataArray *vArray = NULL;
+  if (!key.empty())
+    {
+    vArray = keeper->Lookup(key);
+    }
+  if (vArray)
+    {
+    vArray->Register(NULL);
+    return vArray;
+    }
+
+  if (block)
+    {
+    vArray = vtkXdmf3DataSet_ReadBlock(xArray, name, ncomp, *block, keeper);
+    }
+  else
+    {
+    vArray = vtkXdmf3DataSet::XdmfToVTKArray(xArray, name, ncomp, keeper);
+    }
+  if (vArray && !key.empty())
+    {
+    //a whole array refers to the memory of the XDMF array
+    keeper->Remember(key, block ? NULL : xArray, vArray);
+    }
+  return vArray;
+}
+
+//------------------------------------------------------------------------------
+//Sets points to the block of a grid's geometry, or to the whole geometry
+//when block is NULL. Returns false when the geometry cannot be read.
+bool vtkXdmf3DataSet_ReadPoints(
+  XdmfGeometry *geom, vtkPoints *points,
+  const vtkXdmf3DataSet_Block *block, vtkXdmf3ArrayKeeper *keeper)
+{
+  vtkDataArray *vPoints = NULL;
+  if (geom->getType() == XdmfGeometryType::XY())
+    {
+    vPoints = vtkXdmf3DataSet_ReadGeometryArray(geom, "", 2, block, keeper);
+    if (!vPoints)
+      {
+      return false;
+      }
+    vtkDataArray *vPoints3 = vPoints->NewInstance();
+    vPoints3->SetNumberOfComponents(3);
+    vPoints3->SetNumberOfTuples(vPoints->GetNumberOfTuples());
+    vPoints3->SetName("");
+    vPoints3->CopyComponent(0, vPoints, 0);
+    vPoints3->CopyComponent(1, vPoints, 1);
+    vPoints3->FillComponent(2, 0.0);
+    vPoints->Delete();
+    vPoints = vPoints3;
+    }
+  else if (geom->getType() == XdmfGeometryType::XYZ())
+    {
+    vPoints = vtkXdmf3DataSet_ReadGeometryArray(geom, "", 3, block, keeper);
+    if (!vPoints)
+      {
+      return false;
+      }
+    }
+  else
+    {
+    //TODO: No X_Y or X_Y_Z in xdmf anymore
+    return false;
+    }
+  points->SetData(vPoints);
+  vPoints->Delete();
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//Copies the connectivity of cells that all have numPointsPerCell points to
+//the layout of vtkCellArray.
+template <class T>
+void vtkXdmf3DataSet_CopyConnectivity(const T *from, vtkIdType numCells,
+                                      vtkIdType numPointsPerCell,
+                                      vtkIdType *to)
+{
+  for (vtkIdType cc = 0; cc < numCells; cc++)
+    {
+    *to++ = numPointsPerCell;
+    for (vtkIdType i = 0; i < numPointsPerCell; i++)
+      {
+      *to++ = static_cast<vtkIdType>(*from++);
+      }
+    }
+}
+
+//------------------------------------------------------------------------------
+//Returns true when a structured data set should hold the update extent
+//rather than the whole extent: when the update extent is empty, or is a
+//smaller extent inside the whole extent that is not flat along an axis
+//where the grid has cells.
+bool vtkXdmf3DataSet_UseUpdateExtent(const int wholeExtent[6],
+                                     const int *updateExtent)
+{
+  if (!updateExtent)
+    {
+    return false;
+    }
+  for (int i = 0; i < 3; i++)
+    {
+    if (updateExtent[2*i] > updateExtent[2*i+1])
+      {
+      return true;
+      }
+    }
+  bool same = true;
+  for (int i = 0; i < 3; i++)
+    {
+    if (updateExtent[2*i] < wholeExtent[2*i] ||
+        updateExtent[2*i+1] > wholeExtent[2*i+1] ||
+        (wholeExtent[2*i] < wholeExtent[2*i+1] &&
+         updateExtent[2*i] == updateExtent[2*i+1]))
+      {
+      return false;
+      }
+    if (updateExtent[2*i] != wholeExtent[2*i] ||
+        updateExtent[2*i+1] != wholeExtent[2*i+1])
+      {
+      same = false;
+      }
+    }
+  return !same;
+}
+
+//------------------------------------------------------------------------------
+//Fills the blocks of points and cells of a structured grid that make up the
+//update extent, slowest varying axis (k) first.
+void vtkXdmf3DataSet_ExtentToBlocks(const int wholeExtent[6],
+                                    const int updateExtent[6],
+                                    vtkXdmf3DataSet_Block &points,
+                                    vtkXdmf3DataSet_Block &cells)
+{
+  for (int i = 2; i >= 0; i--)
+    {
+    unsigned int n =
+      static_cast<unsigned int>(wholeExtent[2*i+1] - wholeExtent[2*i] + 1);
+    int start = updateExtent[2*i] - wholeExtent[2*i];
+    int count = updateExtent[2*i+1] - updateExtent[2*i] + 1;
+    if (count <= 0)
+      {
+      start = 0;
+      count = 0;
+      }
+    points.Dims.push_back(n);
+    points.Start.push_back(static_cast<unsigned int>(start));
+    points.Count.push_back(static_cast<unsigned int>(count));
+    if (n > 1)
+      {
+      cells.Dims.push_back(n - 1);
+      cells.Start.push_back(static_cast<unsigned int>(start));
+      cells.Count.push_back(static_cast<unsigned int>(count > 0 ? count-1 : 0));
+      }
+    else
+      {
+      cells.Dims.push_back(1);
+      cells.Start.push_back(0);
+      cells.Count.push_back(static_cast<unsigned int>(count > 0 ? 1 : 0));
+      }
+    }
+}
+
 //==============================================================================
 vtkDataArray *vtkXdmf3DataSet::XdmfToVTKArray(
   XdmfArray* xArray,
@@ -189,7 +747,9 @@ vtkDataArray *vtkXdmf3DataSet::XdmfToVTKArray(
 #else
     //shallowcopy
     vArray->SetVoidArray(xArray->getValuesInternal(), ntuples*ncomp, 1);
-    if (keeper && freeMe)
+    //mark arrays that an earlier request read as well, the output refers
+    //to them until the next request releases what it did not use
+    if (keeper && (freeMe || xArray->getNumberHeavyDataControllers() > 0))
       {
       keeper->Insert(xArray);
       }
@@ -427,12 +987,17 @@ bool vtkXdmf3DataSet::VTKToXdmfArray(
 }
 
 //--------------------------------------------------------------------------
-void vtkXdmf3DataSet::XdmfToVTKAttributes(
+//Reads the selected attributes of the grid. When pointBlock or cellBlock
+//is given, the data set holds only that block of the grid's points or
+//cells, and only that block of the node or cell centered arrays is read.
+void vtkXdmf3DataSet_ReadAttributes(
   vtkXdmf3ArraySelection *fselection,
   vtkXdmf3ArraySelection *cselection,
   vtkXdmf3ArraySelection *pselection,
   XdmfGrid *grid, vtkDataObject *dObject,
-  vtkXdmf3ArrayKeeper *keeper)
+  vtkXdmf3ArrayKeeper *keeper,
+  const vtkXdmf3DataSet_Block *pointBlock,
+  const vtkXdmf3DataSet_Block *cellBlock)
 {
   vtkDataSet *dataSet = vtkDataSet::SafeDownCast(dObject);
   if (!dataSet)
@@ -441,6 +1006,22 @@ void vtkXdmf3DataSet::XdmfToVTKAttributes(
     }
   unsigned int numCells = dataSet->GetNumberOfCells();
   unsigned int numPoints = dataSet->GetNumberOfPoints();
+  if (cellBlock)
+    {
+    numCells = 1;
+    for (size_t i = 0; i < cellBlock->Dims.size(); i++)
+      {
+      numCells = numCells * cellBlock->Dims[i];
+      }
+    }
+  if (pointBlock)
+    {
+    numPoints = 1;
+    for (size_t i = 0; i < pointBlock->Dims.size(); i++)
+      {
+      numPoints = numPoints * pointBlock->Dims[i];
+      }
+    }
   unsigned int numAttributes = grid->getNumberAttributes();
   for (unsigned int cc=0; cc < numAttributes; cc++)
     {
@@ -537,8 +1118,30 @@ void vtkXdmf3DataSet::XdmfToVTKAttributes(
       atype = GLOBALID;
       }
 
-    vtkDataArray *array = XdmfToVTKArray(xmfAttribute.get(), attrName,
-                                         ncomp, keeper);
+    const vtkXdmf3DataSet_Block *block = NULL;
+    if (attrCenter == XdmfAttributeCenter::Cell())
+      {
+      block = cellBlock;
+      }
+    else if (attrCenter == XdmfAttributeCenter::Node())
+      {
+      block = pointBlock;
+      }
+    vtkDataArray *array;
+    if (block && block->GetNumberOfTuples() == 0)
+      {
+      continue;
+      }
+    if (block)
+      {
+      array = vtkXdmf3DataSet_ReadBlock(xmfAttribute.get(), attrName,
+                                        ncomp, *block, keeper);
+      }
+    else
+      {
+      array = vtkXdmf3DataSet::XdmfToVTKArray(xmfAttribute.get(), attrName,
+                                              ncomp, keeper);
+      }
     if (array)
       {
       fieldData->AddArray(array);
@@ -577,6 +1180,18 @@ void vtkXdmf3DataSet::XdmfToVTKAttributes(
     }
 }
 
+//--------------------------------------------------------------------------
+void vtkXdmf3DataSet::XdmfToVTKAttributes(
+  vtkXdmf3ArraySelection *fselection,
+  vtkXdmf3ArraySelection *cselection,
+  vtkXdmf3ArraySelection *pselection,
+  XdmfGrid *grid, vtkDataObject *dObject,
+  vtkXdmf3ArrayKeeper *keeper)
+{
+  vtkXdmf3DataSet_ReadAttributes(fselection, cselection, pselection,
+                                 grid, dObject, keeper, NULL, NULL);
+}
+
 //--------------------------------------------------------------------------
 void vtkXdmf3DataSet::VTKToXdmfAttributes(
   vtkDataObject *dObject, XdmfGrid *grid)
@@ -1005,31 +1620,36 @@ void vtkXdmf3DataSet::XdmfToVTK(
   vtkXdmf3ArraySelection *pselection,
   XdmfRegularGrid *grid,
   vtkImageData *dataSet,
-  vtkXdmf3ArrayKeeper *keeper)
+  vtkXdmf3ArrayKeeper *keeper,
+  const int *updateExtent)
 {
-  vtkXdmf3DataSet::CopyShape(grid, dataSet, keeper);
+  vtkXdmf3DataSet::CopyShape(grid, dataSet, keeper, updateExtent);
+  int whole_extent[6];
+  vtkXdmf3DataSet::GetWholeExtent(grid, whole_extent);
+  if (vtkXdmf3DataSet_UseUpdateExtent(whole_extent, updateExtent))
+    {
+    vtkXdmf3DataSet_Block pointBlock;
+    vtkXdmf3DataSet_Block cellBlock;
+    vtkXdmf3DataSet_ExtentToBlocks(whole_extent, updateExtent,
+                                   pointBlock, cellBlock);
+    vtkXdmf3DataSet_ReadAttributes(fselection, cselection, pselection,
+                                   grid, dataSet, keeper,
+                                   &pointBlock, &cellBlock);
+    return;
+    }
   vtkXdmf3DataSet::XdmfToVTKAttributes(fselection, cselection, pselection,
                                        grid, dataSet, keeper);
 }
 
 //--------------------------------------------------------------------------
-void vtkXdmf3DataSet::CopyShape(
-  XdmfRegularGrid *grid,
-  vtkImageData *dataSet,
-  vtkXdmf3ArrayKeeper *vtkNotUsed(keeper))
+void vtkXdmf3DataSet::GetWholeExtent(XdmfRegularGrid *grid, int extent[6])
 {
-  if (!dataSet)
-    {
-    return;
-    }
-
-  int whole_extent[6];
-  whole_extent[0] = 0;
-  whole_extent[1] = -1;
-  whole_extent[2] = 0;
-  whole_extent[3] = -1;
-  whole_extent[4] = 0;
-  whole_extent[5] = -1;
+  extent[0] = 0;
+  extent[1] = -1;
+  extent[2] = 0;
+  extent[3] = -1;
+  extent[4] = 0;
+  extent[5] = -1;
 
   shared_ptr<XdmfArray> xdims = grid->getDimensions();
   if (xdims)
@@ -1037,15 +1657,38 @@ void vtkXdmf3DataSet::CopyShape(
     bool freeMe = vtkXdmf3DataSet_ReadIfNeeded(xdims.get());
     for (unsigned int i = 0; (i < 3 && i < xdims->getSize()); i++)
       {
-      whole_extent[(2-i)*2+1] = xdims->getValue<int>(i)-1;
+      extent[(2-i)*2+1] = xdims->getValue<int>(i)-1;
       }
   if (xdims->getSize() == 2)
     {
-    whole_extent[1] = whole_extent[0];
+    extent[1] = extent[0];
     }
     vtkXdmf3DataSet_ReleaseIfNeeded(xdims.get(), freeMe);
     }
-  dataSet->SetExtent(whole_extent);
+}
+
+//--------------------------------------------------------------------------
+void vtkXdmf3DataSet::CopyShape(
+  XdmfRegularGrid *grid,
+  vtkImageData *dataSet,
+  vtkXdmf3ArrayKeeper *vtkNotUsed(keeper),
+  const int *updateExtent)
+{
+  if (!dataSet)
+    {
+    return;
+    }
+
+  int whole_extent[6];
+  vtkXdmf3DataSet::GetWholeExtent(grid, whole_extent);
+  if (vtkXdmf3DataSet_UseUpdateExtent(whole_extent, updateExtent))
+    {
+    dataSet->SetExtent(const_cast<int *>(updateExtent));
+    }
+  else
+    {
+    dataSet->SetExtent(whole_extent);
+    }
 
   double origin[3];
   origin[0] = 0.0;
@@ -1118,31 +1761,37 @@ void vtkXdmf3DataSet::XdmfToVTK(
   vtkXdmf3ArraySelection *pselection,
   XdmfRectilinearGrid *grid,
   vtkRectilinearGrid *dataSet,
-  vtkXdmf3ArrayKeeper *keeper)
+  vtkXdmf3ArrayKeeper *keeper,
+  const int *updateExtent)
 {
-  vtkXdmf3DataSet::CopyShape(grid, dataSet, keeper);
+  vtkXdmf3DataSet::CopyShape(grid, dataSet, keeper, updateExtent);
+  int whole_extent[6];
+  vtkXdmf3DataSet::GetWholeExtent(grid, whole_extent);
+  if (vtkXdmf3DataSet_UseUpdateExtent(whole_extent, updateExtent))
+    {
+    vtkXdmf3DataSet_Block pointBlock;
+    vtkXdmf3DataSet_Block cellBlock;
+    vtkXdmf3DataSet_ExtentToBlocks(whole_extent, updateExtent,
+                                   pointBlock, cellBlock);
+    vtkXdmf3DataSet_ReadAttributes(fselection, cselection, pselection,
+                                   grid, dataSet, keeper,
+                                   &pointBlock, &cellBlock);
+    return;
+    }
   vtkXdmf3DataSet::XdmfToVTKAttributes(fselection, cselection, pselection,
                                        grid, dataSet, keeper);
 }
 
 //--------------------------------------------------------------------------
-void vtkXdmf3DataSet::CopyShape(
-  XdmfRectilinearGrid *grid,
-  vtkRectilinearGrid *dataSet,
-  vtkXdmf3ArrayKeeper *keeper)
+void vtkXdmf3DataSet::GetWholeExtent(XdmfRectilinearGrid *grid,
+                                     int extent[6])
 {
-  if (!dataSet)
-    {
-    return;
-    }
-
-  int whole_extent[6];
-  whole_extent[0] = 0;
-  whole_extent[1] = -1;
-  whole_extent[2] = 0;
-  whole_extent[3] = -1;
-  whole_extent[4] = 0;
-  whole_extent[5] = -1;
+  extent[0] = 0;
+  extent[1] = -1;
+  extent[2] = 0;
+  extent[3] = -1;
+  extent[4] = 0;
+  extent[5] = -1;
 
   shared_ptr<XdmfArray> xdims;
   xdims = grid->getDimensions();
@@ -1153,43 +1802,76 @@ void vtkXdmf3DataSet::CopyShape(
     bool freeMe = vtkXdmf3DataSet_ReadIfNeeded(xdims.get());
     for (unsigned int i = 0; (i < 3 && i < xdims->getSize()); i++)
       {
-      whole_extent[i*2+1] = xdims->getValue<int>(i)-1;
+      extent[i*2+1] = xdims->getValue<int>(i)-1;
       }
   if (xdims->getSize() == 2)
     {
-    whole_extent[5] = whole_extent[4];
+    extent[5] = extent[4];
     }
     vtkXdmf3DataSet_ReleaseIfNeeded(xdims.get(), freeMe);
     }
-  dataSet->SetExtent(whole_extent);
-
-  vtkDataArray *vCoords = NULL;
-  shared_ptr<XdmfArray> xCoords;
+}
 
-  xCoords = grid->getCoordinates(0);
-  vCoords = vtkXdmf3DataSet::XdmfToVTKArray
-    (xCoords.get(), xCoords->getName(), 1, keeper);
-  dataSet->SetXCoordinates(vCoords);
-  if (vCoords)
+//--------------------------------------------------------------------------
+void vtkXdmf3DataSet::CopyShape(
+  XdmfRectilinearGrid *grid,
+  vtkRectilinearGrid *dataSet,
+  vtkXdmf3ArrayKeeper *keeper,
+  const int *updateExtent)
+{
+  if (!dataSet)
     {
-    vCoords->Delete();
+    return;
     }
 
-  xCoords = grid->getCoordinates(1);
-  vCoords = vtkXdmf3DataSet::XdmfToVTKArray
-    (xCoords.get(), xCoords->getName(), 1, keeper);
-  dataSet->SetYCoordinates(vCoords);
-  if (vCoords)
+  int whole_extent[6];
+  vtkXdmf3DataSet::GetWholeExtent(grid, whole_extent);
+  vtkXdmf3DataSet_Block pointBlock;
+  vtkXdmf3DataSet_Block cellBlock;
+  bool subExtent =
+    vtkXdmf3DataSet_UseUpdateExtent(whole_extent, updateExtent);
+  if (subExtent)
+    {
+    vtkXdmf3DataSet_ExtentToBlocks(whole_extent, updateExtent,
+                                   pointBlock, cellBlock);
+    dataSet->SetExtent(const_cast<int *>(updateExtent));
+    if (pointBlock.GetNumberOfTuples() == 0)
+      {
+      return;
+      }
+    }
+  else
     {
-    vCoords->Delete();
+    dataSet->SetExtent(whole_extent);
     }
 
-  if (xdims->getSize() > 2)
+  unsigned int numCoordinates =
+    grid->getDimensions()->getSize() > 2 ? 3 : 2;
+  for (unsigned int i = 0; i < numCoordinates; i++)
     {
-    xCoords = grid->getCoordinates(2);
-    vCoords = vtkXdmf3DataSet::XdmfToVTKArray
-      (xCoords.get(), xCoords->getName(), 1, keeper);
-    dataSet->SetZCoordinates(vCoords);
+    shared_ptr<XdmfArray> xCoords = grid->getCoordinates(i);
+    vtkXdmf3DataSet_Block axisBlock;
+    if (subExtent)
+      {
+      //the blocks are ordered kji
+      axisBlock.SetOneAxis(pointBlock.Dims[2-i], pointBlock.Start[2-i],
+                           pointBlock.Count[2-i]);
+      }
+    vtkDataArray *vCoords = vtkXdmf3DataSet_ReadGeometryArray
+      (xCoords.get(), xCoords->getName(), 1,
+       subExtent ? &axisBlock : NULL, keeper);
+    if (i == 0)
+      {
+      dataSet->SetXCoordinates(vCoords);
+      }
+    else if (i == 1)
+      {
+      dataSet->SetYCoordinates(vCoords);
+      }
+    else
+      {
+      dataSet->SetZCoordinates(vCoords);
+      }
     if (vCoords)
       {
       vCoords->Delete();
@@ -1244,78 +1926,92 @@ void vtkXdmf3DataSet::XdmfToVTK(
   vtkXdmf3ArraySelection *pselection,
   XdmfCurvilinearGrid *grid,
   vtkStructuredGrid *dataSet,
-  vtkXdmf3ArrayKeeper *keeper)
+  vtkXdmf3ArrayKeeper *keeper,
+  const int *updateExtent)
 {
-  vtkXdmf3DataSet::CopyShape(grid, dataSet, keeper);
+  vtkXdmf3DataSet::CopyShape(grid, dataSet, keeper, updateExtent);
+  int whole_extent[6];
+  vtkXdmf3DataSet::GetWholeExtent(grid, whole_extent);
+  if (vtkXdmf3DataSet_UseUpdateExtent(whole_extent, updateExtent))
+    {
+    vtkXdmf3DataSet_Block pointBlock;
+    vtkXdmf3DataSet_Block cellBlock;
+    vtkXdmf3DataSet_ExtentToBlocks(whole_extent, updateExtent,
+                                   pointBlock, cellBlock);
+    vtkXdmf3DataSet_ReadAttributes(fselection, cselection, pselection,
+                                   grid, dataSet, keeper,
+                                   &pointBlock, &cellBlock);
+    return;
+    }
   vtkXdmf3DataSet::XdmfToVTKAttributes(fselection, cselection, pselection,
                                        grid, dataSet, keeper);
 }
 
 //--------------------------------------------------------------------------
-void vtkXdmf3DataSet::CopyShape(
-  XdmfCurvilinearGrid *grid,
-  vtkStructuredGrid *dataSet,
-  vtkXdmf3ArrayKeeper *keeper)
+void vtkXdmf3DataSet::GetWholeExtent(XdmfCurvilinearGrid *grid,
+                                     int extent[6])
 {
-  if (!dataSet)
-    {
-    return;
-    }
-
-  int whole_extent[6];
-  whole_extent[0] = 0;
-  whole_extent[1] = -1;
-  whole_extent[2] = 0;
-  whole_extent[3] = -1;
-  whole_extent[4] = 0;
-  whole_extent[5] = -1;
+  extent[0] = 0;
+  extent[1] = -1;
+  extent[2] = 0;
+  extent[3] = -1;
+  extent[4] = 0;
+  extent[5] = -1;
   shared_ptr<XdmfArray> xdims;
   xdims = grid->getDimensions();
   if (xdims)
     {
     for (unsigned int i = 0; (i < 3 && i < xdims->getSize()); i++)
       {
-      whole_extent[(2-i)*2+1] = xdims->getValue<int>(i)-1;
+      extent[(2-i)*2+1] = xdims->getValue<int>(i)-1;
       }
     }
   if (xdims->getSize() == 2)
     {
-    whole_extent[1] = whole_extent[0];
+    extent[1] = extent[0];
     }
-  dataSet->SetExtent(whole_extent);
+}
 
-  vtkDataArray *vPoints = NULL;
-  shared_ptr<XdmfGeometry> geom = grid->getGeometry();
-  if (geom->getType() == XdmfGeometryType::XY())
+//--------------------------------------------------------------------------
+void vtkXdmf3DataSet::CopyShape(
+  XdmfCurvilinearGrid *grid,
+  vtkStructuredGrid *dataSet,
+  vtkXdmf3ArrayKeeper *keeper,
+  const int *updateExtent)
+{
+  if (!dataSet)
     {
-    vPoints = vtkXdmf3DataSet::XdmfToVTKArray(geom.get(), "", 2, keeper);
-    vtkDataArray *vPoints3 = vPoints->NewInstance();
-    vPoints3->SetNumberOfComponents(3);
-    vPoints3->SetNumberOfTuples(vPoints->GetNumberOfTuples());
-    vPoints3->SetName("");
-    vPoints3->CopyComponent(0, vPoints, 0);
-    vPoints3->CopyComponent(1, vPoints, 1);
-    vPoints3->FillComponent(2, 0.0);
-    vPoints->Delete();
-    vPoints = vPoints3;
+    return;
     }
-  else if (geom->getType() == XdmfGeometryType::XYZ())
-    {
-    vPoints = vtkXdmf3DataSet::XdmfToVTKArray(geom.get(), "", 3, keeper);
+
+  int whole_extent[6];
+  vtkXdmf3DataSet::GetWholeExtent(grid, whole_extent);
+  vtkXdmf3DataSet_Block pointBlock;
+  vtkXdmf3DataSet_Block cellBlock;
+  bool subExtent =
+    vtkXdmf3DataSet_UseUpdateExtent(whole_extent, updateExtent);
+  if (subExtent)
+    {
+    vtkXdmf3DataSet_ExtentToBlocks(whole_extent, updateExtent,
+                                   pointBlock, cellBlock);
+    dataSet->SetExtent(const_cast<int *>(updateExtent));
+    if (pointBlock.GetNumberOfTuples() == 0)
+      {
+      return;
+      }
     }
   else
     {
-    //TODO: No X_Y or X_Y_Z in xdmf anymore
-    return;
+    dataSet->SetExtent(whole_extent);
     }
+
   vtkPoints *p = vtkPoints::New();
-  p->SetData(vPoints);
-  dataSet->SetPoints(p);
-  p->Delete();
-  if (vPoints)
+  if (vtkXdmf3DataSet_ReadPoints(grid->getGeometry().get(), p,
+                                 subExtent ? &pointBlock : NULL, keeper))
     {
-    vPoints->Delete();
+    dataSet->SetPoints(p);
     }
+  p->Delete();
 }
 
 //--------------------------------------------------------------------------
@@ -1363,30 +2059,18 @@ void vtkXdmf3DataSet::VTKToXdmf(
 
 //==========================================================================
 
-void vtkXdmf3DataSet::XdmfToVTK(
-  vtkXdmf3ArraySelection *fselection,
-  vtkXdmf3ArraySelection *cselection,
-  vtkXdmf3ArraySelection *pselection,
-  XdmfUnstructuredGrid *grid,
-  vtkUnstructuredGrid *dataSet,
-  vtkXdmf3ArrayKeeper *keeper)
-{
-  vtkXdmf3DataSet::CopyShape(grid, dataSet, keeper);
-  vtkXdmf3DataSet::XdmfToVTKAttributes(fselection, cselection, pselection,
-                                       grid, dataSet, keeper);
-}
-
 //--------------------------------------------------------------------------
-void vtkXdmf3DataSet::CopyShape(
+//Fills the data set with the cells of the given piece of the grid and the
+//range of points that they use, and fills the blocks of the grid's points
+//and cells that the data set holds.
+void vtkXdmf3DataSet_CopyShape(
   XdmfUnstructuredGrid *grid,
   vtkUnstructuredGrid *dataSet,
-  vtkXdmf3ArrayKeeper *keeper)
+  vtkXdmf3ArrayKeeper *keeper,
+  unsigned int piece, unsigned int npieces,
+  vtkXdmf3DataSet_Block &pointBlock,
+  vtkXdmf3DataSet_Block &cellBlock)
 {
-  if (!dataSet)
-    {
-    return;
-    }
-
   shared_ptr<XdmfTopology> xTopology = grid->getTopology();
   shared_ptr<const XdmfTopologyType> xCellType = xTopology->getType();
   int vCellType = vtkXdmf3DataSet::GetVTKCellType(xCellType);
@@ -1395,8 +2079,6 @@ void vtkXdmf3DataSet::CopyShape(
     return;
     }
 
-  bool freeMe = vtkXdmf3DataSet_ReadIfNeeded(xTopology.get());
-
   if (xCellType != XdmfTopologyType::Mixed())
     {
     // all cells are of the same type.
@@ -1404,50 +2086,96 @@ void vtkXdmf3DataSet::CopyShape(
 
     // translate cell array
     unsigned int numCells = xTopology->getNumberElements();
-
-    int *cell_types = new int[numCells];
+    unsigned int firstCell = static_cast<unsigned int>(
+      static_cast<unsigned long long>(numCells) * piece / npieces);
+    unsigned int lastCell = static_cast<unsigned int>(
+      static_cast<unsigned long long>(numCells) * (piece + 1) / npieces);
+    cellBlock.SetOneAxis(numCells, firstCell, lastCell - firstCell);
+    vtkIdType numPieceCells = lastCell - firstCell;
+
+    int *cell_types = new int[numPieceCells];
+    for (vtkIdType cc = 0; cc < numPieceCells; cc++)
+      {
+      cell_types[cc] = vCellType;
+      }
 
     vtkCellArray* vCells = vtkCellArray::New();
     // Get the pointer
     vtkIdType* cells_ptr = vCells->WritePointer(
-      numCells, numCells * (1 + numPointsPerCell));
+      numPieceCells, numPieceCells * (1 + numPointsPerCell));
 
     // xmfConnections: N p1 p2 ... pN
     // i.e. Triangles : 3 0 1 2    3 3 4 5   3 6 7 8
-    vtkIdType index = 0;
-    for(vtkIdType cc = 0 ; cc < static_cast<vtkIdType>(numCells); cc++ )
+    if (npieces > 1)
       {
-      cell_types[cc] = vCellType;
-      *cells_ptr++ = numPointsPerCell;
-      for (vtkIdType i = 0 ; i < static_cast<vtkIdType>(numPointsPerCell); i++ )
+      vtkDataArray *vConnectivity = NULL;
+      if (numPieceCells > 0)
         {
-        *cells_ptr++ = xTopology->getValue<vtkIdType>(index++);
+        vConnectivity = vtkXdmf3DataSet_ReadBlock(
+          xTopology.get(), "", numPointsPerCell, cellBlock, keeper);
+        }
+      if (vConnectivity)
+        {
+        switch (vConnectivity->GetDataType())
+          {
+          vtkTemplateMacro(
+            vtkXdmf3DataSet_CopyConnectivity(
+              static_cast<VTK_TT *>(vConnectivity->GetVoidPointer(0)),
+              numPieceCells, numPointsPerCell, cells_ptr));
+          }
+        vConnectivity->Delete();
+        }
+      else
+        {
+        // a topology shorter than its cells gives no cells
+        vCells->Initialize();
+        }
+      }
+    else
+      {
+      bool freeMe = vtkXdmf3DataSet_ReadIfNeeded(xTopology.get());
+      vtkIdType index = 0;
+      for(vtkIdType cc = 0 ; cc < static_cast<vtkIdType>(numCells); cc++ )
+        {
+        *cells_ptr++ = numPointsPerCell;
+        for (vtkIdType i = 0 ; i < static_cast<vtkIdType>(numPointsPerCell); i++ )
+          {
+          *cells_ptr++ = xTopology->getValue<vtkIdType>(index++);
+          }
         }
+      vtkXdmf3DataSet_ReleaseIfNeeded(xTopology.get(), freeMe);
       }
     dataSet->SetCells(cell_types, vCells);
     vCells->Delete();
-    vtkXdmf3DataSet_ReleaseIfNeeded(xTopology.get(), freeMe);
     delete [] cell_types;
     }
   else
     {
     // mixed cell types
+    bool freeMe = vtkXdmf3DataSet_ReadIfNeeded(xTopology.get());
     unsigned int conn_length = xTopology->getSize();
     vtkIdType numCells = xTopology->getNumberElements();
+    vtkIdType firstCell = numCells * piece / npieces;
+    vtkIdType lastCell = numCells * (piece + 1) / npieces;
+    cellBlock.SetOneAxis(static_cast<unsigned int>(numCells),
+                         static_cast<unsigned int>(firstCell),
+                         static_cast<unsigned int>(lastCell - firstCell));
 
-    int *cell_types = new int[numCells];
+    int *cell_types = new int[lastCell - firstCell];
 
     /* Create Cell Array */
     vtkCellArray* vCells = vtkCellArray::New();
 
     /* Get the pointer. Make it Big enough ... too big for now */
-    vtkIdType* cells_ptr = vCells->WritePointer(numCells, conn_length);
+    vtkIdType* cells_ptr = vCells->WritePointer(lastCell - firstCell,
+                                                conn_length);
+    vtkIdType* cells_begin = cells_ptr;
 
     /* xmfConnections : N p1 p2 ... pN */
     /* i.e. Triangles : 3 0 1 2    3 3 4 5   3 6 7 8 */
+    /* the whole connectivity is read, cells outside of the piece are skipped */
     vtkIdType index = 0;
-    int sub = 0;
-    for(vtkIdType cc = 0 ; cc < numCells; cc++ )
+    for(vtkIdType cc = 0 ; cc < lastCell; cc++ )
       {
       shared_ptr<const XdmfTopologyType> nextCellType =
         XdmfTopologyType::New(xTopology->getValue<vtkIdType>(index++));
@@ -1472,10 +2200,14 @@ void vtkXdmf3DataSet::CopyShape(
         // cell type does not have a fixed number of points in which case the
         // next entry in xmfConnections tells us the number of points.
         numPointsPerCell = xTopology->getValue<unsigned int>(index++);
-        sub++; // used to shrink the cells array at the end.
         }
 
-      cell_types[cc] = vtk_cell_typeI;
+      if (cc < firstCell)
+        {
+        index += numPointsPerCell;
+        continue;
+        }
+      cell_types[cc - firstCell] = vtk_cell_typeI;
       *cells_ptr++ = numPointsPerCell;
       for(vtkIdType i = 0 ; i < static_cast<vtkIdType>(numPointsPerCell); i++ )
         {
@@ -1483,7 +2215,7 @@ void vtkXdmf3DataSet::CopyShape(
         }
       }
     // Resize the Array to the Proper Size
-    vCells->GetData()->Resize(index-sub);
+    vCells->GetData()->Resize(cells_ptr - cells_begin);
     dataSet->SetCells(cell_types, vCells);
     vCells->Delete();
     delete [] cell_types;
@@ -1491,39 +2223,105 @@ void vtkXdmf3DataSet::CopyShape(
     }
 
   //copy geometry
-  vtkDataArray *vPoints = NULL;
   shared_ptr<XdmfGeometry> geom = grid->getGeometry();
-  if (geom->getType() == XdmfGeometryType::XY())
+  vtkPoints *p = vtkPoints::New();
+  if (npieces > 1)
+    {
+    //read the range of points used by the cells of the piece, and make the
+    //cells refer to it
+    vtkIdType numPoints = geom->getNumberPoints();
+    vtkIdType minId = numPoints;
+    vtkIdType maxId = -1;
+    vtkCellArray *vCells = dataSet->GetCells();
+    vtkIdType *ptr = vCells ? vCells->GetPointer() : NULL;
+    vtkIdType numPieceCells = vCells ? vCells->GetNumberOfCells() : 0;
+    for (vtkIdType cc = 0; cc < numPieceCells; cc++)
+      {
+      vtkIdType npts = *ptr++;
+      for (vtkIdType i = 0; i < npts; i++, ptr++)
+        {
+        minId = *ptr < minId ? *ptr : minId;
+        maxId = *ptr > maxId ? *ptr : maxId;
+        }
+      }
+    if (maxId < minId)
+      {
+      pointBlock.SetOneAxis(static_cast<unsigned int>(numPoints), 0, 0);
+      p->Delete();
+      return;
+      }
+    ptr = vCells->GetPointer();
+    for (vtkIdType cc = 0; cc < numPieceCells; cc++)
+      {
+      vtkIdType npts = *ptr++;
+      for (vtkIdType i = 0; i < npts; i++, ptr++)
+        {
+        *ptr -= minId;
+        }
+      }
+    pointBlock.SetOneAxis(static_cast<unsigned int>(numPoints),
+                          static_cast<unsigned int>(minId),
+                          static_cast<unsigned int>(maxId - minId + 1));
+    if (vtkXdmf3DataSet_ReadPoints(geom.get(), p, &pointBlock, keeper))
+      {
+      dataSet->SetPoints(p);
+      }
+    }
+  else if (vtkXdmf3DataSet_ReadPoints(geom.get(), p, NULL, keeper))
     {
-    vPoints = vtkXdmf3DataSet::XdmfToVTKArray(geom.get(), "", 2, keeper);
-    vtkDataArray *vPoints3 = vPoints->NewInstance();
-    vPoints3->SetNumberOfComponents(3);
-    vPoints3->SetNumberOfTuples(vPoints->GetNumberOfTuples());
-    vPoints3->SetName("");
-    vPoints3->CopyComponent(0, vPoints, 0);
-    vPoints3->CopyComponent(1, vPoints, 1);
-    vPoints3->FillComponent(2, 0.0);
-    vPoints->Delete();
-    vPoints = vPoints3;
+    dataSet->SetPoints(p);
     }
-  else if (geom->getType() == XdmfGeometryType::XYZ())
+  p->Delete();
+}
+
+//--------------------------------------------------------------------------
+void vtkXdmf3DataSet::XdmfToVTK(
+  vtkXdmf3ArraySelection *fselection,
+  vtkXdmf3ArraySelection *cselection,
+  vtkXdmf3ArraySelection *pselection,
+  XdmfUnstructuredGrid *grid,
+  vtkUnstructuredGrid *dataSet,
+  vtkXdmf3ArrayKeeper *keeper,
+  unsigned int piece, unsigned int npieces)
+{
+  if (npieces <= 1)
     {
-    vPoints = vtkXdmf3DataSet::XdmfToVTKArray(geom.get(), "", 3, keeper);
+    vtkXdmf3DataSet::CopyShape(grid, dataSet, keeper);
+    vtkXdmf3DataSet::XdmfToVTKAttributes(fselection, cselection, pselection,
+                                         grid, dataSet, keeper);
+    return;
     }
-  else
+  if (!dataSet)
     {
-    //TODO: No X_Y or X_Y_Z in xdmf anymore
     return;
     }
+  vtkXdmf3DataSet_Block pointBlock;
+  vtkXdmf3DataSet_Block cellBlock;
+  vtkXdmf3DataSet_CopyShape(grid, dataSet, keeper, piece, npieces,
+                            pointBlock, cellBlock);
+  if (pointBlock.Dims.empty() || cellBlock.Dims.empty())
+    {
+    return;
+    }
+  vtkXdmf3DataSet_ReadAttributes(fselection, cselection, pselection,
+                                 grid, dataSet, keeper,
+                                 &pointBlock, &cellBlock);
+}
 
-  vtkPoints *p = vtkPoints::New();
-  p->SetData(vPoints);
-  dataSet->SetPoints(p);
-  p->Delete();
-  if (vPoints)
+//--------------------------------------------------------------------------
+void vtkXdmf3DataSet::CopyShape(
+  XdmfUnstructuredGrid *grid,
+  vtkUnstructuredGrid *dataSet,
+  vtkXdmf3ArrayKeeper *keeper)
+{
+  if (!dataSet)
     {
-    vPoints->Delete();
+    return;
     }
+  vtkXdmf3DataSet_Block pointBlock;
+  vtkXdmf3DataSet_Block cellBlock;
+  vtkXdmf3DataSet_CopyShape(grid, dataSet, keeper, 0, 1,
+                            pointBlock, cellBlock);
 }
 
 //--------------------------------------------------------------------------
@@ -105,21 +105,29 @@ public:
   //vtkXdmf3RegularGrid
 
   // Description:
-  // Populates the VTK data set with the contents of the Xdmf grid
+  // Populates the VTK data set with the contents of the Xdmf grid.
+  // When updateExtent is a sub-extent of the grid, only the heavy data of
+  // that extent is read.
   static void XdmfToVTK(
     vtkXdmf3ArraySelection *fselection,
     vtkXdmf3ArraySelection *cselection,
     vtkXdmf3ArraySelection *pselection,
     XdmfRegularGrid *grid,
     vtkImageData *dataSet,
-    vtkXdmf3ArrayKeeper *keeper=NULL);
+    vtkXdmf3ArrayKeeper *keeper=NULL,
+    const int *updateExtent=NULL);
 
   // Description:
   // Helper that does topology for XdmfToVTK
   static void CopyShape(
     XdmfRegularGrid *grid,
     vtkImageData *dataSet,
-    vtkXdmf3ArrayKeeper *keeper=NULL);
+    vtkXdmf3ArrayKeeper *keeper=NULL,
+    const int *updateExtent=NULL);
+
+  // Description:
+  // Computes the extent of the grid without reading its heavy data
+  static void GetWholeExtent(XdmfRegularGrid *grid, int extent[6]);
 
   // Description:
   // Populates the Xdmf Grid with the contents of the VTK data set
@@ -130,21 +138,29 @@ public:
 
   //vtkXdmf3RectilinearGrid
   // Description:
-  // Populates the VTK data set with the contents of the Xdmf grid
+  // Populates the VTK data set with the contents of the Xdmf grid.
+  // When updateExtent is a sub-extent of the grid, only the heavy data of
+  // that extent is read.
   static void XdmfToVTK(
     vtkXdmf3ArraySelection *fselection,
     vtkXdmf3ArraySelection *cselection,
     vtkXdmf3ArraySelection *pselection,
     XdmfRectilinearGrid *grid,
     vtkRectilinearGrid *dataSet,
-    vtkXdmf3ArrayKeeper *keeper=NULL);
+    vtkXdmf3ArrayKeeper *keeper=NULL,
+    const int *updateExtent=NULL);
 
   // Description:
   // Helper that does topology for XdmfToVTK
   static void CopyShape(
     XdmfRectilinearGrid *grid,
     vtkRectilinearGrid *dataSet,
-    vtkXdmf3ArrayKeeper *keeper=NULL);
+    vtkXdmf3ArrayKeeper *keeper=NULL,
+    const int *updateExtent=NULL);
+
+  // Description:
+  // Computes the extent of the grid without reading its heavy data
+  static void GetWholeExtent(XdmfRectilinearGrid *grid, int extent[6]);
 
   // Description:
   // Populates the Xdmf Grid with the contents of the VTK data set
@@ -155,21 +171,29 @@ public:
 
   //vtkXdmf3CurvilinearGrid
   // Description:
-  // Populates the VTK data set with the contents of the Xdmf grid
+  // Populates the VTK data set with the contents of the Xdmf grid.
+  // When updateExtent is a sub-extent of the grid, only the heavy data of
+  // that extent is read.
   static void XdmfToVTK(
     vtkXdmf3ArraySelection *fselection,
     vtkXdmf3ArraySelection *cselection,
     vtkXdmf3ArraySelection *pselection,
     XdmfCurvilinearGrid *grid,
     vtkStructuredGrid *dataSet,
-    vtkXdmf3ArrayKeeper *keeper=NULL);
+    vtkXdmf3ArrayKeeper *keeper=NULL,
+    const int *updateExtent=NULL);
 
   // Description:
   // Helper that does topology for XdmfToVTK
   static void CopyShape(
     XdmfCurvilinearGrid *grid,
     vtkStructuredGrid *dataSet,
-    vtkXdmf3ArrayKeeper *keeper=NULL);
+    vtkXdmf3ArrayKeeper *keeper=NULL,
+    const int *updateExtent=NULL);
+
+  // Description:
+  // Computes the extent of the grid without reading its heavy data
+  static void GetWholeExtent(XdmfCurvilinearGrid *grid, int extent[6]);
 
   // Description:
   // Populates the Xdmf Grid with the contents of the VTK data set
@@ -180,14 +204,17 @@ public:
 
   //vtkXdmf3UnstructuredGrid
   // Description:
-  // Populates the VTK data set with the contents of the Xdmf grid
+  // Populates the VTK data set with the contents of the Xdmf grid.
+  // When npieces is more than 1, only the cells of the given piece, the
+  // range of points that they use and their attributes are read.
   static void XdmfToVTK(
     vtkXdmf3ArraySelection *fselection,
     vtkXdmf3ArraySelection *cselection,
     vtkXdmf3ArraySelection *pselection,
     XdmfUnstructuredGrid *grid,
     vtkUnstructuredGrid *dataSet,
-    vtkXdmf3ArrayKeeper *keeper=NULL);
+    vtkXdmf3ArrayKeeper *keeper=NULL,
+    unsigned int piece=0, unsigned int npieces=1);
 
   // Description:
   // Helper that does topology for XdmfToVTK
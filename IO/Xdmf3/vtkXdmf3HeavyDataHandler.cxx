@@ -52,7 +52,9 @@ shared_ptr<vtkXdmf3HeavyDataHandler> vtkXdmf3HeavyDataHandler::New (
    unsigned int processor, unsigned int nprocessors,
    bool dt, double t,
    vtkXdmf3ArrayKeeper *keeper,
-   bool asTime)
+   bool asTime,
+   const int *updateExtent,
+   bool splitUnstructured)
 {
   shared_ptr<vtkXdmf3HeavyDataHandler> p(new vtkXdmf3HeavyDataHandler());
   p->FieldArrays = fs;
@@ -66,12 +68,20 @@ shared_ptr<vtkXdmf3HeavyDataHandler> vtkXdmf3HeavyDataHandler::New (
   p->time = t;
   p->Keeper = keeper;
   p->AsTime = asTime;
+  p->HasUpdateExtent = (updateExtent != NULL);
+  for (int i = 0; i < 6; i++)
+    {
+    p->UpdateExtent[i] = updateExtent ? updateExtent[i] : 0;
+    }
+  p->SplitUnstructured = splitUnstructured;
   return p;
 }
 
 //------------------------------------------------------------------------------
 vtkXdmf3HeavyDataHandler::vtkXdmf3HeavyDataHandler()
 {
+  this->HasUpdateExtent = false;
+  this->SplitUnstructured = false;
 }
 
 //------------------------------------------------------------------------------
@@ -460,6 +470,17 @@ bool vtkXdmf3HeavyDataHandler::ShouldRead(unsigned int piece,
 
 }
 
+//------------------------------------------------------------------------------
+const int *vtkXdmf3HeavyDataHandler::GetUpdateExtent(XdmfGrid *grid)
+{
+  //sets refer to the whole grid, so grids with sets are read whole
+  if (!this->HasUpdateExtent || grid->getNumberSets() > 0)
+    {
+    return NULL;
+    }
+  return this->UpdateExtent;
+}
+
 //------------------------------------------------------------------------------
 bool vtkXdmf3HeavyDataHandler::GridEnabled(shared_ptr<XdmfGrid> grid)
 {
@@ -503,10 +524,13 @@ vtkDataObject *vtkXdmf3HeavyDataHandler::MakeUnsGrid
 {
   if (dataSet && this->GridEnabled(grid) && this->ForThisTime(grid))
     {
+    //sets refer to the whole grid, so grids with sets are read whole
+    bool split = this->SplitUnstructured && grid->getNumberSets() == 0;
     vtkXdmf3DataSet::XdmfToVTK
       (
        this->FieldArrays, this->CellArrays, this->PointArrays,
-       grid.get(), dataSet, keeper);
+       grid.get(), dataSet, keeper,
+       split ? this->Rank : 0, split ? this->NumProcs : 1);
     return dataSet;
     }
   return NULL;
@@ -524,7 +548,7 @@ vtkDataObject *vtkXdmf3HeavyDataHandler::MakeRecGrid
     vtkXdmf3DataSet::XdmfToVTK
       (
        this->FieldArrays, this->CellArrays, this->PointArrays,
-       grid.get(), dataSet, keeper);
+       grid.get(), dataSet, keeper, this->GetUpdateExtent(grid.get()));
     return dataSet;
     }
   return NULL;
@@ -542,7 +566,7 @@ vtkDataObject *vtkXdmf3HeavyDataHandler::MakeCrvGrid
     vtkXdmf3DataSet::XdmfToVTK
       (
        this->FieldArrays, this->CellArrays, this->PointArrays,
-       grid.get(), dataSet, keeper);
+       grid.get(), dataSet, keeper, this->GetUpdateExtent(grid.get()));
     return dataSet;
     }
   return NULL;
@@ -560,7 +584,7 @@ vtkDataObject *vtkXdmf3HeavyDataHandler::MakeRegGrid
     vtkXdmf3DataSet::XdmfToVTK
       (
        this->FieldArrays, this->CellArrays, this->PointArrays,
-       grid.get(), dataSet, keeper);
+       grid.get(), dataSet, keeper, this->GetUpdateExtent(grid.get()));
     return dataSet;
     }
   return NULL;
@@ -64,7 +64,9 @@ public:
       unsigned int processor, unsigned int nprocessors,
       bool dt, double t,
       vtkXdmf3ArrayKeeper *keeper,
-      bool asTime );
+      bool asTime,
+      const int *updateExtent = NULL,
+      bool splitUnstructured = false );
 
   //Description:
   //destructor
@@ -86,6 +88,10 @@ protected:
   //for parallel partitioning
   bool ShouldRead(unsigned int piece, unsigned int npieces);
 
+  //Description:
+  //the extent to read of a structured grid, or NULL to read all of it
+  const int *GetUpdateExtent(XdmfGrid *grid);
+
   bool GridEnabled(shared_ptr<XdmfGrid> grid);
   bool GridEnabled(shared_ptr<XdmfGraph> graph);
   bool SetEnabled(shared_ptr<XdmfSet> set);
@@ -127,6 +133,11 @@ protected:
   vtkXdmf3ArraySelection* GridsCache;
   vtkXdmf3ArraySelection* SetsCache;
   bool AsTime;
+  //structured grids without sets read only this extent when it is given
+  int UpdateExtent[6];
+  bool HasUpdateExtent;
+  //unstructured grids without sets read only the cells of this rank
+  bool SplitUnstructured;
 };
 
 #endif //__vtkXdmf3HeavyDataHandler_h
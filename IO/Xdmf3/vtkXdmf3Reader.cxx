@@ -29,9 +29,7 @@
 #include "vtkMultiProcessController.h"
 #include "vtkMutableDirectedGraph.h"
 #include "vtkObjectFactory.h"
-#include "vtkRectilinearGrid.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
-#include "vtkStructuredGrid.h"
 #include "vtkTimerLog.h"
 #include "vtkXdmf3ArrayKeeper.h"
 #include "vtkXdmf3ArraySelection.h"
@@ -53,8 +51,8 @@
 //TODO: implement fast and approximate CanReadFile
 //TODO: read from buffer, allowing for xincludes
 //TODO: strided access to structured data
+//TODO: split mixed topologies without reading all of the connectivity
 //TODO: when too many grids for SIL, allow selection of top level grids
-//TODO: break structured data into pieces
 //TODO: make domains entirely optional and selectable
 
 //=============================================================================
@@ -218,7 +216,8 @@ public:
   //--------------------------------------------------------------------------
   void ReadHeavyData(unsigned int updatePiece, unsigned int updateNumPieces,
                      bool doTime, double time, vtkMultiBlockDataSet* mbds,
-                     bool AsTime)
+                     bool AsTime, const int *updateExtent,
+                     bool splitUnstructured)
   {
     //traverse the xdmf hierarchy, and convert and return what was requested
     shared_ptr<vtkXdmf3HeavyDataHandler> visitor =
@@ -233,7 +232,9 @@ public:
           doTime,
           time,
           this->Keeper,
-          AsTime
+          AsTime,
+          updateExtent,
+          splitUnstructured
           );
       visitor->Populate(this->Domain, mbds);
   }
@@ -566,8 +567,20 @@ int vtkXdmf3Reader::RequestInformation(vtkInformation *,
 
   vtkInformation* outInfo = outputVector->GetInformationObject(0);
 
-  // Publish the fact that this reader can satisfy any piece request.
-  outInfo->Set(CAN_HANDLE_PIECE_REQUEST(), 1);
+  // Structured atomic data sets are read by extent, everything else can
+  // satisfy any piece request.
+  int vtk_type = this->Internal->GetVTKType();
+  if (vtk_type == VTK_STRUCTURED_GRID ||
+      vtk_type == VTK_RECTILINEAR_GRID ||
+      vtk_type == VTK_IMAGE_DATA ||
+      vtk_type == VTK_UNIFORM_GRID)
+    {
+    outInfo->Set(CAN_PRODUCE_SUB_EXTENT(), 1);
+    }
+  else
+    {
+    outInfo->Set(CAN_HANDLE_PIECE_REQUEST(), 1);
+    }
 
   // Publish the SIL which provides information about the grid hierarchy.
   outInfo->Set(vtkDataObject::SIL(), this->Internal->GetSIL());
@@ -585,7 +598,6 @@ int vtkXdmf3Reader::RequestInformation(vtkInformation *,
     }
 
   // Structured atomic must announce the whole extent it can provide
-  int vtk_type = this->Internal->GetVTKType();
   if (vtk_type == VTK_STRUCTURED_GRID ||
       vtk_type == VTK_RECTILINEAR_GRID ||
       vtk_type == VTK_IMAGE_DATA ||
@@ -622,19 +634,13 @@ int vtkXdmf3Reader::RequestInformation(vtkInformation *,
       shared_dynamic_cast<XdmfRectilinearGrid>(this->Internal->TopGrid);
     if (recGrid)
       {
-      vtkRectilinearGrid *dataSet = vtkRectilinearGrid::New();
-      vtkXdmf3DataSet::CopyShape(recGrid.get(), dataSet, this->Internal->Keeper);
-      dataSet->GetExtent(whole_extent);
-      dataSet->Delete();
+      vtkXdmf3DataSet::GetWholeExtent(recGrid.get(), whole_extent);
       }
     shared_ptr<XdmfCurvilinearGrid> crvGrid =
       shared_dynamic_cast<XdmfCurvilinearGrid>(this->Internal->TopGrid);
     if (crvGrid)
       {
-      vtkStructuredGrid *dataSet = vtkStructuredGrid::New();
-      vtkXdmf3DataSet::CopyShape(crvGrid.get(), dataSet, this->Internal->Keeper);
-      dataSet->GetExtent(whole_extent);
-      dataSet->Delete();
+      vtkXdmf3DataSet::GetWholeExtent(crvGrid.get(), whole_extent);
       }
 
     outInfo->Set(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(),
@@ -688,14 +694,23 @@ int vtkXdmf3Reader::RequestData(vtkInformation *,
         vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_GHOST_LEVELS());
     }
   */
-  /*
+  // Structured atomic data sets read only the requested extent, and
+  // unstructured ones read only the cells of the requested piece.
+  int vtk_type = this->Internal->GetVTKType();
   int update_extent[6] = {0, -1, 0, -1, 0, -1};
-  if (outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT()))
+  bool hasUpdateExtent = false;
+  if ((vtk_type == VTK_STRUCTURED_GRID ||
+       vtk_type == VTK_RECTILINEAR_GRID ||
+       vtk_type == VTK_IMAGE_DATA ||
+       vtk_type == VTK_UNIFORM_GRID) &&
+      outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT()))
     {
     outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(),
         update_extent);
+    hasUpdateExtent = true;
     }
-  */
+  bool splitUnstructured =
+    (vtk_type == VTK_UNSTRUCTURED_GRID && updateNumPieces > 1);
 
   // Collect information about what temporal extent is requested.
   double time = 0.0;
@@ -731,7 +746,9 @@ int vtkXdmf3Reader::RequestData(vtkInformation *,
       updatePiece, updateNumPieces,
       doTime, time,
       mbds,
-      this->FileSeriesAsTime);
+      this->FileSeriesAsTime,
+      hasUpdateExtent ? update_extent : NULL,
+      splitUnstructured);
 
   if (mbds->GetNumberOfBlocks()==1)
     {